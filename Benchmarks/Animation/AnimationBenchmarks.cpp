@@ -0,0 +1,274 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Animation/Animator.hpp>
+#include <FlashlightEngine/Core/JobSystem.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <numbers>
+#include <random>
+#include <unordered_map>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 CharacterCount = 1024;
+    constexpr u32 FrameCount = 61; // Two seconds at 30 Hz.
+
+    // A humanoid with fingers, 53 joints, and as many twist and face joints as needed to reach jointCount.
+    std::vector<SkeletonJoint> BuildHumanoid(const u32 jointCount, std::mt19937& random) {
+        std::vector<SkeletonJoint> joints;
+        const auto add = [&joints](const u32 parent, const glm::vec3& offset) {
+            SkeletonJoint joint;
+            joint.Name = "Joint" + std::to_string(joints.size());
+            joint.Parent = parent;
+            joint.BindPose.Translation = offset;
+            joints.push_back(joint);
+            return static_cast<u32>(joints.size() - 1);
+        };
+        const auto addChain = [&add](u32 parent, const u32 length, const glm::vec3& offset) {
+            for (u32 i = 0; i < length; i++) {
+                parent = add(parent, offset);
+            }
+            return parent;
+        };
+
+        const u32 pelvis = add(InvalidJoint, glm::vec3(0.0f, 1.0f, 0.0f));
+        const u32 chest = addChain(pelvis, 4, glm::vec3(0.0f, 0.12f, 0.0f));
+        addChain(chest, 2, glm::vec3(0.0f, 0.1f, 0.0f));
+
+        for (const f32 side : {-1.0f, 1.0f}) {
+            addChain(pelvis, 4, glm::vec3(side * 0.1f, -0.25f, 0.0f));
+
+            const u32 hand = addChain(chest, 4, glm::vec3(side * 0.15f, 0.0f, 0.0f));
+            for (u32 finger = 0; finger < 5; finger++) {
+                addChain(hand, 3, glm::vec3(side * 0.03f, 0.0f, 0.01f * static_cast<f32>(finger)));
+            }
+        }
+
+        std::uniform_real_distribution<f32> offset(-0.05f, 0.05f);
+        while (joints.size() < jointCount) {
+            const u32 parent = std::uniform_int_distribution<u32>(0, static_cast<u32>(joints.size() - 1))(random);
+            add(parent, glm::vec3(offset(random), offset(random), offset(random)));
+        }
+
+        return joints;
+    }
+
+    // Every joint swings around its own axis, the root walks forward.
+    RawAnimation BuildRawAnimation(const Skeleton& skeleton, std::mt19937& random, const f32 amplitude) {
+        std::uniform_real_distribution<f32> value(-1.0f, 1.0f);
+
+        RawAnimation raw;
+        raw.JointCount = skeleton.GetJointCount();
+        raw.FrameCount = FrameCount;
+        raw.Samples.resize(static_cast<u64>(raw.JointCount) * raw.FrameCount);
+
+        for (u32 joint = 0; joint < raw.JointCount; joint++) {
+            const glm::vec3 axis = glm::normalize(glm::vec3(value(random), value(random), value(random)));
+            const f32 frequency = std::numbers::pi_v<f32> * (1.0f + std::abs(value(random)));
+            const f32 phase = value(random) * std::numbers::pi_v<f32>;
+
+            for (u32 frame = 0; frame < raw.FrameCount; frame++) {
+                const f32 time = static_cast<f32>(frame) / raw.SampleRate;
+
+                JointTransform transform = skeleton.GetBindPose()[joint];
+                transform.Rotation = glm::angleAxis(amplitude * std::sin(frequency * time + phase), axis);
+                if (skeleton.GetParentIndex(joint) == InvalidJoint) {
+                    transform.Translation.z += 1.5f * time;
+                }
+
+                raw.GetSample(frame, joint) = transform;
+            }
+        }
+
+        return raw;
+    }
+
+    struct AnimationData {
+        std::unique_ptr<Flashlight::Skeleton> Skeleton;
+        RawAnimation Walk;
+        AnimationClip WalkClip;
+        AnimationClip RunClip;
+        AnimationClip BreatheClip; // Additive.
+    };
+
+    const AnimationData& GetData(const u32 jointCount) {
+        static std::unordered_map<u32, std::unique_ptr<AnimationData>> cache;
+
+        std::unique_ptr<AnimationData>& data = cache[jointCount];
+        if (!data) {
+            std::mt19937 random(jointCount);
+
+            data = std::make_unique<AnimationData>();
+            data->Skeleton = std::make_unique<Skeleton>(BuildHumanoid(jointCount, random));
+            data->Walk = BuildRawAnimation(*data->Skeleton, random, 0.6f);
+            data->WalkClip = CompressAnimation(data->Walk);
+            data->RunClip = CompressAnimation(BuildRawAnimation(*data->Skeleton, random, 1.0f));
+
+            // Additive poses against the bind pose.
+            RawAnimation breathe = BuildRawAnimation(*data->Skeleton, random, 0.1f);
+            for (u32 frame = 0; frame < breathe.FrameCount; frame++) {
+                for (u32 joint = 0; joint < breathe.JointCount; joint++) {
+                    breathe.GetSample(frame, joint).Translation -= data->Skeleton->GetBindPose()[joint].Translation;
+                }
+            }
+            data->BreatheClip = CompressAnimation(breathe);
+        }
+
+        return *data;
+    }
+
+    void AddJointCounts(benchmark::internal::Benchmark* benchmark) {
+        benchmark->ArgName("Joints")->Arg(60)->Arg(90)->Arg(120);
+    }
+
+    void AnimationCompressClip(benchmark::State& state) {
+        const AnimationData& data = GetData(static_cast<u32>(state.range(0)));
+
+        AnimationClip clip;
+        for (auto _ : state) {
+            clip = CompressAnimation(data.Walk);
+            benchmark::DoNotOptimize(clip.Channels.data());
+        }
+
+        const ClipError error = MeasureClipError(clip, data.Walk);
+        state.counters["Ratio"] = static_cast<f64>(data.Walk.Samples.size() * sizeof(JointTransform)) /
+                                  static_cast<f64>(clip.GetMemorySize());
+        state.counters["Keys"] = clip.GetKeyCount();
+        state.counters["RotationError"] = error.Rotation;
+        state.counters["TranslationError"] = error.Translation;
+    }
+    BENCHMARK(AnimationCompressClip)->Apply(AddJointCounts)->Unit(benchmark::kMillisecond);
+
+    void AnimationSampleClip(benchmark::State& state) {
+        const AnimationData& data = GetData(static_cast<u32>(state.range(0)));
+
+        Pose pose;
+        f32 time = 0.0f;
+        for (auto _ : state) {
+            SampleAnimation(data.WalkClip, time, pose);
+            benchmark::DoNotOptimize(pose.Packets.data());
+            time = std::fmod(time + 1.0f / 60.0f, data.WalkClip.Duration);
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(AnimationSampleClip)->Apply(AddJointCounts);
+
+    void AnimationBlendPoses(benchmark::State& state) {
+        const AnimationData& data = GetData(static_cast<u32>(state.range(0)));
+
+        Pose walk;
+        Pose run;
+        SampleAnimation(data.WalkClip, 0.5f, walk);
+        SampleAnimation(data.RunClip, 0.5f, run);
+
+        Pose result;
+        for (auto _ : state) {
+            BlendPoses(walk, run, 0.3f, result);
+            AddPose(result, walk, 0.5f, result);
+            benchmark::DoNotOptimize(result.Packets.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(AnimationBlendPoses)->Apply(AddJointCounts);
+
+    void AnimationLocalToModel(benchmark::State& state) {
+        const AnimationData& data = GetData(static_cast<u32>(state.range(0)));
+
+        Pose pose;
+        SampleAnimation(data.WalkClip, 0.5f, pose);
+
+        std::vector<glm::mat4> models(data.Skeleton->GetJointCount());
+        for (auto _ : state) {
+            ComputeModelMatrices(*data.Skeleton, pose, models);
+            benchmark::DoNotOptimize(models.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(AnimationLocalToModel)->Apply(AddJointCounts);
+
+    // One joint at a time on glm types, the baseline the packets replace.
+    void GlmLocalToModel(benchmark::State& state) {
+        const AnimationData& data = GetData(static_cast<u32>(state.range(0)));
+        const Skeleton& skeleton = *data.Skeleton;
+
+        Pose pose;
+        SampleAnimation(data.WalkClip, 0.5f, pose);
+
+        std::vector<JointTransform> locals(skeleton.GetJointCount());
+        for (u32 joint = 0; joint < locals.size(); joint++) {
+            locals[joint] = pose.GetJoint(joint);
+        }
+
+        std::vector<glm::mat4> models(skeleton.GetJointCount());
+        for (auto _ : state) {
+            for (u32 joint = 0; joint < locals.size(); joint++) {
+                glm::mat4 local = glm::mat4_cast(locals[joint].Rotation);
+                local[0] *= locals[joint].Scale.x;
+                local[1] *= locals[joint].Scale.y;
+                local[2] *= locals[joint].Scale.z;
+                local[3] = glm::vec4(locals[joint].Translation, 1.0f);
+
+                const u32 parent = skeleton.GetParentIndex(joint);
+                models[joint] = parent == InvalidJoint ? local : models[parent] * local;
+            }
+            benchmark::DoNotOptimize(models.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(GlmLocalToModel)->Apply(AddJointCounts);
+
+    // A crowd blending walk and run with a breathing layer on top, each character at its own time and weight.
+    void AnimationEvaluateCharacters(benchmark::State& state) {
+        const AnimationData& data = GetData(static_cast<u32>(state.range(0)));
+        const u32 jointCount = data.Skeleton->GetJointCount();
+
+        JobSystem jobSystem;
+        JobSystem* jobs = state.range(1) != 0 ? &jobSystem : nullptr;
+
+        std::mt19937 random(7);
+        std::uniform_real_distribution<f32> value(0.0f, 1.0f);
+
+        std::vector<AnimationLayer> layers(CharacterCount * 3);
+        std::vector<glm::mat4> models(static_cast<u64>(CharacterCount) * jointCount);
+        std::vector<CharacterAnimation> characters(CharacterCount);
+        for (u32 character = 0; character < CharacterCount; character++) {
+            const f32 time = value(random) * data.WalkClip.Duration;
+            layers[character * 3] = {&data.WalkClip, time, 1.0f, AnimationBlendMode::Blend};
+            layers[character * 3 + 1] = {&data.RunClip, time, value(random), AnimationBlendMode::Blend};
+            layers[character * 3 + 2] = {&data.BreatheClip, time, 1.0f, AnimationBlendMode::Additive};
+
+            characters[character].SkeletonRef = data.Skeleton.get();
+            characters[character].Layers = std::span(layers).subspan(character * 3, 3);
+            characters[character].ModelMatrices = std::span(models).subspan(character * jointCount, jointCount);
+        }
+
+        std::chrono::duration<f64, std::milli> elapsed{0.0};
+        for (auto _ : state) {
+            const auto start = std::chrono::steady_clock::now();
+            EvaluateCharacters(characters, jobs);
+            elapsed += std::chrono::steady_clock::now() - start;
+            benchmark::DoNotOptimize(models.data());
+
+            for (AnimationLayer& layer : layers) {
+                layer.Time = std::fmod(layer.Time + 1.0f / 60.0f, data.WalkClip.Duration);
+            }
+        }
+
+        state.counters["CharactersPerMs"] = static_cast<f64>(state.iterations()) * CharacterCount / elapsed.count();
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * CharacterCount);
+    }
+    BENCHMARK(AnimationEvaluateCharacters)
+        ->ArgNames({"Joints", "Parallel"})
+        ->ArgsProduct({{60, 90, 120}, {0, 1}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
@@ -0,0 +1,147 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Asset/AssetArchive.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 FileCount = 2048;
+    constexpr u32 FileSize = 16 * 1024;
+
+    struct ArchiveFixture {
+        std::filesystem::path Directory;
+        std::vector<std::string> Paths;
+        std::array<std::filesystem::path, 3> Archives; // Indexed by AssetCompression.
+    };
+
+    // Loose files and the same files packed with each compression, written once. The content compresses about as
+    // well as texture data does.
+    const ArchiveFixture& GetFixture() {
+        static const ArchiveFixture fixture = [] {
+            Logger::Init({.ConsoleOutput = false});
+
+            ArchiveFixture result;
+            result.Directory = std::filesystem::temp_directory_path() / "FlashlightArchiveBenchmarks";
+            std::filesystem::create_directories(result.Directory / "Loose");
+
+            std::array<AssetArchiveWriter, 3> writers;
+            std::vector<std::byte> content(FileSize);
+            u32 seed = 1;
+
+            for (u32 file = 0; file < FileCount; file++) {
+                for (u32 i = 0; i < FileSize; i++) {
+                    seed = seed * 1664525u + 1013904223u;
+                    content[i] = static_cast<std::byte>((i / 64 + file) ^ (seed >> 30));
+                }
+
+                result.Paths.push_back(fmt::format("Textures/Texture{0}.bin", file));
+                std::ofstream(result.Directory / "Loose" / fmt::format("Texture{0}.bin", file), std::ios::binary)
+                    .write(reinterpret_cast<const char*>(content.data()), FileSize);
+
+                for (u32 compression = 0; compression < writers.size(); compression++) {
+                    writers[compression].Add(result.Paths.back(), content, static_cast<AssetCompression>(compression));
+                }
+            }
+
+            for (u32 compression = 0; compression < writers.size(); compression++) {
+                result.Archives[compression] = result.Directory / fmt::format("Assets{0}.flpack", compression);
+                writers[compression].Write(result.Archives[compression]);
+            }
+
+            Logger::Shutdown();
+            return result;
+        }();
+
+        return fixture;
+    }
+
+    // Stands for whatever uses the content, reads a byte per cache line.
+    u64 TouchContent(const std::span<const std::byte> content) {
+        u64 checksum = 0;
+        for (u64 i = 0; i < content.size(); i += 64) {
+            checksum += static_cast<u8>(content[i]);
+        }
+
+        return checksum;
+    }
+
+    // Baseline, one open and one read per file.
+    void LooseFileRead(benchmark::State& state) {
+        const ArchiveFixture& fixture = GetFixture();
+        std::vector<std::byte> buffer(FileSize);
+
+        for (auto _ : state) {
+            u64 checksum = 0;
+            for (u32 file = 0; file < FileCount; file++) {
+                std::ifstream stream(fixture.Directory / "Loose" / fmt::format("Texture{0}.bin", file),
+                                     std::ios::binary);
+                stream.read(reinterpret_cast<char*>(buffer.data()), FileSize);
+                checksum += TouchContent(buffer);
+            }
+
+            benchmark::DoNotOptimize(checksum);
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * FileCount);
+        state.SetBytesProcessed(static_cast<i64>(state.iterations()) * FileCount * FileSize);
+    }
+    BENCHMARK(LooseFileRead)->UseRealTime();
+
+    // Opening the archive included. Uncompressed entries are used in place, compressed ones are decompressed into a
+    // buffer first. The argument is the AssetCompression.
+    void ArchiveRead(benchmark::State& state) {
+        Logger::Init({.ConsoleOutput = false});
+        {
+            const ArchiveFixture& fixture = GetFixture();
+            const auto compression = static_cast<AssetCompression>(state.range(0));
+            std::vector<std::byte> buffer(FileSize);
+
+            for (auto _ : state) {
+                AssetArchive archive;
+                archive.Open(fixture.Archives[state.range(0)]);
+
+                u64 checksum = 0;
+                for (const std::string& path : fixture.Paths) {
+                    const AssetArchiveEntry* entry = archive.Find(path);
+                    if (compression == AssetCompression::None) {
+                        checksum += TouchContent(archive.GetView(*entry));
+                    } else {
+                        archive.Read(*entry, buffer);
+                        checksum += TouchContent(buffer);
+                    }
+                }
+
+                benchmark::DoNotOptimize(checksum);
+            }
+
+            state.SetItemsProcessed(static_cast<i64>(state.iterations()) * FileCount);
+            state.SetBytesProcessed(static_cast<i64>(state.iterations()) * FileCount * FileSize);
+        }
+        Logger::Shutdown();
+    }
+    BENCHMARK(ArchiveRead)->Arg(0)->Arg(1)->Arg(2)->UseRealTime();
+
+    // Lookups from several threads at once, the archive has no lock to contend on.
+    void ArchiveLookup(benchmark::State& state) {
+        static AssetArchive archive;
+        const ArchiveFixture& fixture = GetFixture();
+        if (state.thread_index() == 0) {
+            archive.Open(fixture.Archives[0]);
+        }
+
+        u32 index = static_cast<u32>(state.thread_index()) * 97;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(archive.Find(fixture.Paths[index % FileCount]));
+            index += 13;
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()));
+    }
+    BENCHMARK(ArchiveLookup)->Threads(1)->Threads(4)->UseRealTime();
+}
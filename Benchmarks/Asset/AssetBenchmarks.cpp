@@ -0,0 +1,117 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Asset/AssetManager.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Private copies, the engine has its own stb_image.
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 TextureCount = 64;
+    constexpr u32 TextureSize = 256;
+
+    // Writes the textures once, noisy enough that decoding them isn't trivial.
+    const std::vector<std::filesystem::path>& GetTexturePaths() {
+        static const std::vector<std::filesystem::path> paths = [] {
+            const std::filesystem::path directory = std::filesystem::temp_directory_path() / "FlashlightBenchmarks";
+            std::filesystem::create_directories(directory);
+
+            std::vector<u8> pixels(TextureSize * TextureSize * 4);
+            u32 seed = 1;
+
+            std::vector<std::filesystem::path> result;
+            for (u32 texture = 0; texture < TextureCount; texture++) {
+                for (u32 i = 0; i < pixels.size(); i++) {
+                    seed = seed * 1664525u + 1013904223u;
+                    pixels[i] = static_cast<u8>((i / 4 + texture) ^ (seed >> 29));
+                }
+
+                result.push_back(directory / fmt::format("Texture{0}.png", texture));
+                stbi_write_png(result.back().string().c_str(), TextureSize, TextureSize, 4, pixels.data(),
+                               TextureSize * 4);
+            }
+
+            return result;
+        }();
+
+        return paths;
+    }
+
+    // Baseline, the main thread reads and decodes every texture itself.
+    void SynchronousLoad(benchmark::State& state) {
+        const auto& paths = GetTexturePaths();
+
+        for (auto _ : state) {
+            for (const std::filesystem::path& path : paths) {
+                i32 width;
+                i32 height;
+                i32 channels;
+                u8* pixels = stbi_load(path.string().c_str(), &width, &height, &channels, 4);
+                benchmark::DoNotOptimize(pixels);
+                stbi_image_free(pixels);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * TextureCount);
+    }
+    BENCHMARK(SynchronousLoad)->UseRealTime();
+
+    // The I/O thread count is the argument. MainThreadTime is what the main thread spends in LoadTexture and Update,
+    // the stall a frame would see.
+    void StreamingLoad(benchmark::State& state) {
+        Logger::Init({.ConsoleOutput = false});
+        {
+            const auto& paths = GetTexturePaths();
+
+            JobSystem jobSystem;
+            AssetManagerSettings settings;
+            settings.IoThreadCount = static_cast<u32>(state.range(0));
+            settings.Jobs = &jobSystem;
+            AssetManager assetManager(settings);
+
+            std::vector<AssetHandle> handles(TextureCount);
+            f64 mainThreadTime = 0.0;
+
+            for (auto _ : state) {
+                auto start = std::chrono::steady_clock::now();
+                for (u32 i = 0; i < TextureCount; i++) {
+                    handles[i] = assetManager.LoadTexture(paths[i]);
+                }
+                mainThreadTime += std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+
+                u32 done = 0;
+                while (done < TextureCount) {
+                    start = std::chrono::steady_clock::now();
+                    const u32 count = assetManager.Update();
+                    mainThreadTime += std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+
+                    done += count;
+                    if (count == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                for (const AssetHandle handle : handles) {
+                    assetManager.Release(handle);
+                }
+            }
+
+            state.SetItemsProcessed(static_cast<i64>(state.iterations()) * TextureCount);
+            state.counters["MainThreadTime"] = benchmark::Counter(mainThreadTime, benchmark::Counter::kAvgIterations);
+        }
+        Logger::Shutdown();
+    }
+    BENCHMARK(StreamingLoad)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+}
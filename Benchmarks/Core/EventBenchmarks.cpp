@@ -0,0 +1,290 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/EventBus.hpp>
+#include <FlashlightEngine/Core/EventQueue.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <memory>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 StreamLength = 1024;
+
+    struct EventSink {
+        u64 Count = 0;
+
+        void OnKeyDown(Event& event) {
+            Count += static_cast<KeyDownEvent&>(event).GetScancode();
+        }
+
+        void OnMouseMoved(const MouseMovedEvent& event) {
+            Count += static_cast<u64>(event.GetX());
+        }
+
+        void OnWindowResize(const WindowResizeEvent& event) {
+            Count += event.GetWidth();
+        }
+
+        void OnMouseButtonDown(const MouseButtonDownEvent& event) {
+            Count += static_cast<u64>(event.GetButton());
+        }
+    };
+
+    /*
+     * The dispatch path the handler table replaced, kept here as the baseline: the event type is read through the
+     * vtable and every handler is wrapped in a std::function for every event.
+     */
+    struct LegacyEvent {
+        virtual ~LegacyEvent() = default;
+        [[nodiscard]] virtual EventType GetEventType() const = 0;
+    };
+
+    template <EventType Type>
+    struct LegacyTypedEvent final : LegacyEvent {
+        i32 Value;
+
+        explicit LegacyTypedEvent(const i32 value) : Value(value) {
+        }
+
+        static EventType GetStaticType() {
+            return Type;
+        }
+
+        [[nodiscard]] EventType GetEventType() const override {
+            return GetStaticType();
+        }
+    };
+
+    class LegacyEventDispatcher {
+        LegacyEvent& m_Event;
+
+    public:
+        explicit LegacyEventDispatcher(LegacyEvent& event) : m_Event(event) {
+        }
+
+        template <typename T>
+        bool Dispatch(std::function<void(T&)> handler) {
+            if (m_Event.GetEventType() == T::GetStaticType()) {
+                handler(static_cast<T&>(m_Event));
+                return true;
+            }
+            return false;
+        }
+    };
+
+    // Like the application handlers before the table: OnEvent tries every handled type in turn.
+    struct LegacyEventSink {
+        u64 Count = 0;
+
+        void OnEvent(LegacyEvent& event) {
+            LegacyEventDispatcher dispatcher(event);
+            dispatcher.Dispatch<LegacyTypedEvent<EventType::KeyDown>>(BIND_EVENT_TO_EVENT_HANDLER(OnTyped));
+            dispatcher.Dispatch<LegacyTypedEvent<EventType::MouseMoved>>(BIND_EVENT_TO_EVENT_HANDLER(OnTyped));
+            dispatcher.Dispatch<LegacyTypedEvent<EventType::WindowResize>>(BIND_EVENT_TO_EVENT_HANDLER(OnTyped));
+            dispatcher.Dispatch<LegacyTypedEvent<EventType::MouseButtonDown>>(BIND_EVENT_TO_EVENT_HANDLER(OnTyped));
+        }
+
+        template <typename T>
+        void OnTyped(const T& event) {
+            Count += static_cast<u64>(event.Value);
+        }
+    };
+
+    // The four event types of the sinks above, in a fixed pseudo-random order.
+    std::vector<std::unique_ptr<Event>> BuildEventStream() {
+        std::vector<std::unique_ptr<Event>> events;
+        events.reserve(StreamLength);
+        for (u32 i = 0; i < StreamLength; i++) {
+            switch ((i * 7 + i / 5) % 4) {
+            case 0: events.push_back(std::make_unique<KeyDownEvent>(static_cast<i32>(i), 0)); break;
+            case 1: events.push_back(std::make_unique<MouseMovedEvent>(static_cast<f32>(i), 0.0f)); break;
+            case 2: events.push_back(std::make_unique<WindowResizeEvent>(i, i)); break;
+            default: events.push_back(std::make_unique<MouseButtonDownEvent>(static_cast<i32>(i))); break;
+            }
+        }
+
+        return events;
+    }
+
+    std::vector<std::unique_ptr<LegacyEvent>> BuildLegacyEventStream() {
+        std::vector<std::unique_ptr<LegacyEvent>> events;
+        events.reserve(StreamLength);
+        for (u32 i = 0; i < StreamLength; i++) {
+            const auto value = static_cast<i32>(i);
+            switch ((i * 7 + i / 5) % 4) {
+            case 0: events.push_back(std::make_unique<LegacyTypedEvent<EventType::KeyDown>>(value)); break;
+            case 1: events.push_back(std::make_unique<LegacyTypedEvent<EventType::MouseMoved>>(value)); break;
+            case 2: events.push_back(std::make_unique<LegacyTypedEvent<EventType::WindowResize>>(value)); break;
+            default: events.push_back(std::make_unique<LegacyTypedEvent<EventType::MouseButtonDown>>(value)); break;
+            }
+        }
+
+        return events;
+    }
+
+    void EventConstruction(benchmark::State& state) {
+        i32 scancode = 0;
+        for (auto _ : state) {
+            KeyDownEvent event(scancode++ & 511, 0);
+            benchmark::DoNotOptimize(event);
+        }
+    }
+    BENCHMARK(EventConstruction);
+
+    void EventDispatcherDispatch(benchmark::State& state) {
+        KeyDownEvent event(65, 0);
+        u64 count = 0;
+
+        for (auto _ : state) {
+            EventDispatcher dispatcher(event);
+            dispatcher.Dispatch<KeyDownEvent>([&count](const KeyDownEvent& keyDown) {
+                count += keyDown.GetScancode();
+            });
+            benchmark::DoNotOptimize(count);
+        }
+    }
+    BENCHMARK(EventDispatcherDispatch);
+
+    void EventHandlerTableDispatch(benchmark::State& state) {
+        EventSink sink;
+        EventHandlerTable table;
+        table.Register<KeyDownEvent, &EventSink::OnKeyDown>(&sink);
+
+        KeyDownEvent event(65, 0);
+        for (auto _ : state) {
+            table.Dispatch(event);
+        }
+
+        benchmark::DoNotOptimize(sink.Count);
+    }
+    BENCHMARK(EventHandlerTableDispatch);
+
+    // The same mixed stream through the three dispatch paths, items_per_second is events per second.
+    void LegacyEventDispatchStream(benchmark::State& state) {
+        const std::vector<std::unique_ptr<LegacyEvent>> events = BuildLegacyEventStream();
+        LegacyEventSink sink;
+
+        for (auto _ : state) {
+            for (const std::unique_ptr<LegacyEvent>& event : events) {
+                sink.OnEvent(*event);
+            }
+        }
+
+        benchmark::DoNotOptimize(sink.Count);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * StreamLength);
+    }
+    BENCHMARK(LegacyEventDispatchStream);
+
+    void EventDispatcherStream(benchmark::State& state) {
+        const std::vector<std::unique_ptr<Event>> events = BuildEventStream();
+        EventSink sink;
+
+        for (auto _ : state) {
+            for (const std::unique_ptr<Event>& event : events) {
+                EventDispatcher dispatcher(*event);
+                dispatcher.Dispatch<KeyDownEvent>([&sink](KeyDownEvent& keyDown) {
+                    sink.OnKeyDown(keyDown);
+                });
+                dispatcher.Dispatch<MouseMovedEvent>([&sink](const MouseMovedEvent& mouseMoved) {
+                    sink.OnMouseMoved(mouseMoved);
+                });
+                dispatcher.Dispatch<WindowResizeEvent>([&sink](const WindowResizeEvent& resize) {
+                    sink.OnWindowResize(resize);
+                });
+                dispatcher.Dispatch<MouseButtonDownEvent>([&sink](const MouseButtonDownEvent& buttonDown) {
+                    sink.OnMouseButtonDown(buttonDown);
+                });
+            }
+        }
+
+        benchmark::DoNotOptimize(sink.Count);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * StreamLength);
+    }
+    BENCHMARK(EventDispatcherStream);
+
+    void EventHandlerTableStream(benchmark::State& state) {
+        const std::vector<std::unique_ptr<Event>> events = BuildEventStream();
+        EventSink sink;
+        EventHandlerTable table;
+        table.Register<KeyDownEvent, &EventSink::OnKeyDown>(&sink);
+        table.Register<MouseMovedEvent, &EventSink::OnMouseMoved>(&sink);
+        table.Register<WindowResizeEvent, &EventSink::OnWindowResize>(&sink);
+        table.Register<MouseButtonDownEvent, &EventSink::OnMouseButtonDown>(&sink);
+
+        for (auto _ : state) {
+            for (const std::unique_ptr<Event>& event : events) {
+                table.Dispatch(*event);
+            }
+        }
+
+        benchmark::DoNotOptimize(sink.Count);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * StreamLength);
+    }
+    BENCHMARK(EventHandlerTableStream);
+
+    // A frame worth of window events going through the queue.
+    void EventQueuePushDrain(benchmark::State& state) {
+        const auto eventCount = static_cast<u32>(state.range(0));
+        EventQueue queue;
+        u64 dispatched = 0;
+
+        for (auto _ : state) {
+            for (u32 i = 0; i < eventCount; i += 2) {
+                queue.Push(KeyDownEvent(static_cast<i32>(i), 0));
+                queue.Push(MouseButtonDownEvent(static_cast<i32>(i)));
+            }
+
+            queue.Drain([&dispatched](const Event&) {
+                dispatched++;
+            });
+        }
+
+        benchmark::DoNotOptimize(dispatched);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * eventCount);
+    }
+    BENCHMARK(EventQueuePushDrain)->Arg(16)->Arg(EventQueueCapacity);
+
+    void EventBusPublishDrain(benchmark::State& state) {
+        const auto eventCount = static_cast<u32>(state.range(0));
+        EventBus bus;
+        u64 dispatched = 0;
+
+        for (auto _ : state) {
+            for (u32 i = 0; i < eventCount; i++) {
+                bus.Publish(UserEvent(i));
+            }
+
+            bus.Drain([&dispatched](const Event&) {
+                dispatched++;
+            });
+        }
+
+        benchmark::DoNotOptimize(dispatched);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * eventCount);
+    }
+    BENCHMARK(EventBusPublishDrain)->Arg(64)->Arg(1024);
+
+    // Every benchmark thread publishes, the first one also drains, like workers posting to the main thread.
+    void EventBusContendedPublish(benchmark::State& state) {
+        static EventBus bus(1 << 16);
+
+        for (auto _ : state) {
+            for (u32 i = 0; i < 64; i++) {
+                bus.Publish(UserEvent(i));
+            }
+
+            if (state.thread_index() == 0) {
+                bus.Drain([](const Event&) {
+                });
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * 64);
+    }
+    BENCHMARK(EventBusContendedPublish)->ThreadRange(1, 8)->UseRealTime();
+}
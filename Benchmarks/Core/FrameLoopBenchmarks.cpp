@@ -0,0 +1,109 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Application.hpp>
+#include <FlashlightEngine/Core/HeadlessWindow.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 FramesPerIteration = 100;
+
+    WindowProperties MakeHeadlessProperties() {
+        WindowProperties properties(1280, 720, "FlashlightBenchmarks", false, false);
+        properties.Backend = WindowBackend::Headless;
+        return properties;
+    }
+
+    LoggerSettings MakeQuietLoggerSettings() {
+        LoggerSettings settings;
+        settings.ConsoleOutput = false;
+        return settings;
+    }
+
+    // Empty application, what is measured is the engine's own per-frame work.
+    class BenchmarkApplication final : public Application {
+        u32 m_FramesLeft = 0;
+
+    public:
+        BenchmarkApplication() : Application(MakeHeadlessProperties(), MakeQuietLoggerSettings()) {
+        }
+
+        void RunFrames(const u32 frameCount) {
+            m_FramesLeft = frameCount;
+            m_IsRunning = true;
+            Run();
+        }
+
+        HeadlessWindow& GetHeadlessWindow() {
+            return static_cast<HeadlessWindow&>(*m_Window);
+        }
+
+    protected:
+        void OnUpdate() override {
+        }
+
+        void OnEvent(Event&) override {
+        }
+
+        void OnRender(f32) override {
+            if (--m_FramesLeft == 0) {
+                Close();
+            }
+        }
+    };
+
+    void HeadlessFrameLoop(benchmark::State& state) {
+        BenchmarkApplication application;
+
+        for (auto _ : state) {
+            application.RunFrames(FramesPerIteration);
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * FramesPerIteration);
+    }
+    BENCHMARK(HeadlessFrameLoop);
+
+    void HeadlessFrameLoopFixedStep(benchmark::State& state) {
+        BenchmarkApplication application;
+
+        // Four simulation steps for every 60 Hz frame.
+        FrameLoopSettings settings;
+        settings.Mode = LoopMode::FixedStep;
+        settings.FixedDeltaTime = 1.0f / 240.0f;
+        application.SetFrameLoopSettings(settings);
+
+        for (auto _ : state) {
+            application.RunFrames(FramesPerIteration);
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * FramesPerIteration);
+    }
+    BENCHMARK(HeadlessFrameLoopFixedStep);
+
+    // Every frame carries a burst of input going through the window queue, the handlers and the input snapshot.
+    void HeadlessFrameLoopWithInput(benchmark::State& state) {
+        BenchmarkApplication application;
+        HeadlessWindow& window = application.GetHeadlessWindow();
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            const f64 start = window.GetTime();
+            for (u32 frame = 1; frame <= FramesPerIteration; frame++) {
+                const f64 time = start + frame * window.GetTimeStep();
+                window.ScheduleEvent(time, KeyDownEvent(static_cast<i32>(Keys::W), 0));
+                window.ScheduleEvent(time, MouseMovedEvent(static_cast<f32>(frame), 0.0f));
+                window.ScheduleEvent(time, KeyUpEvent(static_cast<i32>(Keys::W)));
+            }
+            state.ResumeTiming();
+
+            application.RunFrames(FramesPerIteration);
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * FramesPerIteration);
+    }
+    BENCHMARK(HeadlessFrameLoopWithInput);
+}
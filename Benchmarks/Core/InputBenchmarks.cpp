@@ -0,0 +1,42 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Input.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace Flashlight;
+
+namespace {
+    void InputSnapshotQueries(benchmark::State& state) {
+        Input input;
+        input.OnEvent(KeyDownEvent(static_cast<i32>(Keys::W), 0));
+        input.OnEvent(MouseButtonDownEvent(static_cast<i32>(MouseButtons::Left)));
+        input.Publish();
+
+        u32 key = 0;
+        for (auto _ : state) {
+            const InputSnapshot& snapshot = input.GetSnapshot();
+            const auto queried = static_cast<Keys>(key++ & (InputKeyCount - 1));
+
+            benchmark::DoNotOptimize(snapshot.IsKeyDown(queried) + snapshot.WasKeyPressed(queried) +
+                                     snapshot.WasMouseButtonReleased(MouseButtons::Left));
+        }
+    }
+    BENCHMARK(InputSnapshotQueries);
+
+    void InputPublish(benchmark::State& state) {
+        Input input;
+
+        i32 key = 0;
+        for (auto _ : state) {
+            input.OnEvent(KeyDownEvent(key, 0));
+            input.OnEvent(KeyUpEvent(key));
+            input.OnEvent(MouseMovedEvent(static_cast<f32>(key), 0.0f));
+            input.Publish();
+            key = (key + 1) & 511;
+        }
+    }
+    BENCHMARK(InputPublish);
+}
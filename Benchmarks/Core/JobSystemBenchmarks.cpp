@@ -0,0 +1,129 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <numeric>
+
+using namespace Flashlight;
+
+namespace {
+    // A dependent multiply-add chain, the compiler can neither vectorize nor shorten it.
+    f32 SpinWork(const u32 iterations) {
+        f32 value = 1.0f;
+        for (u32 i = 0; i < iterations; i++) {
+            value = value * 0.999f + 0.001f;
+            benchmark::DoNotOptimize(value);
+        }
+        return value;
+    }
+
+    // SpinWork iterations taking about one microsecond on this machine.
+    u32 GetMicrosecondIterations() {
+        static const u32 iterations = [] {
+            constexpr u32 SampleIterations = 1 << 22;
+            const auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(SpinWork(SampleIterations));
+            const std::chrono::duration<f64, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+            return std::max(static_cast<u32>(SampleIterations / elapsed.count()), 1u);
+        }();
+        return iterations;
+    }
+
+    // Worker counts from 1 to every hardware thread.
+    void WorkerCounts(benchmark::internal::Benchmark* benchmark) {
+        const i64 hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        for (i64 workerCount = 1; workerCount < hardwareThreads; workerCount *= 2) {
+            benchmark->Arg(workerCount);
+        }
+        benchmark->Arg(hardwareThreads);
+    }
+
+    // Worker count scaling of jobs of the given length, one job per ParallelFor range.
+    void RunSpinJobs(benchmark::State& state, const u32 jobCount, const u32 jobMicroseconds) {
+        Logger::Init({.ConsoleOutput = false});
+        {
+            JobSystem jobSystem(static_cast<u32>(state.range(0)));
+            const u32 iterations = GetMicrosecondIterations() * jobMicroseconds;
+
+            for (auto _ : state) {
+                jobSystem.ParallelFor(jobCount, 1, [iterations](const u32, const u32) {
+                    benchmark::DoNotOptimize(SpinWork(iterations));
+                });
+            }
+
+            state.SetItemsProcessed(static_cast<i64>(state.iterations()) * jobCount);
+        }
+        Logger::Shutdown();
+    }
+
+    // About 1 µs jobs, where the scheduling overhead shows.
+    void ParallelForFineJobs(benchmark::State& state) {
+        RunSpinJobs(state, 16384, 1);
+    }
+    BENCHMARK(ParallelForFineJobs)->Apply(WorkerCounts)->UseRealTime();
+
+    // About 200 µs jobs, where only the load balancing matters.
+    void ParallelForCoarseJobs(benchmark::State& state) {
+        RunSpinJobs(state, 256, 200);
+    }
+    BENCHMARK(ParallelForCoarseJobs)->Apply(WorkerCounts)->UseRealTime();
+
+    void ScheduleWait(benchmark::State& state) {
+        Logger::Init({.ConsoleOutput = false});
+        {
+            JobSystem jobSystem;
+            const auto jobCount = static_cast<u32>(state.range(0));
+
+            for (auto _ : state) {
+                JobCounter counter;
+                for (u32 i = 0; i < jobCount; i++) {
+                    jobSystem.Schedule([] {
+                    }, &counter);
+                }
+                jobSystem.Wait(counter);
+            }
+
+            state.SetItemsProcessed(static_cast<i64>(state.iterations()) * jobCount);
+        }
+        Logger::Shutdown();
+    }
+    BENCHMARK(ScheduleWait)->Arg(64)->Arg(1024)->UseRealTime();
+
+    // Worker count scaling of a memory bound loop.
+    void ParallelForSum(benchmark::State& state) {
+        Logger::Init({.ConsoleOutput = false});
+        {
+            JobSystem jobSystem(static_cast<u32>(state.range(0)));
+
+            std::vector<f32> values(1 << 22);
+            std::iota(values.begin(), values.end(), 0.0f);
+
+            for (auto _ : state) {
+                std::array<f64, 256> partialSums{};
+                std::atomic<u32> nextSlot{0};
+
+                jobSystem.ParallelFor(static_cast<u32>(values.size()), 1 << 14,
+                                      [&values, &partialSums, &nextSlot](const u32 begin, const u32 end) {
+                                          f64 sum = 0.0;
+                                          for (u32 i = begin; i < end; i++) {
+                                              sum += values[i];
+                                          }
+                                          partialSums[nextSlot.fetch_add(1, std::memory_order_relaxed)] = sum;
+                                      });
+
+                benchmark::DoNotOptimize(partialSums.data());
+            }
+
+            state.SetBytesProcessed(static_cast<i64>(state.iterations() * values.size() * sizeof(f32)));
+        }
+        Logger::Shutdown();
+    }
+    BENCHMARK(ParallelForSum)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+}
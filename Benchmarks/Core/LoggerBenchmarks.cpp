@@ -0,0 +1,166 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/BinaryLog.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+using namespace Flashlight;
+
+namespace {
+    /*
+     * LatencyRecorder : Duration of every log call on the caller thread, reported as p50 and p99 counters next to the
+     * mean google-benchmark prints, which hides the rare slow calls. Reading the TSC around each call adds a few
+     * nanoseconds to the numbers.
+     */
+    class LatencyRecorder {
+        static constexpr u64 Capacity = 1 << 20; // Runs making more calls keep the last ones.
+
+        std::vector<u64> m_Ticks;
+        u64 m_Count = 0;
+        u64 m_StartTicks;
+        std::chrono::steady_clock::time_point m_StartTime;
+
+    public:
+        LatencyRecorder() : m_Ticks(Capacity), m_StartTicks(Profiler::ReadTimestamp()),
+                            m_StartTime(std::chrono::steady_clock::now()) {
+        }
+
+        template <typename Call>
+        void Measure(Call&& call) {
+            const u64 start = Profiler::ReadTimestamp();
+            call();
+            m_Ticks[m_Count++ & (Capacity - 1)] = Profiler::ReadTimestamp() - start;
+        }
+
+        void Report(benchmark::State& state) {
+            if (m_Count == 0) {
+                return;
+            }
+
+            // Ticks are converted with the rate measured over the whole run.
+            const std::chrono::duration<f64, std::nano> elapsed = std::chrono::steady_clock::now() - m_StartTime;
+            const f64 nanosecondsPerTick = elapsed.count() / static_cast<f64>(Profiler::ReadTimestamp() - m_StartTicks);
+
+            const auto samples = std::span(m_Ticks).first(std::min(m_Count, Capacity));
+            const auto percentile = [&samples, nanosecondsPerTick](const f64 fraction) {
+                const auto nth = samples.begin() + static_cast<i64>(fraction * static_cast<f64>(samples.size() - 1));
+                std::nth_element(samples.begin(), nth, samples.end());
+                return static_cast<f64>(*nth) * nanosecondsPerTick;
+            };
+
+            state.counters["p50_ns"] = percentile(0.5);
+            state.counters["p99_ns"] = percentile(0.99);
+        }
+    };
+
+    // Messages go to a callback that throws them away, so the numbers don't include the console.
+    void InitLogger(const LogMode mode) {
+        LoggerSettings settings;
+        settings.Mode = mode;
+        settings.OverflowPolicy = LogOverflowPolicy::DropNewest;
+        settings.ConsoleOutput = false;
+
+        Logger::Init(settings);
+        Logger::AddEngineCallback([](const spdlog::level::level_enum&, const std::string& message) {
+            benchmark::DoNotOptimize(message.data());
+        });
+    }
+
+    void LogCallSynchronous(benchmark::State& state) {
+        InitLogger(LogMode::Synchronous);
+
+        LatencyRecorder latencies;
+        u64 frame = 0;
+        for (auto _ : state) {
+            latencies.Measure([&frame] {
+                FL_ENGINE_WARN(fmt::format("Frame {0} took {1:.3f} ms.", frame++, 16.6));
+            });
+        }
+        latencies.Report(state);
+
+        Logger::Shutdown();
+    }
+    BENCHMARK(LogCallSynchronous);
+
+    void LogCallAsynchronous(benchmark::State& state) {
+        InitLogger(LogMode::Asynchronous);
+
+        LatencyRecorder latencies;
+        u64 frame = 0;
+        for (auto _ : state) {
+            latencies.Measure([&frame] {
+                FL_ENGINE_WARN(fmt::format("Frame {0} took {1:.3f} ms.", frame++, 16.6));
+            });
+        }
+        latencies.Report(state);
+
+        state.counters["Dropped"] = static_cast<f64>(Logger::GetDroppedMessageCount());
+        Logger::Shutdown();
+    }
+    BENCHMARK(LogCallAsynchronous);
+
+    // A message below the runtime level, what a disabled trace costs when it is compiled in.
+    void LogCallFiltered(benchmark::State& state) {
+        InitLogger(LogMode::Synchronous);
+        Logger::GetEngineLogger()->set_level(spdlog::level::err);
+
+        LatencyRecorder latencies;
+        u64 frame = 0;
+        for (auto _ : state) {
+            latencies.Measure([&frame] {
+                Log::EngineWarn(fmt::format("Frame {0} took {1:.3f} ms.", frame++, 16.6));
+            });
+        }
+        latencies.Report(state);
+
+        Logger::Shutdown();
+    }
+    BENCHMARK(LogCallFiltered);
+
+    void LogCallLazyFiltered(benchmark::State& state) {
+        InitLogger(LogMode::Synchronous);
+        Logger::GetEngineLogger()->set_level(spdlog::level::err);
+
+        LatencyRecorder latencies;
+        u64 frame = 0;
+        for (auto _ : state) {
+            latencies.Measure([&frame] {
+                Log::EngineWarnLazy([&frame] {
+                    return fmt::format("Frame {0} took {1:.3f} ms.", frame++, 16.6);
+                });
+            });
+        }
+        latencies.Report(state);
+
+        Logger::Shutdown();
+    }
+    BENCHMARK(LogCallLazyFiltered);
+
+    void BinaryLogCall(benchmark::State& state) {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "FlashlightBenchmarks.fllog";
+        BinaryLog::Open(path, 512ull * 1024 * 1024);
+
+        LatencyRecorder latencies;
+        u64 frame = 0;
+        for (auto _ : state) {
+            latencies.Measure([&frame] {
+                FL_BINARY_WARN("Frame {0} took {1:.3f} ms.", frame++, 16.6);
+            });
+        }
+        latencies.Report(state);
+
+        // Once the file is full, calls only count the dropped record.
+        state.counters["Dropped"] = static_cast<f64>(BinaryLog::GetDroppedRecordCount());
+        BinaryLog::Close();
+        std::filesystem::remove(path);
+    }
+    BENCHMARK(BinaryLogCall);
+}
@@ -0,0 +1,136 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Memory/FrameArena.hpp>
+#include <FlashlightEngine/Core/Memory/PoolAllocator.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 AllocationsPerIteration = 1024;
+
+    struct Particle {
+        f32 Position[3];
+        f32 Velocity[3];
+        f32 Lifetime;
+        u32 Flags;
+    };
+
+    // Baseline the arenas and pools are compared against.
+    void NewDelete(benchmark::State& state) {
+        std::vector<Particle*> particles(AllocationsPerIteration);
+
+        for (auto _ : state) {
+            for (auto& particle : particles) {
+                particle = new Particle();
+            }
+            benchmark::ClobberMemory();
+
+            for (const auto particle : particles) {
+                delete particle;
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * AllocationsPerIteration);
+    }
+    BENCHMARK(NewDelete);
+
+    void LinearArenaAllocate(benchmark::State& state) {
+        LinearArena arena(AllocationsPerIteration * sizeof(Particle) * 2);
+
+        for (auto _ : state) {
+            for (u32 i = 0; i < AllocationsPerIteration; i++) {
+                benchmark::DoNotOptimize(arena.New<Particle>());
+            }
+
+            arena.Reset();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * AllocationsPerIteration);
+    }
+    BENCHMARK(LinearArenaAllocate);
+
+    // Several threads bumping the same arena, like jobs allocating from the frame arena.
+    void LinearArenaContendedAllocate(benchmark::State& state) {
+        static LinearArena arena(64ull * 1024 * 1024);
+
+        for (auto _ : state) {
+            for (u32 i = 0; i < AllocationsPerIteration; i++) {
+                benchmark::DoNotOptimize(arena.allocate(sizeof(Particle), alignof(Particle)));
+            }
+
+            if (state.thread_index() == 0 && arena.GetStatistics().AllocatedBytes > 32ull * 1024 * 1024) {
+                state.PauseTiming();
+                arena.Reset();
+                state.ResumeTiming();
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * AllocationsPerIteration);
+    }
+    BENCHMARK(LinearArenaContendedAllocate)->Threads(1)->Threads(4);
+
+    void ObjectPoolCreateDestroy(benchmark::State& state) {
+        ObjectPool<Particle> pool(AllocationsPerIteration);
+        std::vector<Particle*> particles(AllocationsPerIteration);
+
+        for (auto _ : state) {
+            for (auto& particle : particles) {
+                particle = pool.Create();
+            }
+            benchmark::ClobberMemory();
+
+            for (const auto particle : particles) {
+                pool.Destroy(particle);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * AllocationsPerIteration);
+    }
+    BENCHMARK(ObjectPoolCreateDestroy);
+
+    void FrameArenaPmrVector(benchmark::State& state) {
+        FrameArena frameArena(1024 * 1024);
+
+        for (auto _ : state) {
+            frameArena.BeginFrame();
+
+            std::pmr::vector<u32> values(&frameArena.GetCurrent());
+            for (u32 i = 0; i < AllocationsPerIteration; i++) {
+                values.push_back(i);
+            }
+            benchmark::DoNotOptimize(values.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * AllocationsPerIteration);
+    }
+    BENCHMARK(FrameArenaPmrVector);
+
+    void HeapPmrVector(benchmark::State& state) {
+        for (auto _ : state) {
+            std::pmr::vector<u32> values(std::pmr::new_delete_resource());
+            for (u32 i = 0; i < AllocationsPerIteration; i++) {
+                values.push_back(i);
+            }
+            benchmark::DoNotOptimize(values.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * AllocationsPerIteration);
+    }
+    BENCHMARK(HeapPmrVector);
+
+    void ScratchScopeAllocate(benchmark::State& state) {
+        for (auto _ : state) {
+            const ScratchScope scope;
+            for (u32 i = 0; i < 64; i++) {
+                benchmark::DoNotOptimize(scope.GetArena().New<Particle>());
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * 64);
+    }
+    BENCHMARK(ScratchScopeAllocate);
+}
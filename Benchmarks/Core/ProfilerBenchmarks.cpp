@@ -0,0 +1,33 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace Flashlight;
+
+namespace {
+    // Cost of one zone, the buffer is collected regularly so the zones are really recorded and not dropped.
+    void ProfileZoneOverhead(benchmark::State& state) {
+        Profiler::Init();
+
+        u32 zoneCount = 0;
+        for (auto _ : state) {
+            {
+                const ProfileZone zone("Benchmark");
+            }
+
+            if (++zoneCount == 4096) {
+                state.PauseTiming();
+                Profiler::EndFrame();
+                zoneCount = 0;
+                state.ResumeTiming();
+            }
+        }
+
+        Profiler::Shutdown();
+    }
+    BENCHMARK(ProfileZoneOverhead);
+}
@@ -0,0 +1,250 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Math/BatchMath.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    // About 200 KB of positions, they stay in L2 so the runs compare the kernels rather than the memory.
+    constexpr u32 ElementCount = 16'384;
+
+    struct BatchData {
+        std::vector<glm::vec3> Positions;
+        std::vector<glm::vec3> Velocities;
+        std::vector<glm::mat4> Matrices;
+
+        std::vector<Vec3x16> PositionBlocks;
+        std::vector<Vec3x16> VelocityBlocks;
+        std::vector<Mat4x16> MatrixBlocks;
+    };
+
+    glm::mat4 MakeMatrix(std::mt19937& random) {
+        std::uniform_real_distribution<f32> value(-1.0f, 1.0f);
+
+        glm::mat4 matrix(1.0f);
+        for (u32 column = 0; column < 4; column++) {
+            for (u32 row = 0; row < 3; row++) {
+                matrix[column][row] = value(random);
+            }
+        }
+
+        return matrix;
+    }
+
+    const BatchData& GetData() {
+        static const BatchData data = [] {
+            std::mt19937 random(42);
+            std::uniform_real_distribution<f32> value(-10.0f, 10.0f);
+
+            BatchData result;
+            for (u32 i = 0; i < ElementCount; i++) {
+                result.Positions.emplace_back(value(random), value(random), value(random));
+                result.Velocities.emplace_back(value(random), value(random), value(random));
+                result.Matrices.push_back(MakeMatrix(random));
+            }
+
+            const u32 blockCount = GetBatchBlockCount(ElementCount);
+            result.PositionBlocks.resize(blockCount);
+            result.VelocityBlocks.resize(blockCount);
+            result.MatrixBlocks.resize(blockCount);
+            PackVectors(result.Positions, result.PositionBlocks);
+            PackVectors(result.Velocities, result.VelocityBlocks);
+            PackMatrices(result.Matrices, result.MatrixBlocks);
+            return result;
+        }();
+
+        return data;
+    }
+
+    // Selects the level of the run, levels the CPU doesn't have are skipped. Restored when the run ends.
+    class SimdLevelScope {
+        SimdLevel m_Previous;
+
+    public:
+        explicit SimdLevelScope(benchmark::State& state) : m_Previous(GetSimdLevel()) {
+            const auto level = static_cast<SimdLevel>(state.range(0));
+            if (level > GetSupportedSimdLevel() || GetBatchKernels(level) == nullptr) {
+                state.SkipWithError("Level not supported by this CPU or build.");
+            }
+
+            SetSimdLevel(level);
+            state.SetLabel(std::string(GetSimdLevelName(level)));
+        }
+
+        ~SimdLevelScope() {
+            SetSimdLevel(m_Previous);
+        }
+
+        SimdLevelScope(const SimdLevelScope&) = delete;
+        SimdLevelScope(SimdLevelScope&&) = delete;
+
+        SimdLevelScope& operator=(const SimdLevelScope&) = delete;
+        SimdLevelScope& operator=(SimdLevelScope&&) = delete;
+    };
+
+    void AddSimdLevels(benchmark::internal::Benchmark* benchmark) {
+        benchmark->ArgName("Level");
+        for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse42, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            benchmark->Arg(static_cast<i64>(level));
+        }
+    }
+
+    void BatchTransformPoints(benchmark::State& state) {
+        const BatchData& data = GetData();
+        const SimdLevelScope scope(state);
+
+        const glm::mat4 matrix = data.Matrices[0];
+        std::vector<Vec3x16> result(data.PositionBlocks.size());
+        for (auto _ : state) {
+            TransformPoints(matrix, data.PositionBlocks, result);
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(BatchTransformPoints)->Apply(AddSimdLevels);
+
+    // Each point by its own matrix, like linear blend skinning with one bone.
+    void BatchTransformPointsPerLane(benchmark::State& state) {
+        const BatchData& data = GetData();
+        const SimdLevelScope scope(state);
+
+        std::vector<Vec3x16> result(data.PositionBlocks.size());
+        for (auto _ : state) {
+            TransformPoints(data.MatrixBlocks, data.PositionBlocks, result);
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(BatchTransformPointsPerLane)->Apply(AddSimdLevels);
+
+    // A parent matrix applied to every local matrix, the inner loop of a transform hierarchy update.
+    void BatchMultiplyMatrices(benchmark::State& state) {
+        const BatchData& data = GetData();
+        const SimdLevelScope scope(state);
+
+        const glm::mat4 parent = data.Matrices[0];
+        std::vector<Mat4x16> result(data.MatrixBlocks.size());
+        for (auto _ : state) {
+            MultiplyMatrices(parent, data.MatrixBlocks, result);
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(BatchMultiplyMatrices)->Apply(AddSimdLevels);
+
+    void BatchNormalizeVectors(benchmark::State& state) {
+        const BatchData& data = GetData();
+        const SimdLevelScope scope(state);
+
+        std::vector<Vec3x16> result(data.VelocityBlocks.size());
+        for (auto _ : state) {
+            NormalizeVectors(data.VelocityBlocks, result);
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(BatchNormalizeVectors)->Apply(AddSimdLevels);
+
+    // Particle integration, positions += velocities * dt in place.
+    void BatchIntegrateParticles(benchmark::State& state) {
+        const BatchData& data = GetData();
+        const SimdLevelScope scope(state);
+
+        std::vector<Vec3x16> positions = data.PositionBlocks;
+        for (auto _ : state) {
+            MultiplyAddVectors(positions, data.VelocityBlocks, 1.0f / 60.0f, positions);
+            benchmark::DoNotOptimize(positions.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(BatchIntegrateParticles)->Apply(AddSimdLevels);
+
+    // The same operations on glm arrays, the baseline the batch versions replace.
+    void GlmTransformPoints(benchmark::State& state) {
+        const BatchData& data = GetData();
+
+        const glm::mat4 matrix = data.Matrices[0];
+        std::vector<glm::vec3> result(ElementCount);
+        for (auto _ : state) {
+            for (u32 i = 0; i < ElementCount; i++) {
+                result[i] = glm::vec3(matrix * glm::vec4(data.Positions[i], 1.0f));
+            }
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(GlmTransformPoints);
+
+    void GlmTransformPointsPerLane(benchmark::State& state) {
+        const BatchData& data = GetData();
+
+        std::vector<glm::vec3> result(ElementCount);
+        for (auto _ : state) {
+            for (u32 i = 0; i < ElementCount; i++) {
+                result[i] = glm::vec3(data.Matrices[i] * glm::vec4(data.Positions[i], 1.0f));
+            }
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(GlmTransformPointsPerLane);
+
+    void GlmMultiplyMatrices(benchmark::State& state) {
+        const BatchData& data = GetData();
+
+        const glm::mat4 parent = data.Matrices[0];
+        std::vector<glm::mat4> result(ElementCount);
+        for (auto _ : state) {
+            for (u32 i = 0; i < ElementCount; i++) {
+                result[i] = parent * data.Matrices[i];
+            }
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(GlmMultiplyMatrices);
+
+    void GlmNormalizeVectors(benchmark::State& state) {
+        const BatchData& data = GetData();
+
+        std::vector<glm::vec3> result(ElementCount);
+        for (auto _ : state) {
+            for (u32 i = 0; i < ElementCount; i++) {
+                result[i] = glm::normalize(data.Velocities[i]);
+            }
+            benchmark::DoNotOptimize(result.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(GlmNormalizeVectors);
+
+    void GlmIntegrateParticles(benchmark::State& state) {
+        const BatchData& data = GetData();
+
+        std::vector<glm::vec3> positions = data.Positions;
+        for (auto _ : state) {
+            for (u32 i = 0; i < ElementCount; i++) {
+                positions[i] += data.Velocities[i] * (1.0f / 60.0f);
+            }
+            benchmark::DoNotOptimize(positions.data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ElementCount);
+    }
+    BENCHMARK(GlmIntegrateParticles);
+}
@@ -0,0 +1,162 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Mesh/MeshOptimizer.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 GridSize = 1024; // Two million triangles.
+    constexpr u32 TriangleCount = GridSize * GridSize * 2;
+
+    // A bumpy grid with its triangles shuffled and one vertex per corner, like an exporter that doesn't share
+    // vertices would write it.
+    MeshData MakeUnindexedGrid() {
+        std::vector<std::array<u32, 3>> triangles;
+        triangles.reserve(TriangleCount);
+        for (u32 y = 0; y < GridSize; y++) {
+            for (u32 x = 0; x < GridSize; x++) {
+                const u32 corner = y * (GridSize + 1) + x;
+                triangles.push_back({corner, corner + GridSize + 1, corner + 1});
+                triangles.push_back({corner + 1, corner + GridSize + 1, corner + GridSize + 2});
+            }
+        }
+
+        std::mt19937 random(42);
+        std::ranges::shuffle(triangles, random);
+
+        MeshData mesh;
+        mesh.Vertices.reserve(static_cast<u64>(TriangleCount) * 3);
+        mesh.Indices.reserve(static_cast<u64>(TriangleCount) * 3);
+        for (const auto& triangle : triangles) {
+            for (const u32 corner : triangle) {
+                const auto x = static_cast<f32>(corner % (GridSize + 1));
+                const auto y = static_cast<f32>(corner / (GridSize + 1));
+
+                mesh.Indices.push_back(static_cast<u32>(mesh.Vertices.size()));
+                mesh.Vertices.push_back({glm::vec3(x, y, std::sin(x * 0.1f) * std::cos(y * 0.1f) * 4.0f),
+                                         glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(x, y) / static_cast<f32>(GridSize)});
+            }
+        }
+
+        return mesh;
+    }
+
+    // The grid after deduplication, with the triangles still shuffled.
+    struct IndexedGrid {
+        std::vector<MeshVertex> Vertices;
+        std::vector<u32> Indices;
+    };
+
+    const IndexedGrid& GetIndexedGrid() {
+        static const IndexedGrid grid = [] {
+            MeshData mesh = MakeUnindexedGrid();
+            std::vector<u32> remap(mesh.GetVertexCount());
+            const u32 vertexCount = GenerateVertexRemap(remap, mesh.Indices, mesh.Vertices.data(),
+                                                        mesh.GetVertexCount(), sizeof(MeshVertex));
+
+            IndexedGrid result;
+            result.Vertices.resize(vertexCount);
+            RemapVertices(result.Vertices.data(), mesh.Vertices.data(), mesh.GetVertexCount(), sizeof(MeshVertex),
+                          remap);
+            result.Indices.resize(mesh.Indices.size());
+            RemapIndices(result.Indices, mesh.Indices, remap);
+            return result;
+        }();
+
+        return grid;
+    }
+
+    void MeshVertexRemap(benchmark::State& state) {
+        const MeshData mesh = MakeUnindexedGrid();
+        JobSystem jobSystem;
+        std::vector<u32> remap(mesh.GetVertexCount());
+
+        u32 vertexCount = 0;
+        for (auto _ : state) {
+            vertexCount = GenerateVertexRemap(remap, mesh.Indices, mesh.Vertices.data(), mesh.GetVertexCount(),
+                                              sizeof(MeshVertex), state.range(0) != 0 ? &jobSystem : nullptr);
+        }
+
+        state.counters["Vertices"] = static_cast<f64>(vertexCount);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * mesh.GetVertexCount());
+    }
+    BENCHMARK(MeshVertexRemap)->ArgName("Parallel")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // Whole mesh at once, or sorted spatially and cut into chunks optimized on the job system.
+    void MeshVertexCache(benchmark::State& state) {
+        const IndexedGrid& grid = GetIndexedGrid();
+        const auto vertexCount = static_cast<u32>(grid.Vertices.size());
+        JobSystem jobSystem;
+        MeshOptimizerSettings settings;
+        settings.Jobs = state.range(0) != 0 ? &jobSystem : nullptr;
+
+        std::vector<u32> sorted(grid.Indices.size());
+        std::vector<u32> indices(grid.Indices.size());
+        for (auto _ : state) {
+            if (settings.Jobs != nullptr) {
+                SortTrianglesSpatially(sorted, grid.Indices, &grid.Vertices[0].Position.x, vertexCount,
+                                       sizeof(MeshVertex), settings.Jobs);
+                OptimizeVertexCache(indices, sorted, vertexCount, settings);
+            } else {
+                OptimizeVertexCache(indices, grid.Indices, vertexCount, settings);
+            }
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["AcmrBefore"] = AnalyzeVertexCache(grid.Indices, vertexCount).Acmr;
+        state.counters["AcmrAfter"] = AnalyzeVertexCache(indices, vertexCount).Acmr;
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * TriangleCount);
+    }
+    BENCHMARK(MeshVertexCache)->ArgName("Parallel")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    void MeshOverdraw(benchmark::State& state) {
+        const IndexedGrid& grid = GetIndexedGrid();
+        const auto vertexCount = static_cast<u32>(grid.Vertices.size());
+
+        std::vector<u32> cacheOptimized(grid.Indices.size());
+        OptimizeVertexCache(cacheOptimized, grid.Indices, vertexCount);
+
+        std::vector<u32> indices(grid.Indices.size());
+        for (auto _ : state) {
+            OptimizeOverdraw(indices, cacheOptimized, &grid.Vertices[0].Position.x, vertexCount, sizeof(MeshVertex));
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["AcmrBefore"] = AnalyzeVertexCache(cacheOptimized, vertexCount).Acmr;
+        state.counters["AcmrAfter"] = AnalyzeVertexCache(indices, vertexCount).Acmr;
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * TriangleCount);
+    }
+    BENCHMARK(MeshOverdraw)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // The whole pipeline, from the unindexed mesh.
+    void MeshOptimize(benchmark::State& state) {
+        const MeshData source = MakeUnindexedGrid();
+        JobSystem jobSystem;
+        MeshOptimizerSettings settings;
+        settings.Jobs = &jobSystem;
+
+        MeshOptimizationReport report;
+        for (auto _ : state) {
+            state.PauseTiming();
+            MeshData mesh = source;
+            state.ResumeTiming();
+
+            report = OptimizeMesh(mesh, settings);
+        }
+
+        state.counters["AcmrBefore"] = report.CacheBefore.Acmr;
+        state.counters["AcmrAfter"] = report.CacheAfter.Acmr;
+        state.counters["OverfetchBefore"] = report.FetchBefore.Overfetch;
+        state.counters["OverfetchAfter"] = report.FetchAfter.Overfetch;
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * TriangleCount);
+    }
+    BENCHMARK(MeshOptimize)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
@@ -0,0 +1,108 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Mesh/MeshSimplifier.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <numbers>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 SphereSegments = 256;
+    constexpr u32 ChainMeshCount = 8;
+
+    /*
+     * A unit UV sphere of about 130k triangles with texture coordinates, the first column of vertices is repeated
+     * at the end with u = 1 so there is a seam to keep, like in most authored meshes.
+     */
+    MeshData BuildSphere(const u32 segments) {
+        MeshData mesh;
+        for (u32 ring = 0; ring <= segments; ring++) {
+            const f32 v = static_cast<f32>(ring) / static_cast<f32>(segments);
+            const f32 theta = std::numbers::pi_v<f32> * v;
+            for (u32 segment = 0; segment <= segments; segment++) {
+                const f32 u = static_cast<f32>(segment) / static_cast<f32>(segments);
+                const f32 phi = 2.0f * std::numbers::pi_v<f32> * u;
+                const glm::vec3 position(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                         std::sin(theta) * std::sin(phi));
+                mesh.Vertices.push_back({position, position, glm::vec2(u, v)});
+            }
+        }
+
+        for (u32 ring = 0; ring < segments; ring++) {
+            for (u32 segment = 0; segment < segments; segment++) {
+                const u32 a = ring * (segments + 1) + segment;
+                const u32 b = a + 1;
+                const u32 c = a + segments + 1;
+                const u32 d = c + 1;
+                mesh.Indices.insert(mesh.Indices.end(), {a, c, b, b, c, d});
+            }
+        }
+
+        return mesh;
+    }
+
+    const MeshData& GetSphere() {
+        static const MeshData sphere = BuildSphere(SphereSegments);
+        return sphere;
+    }
+
+    void MeshSimplify(benchmark::State& state) {
+        const MeshData& sphere = GetSphere();
+        const auto targetRatio = static_cast<f32>(state.range(0)) / 100.0f;
+
+        SimplifySettings settings;
+        settings.TargetIndexCount = static_cast<u32>(static_cast<f32>(sphere.Indices.size() / 3) * targetRatio) * 3;
+
+        std::vector<u32> simplified(sphere.Indices.size());
+        SimplifyResult result;
+        for (auto _ : state) {
+            result = SimplifyMesh(simplified, sphere.Indices, sphere.Vertices, settings);
+        }
+
+        const std::span<const u32> indices = std::span(simplified).first(result.IndexCount);
+        state.counters["Triangles"] = static_cast<f64>(result.IndexCount / 3);
+        state.counters["EstimatedError"] = result.EstimatedError * 2.0f; // In mesh units, the sphere is 2 wide.
+        state.counters["Hausdorff"] = MeasureHausdorffDistance(sphere.Indices, indices, sphere.Vertices);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * sphere.Indices.size() / 3));
+    }
+    BENCHMARK(MeshSimplify)->ArgName("TargetPercent")->Arg(50)->Arg(10)->Arg(1)->Unit(benchmark::kMillisecond);
+
+    /*
+     * Spheres of growing sizes, as an importer would get from a scene. Most of the time goes to measuring each LOD
+     * step, which took this benchmark from about 0.44 s to 2.7 s when it replaced summing the simplifier estimates.
+     */
+    void MeshLodChains(benchmark::State& state) {
+        static const std::vector<MeshData> meshes = [] {
+            std::vector<MeshData> result;
+            for (u32 mesh = 0; mesh < ChainMeshCount; mesh++) {
+                result.push_back(BuildSphere(SphereSegments / 4 + mesh * SphereSegments / 8));
+            }
+            return result;
+        }();
+
+        JobSystem jobSystem;
+        JobSystem* jobs = state.range(0) != 0 ? &jobSystem : nullptr;
+
+        std::vector<MeshLodChain> chains(ChainMeshCount);
+        for (auto _ : state) {
+            BuildLodChains(meshes, chains, {}, jobs);
+        }
+
+        // The error the selector uses for the coarsest LOD of the largest mesh, measured with LodErrorMargin.
+        const MeshLodChain& chain = chains.back();
+        state.counters["Lods"] = chain.GetLodCount();
+        state.counters["Error"] = chain.Lods[chain.GetLodCount() - 1].Error;
+
+        u64 triangleCount = 0;
+        for (const MeshData& mesh : meshes) {
+            triangleCount += mesh.GetTriangleCount();
+        }
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * triangleCount));
+    }
+    BENCHMARK(MeshLodChains)->ArgName("Parallel")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
@@ -0,0 +1,118 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Mesh/MeshOptimizer.hpp>
+#include <FlashlightEngine/Mesh/Meshlet.hpp>
+#include <FlashlightEngine/Renderer/MeshletCulling.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <numbers>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 SphereSegments = 512;
+
+    struct SphereMesh {
+        std::vector<glm::vec3> Positions;
+        std::vector<u32> Indices; // Vertex cache optimized.
+    };
+
+    // A unit UV sphere of about half a million triangles.
+    const SphereMesh& GetSphere() {
+        static const SphereMesh sphere = [] {
+            SphereMesh result;
+            for (u32 ring = 0; ring <= SphereSegments; ring++) {
+                const f32 theta = std::numbers::pi_v<f32> * static_cast<f32>(ring) / SphereSegments;
+                for (u32 segment = 0; segment < SphereSegments; segment++) {
+                    const f32 phi = 2.0f * std::numbers::pi_v<f32> * static_cast<f32>(segment) / SphereSegments;
+                    result.Positions.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                                  std::sin(theta) * std::sin(phi));
+                }
+            }
+
+            std::vector<u32> indices;
+            for (u32 ring = 0; ring < SphereSegments; ring++) {
+                for (u32 segment = 0; segment < SphereSegments; segment++) {
+                    const u32 a = ring * SphereSegments + segment;
+                    const u32 b = ring * SphereSegments + (segment + 1) % SphereSegments;
+                    indices.insert(indices.end(), {a, a + SphereSegments, b, b, a + SphereSegments,
+                                                   b + SphereSegments});
+                }
+            }
+
+            result.Indices.resize(indices.size());
+            OptimizeVertexCache(result.Indices, indices, static_cast<u32>(result.Positions.size()));
+            return result;
+        }();
+
+        return sphere;
+    }
+
+    MeshletMesh BuildSphereMeshlets(JobSystem* jobs = nullptr) {
+        const SphereMesh& sphere = GetSphere();
+
+        MeshletBuildSettings settings;
+        settings.Jobs = jobs;
+
+        MeshletMesh meshlets;
+        BuildMeshlets(meshlets, sphere.Indices, &sphere.Positions[0].x, static_cast<u32>(sphere.Positions.size()),
+                      sizeof(glm::vec3), settings);
+        return meshlets;
+    }
+
+    void MeshletBuild(benchmark::State& state) {
+        const SphereMesh& sphere = GetSphere();
+        JobSystem jobSystem;
+
+        MeshletMesh meshlets;
+        for (auto _ : state) {
+            meshlets = BuildSphereMeshlets(state.range(0) != 0 ? &jobSystem : nullptr);
+        }
+
+        const auto meshletCount = static_cast<f64>(meshlets.GetMeshletCount());
+        state.counters["Meshlets"] = meshletCount;
+        state.counters["VerticesPerMeshlet"] = static_cast<f64>(meshlets.Vertices.size()) / meshletCount;
+        state.counters["TrianglesPerMeshlet"] = static_cast<f64>(sphere.Indices.size() / 3) / meshletCount;
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * sphere.Indices.size() / 3));
+    }
+    BENCHMARK(MeshletBuild)->ArgName("Parallel")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // Camera three radii away with the whole sphere in view, so everything culled is culled by the cones.
+    void MeshletCull(benchmark::State& state) {
+        static const MeshletMesh meshlets = BuildSphereMeshlets();
+
+        const glm::vec3 cameraPosition(0.0f, 0.0f, 3.0f);
+        const Frustum frustum = Frustum::FromViewProjection(
+            glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+            glm::lookAtRH(cameraPosition, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+        JobSystem jobSystem;
+        MeshletCullingSettings settings;
+        settings.ConeCulling = state.range(0) != 0;
+        settings.Jobs = state.range(1) != 0 ? &jobSystem : nullptr;
+
+        MeshletCuller culler;
+        std::vector<u32> visible;
+        MeshletCullingStats stats;
+        for (auto _ : state) {
+            stats = culler.Cull(meshlets, frustum, cameraPosition, visible, settings);
+        }
+
+        state.counters["ConeRejection"] = static_cast<f64>(stats.ConeCulledCount) / stats.TestedCount;
+        state.counters["VisibleTriangles"] = static_cast<f64>(stats.VisibleTriangleCount);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * meshlets.GetMeshletCount());
+    }
+    BENCHMARK(MeshletCull)
+        ->ArgNames({"Cones", "Parallel"})
+        ->Args({0, 0})
+        ->Args({1, 0})
+        ->Args({1, 1})
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime();
+}
@@ -0,0 +1,154 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Renderer/Culling.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 ObjectCount = 100'000;
+
+    // Objects scattered in a cube around the camera, about a tenth of them end up in the frustum.
+    glm::mat4 MakeViewProjection() {
+        return glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) *
+               glm::lookAtRH(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    glm::vec3 MakeCenter(std::mt19937& random) {
+        std::uniform_real_distribution<f32> position(-500.0f, 500.0f);
+        return {position(random), position(random), position(random)};
+    }
+
+    BoundingSpheres MakeSpheres() {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<f32> radius(0.5f, 5.0f);
+
+        BoundingSpheres spheres;
+        for (u32 i = 0; i < ObjectCount; i++) {
+            spheres.Add(MakeCenter(random), radius(random));
+        }
+
+        return spheres;
+    }
+
+    BoundingBoxes MakeBoxes() {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<f32> extent(0.5f, 5.0f);
+
+        BoundingBoxes boxes;
+        for (u32 i = 0; i < ObjectCount; i++) {
+            boxes.Add(MakeCenter(random), glm::vec3(extent(random), extent(random), extent(random)));
+        }
+
+        return boxes;
+    }
+
+    // Selects the level of the run, levels the CPU doesn't have are skipped. Restored when the run ends.
+    class SimdLevelScope {
+        SimdLevel m_Previous;
+
+    public:
+        explicit SimdLevelScope(benchmark::State& state) : m_Previous(GetSimdLevel()) {
+            const auto level = static_cast<SimdLevel>(state.range(0));
+            if (level > GetSupportedSimdLevel() || GetCullingKernels(level) == nullptr) {
+                state.SkipWithError("Level not supported by this CPU or build.");
+            }
+
+            SetSimdLevel(level);
+            state.SetLabel(std::string(GetSimdLevelName(level)));
+        }
+
+        ~SimdLevelScope() {
+            SetSimdLevel(m_Previous);
+        }
+
+        SimdLevelScope(const SimdLevelScope&) = delete;
+        SimdLevelScope(SimdLevelScope&&) = delete;
+
+        SimdLevelScope& operator=(const SimdLevelScope&) = delete;
+        SimdLevelScope& operator=(SimdLevelScope&&) = delete;
+    };
+
+    void AddSimdLevels(benchmark::internal::Benchmark* benchmark) {
+        benchmark->ArgName("Level");
+        for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse42, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            benchmark->Arg(static_cast<i64>(level));
+        }
+    }
+
+    template <auto Cull, typename Bounds>
+    void RunFrustumCull(benchmark::State& state, const Bounds& bounds) {
+        const SimdLevelScope scope(state);
+        const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+        std::vector<u32> visible(bounds.GetCount());
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Cull(frustum, bounds, 0, bounds.GetCount(), visible.data()));
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * bounds.GetCount());
+    }
+
+    void FrustumCullSpheres(benchmark::State& state) {
+        RunFrustumCull<CullSpheres>(state, MakeSpheres());
+    }
+    BENCHMARK(FrustumCullSpheres)->Apply(AddSimdLevels)->Unit(benchmark::kMicrosecond);
+
+    void FrustumCullBoxes(benchmark::State& state) {
+        RunFrustumCull<CullBoxes>(state, MakeBoxes());
+    }
+    BENCHMARK(FrustumCullBoxes)->Apply(AddSimdLevels)->Unit(benchmark::kMicrosecond);
+
+    // Whole culler, on the calling thread or spread over the job system.
+    void CullerSpheres(benchmark::State& state) {
+        const BoundingSpheres spheres = MakeSpheres();
+        const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+
+        JobSystem jobSystem;
+        CullingSettings settings;
+        settings.Jobs = state.range(0) != 0 ? &jobSystem : nullptr;
+
+        Culler culler;
+        std::vector<u32> visible;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(culler.Cull(frustum, spheres, visible, settings));
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ObjectCount);
+    }
+    BENCHMARK(CullerSpheres)->ArgName("Parallel")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+    // A wall in front of the camera hides most of what the frustum lets through.
+    void CullerSpheresOcclusion(benchmark::State& state) {
+        const BoundingSpheres spheres = MakeSpheres();
+        const glm::mat4 viewProjection = MakeViewProjection();
+        const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+
+        OcclusionBuffer occlusion;
+        JobSystem jobSystem;
+        CullingSettings settings;
+        settings.Jobs = &jobSystem;
+        settings.Occlusion = &occlusion;
+
+        Culler culler;
+        std::vector<u32> visible;
+        CullingStats stats;
+        for (auto _ : state) {
+            occlusion.Begin(viewProjection);
+            occlusion.RasterizeOccluderBox(glm::vec3(0.0f, 0.0f, -50.0f), glm::vec3(60.0f, 40.0f, 1.0f));
+            stats = culler.Cull(frustum, spheres, visible, settings);
+        }
+
+        state.counters["Visible"] = static_cast<f64>(stats.VisibleCount);
+        state.counters["Occluded"] = static_cast<f64>(stats.OcclusionCulledCount);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * ObjectCount);
+    }
+    BENCHMARK(CullerSpheresOcclusion)->Unit(benchmark::kMicrosecond)->UseRealTime();
+}
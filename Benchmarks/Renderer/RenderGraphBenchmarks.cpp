@@ -0,0 +1,78 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Renderer/RenderGraph.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    // Every pass writes its own target and samples up to three of the sixteen targets written before it, the last
+    // pass writes the swapchain. Some passes end up unread and are culled.
+    void BuildGraph(RenderGraph& graph, const u32 passCount) {
+        std::mt19937 random(42);
+        std::vector<RenderResourceId> targets;
+        targets.reserve(passCount);
+
+        const RenderImageDesc swapchainDesc{1920, 1080, 1, 1, RenderFormat::B8G8R8A8Srgb};
+        const RenderResourceId swapchain = graph.ImportImage("Swapchain", swapchainDesc, RenderUsage::None,
+                                                             RenderUsage::Present);
+
+        for (u32 i = 0; i < passCount; i++) {
+            const RenderResourceId target = graph.CreateImage(
+                "Target", {256u << (random() % 3), 256, 1, 1, RenderFormat::R16G16B16A16Sfloat});
+
+            graph.AddPass("Pass", [&](RenderPassBuilder& builder) {
+                for (u32 j = 0; j < 3 && !targets.empty(); j++) {
+                    const u32 back = static_cast<u32>(random() % std::min<u32>(static_cast<u32>(targets.size()), 16));
+                    builder.Read(targets[targets.size() - 1 - back], RenderUsage::ShaderSampled);
+                }
+                builder.Write(target, RenderUsage::ColorAttachment);
+            });
+
+            targets.push_back(target);
+        }
+
+        graph.AddPass("Present", [&](RenderPassBuilder& builder) {
+            builder.Read(targets.back(), RenderUsage::ShaderSampled);
+            builder.Write(swapchain, RenderUsage::ColorAttachment);
+        });
+    }
+
+    void RenderGraphCompile(benchmark::State& state) {
+        RenderGraph graph;
+        BuildGraph(graph, static_cast<u32>(state.range(0)));
+
+        for (auto _ : state) {
+            graph.Compile();
+            benchmark::DoNotOptimize(graph.GetBarriers().data());
+        }
+
+        const RenderGraphStats& stats = graph.GetStats();
+        state.counters["Barriers"] = static_cast<f64>(stats.BarrierCount);
+        state.counters["Batches"] = static_cast<f64>(stats.BatchCount);
+        state.counters["AliasedMB"] = static_cast<f64>(stats.ImageHeapSize) / (1024.0 * 1024.0);
+        state.counters["UnaliasedMB"] = static_cast<f64>(stats.TransientMemory) / (1024.0 * 1024.0);
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(RenderGraphCompile)->Arg(100)->Arg(1000)->Arg(4000)->Unit(benchmark::kMicrosecond);
+
+    // What a frame pays: declaring the passes again, then compiling.
+    void RenderGraphBuildAndCompile(benchmark::State& state) {
+        RenderGraph graph;
+
+        for (auto _ : state) {
+            graph.Reset();
+            BuildGraph(graph, static_cast<u32>(state.range(0)));
+            graph.Compile();
+            benchmark::DoNotOptimize(graph.GetBarriers().data());
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(RenderGraphBuildAndCompile)->Arg(100)->Arg(1000)->Arg(4000)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,243 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Scene/Query.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 EntityCount = 1'000'000;
+
+    struct Position {
+        f32 X, Y, Z;
+    };
+
+    struct Velocity {
+        f32 X, Y, Z;
+    };
+
+    struct Acceleration {
+        f32 X, Y, Z;
+    };
+
+    struct Damping {
+        f32 Factor;
+    };
+
+    // Baseline the scene is compared against: one heap allocation per object, iterated through pointers.
+    struct GameObject {
+        Position Location;
+        Velocity Speed;
+        Acceleration Gravity;
+        Damping Drag;
+    };
+
+    void FillScene(Scene& scene, const u32 componentCount) {
+        for (u32 i = 0; i < EntityCount; i++) {
+            const Position position{static_cast<f32>(i), 0.0f, 0.0f};
+            switch (componentCount) {
+            case 1:
+                scene.CreateEntity(position);
+                break;
+
+            case 2:
+                scene.CreateEntity(position, Velocity{1.0f, 0.0f, 0.0f});
+                break;
+
+            case 3:
+                scene.CreateEntity(position, Velocity{1.0f, 0.0f, 0.0f}, Acceleration{0.0f, -9.81f, 0.0f});
+                break;
+
+            default:
+                scene.CreateEntity(position, Velocity{1.0f, 0.0f, 0.0f}, Acceleration{0.0f, -9.81f, 0.0f},
+                                   Damping{0.99f});
+                break;
+            }
+        }
+    }
+
+    void HeapObjectsIterate(benchmark::State& state) {
+        std::vector<std::unique_ptr<GameObject>> objects;
+        objects.reserve(EntityCount);
+        for (u32 i = 0; i < EntityCount; i++) {
+            objects.push_back(std::make_unique<GameObject>(
+                GameObject{{static_cast<f32>(i), 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, -9.81f, 0.0f}, {0.99f}}));
+        }
+
+        constexpr f32 deltaTime = 1.0f / 60.0f;
+        for (auto _ : state) {
+            for (const auto& object : objects) {
+                object->Speed.Y = (object->Speed.Y + object->Gravity.Y * deltaTime) * object->Drag.Factor;
+                object->Location.Y += object->Speed.Y * deltaTime;
+            }
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * EntityCount);
+    }
+    BENCHMARK(HeapObjectsIterate)->Unit(benchmark::kMillisecond);
+
+    void QueryIterateOneComponent(benchmark::State& state) {
+        Scene scene;
+        FillScene(scene, 1);
+
+        Query<Position> query(scene);
+        for (auto _ : state) {
+            query.ForEach([](Position& position) {
+                position.X += 1.0f;
+            });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * EntityCount);
+    }
+    BENCHMARK(QueryIterateOneComponent)->Unit(benchmark::kMillisecond);
+
+    void QueryIterateTwoComponents(benchmark::State& state) {
+        Scene scene;
+        FillScene(scene, 2);
+
+        constexpr f32 deltaTime = 1.0f / 60.0f;
+        Query<Position, const Velocity> query(scene);
+        for (auto _ : state) {
+            query.ForEach([](Position& position, const Velocity& velocity) {
+                position.X += velocity.X * deltaTime;
+            });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * EntityCount);
+    }
+    BENCHMARK(QueryIterateTwoComponents)->Unit(benchmark::kMillisecond);
+
+    void QueryIterateThreeComponents(benchmark::State& state) {
+        Scene scene;
+        FillScene(scene, 3);
+
+        constexpr f32 deltaTime = 1.0f / 60.0f;
+        Query<Position, Velocity, const Acceleration> query(scene);
+        for (auto _ : state) {
+            query.ForEach([](Position& position, Velocity& velocity, const Acceleration& acceleration) {
+                velocity.Y += acceleration.Y * deltaTime;
+                position.Y += velocity.Y * deltaTime;
+            });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * EntityCount);
+    }
+    BENCHMARK(QueryIterateThreeComponents)->Unit(benchmark::kMillisecond);
+
+    void QueryIterateFourComponents(benchmark::State& state) {
+        Scene scene;
+        FillScene(scene, 4);
+
+        constexpr f32 deltaTime = 1.0f / 60.0f;
+        Query<Position, Velocity, const Acceleration, const Damping> query(scene);
+        for (auto _ : state) {
+            query.ForEach([](Position& position, Velocity& velocity, const Acceleration& acceleration,
+                             const Damping& damping) {
+                velocity.Y = (velocity.Y + acceleration.Y * deltaTime) * damping.Factor;
+                position.Y += velocity.Y * deltaTime;
+            });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * EntityCount);
+    }
+    BENCHMARK(QueryIterateFourComponents)->Unit(benchmark::kMillisecond);
+
+    void QueryParallelIterateFourComponents(benchmark::State& state) {
+        Logger::Init({.ConsoleOutput = false});
+        {
+            JobSystem jobSystem(static_cast<u32>(state.range(0)));
+
+            Scene scene;
+            FillScene(scene, 4);
+
+            constexpr f32 deltaTime = 1.0f / 60.0f;
+            Query<Position, Velocity, const Acceleration, const Damping> query(scene);
+            for (auto _ : state) {
+                query.ParallelForEach(jobSystem, [](Position& position, Velocity& velocity,
+                                                    const Acceleration& acceleration, const Damping& damping) {
+                    velocity.Y = (velocity.Y + acceleration.Y * deltaTime) * damping.Factor;
+                    position.Y += velocity.Y * deltaTime;
+                });
+                benchmark::ClobberMemory();
+            }
+
+            state.SetItemsProcessed(static_cast<i64>(state.iterations()) * EntityCount);
+        }
+        Logger::Shutdown();
+    }
+    BENCHMARK(QueryParallelIterateFourComponents)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+
+    // Entities spread over several archetypes, only half of them match.
+    void QueryIterateMixedArchetypes(benchmark::State& state) {
+        Scene scene;
+        for (u32 i = 0; i < EntityCount; i++) {
+            const Entity entity = scene.CreateEntity(Position{static_cast<f32>(i), 0.0f, 0.0f});
+            if (i % 2 == 0) {
+                scene.AddComponent<Velocity>(entity, 1.0f, 0.0f, 0.0f);
+            }
+            if (i % 3 == 0) {
+                scene.AddComponent<Damping>(entity, 0.99f);
+            }
+        }
+
+        Query<Position, const Velocity> query(scene);
+        for (auto _ : state) {
+            query.ForEach([](Position& position, const Velocity& velocity) {
+                position.X += velocity.X;
+            });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * query.GetEntityCount()));
+    }
+    BENCHMARK(QueryIterateMixedArchetypes)->Unit(benchmark::kMillisecond);
+
+    void SceneCreateDestroy(benchmark::State& state) {
+        Scene scene;
+        std::vector<Entity> entities(4096);
+
+        for (auto _ : state) {
+            for (auto& entity : entities) {
+                entity = scene.CreateEntity(Position{}, Velocity{});
+            }
+
+            for (const Entity entity : entities) {
+                scene.DestroyEntity(entity);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * entities.size()));
+    }
+    BENCHMARK(SceneCreateDestroy);
+
+    void SceneAddRemoveComponent(benchmark::State& state) {
+        Scene scene;
+        std::vector<Entity> entities(4096);
+        for (auto& entity : entities) {
+            entity = scene.CreateEntity(Position{});
+        }
+
+        for (auto _ : state) {
+            for (const Entity entity : entities) {
+                scene.AddComponent<Velocity>(entity);
+            }
+
+            for (const Entity entity : entities) {
+                scene.RemoveComponent<Velocity>(entity);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations() * entities.size()));
+    }
+    BENCHMARK(SceneAddRemoveComponent);
+}
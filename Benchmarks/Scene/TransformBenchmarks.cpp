@@ -0,0 +1,185 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Scene/TransformHierarchy.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <thread>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 NodeCount = 100'000;
+    constexpr u32 MaxChildren = 8;
+
+    // Baseline: every node is a heap object holding its children, world matrices are computed recursively.
+    struct PointerNode {
+        glm::vec3 Position{0.0f};
+        glm::quat Rotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::vec3 Scale{1.0f};
+        glm::mat4 World{1.0f};
+        std::vector<std::unique_ptr<PointerNode>> Children;
+    };
+
+    void UpdatePointerNode(PointerNode& node, const glm::mat4& parentWorld) {
+        const glm::mat4 local = glm::translate(glm::mat4(1.0f), node.Position) * glm::mat4_cast(node.Rotation) *
+                                glm::scale(glm::mat4(1.0f), node.Scale);
+        node.World = parentWorld * local;
+
+        for (const auto& child : node.Children) {
+            UpdatePointerNode(*child, node.World);
+        }
+    }
+
+    // The same random tree for both implementations: node i's parent is drawn among the nodes before it.
+    std::vector<u32> MakeParents() {
+        std::mt19937 random(42);
+        std::vector<u32> parents(NodeCount, InvalidTransform);
+        std::vector<u32> childCounts(NodeCount, 0);
+
+        for (u32 i = 1; i < NodeCount; i++) {
+            u32 parent;
+            do {
+                parent = std::uniform_int_distribution<u32>(0, i - 1)(random);
+            } while (childCounts[parent] == MaxChildren);
+
+            parents[i] = parent;
+            childCounts[parent]++;
+        }
+
+        return parents;
+    }
+
+    glm::vec3 MakePosition(const u32 i) {
+        return glm::vec3(static_cast<f32>(i % 7), static_cast<f32>(i % 3), 1.0f);
+    }
+
+    glm::quat MakeRotation(const u32 i) {
+        return glm::angleAxis(static_cast<f32>(i) * 0.001f, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    void PointerHierarchyUpdate(benchmark::State& state) {
+        const std::vector<u32> parents = MakeParents();
+
+        std::vector<PointerNode*> nodes(NodeCount);
+        PointerNode root;
+        nodes[0] = &root;
+        for (u32 i = 1; i < NodeCount; i++) {
+            nodes[i] = nodes[parents[i]]->Children.emplace_back(std::make_unique<PointerNode>()).get();
+            nodes[i]->Position = MakePosition(i);
+            nodes[i]->Rotation = MakeRotation(i);
+        }
+
+        for (auto _ : state) {
+            UpdatePointerNode(root, glm::mat4(1.0f));
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * NodeCount);
+    }
+    BENCHMARK(PointerHierarchyUpdate)->Unit(benchmark::kMicrosecond);
+
+    void FillHierarchy(TransformHierarchy& hierarchy, std::vector<TransformId>& ids) {
+        const std::vector<u32> parents = MakeParents();
+
+        ids.resize(NodeCount);
+        for (u32 i = 0; i < NodeCount; i++) {
+            ids[i] = hierarchy.Create(i == 0 ? InvalidTransform : ids[parents[i]]);
+            hierarchy.SetLocalTransform(ids[i], MakePosition(i), MakeRotation(i), glm::vec3(1.0f));
+        }
+
+        hierarchy.Update();
+    }
+
+    // Every root moved, so every node is recomputed.
+    void TransformHierarchyFullUpdate(benchmark::State& state) {
+        TransformHierarchy hierarchy;
+        std::vector<TransformId> ids;
+        FillHierarchy(hierarchy, ids);
+
+        f32 offset = 0.0f;
+        for (auto _ : state) {
+            hierarchy.SetLocalPosition(ids[0], glm::vec3(offset++, 0.0f, 0.0f));
+            hierarchy.Update();
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * NodeCount);
+    }
+    BENCHMARK(TransformHierarchyFullUpdate)->Unit(benchmark::kMicrosecond);
+
+    // The same full update with levels split across 1, 2, 4... workers up to one per hardware thread.
+    void TransformHierarchyParallelFullUpdate(benchmark::State& state) {
+        Logger::Init({.ConsoleOutput = false});
+        {
+            JobSystem jobSystem(static_cast<u32>(state.range(0)));
+            TransformHierarchy hierarchy;
+            std::vector<TransformId> ids;
+            FillHierarchy(hierarchy, ids);
+
+            f32 offset = 0.0f;
+            for (auto _ : state) {
+                hierarchy.SetLocalPosition(ids[0], glm::vec3(offset++, 0.0f, 0.0f));
+                hierarchy.Update(&jobSystem);
+                benchmark::ClobberMemory();
+            }
+
+            state.SetItemsProcessed(static_cast<i64>(state.iterations()) * NodeCount);
+        }
+        Logger::Shutdown();
+    }
+    BENCHMARK(TransformHierarchyParallelFullUpdate)
+        ->Apply([](benchmark::internal::Benchmark* benchmark) {
+            const i64 hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+            for (i64 workerCount = 1; workerCount < hardwareThreads; workerCount *= 2) {
+                benchmark->Arg(workerCount);
+            }
+            benchmark->Arg(hardwareThreads);
+        })
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    // A percentage of random nodes moved, with their subtrees.
+    void TransformHierarchyPartialUpdate(benchmark::State& state) {
+        TransformHierarchy hierarchy;
+        std::vector<TransformId> ids;
+        FillHierarchy(hierarchy, ids);
+
+        std::mt19937 random(7);
+        const u32 movedCount = NodeCount * static_cast<u32>(state.range(0)) / 100;
+
+        f32 offset = 0.0f;
+        for (auto _ : state) {
+            state.PauseTiming();
+            for (u32 i = 0; i < movedCount; i++) {
+                const u32 node = std::uniform_int_distribution<u32>(1, NodeCount - 1)(random);
+                hierarchy.SetLocalPosition(ids[node], glm::vec3(offset++, 0.0f, 0.0f));
+            }
+            state.ResumeTiming();
+
+            hierarchy.Update();
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<i64>(state.iterations()) * NodeCount);
+    }
+    BENCHMARK(TransformHierarchyPartialUpdate)->Arg(1)->Arg(10)->Unit(benchmark::kMicrosecond);
+
+    void TransformHierarchyNoChange(benchmark::State& state) {
+        TransformHierarchy hierarchy;
+        std::vector<TransformId> ids;
+        FillHierarchy(hierarchy, ids);
+
+        for (auto _ : state) {
+            hierarchy.Update();
+        }
+    }
+    BENCHMARK(TransformHierarchyNoChange);
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+# Copyright (C) 2024 Jean "Pixfri" Letessier
+# This file is part of Flashlight Engine.
+# For conditions of distribution and use, see copyright notice in LICENSE
+
+"""Compares two FlashlightBenchmarks JSON outputs and fails when a benchmark got slower than the threshold.
+
+Usage: compare_benchmarks.py baseline.json current.json [--threshold 10] [--metric real_time|cpu_time]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path, metric):
+    with open(path, encoding="utf-8") as file:
+        data = json.load(file)
+
+    results = {}
+    for benchmark in data.get("benchmarks", []):
+        # With repetitions, only compare the aggregated medians, they are less noisy than the single runs.
+        run_type = benchmark.get("run_type", "iteration")
+        if run_type == "aggregate" and benchmark.get("aggregate_name") != "median":
+            continue
+        if run_type == "iteration" and benchmark.get("repetitions", 1) > 1:
+            continue
+
+        name = benchmark.get("run_name", benchmark["name"])
+        results[name] = benchmark[metric]
+
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fails when a benchmark regressed against a baseline.")
+    parser.add_argument("baseline", help="JSON output of the reference run.")
+    parser.add_argument("current", help="JSON output of the run to check.")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Slowdown in percent above which a benchmark counts as a regression, 10 by default.")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="real_time")
+    arguments = parser.parse_args()
+
+    baseline = load_results(arguments.baseline, arguments.metric)
+    current = load_results(arguments.current, arguments.metric)
+
+    regressions = []
+    name_width = max((len(name) for name in current), default=0)
+
+    for name, time in current.items():
+        if name not in baseline:
+            print(f"{name:<{name_width}}  new")
+            continue
+
+        reference = baseline[name]
+        change = (time - reference) / reference * 100.0 if reference > 0 else 0.0
+        status = "REGRESSION" if change > arguments.threshold else ""
+        print(f"{name:<{name_width}}  {reference:12.2f} -> {time:12.2f}  {change:+7.2f}%  {status}")
+
+        if status:
+            regressions.append(name)
+
+    for name in baseline:
+        if name not in current:
+            print(f"{name:<{name_width}}  missing")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {arguments.threshold}%.")
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,9 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <benchmark/benchmark.h>
+
+// Every suite registers itself, run with --benchmark_out=results.json --benchmark_out_format=json to get a file
+// Benchmarks/compare_benchmarks.py can compare against a baseline.
+BENCHMARK_MAIN();
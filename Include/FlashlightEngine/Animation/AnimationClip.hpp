@@ -0,0 +1,105 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Animation/Pose.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <span>
+
+namespace Flashlight {
+    // Uncompressed animation sampled at a fixed rate, joints in skeleton order.
+    struct FL_API RawAnimation {
+        f32 SampleRate = 30.0f;
+        u32 JointCount = 0;
+        u32 FrameCount = 0;
+        std::vector<JointTransform> Samples; // FrameCount * JointCount, frame after frame.
+
+        [[nodiscard]] inline f32 GetDuration() const;
+        [[nodiscard]] inline JointTransform& GetSample(u32 frame, u32 joint);
+        [[nodiscard]] inline const JointTransform& GetSample(u32 frame, u32 joint) const;
+    };
+
+    /*
+     * Largest local error each track may have once compressed. The errors add up down the hierarchy. Rotations can't
+     * get below the error of their quantization, up to about 6e-5 radians: smaller tolerances are logged and not met.
+     */
+    struct FL_API ClipCompressionSettings {
+        f32 TranslationTolerance = 0.001f; // In skeleton units.
+        f32 RotationTolerance = 0.001f; // Angle in radians.
+        f32 ScaleTolerance = 0.001f;
+    };
+
+    enum class ClipChannel : u8 {
+        Translation,
+        Rotation,
+        Scale,
+
+        Count
+    };
+
+    // Three 16 bit values per key, see AnimationClip for what they hold.
+    using QuantizedKey = std::array<u16, 3>;
+
+    struct FL_API ClipTrack {
+        u32 FirstKey = 0;
+        u32 KeyCount = 0;
+
+        // Translation and scale keys hold Minimum + value / 65535 * Extent. Unused by rotations.
+        glm::vec3 Minimum{0.0f};
+        glm::vec3 Extent{0.0f};
+
+        // The keys are in RawKeyFrames and RawKeys, the range is too wide for 16 bits to meet the tolerance.
+        bool Raw = false;
+    };
+
+    // Keys of every track of one channel, a track per joint.
+    struct FL_API ClipChannelData {
+        std::vector<ClipTrack> Tracks;
+        std::vector<u16> KeyFrames; // Frame of each key, increasing within a track.
+        std::vector<QuantizedKey> Keys;
+        std::vector<u16> RawKeyFrames;
+        std::vector<glm::vec3> RawKeys;
+    };
+
+    /*
+     * AnimationClip : Compressed animation. Each track only keeps the keys linear interpolation can't rebuild within
+     * the tolerances, quantized to 48 bits: translations and scales on 16 bits per component over the range of their
+     * track, rotations with the smallest three encoding, the three smallest components on 15 bits each and the index
+     * of the largest one, rebuilt from the unit length, in their lowest bits. Translation and scale tracks whose
+     * range is too wide for 16 bits to meet the tolerance keep full floats instead.
+     */
+    struct FL_API AnimationClip {
+        f32 SampleRate = 30.0f;
+        f32 Duration = 0.0f;
+        u32 JointCount = 0;
+        std::array<ClipChannelData, static_cast<u32>(ClipChannel::Count)> Channels;
+
+        [[nodiscard]] inline const ClipChannelData& GetChannel(ClipChannel channel) const;
+        [[nodiscard]] inline u32 GetKeyCount() const;
+
+        // Bytes used by the tracks and keys.
+        [[nodiscard]] u64 GetMemorySize() const;
+    };
+
+    struct FL_API ClipError {
+        f32 Translation = 0.0f;
+        f32 Rotation = 0.0f;
+        f32 Scale = 0.0f;
+    };
+
+    [[nodiscard]] FL_API AnimationClip CompressAnimation(const RawAnimation& raw,
+                                                         const ClipCompressionSettings& settings = {});
+
+    // Largest local errors of the clip against its source, over every frame.
+    [[nodiscard]] FL_API ClipError MeasureClipError(const AnimationClip& clip, const RawAnimation& raw);
+
+    // Local pose at a time in seconds, clamped to the clip. Loop with std::fmod(time, clip.Duration).
+    FL_API void SampleAnimation(const AnimationClip& clip, f32 time, Pose& result);
+
+#include <FlashlightEngine/Animation/AnimationClip.inl>
+}
@@ -0,0 +1,30 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline f32 RawAnimation::GetDuration() const {
+    return FrameCount > 1 ? static_cast<f32>(FrameCount - 1) / SampleRate : 0.0f;
+}
+
+inline JointTransform& RawAnimation::GetSample(const u32 frame, const u32 joint) {
+    return Samples[static_cast<u64>(frame) * JointCount + joint];
+}
+
+inline const JointTransform& RawAnimation::GetSample(const u32 frame, const u32 joint) const {
+    return Samples[static_cast<u64>(frame) * JointCount + joint];
+}
+
+inline const ClipChannelData& AnimationClip::GetChannel(const ClipChannel channel) const {
+    return Channels[static_cast<u32>(channel)];
+}
+
+inline u32 AnimationClip::GetKeyCount() const {
+    u32 count = 0;
+    for (const ClipChannelData& channel : Channels) {
+        count += static_cast<u32>(channel.Keys.size() + channel.RawKeys.size());
+    }
+
+    return count;
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Animation/AnimationClip.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <span>
+
+namespace Flashlight {
+    class JobSystem;
+
+    enum class AnimationBlendMode : u8 {
+        Blend, // Lerps the pose so far toward the clip by the weight.
+        Additive // Adds the clip, made of additive poses, by the weight.
+    };
+
+    struct FL_API AnimationLayer {
+        const AnimationClip* Clip = nullptr;
+        f32 Time = 0.0f; // In seconds, clamped to the clip.
+        f32 Weight = 1.0f;
+        AnimationBlendMode Mode = AnimationBlendMode::Blend;
+    };
+
+    /*
+     * CharacterAnimation : What to play on one character this frame. Layers apply in order over the bind pose, a first
+     * Blend layer with a weight of 1 replaces it. The model matrices of the joints are written to ModelMatrices.
+     */
+    struct FL_API CharacterAnimation {
+        const Skeleton* SkeletonRef = nullptr;
+        std::span<const AnimationLayer> Layers;
+        glm::mat4 Root{1.0f};
+        std::span<glm::mat4> ModelMatrices;
+    };
+
+    FL_API void EvaluateCharacter(const CharacterAnimation& character);
+
+    // Characters are split over the jobs when a job system is given. The poses in between live in per-thread
+    // buffers, which stop allocating once they fit the largest skeleton.
+    FL_API void EvaluateCharacters(std::span<const CharacterAnimation> characters, JobSystem* jobs = nullptr);
+}
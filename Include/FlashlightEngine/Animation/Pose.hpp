@@ -0,0 +1,64 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Animation/Skeleton.hpp>
+#include <FlashlightEngine/Math/SoaTypes.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <span>
+
+namespace Flashlight {
+    // Local transforms of PoseWidth consecutive joints.
+    struct FL_API SoaTransform {
+        Vec3x8 Translation;
+        Quatx8 Rotation;
+        Vec3x8 Scale;
+
+        [[nodiscard]] static inline SoaTransform Identity();
+    };
+
+    /*
+     * Pose : Local transforms of every joint of a skeleton, in packets of PoseWidth joints so sampling and blending
+     * work on a whole packet at once. Lanes past the last joint hold unit transforms that keep the math finite and
+     * are never read.
+     */
+    struct FL_API Pose {
+        std::vector<SoaTransform> Packets;
+        u32 JointCount = 0;
+
+        // Keeps the allocation when the packet count doesn't grow. Transforms are reset to identity.
+        inline void Resize(u32 jointCount);
+
+        [[nodiscard]] inline JointTransform GetJoint(u32 joint) const;
+        inline void SetJoint(u32 joint, const JointTransform& transform);
+
+        [[nodiscard]] static Pose FromBindPose(const Skeleton& skeleton);
+    };
+
+    // Per joint lerp of translations and scales and nlerp of rotations, weight 0 gives a and 1 gives b. result may be
+    // one of the inputs.
+    FL_API void BlendPoses(const Pose& a, const Pose& b, f32 weight, Pose& result);
+
+    /*
+     * Adds a fraction of an additive pose, made by ComputeAdditivePose, on top of base: translations add up, rotations
+     * compose and scales multiply. result may be one of the inputs.
+     */
+    FL_API void AddPose(const Pose& base, const Pose& additive, f32 weight, Pose& result);
+
+    // The difference from reference to pose, so that AddPose(reference, result, 1) gives pose back.
+    FL_API void ComputeAdditivePose(const Pose& pose, const Pose& reference, Pose& result);
+
+    /*
+     * Model matrices of the joints, each one the product of the local transforms from the root down to it, then root.
+     * Computed PoseWidth joints at a time, see Skeleton.
+     */
+    FL_API void ComputeModelMatrices(const Skeleton& skeleton, const Pose& pose, std::span<glm::mat4> models,
+                                     const glm::mat4& root = glm::mat4(1.0f));
+
+#include <FlashlightEngine/Animation/Pose.inl>
+}
@@ -0,0 +1,29 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline SoaTransform SoaTransform::Identity() {
+    return {Vec3x8::Splat(glm::vec3(0.0f)), Quatx8::Splat(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
+            Vec3x8::Splat(glm::vec3(1.0f))};
+}
+
+inline void Pose::Resize(const u32 jointCount) {
+    JointCount = jointCount;
+    Packets.assign((jointCount + PoseWidth - 1) / PoseWidth, SoaTransform::Identity());
+}
+
+inline JointTransform Pose::GetJoint(const u32 joint) const {
+    const SoaTransform& packet = Packets[joint / PoseWidth];
+    const u32 lane = joint % PoseWidth;
+    return {packet.Translation.Get(lane), packet.Rotation.Get(lane), packet.Scale.Get(lane)};
+}
+
+inline void Pose::SetJoint(const u32 joint, const JointTransform& transform) {
+    SoaTransform& packet = Packets[joint / PoseWidth];
+    const u32 lane = joint % PoseWidth;
+    packet.Translation.Set(lane, transform.Translation);
+    packet.Rotation.Set(lane, transform.Rotation);
+    packet.Scale.Set(lane, transform.Scale);
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <limits>
+#include <span>
+#include <string_view>
+
+namespace Flashlight {
+    constexpr u32 InvalidJoint = std::numeric_limits<u32>::max();
+
+    // Joints per packet of a pose, one lane per float of an AVX register.
+    constexpr u32 PoseWidth = 8;
+
+    struct FL_API JointTransform {
+        glm::vec3 Translation{0.0f};
+        glm::quat Rotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::vec3 Scale{1.0f};
+    };
+
+    struct FL_API SkeletonJoint {
+        std::string Name;
+        u32 Parent = InvalidJoint; // Index in the array given to the skeleton.
+        JointTransform BindPose;
+    };
+
+    /*
+     * Skeleton : Joint hierarchy an animation plays on. Joints are sorted breadth-first like the nodes of a
+     * TransformHierarchy, so a parent comes before its children and the joints of a packet of PoseWidth mostly sit at
+     * the same depth: their parents are in earlier packets and the packet goes to model space in one vectorized step.
+     * The few joints whose parent is in their own packet are redone one at a time after it. Raw animations and poses
+     * use this order, FindJoint and GetSourceIndex map it from names or from the order given to the constructor.
+     */
+    class FL_API Skeleton {
+        std::vector<std::string> m_Names;
+        std::vector<u32> m_ParentIndices;
+        std::vector<u32> m_SourceIndices;
+        std::vector<JointTransform> m_BindPose;
+        std::vector<u8> m_PacketLocalParents;
+
+    public:
+        // Parents may come after their children, but there must be no cycle.
+        explicit Skeleton(std::span<const SkeletonJoint> joints);
+        ~Skeleton() = default;
+
+        Skeleton(const Skeleton&) = delete;
+        Skeleton(Skeleton&&) = delete;
+
+        Skeleton& operator=(const Skeleton&) = delete;
+        Skeleton& operator=(Skeleton&&) = delete;
+
+        [[nodiscard]] inline u32 GetJointCount() const;
+        [[nodiscard]] inline u32 GetPacketCount() const;
+
+        [[nodiscard]] inline u32 GetParentIndex(u32 joint) const;
+        [[nodiscard]] inline std::span<const u32> GetParentIndices() const;
+        [[nodiscard]] inline const std::string& GetName(u32 joint) const;
+        [[nodiscard]] inline u32 GetSourceIndex(u32 joint) const;
+        [[nodiscard]] inline std::span<const JointTransform> GetBindPose() const;
+
+        // Bit l is set when the joint in lane l has its parent in the same packet.
+        [[nodiscard]] inline u8 GetPacketLocalParents(u32 packet) const;
+
+        // InvalidJoint when no joint has that name.
+        [[nodiscard]] u32 FindJoint(std::string_view name) const;
+    };
+
+#include <FlashlightEngine/Animation/Skeleton.inl>
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u32 Skeleton::GetJointCount() const {
+    return static_cast<u32>(m_ParentIndices.size());
+}
+
+inline u32 Skeleton::GetPacketCount() const {
+    return static_cast<u32>(m_PacketLocalParents.size());
+}
+
+inline u32 Skeleton::GetParentIndex(const u32 joint) const {
+    return m_ParentIndices[joint];
+}
+
+inline std::span<const u32> Skeleton::GetParentIndices() const {
+    return m_ParentIndices;
+}
+
+inline const std::string& Skeleton::GetName(const u32 joint) const {
+    return m_Names[joint];
+}
+
+inline u32 Skeleton::GetSourceIndex(const u32 joint) const {
+    return m_SourceIndices[joint];
+}
+
+inline std::span<const JointTransform> Skeleton::GetBindPose() const {
+    return m_BindPose;
+}
+
+inline u8 Skeleton::GetPacketLocalParents(const u32 packet) const {
+    return m_PacketLocalParents[packet];
+}
@@ -4,15 +4,44 @@
 
 #pragma once
 
+#include <FlashlightEngine/Asset/AssetManager.hpp>
+
+#include <FlashlightEngine/Core/EventBus.hpp>
+#include <FlashlightEngine/Core/EventRecorder.hpp>
+#include <FlashlightEngine/Core/FrameLimiter.hpp>
+#include <FlashlightEngine/Core/Input.hpp>
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Memory/FrameArena.hpp>
 #include <FlashlightEngine/Core/Window.hpp>
 
-namespace Flashlight {    
+#include <FlashlightEngine/Scene/Scene.hpp>
+
+namespace Flashlight {
+    enum class LoopMode : u8 {
+        Variable, // OnUpdate is called once per frame with the measured frame time.
+        FixedStep // OnUpdate is called zero or more times per frame with FixedDeltaTime.
+    };
+
+    struct FL_API FrameLoopSettings {
+        LoopMode Mode = LoopMode::Variable;
+        f32 FixedDeltaTime = 1.0f / 60.0f; // Must be positive.
+        u32 MaxStepsPerFrame = 8; // Time beyond this many steps is dropped so a slow frame can't snowball.
+        f32 TargetFrameRate = 0.0f; // 0 means uncapped.
+        f32 BackgroundFrameRate = 10.0f; // Used while the window is unfocused or iconified, 0 means no throttling.
+    };
+
+    struct FL_API ReplaySettings {
+        std::filesystem::path RecordingPath;
+        std::filesystem::path StatisticsPath; // Per-frame EngineStats are written there as CSV, empty to skip it.
+        f32 DeltaTime = 1.0f / 60.0f; // Frame time given to every replayed frame.
+    };
+
     class FL_API Application {
-        std::chrono::high_resolution_clock::time_point m_CurrentTime;
+        f64 m_CurrentTime = 0.0;
         static Application* m_SLoadedApplication;
         
     public:
-        Application(const WindowProperties& windowProperties);
+        explicit Application(const WindowProperties& windowProperties, const LoggerSettings& loggerSettings = {});
         virtual ~Application();
 
         Application(const Application&) noexcept = delete;
@@ -25,10 +54,44 @@ namespace Flashlight {
 
         [[nodiscard]] static inline Application& GetRunningInstance();
 
+        // Thread-safe, events published here are dispatched on the main thread at the start of the next frame.
+        [[nodiscard]] inline EventBus& GetEventBus();
+
+        [[nodiscard]] inline JobSystem& GetJobSystem();
+
+        // Main thread only, load callbacks are called at the start of the frame.
+        [[nodiscard]] inline AssetManager& GetAssetManager();
+
+        // Input state of the current frame, readable from any thread.
+        [[nodiscard]] inline const InputSnapshot& GetInput() const;
+
+        // Memory allocated here is released two frames later, nothing allocated from it is ever destroyed.
+        [[nodiscard]] inline FrameArena& GetFrameArena();
+
+        // Main thread only for structural changes, see Scene.
+        [[nodiscard]] inline Scene& GetScene();
+
+        [[nodiscard]] inline const FrameLoopSettings& GetFrameLoopSettings() const;
+        inline void SetFrameLoopSettings(const FrameLoopSettings& settings);
+
+        // Records every window event from the next frame on, until StopRecording or the application quits. Stopping
+        // during a frame ends the recording with that frame.
+        bool StartRecording(const std::filesystem::path& path);
+        void StopRecording();
+
+        /*
+         * Plays a recording back from the next frame on. Window input is ignored, frames use a fixed delta time and
+         * aren't paced, the application quits once the recorded frame count is reached.
+         */
+        bool StartReplay(const ReplaySettings& settings);
+        [[nodiscard]] inline bool IsReplaying() const;
+
     protected:
         virtual void OnUpdate() = 0;
         virtual void OnEvent(Event& event) = 0;
-        virtual void OnRender() = 0;
+        // interpolationAlpha is how far the current time is between the last two fixed steps, in [0, 1). It is always 1
+        // in variable mode.
+        virtual void OnRender(f32 interpolationAlpha) = 0;
 
         [[nodiscard]] inline bool IsRunning() const;
         inline void Close();
@@ -40,8 +103,41 @@ namespace Flashlight {
         EngineStats m_EngineStats{};
         
         std::unique_ptr<Window> m_Window;
+        std::unique_ptr<JobSystem> m_JobSystem;
+        std::unique_ptr<AssetManager> m_AssetManager;
 
     private:
+        EventHandlerTable m_EventHandlers;
+        EventBus m_EventBus;
+        Input m_Input;
+        Scene m_Scene;
+
+        FrameLoopSettings m_FrameLoopSettings;
+        FrameLimiter m_FrameLimiter;
+        FrameArena m_FrameArena;
+        f64 m_Accumulator = 0.0;
+        u64 m_FrameIndex = 0;
+        bool m_InFrame = false;
+
+        struct ReplayFrameStatistics {
+            u64 FrameIndex;
+            f32 WallTime;
+            EngineStats Stats;
+        };
+
+        EventRecorder m_Recorder;
+        u64 m_RecordingStartFrame = 0;
+
+        std::unique_ptr<EventRecording> m_Replay;
+        ReplaySettings m_ReplaySettings;
+        u64 m_ReplayStartFrame = 0;
+        std::vector<ReplayFrameStatistics> m_ReplayStatistics;
+
+        f32 Simulate(f32 frameTime);
+        void FinishReplay();
+
+        void OnWindowEvent(Event& event);
+        void DispatchEvent(Event& event);
         void OnWindowClose(Event& event);
     };
 
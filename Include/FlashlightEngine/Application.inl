@@ -8,6 +8,45 @@ inline Application& Application::GetRunningInstance() {
     return *m_SLoadedApplication;
 }
 
+inline EventBus& Application::GetEventBus() {
+    return m_EventBus;
+}
+
+inline JobSystem& Application::GetJobSystem() {
+    return *m_JobSystem;
+}
+
+inline AssetManager& Application::GetAssetManager() {
+    return *m_AssetManager;
+}
+
+inline const InputSnapshot& Application::GetInput() const {
+    return m_Input.GetSnapshot();
+}
+
+inline FrameArena& Application::GetFrameArena() {
+    return m_FrameArena;
+}
+
+inline Scene& Application::GetScene() {
+    return m_Scene;
+}
+
+inline const FrameLoopSettings& Application::GetFrameLoopSettings() const {
+    return m_FrameLoopSettings;
+}
+
+inline void Application::SetFrameLoopSettings(const FrameLoopSettings& settings) {
+    assert(settings.FixedDeltaTime > 0.0f && "The fixed delta time must be positive.");
+
+    m_FrameLoopSettings = settings;
+    m_Accumulator = 0.0;
+}
+
+inline bool Application::IsReplaying() const {
+    return m_Replay != nullptr;
+}
+
 inline bool Application::IsRunning() const {
     return m_IsRunning;
 }
@@ -0,0 +1,165 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/MemoryMappedFile.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace Flashlight {
+    class JobSystem;
+
+    /*
+     * Asset archive layout, every offset is from the start of the file and aligned to AssetArchiveAlignment:
+     * - AssetArchiveHeader.
+     * - The entry contents, stored as they are or compressed.
+     * - The table of contents, AssetArchiveEntry records sorted by path hash.
+     * - The paths of the entries, UTF-8 with '/' separators and not null-terminated.
+     */
+    inline constexpr std::array<char, 8> AssetArchiveMagic = {'F', 'L', 'P', 'A', 'C', 'K', '\0', '\0'};
+    inline constexpr u32 AssetArchiveVersion = 1;
+    inline constexpr u64 AssetArchiveAlignment = 64;
+
+    enum class AssetCompression : u8 {
+        None,
+        LZ4,
+        Zstd
+    };
+
+    // Error numbers of the filesystem module (0x03).
+    enum class AssetArchiveError : u8 {
+        None,
+        OpenFailed,
+        InvalidHeader,
+        UnsupportedVersion,
+        Corrupted,
+        EntryNotFound,
+        DuplicatePath,
+        BufferTooSmall,
+        DecompressionFailed,
+        CompressionFailed,
+        HashMismatch,
+        WriteFailed
+    };
+
+    struct AssetArchiveHeader {
+        std::array<char, 8> Magic;
+        u32 Version;
+        u32 EntryCount;
+        u64 TocOffset;
+        u64 PathsOffset;
+        u64 PathsSize;
+        u64 FileSize;
+        std::array<u8, 16> Reserved;
+    };
+
+    // One cache line per entry, so a lookup touches one line per binary search step.
+    struct AssetArchiveEntry {
+        u64 PathHash; // HashAssetPath of the path.
+        u64 ContentHash; // HashXxh64 of the uncompressed content.
+        u64 Offset;
+        u64 StoredSize;
+        u64 Size; // Uncompressed.
+        u32 PathOffset; // From the start of the paths block.
+        u32 PathLength;
+        AssetCompression Compression;
+        std::array<u8, 15> Reserved;
+    };
+
+    static_assert(sizeof(AssetArchiveHeader) == AssetArchiveAlignment);
+    static_assert(sizeof(AssetArchiveEntry) == AssetArchiveAlignment);
+
+    [[nodiscard]] inline ErrorCode GetErrorCode(AssetArchiveError error);
+    [[nodiscard]] FL_API std::string_view GetErrorName(AssetArchiveError error);
+
+    // Paths are hashed in their generic form, "Textures\\Brick.png" and "Textures/Brick.png" are the same entry.
+    [[nodiscard]] FL_API u64 HashAssetPath(std::string_view path);
+
+    /*
+     * AssetArchive : Read-only view of a packed asset archive, mapped in memory. Uncompressed entries are handed out
+     * as spans of the mapping, nothing is copied. The archive never changes once opened, so any number of threads
+     * can look entries up and read them at the same time without locking.
+     */
+    class FL_API AssetArchive {
+        MemoryMappedFile m_File;
+        std::span<const AssetArchiveEntry> m_Entries;
+        const char* m_Paths = nullptr;
+
+    public:
+        AssetArchive() = default;
+        ~AssetArchive() = default;
+
+        AssetArchive(const AssetArchive&) = delete;
+        AssetArchive(AssetArchive&&) = delete;
+
+        AssetArchive& operator=(const AssetArchive&) = delete;
+        AssetArchive& operator=(AssetArchive&&) = delete;
+
+        // Maps the archive and checks its header and table of contents, the contents are only checked by Verify.
+        AssetArchiveError Open(const std::filesystem::path& path);
+        void Close();
+
+        [[nodiscard]] inline bool IsOpen() const;
+
+        // Null if the archive has no entry with this path.
+        [[nodiscard]] const AssetArchiveEntry* Find(std::string_view path) const;
+
+        [[nodiscard]] inline std::span<const AssetArchiveEntry> GetEntries() const;
+        [[nodiscard]] inline std::string_view GetPath(const AssetArchiveEntry& entry) const;
+
+        // The bytes of the entry as stored in the archive, compressed or not.
+        [[nodiscard]] inline std::span<const std::byte> GetStoredData(const AssetArchiveEntry& entry) const;
+
+        // The content of an uncompressed entry, straight from the mapping.
+        [[nodiscard]] inline std::span<const std::byte> GetView(const AssetArchiveEntry& entry) const;
+
+        // Copies or decompresses the content of the entry, output must hold at least entry.Size bytes.
+        AssetArchiveError Read(const AssetArchiveEntry& entry, std::span<std::byte> output) const;
+
+        // Checks the content of the entry against its hash.
+        AssetArchiveError Verify(const AssetArchiveEntry& entry) const;
+    };
+
+    /*
+     * AssetArchiveWriter : Collects files and writes them into an archive. Compression runs in parallel on the job
+     * system when one is given, entries that don't get smaller are stored uncompressed.
+     */
+    class FL_API AssetArchiveWriter {
+        struct PendingEntry {
+            std::string Path;
+            std::vector<std::byte> Content;
+            AssetCompression Compression;
+        };
+
+        std::vector<PendingEntry> m_Entries;
+
+    public:
+        AssetArchiveWriter() = default;
+        ~AssetArchiveWriter() = default;
+
+        AssetArchiveWriter(const AssetArchiveWriter&) = delete;
+        AssetArchiveWriter(AssetArchiveWriter&&) = delete;
+
+        AssetArchiveWriter& operator=(const AssetArchiveWriter&) = delete;
+        AssetArchiveWriter& operator=(AssetArchiveWriter&&) = delete;
+
+        void Add(std::string_view path, std::vector<std::byte> content,
+                 AssetCompression compression = AssetCompression::None);
+        AssetArchiveError AddFile(const std::filesystem::path& file, std::string_view path,
+                                  AssetCompression compression = AssetCompression::None);
+
+        [[nodiscard]] inline u32 GetEntryCount() const;
+
+        AssetArchiveError Write(const std::filesystem::path& path, JobSystem* jobs = nullptr);
+    };
+
+#include <FlashlightEngine/Asset/AssetArchive.inl>
+}
@@ -0,0 +1,35 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline ErrorCode GetErrorCode(const AssetArchiveError error) {
+    return {0x03, static_cast<u8>(error)};
+}
+
+inline bool AssetArchive::IsOpen() const {
+    return m_File.IsOpen();
+}
+
+inline std::span<const AssetArchiveEntry> AssetArchive::GetEntries() const {
+    return m_Entries;
+}
+
+inline std::string_view AssetArchive::GetPath(const AssetArchiveEntry& entry) const {
+    return {m_Paths + entry.PathOffset, entry.PathLength};
+}
+
+inline std::span<const std::byte> AssetArchive::GetStoredData(const AssetArchiveEntry& entry) const {
+    return m_File.GetSpan().subspan(entry.Offset, entry.StoredSize);
+}
+
+inline std::span<const std::byte> AssetArchive::GetView(const AssetArchiveEntry& entry) const {
+    assert(entry.Compression == AssetCompression::None && "Compressed entries have to be read.");
+
+    return GetStoredData(entry);
+}
+
+inline u32 AssetArchiveWriter::GetEntryCount() const {
+    return static_cast<u32>(m_Entries.size());
+}
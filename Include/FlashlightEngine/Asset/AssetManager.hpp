@@ -0,0 +1,217 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Asset/AssetArchive.hpp>
+
+#include <FlashlightEngine/Core/BoundedQueue.hpp>
+#include <FlashlightEngine/Core/JobSystem.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace Flashlight {
+    /*
+     * AssetHandle : Handle to an asset of an AssetManager. The index is reused once the asset is released, the
+     * generation is bumped at the same time so handles to the old asset are detected as dead.
+     */
+    struct FL_API AssetHandle {
+        static constexpr u32 InvalidIndex = std::numeric_limits<u32>::max();
+
+        u32 Index = InvalidIndex;
+        u32 Generation = 0;
+
+        [[nodiscard]] constexpr bool IsValid() const {
+            return Index != InvalidIndex;
+        }
+
+        constexpr bool operator==(const AssetHandle&) const = default;
+    };
+
+    enum class AssetState : u8 {
+        Unloaded, // Released, or a dead handle.
+        Queued,
+        Reading,
+        Decoding,
+        Ready,
+        Failed,
+        Cancelled
+    };
+
+    // Requests with a higher priority are read first, requests of the same priority in the order they were made.
+    enum class AssetPriority : u8 {
+        Low,
+        Normal,
+        High,
+        Critical
+    };
+
+    struct FL_API TextureData {
+        u32 Width = 0;
+        u32 Height = 0;
+        u32 Channels = 0;
+        u8* Pixels = nullptr; // Owned by the asset manager.
+
+        [[nodiscard]] inline u64 GetSize() const;
+        [[nodiscard]] inline std::span<const u8> GetPixels() const;
+    };
+
+    struct FL_API AssetManagerSettings {
+        u32 IoThreadCount = 2;
+        u32 MaxAssetCount = 4096;
+
+        // Soft limit on the file data and decoded pixels held at once, loaded textures included: reads only start
+        // while the memory held is under it, so it is exceeded by at most what the requests already in flight need.
+        // Once it is reached, requests wait until assets are released, or fail in WaitIdle if nothing can free any.
+        u64 MemoryBudget = 1ull << 30;
+
+        // Decodes on the I/O threads when null or when the job system has no worker thread besides the main one.
+        JobSystem* Jobs = nullptr;
+
+        // Paths found in the archive are loaded from it, uncompressed entries without any copy. Others are read from
+        // the disk. Must outlive the asset manager.
+        const AssetArchive* Archive = nullptr;
+    };
+
+    struct FL_API AssetStatistics {
+        u64 Requested = 0;
+        u64 Loaded = 0;
+        u64 Failed = 0;
+        u64 Cancelled = 0;
+        u64 BytesRead = 0;
+        u64 MemoryUsed = 0;
+        u32 PendingCount = 0;
+    };
+
+    // Called from AssetManager::Update once the request is done, whether it succeeded, failed or was cancelled.
+    using AssetCallback = std::function<void(AssetHandle handle, AssetState state)>;
+
+    /*
+     * AssetManager : Loads textures in the background. Files are read by a pool of I/O threads in priority order and
+     * decoded with stb_image on the job system, so requesting an asset only costs the main thread a queue push.
+     * Completions are handed back to the main thread by Update, which the application calls once per frame.
+     * Every member function must be called from the main thread. Failed and cancelled assets keep their slot until
+     * they are released.
+     */
+    class FL_API AssetManager {
+        struct Slot {
+            std::atomic<AssetState> State{AssetState::Unloaded};
+            u32 Generation = 0;
+            std::filesystem::path Path;
+            u32 DesiredChannels = 0;
+            AssetCallback Callback;
+            TextureData Texture;
+            std::vector<u8> FileData;
+            std::span<const u8> Source; // FileData, or an archive entry.
+            u64 HeldBytes = 0;
+
+            // Main thread only.
+            bool InFlight = false;
+            bool ReleaseRequested = false;
+        };
+
+        struct IoRequest {
+            AssetPriority Priority;
+            u64 Sequence;
+            u32 Index;
+
+            // Orders the heap so the front is the highest priority, then the oldest request.
+            inline bool operator<(const IoRequest& other) const;
+        };
+
+        AssetManagerSettings m_Settings;
+        std::unique_ptr<Slot[]> m_Slots;
+        std::vector<u32> m_FreeIndices;
+        u64 m_NextSequence = 0;
+        u32 m_PendingCount = 0;
+
+        std::mutex m_QueueMutex;
+        std::condition_variable m_QueueCondition;
+        std::vector<IoRequest> m_Queue; // Heap.
+        std::atomic<bool> m_Stopping{false};
+        std::vector<std::thread> m_IoThreads;
+
+        std::mutex m_MemoryMutex;
+        std::condition_variable m_MemoryCondition;
+        u64 m_MemoryUsed = 0;
+        u32 m_ActiveCount = 0; // Requests past the memory budget check, until they finish.
+        bool m_FailOverBudget = false; // Set by WaitIdle when the budget is full and no active request can free any.
+
+        BoundedQueue<u32> m_Completions;
+        JobCounter m_DecodeCounter;
+
+        std::atomic<u64> m_BytesRead{0};
+        u64 m_RequestedCount = 0;
+        u64 m_LoadedCount = 0;
+        u64 m_FailedCount = 0;
+        u64 m_CancelledCount = 0;
+
+    public:
+        explicit AssetManager(const AssetManagerSettings& settings = {});
+        ~AssetManager();
+
+        AssetManager(const AssetManager&) = delete;
+        AssetManager(AssetManager&&) = delete;
+
+        AssetManager& operator=(const AssetManager&) = delete;
+        AssetManager& operator=(AssetManager&&) = delete;
+
+        /*
+         * Returns right away with a handle to the texture, which is Ready once loaded. desiredChannels forces the
+         * channel count of the pixels, 0 keeps the one of the file. Returns an invalid handle if every slot is taken.
+         */
+        AssetHandle LoadTexture(const std::filesystem::path& path, AssetPriority priority = AssetPriority::Normal,
+                                AssetCallback callback = {}, u32 desiredChannels = 4);
+
+        // Stops the request as soon as possible, the callback still gets called with the Cancelled state.
+        void Cancel(AssetHandle handle);
+
+        // Frees the asset, cancelling it first if it is still loading. The handle is dead afterwards.
+        void Release(AssetHandle handle);
+
+        // Calls the callbacks of the requests done since the last call. Returns how many there were.
+        u32 Update();
+
+        /*
+         * Blocks until no request is left, calling Update meanwhile. Meant for loading screens and tools. When loaded
+         * textures fill the memory budget and no request in flight can free any, the requests left fail rather than
+         * wait for releases that can't come while the main thread is blocked here.
+         */
+        void WaitIdle();
+
+        [[nodiscard]] AssetState GetState(AssetHandle handle) const;
+
+        // Null unless the texture is Ready.
+        [[nodiscard]] const TextureData* GetTexture(AssetHandle handle) const;
+
+        [[nodiscard]] AssetStatistics GetStatistics();
+
+    private:
+        [[nodiscard]] inline bool IsAlive(AssetHandle handle) const;
+
+        void IoThreadMain();
+        void Read(u32 index);
+        bool ReadFromArchive(Slot& slot);
+        void Decode(u32 index);
+        void Finish(u32 index, AssetState from, AssetState to);
+        void Complete(u32 index);
+        bool RemoveQueued(u32 index);
+        bool IsStalled();
+        void FreeSlot(u32 index);
+        void HoldMemory(Slot& slot, u64 bytes);
+        void ReleaseMemory(Slot& slot, u64 bytes);
+        void FreeTexture(Slot& slot);
+    };
+
+#include <FlashlightEngine/Asset/AssetManager.inl>
+}
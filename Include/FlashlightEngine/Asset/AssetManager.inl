@@ -0,0 +1,26 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u64 TextureData::GetSize() const {
+    return static_cast<u64>(Width) * Height * Channels;
+}
+
+inline std::span<const u8> TextureData::GetPixels() const {
+    return {Pixels, GetSize()};
+}
+
+inline bool AssetManager::IoRequest::operator<(const IoRequest& other) const {
+    if (Priority != other.Priority) {
+        return Priority < other.Priority;
+    }
+
+    return Sequence > other.Sequence;
+}
+
+inline bool AssetManager::IsAlive(const AssetHandle handle) const {
+    return handle.Index < m_Settings.MaxAssetCount && m_Slots[handle.Index].Generation == handle.Generation &&
+           m_Slots[handle.Index].State.load(std::memory_order_acquire) != AssetState::Unloaded;
+}
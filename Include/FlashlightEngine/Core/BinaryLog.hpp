@@ -0,0 +1,128 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/MemoryMappedFile.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <string_view>
+
+// Writes a binary log record. The format string is registered once per call site, the first time the call is reached,
+// after that a call only copies the format id and the raw argument bytes into the log file.
+#define FL_BINARY_LOG(level, ...)                                                                               \
+    ::Flashlight::BinaryLog::Write(level, [](const std::string_view format) {                                   \
+        static const u32 formatId = ::Flashlight::BinaryLog::RegisterFormat(format);                            \
+        return formatId;                                                                                        \
+    }, __VA_ARGS__)
+
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_TRACE
+    #define FL_BINARY_TRACE(...) FL_BINARY_LOG(spdlog::level::trace, __VA_ARGS__)
+#else
+    #define FL_BINARY_TRACE(...) static_cast<void>(0)
+#endif
+
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_INFO
+    #define FL_BINARY_INFO(...) FL_BINARY_LOG(spdlog::level::info, __VA_ARGS__)
+#else
+    #define FL_BINARY_INFO(...) static_cast<void>(0)
+#endif
+
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_WARN
+    #define FL_BINARY_WARN(...) FL_BINARY_LOG(spdlog::level::warn, __VA_ARGS__)
+#else
+    #define FL_BINARY_WARN(...) static_cast<void>(0)
+#endif
+
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_ERROR
+    #define FL_BINARY_ERROR(...) FL_BINARY_LOG(spdlog::level::err, __VA_ARGS__)
+#else
+    #define FL_BINARY_ERROR(...) static_cast<void>(0)
+#endif
+
+namespace Flashlight {
+    constexpr std::array<char, 8> BinaryLogMagic = {'F', 'L', 'B', 'L', 'O', 'G', '\0', '\1'};
+    constexpr u32 BinaryLogVersion = 1;
+
+    struct BinaryLogFileHeader {
+        std::array<char, 8> Magic;
+        u32 Version;
+        u32 HeaderSize;
+        i64 SystemClockAtOpen; // Nanoseconds since the UNIX epoch.
+        i64 SteadyClockAtOpen; // Nanoseconds, same clock as the record timestamps.
+    };
+
+    enum class BinaryLogRecordKind : u8 {
+        Format = 1, // Payload is the format string of FormatId.
+        Message = 2 // Payload is ArgumentCount encoded arguments.
+    };
+
+    // Every record starts with this header, records are padded to 8 bytes. A zero size marks the end of the log.
+    struct BinaryLogRecordHeader {
+        u32 Size;
+        BinaryLogRecordKind Kind;
+        u8 Level;
+        u16 ArgumentCount;
+        u32 FormatId;
+        u32 ThreadId;
+        i64 Timestamp;
+    };
+
+    // Each argument is a one byte type tag followed by the raw value, strings are prefixed with their u32 length.
+    enum class BinaryLogArgumentType : u8 {
+        Bool, Char,
+        I8, I16, I32, I64,
+        U8, U16, U32, U64,
+        F32, F64,
+        String
+    };
+
+    /*
+     * BinaryLog : Structured log written into a memory-mapped file without any text formatting, decoded offline by the
+     * FlashlightLogDecoder tool. Writing is lock-free, records that don't fit in the file anymore are dropped.
+     * Writers count themselves in while they touch the mapping, Close waits for them before unmapping the file.
+     * Open and Close may run while other threads log, but not at the same time as each other.
+     */
+    class FL_API BinaryLog {
+        static MemoryMappedFile m_File;
+        static std::atomic<bool> m_IsOpen;
+        static std::atomic<u32> m_ActiveWriters;
+        static std::atomic<u64> m_WriteOffset;
+        static std::atomic<u64> m_DroppedCount;
+
+        static std::mutex m_FormatsMutex;
+        static std::vector<std::string> m_Formats;
+
+    public:
+        static bool Open(const std::filesystem::path& path, u64 capacity = 64ull * 1024 * 1024);
+        static void Close();
+
+        [[nodiscard]] static inline bool IsOpen();
+        [[nodiscard]] static inline u64 GetDroppedRecordCount();
+
+        // Returns the id of the format, formats registered while no file is open are written when one is opened.
+        static u32 RegisterFormat(std::string_view format);
+
+        template <typename FormatRegistrar, typename... Args>
+        static void Write(spdlog::level::level_enum level, FormatRegistrar&& registrar, std::string_view format,
+                          const Args&... args);
+
+    private:
+        // BeginWrite returns false when the log is closed, otherwise m_File stays mapped until the matching EndWrite.
+        [[nodiscard]] static inline bool BeginWrite();
+        static inline void EndWrite();
+
+        static std::byte* Reserve(u32 size);
+        static void Commit(std::byte* record, u32 size);
+        static void WriteFormatRecord(u32 formatId, std::string_view format);
+        static u32 GetThreadId();
+    };
+
+#include <FlashlightEngine/Core/BinaryLog.inl>
+}
@@ -0,0 +1,125 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+namespace BinaryLogEncoding {
+    template <typename T>
+    constexpr bool IsString = std::is_convertible_v<const T&, std::string_view>;
+
+    template <typename T>
+    constexpr BinaryLogArgumentType GetArgumentType() {
+        if constexpr (std::is_enum_v<T>) {
+            return GetArgumentType<std::underlying_type_t<T>>();
+        } else if constexpr (IsString<T>) {
+            return BinaryLogArgumentType::String;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return BinaryLogArgumentType::Bool;
+        } else if constexpr (std::is_same_v<T, char>) {
+            return BinaryLogArgumentType::Char;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Unsupported floating point argument.");
+            return sizeof(T) == 4 ? BinaryLogArgumentType::F32 : BinaryLogArgumentType::F64;
+        } else if constexpr (std::is_signed_v<T>) {
+            static_assert(std::is_integral_v<T>, "Unsupported binary log argument type.");
+            constexpr BinaryLogArgumentType types[] = {
+                BinaryLogArgumentType::I8, BinaryLogArgumentType::I16, BinaryLogArgumentType::I32,
+                BinaryLogArgumentType::I32, BinaryLogArgumentType::I64
+            };
+            return sizeof(T) == 8 ? BinaryLogArgumentType::I64 : types[sizeof(T) - 1];
+        } else {
+            static_assert(std::is_integral_v<T>, "Unsupported binary log argument type.");
+            constexpr BinaryLogArgumentType types[] = {
+                BinaryLogArgumentType::U8, BinaryLogArgumentType::U16, BinaryLogArgumentType::U32,
+                BinaryLogArgumentType::U32, BinaryLogArgumentType::U64
+            };
+            return sizeof(T) == 8 ? BinaryLogArgumentType::U64 : types[sizeof(T) - 1];
+        }
+    }
+
+    template <typename T>
+    u32 GetEncodedSize(const T& argument) {
+        if constexpr (IsString<T>) {
+            return 1 + sizeof(u32) + static_cast<u32>(std::string_view(argument).size());
+        } else {
+            return 1 + sizeof(T);
+        }
+    }
+
+    template <typename T>
+    std::byte* Encode(std::byte* output, const T& argument) {
+        *output++ = static_cast<std::byte>(GetArgumentType<T>());
+
+        if constexpr (IsString<T>) {
+            const std::string_view string(argument);
+            const u32 length = static_cast<u32>(string.size());
+            std::memcpy(output, &length, sizeof(length));
+            std::memcpy(output + sizeof(length), string.data(), length);
+            return output + sizeof(length) + length;
+        } else {
+            std::memcpy(output, &argument, sizeof(T));
+            return output + sizeof(T);
+        }
+    }
+}
+
+inline bool BinaryLog::IsOpen() {
+    return m_IsOpen.load(std::memory_order_acquire);
+}
+
+inline u64 BinaryLog::GetDroppedRecordCount() {
+    return m_DroppedCount.load(std::memory_order_relaxed);
+}
+
+inline bool BinaryLog::BeginWrite() {
+    // Sequentially consistent with the store and load in Close: either Close sees this writer, or the writer sees the
+    // log closed.
+    m_ActiveWriters.fetch_add(1, std::memory_order_seq_cst);
+    if (m_IsOpen.load(std::memory_order_seq_cst)) {
+        return true;
+    }
+
+    EndWrite();
+    return false;
+}
+
+inline void BinaryLog::EndWrite() {
+    m_ActiveWriters.fetch_sub(1, std::memory_order_release);
+}
+
+template <typename FormatRegistrar, typename... Args>
+void BinaryLog::Write(const spdlog::level::level_enum level, FormatRegistrar&& registrar, const std::string_view format,
+                      const Args&... args) {
+    const u32 formatId = registrar(format);
+
+    // Closed logs cost a relaxed load, without touching the writer count.
+    if (!m_IsOpen.load(std::memory_order_relaxed) || !BeginWrite()) {
+        return;
+    }
+
+    const u32 payloadSize = (0 + ... + BinaryLogEncoding::GetEncodedSize(args));
+    const u32 recordSize = (static_cast<u32>(sizeof(BinaryLogRecordHeader)) + payloadSize + 7u) & ~7u;
+
+    std::byte* record = Reserve(recordSize);
+    if (record == nullptr) {
+        EndWrite();
+        return;
+    }
+
+    BinaryLogRecordHeader header{};
+    header.Kind = BinaryLogRecordKind::Message;
+    header.Level = static_cast<u8>(level);
+    header.ArgumentCount = static_cast<u16>(sizeof...(Args));
+    header.FormatId = formatId;
+    header.ThreadId = GetThreadId();
+    header.Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::memcpy(record, &header, sizeof(header));
+
+    std::byte* output = record + sizeof(header);
+    ((output = BinaryLogEncoding::Encode(output, args)), ...);
+
+    Commit(record, recordSize);
+    EndWrite();
+}
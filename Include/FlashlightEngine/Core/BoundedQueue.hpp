@@ -0,0 +1,55 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Platform.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+
+#include <atomic>
+
+namespace Flashlight {
+    /*
+     * BoundedQueue : Lock-free multi-producer multi-consumer queue with a fixed number of slots allocated up front.
+     * Every slot carries a sequence number telling producers and consumers whose turn it is (D. Vyukov's design), so
+     * items pushed by one thread are always popped in the order that thread pushed them.
+     * The capacity is rounded up to a power of two.
+     */
+    template <typename T>
+    class BoundedQueue {
+        struct Cell {
+            std::atomic<u64> Sequence;
+            T Value;
+        };
+
+        std::unique_ptr<Cell[]> m_Cells;
+        u64 m_Mask;
+
+        alignas(CacheLineSize) std::atomic<u64> m_EnqueuePosition{0};
+        alignas(CacheLineSize) std::atomic<u64> m_DequeuePosition{0};
+
+    public:
+        explicit BoundedQueue(u64 capacity);
+        ~BoundedQueue() = default;
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue(BoundedQueue&&) = delete;
+
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(BoundedQueue&&) = delete;
+
+        // Returns false without blocking if the queue is full.
+        template <typename U>
+        bool TryPush(U&& value);
+
+        // Returns false without blocking if the queue is empty.
+        bool TryPop(T& value);
+
+        [[nodiscard]] inline u64 GetCapacity() const;
+        [[nodiscard]] inline u64 GetApproximateSize() const;
+    };
+
+#include <FlashlightEngine/Core/BoundedQueue.inl>
+}
@@ -0,0 +1,88 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+template <typename T>
+BoundedQueue<T>::BoundedQueue(const u64 capacity) {
+    u64 roundedCapacity = 2;
+    while (roundedCapacity < capacity) {
+        roundedCapacity <<= 1;
+    }
+
+    m_Cells = std::make_unique<Cell[]>(roundedCapacity);
+    m_Mask = roundedCapacity - 1;
+
+    for (u64 i = 0; i < roundedCapacity; i++) {
+        m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+template <typename U>
+bool BoundedQueue<T>::TryPush(U&& value) {
+    u64 position = m_EnqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    for (;;) {
+        cell = &m_Cells[position & m_Mask];
+        const u64 sequence = cell->Sequence.load(std::memory_order_acquire);
+        const i64 difference = static_cast<i64>(sequence) - static_cast<i64>(position);
+
+        if (difference == 0) {
+            if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->Value = std::forward<U>(value);
+    cell->Sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+bool BoundedQueue<T>::TryPop(T& value) {
+    u64 position = m_DequeuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    for (;;) {
+        cell = &m_Cells[position & m_Mask];
+        const u64 sequence = cell->Sequence.load(std::memory_order_acquire);
+        const i64 difference = static_cast<i64>(sequence) - static_cast<i64>(position + 1);
+
+        if (difference == 0) {
+            if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = m_DequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    value = std::move(cell->Value);
+    cell->Sequence.store(position + m_Mask + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+inline u64 BoundedQueue<T>::GetCapacity() const {
+    return m_Mask + 1;
+}
+
+template <typename T>
+inline u64 BoundedQueue<T>::GetApproximateSize() const {
+    const u64 enqueuePosition = m_EnqueuePosition.load(std::memory_order_relaxed);
+    const u64 dequeuePosition = m_DequeuePosition.load(std::memory_order_relaxed);
+
+    return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+}
@@ -28,9 +28,12 @@ namespace Flashlight {
 
         WindowClose, WindowResize, WindowMoved, WindowFocus,
         KeyDown, KeyUp, KeyTyped,
-        MouseButtonDown, MouseButtonUp, MouseMoved, MouseScroll
+        MouseButtonDown, MouseButtonUp, MouseMoved, MouseScroll,
+        User
     };
 
+    constexpr u32 EventTypeCount = IntegerFromEnum(EventType::User) + 1;
+
     enum class EventCategory : u8 {
         Undefined = 0,
 
@@ -38,7 +41,8 @@ namespace Flashlight {
         Input = BitFromNumber(1),
         Keyboard = BitFromNumber(2),
         Mouse = BitFromNumber(3),
-        MouseButton = BitFromNumber(4)
+        MouseButton = BitFromNumber(4),
+        User = BitFromNumber(5)
     };
 
     inline EventCategory operator|(const EventCategory a, const EventCategory b);
@@ -46,8 +50,7 @@ namespace Flashlight {
 #define BIND_EVENT_TO_EVENT_HANDLER(x) [this](auto && PH1) { return (x)(PH1); }
     
 #define EVENT_TYPE_CLASS(type)                                                  \
-static EventType GetStaticType() { return type; }                           \
-virtual EventType GetEventType() const override { return GetStaticType(); } \
+static constexpr EventType GetStaticType() { return type; }                 \
 virtual const char* GetName() const override { return #type; }
 
 
@@ -57,11 +60,12 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
     class FL_API Event {
         friend class EventDispatcher;
 
+        EventType m_Type;
         bool m_Handled = false;
 
     public:
         virtual ~Event() = default;
-        [[nodiscard]] virtual EventType GetEventType() const = 0;
+        [[nodiscard]] inline EventType GetEventType() const;
         [[nodiscard]] virtual const char* GetName() const = 0;
         [[nodiscard]] virtual i32 GetCategoryFlags() const = 0;
 
@@ -72,6 +76,10 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
         inline bool IsHandled() const;
 
         inline void Stop();
+
+    protected:
+        explicit Event(const EventType type) : m_Type(type) {
+        }
     };
 
     class FL_API EventDispatcher {
@@ -81,8 +89,31 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
         explicit EventDispatcher(Event& event) : m_Event(event) {
         }
 
+        template <typename T, typename Handler>
+        bool Dispatch(Handler&& handler);
+    };
+
+    /*
+     * EventHandlerTable : Event handlers registered once and indexed by EventType, so dispatching an event is a single
+     * indexed call through a function pointer, with no allocation and no type comparison.
+     */
+    class FL_API EventHandlerTable {
+        struct HandlerEntry {
+            void* Instance = nullptr;
+            void (*Invoke)(void* instance, Event& event) = nullptr;
+        };
+
+        std::array<HandlerEntry, EventTypeCount> m_Handlers{};
+
+    public:
+        // Registers instance->Method(T&) as the handler of T, replacing any previous one.
+        template <typename T, auto Method, typename Class>
+        void Register(Class* instance);
+
         template <typename T>
-        bool Dispatch(std::function<void(T&)> handler);
+        inline void Unregister();
+
+        inline bool Dispatch(Event& event) const;
     };
 
     inline std::ostream& operator<<(std::ostream& os, const Event& event);
@@ -95,7 +126,8 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
         u32 m_Width, m_Height;
 
     public:
-        WindowResizeEvent(const u32 width, const u32 height) : m_Width(width), m_Height(height) {
+        WindowResizeEvent(const u32 width, const u32 height) : Event(GetStaticType()), m_Width(width),
+                                                               m_Height(height) {
         }
 
         ~WindowResizeEvent() override = default;
@@ -124,7 +156,8 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
 
     class FL_API WindowCloseEvent final : public Event {
     public:
-        WindowCloseEvent() = default;
+        WindowCloseEvent() : Event(GetStaticType()) {
+        }
 
         EVENT_TYPE_CLASS(EventType::WindowClose)
         EVENT_CATEGORY_CLASS(EventCategory::Application)
@@ -134,7 +167,7 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
         bool m_Focused;
 
     public:
-        explicit WindowFocusedEvent(const bool focused) : m_Focused(focused) {
+        explicit WindowFocusedEvent(const bool focused) : Event(GetStaticType()), m_Focused(focused) {
         }
 
         [[nodiscard]] inline bool IsFocused() const {
@@ -149,7 +182,15 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
         i32 m_XPos, m_YPos;
 
     public:
-        WindowMovedEvent(const i32 x, const i32 y) : m_XPos(x), m_YPos(y) {
+        WindowMovedEvent(const i32 x, const i32 y) : Event(GetStaticType()), m_XPos(x), m_YPos(y) {
+        }
+
+        [[nodiscard]] inline i32 GetX() const {
+            return m_XPos;
+        }
+
+        [[nodiscard]] inline i32 GetY() const {
+            return m_YPos;
         }
 
         [[nodiscard]] inline std::string ToString() const override {
@@ -177,7 +218,7 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
     protected:
         i32 m_Scancode;
 
-        explicit KeyEvent(const i32 scancode) : m_Scancode(scancode) {
+        KeyEvent(const EventType type, const i32 scancode) : Event(type), m_Scancode(scancode) {
         }
     };
 
@@ -185,10 +226,14 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
         i32 m_RepetitionCount;
 
     public:
-        KeyDownEvent(const i32 scancode, const i32 repetitionCount) : KeyEvent(scancode),
+        KeyDownEvent(const i32 scancode, const i32 repetitionCount) : KeyEvent(GetStaticType(), scancode),
                                                                       m_RepetitionCount(repetitionCount) {
         }
 
+        [[nodiscard]] inline i32 GetRepetitionCount() const {
+            return m_RepetitionCount;
+        }
+
         [[nodiscard]] std::string ToString() const override {
             std::stringstream ss;
             ss << "Key down: Scancode=" << m_Scancode << " Repeated " << m_RepetitionCount << " times";
@@ -200,7 +245,7 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
 
     class FL_API KeyUpEvent final : public KeyEvent {
     public:
-        explicit KeyUpEvent(const i32 scancode) : KeyEvent(scancode) {
+        explicit KeyUpEvent(const i32 scancode) : KeyEvent(GetStaticType(), scancode) {
         }
 
         [[nodiscard]] std::string ToString() const override {
@@ -214,7 +259,7 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
 
     class FL_API KeyTypedEvent final : public KeyEvent {
     public:
-        KeyTypedEvent(const i32 scancode) : KeyEvent(scancode) {
+        KeyTypedEvent(const i32 scancode) : KeyEvent(GetStaticType(), scancode) {
         }
 
         [[nodiscard]] std::string ToString() const override {
@@ -234,7 +279,7 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
         f32 m_MouseX, m_MouseY;
 
     public:
-        MouseMovedEvent(const f32 x, const f32 y) : m_MouseX(x), m_MouseY(y) {
+        MouseMovedEvent(const f32 x, const f32 y) : Event(GetStaticType()), m_MouseX(x), m_MouseY(y) {
         }
 
         [[nodiscard]] inline f32 GetX() const {
@@ -263,7 +308,8 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
         f32 m_XOffset, m_YOffset;
 
     public:
-        MouseScrolledEvent(const f32 xOffset, const f32 yOffset) : m_XOffset(xOffset), m_YOffset(yOffset) {
+        MouseScrolledEvent(const f32 xOffset, const f32 yOffset) : Event(GetStaticType()), m_XOffset(xOffset),
+                                                                   m_YOffset(yOffset) {
         }
 
         [[nodiscard]] inline f32 GetXOffset() const {
@@ -295,14 +341,14 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
     protected:
         i32 m_Button;
 
-        explicit MouseButtonEvent(const i32 button) : m_Button(button) {
+        MouseButtonEvent(const EventType type, const i32 button) : Event(type), m_Button(button) {
         
         }
     };
 
     class FL_API MouseButtonDownEvent final : public MouseButtonEvent {
     public:
-        explicit MouseButtonDownEvent(const i32 button) : MouseButtonEvent(button) {
+        explicit MouseButtonDownEvent(const i32 button) : MouseButtonEvent(GetStaticType(), button) {
         }
 
         [[nodiscard]] std::string ToString() const override {
@@ -316,7 +362,7 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
 
     class FL_API MouseButtonUpEvent final : public MouseButtonEvent {
     public:
-        explicit MouseButtonUpEvent(const i32 button) : MouseButtonEvent(button) {
+        explicit MouseButtonUpEvent(const i32 button) : MouseButtonEvent(GetStaticType(), button) {
         }
 
         [[nodiscard]] std::string ToString() const override {
@@ -330,6 +376,43 @@ virtual int GetCategoryFlags() const override { return IntegerFromEnum(category)
 
 #pragma endregion Mouse Events
 
+#pragma region User Events
+
+    // Event posted by engine or application systems, the code tells the receiver how to interpret the payload.
+    class FL_API UserEvent final : public Event {
+        u32 m_Code;
+        u64 m_Data;
+        void* m_Pointer;
+
+    public:
+        explicit UserEvent(const u32 code, const u64 data = 0, void* pointer = nullptr) : Event(GetStaticType()),
+            m_Code(code), m_Data(data), m_Pointer(pointer) {
+        }
+
+        [[nodiscard]] inline u32 GetCode() const {
+            return m_Code;
+        }
+
+        [[nodiscard]] inline u64 GetData() const {
+            return m_Data;
+        }
+
+        [[nodiscard]] inline void* GetPointer() const {
+            return m_Pointer;
+        }
+
+        [[nodiscard]] std::string ToString() const override {
+            std::stringstream ss;
+            ss << "User event: Code=" << m_Code << ", Data=" << m_Data;
+            return ss.str();
+        }
+
+        EVENT_TYPE_CLASS(EventType::User)
+        EVENT_CATEGORY_CLASS(EventCategory::User)
+    };
+
+#pragma endregion User Events
+
 #pragma endregion Events
 
 #include <FlashlightEngine/Core/Event.inl>
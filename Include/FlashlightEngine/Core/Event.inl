@@ -8,6 +8,10 @@ inline EventCategory operator|(const EventCategory a, const EventCategory b) {
     return static_cast<EventCategory>(IntegerFromEnum(a) | IntegerFromEnum(b));
 }
 
+inline EventType Event::GetEventType() const {
+    return m_Type;
+}
+
 inline std::string Event::ToString() const {
     return GetName();
 }
@@ -24,15 +28,40 @@ inline void Event::Stop() {
     m_Handled = false;
 }
 
-template <typename T>
-bool EventDispatcher::Dispatch(std::function<void(T&)> handler) {
-    if (m_Event.GetEventType() == T::GetStaticType()) {
+template <typename T, typename Handler>
+bool EventDispatcher::Dispatch(Handler&& handler) {
+    if (m_Event.m_Type == T::GetStaticType()) {
         handler(static_cast<T&>(m_Event));
         return true;
     }
     return false;
 }
 
+template <typename T, auto Method, typename Class>
+void EventHandlerTable::Register(Class* instance) {
+    m_Handlers[IntegerFromEnum(T::GetStaticType())] = {
+        instance,
+        [](void* handlerInstance, Event& event) {
+            (static_cast<Class*>(handlerInstance)->*Method)(static_cast<T&>(event));
+        }
+    };
+}
+
+template <typename T>
+inline void EventHandlerTable::Unregister() {
+    m_Handlers[IntegerFromEnum(T::GetStaticType())] = {};
+}
+
+inline bool EventHandlerTable::Dispatch(Event& event) const {
+    const HandlerEntry& entry = m_Handlers[IntegerFromEnum(event.GetEventType())];
+    if (entry.Invoke == nullptr) {
+        return false;
+    }
+
+    entry.Invoke(entry.Instance, event);
+    return true;
+}
+
 inline std::ostream& operator<<(std::ostream& os, const Event& event) {
     return os << event.ToString();
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/BoundedQueue.hpp>
+#include <FlashlightEngine/Core/EventQueue.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+namespace Flashlight {
+    struct FL_API EventBusStatistics {
+        u64 Published = 0;
+        u64 Dropped = 0;
+        u64 Dispatched = 0;
+        u64 HighWaterMark = 0;
+    };
+
+    /*
+     * EventBus : Bounded lock-free queue any thread can publish events to, drained by the main loop once per frame.
+     * Events published by a given thread are dispatched in the order that thread published them.
+     * When the bus is full, Publish fails and the event is counted as dropped, so producers can apply backpressure.
+     */
+    class FL_API EventBus {
+        BoundedQueue<EventStorage> m_Queue;
+
+        alignas(CacheLineSize) std::atomic<u64> m_PublishedCount{0};
+        std::atomic<u64> m_DroppedCount{0};
+        std::atomic<u64> m_HighWaterMark{0};
+        alignas(CacheLineSize) u64 m_DispatchedCount = 0;
+
+    public:
+        explicit EventBus(u64 capacity = 4096);
+        ~EventBus() = default;
+
+        EventBus(const EventBus&) = delete;
+        EventBus(EventBus&&) = delete;
+
+        EventBus& operator=(const EventBus&) = delete;
+        EventBus& operator=(EventBus&&) = delete;
+
+        // Can be called from any thread. Returns false if the bus is full and the event was dropped.
+        template <typename T>
+        bool Publish(const T& event);
+
+        // Must only be called from the main thread. Dispatches the events that were in the bus when the call started,
+        // so producers publishing faster than the main loop can't keep it stuck here. Returns the dispatched count.
+        template <typename Handler>
+        u64 Drain(Handler&& handler);
+
+        [[nodiscard]] EventBusStatistics GetStatistics() const;
+        [[nodiscard]] inline u64 GetCapacity() const;
+
+    private:
+        void UpdateHighWaterMark();
+    };
+
+#include <FlashlightEngine/Core/EventBus.inl>
+}
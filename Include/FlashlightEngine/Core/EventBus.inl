@@ -0,0 +1,38 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+template <typename T>
+bool EventBus::Publish(const T& event) {
+    if (!m_Queue.TryPush(EventStorage(std::in_place_type<T>, event))) {
+        m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_PublishedCount.fetch_add(1, std::memory_order_relaxed);
+    UpdateHighWaterMark();
+
+    return true;
+}
+
+template <typename Handler>
+u64 EventBus::Drain(Handler&& handler) {
+    const u64 pending = m_Queue.GetApproximateSize();
+
+    u64 dispatched = 0;
+    EventStorage storage;
+    while (dispatched < pending && m_Queue.TryPop(storage)) {
+        std::visit([&handler](auto& event) { handler(static_cast<Event&>(event)); }, storage);
+        dispatched++;
+    }
+
+    m_DispatchedCount += dispatched;
+
+    return dispatched;
+}
+
+inline u64 EventBus::GetCapacity() const {
+    return m_Queue.GetCapacity();
+}
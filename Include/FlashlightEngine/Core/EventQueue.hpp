@@ -0,0 +1,66 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Event.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <variant>
+
+namespace Flashlight {
+    // Every concrete event type, stored by value so queued events never touch the heap.
+    using EventStorage = std::variant<WindowCloseEvent, WindowResizeEvent, WindowMovedEvent, WindowFocusedEvent,
+                                      KeyDownEvent, KeyUpEvent, KeyTypedEvent,
+                                      MouseButtonDownEvent, MouseButtonUpEvent, MouseMovedEvent, MouseScrolledEvent,
+                                      UserEvent>;
+
+    // Events for which only the latest value of a burst matters.
+    template <typename T>
+    constexpr bool IsCoalescableEvent = std::is_same_v<T, MouseMovedEvent> ||
+                                        std::is_same_v<T, WindowResizeEvent> ||
+                                        std::is_same_v<T, WindowMovedEvent>;
+
+    constexpr u32 EventQueueCapacity = 256;
+
+    /*
+     * EventQueue : Fixed-capacity ring buffer holding the events of a frame until they are dispatched in one batch.
+     * Pushing a coalescable event right after another one of the same type overwrites it instead of taking a new slot.
+     */
+    class FL_API EventQueue {
+        std::array<EventStorage, EventQueueCapacity> m_Events{};
+        u32 m_Head = 0;
+        u32 m_Count = 0;
+        u64 m_CoalescedCount = 0;
+
+    public:
+        EventQueue() = default;
+        ~EventQueue() = default;
+
+        EventQueue(const EventQueue&) = delete;
+        EventQueue(EventQueue&&) = delete;
+
+        EventQueue& operator=(const EventQueue&) = delete;
+        EventQueue& operator=(EventQueue&&) = delete;
+
+        // Returns false if the queue is full, the event is not stored in that case.
+        template <typename T>
+        bool Push(const T& event);
+
+        // Calls handler(Event&) for every queued event in submission order, then empties the queue.
+        template <typename Handler>
+        void Drain(Handler&& handler);
+
+        inline void Clear();
+
+        [[nodiscard]] inline u32 GetSize() const;
+        [[nodiscard]] inline bool IsEmpty() const;
+        [[nodiscard]] inline bool IsFull() const;
+        [[nodiscard]] inline u64 GetCoalescedCount() const;
+    };
+
+#include <FlashlightEngine/Core/EventQueue.inl>
+}
@@ -0,0 +1,62 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+template <typename T>
+bool EventQueue::Push(const T& event) {
+    if constexpr (IsCoalescableEvent<T>) {
+        if (m_Count > 0) {
+            EventStorage& last = m_Events[(m_Head + m_Count - 1) % EventQueueCapacity];
+            if (std::holds_alternative<T>(last)) {
+                std::get<T>(last) = event;
+                m_CoalescedCount++;
+                return true;
+            }
+        }
+    }
+
+    if (m_Count == EventQueueCapacity) {
+        return false;
+    }
+
+    m_Events[(m_Head + m_Count) % EventQueueCapacity].emplace<T>(event);
+    m_Count++;
+
+    return true;
+}
+
+template <typename Handler>
+void EventQueue::Drain(Handler&& handler) {
+    while (m_Count > 0) {
+        EventStorage& storage = m_Events[m_Head];
+        m_Head = (m_Head + 1) % EventQueueCapacity;
+        m_Count--;
+
+        std::visit([&handler](auto& event) { handler(static_cast<Event&>(event)); }, storage);
+    }
+
+    m_Head = 0;
+}
+
+inline void EventQueue::Clear() {
+    m_Head = 0;
+    m_Count = 0;
+}
+
+inline u32 EventQueue::GetSize() const {
+    return m_Count;
+}
+
+inline bool EventQueue::IsEmpty() const {
+    return m_Count == 0;
+}
+
+inline bool EventQueue::IsFull() const {
+    return m_Count == EventQueueCapacity;
+}
+
+inline u64 EventQueue::GetCoalescedCount() const {
+    return m_CoalescedCount;
+}
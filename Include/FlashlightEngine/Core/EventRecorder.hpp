@@ -0,0 +1,76 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/EventQueue.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+namespace Flashlight {
+    constexpr std::array<char, 8> EventRecordingMagic = {'F', 'L', 'E', 'V', 'R', 'E', 'C', '\1'};
+    constexpr u32 EventRecordingVersion = 1;
+
+    /*
+     * Recording layout : the magic and version, then one record per event. A record is the EventType as a byte, the
+     * number of frames since the previous record as a LEB128 varint, then the event fields in little endian.
+     * EventType::Undefined closes the recording, its frame delta gives the total frame count.
+     * UserEvent pointers are not recorded, they come back as nullptr.
+     */
+    class FL_API EventRecorder {
+        std::ofstream m_File;
+        u64 m_LastFrameIndex = 0;
+        u64 m_RecordedCount = 0;
+
+    public:
+        EventRecorder() = default;
+        ~EventRecorder();
+
+        EventRecorder(const EventRecorder&) = delete;
+        EventRecorder(EventRecorder&&) = delete;
+
+        EventRecorder& operator=(const EventRecorder&) = delete;
+        EventRecorder& operator=(EventRecorder&&) = delete;
+
+        bool Start(const std::filesystem::path& path);
+        // frameCount is the number of frames the recording covers, events can't be recorded past it.
+        void Stop(u64 frameCount);
+
+        // Frame indices must not decrease between calls.
+        void Record(u64 frameIndex, const Event& event);
+
+        [[nodiscard]] inline bool IsRecording() const;
+        [[nodiscard]] inline u64 GetRecordedCount() const;
+    };
+
+    // Recording loaded back in memory, events are handed out frame by frame.
+    class FL_API EventRecording {
+        struct RecordedEvent {
+            u64 FrameIndex;
+            EventStorage Event;
+        };
+
+        std::vector<RecordedEvent> m_Events;
+        u64 m_FrameCount = 0;
+        size m_Cursor = 0;
+
+    public:
+        bool Load(const std::filesystem::path& path);
+
+        // Calls handler(Event&) for every event recorded up to frameIndex which hasn't been handed out yet.
+        template <typename Handler>
+        void DispatchFrame(u64 frameIndex, Handler&& handler);
+
+        inline void Rewind();
+
+        [[nodiscard]] inline u64 GetFrameCount() const;
+        [[nodiscard]] inline u64 GetEventCount() const;
+    };
+
+#include <FlashlightEngine/Core/EventRecorder.inl>
+}
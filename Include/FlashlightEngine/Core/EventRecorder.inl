@@ -0,0 +1,36 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline bool EventRecorder::IsRecording() const {
+    return m_File.is_open();
+}
+
+inline u64 EventRecorder::GetRecordedCount() const {
+    return m_RecordedCount;
+}
+
+template <typename Handler>
+void EventRecording::DispatchFrame(const u64 frameIndex, Handler&& handler) {
+    while (m_Cursor < m_Events.size() && m_Events[m_Cursor].FrameIndex <= frameIndex) {
+        // Dispatch a copy, handlers may mark the event as handled.
+        EventStorage event = m_Events[m_Cursor++].Event;
+        std::visit([&handler](auto& concreteEvent) {
+            handler(static_cast<Event&>(concreteEvent));
+        }, event);
+    }
+}
+
+inline void EventRecording::Rewind() {
+    m_Cursor = 0;
+}
+
+inline u64 EventRecording::GetFrameCount() const {
+    return m_FrameCount;
+}
+
+inline u64 EventRecording::GetEventCount() const {
+    return m_Events.size();
+}
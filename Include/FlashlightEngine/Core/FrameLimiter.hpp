@@ -0,0 +1,36 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+namespace Flashlight {
+    /*
+     * FrameLimiter : Waits until a deadline with sub-millisecond precision without burning a core for the whole wait.
+     * It sleeps in one millisecond slices while the remaining time is larger than the worst sleep overshoot observed so
+     * far, then spins for the last fraction.
+     */
+    class FL_API FrameLimiter {
+        f64 m_SleepEstimate = 0.005; // Seconds, pessimistic until measured.
+        f64 m_SleepMean = 0.005;
+        f64 m_SleepM2 = 0.0;
+        u64 m_SleepCount = 1;
+
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        FrameLimiter() = default;
+        ~FrameLimiter() = default;
+
+        FrameLimiter(const FrameLimiter&) = delete;
+        FrameLimiter(FrameLimiter&&) = delete;
+
+        FrameLimiter& operator=(const FrameLimiter&) = delete;
+        FrameLimiter& operator=(FrameLimiter&&) = delete;
+
+        void WaitUntil(Clock::time_point deadline);
+    };
+}
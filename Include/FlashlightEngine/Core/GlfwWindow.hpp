@@ -0,0 +1,37 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Window.hpp>
+
+namespace Flashlight {
+    class FL_API GlfwWindow final : public Window {
+        GLFWwindow* m_Window = nullptr;
+
+    public:
+        explicit GlfwWindow(const WindowProperties& windowProperties);
+        ~GlfwWindow() override;
+
+        GlfwWindow(const GlfwWindow&) = delete;
+        GlfwWindow(GlfwWindow&&) = delete;
+
+        GlfwWindow& operator=(const GlfwWindow&) = delete;
+        GlfwWindow& operator=(GlfwWindow&&) = delete;
+
+        [[nodiscard]] inline WindowBackend GetBackend() const override;
+        [[nodiscard]] inline bool ShouldClose() const override;
+        [[nodiscard]] inline GLFWwindow* GetNativeWindow() const override;
+        [[nodiscard]] inline f64 GetTime() const override;
+
+        inline void SetVSync(bool status) override;
+
+        void Update() override;
+        inline void Close() override;
+
+        void SetMouseMovementCallback(GLFWcursorposfun callback) const override;
+    };
+
+#include <FlashlightEngine/Core/GlfwWindow.inl>
+}
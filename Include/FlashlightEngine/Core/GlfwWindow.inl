@@ -0,0 +1,31 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline WindowBackend GlfwWindow::GetBackend() const {
+    return WindowBackend::Glfw;
+}
+
+inline bool GlfwWindow::ShouldClose() const {
+    return glfwWindowShouldClose(m_Window);
+}
+
+inline GLFWwindow* GlfwWindow::GetNativeWindow() const {
+    return m_Window;
+}
+
+inline f64 GlfwWindow::GetTime() const {
+    return glfwGetTime();
+}
+
+inline void GlfwWindow::SetVSync(const bool status) {
+    glfwSwapInterval(status);
+    m_Data.VSyncEnabled = status;
+    m_Data.ShouldInvalidateSwapchain = true;
+}
+
+inline void GlfwWindow::Close() {
+    glfwSetWindowShouldClose(m_Window, true);
+}
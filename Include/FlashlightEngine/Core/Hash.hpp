@@ -0,0 +1,24 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <span>
+#include <string_view>
+
+namespace Flashlight {
+    inline constexpr u64 Fnv1aOffsetBasis = 0xCBF29CE484222325ull;
+    inline constexpr u64 Fnv1aPrime = 0x100000001B3ull;
+
+    // 64-bit FNV-1a, for short keys such as names and paths.
+    [[nodiscard]] constexpr u64 HashFnv1a(std::string_view string);
+
+    // XXH64, for bulk data. Matches the reference implementation so hashes can be checked with external tools.
+    [[nodiscard]] FL_API u64 HashXxh64(std::span<const std::byte> data, u64 seed = 0);
+
+#include <FlashlightEngine/Core/Hash.inl>
+}
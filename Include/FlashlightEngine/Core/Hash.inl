@@ -0,0 +1,15 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+constexpr u64 HashFnv1a(const std::string_view string) {
+    u64 hash = Fnv1aOffsetBasis;
+    for (const char character : string) {
+        hash ^= static_cast<u8>(character);
+        hash *= Fnv1aPrime;
+    }
+
+    return hash;
+}
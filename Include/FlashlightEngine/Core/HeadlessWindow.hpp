@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Window.hpp>
+
+#include <deque>
+
+namespace Flashlight {
+    /*
+     * HeadlessWindow : Window without any display. Its clock only moves when Update is called, by a fixed time step,
+     * so a run is deterministic and goes as fast as the frames can be computed. Input is injected by the application,
+     * either right away or scheduled at a given virtual time.
+     */
+    class FL_API HeadlessWindow final : public Window {
+        struct ScheduledEvent {
+            f64 Time;
+            EventStorage Event;
+        };
+
+        f64 m_Time = 0.0;
+        f64 m_TimeStep;
+        bool m_ShouldClose = false;
+
+        // Sorted by time, events scheduled for the same time keep their scheduling order.
+        std::deque<ScheduledEvent> m_ScheduledEvents;
+
+    public:
+        explicit HeadlessWindow(const WindowProperties& windowProperties);
+        ~HeadlessWindow() override = default;
+
+        HeadlessWindow(const HeadlessWindow&) = delete;
+        HeadlessWindow(HeadlessWindow&&) = delete;
+
+        HeadlessWindow& operator=(const HeadlessWindow&) = delete;
+        HeadlessWindow& operator=(HeadlessWindow&&) = delete;
+
+        [[nodiscard]] inline WindowBackend GetBackend() const override;
+        [[nodiscard]] inline bool ShouldClose() const override;
+        [[nodiscard]] inline GLFWwindow* GetNativeWindow() const override;
+        [[nodiscard]] inline f64 GetTime() const override;
+
+        inline void SetVSync(bool status) override;
+
+        // Advances the clock by one time step and queues the scheduled events that are now due.
+        void Update() override;
+        inline void Close() override;
+
+        inline void SetMouseMovementCallback(GLFWcursorposfun callback) const override;
+
+        // The event is dispatched on the next DispatchEvents call.
+        template <typename T>
+        void InjectEvent(const T& event);
+
+        // The event is dispatched after the first Update which brings the clock to or past time.
+        template <typename T>
+        void ScheduleEvent(f64 time, const T& event);
+
+        // Window state changes go through the same path as the GLFW callbacks, so they also produce their events.
+        inline void SetExtent(u32 width, u32 height);
+        inline void SetFocused(bool focused);
+        inline void SetIconified(bool iconified);
+
+        [[nodiscard]] inline f64 GetTimeStep() const;
+        inline void SetTimeStep(f64 timeStep);
+
+    private:
+        void Deliver(const EventStorage& event);
+    };
+
+#include <FlashlightEngine/Core/HeadlessWindow.inl>
+}
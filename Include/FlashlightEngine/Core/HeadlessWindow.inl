@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline WindowBackend HeadlessWindow::GetBackend() const {
+    return WindowBackend::Headless;
+}
+
+inline bool HeadlessWindow::ShouldClose() const {
+    return m_ShouldClose;
+}
+
+inline GLFWwindow* HeadlessWindow::GetNativeWindow() const {
+    return nullptr;
+}
+
+inline f64 HeadlessWindow::GetTime() const {
+    return m_Time;
+}
+
+inline void HeadlessWindow::SetVSync(const bool status) {
+    m_Data.VSyncEnabled = status;
+}
+
+inline void HeadlessWindow::Close() {
+    m_ShouldClose = true;
+}
+
+inline void HeadlessWindow::SetMouseMovementCallback([[maybe_unused]] GLFWcursorposfun callback) const {
+}
+
+template <typename T>
+void HeadlessWindow::InjectEvent(const T& event) {
+    Deliver(EventStorage(std::in_place_type<T>, event));
+}
+
+template <typename T>
+void HeadlessWindow::ScheduleEvent(const f64 time, const T& event) {
+    const auto position = std::upper_bound(m_ScheduledEvents.begin(), m_ScheduledEvents.end(), time,
+                                           [](const f64 value, const ScheduledEvent& scheduled) {
+                                               return value < scheduled.Time;
+                                           });
+
+    m_ScheduledEvents.insert(position, ScheduledEvent{time, EventStorage(std::in_place_type<T>, event)});
+}
+
+inline void HeadlessWindow::SetExtent(const u32 width, const u32 height) {
+    InjectEvent(WindowResizeEvent(width, height));
+}
+
+inline void HeadlessWindow::SetFocused(const bool focused) {
+    InjectEvent(WindowFocusedEvent(focused));
+}
+
+inline void HeadlessWindow::SetIconified(const bool iconified) {
+    m_Data.Iconified = iconified;
+}
+
+inline f64 HeadlessWindow::GetTimeStep() const {
+    return m_TimeStep;
+}
+
+inline void HeadlessWindow::SetTimeStep(const f64 timeStep) {
+    m_TimeStep = timeStep;
+}
@@ -0,0 +1,103 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Event.hpp>
+#include <FlashlightEngine/Core/Window.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <atomic>
+
+namespace Flashlight {
+    enum class MouseButtons : u8 {
+        Left = 0,
+        Right = 1,
+        Middle = 2,
+        Button4 = 3,
+        Button5 = 4,
+        Button6 = 5,
+        Button7 = 6,
+        Button8 = 7
+    };
+
+    // Fixed-size bitset indexed by key or button code. Out of range codes wrap instead of being checked.
+    template <u32 BitCount>
+    struct InputBits {
+        static_assert((BitCount & (BitCount - 1)) == 0 && BitCount >= 64, "BitCount must be a power of two >= 64.");
+
+        std::array<u64, BitCount / 64> Words{};
+
+        [[nodiscard]] inline bool Test(u32 index) const;
+        inline void Set(u32 index, bool value);
+        inline void Reset();
+    };
+
+    constexpr u32 InputKeyCount = 512; // Covers every GLFW key code, the highest one is Keys::Menu (348).
+    constexpr u32 InputMouseButtonCount = 64;
+
+    /*
+     * InputSnapshot : Input state of one frame. Pressed and released record every transition seen during the frame,
+     * so a key tapped and released between two snapshots still reports both edges.
+     */
+    struct FL_API InputSnapshot {
+        InputBits<InputKeyCount> KeysDown;
+        InputBits<InputKeyCount> KeysPressed;
+        InputBits<InputKeyCount> KeysReleased;
+
+        InputBits<InputMouseButtonCount> ButtonsDown;
+        InputBits<InputMouseButtonCount> ButtonsPressed;
+        InputBits<InputMouseButtonCount> ButtonsReleased;
+
+        f32 MouseX = 0.0f, MouseY = 0.0f;
+        f32 MouseDeltaX = 0.0f, MouseDeltaY = 0.0f;
+        f32 ScrollX = 0.0f, ScrollY = 0.0f;
+
+        u64 FrameIndex = 0;
+
+        [[nodiscard]] inline bool IsKeyDown(Keys key) const;
+        [[nodiscard]] inline bool WasKeyPressed(Keys key) const;
+        [[nodiscard]] inline bool WasKeyReleased(Keys key) const;
+
+        [[nodiscard]] inline bool IsMouseButtonDown(MouseButtons button) const;
+        [[nodiscard]] inline bool WasMouseButtonPressed(MouseButtons button) const;
+        [[nodiscard]] inline bool WasMouseButtonReleased(MouseButtons button) const;
+    };
+
+    /*
+     * Input : Builds the input state from the window events on the main thread and publishes it once per frame.
+     * Published snapshots are double buffered, any thread can read the current one without locking. A snapshot stays
+     * valid until the second Publish after it was obtained, so a job may keep it for the whole frame.
+     */
+    class FL_API Input {
+        std::array<InputSnapshot, 2> m_Snapshots;
+        std::atomic<u32> m_FrontIndex{0};
+
+        // State accumulated since the last Publish, main thread only.
+        InputSnapshot m_Pending;
+        f32 m_PublishedMouseX = 0.0f, m_PublishedMouseY = 0.0f;
+        bool m_HasMousePosition = false; // Until the first mouse move the cursor position is unknown, deltas are 0.
+
+    public:
+        Input() = default;
+        ~Input() = default;
+
+        Input(const Input&) = delete;
+        Input(Input&&) = delete;
+
+        Input& operator=(const Input&) = delete;
+        Input& operator=(Input&&) = delete;
+
+        void OnEvent(const Event& event);
+
+        // Makes the state accumulated since the previous call visible to readers.
+        void Publish();
+
+        [[nodiscard]] inline const InputSnapshot& GetSnapshot() const;
+    };
+
+#include <FlashlightEngine/Core/Input.inl>
+}
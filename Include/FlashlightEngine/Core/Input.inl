@@ -0,0 +1,52 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+template <u32 BitCount>
+inline bool InputBits<BitCount>::Test(u32 index) const {
+    index &= BitCount - 1;
+    return (Words[index >> 6] >> (index & 63)) & 1;
+}
+
+template <u32 BitCount>
+inline void InputBits<BitCount>::Set(u32 index, const bool value) {
+    index &= BitCount - 1;
+    const u64 mask = 1ull << (index & 63);
+    u64& word = Words[index >> 6];
+    word = (word & ~mask) | (static_cast<u64>(value) << (index & 63));
+}
+
+template <u32 BitCount>
+inline void InputBits<BitCount>::Reset() {
+    Words.fill(0);
+}
+
+inline bool InputSnapshot::IsKeyDown(const Keys key) const {
+    return KeysDown.Test(IntegerFromEnum(key));
+}
+
+inline bool InputSnapshot::WasKeyPressed(const Keys key) const {
+    return KeysPressed.Test(IntegerFromEnum(key));
+}
+
+inline bool InputSnapshot::WasKeyReleased(const Keys key) const {
+    return KeysReleased.Test(IntegerFromEnum(key));
+}
+
+inline bool InputSnapshot::IsMouseButtonDown(const MouseButtons button) const {
+    return ButtonsDown.Test(IntegerFromEnum(button));
+}
+
+inline bool InputSnapshot::WasMouseButtonPressed(const MouseButtons button) const {
+    return ButtonsPressed.Test(IntegerFromEnum(button));
+}
+
+inline bool InputSnapshot::WasMouseButtonReleased(const MouseButtons button) const {
+    return ButtonsReleased.Test(IntegerFromEnum(button));
+}
+
+inline const InputSnapshot& Input::GetSnapshot() const {
+    return m_Snapshots[m_FrontIndex.load(std::memory_order_acquire)];
+}
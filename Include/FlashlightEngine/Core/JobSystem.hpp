@@ -0,0 +1,149 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/BoundedQueue.hpp>
+#include <FlashlightEngine/Core/Platform.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace Flashlight {
+    // Number of unfinished jobs attached to it, a job can wait for others by waiting on their counter.
+    class FL_API JobCounter {
+        friend class Job;
+        friend class JobSystem;
+
+        std::atomic<u32> m_Value{0};
+
+    public:
+        JobCounter() = default;
+        ~JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter(JobCounter&&) = delete;
+
+        JobCounter& operator=(const JobCounter&) = delete;
+        JobCounter& operator=(JobCounter&&) = delete;
+
+        [[nodiscard]] inline bool IsDone() const;
+    };
+
+    /*
+     * Job : A callable stored inline in one cache line. The callable must be trivially copyable and small, which
+     * lambdas capturing a few references or values are.
+     */
+    class alignas(CacheLineSize) Job {
+        using InvokeFunction = void (*)(const void* storage);
+
+        InvokeFunction m_Invoke = nullptr;
+        JobCounter* m_Counter = nullptr;
+        alignas(8) std::array<std::byte, CacheLineSize - 2 * sizeof(void*)> m_Storage{};
+
+    public:
+        Job() = default;
+
+        template <typename Function>
+        Job(Function&& function, JobCounter* counter);
+
+        inline void Execute() const;
+    };
+
+    /*
+     * PooledJob : Slot of a worker's job pool. It is busy from the moment its job is pushed until the job has finished
+     * running, on whichever thread stole it, so the owner never overwrites a job that is still queued or running.
+     */
+    struct PooledJob {
+        Job Work;
+        std::atomic<bool> Busy{false};
+
+        // Runs the job and frees the slot.
+        inline void Run();
+    };
+
+    /*
+     * WorkStealingDeque : Fixed-capacity Chase-Lev deque. The owner thread pushes and pops at the bottom, other threads
+     * steal from the top.
+     */
+    class FL_API WorkStealingDeque {
+        std::unique_ptr<std::atomic<PooledJob*>[]> m_Buffer;
+        i64 m_Mask;
+
+        alignas(CacheLineSize) std::atomic<i64> m_Top{0};
+        alignas(CacheLineSize) std::atomic<i64> m_Bottom{0};
+
+    public:
+        explicit WorkStealingDeque(u32 capacity);
+
+        // Owner thread only. Returns false if the deque is full.
+        bool Push(PooledJob* job);
+
+        // Owner thread only.
+        PooledJob* Pop();
+
+        // Any thread.
+        PooledJob* Steal();
+    };
+
+    /*
+     * JobSystem : Work-stealing scheduler. Every worker thread owns a deque and a pool of jobs, idle workers steal from
+     * the others. The thread that created the job system is worker 0, it runs jobs while it waits on a counter.
+     * Threads outside the job system can still schedule jobs, they go through a shared queue.
+     */
+    class FL_API JobSystem {
+        struct alignas(CacheLineSize) Worker {
+            WorkStealingDeque Deque;
+            std::unique_ptr<PooledJob[]> JobPool;
+            u32 NextJob = 0;
+            u32 RandomState;
+
+            explicit Worker(u32 index);
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::vector<std::thread> m_Threads;
+        BoundedQueue<Job> m_ExternalQueue;
+
+        alignas(CacheLineSize) std::atomic<u32> m_WorkSignal{0};
+        std::atomic<u32> m_SleepingWorkers{0};
+        std::atomic<bool> m_Running{true};
+
+    public:
+        // A worker count of 0 uses one worker per hardware thread, the calling thread included.
+        explicit JobSystem(u32 workerCount = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem(JobSystem&&) = delete;
+
+        JobSystem& operator=(const JobSystem&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        template <typename Function>
+        void Schedule(Function&& function, JobCounter* counter = nullptr);
+
+        // Runs other jobs until the counter reaches zero.
+        void Wait(const JobCounter& counter);
+
+        // Calls function(begin, end) over [0, count) split into ranges of at most granularity elements, and waits for
+        // all of them.
+        template <typename Function>
+        void ParallelFor(u32 count, u32 granularity, Function&& function);
+
+        [[nodiscard]] inline u32 GetWorkerCount() const;
+
+    private:
+        void Submit(const Job& job);
+        bool RunOneJob();
+        bool RunWorkerJob(u32 workerIndex);
+        void WorkerMain(u32 workerIndex);
+        void WakeWorkers();
+    };
+
+#include <FlashlightEngine/Core/JobSystem.inl>
+}
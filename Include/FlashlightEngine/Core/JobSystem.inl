@@ -0,0 +1,73 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline bool JobCounter::IsDone() const {
+    return m_Value.load(std::memory_order_acquire) == 0;
+}
+
+template <typename Function>
+Job::Job(Function&& function, JobCounter* counter) : m_Counter(counter) {
+    using Callable = std::decay_t<Function>;
+    static_assert(sizeof(Callable) <= sizeof(m_Storage), "Job callable is too large, capture less or by reference.");
+    static_assert(alignof(Callable) <= 8, "Job callable alignment is too large.");
+    static_assert(std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>,
+                  "Job callables are copied byte by byte and never destroyed.");
+
+    new (m_Storage.data()) Callable(std::forward<Function>(function));
+    m_Invoke = [](const void* storage) {
+        (*static_cast<const Callable*>(storage))();
+    };
+}
+
+inline void Job::Execute() const {
+    m_Invoke(m_Storage.data());
+
+    if (m_Counter != nullptr) {
+        m_Counter->m_Value.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+inline void PooledJob::Run() {
+    Work.Execute();
+
+    // Last, the owner refills the slot as soon as it sees it free.
+    Busy.store(false, std::memory_order_release);
+}
+
+template <typename Function>
+void JobSystem::Schedule(Function&& function, JobCounter* counter) {
+    if (counter != nullptr) {
+        counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Submit(Job(std::forward<Function>(function), counter));
+}
+
+template <typename Function>
+void JobSystem::ParallelFor(const u32 count, u32 granularity, Function&& function) {
+    if (count == 0) {
+        return;
+    }
+
+    granularity = std::max(granularity, 1u);
+
+    JobCounter counter;
+    auto* callable = std::addressof(function);
+
+    // The first range is kept for the calling thread so it does useful work before it starts waiting.
+    for (u32 begin = granularity; begin < count; begin += granularity) {
+        const u32 end = std::min(begin + granularity, count);
+        Schedule([callable, begin, end] { (*callable)(begin, end); }, &counter);
+    }
+
+    function(0u, std::min(granularity, count));
+
+    Wait(counter);
+}
+
+inline u32 JobSystem::GetWorkerCount() const {
+    return static_cast<u32>(m_Workers.size());
+}
@@ -9,6 +9,65 @@
 
 #include <spdlog/spdlog.h>
 
+// Log levels usable in preprocessor conditions, the values match spdlog::level::level_enum.
+#define FL_LOG_LEVEL_TRACE 0
+#define FL_LOG_LEVEL_DEBUG 1
+#define FL_LOG_LEVEL_INFO 2
+#define FL_LOG_LEVEL_WARN 3
+#define FL_LOG_LEVEL_ERROR 4
+#define FL_LOG_LEVEL_CRITICAL 5
+#define FL_LOG_LEVEL_OFF 6
+
+// Lowest level compiled in, calls below it are removed at compile time. Can be overridden with `xmake f --loglevel=`.
+#ifndef FL_LOG_ACTIVE_LEVEL
+    #ifdef FL_DEBUG
+        #define FL_LOG_ACTIVE_LEVEL FL_LOG_LEVEL_TRACE
+    #else
+        #define FL_LOG_ACTIVE_LEVEL FL_LOG_LEVEL_INFO
+    #endif
+#endif
+
+// Unlike the Log:: functions, these macros also remove the evaluation of their arguments when the level is stripped.
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_TRACE
+    #define FL_ENGINE_TRACE(...) ::Flashlight::Log::EngineTrace(__VA_ARGS__)
+    #define FL_EDITOR_TRACE(...) ::Flashlight::Log::EditorTrace(__VA_ARGS__)
+#else
+    #define FL_ENGINE_TRACE(...) static_cast<void>(0)
+    #define FL_EDITOR_TRACE(...) static_cast<void>(0)
+#endif
+
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_INFO
+    #define FL_ENGINE_INFO(...) ::Flashlight::Log::EngineInfo(__VA_ARGS__)
+    #define FL_EDITOR_INFO(...) ::Flashlight::Log::EditorInfo(__VA_ARGS__)
+#else
+    #define FL_ENGINE_INFO(...) static_cast<void>(0)
+    #define FL_EDITOR_INFO(...) static_cast<void>(0)
+#endif
+
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_WARN
+    #define FL_ENGINE_WARN(...) ::Flashlight::Log::EngineWarn(__VA_ARGS__)
+    #define FL_EDITOR_WARN(...) ::Flashlight::Log::EditorWarn(__VA_ARGS__)
+#else
+    #define FL_ENGINE_WARN(...) static_cast<void>(0)
+    #define FL_EDITOR_WARN(...) static_cast<void>(0)
+#endif
+
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_ERROR
+    #define FL_ENGINE_ERROR(...) ::Flashlight::Log::EngineError(__VA_ARGS__)
+    #define FL_EDITOR_ERROR(...) ::Flashlight::Log::EditorError(__VA_ARGS__)
+#else
+    #define FL_ENGINE_ERROR(...) static_cast<void>(0)
+    #define FL_EDITOR_ERROR(...) static_cast<void>(0)
+#endif
+
+#if FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_CRITICAL
+    #define FL_ENGINE_CRITICAL(...) ::Flashlight::Log::EngineCritical(__VA_ARGS__)
+    #define FL_EDITOR_CRITICAL(...) ::Flashlight::Log::EditorCritical(__VA_ARGS__)
+#else
+    #define FL_ENGINE_CRITICAL(...) static_cast<void>(0)
+    #define FL_EDITOR_CRITICAL(...) static_cast<void>(0)
+#endif
+
 namespace Flashlight {
     /*
      * ErrorCode : The representation of an error code when throwing an error.
@@ -27,21 +86,47 @@ namespace Flashlight {
 
     using customLogCallback = std::function<void(const spdlog::level::level_enum& level, const std::string& msg)>;
 
+    enum class LogMode : u8 {
+        Synchronous,
+        Asynchronous // Messages are queued and written to the sinks by a dedicated thread.
+    };
+
+    // What an asynchronous log call does when the message queue is full.
+    enum class LogOverflowPolicy : u8 {
+        Block, // Wait until the flush thread frees a slot.
+        DropOldest, // Discard the oldest queued message to make room.
+        DropNewest // Discard the message being logged.
+    };
+
+    struct FL_API LoggerSettings {
+        LogMode Mode = LogMode::Synchronous;
+        LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::Block;
+        u32 QueueCapacity = 4096;
+        bool ConsoleOutput = true; // When false, messages only reach the callbacks.
+    };
+
     class FL_API Logger {
         static std::shared_ptr<spdlog::logger> m_EngineLogger;
         static std::shared_ptr<spdlog::logger> m_EditorLogger;
 
     public:
-        static void Init();
+        static void Init(const LoggerSettings& settings = {});
+        static void Shutdown();
+        static void Flush();
         static inline spdlog::logger* GetEngineLogger();
         static inline spdlog::logger* GetEditorLogger();
         static void AddEngineCallback(const customLogCallback& callback);
         static void AddEditorCallback(const customLogCallback& callback);
+
+        // Number of messages discarded by the asynchronous mode overflow policy since Init.
+        [[nodiscard]] static u64 GetDroppedMessageCount();
     };
 
 
     namespace Log {
         std::string EvaluateEngineErrorCode(const ErrorCode& errorCode); 
+
+        [[nodiscard]] constexpr bool IsLevelCompiled(spdlog::level::level_enum level);
         
         template <typename... Args>
         constexpr void EngineTrace(Args&&... args);
@@ -61,6 +146,17 @@ namespace Flashlight {
         template <typename... Args>
         constexpr void EngineFatal(ErrorCode errorCode, Args&&... args);
 
+        // Lazy variants: producer() is only called, and its result formatted, if the level is enabled both at compile
+        // time and on the logger at runtime.
+        template <typename Producer>
+        constexpr void EngineTraceLazy(Producer&& producer);
+
+        template <typename Producer>
+        constexpr void EngineInfoLazy(Producer&& producer);
+
+        template <typename Producer>
+        constexpr void EngineWarnLazy(Producer&& producer);
+
 
         template <typename... Args>
         constexpr void EditorTrace(Args&&... args);
@@ -79,6 +175,15 @@ namespace Flashlight {
 
         template <typename... Args>
         constexpr void EditorFatal(ErrorCode errorCode, Args&&... args);
+
+        template <typename Producer>
+        constexpr void EditorTraceLazy(Producer&& producer);
+
+        template <typename Producer>
+        constexpr void EditorInfoLazy(Producer&& producer);
+
+        template <typename Producer>
+        constexpr void EditorWarnLazy(Producer&& producer);
     }
 
 #include "Logger.inl"
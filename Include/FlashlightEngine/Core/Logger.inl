@@ -13,29 +13,52 @@ inline spdlog::logger* Logger::GetEditorLogger() {
 }
 
 namespace Log {
+    constexpr bool IsLevelCompiled(const spdlog::level::level_enum level) {
+        return static_cast<i32>(level) >= FL_LOG_ACTIVE_LEVEL;
+    }
+
+    template <spdlog::level::level_enum Level, typename Producer>
+    constexpr void LogLazy(spdlog::logger* logger, Producer&& producer) {
+        if constexpr (IsLevelCompiled(Level)) {
+            if (logger->should_log(Level)) {
+                logger->log(Level, "{}", producer());
+            }
+        }
+    }
+
     template <typename... Args>
     constexpr void EngineTrace(Args&&... args) {
-        Logger::GetEngineLogger()->trace(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_TRACE) {
+            Logger::GetEngineLogger()->trace(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     constexpr void EngineInfo(Args&&... args) {
-        Logger::GetEngineLogger()->info(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_INFO) {
+            Logger::GetEngineLogger()->info(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     constexpr void EngineWarn(Args&&... args) {
-        Logger::GetEngineLogger()->warn(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_WARN) {
+            Logger::GetEngineLogger()->warn(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     constexpr void EngineError(Args&&... args) {
-        Logger::GetEngineLogger()->error(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_ERROR) {
+            Logger::GetEngineLogger()->error(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     constexpr void EngineCritical(Args&&... args) {
-        Logger::GetEngineLogger()->critical(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_CRITICAL) {
+            Logger::GetEngineLogger()->critical(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
@@ -45,33 +68,59 @@ namespace Log {
         Logger::GetEngineLogger()->critical("{0} FATAL ENGINE ERROR: Code: 0x{1}",
                                                  EvaluateEngineErrorCode(errorCode), hexErrorCodeStream.str());
         Logger::GetEngineLogger()->critical(std::forward<Args>(args)...);
+        Logger::Flush();
         exit(errorCode.GetFormattedErrorCode());
     }
 
+    template <typename Producer>
+    constexpr void EngineTraceLazy(Producer&& producer) {
+        LogLazy<spdlog::level::trace>(Logger::GetEngineLogger(), std::forward<Producer>(producer));
+    }
+
+    template <typename Producer>
+    constexpr void EngineInfoLazy(Producer&& producer) {
+        LogLazy<spdlog::level::info>(Logger::GetEngineLogger(), std::forward<Producer>(producer));
+    }
+
+    template <typename Producer>
+    constexpr void EngineWarnLazy(Producer&& producer) {
+        LogLazy<spdlog::level::warn>(Logger::GetEngineLogger(), std::forward<Producer>(producer));
+    }
+
 
     template <typename... Args>
     constexpr void EditorTrace(Args&&... args) {
-        Logger::GetEditorLogger()->trace(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_TRACE) {
+            Logger::GetEditorLogger()->trace(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     constexpr void EditorInfo(Args&&... args) {
-        Logger::GetEditorLogger()->info(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_INFO) {
+            Logger::GetEditorLogger()->info(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     constexpr void EditorWarn(Args&&... args) {
-        Logger::GetEditorLogger()->warn(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_WARN) {
+            Logger::GetEditorLogger()->warn(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     constexpr void EditorError(Args&&... args) {
-        Logger::GetEditorLogger()->error(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_ERROR) {
+            Logger::GetEditorLogger()->error(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     constexpr void EditorCritical(Args&&... args) {
-        Logger::GetEditorLogger()->critical(std::forward<Args>(args)...);
+        if constexpr (FL_LOG_ACTIVE_LEVEL <= FL_LOG_LEVEL_CRITICAL) {
+            Logger::GetEditorLogger()->critical(std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
@@ -80,6 +129,22 @@ namespace Log {
         hexErrorCodeStream << std::hex << errorCode.GetFormattedErrorCode();
         Logger::GetEditorLogger()->critical("FATAL EDITOR ERROR: Code: 0x{0}", hexErrorCodeStream.str());
         Logger::GetEditorLogger()->critical(std::forward<Args>(args)...);
+        Logger::Flush();
         exit(errorCode.GetFormattedErrorCode());
     }
+
+    template <typename Producer>
+    constexpr void EditorTraceLazy(Producer&& producer) {
+        LogLazy<spdlog::level::trace>(Logger::GetEditorLogger(), std::forward<Producer>(producer));
+    }
+
+    template <typename Producer>
+    constexpr void EditorInfoLazy(Producer&& producer) {
+        LogLazy<spdlog::level::info>(Logger::GetEditorLogger(), std::forward<Producer>(producer));
+    }
+
+    template <typename Producer>
+    constexpr void EditorWarnLazy(Producer&& producer) {
+        LogLazy<spdlog::level::warn>(Logger::GetEditorLogger(), std::forward<Producer>(producer));
+    }
 }
@@ -0,0 +1,63 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Memory/LinearArena.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+namespace Flashlight {
+    /*
+     * FrameArena : Two linear arenas used on alternate frames. Memory allocated during a frame stays valid during the
+     * next one, so data produced in frame N can still be consumed while frame N + 1 is built.
+     */
+    class FL_API FrameArena {
+        std::array<std::unique_ptr<LinearArena>, 2> m_Arenas;
+        u32 m_CurrentIndex = 0;
+        ArenaStatistics m_LastFrameStatistics;
+
+    public:
+        explicit FrameArena(u64 capacityPerFrame = 8ull * 1024 * 1024);
+        ~FrameArena() = default;
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena(FrameArena&&) = delete;
+
+        FrameArena& operator=(const FrameArena&) = delete;
+        FrameArena& operator=(FrameArena&&) = delete;
+
+        // Switches to the other arena and resets it, memory from two frames ago is released.
+        void BeginFrame();
+
+        [[nodiscard]] inline LinearArena& GetCurrent();
+        [[nodiscard]] inline LinearArena& GetPrevious();
+        [[nodiscard]] inline const ArenaStatistics& GetLastFrameStatistics() const;
+    };
+
+    // Thread-local arena for short-lived temporaries, use a ScratchScope to give the memory back.
+    [[nodiscard]] FL_API LinearArena& GetScratchArena();
+
+    // Rewinds the calling thread's scratch arena to where it was when the scope was entered, allocations that didn't
+    // fit in it are freed too.
+    class FL_API ScratchScope {
+        LinearArena& m_Arena;
+        LinearArena::Marker m_Marker;
+
+    public:
+        inline ScratchScope();
+        inline ~ScratchScope();
+
+        ScratchScope(const ScratchScope&) = delete;
+        ScratchScope(ScratchScope&&) = delete;
+
+        ScratchScope& operator=(const ScratchScope&) = delete;
+        ScratchScope& operator=(ScratchScope&&) = delete;
+
+        [[nodiscard]] inline LinearArena& GetArena() const;
+    };
+
+#include <FlashlightEngine/Core/Memory/FrameArena.inl>
+}
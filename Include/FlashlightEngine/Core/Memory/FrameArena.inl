@@ -0,0 +1,28 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline LinearArena& FrameArena::GetCurrent() {
+    return *m_Arenas[m_CurrentIndex];
+}
+
+inline LinearArena& FrameArena::GetPrevious() {
+    return *m_Arenas[m_CurrentIndex ^ 1];
+}
+
+inline const ArenaStatistics& FrameArena::GetLastFrameStatistics() const {
+    return m_LastFrameStatistics;
+}
+
+inline ScratchScope::ScratchScope() : m_Arena(GetScratchArena()), m_Marker(m_Arena.GetMarker()) {
+}
+
+inline ScratchScope::~ScratchScope() {
+    m_Arena.Rewind(m_Marker);
+}
+
+inline LinearArena& ScratchScope::GetArena() const {
+    return m_Arena;
+}
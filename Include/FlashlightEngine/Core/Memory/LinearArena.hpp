@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Platform.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
+
+namespace Flashlight {
+    struct FL_API ArenaStatistics {
+        u64 AllocationCount = 0;
+        u64 AllocatedBytes = 0;
+        u64 PeakBytes = 0;
+        u64 OverflowCount = 0; // Allocations that didn't fit and went to the upstream resource.
+    };
+
+    /*
+     * LinearArena : Bump allocator over a block reserved once. Deallocation is a no-op, memory is reclaimed all at
+     * once by Reset or back to a marker by Rewind. Allocating is lock-free and can be done from any thread, resetting
+     * must not overlap with allocations.
+     * Allocations that don't fit go to the upstream resource and are released on the next Reset, or by a Rewind to a
+     * marker taken before them.
+     */
+    class FL_API LinearArena final : public std::pmr::memory_resource {
+        std::unique_ptr<std::byte[]> m_Buffer;
+        u64 m_Capacity;
+
+        alignas(CacheLineSize) std::atomic<u64> m_Offset{0};
+        std::atomic<u64> m_AllocationCount{0};
+        std::atomic<u64> m_OverflowCount{0};
+        u64 m_PeakBytes = 0;
+
+        std::pmr::memory_resource* m_Upstream;
+        std::mutex m_OverflowMutex;
+        std::vector<std::tuple<void*, size_t, size_t>> m_OverflowAllocations;
+
+    public:
+        struct Marker {
+            u64 Offset;
+            size_t OverflowCount;
+        };
+
+        explicit LinearArena(u64 capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+        ~LinearArena() override;
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena(LinearArena&&) = delete;
+
+        LinearArena& operator=(const LinearArena&) = delete;
+        LinearArena& operator=(LinearArena&&) = delete;
+
+        void Reset();
+
+        // Like resetting, taking a marker and rewinding to it must not overlap with allocations.
+        [[nodiscard]] inline Marker GetMarker() const;
+        // Frees everything allocated after the marker was taken, overflow allocations included.
+        inline void Rewind(const Marker& marker);
+
+        template <typename T, typename... Args>
+        T* New(Args&&... args);
+
+        [[nodiscard]] ArenaStatistics GetStatistics() const;
+        [[nodiscard]] inline u64 GetCapacity() const;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        void* AllocateOverflow(size_t bytes, size_t alignment);
+        void ReleaseOverflow(size_t keptCount);
+    };
+
+#include <FlashlightEngine/Core/Memory/LinearArena.inl>
+}
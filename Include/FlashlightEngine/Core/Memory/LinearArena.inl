@@ -0,0 +1,27 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline LinearArena::Marker LinearArena::GetMarker() const {
+    return {m_Offset.load(std::memory_order_relaxed), m_OverflowAllocations.size()};
+}
+
+inline void LinearArena::Rewind(const Marker& marker) {
+    m_PeakBytes = std::max(m_PeakBytes, m_Offset.load(std::memory_order_relaxed));
+    m_Offset.store(marker.Offset, std::memory_order_relaxed);
+
+    if (m_OverflowAllocations.size() > marker.OverflowCount) {
+        ReleaseOverflow(marker.OverflowCount);
+    }
+}
+
+template <typename T, typename... Args>
+T* LinearArena::New(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+}
+
+inline u64 LinearArena::GetCapacity() const {
+    return m_Capacity;
+}
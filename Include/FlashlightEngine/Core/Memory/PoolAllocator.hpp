@@ -0,0 +1,87 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <memory_resource>
+
+namespace Flashlight {
+    struct FL_API PoolStatistics {
+        u64 AllocationCount = 0;
+        u64 LiveBlocks = 0;
+        u64 ReservedBlocks = 0;
+    };
+
+    /*
+     * PoolResource : Hands out blocks of one fixed size from chunks reserved up front, freed blocks go to an intrusive
+     * free list so allocating and freeing are a few instructions. Not thread-safe.
+     * Requests larger than the block size are forwarded to the upstream resource.
+     */
+    class FL_API PoolResource final : public std::pmr::memory_resource {
+        struct FreeBlock {
+            FreeBlock* Next;
+        };
+
+        size_t m_BlockSize;
+        size_t m_BlockAlignment;
+        u32 m_BlocksPerChunk;
+
+        FreeBlock* m_FreeList = nullptr;
+        std::vector<std::pair<void*, size_t>> m_Chunks;
+        std::pmr::memory_resource* m_Upstream;
+
+        u64 m_AllocationCount = 0;
+        u64 m_LiveBlocks = 0;
+
+    public:
+        PoolResource(size_t blockSize, size_t blockAlignment, u32 blocksPerChunk = 256,
+                     std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+        ~PoolResource() override;
+
+        PoolResource(const PoolResource&) = delete;
+        PoolResource(PoolResource&&) = delete;
+
+        PoolResource& operator=(const PoolResource&) = delete;
+        PoolResource& operator=(PoolResource&&) = delete;
+
+        [[nodiscard]] PoolStatistics GetStatistics() const;
+        [[nodiscard]] inline size_t GetBlockSize() const;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        void AllocateChunk();
+    };
+
+    // Typed front end of a PoolResource sized for T.
+    template <typename T>
+    class ObjectPool {
+        PoolResource m_Resource;
+
+    public:
+        explicit ObjectPool(u32 objectsPerChunk = 256);
+        ~ObjectPool() = default;
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&&) = delete;
+
+        ObjectPool& operator=(const ObjectPool&) = delete;
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        template <typename... Args>
+        T* Create(Args&&... args);
+
+        void Destroy(T* object);
+
+        [[nodiscard]] inline PoolResource& GetResource();
+    };
+
+#include <FlashlightEngine/Core/Memory/PoolAllocator.inl>
+}
@@ -0,0 +1,34 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline size_t PoolResource::GetBlockSize() const {
+    return m_BlockSize;
+}
+
+template <typename T>
+ObjectPool<T>::ObjectPool(const u32 objectsPerChunk) : m_Resource(sizeof(T), alignof(T), objectsPerChunk) {
+}
+
+template <typename T>
+template <typename... Args>
+T* ObjectPool<T>::Create(Args&&... args) {
+    return new (m_Resource.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void ObjectPool<T>::Destroy(T* object) {
+    if (object == nullptr) {
+        return;
+    }
+
+    object->~T();
+    m_Resource.deallocate(object, sizeof(T), alignof(T));
+}
+
+template <typename T>
+inline PoolResource& ObjectPool<T>::GetResource() {
+    return m_Resource;
+}
@@ -0,0 +1,58 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <filesystem>
+#include <span>
+
+namespace Flashlight {
+    /*
+     * MemoryMappedFile : A file mapped in the address space of the process, either read-only or, when created with
+     * a fixed size, read-write.
+     */
+    class FL_API MemoryMappedFile {
+        std::byte* m_Data = nullptr;
+        u64 m_Size = 0;
+        bool m_Writable = false;
+
+#ifdef _WIN32
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#else
+        i32 m_FileDescriptor = -1;
+#endif
+
+    public:
+        MemoryMappedFile() = default;
+        ~MemoryMappedFile();
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+        // Maps an existing file read-only. Returns false if the file can't be opened or mapped.
+        bool OpenRead(const std::filesystem::path& path);
+
+        // Creates (or truncates) a file of the given size and maps it read-write.
+        bool Create(const std::filesystem::path& path, u64 size);
+
+        // Unmaps the file. If the file is writable and finalSize is smaller than the mapped size, the file is
+        // truncated to finalSize.
+        void Close(u64 finalSize = ~0ull);
+
+        [[nodiscard]] inline bool IsOpen() const;
+        [[nodiscard]] inline u64 GetSize() const;
+        [[nodiscard]] inline std::byte* GetData();
+        [[nodiscard]] inline const std::byte* GetData() const;
+        [[nodiscard]] inline std::span<const std::byte> GetSpan() const;
+    };
+
+#include <FlashlightEngine/Core/MemoryMappedFile.inl>
+}
@@ -0,0 +1,25 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline bool MemoryMappedFile::IsOpen() const {
+    return m_Data != nullptr;
+}
+
+inline u64 MemoryMappedFile::GetSize() const {
+    return m_Size;
+}
+
+inline std::byte* MemoryMappedFile::GetData() {
+    return m_Data;
+}
+
+inline const std::byte* MemoryMappedFile::GetData() const {
+    return m_Data;
+}
+
+inline std::span<const std::byte> MemoryMappedFile::GetSpan() const {
+    return {m_Data, static_cast<std::size_t>(m_Size)};
+}
@@ -0,0 +1,12 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+
+namespace Flashlight {
+    // Size used to pad data shared between threads so two atomics never end up on the same cache line.
+    constexpr u32 CacheLineSize = 64;
+}
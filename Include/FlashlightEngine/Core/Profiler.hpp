@@ -0,0 +1,108 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Platform.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <string_view>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+#define FL_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FL_PROFILE_CONCAT(a, b) FL_PROFILE_CONCAT_IMPL(a, b)
+
+// Times the enclosing scope. The name must be a string literal or have static storage, only the pointer is recorded.
+#ifdef FL_PROFILING
+    #define FL_PROFILE_ZONE(name) const ::Flashlight::ProfileZone FL_PROFILE_CONCAT(flProfileZone, __LINE__)(name)
+    #define FL_PROFILE_FUNCTION() FL_PROFILE_ZONE(__func__)
+#else
+    #define FL_PROFILE_ZONE(name) static_cast<void>(0)
+    #define FL_PROFILE_FUNCTION() static_cast<void>(0)
+#endif
+
+namespace Flashlight {
+    struct ProfileEvent {
+        const char* Name;
+        u64 Start; // Timestamps in ticks, see Profiler::TicksToSeconds.
+        u64 End;
+        u32 ThreadIndex;
+        u32 Depth;
+    };
+
+    struct ProfiledFrame {
+        u64 Start;
+        u64 End;
+        u64 DroppedEventCount;
+        std::vector<ProfileEvent> Events; // Every zone which ended during the frame, from every thread.
+    };
+
+    /*
+     * Profiler : Collects timed zones from every thread. Zones are written to a lock-free buffer owned by the thread
+     * which opened them, the main thread moves them into a rolling history of the last frames in EndFrame.
+     * Timestamps come from the TSC when CPUID reports it invariant, from steady_clock otherwise, and are converted with
+     * a rate calibrated against steady_clock.
+     */
+    class FL_API Profiler {
+    public:
+        static constexpr u32 FrameHistorySize = 120;
+
+        static void Init();
+        static void Shutdown();
+
+        // Main thread only.
+        static void BeginFrame();
+        static void EndFrame();
+
+        // Names the calling thread in exported traces. The string is copied.
+        static void SetThreadName(std::string_view name);
+
+        [[nodiscard]] static inline u64 ReadTimestamp();
+        // Whether the TSC ticks at a constant rate on every core, read with CPUID once.
+        [[nodiscard]] static inline bool HasInvariantTsc();
+        [[nodiscard]] static f64 TicksToSeconds(u64 ticks);
+
+        // Time spent in zones with this name during the last completed frame, summed over every thread, in seconds.
+        [[nodiscard]] static f64 GetLastFrameZoneTime(std::string_view name);
+
+        // Main thread only. Index 0 is the oldest frame kept, the reference is invalidated by the next EndFrame.
+        [[nodiscard]] static u32 GetFrameCount();
+        [[nodiscard]] static const ProfiledFrame& GetFrame(u32 index);
+
+        // Writes the frame history in the Chrome trace event format, which Perfetto and chrome://tracing can open.
+        static bool ExportChromeTrace(const std::filesystem::path& path);
+
+        static void RecordEvent(const char* name, u64 start, u64 end, u32 depth);
+        [[nodiscard]] static bool DetectInvariantTsc();
+
+        static inline u32& GetZoneDepth();
+    };
+
+    class ProfileZone {
+        const char* m_Name;
+        u64 m_Start;
+        u32 m_Depth;
+
+    public:
+        explicit inline ProfileZone(const char* name);
+        inline ~ProfileZone();
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone(ProfileZone&&) = delete;
+
+        ProfileZone& operator=(const ProfileZone&) = delete;
+        ProfileZone& operator=(ProfileZone&&) = delete;
+    };
+
+#include <FlashlightEngine/Core/Profiler.inl>
+}
@@ -0,0 +1,35 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u64 Profiler::ReadTimestamp() {
+#if defined(_M_X64) || defined(__x86_64__) || defined(__i386__)
+    if (HasInvariantTsc()) {
+        return __rdtsc();
+    }
+#endif
+    return static_cast<u64>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+inline bool Profiler::HasInvariantTsc() {
+    static const bool invariantTsc = DetectInvariantTsc();
+    return invariantTsc;
+}
+
+inline u32& Profiler::GetZoneDepth() {
+    thread_local u32 depth = 0;
+    return depth;
+}
+
+inline ProfileZone::ProfileZone(const char* name) : m_Name(name), m_Depth(Profiler::GetZoneDepth()++) {
+    // Read last so the bookkeeping above isn't part of the zone.
+    m_Start = Profiler::ReadTimestamp();
+}
+
+inline ProfileZone::~ProfileZone() {
+    const u64 end = Profiler::ReadTimestamp();
+    Profiler::GetZoneDepth()--;
+    Profiler::RecordEvent(m_Name, m_Start, end, m_Depth);
+}
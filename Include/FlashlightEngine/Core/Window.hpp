@@ -5,6 +5,7 @@
 #pragma once
 
 #include <FlashlightEngine/Core/Event.hpp>
+#include <FlashlightEngine/Core/EventQueue.hpp>
 #include <FlashlightEngine/Core/Logger.hpp>
 
 #include <FlashlightEngine/flpch.hpp>
@@ -141,11 +142,18 @@ namespace Flashlight {
         Menu = 348,
     };
 
+    enum class WindowBackend : u8 {
+        Glfw,    // Native window, needs a display.
+        Headless // No window at all, time and input are driven by the application.
+    };
+
     struct FL_API WindowProperties {
         i32 Width, Height;
         std::string Title;
         bool Fullscreen;
         bool VSync;
+        WindowBackend Backend = WindowBackend::Glfw;
+        f64 HeadlessTimeStep = 1.0 / 60.0; // How far the headless clock moves on every Update.
 
         WindowProperties(const i32 width, const i32 height, std::string&& title,
                          const bool fullscreen, const bool vSync) : Width(width), Height(height),
@@ -160,16 +168,22 @@ namespace Flashlight {
         bool ShouldInvalidateSwapchain = false;
         bool VSyncEnabled = false;
         bool Focused = false;
+        bool Iconified = false;
         std::function<void(Event&)> EventCallback;
+        EventQueue Events;
     };
 
+    /*
+     * Window : Platform window interface. The GLFW backend opens a real window, the headless backend fakes one so the
+     * whole application loop can run without a display.
+     */
     class FL_API Window {
-        GLFWwindow* m_Window = nullptr;
+    protected:
         WindowData m_Data;
 
     public:
-        explicit Window(const WindowProperties& windowProperties);
-        ~Window();
+        Window() = default;
+        virtual ~Window() = default;
 
         Window(const Window&) = delete;
         Window(Window&&) = delete;
@@ -177,23 +191,37 @@ namespace Flashlight {
         Window& operator=(const Window&) = delete;
         Window& operator=(Window&&) = delete;
 
-        [[nodiscard]] inline bool ShouldClose() const;
+        [[nodiscard]] static std::unique_ptr<Window> Create(const WindowProperties& windowProperties);
+
+        [[nodiscard]] virtual WindowBackend GetBackend() const = 0;
+        [[nodiscard]] virtual bool ShouldClose() const = 0;
         [[nodiscard]] inline bool ShouldInvalidateSwapchain() const;
-        [[nodiscard]] inline GLFWwindow* GetNativeWindow() const;
+        // nullptr when there is no native window.
+        [[nodiscard]] virtual GLFWwindow* GetNativeWindow() const = 0;
+        // Seconds since the window was created. Frame times are measured with this clock.
+        [[nodiscard]] virtual f64 GetTime() const = 0;
         [[nodiscard]] inline i32 GetWidth() const;
         [[nodiscard]] inline i32 GetHeight() const;
         [[nodiscard]] inline VkExtent2D GetExtent() const;
         [[nodiscard]] inline std::string GetTitle() const;
         [[nodiscard]] inline bool VSyncEnabled() const;
+        [[nodiscard]] inline bool IsFocused() const;
+        [[nodiscard]] inline bool IsIconified() const;
 
         inline void SwapchainInvalidated();
-        inline void SetVSync(bool status);
+        virtual void SetVSync(bool status) = 0;
         inline void SetEventCallback(const std::function<void(Event&)>& callback);
 
-        static void Update();
-        inline void Close() const;
+        virtual void Update() = 0;
+        void DispatchEvents();
+        virtual void Close() = 0;
+
+        virtual void SetMouseMovementCallback(GLFWcursorposfun callback) const = 0;
 
-        void SetMouseMovementCallback(GLFWcursorposfun callback) const;
+    protected:
+        // Queues an event for the next DispatchEvents, dispatching the pending ones first if the queue is full.
+        template <typename T>
+        static void QueueEvent(WindowData& data, const T& event);
     };
 
 #include <FlashlightEngine/Core/Window.inl>
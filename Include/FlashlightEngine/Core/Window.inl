@@ -4,10 +4,6 @@
 
 #pragma once
 
-inline bool Window::ShouldClose() const {
-    return glfwWindowShouldClose(m_Window);
-}
-
 inline bool Window::ShouldInvalidateSwapchain() const {
     return m_Data.ShouldInvalidateSwapchain;
 }
@@ -16,10 +12,6 @@ inline void Window::SwapchainInvalidated() {
     m_Data.ShouldInvalidateSwapchain = false;
 }
 
-inline GLFWwindow* Window::GetNativeWindow() const {
-    return m_Window;
-}
-
 inline i32 Window::GetWidth() const {
     return m_Data.Width;
 }
@@ -40,16 +32,23 @@ inline bool Window::VSyncEnabled() const {
     return m_Data.VSyncEnabled;
 }
 
-inline void Window::SetVSync(const bool status) {
-    glfwSwapInterval(status);
-    m_Data.VSyncEnabled = status;
-    m_Data.ShouldInvalidateSwapchain = true;
+inline bool Window::IsFocused() const {
+    return m_Data.Focused;
+}
+
+inline bool Window::IsIconified() const {
+    return m_Data.Iconified;
 }
 
 inline void Window::SetEventCallback(const std::function<void(Event&)>& callback) {
     m_Data.EventCallback = callback;
 }
 
-inline void Window::Close() const {
-    glfwSetWindowShouldClose(m_Window, true);
+template <typename T>
+void Window::QueueEvent(WindowData& data, const T& event) {
+    if (!data.Events.Push(event)) {
+        // The queue is full, dispatch what we have now rather than dropping input.
+        data.Events.Drain(data.EventCallback);
+        data.Events.Push(event);
+    }
 }
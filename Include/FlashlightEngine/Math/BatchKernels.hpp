@@ -0,0 +1,30 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/fltypes.hpp>
+
+namespace Flashlight {
+    // Lanes per block of the bulk math functions, an AVX-512 register holds 16 floats.
+    inline constexpr u32 BatchWidth = 16;
+
+    /*
+     * BatchKernels : The bulk math functions compiled for one instruction set. They work on blocks of BatchWidth
+     * lanes laid out like Vec3x16 and Mat4x16 (64-byte aligned), or a single glm matrix as 16 floats, and take raw
+     * pointers so the files built for a given instruction set include nothing but this header and the intrinsics:
+     * inline functions shared with the rest of the engine would be compiled with instructions older CPUs don't have.
+     */
+    struct BatchKernels {
+        void (*TransformPoints)(const f32* matrix, const f32* points, f32* result, u32 blockCount);
+        void (*TransformDirections)(const f32* matrix, const f32* directions, f32* result, u32 blockCount);
+        void (*TransformPointsPerLane)(const f32* matrices, const f32* points, f32* result, u32 blockCount);
+        void (*MultiplyMatrices)(const f32* lhs, const f32* rhs, f32* result, u32 blockCount);
+        void (*MultiplyMatricesPerLane)(const f32* lhs, const f32* rhs, f32* result, u32 blockCount);
+        void (*NormalizeVectors)(const f32* vectors, f32* result, u32 blockCount);
+        void (*MultiplyAddVectors)(const f32* lhs, const f32* rhs, f32 scale, f32* result, u32 blockCount);
+        void (*DotVectors)(const f32* lhs, const f32* rhs, f32* result, u32 blockCount);
+        void (*CrossVectors)(const f32* lhs, const f32* rhs, f32* result, u32 blockCount);
+    };
+}
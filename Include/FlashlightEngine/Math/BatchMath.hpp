@@ -0,0 +1,60 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Math/BatchKernels.hpp>
+#include <FlashlightEngine/Math/SimdLevel.hpp>
+#include <FlashlightEngine/Math/SoaTypes.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+
+#include <span>
+
+namespace Flashlight {
+    // Blocks needed to hold count values.
+    [[nodiscard]] inline u32 GetBatchBlockCount(u32 count);
+
+    // Conversions from and to glm arrays. Lanes of the last block past the end of values are zero.
+    FL_API void PackVectors(std::span<const glm::vec3> values, std::span<Vec3x16> blocks);
+    FL_API void UnpackVectors(std::span<const Vec3x16> blocks, std::span<glm::vec3> values);
+    FL_API void PackMatrices(std::span<const glm::mat4> values, std::span<Mat4x16> blocks);
+    FL_API void UnpackMatrices(std::span<const Mat4x16> blocks, std::span<glm::mat4> values);
+
+    /*
+     * Bulk operations over blocks of BatchWidth lanes, run by the kernels of GetSimdLevel(). result must have as many
+     * blocks as the inputs and may be one of them. Matrices are taken as affine, their last row is ignored when they
+     * transform points or directions.
+     */
+    FL_API void TransformPoints(const glm::mat4& matrix, std::span<const Vec3x16> points, std::span<Vec3x16> result);
+    FL_API void TransformDirections(const glm::mat4& matrix, std::span<const Vec3x16> directions,
+                                    std::span<Vec3x16> result);
+
+    // Each point by the matrix in the same lane, the skinning case.
+    FL_API void TransformPoints(std::span<const Mat4x16> matrices, std::span<const Vec3x16> points,
+                                std::span<Vec3x16> result);
+
+    FL_API void MultiplyMatrices(const glm::mat4& lhs, std::span<const Mat4x16> rhs, std::span<Mat4x16> result);
+    FL_API void MultiplyMatrices(std::span<const Mat4x16> lhs, std::span<const Mat4x16> rhs,
+                                 std::span<Mat4x16> result);
+
+    // Zero vectors, like the lanes past the end of a packed array, stay zero where glm::normalize gives NaNs.
+    FL_API void NormalizeVectors(std::span<const Vec3x16> vectors, std::span<Vec3x16> result);
+
+    // lhs + rhs * scale.
+    FL_API void MultiplyAddVectors(std::span<const Vec3x16> lhs, std::span<const Vec3x16> rhs, f32 scale,
+                                   std::span<Vec3x16> result);
+
+    // result holds BatchWidth values per block.
+    FL_API void DotVectors(std::span<const Vec3x16> lhs, std::span<const Vec3x16> rhs, std::span<f32> result);
+    FL_API void CrossVectors(std::span<const Vec3x16> lhs, std::span<const Vec3x16> rhs, std::span<Vec3x16> result);
+
+    // Kernels of one level, to call them without dispatch. Null when the engine was built without that level.
+    [[nodiscard]] FL_API const BatchKernels* GetBatchKernels(SimdLevel level);
+
+#include <FlashlightEngine/Math/BatchMath.inl>
+}
@@ -0,0 +1,9 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u32 GetBatchBlockCount(const u32 count) {
+    return (count + BatchWidth - 1) / BatchWidth;
+}
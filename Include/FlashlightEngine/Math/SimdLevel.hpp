@@ -0,0 +1,33 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <string_view>
+
+namespace Flashlight {
+    // Instruction sets the batch math kernels are compiled for, each one implies the previous ones.
+    enum class SimdLevel : u8 {
+        Scalar,
+        Sse42,
+        Avx2, // With FMA.
+        Avx512 // AVX-512F only.
+    };
+
+    // Best level the CPU and the OS support, read with CPUID once.
+    [[nodiscard]] FL_API SimdLevel GetSupportedSimdLevel();
+
+    // Level the batch math functions dispatch to, the supported one unless SetSimdLevel lowered it.
+    [[nodiscard]] FL_API SimdLevel GetSimdLevel();
+
+    // Levels above the supported one are clamped to it. Meant for benchmarks and for comparing results across levels.
+    FL_API void SetSimdLevel(SimdLevel level);
+
+    [[nodiscard]] inline std::string_view GetSimdLevelName(SimdLevel level);
+
+#include <FlashlightEngine/Math/SimdLevel.inl>
+}
@@ -0,0 +1,20 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline std::string_view GetSimdLevelName(const SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return "Scalar";
+    case SimdLevel::Sse42:
+        return "SSE4.2";
+    case SimdLevel::Avx2:
+        return "AVX2";
+    case SimdLevel::Avx512:
+        return "AVX-512";
+    }
+
+    return "Unknown";
+}
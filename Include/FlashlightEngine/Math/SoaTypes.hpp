@@ -0,0 +1,143 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cmath>
+#include <span>
+#include <type_traits>
+
+namespace Flashlight {
+    /*
+     * Vec3xN : Width 3D vectors with one array per coordinate, so an operation over all of them is one instruction
+     * per coordinate on a register of Width floats. The operators below are plain loops the compiler vectorizes for
+     * the instruction set the engine is built with, the bulk functions of BatchMath.hpp pick theirs at runtime.
+     */
+    template <u32 Width>
+    struct alignas(Width * sizeof(f32)) Vec3xN {
+        static constexpr u32 LaneCount = Width;
+
+        std::array<f32, Width> X;
+        std::array<f32, Width> Y;
+        std::array<f32, Width> Z;
+
+        [[nodiscard]] static inline Vec3xN Splat(const glm::vec3& value);
+
+        // Lanes past the end of values are zero.
+        [[nodiscard]] static inline Vec3xN Load(std::span<const glm::vec3> values);
+
+        // Writes the first values.size() lanes.
+        inline void Store(std::span<glm::vec3> values) const;
+
+        [[nodiscard]] inline glm::vec3 Get(u32 lane) const;
+        inline void Set(u32 lane, const glm::vec3& value);
+    };
+
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> operator+(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs);
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> operator-(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs);
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> operator*(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs);
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> operator*(const Vec3xN<Width>& lhs, f32 rhs);
+
+    template <u32 Width>
+    [[nodiscard]] inline std::array<f32, Width> Dot(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs);
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> Cross(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs);
+
+    // Zero vectors give NaNs, like glm::normalize.
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> Normalize(const Vec3xN<Width>& value);
+
+    // lhs + rhs * scale, the integration step of particles.
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> MultiplyAdd(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs, f32 scale);
+
+    /*
+     * Mat4xN : Width 4x4 matrices, element (column, row) of every lane is in M[column * 4 + row], the order of
+     * glm::value_ptr.
+     */
+    template <u32 Width>
+    struct alignas(Width * sizeof(f32)) Mat4xN {
+        static constexpr u32 LaneCount = Width;
+
+        std::array<std::array<f32, Width>, 16> M;
+
+        [[nodiscard]] static inline Mat4xN Splat(const glm::mat4& value);
+
+        // Lanes past the end of values are zero.
+        [[nodiscard]] static inline Mat4xN Load(std::span<const glm::mat4> values);
+
+        // Writes the first values.size() lanes.
+        inline void Store(std::span<glm::mat4> values) const;
+
+        [[nodiscard]] inline glm::mat4 Get(u32 lane) const;
+        inline void Set(u32 lane, const glm::mat4& value);
+    };
+
+    template <u32 Width>
+    [[nodiscard]] inline Mat4xN<Width> operator*(const Mat4xN<Width>& lhs, const Mat4xN<Width>& rhs);
+
+    // The matrices are taken as affine, their last row is ignored.
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> TransformPoint(const Mat4xN<Width>& matrix, const Vec3xN<Width>& point);
+    template <u32 Width>
+    [[nodiscard]] inline Vec3xN<Width> TransformDirection(const Mat4xN<Width>& matrix,
+                                                          const Vec3xN<Width>& direction);
+
+    /*
+     * QuatxN : Width quaternions with one array per component. The operations expect unit quaternions, like the
+     * rotations of transforms.
+     */
+    template <u32 Width>
+    struct alignas(Width * sizeof(f32)) QuatxN {
+        static constexpr u32 LaneCount = Width;
+
+        std::array<f32, Width> X;
+        std::array<f32, Width> Y;
+        std::array<f32, Width> Z;
+        std::array<f32, Width> W;
+
+        [[nodiscard]] static inline QuatxN Splat(const glm::quat& value);
+
+        [[nodiscard]] inline glm::quat Get(u32 lane) const;
+        inline void Set(u32 lane, const glm::quat& value);
+    };
+
+    // Hamilton product, lhs * rhs rotates by rhs then by lhs.
+    template <u32 Width>
+    [[nodiscard]] inline QuatxN<Width> operator*(const QuatxN<Width>& lhs, const QuatxN<Width>& rhs);
+
+    template <u32 Width>
+    [[nodiscard]] inline QuatxN<Width> Conjugate(const QuatxN<Width>& value);
+    template <u32 Width>
+    [[nodiscard]] inline QuatxN<Width> Normalize(const QuatxN<Width>& value);
+
+    // Normalized lerp along the shortest path, close enough to a slerp between the nearby keys of an animation.
+    template <u32 Width>
+    [[nodiscard]] inline QuatxN<Width> Nlerp(const QuatxN<Width>& lhs, const QuatxN<Width>& rhs,
+                                             const std::type_identity_t<std::array<f32, Width>>& weights);
+
+    // One lane per float of an SSE, AVX or AVX-512 register.
+    using Vec3x4 = Vec3xN<4>;
+    using Vec3x8 = Vec3xN<8>;
+    using Vec3x16 = Vec3xN<16>;
+    using Quatx4 = QuatxN<4>;
+    using Quatx8 = QuatxN<8>;
+    using Mat4x8 = Mat4xN<8>;
+    using Mat4x16 = Mat4xN<16>;
+
+    static_assert(sizeof(Vec3x8) == 96 && alignof(Vec3x8) == 32);
+    static_assert(sizeof(Mat4x16) == 1024 && alignof(Mat4x16) == 64);
+
+#include <FlashlightEngine/Math/SoaTypes.inl>
+}
@@ -0,0 +1,325 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+template <u32 Width>
+inline Vec3xN<Width> Vec3xN<Width>::Splat(const glm::vec3& value) {
+    Vec3xN result;
+    result.X.fill(value.x);
+    result.Y.fill(value.y);
+    result.Z.fill(value.z);
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> Vec3xN<Width>::Load(const std::span<const glm::vec3> values) {
+    assert(values.size() <= Width && "Too many values for the lanes.");
+
+    Vec3xN result = Splat(glm::vec3(0.0f));
+    for (u32 lane = 0; lane < values.size(); lane++) {
+        result.Set(lane, values[lane]);
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline void Vec3xN<Width>::Store(const std::span<glm::vec3> values) const {
+    assert(values.size() <= Width && "Too many values for the lanes.");
+
+    for (u32 lane = 0; lane < values.size(); lane++) {
+        values[lane] = Get(lane);
+    }
+}
+
+template <u32 Width>
+inline glm::vec3 Vec3xN<Width>::Get(const u32 lane) const {
+    return {X[lane], Y[lane], Z[lane]};
+}
+
+template <u32 Width>
+inline void Vec3xN<Width>::Set(const u32 lane, const glm::vec3& value) {
+    X[lane] = value.x;
+    Y[lane] = value.y;
+    Z[lane] = value.z;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> operator+(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs) {
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        result.X[lane] = lhs.X[lane] + rhs.X[lane];
+        result.Y[lane] = lhs.Y[lane] + rhs.Y[lane];
+        result.Z[lane] = lhs.Z[lane] + rhs.Z[lane];
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> operator-(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs) {
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        result.X[lane] = lhs.X[lane] - rhs.X[lane];
+        result.Y[lane] = lhs.Y[lane] - rhs.Y[lane];
+        result.Z[lane] = lhs.Z[lane] - rhs.Z[lane];
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> operator*(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs) {
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        result.X[lane] = lhs.X[lane] * rhs.X[lane];
+        result.Y[lane] = lhs.Y[lane] * rhs.Y[lane];
+        result.Z[lane] = lhs.Z[lane] * rhs.Z[lane];
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> operator*(const Vec3xN<Width>& lhs, const f32 rhs) {
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        result.X[lane] = lhs.X[lane] * rhs;
+        result.Y[lane] = lhs.Y[lane] * rhs;
+        result.Z[lane] = lhs.Z[lane] * rhs;
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline std::array<f32, Width> Dot(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs) {
+    std::array<f32, Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        result[lane] = lhs.X[lane] * rhs.X[lane] + lhs.Y[lane] * rhs.Y[lane] + lhs.Z[lane] * rhs.Z[lane];
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> Cross(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs) {
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        result.X[lane] = lhs.Y[lane] * rhs.Z[lane] - lhs.Z[lane] * rhs.Y[lane];
+        result.Y[lane] = lhs.Z[lane] * rhs.X[lane] - lhs.X[lane] * rhs.Z[lane];
+        result.Z[lane] = lhs.X[lane] * rhs.Y[lane] - lhs.Y[lane] * rhs.X[lane];
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> Normalize(const Vec3xN<Width>& value) {
+    const std::array<f32, Width> lengths = Dot(value, value);
+
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        const f32 inverseLength = 1.0f / std::sqrt(lengths[lane]);
+        result.X[lane] = value.X[lane] * inverseLength;
+        result.Y[lane] = value.Y[lane] * inverseLength;
+        result.Z[lane] = value.Z[lane] * inverseLength;
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> MultiplyAdd(const Vec3xN<Width>& lhs, const Vec3xN<Width>& rhs, const f32 scale) {
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        result.X[lane] = lhs.X[lane] + rhs.X[lane] * scale;
+        result.Y[lane] = lhs.Y[lane] + rhs.Y[lane] * scale;
+        result.Z[lane] = lhs.Z[lane] + rhs.Z[lane] * scale;
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline QuatxN<Width> QuatxN<Width>::Splat(const glm::quat& value) {
+    QuatxN result;
+    result.X.fill(value.x);
+    result.Y.fill(value.y);
+    result.Z.fill(value.z);
+    result.W.fill(value.w);
+    return result;
+}
+
+template <u32 Width>
+inline glm::quat QuatxN<Width>::Get(const u32 lane) const {
+    return {W[lane], X[lane], Y[lane], Z[lane]};
+}
+
+template <u32 Width>
+inline void QuatxN<Width>::Set(const u32 lane, const glm::quat& value) {
+    X[lane] = value.x;
+    Y[lane] = value.y;
+    Z[lane] = value.z;
+    W[lane] = value.w;
+}
+
+template <u32 Width>
+inline QuatxN<Width> operator*(const QuatxN<Width>& lhs, const QuatxN<Width>& rhs) {
+    QuatxN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        const f32 x0 = lhs.X[lane], y0 = lhs.Y[lane], z0 = lhs.Z[lane], w0 = lhs.W[lane];
+        const f32 x1 = rhs.X[lane], y1 = rhs.Y[lane], z1 = rhs.Z[lane], w1 = rhs.W[lane];
+        result.X[lane] = w0 * x1 + x0 * w1 + y0 * z1 - z0 * y1;
+        result.Y[lane] = w0 * y1 + y0 * w1 + z0 * x1 - x0 * z1;
+        result.Z[lane] = w0 * z1 + z0 * w1 + x0 * y1 - y0 * x1;
+        result.W[lane] = w0 * w1 - x0 * x1 - y0 * y1 - z0 * z1;
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline QuatxN<Width> Conjugate(const QuatxN<Width>& value) {
+    QuatxN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        result.X[lane] = -value.X[lane];
+        result.Y[lane] = -value.Y[lane];
+        result.Z[lane] = -value.Z[lane];
+        result.W[lane] = value.W[lane];
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline QuatxN<Width> Normalize(const QuatxN<Width>& value) {
+    QuatxN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        const f32 x = value.X[lane], y = value.Y[lane], z = value.Z[lane], w = value.W[lane];
+        const f32 inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+        result.X[lane] = x * inverseLength;
+        result.Y[lane] = y * inverseLength;
+        result.Z[lane] = z * inverseLength;
+        result.W[lane] = w * inverseLength;
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline QuatxN<Width> Nlerp(const QuatxN<Width>& lhs, const QuatxN<Width>& rhs,
+                           const std::type_identity_t<std::array<f32, Width>>& weights) {
+    QuatxN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        const f32 dot = lhs.X[lane] * rhs.X[lane] + lhs.Y[lane] * rhs.Y[lane] + lhs.Z[lane] * rhs.Z[lane] +
+                        lhs.W[lane] * rhs.W[lane];
+
+        // q and -q are the same rotation, flipping rhs into the half-space of lhs takes the short way.
+        const f32 rhsWeight = dot < 0.0f ? -weights[lane] : weights[lane];
+        const f32 lhsWeight = 1.0f - weights[lane];
+        result.X[lane] = lhs.X[lane] * lhsWeight + rhs.X[lane] * rhsWeight;
+        result.Y[lane] = lhs.Y[lane] * lhsWeight + rhs.Y[lane] * rhsWeight;
+        result.Z[lane] = lhs.Z[lane] * lhsWeight + rhs.Z[lane] * rhsWeight;
+        result.W[lane] = lhs.W[lane] * lhsWeight + rhs.W[lane] * rhsWeight;
+    }
+
+    return Normalize(result);
+}
+
+template <u32 Width>
+inline Mat4xN<Width> Mat4xN<Width>::Splat(const glm::mat4& value) {
+    Mat4xN result;
+    for (u32 element = 0; element < 16; element++) {
+        result.M[element].fill(value[element / 4][element % 4]);
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Mat4xN<Width> Mat4xN<Width>::Load(const std::span<const glm::mat4> values) {
+    assert(values.size() <= Width && "Too many values for the lanes.");
+
+    Mat4xN result = Splat(glm::mat4(0.0f));
+    for (u32 lane = 0; lane < values.size(); lane++) {
+        result.Set(lane, values[lane]);
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline void Mat4xN<Width>::Store(const std::span<glm::mat4> values) const {
+    assert(values.size() <= Width && "Too many values for the lanes.");
+
+    for (u32 lane = 0; lane < values.size(); lane++) {
+        values[lane] = Get(lane);
+    }
+}
+
+template <u32 Width>
+inline glm::mat4 Mat4xN<Width>::Get(const u32 lane) const {
+    glm::mat4 result;
+    for (u32 element = 0; element < 16; element++) {
+        result[element / 4][element % 4] = M[element][lane];
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline void Mat4xN<Width>::Set(const u32 lane, const glm::mat4& value) {
+    for (u32 element = 0; element < 16; element++) {
+        M[element][lane] = value[element / 4][element % 4];
+    }
+}
+
+template <u32 Width>
+inline Mat4xN<Width> operator*(const Mat4xN<Width>& lhs, const Mat4xN<Width>& rhs) {
+    Mat4xN<Width> result;
+    for (u32 column = 0; column < 4; column++) {
+        for (u32 row = 0; row < 4; row++) {
+            for (u32 lane = 0; lane < Width; lane++) {
+                result.M[column * 4 + row][lane] = lhs.M[row][lane] * rhs.M[column * 4][lane] +
+                                                   lhs.M[4 + row][lane] * rhs.M[column * 4 + 1][lane] +
+                                                   lhs.M[8 + row][lane] * rhs.M[column * 4 + 2][lane] +
+                                                   lhs.M[12 + row][lane] * rhs.M[column * 4 + 3][lane];
+            }
+        }
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> TransformPoint(const Mat4xN<Width>& matrix, const Vec3xN<Width>& point) {
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        const f32 x = point.X[lane];
+        const f32 y = point.Y[lane];
+        const f32 z = point.Z[lane];
+        result.X[lane] = matrix.M[0][lane] * x + matrix.M[4][lane] * y + matrix.M[8][lane] * z + matrix.M[12][lane];
+        result.Y[lane] = matrix.M[1][lane] * x + matrix.M[5][lane] * y + matrix.M[9][lane] * z + matrix.M[13][lane];
+        result.Z[lane] = matrix.M[2][lane] * x + matrix.M[6][lane] * y + matrix.M[10][lane] * z + matrix.M[14][lane];
+    }
+
+    return result;
+}
+
+template <u32 Width>
+inline Vec3xN<Width> TransformDirection(const Mat4xN<Width>& matrix, const Vec3xN<Width>& direction) {
+    Vec3xN<Width> result;
+    for (u32 lane = 0; lane < Width; lane++) {
+        const f32 x = direction.X[lane];
+        const f32 y = direction.Y[lane];
+        const f32 z = direction.Z[lane];
+        result.X[lane] = matrix.M[0][lane] * x + matrix.M[4][lane] * y + matrix.M[8][lane] * z;
+        result.Y[lane] = matrix.M[1][lane] * x + matrix.M[5][lane] * y + matrix.M[9][lane] * z;
+        result.Z[lane] = matrix.M[2][lane] * x + matrix.M[6][lane] * y + matrix.M[10][lane] * z;
+    }
+
+    return result;
+}
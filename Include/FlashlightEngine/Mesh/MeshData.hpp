@@ -0,0 +1,38 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+
+namespace Flashlight {
+    struct FL_API MeshVertex {
+        glm::vec3 Position;
+        glm::vec3 Normal;
+        glm::vec2 TexCoord;
+    };
+
+    // An indexed triangle list.
+    struct FL_API MeshData {
+        std::vector<MeshVertex> Vertices;
+        std::vector<u32> Indices;
+
+        [[nodiscard]] inline u32 GetVertexCount() const;
+        [[nodiscard]] inline u32 GetTriangleCount() const;
+    };
+
+    /*
+     * Loads the faces of a Wavefront OBJ file, polygons are split into fans. Every face corner gets its own vertex,
+     * GenerateVertexRemap merges them back. Returns false, with the reason logged, if the file can't be read.
+     */
+    FL_API bool ImportObj(const std::filesystem::path& path, MeshData& mesh);
+    FL_API bool ExportObj(const std::filesystem::path& path, const MeshData& mesh);
+
+#include <FlashlightEngine/Mesh/MeshData.inl>
+}
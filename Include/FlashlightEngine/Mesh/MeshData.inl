@@ -0,0 +1,13 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u32 MeshData::GetVertexCount() const {
+    return static_cast<u32>(Vertices.size());
+}
+
+inline u32 MeshData::GetTriangleCount() const {
+    return static_cast<u32>(Indices.size() / 3);
+}
@@ -0,0 +1,102 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Mesh/MeshData.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <limits>
+#include <span>
+
+namespace Flashlight {
+    class JobSystem;
+
+    inline constexpr u32 InvalidVertex = std::numeric_limits<u32>::max();
+
+    // Post-transform cache efficiency of an index buffer, simulated with a FIFO cache.
+    struct FL_API VertexCacheStatistics {
+        u32 TransformedVertexCount = 0;
+        f32 Acmr = 0.0f; // Vertices transformed per triangle, 0.5 at best and 3 at worst.
+        f32 Atvr = 0.0f; // Vertices transformed per vertex used, 1 at best.
+    };
+
+    // Vertex buffer memory traffic of an index buffer, simulated with a 16 KiB cache of 64-byte lines.
+    struct FL_API VertexFetchStatistics {
+        u64 BytesFetched = 0;
+        f32 Overfetch = 0.0f; // Bytes fetched per byte of vertex used, 1 at best.
+    };
+
+    struct FL_API MeshOptimizerSettings {
+        u32 CacheSize = 16;
+
+        // How much worse ACMR may get to draw outer triangles first. 1 allows no ACMR loss but clusters may still be
+        // reordered, values under 1 skip the overdraw pass.
+        f32 OverdrawThreshold = 1.05f;
+
+        // Meshes with more triangles are cut into chunks of that size optimized in parallel, each one on its own.
+        // Only used with a job system, OptimizeMesh sorts the triangles spatially first so chunks are patches.
+        u32 ChunkTriangleCount = 1 << 16;
+
+        JobSystem* Jobs = nullptr;
+    };
+
+    struct FL_API MeshOptimizationReport {
+        u32 SourceVertexCount = 0;
+        u32 VertexCount = 0;
+        u32 TriangleCount = 0;
+        VertexCacheStatistics CacheBefore;
+        VertexCacheStatistics CacheAfter;
+        VertexFetchStatistics FetchBefore;
+        VertexFetchStatistics FetchAfter;
+    };
+
+    /*
+     * Finds the vertices with the same bytes and gives each group one new index, in order of first use. indices may
+     * be empty for an unindexed mesh, otherwise vertices it doesn't use are mapped to InvalidVertex.
+     * Returns the new vertex count.
+     */
+    FL_API u32 GenerateVertexRemap(std::span<u32> remap, std::span<const u32> indices, const void* vertices,
+                                   u32 vertexCount, u32 vertexSize, JobSystem* jobs = nullptr);
+
+    // destination may be indices.
+    FL_API void RemapIndices(std::span<u32> destination, std::span<const u32> indices, std::span<const u32> remap);
+
+    // destination must hold as many vertices as the remap generated and can't overlap vertices.
+    FL_API void RemapVertices(void* destination, const void* vertices, u32 vertexCount, u32 vertexSize,
+                              std::span<const u32> remap);
+
+    /*
+     * Orders the triangles along a Morton curve through their centroids, so any contiguous range of them is a compact
+     * patch of the mesh. The chunks optimized in parallel are such ranges. destination can't overlap indices.
+     */
+    FL_API void SortTrianglesSpatially(std::span<u32> destination, std::span<const u32> indices, const f32* positions,
+                                       u32 vertexCount, u32 positionStride, JobSystem* jobs = nullptr);
+
+    // Reorders the triangles for post-transform cache hits (Tipsify). destination can't overlap indices.
+    FL_API void OptimizeVertexCache(std::span<u32> destination, std::span<const u32> indices, u32 vertexCount,
+                                    const MeshOptimizerSettings& settings = {});
+
+    /*
+     * Reorders the clusters of a cache optimized index buffer so triangles facing out of the mesh are drawn first
+     * and hide the ones behind them. positions is the first position, positionStride the bytes between two of them.
+     * destination can't overlap indices.
+     */
+    FL_API void OptimizeOverdraw(std::span<u32> destination, std::span<const u32> indices, const f32* positions,
+                                 u32 vertexCount, u32 positionStride, const MeshOptimizerSettings& settings = {});
+
+    // Orders the vertices by first use so they are fetched sequentially. Returns the new vertex count.
+    FL_API u32 GenerateVertexFetchRemap(std::span<u32> remap, std::span<const u32> indices, u32 vertexCount);
+
+    [[nodiscard]] FL_API VertexCacheStatistics AnalyzeVertexCache(std::span<const u32> indices, u32 vertexCount,
+                                                                  u32 cacheSize = 16);
+    [[nodiscard]] FL_API VertexFetchStatistics AnalyzeVertexFetch(std::span<const u32> indices, u32 vertexCount,
+                                                                  u32 vertexSize);
+
+    // Runs every step above on the mesh: deduplication, spatial sort when chunked, vertex cache, overdraw and vertex
+    // fetch.
+    FL_API MeshOptimizationReport OptimizeMesh(MeshData& mesh, const MeshOptimizerSettings& settings = {});
+}
@@ -0,0 +1,119 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Mesh/MeshData.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <limits>
+#include <span>
+
+namespace Flashlight {
+    class JobSystem;
+    class Window;
+
+    struct FL_API SimplifySettings {
+        u32 TargetIndexCount = 0;
+
+        // Largest estimated error of a collapse, see SimplifyResult, relative to the largest side of the mesh
+        // bounding box.
+        f32 TargetError = 0.01f;
+    };
+
+    struct FL_API SimplifyResult {
+        u32 IndexCount = 0;
+
+        /*
+         * Worst collapse of the quadrics, relative like SimplifySettings::TargetError. It is the root mean square
+         * distance from a moved vertex to the planes it stood for, weighted by their area, so parts of the surface
+         * may move further. MeasureHausdorffDistance gives the actual distance.
+         */
+        f32 EstimatedError = 0.0f;
+    };
+
+    /*
+     * Quadric error metric simplification: vertices collapse onto a neighbour, cheapest first, until the index count
+     * reaches the target or the next collapse would move the surface more than the target error. Vertices on open
+     * borders or attribute seams (positions shared by several vertices) never move, so the mesh needs deduplicated
+     * vertices, see GenerateVertexRemap. Triangles keep indexing the same vertices. destination may be indices.
+     */
+    FL_API SimplifyResult SimplifyMesh(std::span<u32> destination, std::span<const u32> indices,
+                                       std::span<const MeshVertex> vertices, const SimplifySettings& settings);
+
+    struct FL_API MeshLod {
+        u32 IndexOffset;
+        u32 IndexCount;
+        // Estimated distance to the source surface, in mesh units. The distances are sampled and widened by
+        // LodErrorMargin, an estimate with a safety margin rather than a bound.
+        f32 Error;
+    };
+
+    // LODs of a mesh from the finest, the source, to the coarsest. They all index the vertices of the source.
+    struct FL_API MeshLodChain {
+        std::vector<u32> Indices;
+        std::vector<MeshLod> Lods;
+
+        [[nodiscard]] inline u32 GetLodCount() const;
+        [[nodiscard]] inline std::span<const u32> GetIndices(u32 lod) const;
+    };
+
+    struct FL_API LodChainSettings {
+        u32 MaxLodCount = 6;
+        f32 ReductionRatio = 0.5f; // Target triangle count of each LOD, relative to the previous one.
+        f32 MaxError = 0.05f; // SimplifySettings::TargetError of each step, the chain stops at the first one it limits.
+        u32 MinTriangleCount = 32;
+
+        JobSystem* Jobs = nullptr; // Measures the error of each LOD in parallel.
+    };
+
+    /*
+     * Margin on the measured error of each LOD step. MeasureHausdorffDistance only samples vertices and triangle
+     * centers, sampling inside the triangles found distances up to a quarter larger on bumpy spheres.
+     */
+    inline constexpr f32 LodErrorMargin = 1.5f;
+
+    /*
+     * Each LOD is simplified from the previous one and measured against it, its error is the sum of the sampled
+     * distances since the source, each one times LodErrorMargin. Measuring every step makes the chain about six times
+     * slower to build than summing the estimates of SimplifyMesh.
+     */
+    [[nodiscard]] FL_API MeshLodChain BuildLodChain(const MeshData& mesh, const LodChainSettings& settings = {});
+
+    // One job per mesh when a job system is given, which also measures the LODs. chains must have as many elements
+    // as meshes.
+    FL_API void BuildLodChains(std::span<const MeshData> meshes, std::span<MeshLodChain> chains,
+                               const LodChainSettings& settings = {}, JobSystem* jobs = nullptr);
+
+    /*
+     * Symmetric Hausdorff distance between two triangle sets over the same positions, approximated by the distances
+     * from the vertices and triangle centers of each set to the surface of the other.
+     */
+    [[nodiscard]] FL_API f32 MeasureHausdorffDistance(std::span<const u32> indicesA, std::span<const u32> indicesB,
+                                                      std::span<const MeshVertex> vertices, JobSystem* jobs = nullptr);
+
+    /*
+     * LodSelector : Picks the coarsest LOD whose error, projected on screen, stays under a number of pixels. Errors
+     * project with a perspective camera: pixels = error * viewport height / (2 * tan(fov / 2) * distance).
+     */
+    class FL_API LodSelector {
+        f32 m_PixelsPerUnit; // At a distance of one.
+        f32 m_MaxPixelError;
+
+    public:
+        LodSelector(u32 viewportHeight, f32 verticalFov, f32 maxPixelError = 1.0f);
+
+        // Uses the height of Window::GetExtent(), to build again when the window is resized.
+        [[nodiscard]] static LodSelector FromWindow(const Window& window, f32 verticalFov, f32 maxPixelError = 1.0f);
+
+        [[nodiscard]] inline f32 GetScreenError(f32 error, f32 distance) const;
+
+        // distance is from the camera to the nearest point of the mesh bounds, scale the largest scale of the model.
+        [[nodiscard]] inline u32 Select(const MeshLodChain& chain, f32 distance, f32 scale = 1.0f) const;
+    };
+
+#include <FlashlightEngine/Mesh/MeshSimplifier.inl>
+}
@@ -0,0 +1,27 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u32 MeshLodChain::GetLodCount() const {
+    return static_cast<u32>(Lods.size());
+}
+
+inline std::span<const u32> MeshLodChain::GetIndices(const u32 lod) const {
+    return std::span(Indices).subspan(Lods[lod].IndexOffset, Lods[lod].IndexCount);
+}
+
+inline f32 LodSelector::GetScreenError(const f32 error, const f32 distance) const {
+    return distance > 0.0f ? error * m_PixelsPerUnit / distance : std::numeric_limits<f32>::max();
+}
+
+inline u32 LodSelector::Select(const MeshLodChain& chain, const f32 distance, const f32 scale) const {
+    for (u32 lod = chain.GetLodCount(); lod > 1; lod--) {
+        if (GetScreenError(chain.Lods[lod - 1].Error * scale, distance) <= m_MaxPixelError) {
+            return lod - 1;
+        }
+    }
+
+    return 0;
+}
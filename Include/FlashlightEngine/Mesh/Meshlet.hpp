@@ -0,0 +1,108 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+#include <span>
+
+namespace Flashlight {
+    class JobSystem;
+
+    // Mesh shader friendly limits, 124 triangles keep the local indices of a meshlet within 372 bytes.
+    inline constexpr u32 MeshletMaxVertexCount = 64;
+    inline constexpr u32 MeshletMaxTriangleCount = 124;
+
+    // Offsets into the vertex and triangle arrays of the MeshletMesh.
+    struct FL_API Meshlet {
+        u32 VertexOffset;
+        u32 TriangleOffset; // In bytes, always a multiple of 4.
+        u32 VertexCount;
+        u32 TriangleCount;
+    };
+
+    /*
+     * Bounding sphere and normal cone of a meshlet, in the space of the mesh. Every triangle faces away from a camera
+     * at c when dot(Center - c, ConeAxis) >= ConeCutoff * length(Center - c) + Radius. A cutoff of 1 means the
+     * normals spread too much for the test to ever pass.
+     */
+    struct FL_API MeshletBounds {
+        glm::vec3 Center;
+        f32 Radius;
+        glm::vec3 ConeAxis;
+        f32 ConeCutoff;
+    };
+
+    static_assert(sizeof(Meshlet) == 16);
+    static_assert(sizeof(MeshletBounds) == 32);
+
+    /*
+     * Meshlets of an indexed mesh, stored in flat arrays that can be uploaded or written as they are. Vertices holds
+     * the mesh vertex indices used by each meshlet, Triangles three indices into those per triangle.
+     */
+    struct FL_API MeshletMesh {
+        std::vector<Meshlet> Meshlets;
+        std::vector<MeshletBounds> Bounds; // One per meshlet.
+        std::vector<u32> Vertices;
+        std::vector<u8> Triangles;
+
+        [[nodiscard]] inline u32 GetMeshletCount() const;
+        [[nodiscard]] inline std::span<const u32> GetVertices(const Meshlet& meshlet) const;
+        [[nodiscard]] inline std::span<const u8> GetTriangles(const Meshlet& meshlet) const;
+    };
+
+    struct FL_API MeshletBuildSettings {
+        u32 MaxVertexCount = MeshletMaxVertexCount; // At most 255.
+        u32 MaxTriangleCount = MeshletMaxTriangleCount;
+
+        // Between neighbours adding as many vertices, how much facing away from the meshlet costs compared to one
+        // more triangle left around the corners. Higher values give tighter cones.
+        f32 ConeWeight = 0.5f;
+
+        JobSystem* Jobs = nullptr; // Computes the triangle normals and the bounds in parallel.
+    };
+
+    /*
+     * Grows meshlets one triangle at a time, always taking the neighbouring triangle that adds the fewest vertices,
+     * and starts the next meshlet in the most enclosed spot next to the last one, so few small islands are left.
+     * positions is the first position, positionStride the bytes between two of them.
+     */
+    FL_API void BuildMeshlets(MeshletMesh& meshlets, std::span<const u32> indices, const f32* positions,
+                              u32 vertexCount, u32 positionStride, const MeshletBuildSettings& settings = {});
+
+    [[nodiscard]] FL_API MeshletBounds ComputeMeshletBounds(std::span<const u32> vertices,
+                                                            std::span<const u8> triangles, const f32* positions,
+                                                            u32 positionStride);
+
+    /*
+     * Meshlet file layout, little endian:
+     * - MeshletFileHeader.
+     * - The meshlets, the bounds, the vertices and the triangles, in that order and without padding.
+     */
+    inline constexpr std::array<char, 4> MeshletFileMagic = {'F', 'L', 'M', 'L'};
+    inline constexpr u32 MeshletFileVersion = 1;
+
+    struct MeshletFileHeader {
+        std::array<char, 4> Magic;
+        u32 Version;
+        u32 MeshletCount;
+        u32 VertexCount;
+        u32 TriangleSize; // In bytes.
+        std::array<u8, 12> Reserved;
+    };
+
+    static_assert(sizeof(MeshletFileHeader) == 32);
+
+    FL_API bool SaveMeshlets(const std::filesystem::path& path, const MeshletMesh& meshlets);
+
+    // Checks every meshlet range against the arrays. Returns false if the file can't be read or isn't valid.
+    FL_API bool LoadMeshlets(const std::filesystem::path& path, MeshletMesh& meshlets);
+
+#include <FlashlightEngine/Mesh/Meshlet.inl>
+}
@@ -0,0 +1,17 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u32 MeshletMesh::GetMeshletCount() const {
+    return static_cast<u32>(Meshlets.size());
+}
+
+inline std::span<const u32> MeshletMesh::GetVertices(const Meshlet& meshlet) const {
+    return std::span(Vertices).subspan(meshlet.VertexOffset, meshlet.VertexCount);
+}
+
+inline std::span<const u8> MeshletMesh::GetTriangles(const Meshlet& meshlet) const {
+    return std::span(Triangles).subspan(meshlet.TriangleOffset, static_cast<u64>(meshlet.TriangleCount) * 3);
+}
@@ -0,0 +1,44 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+
+namespace Flashlight {
+    // World-space bounding spheres, one array per coordinate so eight of them can be loaded in one register.
+    struct FL_API BoundingSpheres {
+        std::vector<f32> CenterX;
+        std::vector<f32> CenterY;
+        std::vector<f32> CenterZ;
+        std::vector<f32> Radius;
+
+        inline u32 Add(const glm::vec3& center, f32 radius);
+        inline void Set(u32 index, const glm::vec3& center, f32 radius);
+        inline void Clear();
+
+        [[nodiscard]] inline u32 GetCount() const;
+    };
+
+    // World-space axis-aligned boxes stored as center and half extents, the form the plane test needs.
+    struct FL_API BoundingBoxes {
+        std::vector<f32> CenterX;
+        std::vector<f32> CenterY;
+        std::vector<f32> CenterZ;
+        std::vector<f32> ExtentX;
+        std::vector<f32> ExtentY;
+        std::vector<f32> ExtentZ;
+
+        inline u32 Add(const glm::vec3& center, const glm::vec3& extents);
+        inline void Set(u32 index, const glm::vec3& center, const glm::vec3& extents);
+        inline void Clear();
+
+        [[nodiscard]] inline u32 GetCount() const;
+    };
+
+#include <FlashlightEngine/Renderer/BoundingVolumes.inl>
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u32 BoundingSpheres::Add(const glm::vec3& center, const f32 radius) {
+    CenterX.push_back(center.x);
+    CenterY.push_back(center.y);
+    CenterZ.push_back(center.z);
+    Radius.push_back(radius);
+
+    return GetCount() - 1;
+}
+
+inline void BoundingSpheres::Set(const u32 index, const glm::vec3& center, const f32 radius) {
+    CenterX[index] = center.x;
+    CenterY[index] = center.y;
+    CenterZ[index] = center.z;
+    Radius[index] = radius;
+}
+
+inline void BoundingSpheres::Clear() {
+    CenterX.clear();
+    CenterY.clear();
+    CenterZ.clear();
+    Radius.clear();
+}
+
+inline u32 BoundingSpheres::GetCount() const {
+    return static_cast<u32>(Radius.size());
+}
+
+inline u32 BoundingBoxes::Add(const glm::vec3& center, const glm::vec3& extents) {
+    CenterX.push_back(center.x);
+    CenterY.push_back(center.y);
+    CenterZ.push_back(center.z);
+    ExtentX.push_back(extents.x);
+    ExtentY.push_back(extents.y);
+    ExtentZ.push_back(extents.z);
+
+    return GetCount() - 1;
+}
+
+inline void BoundingBoxes::Set(const u32 index, const glm::vec3& center, const glm::vec3& extents) {
+    CenterX[index] = center.x;
+    CenterY[index] = center.y;
+    CenterZ[index] = center.z;
+    ExtentX[index] = extents.x;
+    ExtentY[index] = extents.y;
+    ExtentZ[index] = extents.z;
+}
+
+inline void BoundingBoxes::Clear() {
+    CenterX.clear();
+    CenterY.clear();
+    CenterZ.clear();
+    ExtentX.clear();
+    ExtentY.clear();
+    ExtentZ.clear();
+}
+
+inline u32 BoundingBoxes::GetCount() const {
+    return static_cast<u32>(ExtentX.size());
+}
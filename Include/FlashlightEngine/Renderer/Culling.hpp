@@ -0,0 +1,121 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+
+#include <FlashlightEngine/Math/SimdLevel.hpp>
+
+#include <FlashlightEngine/Renderer/BoundingVolumes.hpp>
+#include <FlashlightEngine/Renderer/CullingKernels.hpp>
+#include <FlashlightEngine/Renderer/OcclusionBuffer.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <span>
+
+namespace Flashlight {
+    // Six planes with normals pointing inside, a point p is inside a plane when dot(plane.xyz, p) + plane.w >= 0.
+    struct FL_API Frustum {
+        std::array<glm::vec4, 6> Planes; // Left, right, bottom, top, near, far.
+
+        // Planes of a view projection matrix with the Vulkan depth range, [0, 1].
+        [[nodiscard]] static Frustum FromViewProjection(const glm::mat4& viewProjection);
+    };
+
+    struct FL_API CullingStats {
+        u32 TestedCount = 0;
+        u32 FrustumCulledCount = 0;
+        u32 OcclusionCulledCount = 0;
+        u32 VisibleCount = 0;
+        u64 VisibleTriangleCount = 0;
+    };
+
+    /*
+     * Frustum tests over the ranges [begin, end), indices of the objects passing are written to visible, which must
+     * have room for end - begin values. Return the number written. They use the kernels of GetSimdLevel, which test
+     * up to sixteen objects at a time.
+     */
+    FL_API u32 CullSpheres(const Frustum& frustum, const BoundingSpheres& spheres, u32 begin, u32 end, u32* visible);
+    FL_API u32 CullBoxes(const Frustum& frustum, const BoundingBoxes& boxes, u32 begin, u32 end, u32* visible);
+
+    // Kernels of one level, to call them without dispatch. Null when the engine was built without that level.
+    [[nodiscard]] FL_API const CullingKernels* GetCullingKernels(SimdLevel level);
+
+    // Frustum test of a single sphere, for bounds not stored as arrays. Sums in the order of the scalar kernels.
+    [[nodiscard]] inline bool IsSphereInFrustum(const Frustum& frustum, const glm::vec3& center, f32 radius);
+
+    /*
+     * Adds a pass to the visibility fields of the engine statistics, every visible object counts as one draw call.
+     * Application::Run clears them when a frame starts, so the passes of a frame add up. Culler calls it when given
+     * CullingSettings::Stats.
+     */
+    inline void ReportCullingStats(const CullingStats& stats, EngineStats& engineStats);
+
+    struct FL_API CullingRangeCounts {
+        u32 FirstCulledCount = 0;
+        u32 SecondCulledCount = 0; // Of the objects passing the first test.
+        u32 VisibleCount = 0;
+    };
+
+    /*
+     * CullingRanges : Splits a culling pass in ranges spread over the job system, shared by the cullers. Every range
+     * runs a first test writing the indices passing it at the range's own offset, drops those a second test rejects,
+     * and the ranges are packed together afterwards. Keeps its scratch memory between calls.
+     */
+    class FL_API CullingRanges {
+        std::vector<u32> m_FirstCounts;
+        std::vector<u32> m_SecondCounts;
+
+    public:
+        /*
+         * test(begin, end, visible) writes the indices of [begin, end) passing the first test to visible and returns
+         * how many, reject(index) tells whether one of them fails the second test. visible is resized to the number
+         * of objects passing both and filled with their indices, in increasing order. Ranges hold enough objects to
+         * be worth a job each.
+         */
+        template <typename Test, typename Reject>
+        CullingRangeCounts Run(u32 count, u32 rangeSize, JobSystem* jobs, std::vector<u32>& visible, Test&& test,
+                               Reject&& reject);
+    };
+
+    struct FL_API CullingSettings {
+        JobSystem* Jobs = nullptr; // Null to cull on the calling thread.
+        const OcclusionBuffer* Occlusion = nullptr; // Null to skip the occlusion test.
+        std::span<const u32> TriangleCounts; // Per object, empty if triangles shouldn't be counted.
+
+        // The pass is added there with ReportCullingStats, null to skip it. Applications pass m_EngineStats from
+        // OnRender so the visibility counts reach the statistics and the replay CSV.
+        EngineStats* Stats = nullptr;
+    };
+
+    /*
+     * Culler : Runs the frustum test and the optional occlusion test over a whole set of bounds, split in ranges spread
+     * over the job system. Keeps its scratch memory between calls.
+     */
+    class FL_API Culler {
+        CullingRanges m_Ranges;
+
+    public:
+        static constexpr u32 RangeSize = 4096;
+
+        // visible is resized to the number of visible objects and filled with their indices, in increasing order.
+        CullingStats Cull(const Frustum& frustum, const BoundingSpheres& spheres, std::vector<u32>& visible,
+                          const CullingSettings& settings = {});
+        CullingStats Cull(const Frustum& frustum, const BoundingBoxes& boxes, std::vector<u32>& visible,
+                          const CullingSettings& settings = {});
+
+    private:
+        template <typename Bounds>
+        CullingStats CullImpl(const Frustum& frustum, const Bounds& bounds, std::vector<u32>& visible,
+                              const CullingSettings& settings);
+    };
+
+#include <FlashlightEngine/Renderer/Culling.inl>
+}
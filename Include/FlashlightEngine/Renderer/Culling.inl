@@ -0,0 +1,75 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline void ReportCullingStats(const CullingStats& stats, EngineStats& engineStats) {
+    engineStats.VisibleObjectCount += static_cast<i32>(stats.VisibleCount);
+    engineStats.CulledObjectCount += static_cast<i32>(stats.FrustumCulledCount + stats.OcclusionCulledCount);
+    engineStats.DrawCallCount += static_cast<i32>(stats.VisibleCount);
+    engineStats.TriangleCount += static_cast<i32>(stats.VisibleTriangleCount);
+}
+
+inline bool IsSphereInFrustum(const Frustum& frustum, const glm::vec3& center, const f32 radius) {
+    for (const glm::vec4& plane : frustum.Planes) {
+        f32 distance = center.x * plane.x + plane.w;
+        distance = center.y * plane.y + distance;
+        distance = center.z * plane.z + distance;
+        if (distance + radius < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename Test, typename Reject>
+CullingRangeCounts CullingRanges::Run(const u32 count, const u32 rangeSize, JobSystem* jobs, std::vector<u32>& visible,
+                                      Test&& test, Reject&& reject) {
+    const u32 rangeCount = (count + rangeSize - 1) / rangeSize;
+
+    // Every range writes its survivors at its own offset, they are packed together afterwards.
+    visible.resize(count);
+    m_FirstCounts.assign(rangeCount, 0);
+    m_SecondCounts.assign(rangeCount, 0);
+
+    const auto cullRanges = [&](const u32 firstRange, const u32 lastRange) {
+        for (u32 range = firstRange; range < lastRange; range++) {
+            const u32 begin = range * rangeSize;
+            const u32 end = std::min(begin + rangeSize, count);
+            u32* rangeVisible = visible.data() + begin;
+
+            const u32 firstCount = test(begin, end, rangeVisible);
+
+            u32 secondCount = 0;
+            for (u32 i = 0; i < firstCount; i++) {
+                if (!reject(rangeVisible[i])) {
+                    rangeVisible[secondCount++] = rangeVisible[i];
+                }
+            }
+
+            m_FirstCounts[range] = firstCount;
+            m_SecondCounts[range] = secondCount;
+        }
+    };
+
+    if (jobs != nullptr) {
+        jobs->ParallelFor(rangeCount, 1, cullRanges);
+    } else {
+        cullRanges(0, rangeCount);
+    }
+
+    CullingRangeCounts counts;
+    for (u32 range = 0; range < rangeCount; range++) {
+        const u32 begin = range * rangeSize;
+        std::copy_n(visible.begin() + begin, m_SecondCounts[range], visible.begin() + counts.VisibleCount);
+
+        counts.VisibleCount += m_SecondCounts[range];
+        counts.FirstCulledCount += std::min(begin + rangeSize, count) - begin - m_FirstCounts[range];
+        counts.SecondCulledCount += m_FirstCounts[range] - m_SecondCounts[range];
+    }
+
+    visible.resize(counts.VisibleCount);
+    return counts;
+}
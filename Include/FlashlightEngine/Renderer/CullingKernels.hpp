@@ -0,0 +1,41 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/fltypes.hpp>
+
+namespace Flashlight {
+    // Arrays of BoundingSpheres.
+    struct SphereArrays {
+        const f32* CenterX;
+        const f32* CenterY;
+        const f32* CenterZ;
+        const f32* Radius;
+    };
+
+    // Arrays of BoundingBoxes.
+    struct BoxArrays {
+        const f32* CenterX;
+        const f32* CenterY;
+        const f32* CenterZ;
+        const f32* ExtentX;
+        const f32* ExtentY;
+        const f32* ExtentZ;
+    };
+
+    /*
+     * CullingKernels : The frustum tests compiled for one instruction set. planes holds the six frustum planes as 24
+     * floats. Indices of the objects of [begin, end) passing the test are written to visible in increasing order, the
+     * number written is returned.
+     *
+     * The files under Source/Renderer/Kernels include nothing but this header, CullingKernels.inl and the intrinsics,
+     * hence the raw arrays: an inline function they shared with the rest of the engine (glm, <bit>...) would be
+     * compiled with their instruction set, and the linker may keep that copy for every caller.
+     */
+    struct CullingKernels {
+        u32 (*CullSpheres)(const f32* planes, const SphereArrays& spheres, u32 begin, u32 end, u32* visible);
+        u32 (*CullBoxes)(const f32* planes, const BoxArrays& boxes, u32 begin, u32 end, u32* visible);
+    };
+}
@@ -0,0 +1,47 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Mesh/Meshlet.hpp>
+#include <FlashlightEngine/Renderer/Culling.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+namespace Flashlight {
+    struct FL_API MeshletCullingStats {
+        u32 TestedCount = 0;
+        u32 FrustumCulledCount = 0;
+        u32 ConeCulledCount = 0; // Of the meshlets inside the frustum.
+        u32 VisibleCount = 0;
+        u64 VisibleTriangleCount = 0;
+    };
+
+    struct FL_API MeshletCullingSettings {
+        JobSystem* Jobs = nullptr; // Null to cull on the calling thread.
+        bool FrustumCulling = true;
+        bool ConeCulling = true;
+    };
+
+    /*
+     * MeshletCuller : CPU reference for the per-meshlet test a task shader would run, a sphere against the frustum
+     * then the normal cone against the camera position. Meshlet bounds are in mesh space, so the frustum must come
+     * from the view projection times the model matrix and the camera position must be in mesh space too.
+     */
+    class FL_API MeshletCuller {
+        CullingRanges m_Ranges;
+
+    public:
+        static constexpr u32 RangeSize = 1024;
+
+        // visible is resized to the number of visible meshlets and filled with their indices, in increasing order.
+        MeshletCullingStats Cull(const MeshletMesh& meshlets, const Frustum& frustum, const glm::vec3& cameraPosition,
+                                 std::vector<u32>& visible, const MeshletCullingSettings& settings = {});
+    };
+
+    [[nodiscard]] inline bool IsMeshletBackFacing(const MeshletBounds& bounds, const glm::vec3& cameraPosition);
+
+#include <FlashlightEngine/Renderer/MeshletCulling.inl>
+}
@@ -0,0 +1,10 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline bool IsMeshletBackFacing(const MeshletBounds& bounds, const glm::vec3& cameraPosition) {
+    const glm::vec3 toCenter = bounds.Center - cameraPosition;
+    return glm::dot(toCenter, bounds.ConeAxis) >= bounds.ConeCutoff * glm::length(toCenter) + bounds.Radius;
+}
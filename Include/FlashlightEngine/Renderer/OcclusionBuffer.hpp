@@ -0,0 +1,50 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+
+#include <span>
+
+namespace Flashlight {
+    /*
+     * OcclusionBuffer : Low resolution depth buffer filled on the CPU with a few large occluders, used to reject
+     * objects hidden behind them before they reach the GPU. Depth follows the Vulkan convention, 0 is the near plane.
+     * Coverage is sampled at pixel centers, so an object peeking through less than a pixel of the buffer can be
+     * rejected. Occluder triangles crossing the near plane are skipped, which only ever makes the test keep more.
+     * Rasterizing is single-threaded, tests are read-only and can run from any number of threads.
+     */
+    class FL_API OcclusionBuffer {
+        u32 m_Width;
+        u32 m_Height;
+        std::vector<f32> m_Depth; // Nearest occluder depth of every pixel.
+        glm::mat4 m_ViewProjection{1.0f};
+
+    public:
+        explicit OcclusionBuffer(u32 width = 256, u32 height = 128);
+
+        // Clears the buffer for a new view.
+        void Begin(const glm::mat4& viewProjection);
+
+        void RasterizeOccluder(std::span<const glm::vec3> vertices, std::span<const u32> indices,
+                               const glm::mat4& model);
+        void RasterizeOccluderBox(const glm::vec3& center, const glm::vec3& extents);
+
+        // False if the box is off-screen or behind occluders everywhere it covers.
+        [[nodiscard]] bool IsBoxVisible(const glm::vec3& center, const glm::vec3& extents) const;
+
+        [[nodiscard]] inline u32 GetWidth() const;
+        [[nodiscard]] inline u32 GetHeight() const;
+        [[nodiscard]] inline std::span<const f32> GetDepth() const;
+
+    private:
+        void RasterizeTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+    };
+
+#include <FlashlightEngine/Renderer/OcclusionBuffer.inl>
+}
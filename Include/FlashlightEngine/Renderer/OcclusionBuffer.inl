@@ -0,0 +1,17 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline u32 OcclusionBuffer::GetWidth() const {
+    return m_Width;
+}
+
+inline u32 OcclusionBuffer::GetHeight() const {
+    return m_Height;
+}
+
+inline std::span<const f32> OcclusionBuffer::GetDepth() const {
+    return m_Depth;
+}
@@ -0,0 +1,330 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <bit>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string_view>
+
+namespace Flashlight {
+    using RenderResourceId = u32;
+    using RenderPassId = u32;
+
+    constexpr RenderResourceId InvalidRenderResource = std::numeric_limits<RenderResourceId>::max();
+
+    enum class RenderResourceType : u8 {
+        Image,
+        Buffer
+    };
+
+    enum class RenderFormat : u8 {
+        R8G8B8A8Unorm,
+        R8G8B8A8Srgb,
+        B8G8R8A8Unorm,
+        B8G8R8A8Srgb,
+        R16G16B16A16Sfloat,
+        R32G32B32A32Sfloat,
+        R32Sfloat,
+        D32Sfloat,
+        D24UnormS8Uint
+    };
+
+    // Image layouts the graph moves images through, the backend maps them to the Vulkan ones.
+    enum class RenderImageLayout : u8 {
+        Undefined,
+        General,
+        ColorAttachment,
+        DepthStencilAttachment,
+        DepthStencilReadOnly,
+        ShaderReadOnly,
+        TransferSrc,
+        TransferDst,
+        PresentSrc
+    };
+
+    // One bit per way a pass can touch a resource, the backend maps them to pipeline stages and access masks.
+    enum class RenderUsage : u32 {
+        None = 0,
+        ColorAttachment = 1 << 0,
+        DepthStencilAttachment = 1 << 1,
+        DepthStencilRead = 1 << 2,
+        ShaderSampled = 1 << 3,
+        ShaderStorageRead = 1 << 4,
+        ShaderStorageWrite = 1 << 5,
+        TransferSrc = 1 << 6,
+        TransferDst = 1 << 7,
+        VertexBuffer = 1 << 8,
+        IndexBuffer = 1 << 9,
+        IndirectBuffer = 1 << 10,
+        UniformBuffer = 1 << 11,
+        Present = 1 << 12
+    };
+
+    using RenderUsageFlags = u32;
+
+    constexpr RenderUsageFlags RenderWriteUsages = static_cast<RenderUsageFlags>(RenderUsage::ColorAttachment) |
+                                                   static_cast<RenderUsageFlags>(RenderUsage::DepthStencilAttachment) |
+                                                   static_cast<RenderUsageFlags>(RenderUsage::ShaderStorageWrite) |
+                                                   static_cast<RenderUsageFlags>(RenderUsage::TransferDst);
+
+    [[nodiscard]] inline bool IsWriteUsage(RenderUsage usage);
+    [[nodiscard]] inline RenderImageLayout GetUsageLayout(RenderUsage usage);
+    [[nodiscard]] inline u32 GetFormatSize(RenderFormat format);
+
+    struct FL_API RenderImageDesc {
+        u32 Width = 1;
+        u32 Height = 1;
+        u32 MipLevels = 1;
+        u32 ArrayLayers = 1;
+        RenderFormat Format = RenderFormat::R8G8B8A8Unorm;
+    };
+
+    struct FL_API RenderBufferDesc {
+        u64 Size = 0;
+    };
+
+    // Recorded before the passes of a batch. Src are the accesses to wait for, none on a resource's first use.
+    struct FL_API RenderGraphBarrier {
+        RenderResourceId Resource;
+        RenderUsageFlags SrcUsages;
+        RenderUsageFlags DstUsages;
+        RenderImageLayout OldLayout;
+        RenderImageLayout NewLayout;
+    };
+
+    // Passes of a batch don't depend on each other, so all the barriers they need are recorded at once before them.
+    struct FL_API RenderGraphBatch {
+        u32 FirstPass; // Index in the pass order.
+        u32 PassCount;
+        u32 FirstBarrier;
+        u32 BarrierCount;
+    };
+
+    struct FL_API RenderGraphStats {
+        u32 PassCount = 0;
+        u32 CulledPassCount = 0;
+        u32 BatchCount = 0;
+        u32 BarrierCount = 0;
+        u32 TransientResourceCount = 0;
+        u64 TransientMemory = 0; // What the transient resources would take without aliasing.
+        u64 ImageHeapSize = 0;
+        u64 BufferHeapSize = 0;
+    };
+
+    /*
+     * RenderGraphBackend : Records what a compiled graph asks for, the Vulkan renderer implements it by translating
+     * the barriers to vkCmdPipelineBarrier2 calls and binding the transient resources to its heaps.
+     */
+    class FL_API RenderGraphBackend {
+    public:
+        RenderGraphBackend() = default;
+        virtual ~RenderGraphBackend() = default;
+
+        RenderGraphBackend(const RenderGraphBackend&) = delete;
+        RenderGraphBackend(RenderGraphBackend&&) = delete;
+
+        RenderGraphBackend& operator=(const RenderGraphBackend&) = delete;
+        RenderGraphBackend& operator=(RenderGraphBackend&&) = delete;
+
+        virtual void RecordBarriers(std::span<const RenderGraphBarrier> barriers) = 0;
+        virtual void BeginPass(std::string_view name);
+        virtual void EndPass();
+    };
+
+    using RenderPassExecute = std::function<void(RenderGraphBackend& backend)>;
+
+    class RenderGraph;
+
+    // Declares what a pass touches, only valid inside the setup function given to RenderGraph::AddPass.
+    class FL_API RenderPassBuilder {
+        RenderGraph& m_Graph;
+        RenderPassId m_Pass;
+
+    public:
+        inline RenderPassBuilder(RenderGraph& graph, RenderPassId pass);
+
+        inline RenderPassBuilder& Read(RenderResourceId resource, RenderUsage usage);
+        inline RenderPassBuilder& Write(RenderResourceId resource, RenderUsage usage);
+
+        // Keeps the pass even if nothing reads what it writes, e.g. for readbacks or debug output.
+        inline RenderPassBuilder& SetSideEffects();
+        inline RenderPassBuilder& SetExecute(RenderPassExecute execute);
+    };
+
+    /*
+     * RenderGraph : Passes with the resources they read and write, rebuilt every frame. Dependencies come from the
+     * declaration order: a pass depends on the last pass that wrote what it reads, and on the passes that read or
+     * wrote what it writes since then. Compile drops the passes none of the imported resources or passes with side
+     * effects depend on, groups the rest in levels of independent passes, computes one batch of barriers per level
+     * and places the transient resources in one heap per resource type, sharing memory between resources whose
+     * lifetimes don't overlap. Compiling never touches the GPU, only Execute goes through the backend.
+     */
+    class FL_API RenderGraph {
+        static constexpr u32 InvalidIndex = std::numeric_limits<u32>::max();
+        static constexpr u32 AntiDependencyBit = 1u << 31; // Set on predecessors that only read what the pass writes.
+
+        // Only what compiling reads, names and descriptions are kept aside so the passes over these stay small.
+        struct ResourceData {
+            u64 Size;
+            u64 Alignment;
+            RenderResourceType Type;
+            bool Imported;
+            RenderUsage InitialUsage;
+            RenderUsage FinalUsage;
+        };
+
+        struct ResourceDesc {
+            std::string Name;
+            RenderImageDesc Image;
+            RenderBufferDesc Buffer;
+        };
+
+        struct PassData {
+            u32 FirstAccess;
+            u32 AccessCount;
+            bool SideEffects;
+        };
+
+        struct PassCallbacks {
+            std::string Name;
+            RenderPassExecute Execute;
+        };
+
+        struct AccessData {
+            RenderResourceId Resource;
+            RenderUsage Usage;
+        };
+
+        struct ResourceState {
+            RenderImageLayout Layout;
+            RenderUsageFlags WriteUsages; // Last write, what every following access has to wait for.
+            RenderUsageFlags ReadUsages; // Reads since the last write, what the next write has to wait for.
+            RenderUsageFlags VisibleUsages; // Reads the last write was already made visible to.
+        };
+
+        struct ReaderNode {
+            RenderPassId Pass;
+            u32 Next;
+        };
+
+        struct FreeBlock {
+            u64 Offset;
+            u64 Size;
+            RenderUsageFlags Usages; // Of the resources that used this memory before, for the aliasing barrier.
+        };
+
+        std::vector<ResourceData> m_Resources;
+        std::vector<ResourceDesc> m_ResourceDescs;
+        std::vector<PassData> m_Passes;
+        std::vector<PassCallbacks> m_PassCallbacks;
+        std::vector<AccessData> m_Accesses;
+
+        // Compile results.
+        std::vector<RenderPassId> m_Order;
+        std::vector<RenderGraphBatch> m_Batches;
+        std::vector<RenderGraphBarrier> m_Barriers;
+        std::vector<u64> m_Offsets; // Per resource, in the heap of its type.
+        RenderGraphStats m_Stats;
+        bool m_Compiled = false;
+
+        // Scratch memory, kept between compilations.
+        std::vector<u32> m_PredecessorOffsets;
+        std::vector<u32> m_Predecessors;
+        std::vector<RenderPassId> m_LastWriters;
+        std::vector<u32> m_ReaderHeads;
+        std::vector<ReaderNode> m_ReaderNodes;
+        std::vector<u32> m_PassLevels;
+        std::vector<u32> m_LevelCounts;
+        std::vector<u32> m_FirstLevels;
+        std::vector<u32> m_LastLevels;
+        std::vector<RenderUsageFlags> m_ResourceUsages;
+        std::vector<RenderUsageFlags> m_AliasUsages;
+        std::vector<RenderResourceId> m_AllocationOrder;
+        std::vector<RenderResourceId> m_ReleaseOrder;
+        std::vector<FreeBlock> m_FreeBlocks;
+        std::vector<ResourceState> m_States;
+        std::vector<u32> m_LevelStamps;
+        std::vector<RenderUsageFlags> m_LevelUsages;
+        std::vector<RenderImageLayout> m_LevelLayouts;
+        std::vector<RenderResourceId> m_LevelResources;
+
+    public:
+        RenderGraph() = default;
+        ~RenderGraph() = default;
+
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph(RenderGraph&&) = delete;
+
+        RenderGraph& operator=(const RenderGraph&) = delete;
+        RenderGraph& operator=(RenderGraph&&) = delete;
+
+        // Transient resources only live for the frame, their memory comes from the graph heaps.
+        RenderResourceId CreateImage(std::string_view name, const RenderImageDesc& desc);
+        RenderResourceId CreateBuffer(std::string_view name, const RenderBufferDesc& desc);
+
+        // Imported resources live outside of the graph, like the swapchain images. They start in the state left by
+        // initialUsage and are moved to the state of finalUsage after the last pass. Passes writing them are kept.
+        RenderResourceId ImportImage(std::string_view name, const RenderImageDesc& desc,
+                                     RenderUsage initialUsage = RenderUsage::None,
+                                     RenderUsage finalUsage = RenderUsage::None);
+        RenderResourceId ImportBuffer(std::string_view name, const RenderBufferDesc& desc,
+                                      RenderUsage initialUsage = RenderUsage::None,
+                                      RenderUsage finalUsage = RenderUsage::None);
+
+        // Sizes are estimated from the descriptions, the backend can set the exact requirements of the device.
+        inline void SetMemoryRequirements(RenderResourceId resource, u64 size, u64 alignment);
+
+        // Calls setup with a RenderPassBuilder right away, to declare the accesses of the pass.
+        template <typename Setup>
+        RenderPassId AddPass(std::string_view name, Setup&& setup);
+
+        void Compile();
+        void Execute(RenderGraphBackend& backend) const;
+
+        // Forgets every pass and resource, keeps the memory for the next frame.
+        void Reset();
+
+        [[nodiscard]] inline u32 GetPassCount() const;
+        [[nodiscard]] inline u32 GetResourceCount() const;
+        [[nodiscard]] inline const std::string& GetPassName(RenderPassId pass) const;
+        [[nodiscard]] inline const std::string& GetResourceName(RenderResourceId resource) const;
+        [[nodiscard]] inline RenderResourceType GetResourceType(RenderResourceId resource) const;
+        [[nodiscard]] inline const RenderImageDesc& GetImageDesc(RenderResourceId resource) const;
+        [[nodiscard]] inline const RenderBufferDesc& GetBufferDesc(RenderResourceId resource) const;
+        [[nodiscard]] inline bool IsImported(RenderResourceId resource) const;
+
+        // Valid after Compile.
+        [[nodiscard]] inline bool IsPassCulled(RenderPassId pass) const;
+        [[nodiscard]] inline u64 GetResourceOffset(RenderResourceId resource) const;
+        [[nodiscard]] inline std::span<const RenderPassId> GetPassOrder() const;
+        [[nodiscard]] inline std::span<const RenderGraphBatch> GetBatches() const;
+        [[nodiscard]] inline std::span<const RenderGraphBarrier> GetBarriers() const;
+        [[nodiscard]] inline const RenderGraphStats& GetStats() const;
+
+    private:
+        friend class RenderPassBuilder;
+
+        RenderResourceId AddResource(std::string_view name, RenderResourceType type, const RenderImageDesc& image,
+                                     const RenderBufferDesc& buffer, bool imported, RenderUsage initialUsage,
+                                     RenderUsage finalUsage);
+        void AddAccess(RenderPassId pass, RenderResourceId resource, RenderUsage usage);
+
+        void BuildDependencies();
+        void CullPasses();
+        void SortPasses();
+        void ComputeLifetimes();
+        u64 AllocateHeap(RenderResourceType type);
+        void ComputeBarriers();
+        void AddBarrier(RenderResourceId resource, RenderUsageFlags srcUsages, RenderUsageFlags dstUsages,
+                        RenderImageLayout oldLayout, RenderImageLayout newLayout);
+    };
+
+#include <FlashlightEngine/Renderer/RenderGraph.inl>
+}
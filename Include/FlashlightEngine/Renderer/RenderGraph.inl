@@ -0,0 +1,153 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline bool IsWriteUsage(const RenderUsage usage) {
+    return (static_cast<RenderUsageFlags>(usage) & RenderWriteUsages) != 0;
+}
+
+inline RenderImageLayout GetUsageLayout(const RenderUsage usage) {
+    switch (usage) {
+    case RenderUsage::ColorAttachment:
+        return RenderImageLayout::ColorAttachment;
+    case RenderUsage::DepthStencilAttachment:
+        return RenderImageLayout::DepthStencilAttachment;
+    case RenderUsage::DepthStencilRead:
+        return RenderImageLayout::DepthStencilReadOnly;
+    case RenderUsage::ShaderSampled:
+        return RenderImageLayout::ShaderReadOnly;
+    case RenderUsage::ShaderStorageRead:
+    case RenderUsage::ShaderStorageWrite:
+        return RenderImageLayout::General;
+    case RenderUsage::TransferSrc:
+        return RenderImageLayout::TransferSrc;
+    case RenderUsage::TransferDst:
+        return RenderImageLayout::TransferDst;
+    case RenderUsage::Present:
+        return RenderImageLayout::PresentSrc;
+    default:
+        return RenderImageLayout::Undefined;
+    }
+}
+
+inline u32 GetFormatSize(const RenderFormat format) {
+    switch (format) {
+    case RenderFormat::R16G16B16A16Sfloat:
+        return 8;
+    case RenderFormat::R32G32B32A32Sfloat:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+inline RenderPassBuilder::RenderPassBuilder(RenderGraph& graph, const RenderPassId pass)
+    : m_Graph(graph), m_Pass(pass) {
+}
+
+inline RenderPassBuilder& RenderPassBuilder::Read(const RenderResourceId resource, const RenderUsage usage) {
+    assert(!IsWriteUsage(usage) && "Write usage declared as a read.");
+
+    m_Graph.AddAccess(m_Pass, resource, usage);
+    return *this;
+}
+
+inline RenderPassBuilder& RenderPassBuilder::Write(const RenderResourceId resource, const RenderUsage usage) {
+    assert(IsWriteUsage(usage) && "Read usage declared as a write.");
+
+    m_Graph.AddAccess(m_Pass, resource, usage);
+    return *this;
+}
+
+inline RenderPassBuilder& RenderPassBuilder::SetSideEffects() {
+    m_Graph.m_Passes[m_Pass].SideEffects = true;
+    return *this;
+}
+
+inline RenderPassBuilder& RenderPassBuilder::SetExecute(RenderPassExecute execute) {
+    m_Graph.m_PassCallbacks[m_Pass].Execute = std::move(execute);
+    return *this;
+}
+
+inline void RenderGraph::SetMemoryRequirements(const RenderResourceId resource, const u64 size, const u64 alignment) {
+    assert(std::has_single_bit(alignment) && "Alignment must be a power of two.");
+
+    m_Resources[resource].Size = size;
+    m_Resources[resource].Alignment = alignment;
+    m_Compiled = false;
+}
+
+template <typename Setup>
+RenderPassId RenderGraph::AddPass(const std::string_view name, Setup&& setup) {
+    const auto pass = static_cast<RenderPassId>(m_Passes.size());
+    m_Passes.push_back({static_cast<u32>(m_Accesses.size()), 0, false});
+    m_PassCallbacks.push_back({std::string(name), {}});
+    m_Compiled = false;
+
+    RenderPassBuilder builder(*this, pass);
+    setup(builder);
+
+    return pass;
+}
+
+inline u32 RenderGraph::GetPassCount() const {
+    return static_cast<u32>(m_Passes.size());
+}
+
+inline u32 RenderGraph::GetResourceCount() const {
+    return static_cast<u32>(m_Resources.size());
+}
+
+inline const std::string& RenderGraph::GetPassName(const RenderPassId pass) const {
+    return m_PassCallbacks[pass].Name;
+}
+
+inline const std::string& RenderGraph::GetResourceName(const RenderResourceId resource) const {
+    return m_ResourceDescs[resource].Name;
+}
+
+inline RenderResourceType RenderGraph::GetResourceType(const RenderResourceId resource) const {
+    return m_Resources[resource].Type;
+}
+
+inline const RenderImageDesc& RenderGraph::GetImageDesc(const RenderResourceId resource) const {
+    return m_ResourceDescs[resource].Image;
+}
+
+inline const RenderBufferDesc& RenderGraph::GetBufferDesc(const RenderResourceId resource) const {
+    return m_ResourceDescs[resource].Buffer;
+}
+
+inline bool RenderGraph::IsImported(const RenderResourceId resource) const {
+    return m_Resources[resource].Imported;
+}
+
+inline bool RenderGraph::IsPassCulled(const RenderPassId pass) const {
+    assert(m_Compiled && "The graph isn't compiled.");
+
+    return m_PassLevels[pass] == InvalidIndex;
+}
+
+inline u64 RenderGraph::GetResourceOffset(const RenderResourceId resource) const {
+    assert(m_Compiled && "The graph isn't compiled.");
+
+    return m_Offsets[resource];
+}
+
+inline std::span<const RenderPassId> RenderGraph::GetPassOrder() const {
+    return m_Order;
+}
+
+inline std::span<const RenderGraphBatch> RenderGraph::GetBatches() const {
+    return m_Batches;
+}
+
+inline std::span<const RenderGraphBarrier> RenderGraph::GetBarriers() const {
+    return m_Barriers;
+}
+
+inline const RenderGraphStats& RenderGraph::GetStats() const {
+    return m_Stats;
+}
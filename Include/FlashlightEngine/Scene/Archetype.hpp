@@ -0,0 +1,94 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/Platform.hpp>
+
+#include <FlashlightEngine/Scene/Component.hpp>
+#include <FlashlightEngine/Scene/Entity.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+namespace Flashlight {
+    struct ArchetypeRow {
+        u32 Chunk;
+        u32 Row;
+    };
+
+    /*
+     * Archetype : Stores every entity having exactly one set of components. Entities live in fixed-size chunks, a
+     * chunk holds one contiguous array per component (and one for the entity handles) so iterating a component touches
+     * only its own memory. Rows are kept dense: removing an entity moves the last one into its place, so every chunk
+     * but the last is full.
+     */
+    class FL_API Archetype {
+        friend class Scene;
+
+        struct Chunk {
+            std::byte* Data;
+            u32 Count;
+        };
+
+        ComponentMask m_Mask;
+        std::vector<ComponentId> m_ComponentIds; // In increasing id order, column i stores m_ComponentIds[i].
+        std::vector<const ComponentInfo*> m_ComponentInfos;
+        std::vector<u32> m_ColumnOffsets;
+        std::array<u8, MaxComponentTypes> m_ColumnIndices;
+
+        u32 m_ChunkCapacity = 0;
+        u32 m_ChunkBytes = 0;
+        std::vector<Chunk> m_Chunks;
+        u64 m_EntityCount = 0;
+
+        // Archetypes reached by adding or removing one component, filled in lazily by the scene.
+        std::array<Archetype*, MaxComponentTypes> m_AddEdges{};
+        std::array<Archetype*, MaxComponentTypes> m_RemoveEdges{};
+
+    public:
+        // Chunks are sized to stay in L1 while one is iterated.
+        static constexpr u32 ChunkSize = 16 * 1024;
+        static constexpr u8 InvalidColumn = 0xFF;
+
+        explicit Archetype(ComponentMask mask);
+        ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+        Archetype(Archetype&&) = delete;
+
+        Archetype& operator=(const Archetype&) = delete;
+        Archetype& operator=(Archetype&&) = delete;
+
+        // Appends a row for the entity, its components are left uninitialized.
+        ArchetypeRow Push(Entity entity);
+
+        // Destroys every component of the row.
+        void DestroyComponents(ArchetypeRow row);
+
+        // Fills the row with the last one, its components must have been destroyed or moved out already. Returns the
+        // entity moved into the row, or an invalid one if the row was the last.
+        Entity Remove(ArchetypeRow row);
+
+        [[nodiscard]] inline ComponentMask GetMask() const;
+        [[nodiscard]] inline const std::vector<ComponentId>& GetComponentIds() const;
+        [[nodiscard]] inline bool HasComponent(ComponentId id) const;
+        [[nodiscard]] inline u8 GetColumnIndex(ComponentId id) const;
+
+        [[nodiscard]] inline u32 GetChunkCount() const;
+        [[nodiscard]] inline u32 GetChunkCapacity() const;
+        [[nodiscard]] inline u32 GetChunkEntityCount(u32 chunk) const;
+        [[nodiscard]] inline u64 GetEntityCount() const;
+
+        [[nodiscard]] inline Entity* GetEntities(u32 chunk) const;
+        [[nodiscard]] inline void* GetColumn(u32 chunk, u8 column) const;
+        [[nodiscard]] inline void* GetComponent(ArchetypeRow row, u8 column) const;
+
+    private:
+        // Lays the columns out for this capacity and returns the chunk size it needs.
+        u32 ComputeChunkBytes(u32 capacity);
+    };
+
+#include <FlashlightEngine/Scene/Archetype.inl>
+}
@@ -0,0 +1,50 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline ComponentMask Archetype::GetMask() const {
+    return m_Mask;
+}
+
+inline const std::vector<ComponentId>& Archetype::GetComponentIds() const {
+    return m_ComponentIds;
+}
+
+inline bool Archetype::HasComponent(const ComponentId id) const {
+    return (m_Mask & (ComponentMask{1} << id)) != 0;
+}
+
+inline u8 Archetype::GetColumnIndex(const ComponentId id) const {
+    return m_ColumnIndices[id];
+}
+
+inline u32 Archetype::GetChunkCount() const {
+    return static_cast<u32>(m_Chunks.size());
+}
+
+inline u32 Archetype::GetChunkCapacity() const {
+    return m_ChunkCapacity;
+}
+
+inline u32 Archetype::GetChunkEntityCount(const u32 chunk) const {
+    return m_Chunks[chunk].Count;
+}
+
+inline u64 Archetype::GetEntityCount() const {
+    return m_EntityCount;
+}
+
+inline Entity* Archetype::GetEntities(const u32 chunk) const {
+    return reinterpret_cast<Entity*>(m_Chunks[chunk].Data);
+}
+
+inline void* Archetype::GetColumn(const u32 chunk, const u8 column) const {
+    return m_Chunks[chunk].Data + m_ColumnOffsets[column];
+}
+
+inline void* Archetype::GetComponent(const ArchetypeRow row, const u8 column) const {
+    return static_cast<std::byte*>(GetColumn(row.Chunk, column)) + static_cast<size_t>(row.Row) *
+           m_ComponentInfos[column]->Size;
+}
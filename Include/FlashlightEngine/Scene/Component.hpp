@@ -0,0 +1,58 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <cstring>
+#include <typeindex>
+
+namespace Flashlight {
+    using ComponentId = u32;
+    using ComponentMask = u64; // Bit i is set when the component with id i is present.
+
+    constexpr u32 MaxComponentTypes = 64;
+
+    // What an archetype needs to know to store a component type without knowing the type.
+    struct FL_API ComponentInfo {
+        const std::type_info* Type = nullptr;
+        std::string Name;
+        u32 Size = 0;
+        u32 Alignment = 0;
+
+        // Move constructs the destination from the source and destroys the source. Null for trivially copyable types,
+        // which are moved with memcpy.
+        void (*Relocate)(void* destination, void* source) = nullptr;
+        // Null for trivially destructible types.
+        void (*Destroy)(void* component) = nullptr;
+    };
+
+    /*
+     * ComponentRegistry : Hands out component ids. Types are compared with std::type_index, which every module sharing
+     * the engine library agrees on, unlike type_info addresses. Thread-safe, only registering takes a lock.
+     */
+    class FL_API ComponentRegistry {
+    public:
+        // Returns the id already given to the same type, if any.
+        static ComponentId Register(const ComponentInfo& info);
+
+        // Lock-free, the info of a registered type never changes.
+        [[nodiscard]] static const ComponentInfo& GetInfo(ComponentId id);
+        [[nodiscard]] static u32 GetComponentTypeCount();
+    };
+
+    // Id of T, the type is registered the first time this is called.
+    template <typename T>
+    [[nodiscard]] ComponentId GetComponentId();
+
+    template <typename... Ts>
+    [[nodiscard]] ComponentMask GetComponentMask();
+
+    inline void RelocateComponent(const ComponentInfo& info, void* destination, void* source);
+    inline void DestroyComponent(const ComponentInfo& info, void* component);
+
+#include <FlashlightEngine/Scene/Component.inl>
+}
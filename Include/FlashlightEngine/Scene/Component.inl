@@ -0,0 +1,57 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+template <typename T>
+ComponentId GetComponentId() {
+    using Component = std::remove_cvref_t<T>;
+    static_assert(std::is_nothrow_move_constructible_v<Component>,
+                  "Components are moved when entities change archetype.");
+
+    static const ComponentId id = [] {
+        ComponentInfo info;
+        info.Type = &typeid(Component);
+        info.Name = typeid(Component).name();
+        info.Size = static_cast<u32>(sizeof(Component));
+        info.Alignment = static_cast<u32>(alignof(Component));
+
+        if constexpr (!std::is_trivially_copyable_v<Component>) {
+            info.Relocate = [](void* destination, void* source) {
+                auto* component = static_cast<Component*>(source);
+                new (destination) Component(std::move(*component));
+                component->~Component();
+            };
+        }
+
+        if constexpr (!std::is_trivially_destructible_v<Component>) {
+            info.Destroy = [](void* component) {
+                static_cast<Component*>(component)->~Component();
+            };
+        }
+
+        return ComponentRegistry::Register(info);
+    }();
+
+    return id;
+}
+
+template <typename... Ts>
+ComponentMask GetComponentMask() {
+    return (ComponentMask{0} | ... | (ComponentMask{1} << GetComponentId<Ts>()));
+}
+
+inline void RelocateComponent(const ComponentInfo& info, void* destination, void* source) {
+    if (info.Relocate != nullptr) {
+        info.Relocate(destination, source);
+    } else {
+        std::memcpy(destination, source, info.Size);
+    }
+}
+
+inline void DestroyComponent(const ComponentInfo& info, void* component) {
+    if (info.Destroy != nullptr) {
+        info.Destroy(component);
+    }
+}
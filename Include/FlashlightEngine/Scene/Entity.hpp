@@ -0,0 +1,29 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <limits>
+
+namespace Flashlight {
+    /*
+     * Entity : Handle to an entity of a Scene. The index is reused once the entity is destroyed, the generation is
+     * bumped at the same time so handles to the old entity are detected as dead.
+     */
+    struct FL_API Entity {
+        static constexpr u32 InvalidIndex = std::numeric_limits<u32>::max();
+
+        u32 Index = InvalidIndex;
+        u32 Generation = 0;
+
+        [[nodiscard]] constexpr bool IsValid() const {
+            return Index != InvalidIndex;
+        }
+
+        constexpr bool operator==(const Entity&) const = default;
+    };
+}
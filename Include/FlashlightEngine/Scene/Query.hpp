@@ -0,0 +1,75 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <FlashlightEngine/Scene/Scene.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <utility>
+
+namespace Flashlight {
+    /*
+     * Query : Iterates the entities having at least the components Ts, a const component type gives read-only access.
+     * Matching archetypes are cached, each iteration only checks the archetypes created since the previous one.
+     * Iterations are timed under the "Scene::Query" profiler zone, which feeds EngineStats::SceneUpdateTime.
+     */
+    template <typename... Ts>
+    class Query {
+        struct MatchedArchetype {
+            Archetype* Storage;
+            std::array<u8, sizeof...(Ts)> Columns;
+        };
+
+        struct ChunkReference {
+            const MatchedArchetype* Matched;
+            u32 Chunk;
+        };
+
+        Scene& m_Scene;
+        ComponentMask m_Mask;
+        std::vector<MatchedArchetype> m_Archetypes;
+        u32 m_CheckedArchetypeCount = 0;
+        std::vector<ChunkReference> m_Chunks; // Kept between parallel iterations to reuse the allocation.
+
+    public:
+        explicit Query(Scene& scene);
+
+        // Calls function(Ts&...), or function(Entity, Ts&...), for every matching entity.
+        template <typename Function>
+        void ForEach(Function&& function);
+
+        // Calls function(u32 count, const Entity* entities, Ts*... components) for every matching chunk, each pointer
+        // is the start of an array of count elements.
+        template <typename Function>
+        void ForEachChunk(Function&& function);
+
+        // Same as ForEach and ForEachChunk but chunks are spread over the job system, the function is called from
+        // several threads at once.
+        template <typename Function>
+        void ParallelForEach(JobSystem& jobSystem, Function&& function);
+
+        template <typename Function>
+        void ParallelForEachChunk(JobSystem& jobSystem, Function&& function);
+
+        [[nodiscard]] u64 GetEntityCount();
+
+    private:
+        void Update();
+
+        template <typename Function, size_t... Indices>
+        static void InvokeChunk(const MatchedArchetype& matched, u32 chunk, Function& function,
+                                std::index_sequence<Indices...>);
+
+        template <typename Function>
+        static auto MakeEntityFunction(Function& function);
+    };
+
+#include <FlashlightEngine/Scene/Query.inl>
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+template <typename... Ts>
+Query<Ts...>::Query(Scene& scene) : m_Scene(scene), m_Mask(GetComponentMask<Ts...>()) {
+}
+
+template <typename... Ts>
+template <typename Function>
+void Query<Ts...>::ForEach(Function&& function) {
+    ForEachChunk(MakeEntityFunction(function));
+}
+
+template <typename... Ts>
+template <typename Function>
+void Query<Ts...>::ForEachChunk(Function&& function) {
+    FL_PROFILE_ZONE("Scene::Query");
+    Update();
+
+    for (const MatchedArchetype& matched : m_Archetypes) {
+        for (u32 chunk = 0; chunk < matched.Storage->GetChunkCount(); chunk++) {
+            InvokeChunk(matched, chunk, function, std::index_sequence_for<Ts...>{});
+        }
+    }
+}
+
+template <typename... Ts>
+template <typename Function>
+void Query<Ts...>::ParallelForEach(JobSystem& jobSystem, Function&& function) {
+    ParallelForEachChunk(jobSystem, MakeEntityFunction(function));
+}
+
+template <typename... Ts>
+template <typename Function>
+void Query<Ts...>::ParallelForEachChunk(JobSystem& jobSystem, Function&& function) {
+    FL_PROFILE_ZONE("Scene::Query");
+    Update();
+
+    m_Chunks.clear();
+    for (const MatchedArchetype& matched : m_Archetypes) {
+        for (u32 chunk = 0; chunk < matched.Storage->GetChunkCount(); chunk++) {
+            m_Chunks.push_back({&matched, chunk});
+        }
+    }
+
+    // A chunk is already a few thousand components, one per job is enough to hide the scheduling cost.
+    jobSystem.ParallelFor(static_cast<u32>(m_Chunks.size()), 1, [this, &function](const u32 begin, const u32 end) {
+        for (u32 i = begin; i < end; i++) {
+            InvokeChunk(*m_Chunks[i].Matched, m_Chunks[i].Chunk, function, std::index_sequence_for<Ts...>{});
+        }
+    });
+}
+
+template <typename... Ts>
+u64 Query<Ts...>::GetEntityCount() {
+    Update();
+
+    u64 count = 0;
+    for (const MatchedArchetype& matched : m_Archetypes) {
+        count += matched.Storage->GetEntityCount();
+    }
+
+    return count;
+}
+
+template <typename... Ts>
+void Query<Ts...>::Update() {
+    const u32 archetypeCount = m_Scene.GetArchetypeCount();
+
+    for (; m_CheckedArchetypeCount < archetypeCount; m_CheckedArchetypeCount++) {
+        Archetype& archetype = m_Scene.GetArchetype(m_CheckedArchetypeCount);
+        if ((archetype.GetMask() & m_Mask) != m_Mask) {
+            continue;
+        }
+
+        m_Archetypes.push_back({&archetype, {archetype.GetColumnIndex(GetComponentId<Ts>())...}});
+    }
+}
+
+template <typename... Ts>
+template <typename Function, size_t... Indices>
+void Query<Ts...>::InvokeChunk(const MatchedArchetype& matched, const u32 chunk, Function& function,
+                               std::index_sequence<Indices...>) {
+    const Archetype& archetype = *matched.Storage;
+
+    function(archetype.GetChunkEntityCount(chunk), static_cast<const Entity*>(archetype.GetEntities(chunk)),
+             static_cast<Ts*>(archetype.GetColumn(chunk, matched.Columns[Indices]))...);
+}
+
+template <typename... Ts>
+template <typename Function>
+auto Query<Ts...>::MakeEntityFunction(Function& function) {
+    return [&function](const u32 count, const Entity* entities, Ts*... components) {
+        for (u32 i = 0; i < count; i++) {
+            if constexpr (std::is_invocable_v<Function&, Entity, Ts&...>) {
+                function(entities[i], components[i]...);
+            } else {
+                function(components[i]...);
+            }
+        }
+    };
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/Scene/Archetype.hpp>
+#include <FlashlightEngine/Scene/Component.hpp>
+#include <FlashlightEngine/Scene/Entity.hpp>
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <unordered_map>
+
+namespace Flashlight {
+    /*
+     * Scene : Entity component system storing entities by archetype, see Archetype. Adding or removing a component
+     * moves the entity to another archetype, so components should be added when the entity is created where possible.
+     * Structural changes (creating and destroying entities, adding and removing components) are main thread only and
+     * must not happen while a query iterates. Component values can be written from any thread as long as two threads
+     * never touch the same entity.
+     */
+    class FL_API Scene {
+        struct EntityRecord {
+            Archetype* Owner = nullptr; // Null while the index is free.
+            ArchetypeRow Row{};
+            u32 Generation = 0;
+        };
+
+        std::vector<EntityRecord> m_Records;
+        std::vector<u32> m_FreeIndices;
+
+        // Archetypes are never destroyed, queries rely on it to only look at the ones created since their last update.
+        std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+        std::unordered_map<ComponentMask, Archetype*> m_ArchetypesByMask;
+
+        u64 m_EntityCount = 0;
+
+    public:
+        Scene();
+        ~Scene() = default;
+
+        Scene(const Scene&) = delete;
+        Scene(Scene&&) = delete;
+
+        Scene& operator=(const Scene&) = delete;
+        Scene& operator=(Scene&&) = delete;
+
+        Entity CreateEntity();
+
+        template <typename... Ts>
+        Entity CreateEntity(Ts&&... components);
+
+        void DestroyEntity(Entity entity);
+
+        // Destroys every entity, archetypes are kept.
+        void Clear();
+
+        [[nodiscard]] inline bool IsAlive(Entity entity) const;
+
+        // Replaces the component if the entity already has one.
+        template <typename T, typename... Args>
+        T& AddComponent(Entity entity, Args&&... args);
+
+        template <typename T>
+        void RemoveComponent(Entity entity);
+
+        template <typename T>
+        [[nodiscard]] bool HasComponent(Entity entity) const;
+
+        template <typename T>
+        [[nodiscard]] T& GetComponent(Entity entity) const;
+
+        // Null if the entity doesn't have the component.
+        template <typename T>
+        [[nodiscard]] T* TryGetComponent(Entity entity) const;
+
+        [[nodiscard]] inline u64 GetEntityCount() const;
+        [[nodiscard]] inline u32 GetArchetypeCount() const;
+        [[nodiscard]] inline Archetype& GetArchetype(u32 index) const;
+
+    private:
+        Entity AllocateEntity(Archetype& archetype);
+        Archetype& GetOrCreateArchetype(ComponentMask mask);
+        Archetype& GetAddTarget(Archetype& source, ComponentId id);
+        Archetype& GetRemoveTarget(Archetype& source, ComponentId id);
+
+        // Moves the components the target shares with the current archetype, destroys the others. Components only in
+        // the target are left uninitialized.
+        void MoveEntity(Entity entity, Archetype& target);
+
+        [[nodiscard]] void* FindComponent(Entity entity, ComponentId id) const;
+    };
+
+#include <FlashlightEngine/Scene/Scene.inl>
+}
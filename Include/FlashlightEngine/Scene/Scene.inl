@@ -0,0 +1,85 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+template <typename... Ts>
+Entity Scene::CreateEntity(Ts&&... components) {
+    Archetype& archetype = GetOrCreateArchetype(GetComponentMask<Ts...>());
+    const Entity entity = AllocateEntity(archetype);
+    const ArchetypeRow row = m_Records[entity.Index].Row;
+
+    (new (archetype.GetComponent(row, archetype.GetColumnIndex(GetComponentId<Ts>())))
+         std::remove_cvref_t<Ts>(std::forward<Ts>(components)), ...);
+
+    return entity;
+}
+
+inline bool Scene::IsAlive(const Entity entity) const {
+    return entity.Index < m_Records.size() && m_Records[entity.Index].Owner != nullptr &&
+           m_Records[entity.Index].Generation == entity.Generation;
+}
+
+template <typename T, typename... Args>
+T& Scene::AddComponent(const Entity entity, Args&&... args) {
+    assert(IsAlive(entity) && "Entity is dead.");
+
+    const ComponentId id = GetComponentId<T>();
+    const EntityRecord& record = m_Records[entity.Index];
+
+    if (record.Owner->HasComponent(id)) {
+        T& component = *static_cast<T*>(record.Owner->GetComponent(record.Row, record.Owner->GetColumnIndex(id)));
+        component = T(std::forward<Args>(args)...);
+        return component;
+    }
+
+    MoveEntity(entity, GetAddTarget(*record.Owner, id));
+
+    void* storage = record.Owner->GetComponent(record.Row, record.Owner->GetColumnIndex(id));
+    return *new (storage) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void Scene::RemoveComponent(const Entity entity) {
+    assert(IsAlive(entity) && "Entity is dead.");
+
+    const ComponentId id = GetComponentId<T>();
+    const EntityRecord& record = m_Records[entity.Index];
+
+    if (!record.Owner->HasComponent(id)) {
+        return;
+    }
+
+    MoveEntity(entity, GetRemoveTarget(*record.Owner, id));
+}
+
+template <typename T>
+bool Scene::HasComponent(const Entity entity) const {
+    return FindComponent(entity, GetComponentId<T>()) != nullptr;
+}
+
+template <typename T>
+T& Scene::GetComponent(const Entity entity) const {
+    T* component = TryGetComponent<T>(entity);
+    assert(component && "Entity doesn't have this component.");
+
+    return *component;
+}
+
+template <typename T>
+T* Scene::TryGetComponent(const Entity entity) const {
+    return static_cast<T*>(FindComponent(entity, GetComponentId<T>()));
+}
+
+inline u64 Scene::GetEntityCount() const {
+    return m_EntityCount;
+}
+
+inline u32 Scene::GetArchetypeCount() const {
+    return static_cast<u32>(m_Archetypes.size());
+}
+
+inline Archetype& Scene::GetArchetype(const u32 index) const {
+    return *m_Archetypes[index];
+}
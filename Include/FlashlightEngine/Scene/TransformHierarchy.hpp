@@ -0,0 +1,112 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/flpch.hpp>
+#include <FlashlightEngine/Export.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <limits>
+#include <span>
+
+namespace Flashlight {
+    class JobSystem;
+
+    using TransformId = u32;
+
+    constexpr TransformId InvalidTransform = std::numeric_limits<TransformId>::max();
+
+    /*
+     * TransformHierarchy : Local translation, rotation and scale of a set of nodes, and the world matrices computed
+     * from them. Every field is stored in its own array, in breadth-first order so a parent always comes before its
+     * children: world matrices are computed in one linear pass, and only for nodes whose local transform or one of
+     * whose ancestors changed since the last Update. Structural changes make the next Update sort the nodes again.
+     * Every depth level is a contiguous range whose nodes only read the levels before it, so Update can split a level
+     * across the workers of a job system. Ids are stable while the node lives and are reused once it is destroyed.
+     * Not thread-safe.
+     */
+    class FL_API TransformHierarchy {
+        static constexpr u32 InvalidIndex = std::numeric_limits<u32>::max();
+
+        // Indexed by position in the depth order.
+        std::vector<TransformId> m_Ids;
+        std::vector<u32> m_ParentIndices;
+        std::vector<glm::vec3> m_LocalPositions;
+        std::vector<glm::quat> m_LocalRotations;
+        std::vector<glm::vec3> m_LocalScales;
+        std::vector<glm::mat4> m_WorldMatrices;
+        std::vector<u8> m_Dirty;
+
+        // First index of every depth level, then the node count. Valid while the order isn't dirty.
+        std::vector<u32> m_LevelOffsets;
+
+        // Indexed by id.
+        std::vector<u32> m_Indices;
+        std::vector<TransformId> m_FreeIds;
+
+        bool m_OrderDirty = false;
+        // Nothing before it is dirty, so Update starts there. InvalidIndex when nothing changed.
+        u32 m_FirstDirtyIndex = InvalidIndex;
+
+    public:
+        TransformHierarchy() = default;
+        ~TransformHierarchy() = default;
+
+        TransformHierarchy(const TransformHierarchy&) = delete;
+        TransformHierarchy(TransformHierarchy&&) = delete;
+
+        TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+        TransformHierarchy& operator=(TransformHierarchy&&) = delete;
+
+        TransformId Create(TransformId parent = InvalidTransform);
+
+        // Destroys the node and its whole subtree. Costs a pass over every node, destroy many nodes at once with the
+        // span overload.
+        void Destroy(TransformId id);
+        void Destroy(std::span<const TransformId> ids);
+
+        // The local transform is kept, so the node is now placed relative to its new parent.
+        void SetParent(TransformId id, TransformId parent);
+        [[nodiscard]] TransformId GetParent(TransformId id) const;
+
+        inline void SetLocalPosition(TransformId id, const glm::vec3& position);
+        inline void SetLocalRotation(TransformId id, const glm::quat& rotation);
+        inline void SetLocalScale(TransformId id, const glm::vec3& scale);
+        inline void SetLocalTransform(TransformId id, const glm::vec3& position, const glm::quat& rotation,
+                                      const glm::vec3& scale);
+
+        [[nodiscard]] inline const glm::vec3& GetLocalPosition(TransformId id) const;
+        [[nodiscard]] inline const glm::quat& GetLocalRotation(TransformId id) const;
+        [[nodiscard]] inline const glm::vec3& GetLocalScale(TransformId id) const;
+
+        // Up to date after Update.
+        [[nodiscard]] inline const glm::mat4& GetWorldMatrix(TransformId id) const;
+
+        /*
+         * Recomputes the world matrix of every node changed since the last call, and of their descendants. With a job
+         * system, levels of more than a few thousand nodes are split across its workers.
+         */
+        void Update(JobSystem* jobs = nullptr);
+
+        [[nodiscard]] inline bool IsAlive(TransformId id) const;
+        [[nodiscard]] inline u32 GetCount() const;
+
+        // World matrices and the id of the node each one belongs to, in depth order. Invalidated by Update and by
+        // structural changes.
+        [[nodiscard]] inline std::span<const glm::mat4> GetWorldMatrices() const;
+        [[nodiscard]] inline std::span<const TransformId> GetIds() const;
+
+    private:
+        inline void MarkDirty(u32 index);
+
+        void UpdateRange(u32 begin, u32 end);
+        void SortBreadthFirst();
+        void RemoveMarked(const std::vector<u8>& removed);
+    };
+
+#include <FlashlightEngine/Scene/TransformHierarchy.inl>
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+inline void TransformHierarchy::SetLocalPosition(const TransformId id, const glm::vec3& position) {
+    const u32 index = m_Indices[id];
+    m_LocalPositions[index] = position;
+    MarkDirty(index);
+}
+
+inline void TransformHierarchy::SetLocalRotation(const TransformId id, const glm::quat& rotation) {
+    const u32 index = m_Indices[id];
+    m_LocalRotations[index] = rotation;
+    MarkDirty(index);
+}
+
+inline void TransformHierarchy::SetLocalScale(const TransformId id, const glm::vec3& scale) {
+    const u32 index = m_Indices[id];
+    m_LocalScales[index] = scale;
+    MarkDirty(index);
+}
+
+inline void TransformHierarchy::SetLocalTransform(const TransformId id, const glm::vec3& position,
+                                                  const glm::quat& rotation, const glm::vec3& scale) {
+    const u32 index = m_Indices[id];
+    m_LocalPositions[index] = position;
+    m_LocalRotations[index] = rotation;
+    m_LocalScales[index] = scale;
+    MarkDirty(index);
+}
+
+inline const glm::vec3& TransformHierarchy::GetLocalPosition(const TransformId id) const {
+    return m_LocalPositions[m_Indices[id]];
+}
+
+inline const glm::quat& TransformHierarchy::GetLocalRotation(const TransformId id) const {
+    return m_LocalRotations[m_Indices[id]];
+}
+
+inline const glm::vec3& TransformHierarchy::GetLocalScale(const TransformId id) const {
+    return m_LocalScales[m_Indices[id]];
+}
+
+inline const glm::mat4& TransformHierarchy::GetWorldMatrix(const TransformId id) const {
+    return m_WorldMatrices[m_Indices[id]];
+}
+
+inline bool TransformHierarchy::IsAlive(const TransformId id) const {
+    return id < m_Indices.size() && m_Indices[id] != InvalidIndex;
+}
+
+inline u32 TransformHierarchy::GetCount() const {
+    return static_cast<u32>(m_Ids.size());
+}
+
+inline std::span<const glm::mat4> TransformHierarchy::GetWorldMatrices() const {
+    return m_WorldMatrices;
+}
+
+inline std::span<const TransformId> TransformHierarchy::GetIds() const {
+    return m_Ids;
+}
+
+inline void TransformHierarchy::MarkDirty(const u32 index) {
+    m_Dirty[index] = 1;
+    m_FirstDirtyIndex = std::min(m_FirstDirtyIndex, index);
+}
@@ -0,0 +1,32 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#pragma once
+
+#include <FlashlightEngine/fltypes.hpp>
+
+namespace Flashlight {
+    // Parent index of the roots in TransformArrays.
+    inline constexpr u32 TransformRootParent = ~0u;
+
+    // Arrays of a TransformHierarchy: 3 floats per position and scale, 4 per rotation (x, y, z, w), 16 per matrix.
+    struct TransformArrays {
+        const u32* ParentIndices;
+        const f32* Positions;
+        const f32* Rotations;
+        const f32* Scales;
+        u8* Dirty;
+        f32* WorldMatrices;
+    };
+
+    /*
+     * TransformKernels : The world matrix update compiled for one instruction set. UpdateWorldMatrices recomputes the
+     * nodes of [begin, end) that are dirty or have a dirty parent and marks them dirty, their parents must be up to
+     * date. The files under Source/Scene/Kernels include nothing but this header, TransformKernels.inl and the
+     * intrinsics, see CullingKernels for why.
+     */
+    struct TransformKernels {
+        void (*UpdateWorldMatrices)(const TransformArrays& nodes, u32 begin, u32 end);
+    };
+}
@@ -24,9 +24,16 @@ using f64 = double;
 
 // Engine structures
 struct EngineStats {
+    // Times are in seconds.
     f32 FrameTime;
+    // Sums of the frame's culling passes given these stats, see CullingSettings::Stats.
     i32 TriangleCount;
     i32 DrawCallCount;
-    f32 SceneUpdateTime;
-    f32 MeshDrawTime;
+    i32 VisibleObjectCount;
+    i32 CulledObjectCount;
+    f32 SceneUpdateTime; // "Scene::Query" profiler zones.
+    f32 MeshDrawTime; // "Renderer::DrawMeshes" profiler zones, open one around the code recording mesh draws.
+    u64 FrameAllocatedBytes;
+    u64 FrameAllocationCount;
+    u64 FrameArenaOverflowCount;
 };
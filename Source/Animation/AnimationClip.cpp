@@ -0,0 +1,489 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Animation/AnimationClip.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Flashlight {
+    namespace {
+        constexpr f32 VectorSteps = 65535.0f;
+
+        // The three smallest components of a unit quaternion are within +-1/sqrt(2).
+        constexpr f32 RotationRange = 0.70710678f;
+        constexpr f32 RotationSteps = 32767.0f;
+        constexpr f32 RotationStepSize = 2.0f * RotationRange / RotationSteps;
+
+        QuantizedKey EncodeVector(const glm::vec3& value, const ClipTrack& track) {
+            QuantizedKey key{};
+            for (u32 component = 0; component < 3; component++) {
+                if (track.Extent[component] > 0.0f) {
+                    const f32 step = (value[component] - track.Minimum[component]) / track.Extent[component];
+                    key[component] = static_cast<u16>(std::lround(std::clamp(step, 0.0f, 1.0f) * VectorSteps));
+                }
+            }
+
+            return key;
+        }
+
+        glm::vec3 DecodeVector(const QuantizedKey& key, const ClipTrack& track) {
+            return track.Minimum + glm::vec3(key[0], key[1], key[2]) * (track.Extent / VectorSteps);
+        }
+
+        QuantizedKey EncodeRotation(glm::quat rotation) {
+            rotation = glm::normalize(rotation);
+
+            u32 largest = 0;
+            for (u32 component = 1; component < 4; component++) {
+                if (std::abs(rotation[component]) > std::abs(rotation[largest])) {
+                    largest = component;
+                }
+            }
+
+            // q and -q are the same rotation, the positive largest component is the one left out.
+            if (rotation[largest] < 0.0f) {
+                rotation = -rotation;
+            }
+
+            QuantizedKey key{};
+            u32 next = 0;
+            for (u32 component = 0; component < 4; component++) {
+                if (component == largest) {
+                    continue;
+                }
+
+                const f32 value = std::clamp(rotation[component] / RotationRange, -1.0f, 1.0f);
+                const auto step = static_cast<u16>(std::lround((value * 0.5f + 0.5f) * RotationSteps));
+                key[next++] = static_cast<u16>(step << 1);
+            }
+
+            key[0] |= static_cast<u16>(largest & 1);
+            key[1] |= static_cast<u16>(largest >> 1);
+            return key;
+        }
+
+        glm::quat DecodeRotation(const QuantizedKey& key) {
+            const u32 largest = (key[0] & 1) | (key[1] & 1) << 1;
+
+            std::array<f32, 3> values;
+            f32 squaredLength = 0.0f;
+            for (u32 i = 0; i < 3; i++) {
+                values[i] = static_cast<f32>(key[i] >> 1) * RotationStepSize - RotationRange;
+                squaredLength += values[i] * values[i];
+            }
+
+            glm::quat result;
+            u32 next = 0;
+            for (u32 component = 0; component < 4; component++) {
+                result[component] = component == largest ? std::sqrt(std::max(0.0f, 1.0f - squaredLength))
+                                                         : values[next++];
+            }
+
+            return result;
+        }
+
+        // 2 * atan2(|a - b|, |a + b|) rather than 2 * acos(|a . b|): near a dot product of 1, rounding in the
+        // components alone would read as errors of a thousandth of a radian.
+        f32 GetRotationError(const glm::quat& lhs, const glm::quat& rhs) {
+            f64 dot = 0.0;
+            for (u32 component = 0; component < 4; component++) {
+                dot += static_cast<f64>(lhs[component]) * static_cast<f64>(rhs[component]);
+            }
+
+            const f64 sign = dot < 0.0 ? -1.0 : 1.0;
+            f64 difference = 0.0;
+            f64 sum = 0.0;
+            for (u32 component = 0; component < 4; component++) {
+                const f64 a = lhs[component];
+                const f64 b = rhs[component] * sign;
+                difference += (a - b) * (a - b);
+                sum += (a + b) * (a + b);
+            }
+
+            return static_cast<f32>(2.0 * std::atan2(std::sqrt(difference), std::sqrt(sum)));
+        }
+
+        glm::quat InterpolateRotation(const glm::quat& lhs, const glm::quat& rhs, const f32 weight) {
+            const f32 rhsWeight = glm::dot(lhs, rhs) < 0.0f ? -weight : weight;
+            return glm::normalize(lhs * (1.0f - weight) + rhs * rhsWeight);
+        }
+
+        f32 GetVectorError(const glm::vec3& lhs, const glm::vec3& rhs) {
+            const glm::vec3 difference = glm::abs(lhs - rhs);
+            return std::max(difference.x, std::max(difference.y, difference.z));
+        }
+
+        /*
+         * Frames to keep so that interpolating between the kept ones stays within tolerance of every frame. Greedy:
+         * from each kept frame, the next one is the farthest the segment can reach. fits(first, last, frame) checks
+         * one frame of the segment, first and last may be equal. Adjacent frames always make a segment, the bound
+         * only holds if every key is itself within tolerance of its frame.
+         */
+        template <typename Fits>
+        std::vector<u32> SelectKeyFrames(const u32 frameCount, const Fits& fits) {
+            std::vector<u32> keys{0};
+
+            bool constant = true;
+            for (u32 frame = 1; frame < frameCount && constant; frame++) {
+                constant = fits(0, 0, frame);
+            }
+
+            if (constant) {
+                return keys;
+            }
+
+            const u32 lastFrame = frameCount - 1;
+            u32 start = 0;
+            while (start < lastFrame) {
+                u32 end = start + 1;
+                while (end < lastFrame) {
+                    const u32 candidate = end + 1;
+
+                    bool segmentFits = true;
+                    for (u32 frame = start + 1; frame < candidate && segmentFits; frame++) {
+                        segmentFits = fits(start, candidate, frame);
+                    }
+
+                    if (!segmentFits) {
+                        break;
+                    }
+
+                    end = candidate;
+                }
+
+                keys.push_back(end);
+                start = end;
+            }
+
+            return keys;
+        }
+
+        f32 GetSegmentWeight(const u32 first, const u32 last, const u32 frame) {
+            return first == last ? 0.0f : static_cast<f32>(frame - first) / static_cast<f32>(last - first);
+        }
+
+        void CompressVectorTrack(const RawAnimation& raw, const u32 joint, const ClipChannel channel,
+                                 const f32 tolerance, ClipChannelData& result) {
+            const auto getValue = [&raw, joint, channel](const u32 frame) {
+                const JointTransform& sample = raw.GetSample(frame, joint);
+                return channel == ClipChannel::Translation ? sample.Translation : sample.Scale;
+            };
+
+            ClipTrack track;
+            glm::vec3 maximum = getValue(0);
+            track.Minimum = maximum;
+            for (u32 frame = 1; frame < raw.FrameCount; frame++) {
+                track.Minimum = glm::min(track.Minimum, getValue(frame));
+                maximum = glm::max(maximum, getValue(frame));
+            }
+            track.Extent = maximum - track.Minimum;
+
+            // Keys are interpolated as the runtime will see them, so the tolerance covers quantization too.
+            std::vector<QuantizedKey> keys(raw.FrameCount);
+            std::vector<glm::vec3> decoded(raw.FrameCount);
+            for (u32 frame = 0; frame < raw.FrameCount; frame++) {
+                keys[frame] = EncodeVector(getValue(frame), track);
+                decoded[frame] = DecodeVector(keys[frame], track);
+                track.Raw |= GetVectorError(decoded[frame], getValue(frame)) > tolerance;
+            }
+
+            // A step of the range is more than twice the tolerance, the keys themselves would be out of it.
+            if (track.Raw) {
+                track.Minimum = glm::vec3(0.0f);
+                track.Extent = glm::vec3(0.0f);
+                for (u32 frame = 0; frame < raw.FrameCount; frame++) {
+                    decoded[frame] = getValue(frame);
+                }
+            }
+
+            const std::vector<u32> keyFrames = SelectKeyFrames(raw.FrameCount, [&](const u32 first, const u32 last,
+                                                                                   const u32 frame) {
+                const glm::vec3 value = glm::mix(decoded[first], decoded[last], GetSegmentWeight(first, last, frame));
+                return GetVectorError(value, getValue(frame)) <= tolerance;
+            });
+
+            track.FirstKey = static_cast<u32>(track.Raw ? result.RawKeys.size() : result.Keys.size());
+            track.KeyCount = static_cast<u32>(keyFrames.size());
+            for (const u32 frame : keyFrames) {
+                if (track.Raw) {
+                    result.RawKeyFrames.push_back(static_cast<u16>(frame));
+                    result.RawKeys.push_back(decoded[frame]);
+                } else {
+                    result.KeyFrames.push_back(static_cast<u16>(frame));
+                    result.Keys.push_back(keys[frame]);
+                }
+            }
+
+            result.Tracks.push_back(track);
+        }
+
+        void CompressRotationTrack(const RawAnimation& raw, const u32 joint, const f32 tolerance,
+                                   ClipChannelData& result) {
+            std::vector<QuantizedKey> keys(raw.FrameCount);
+            std::vector<glm::quat> decoded(raw.FrameCount);
+            f32 quantizationError = 0.0f;
+            for (u32 frame = 0; frame < raw.FrameCount; frame++) {
+                keys[frame] = EncodeRotation(raw.GetSample(frame, joint).Rotation);
+                decoded[frame] = DecodeRotation(keys[frame]);
+                quantizationError = std::max(quantizationError,
+                                             GetRotationError(decoded[frame], raw.GetSample(frame, joint).Rotation));
+            }
+
+            if (quantizationError > tolerance) {
+                Log::EngineWarn(fmt::format("Rotations of joint {0} are quantized to {1} radians, over the tolerance "
+                                            "of {2}.", joint, quantizationError, tolerance));
+            }
+
+            const std::vector<u32> keyFrames = SelectKeyFrames(raw.FrameCount, [&](const u32 first, const u32 last,
+                                                                                   const u32 frame) {
+                const glm::quat value = InterpolateRotation(decoded[first], decoded[last],
+                                                            GetSegmentWeight(first, last, frame));
+                return GetRotationError(value, raw.GetSample(frame, joint).Rotation) <= tolerance;
+            });
+
+            ClipTrack track;
+            track.FirstKey = static_cast<u32>(result.Keys.size());
+            track.KeyCount = static_cast<u32>(keyFrames.size());
+            for (const u32 frame : keyFrames) {
+                result.KeyFrames.push_back(static_cast<u16>(frame));
+                result.Keys.push_back(keys[frame]);
+            }
+
+            result.Tracks.push_back(track);
+        }
+
+        // Quantized keys on both sides of the sampled frame for every lane of a packet, as floats so they decode and
+        // interpolate PoseWidth lanes at a time.
+        struct KeyPairs {
+            std::array<std::array<f32, PoseWidth>, 3> Left;
+            std::array<std::array<f32, PoseWidth>, 3> Right;
+            std::array<f32, PoseWidth> Weights;
+
+            // Per track ranges of translations and scales, index of the largest component of rotations.
+            std::array<std::array<f32, PoseWidth>, 3> Minimum;
+            std::array<std::array<f32, PoseWidth>, 3> Extent;
+            std::array<f32, PoseWidth> LeftLargest;
+            std::array<f32, PoseWidth> RightLargest;
+        };
+
+        /*
+         * Last key at or before the frame. Keys are on distinct frames, so key k is at least on frame k and at most on
+         * frame k + dropped, dropped being the frames the track has no key for: only the keys in between need a search,
+         * few of them for tracks with many keys. The search is branchless, its steps go either way at random.
+         */
+        u32 FindLeftKey(const u16* frames, const u32 keyCount, const f32 frame) {
+            const u32 whole = static_cast<u32>(frame);
+            const u32 dropped = frames[keyCount - 1] - (keyCount - 1);
+            const u32 last = std::min(whole, keyCount - 1);
+            const u32 first = std::min(whole > dropped ? whole - dropped : 0, last);
+
+            const u16* base = frames + first;
+            for (u32 count = last - first + 1; count > 1;) {
+                const u32 half = count / 2;
+                base = static_cast<f32>(base[half]) <= frame ? base + half : base;
+                count -= half;
+            }
+
+            return static_cast<u32>(base - frames);
+        }
+
+        void GatherKeys(const ClipChannelData& channel, const ClipChannel type, const u32 firstJoint,
+                        const u32 laneCount, const f32 frame, KeyPairs& pairs) {
+            for (u32 lane = 0; lane < laneCount; lane++) {
+                const ClipTrack& track = channel.Tracks[firstJoint + lane];
+                const u16* frames = (track.Raw ? channel.RawKeyFrames : channel.KeyFrames).data() + track.FirstKey;
+
+                const u32 left = FindLeftKey(frames, track.KeyCount, frame);
+                const u32 right = std::min(left + 1, track.KeyCount - 1);
+
+                const f32 span = static_cast<f32>(frames[right]) - static_cast<f32>(frames[left]);
+                pairs.Weights[lane] = span > 0.0f ? std::min((frame - frames[left]) / span, 1.0f) : 0.0f;
+
+                if (track.Raw) {
+                    // Decoded as Minimum + value / 65535 * Extent like the others, to the value itself.
+                    const glm::vec3& leftKey = channel.RawKeys[track.FirstKey + left];
+                    const glm::vec3& rightKey = channel.RawKeys[track.FirstKey + right];
+                    for (u32 component = 0; component < 3; component++) {
+                        pairs.Left[component][lane] = leftKey[component];
+                        pairs.Right[component][lane] = rightKey[component];
+                        pairs.Minimum[component][lane] = 0.0f;
+                        pairs.Extent[component][lane] = VectorSteps;
+                    }
+
+                    continue;
+                }
+
+                const QuantizedKey& leftKey = channel.Keys[track.FirstKey + left];
+                const QuantizedKey& rightKey = channel.Keys[track.FirstKey + right];
+                if (type == ClipChannel::Rotation) {
+                    // The lowest bits hold the index of the largest component, the values are above them.
+                    for (u32 component = 0; component < 3; component++) {
+                        pairs.Left[component][lane] = static_cast<f32>(leftKey[component] >> 1);
+                        pairs.Right[component][lane] = static_cast<f32>(rightKey[component] >> 1);
+                    }
+
+                    pairs.LeftLargest[lane] = static_cast<f32>((leftKey[0] & 1) | (leftKey[1] & 1) << 1);
+                    pairs.RightLargest[lane] = static_cast<f32>((rightKey[0] & 1) | (rightKey[1] & 1) << 1);
+                } else {
+                    for (u32 component = 0; component < 3; component++) {
+                        pairs.Left[component][lane] = leftKey[component];
+                        pairs.Right[component][lane] = rightKey[component];
+                        pairs.Minimum[component][lane] = track.Minimum[component];
+                        pairs.Extent[component][lane] = track.Extent[component];
+                    }
+                }
+            }
+        }
+
+        Vec3x8 DecodeVectors(const std::array<std::array<f32, PoseWidth>, 3>& keys, const KeyPairs& pairs) {
+            const auto decode = [&keys, &pairs](const u32 component, std::array<f32, PoseWidth>& values) {
+                for (u32 lane = 0; lane < PoseWidth; lane++) {
+                    values[lane] = pairs.Minimum[component][lane] +
+                                   keys[component][lane] * (pairs.Extent[component][lane] / VectorSteps);
+                }
+            };
+
+            Vec3x8 result;
+            decode(0, result.X);
+            decode(1, result.Y);
+            decode(2, result.Z);
+            return result;
+        }
+
+        Quatx8 DecodeRotations(const std::array<std::array<f32, PoseWidth>, 3>& keys,
+                               const std::array<f32, PoseWidth>& largest) {
+            Quatx8 result;
+            for (u32 lane = 0; lane < PoseWidth; lane++) {
+                const f32 a = keys[0][lane] * RotationStepSize - RotationRange;
+                const f32 b = keys[1][lane] * RotationStepSize - RotationRange;
+                const f32 c = keys[2][lane] * RotationStepSize - RotationRange;
+                const f32 m = std::sqrt(std::max(0.0f, 1.0f - a * a - b * b - c * c));
+
+                const f32 index = largest[lane];
+                result.X[lane] = index == 0.0f ? m : a;
+                result.Y[lane] = index == 0.0f ? a : (index == 1.0f ? m : b);
+                result.Z[lane] = index <= 1.0f ? b : (index == 2.0f ? m : c);
+                result.W[lane] = index == 3.0f ? m : c;
+            }
+
+            return result;
+        }
+
+        // Lanes past the last joint decode to transforms close to identity, their values are never read.
+        void ResetKeys(KeyPairs& pairs, const ClipChannel channel) {
+            const f32 vectorValue = channel == ClipChannel::Scale ? 1.0f : 0.0f;
+            const f32 rotationMiddle = std::floor(RotationSteps * 0.5f + 0.5f);
+
+            for (u32 component = 0; component < 3; component++) {
+                pairs.Left[component].fill(channel == ClipChannel::Rotation ? rotationMiddle : 0.0f);
+                pairs.Right[component] = pairs.Left[component];
+                pairs.Minimum[component].fill(vectorValue);
+                pairs.Extent[component].fill(0.0f);
+            }
+
+            pairs.Weights.fill(0.0f);
+            pairs.LeftLargest.fill(3.0f);
+            pairs.RightLargest.fill(3.0f);
+        }
+    }
+
+    u64 AnimationClip::GetMemorySize() const {
+        u64 size = 0;
+        for (const ClipChannelData& channel : Channels) {
+            size += channel.Tracks.size() * sizeof(ClipTrack) + channel.KeyFrames.size() * sizeof(u16) +
+                    channel.Keys.size() * sizeof(QuantizedKey) + channel.RawKeyFrames.size() * sizeof(u16) +
+                    channel.RawKeys.size() * sizeof(glm::vec3);
+        }
+
+        return size;
+    }
+
+    AnimationClip CompressAnimation(const RawAnimation& raw, const ClipCompressionSettings& settings) {
+        FL_PROFILE_ZONE("CompressAnimation");
+
+        assert(raw.FrameCount > 0 && raw.FrameCount <= 65536 && "Frame count out of range.");
+        assert(raw.Samples.size() == static_cast<u64>(raw.FrameCount) * raw.JointCount && "Missing samples.");
+
+        AnimationClip clip;
+        clip.SampleRate = raw.SampleRate;
+        clip.Duration = raw.GetDuration();
+        clip.JointCount = raw.JointCount;
+
+        ClipChannelData& translations = clip.Channels[static_cast<u32>(ClipChannel::Translation)];
+        ClipChannelData& rotations = clip.Channels[static_cast<u32>(ClipChannel::Rotation)];
+        ClipChannelData& scales = clip.Channels[static_cast<u32>(ClipChannel::Scale)];
+        for (u32 joint = 0; joint < raw.JointCount; joint++) {
+            CompressVectorTrack(raw, joint, ClipChannel::Translation, settings.TranslationTolerance, translations);
+            CompressRotationTrack(raw, joint, settings.RotationTolerance, rotations);
+            CompressVectorTrack(raw, joint, ClipChannel::Scale, settings.ScaleTolerance, scales);
+        }
+
+        return clip;
+    }
+
+    ClipError MeasureClipError(const AnimationClip& clip, const RawAnimation& raw) {
+        assert(clip.JointCount == raw.JointCount && "The clip wasn't compressed from this animation.");
+
+        ClipError error;
+        Pose pose;
+        for (u32 frame = 0; frame < raw.FrameCount; frame++) {
+            SampleAnimation(clip, static_cast<f32>(frame) / raw.SampleRate, pose);
+
+            for (u32 joint = 0; joint < raw.JointCount; joint++) {
+                const JointTransform sampled = pose.GetJoint(joint);
+                const JointTransform& source = raw.GetSample(frame, joint);
+                error.Translation = std::max(error.Translation,
+                                             GetVectorError(sampled.Translation, source.Translation));
+                error.Rotation = std::max(error.Rotation, GetRotationError(sampled.Rotation, source.Rotation));
+                error.Scale = std::max(error.Scale, GetVectorError(sampled.Scale, source.Scale));
+            }
+        }
+
+        return error;
+    }
+
+    void SampleAnimation(const AnimationClip& clip, const f32 time, Pose& result) {
+        if (result.JointCount != clip.JointCount) {
+            result.Resize(clip.JointCount);
+        }
+
+        const f32 frame = std::clamp(time, 0.0f, clip.Duration) * clip.SampleRate;
+
+        KeyPairs pairs;
+        for (u32 packet = 0; packet < result.Packets.size(); packet++) {
+            const u32 firstJoint = packet * PoseWidth;
+            const u32 laneCount = std::min(PoseWidth, clip.JointCount - firstJoint);
+            SoaTransform& out = result.Packets[packet];
+
+            for (const ClipChannel channel : {ClipChannel::Translation, ClipChannel::Rotation, ClipChannel::Scale}) {
+                if (laneCount < PoseWidth) {
+                    ResetKeys(pairs, channel);
+                }
+
+                GatherKeys(clip.GetChannel(channel), channel, firstJoint, laneCount, frame, pairs);
+
+                if (channel == ClipChannel::Rotation) {
+                    out.Rotation = Nlerp(DecodeRotations(pairs.Left, pairs.LeftLargest),
+                                         DecodeRotations(pairs.Right, pairs.RightLargest), pairs.Weights);
+                    continue;
+                }
+
+                const Vec3x8 left = DecodeVectors(pairs.Left, pairs);
+                const Vec3x8 right = DecodeVectors(pairs.Right, pairs);
+
+                Vec3x8& value = channel == ClipChannel::Translation ? out.Translation : out.Scale;
+                for (u32 lane = 0; lane < PoseWidth; lane++) {
+                    const f32 weight = pairs.Weights[lane];
+                    value.X[lane] = left.X[lane] + (right.X[lane] - left.X[lane]) * weight;
+                    value.Y[lane] = left.Y[lane] + (right.Y[lane] - left.Y[lane]) * weight;
+                    value.Z[lane] = left.Z[lane] + (right.Z[lane] - left.Z[lane]) * weight;
+                }
+            }
+        }
+    }
+}
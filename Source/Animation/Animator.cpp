@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Animation/Animator.hpp>
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+namespace Flashlight {
+    namespace {
+        // A few microseconds of work per character, enough of them per job to hide the scheduling.
+        constexpr u32 CharactersPerJob = 16;
+
+        struct EvaluationPoses {
+            Pose Result;
+            Pose Layer;
+        };
+
+        EvaluationPoses& GetEvaluationPoses() {
+            thread_local EvaluationPoses poses;
+            return poses;
+        }
+    }
+
+    void EvaluateCharacter(const CharacterAnimation& character) {
+        assert(character.SkeletonRef != nullptr && "The character has no skeleton.");
+
+        const Skeleton& skeleton = *character.SkeletonRef;
+        EvaluationPoses& poses = GetEvaluationPoses();
+        Pose& pose = poses.Result;
+
+        // The bind pose only shows through when no layer replaces it.
+        const bool replaced = !character.Layers.empty() && character.Layers[0].Clip != nullptr &&
+                              character.Layers[0].Mode == AnimationBlendMode::Blend &&
+                              character.Layers[0].Weight >= 1.0f;
+        if (!replaced) {
+            pose.Resize(skeleton.GetJointCount());
+            const std::span<const JointTransform> bindPose = skeleton.GetBindPose();
+            for (u32 joint = 0; joint < bindPose.size(); joint++) {
+                pose.SetJoint(joint, bindPose[joint]);
+            }
+        }
+
+        for (const AnimationLayer& layer : character.Layers) {
+            if (layer.Clip == nullptr || layer.Weight <= 0.0f) {
+                continue;
+            }
+
+            assert(layer.Clip->JointCount == skeleton.GetJointCount() && "The clip isn't one of this skeleton.");
+
+            if (layer.Mode == AnimationBlendMode::Blend && layer.Weight >= 1.0f) {
+                SampleAnimation(*layer.Clip, layer.Time, pose);
+                continue;
+            }
+
+            SampleAnimation(*layer.Clip, layer.Time, poses.Layer);
+            if (layer.Mode == AnimationBlendMode::Blend) {
+                BlendPoses(pose, poses.Layer, layer.Weight, pose);
+            } else {
+                AddPose(pose, poses.Layer, layer.Weight, pose);
+            }
+        }
+
+        ComputeModelMatrices(skeleton, pose, character.ModelMatrices, character.Root);
+    }
+
+    void EvaluateCharacters(const std::span<const CharacterAnimation> characters, JobSystem* jobs) {
+        FL_PROFILE_ZONE("EvaluateCharacters");
+
+        const auto evaluate = [characters](const u32 begin, const u32 end) {
+            for (u32 character = begin; character < end; character++) {
+                EvaluateCharacter(characters[character]);
+            }
+        };
+
+        if (jobs != nullptr) {
+            jobs->ParallelFor(static_cast<u32>(characters.size()), CharactersPerJob, evaluate);
+        } else {
+            evaluate(0, static_cast<u32>(characters.size()));
+        }
+    }
+}
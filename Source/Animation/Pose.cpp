@@ -0,0 +1,195 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Animation/Pose.hpp>
+
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <algorithm>
+
+namespace Flashlight {
+    namespace {
+        // Sizes result like input unless it already is, so an input can also be the result.
+        void PrepareResult(const Pose& input, Pose& result) {
+            if (result.JointCount != input.JointCount || result.Packets.size() != input.Packets.size()) {
+                result.Resize(input.JointCount);
+            }
+        }
+
+        // translate(translation) * mat4_cast(rotation) * scale(scale) of every lane, the last row is (0, 0, 0, 1).
+        Mat4x8 ComposeLocalMatrices(const SoaTransform& transform) {
+            const Vec3x8& t = transform.Translation;
+            const Quatx8& r = transform.Rotation;
+            const Vec3x8& s = transform.Scale;
+
+            Mat4x8 result;
+            for (u32 lane = 0; lane < PoseWidth; lane++) {
+                const f32 xx = r.X[lane] * r.X[lane], yy = r.Y[lane] * r.Y[lane], zz = r.Z[lane] * r.Z[lane];
+                const f32 xy = r.X[lane] * r.Y[lane], xz = r.X[lane] * r.Z[lane], yz = r.Y[lane] * r.Z[lane];
+                const f32 wx = r.W[lane] * r.X[lane], wy = r.W[lane] * r.Y[lane], wz = r.W[lane] * r.Z[lane];
+
+                result.M[0][lane] = (1.0f - 2.0f * (yy + zz)) * s.X[lane];
+                result.M[1][lane] = 2.0f * (xy + wz) * s.X[lane];
+                result.M[2][lane] = 2.0f * (xz - wy) * s.X[lane];
+                result.M[3][lane] = 0.0f;
+                result.M[4][lane] = 2.0f * (xy - wz) * s.Y[lane];
+                result.M[5][lane] = (1.0f - 2.0f * (xx + zz)) * s.Y[lane];
+                result.M[6][lane] = 2.0f * (yz + wx) * s.Y[lane];
+                result.M[7][lane] = 0.0f;
+                result.M[8][lane] = 2.0f * (xz + wy) * s.Z[lane];
+                result.M[9][lane] = 2.0f * (yz - wx) * s.Z[lane];
+                result.M[10][lane] = (1.0f - 2.0f * (xx + yy)) * s.Z[lane];
+                result.M[11][lane] = 0.0f;
+                result.M[12][lane] = t.X[lane];
+                result.M[13][lane] = t.Y[lane];
+                result.M[14][lane] = t.Z[lane];
+                result.M[15][lane] = 1.0f;
+            }
+
+            return result;
+        }
+
+        // parent * local, with local affine: each column is three parent columns weighted by the local one, plus the
+        // parent translation for the last column. 48 multiplies per lane instead of 64.
+        Mat4x8 MultiplyByAffine(const Mat4x8& parent, const Mat4x8& local) {
+            Mat4x8 result;
+            for (u32 column = 0; column < 4; column++) {
+                const std::array<f32, PoseWidth>& c0 = local.M[column * 4];
+                const std::array<f32, PoseWidth>& c1 = local.M[column * 4 + 1];
+                const std::array<f32, PoseWidth>& c2 = local.M[column * 4 + 2];
+
+                for (u32 row = 0; row < 4; row++) {
+                    const std::array<f32, PoseWidth>& p0 = parent.M[row];
+                    const std::array<f32, PoseWidth>& p1 = parent.M[4 + row];
+                    const std::array<f32, PoseWidth>& p2 = parent.M[8 + row];
+                    const std::array<f32, PoseWidth>& p3 = parent.M[12 + row];
+
+                    std::array<f32, PoseWidth>& out = result.M[column * 4 + row];
+                    for (u32 lane = 0; lane < PoseWidth; lane++) {
+                        out[lane] = p0[lane] * c0[lane] + p1[lane] * c1[lane] + p2[lane] * c2[lane];
+                    }
+
+                    if (column == 3) {
+                        for (u32 lane = 0; lane < PoseWidth; lane++) {
+                            out[lane] += p3[lane];
+                        }
+                    }
+                }
+            }
+
+            return result;
+        }
+    }
+
+    Pose Pose::FromBindPose(const Skeleton& skeleton) {
+        Pose result;
+        result.Resize(skeleton.GetJointCount());
+
+        const std::span<const JointTransform> bindPose = skeleton.GetBindPose();
+        for (u32 joint = 0; joint < bindPose.size(); joint++) {
+            result.SetJoint(joint, bindPose[joint]);
+        }
+
+        return result;
+    }
+
+    void BlendPoses(const Pose& a, const Pose& b, const f32 weight, Pose& result) {
+        assert(a.JointCount == b.JointCount && "Poses of different skeletons.");
+
+        PrepareResult(a, result);
+
+        std::array<f32, PoseWidth> weights;
+        weights.fill(weight);
+
+        for (u32 packet = 0; packet < a.Packets.size(); packet++) {
+            const SoaTransform& lhs = a.Packets[packet];
+            const SoaTransform& rhs = b.Packets[packet];
+            SoaTransform& out = result.Packets[packet];
+
+            out.Translation = MultiplyAdd(lhs.Translation, rhs.Translation - lhs.Translation, weight);
+            out.Rotation = Nlerp(lhs.Rotation, rhs.Rotation, weights);
+            out.Scale = MultiplyAdd(lhs.Scale, rhs.Scale - lhs.Scale, weight);
+        }
+    }
+
+    void AddPose(const Pose& base, const Pose& additive, const f32 weight, Pose& result) {
+        assert(base.JointCount == additive.JointCount && "Poses of different skeletons.");
+
+        PrepareResult(base, result);
+
+        std::array<f32, PoseWidth> weights;
+        weights.fill(weight);
+
+        const Quatx8 identity = Quatx8::Splat(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        const Vec3x8 one = Vec3x8::Splat(glm::vec3(1.0f));
+
+        for (u32 packet = 0; packet < base.Packets.size(); packet++) {
+            const SoaTransform& lhs = base.Packets[packet];
+            const SoaTransform& rhs = additive.Packets[packet];
+            SoaTransform& out = result.Packets[packet];
+
+            out.Translation = MultiplyAdd(lhs.Translation, rhs.Translation, weight);
+            out.Rotation = Normalize(lhs.Rotation * Nlerp(identity, rhs.Rotation, weights));
+            out.Scale = lhs.Scale * MultiplyAdd(one, rhs.Scale - one, weight);
+        }
+    }
+
+    void ComputeAdditivePose(const Pose& pose, const Pose& reference, Pose& result) {
+        assert(pose.JointCount == reference.JointCount && "Poses of different skeletons.");
+
+        PrepareResult(pose, result);
+
+        for (u32 packet = 0; packet < pose.Packets.size(); packet++) {
+            const SoaTransform& lhs = pose.Packets[packet];
+            const SoaTransform& rhs = reference.Packets[packet];
+            SoaTransform& out = result.Packets[packet];
+
+            Vec3x8 scale;
+            for (u32 lane = 0; lane < PoseWidth; lane++) {
+                scale.X[lane] = lhs.Scale.X[lane] / rhs.Scale.X[lane];
+                scale.Y[lane] = lhs.Scale.Y[lane] / rhs.Scale.Y[lane];
+                scale.Z[lane] = lhs.Scale.Z[lane] / rhs.Scale.Z[lane];
+            }
+
+            out.Translation = lhs.Translation - rhs.Translation;
+            out.Rotation = Conjugate(rhs.Rotation) * lhs.Rotation;
+            out.Scale = scale;
+        }
+    }
+
+    void ComputeModelMatrices(const Skeleton& skeleton, const Pose& pose, const std::span<glm::mat4> models,
+                              const glm::mat4& root) {
+        FL_PROFILE_ZONE("ComputeModelMatrices");
+
+        const u32 jointCount = skeleton.GetJointCount();
+        assert(pose.JointCount == jointCount && "The pose isn't one of this skeleton.");
+        assert(models.size() >= jointCount && "Not enough model matrices.");
+
+        const std::span<const u32> parents = skeleton.GetParentIndices();
+        Mat4x8 parentMatrices = Mat4x8::Splat(root);
+
+        for (u32 packet = 0; packet < skeleton.GetPacketCount(); packet++) {
+            const Mat4x8 local = ComposeLocalMatrices(pose.Packets[packet]);
+            const u32 first = packet * PoseWidth;
+            const u32 laneCount = std::min(PoseWidth, jointCount - first);
+            const u8 localParents = skeleton.GetPacketLocalParents(packet);
+
+            // Lanes whose parent isn't computed yet get a placeholder, they are redone below.
+            for (u32 lane = 0; lane < laneCount; lane++) {
+                const u32 parent = parents[first + lane];
+                const bool ready = parent != InvalidJoint && !(localParents & 1u << lane);
+                parentMatrices.Set(lane, ready ? models[parent] : root);
+            }
+
+            MultiplyByAffine(parentMatrices, local).Store(models.subspan(first, laneCount));
+
+            // Lanes come in order, a parent in the packet is always done before its children.
+            for (u32 lane = 0; lane < laneCount && localParents >> lane != 0; lane++) {
+                if (localParents & 1u << lane) {
+                    models[first + lane] = models[parents[first + lane]] * local.Get(lane);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Animation/Skeleton.hpp>
+
+namespace Flashlight {
+    static_assert(PoseWidth <= 8, "The lanes of a packet are tracked in a byte.");
+
+    Skeleton::Skeleton(const std::span<const SkeletonJoint> joints) {
+        const u32 count = static_cast<u32>(joints.size());
+
+        // Children of every joint, grouped by parent in source order.
+        std::vector<u32> childOffsets(count + 1, 0);
+        for (const SkeletonJoint& joint : joints) {
+            assert((joint.Parent == InvalidJoint || joint.Parent < count) && "Parent joint out of range.");
+            if (joint.Parent != InvalidJoint) {
+                childOffsets[joint.Parent + 1]++;
+            }
+        }
+        for (u32 index = 0; index < count; index++) {
+            childOffsets[index + 1] += childOffsets[index];
+        }
+
+        std::vector<u32> children(childOffsets[count]);
+        std::vector<u32> nextChild(childOffsets.begin(), childOffsets.end() - 1);
+        for (u32 index = 0; index < count; index++) {
+            if (joints[index].Parent != InvalidJoint) {
+                children[nextChild[joints[index].Parent]++] = index;
+            }
+        }
+
+        m_SourceIndices.reserve(count);
+        for (u32 index = 0; index < count; index++) {
+            if (joints[index].Parent == InvalidJoint) {
+                m_SourceIndices.push_back(index);
+            }
+        }
+
+        for (u32 next = 0; next < m_SourceIndices.size(); next++) {
+            const u32 index = m_SourceIndices[next];
+            for (u32 child = childOffsets[index]; child < childOffsets[index + 1]; child++) {
+                m_SourceIndices.push_back(children[child]);
+            }
+        }
+
+        assert(m_SourceIndices.size() == count && "The joint hierarchy has a cycle.");
+
+        std::vector<u32> newIndices(count);
+        for (u32 joint = 0; joint < count; joint++) {
+            newIndices[m_SourceIndices[joint]] = joint;
+        }
+
+        m_Names.reserve(count);
+        m_ParentIndices.reserve(count);
+        m_BindPose.reserve(count);
+        for (const u32 source : m_SourceIndices) {
+            const SkeletonJoint& joint = joints[source];
+            m_Names.push_back(joint.Name);
+            m_ParentIndices.push_back(joint.Parent == InvalidJoint ? InvalidJoint : newIndices[joint.Parent]);
+            m_BindPose.push_back(joint.BindPose);
+        }
+
+        const u32 packetCount = (count + PoseWidth - 1) / PoseWidth;
+        m_PacketLocalParents.assign(packetCount, 0);
+        for (u32 joint = 0; joint < count; joint++) {
+            const u32 parent = m_ParentIndices[joint];
+            if (parent != InvalidJoint && parent / PoseWidth == joint / PoseWidth) {
+                m_PacketLocalParents[joint / PoseWidth] |= static_cast<u8>(1u << joint % PoseWidth);
+            }
+        }
+    }
+
+    u32 Skeleton::FindJoint(const std::string_view name) const {
+        for (u32 joint = 0; joint < GetJointCount(); joint++) {
+            if (m_Names[joint] == name) {
+                return joint;
+            }
+        }
+
+        return InvalidJoint;
+    }
+}
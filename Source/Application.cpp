@@ -5,24 +5,33 @@
 #include <FlashlightEngine/Application.hpp>
 
 #include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
 
 #include <imgui.h>
 
+#include <cmath>
+#include <fstream>
+
 namespace Flashlight {    
     Application* Application::m_SLoadedApplication = nullptr;
 
-    Application::Application(const WindowProperties& windowProperties) {
+    Application::Application(const WindowProperties& windowProperties, const LoggerSettings& loggerSettings) {
         assert(!m_SLoadedApplication && "Only one instance of this application can run at a time.");
         m_SLoadedApplication = this;
         
-        Logger::Init();
-
-        m_Window = std::make_unique<Window>(windowProperties);
-        m_Window->SetEventCallback([this](Event& event) {
-            EventDispatcher dispatcher(event);
-            dispatcher.Dispatch<WindowCloseEvent>(BIND_EVENT_TO_EVENT_HANDLER(Application::OnWindowClose));
-            OnEvent(event);
-        });
+        Profiler::Init();
+        Logger::Init(loggerSettings);
+
+        m_JobSystem = std::make_unique<JobSystem>();
+
+        AssetManagerSettings assetManagerSettings;
+        assetManagerSettings.Jobs = m_JobSystem.get();
+        m_AssetManager = std::make_unique<AssetManager>(assetManagerSettings);
+
+        m_EventHandlers.Register<WindowCloseEvent, &Application::OnWindowClose>(this);
+
+        m_Window = Window::Create(windowProperties);
+        m_Window->SetEventCallback(BIND_EVENT_TO_EVENT_HANDLER(Application::OnWindowEvent));
         
         m_IsRunning = true;
         
@@ -31,27 +40,223 @@ namespace Flashlight {
 
     Application::~Application() {
         Log::EditorInfo("Quitting application.");
+
+        StopRecording();
+
+        // Components may still use engine services when they are destroyed.
+        m_Scene.Clear();
+
+        m_Window.reset();
+        m_AssetManager.reset();
+        m_JobSystem.reset();
+        Logger::Shutdown();
+        Profiler::Shutdown();
         
         m_SLoadedApplication = nullptr;
     }
 
     void Application::Run() {
+        using Clock = std::chrono::steady_clock;
+
+        m_CurrentTime = m_Window->GetTime();
+        m_Accumulator = 0.0;
+
         while (m_IsRunning) {
+            m_InFrame = true;
+            const auto frameStart = Clock::now();
+            Profiler::BeginFrame();
+
+            m_FrameArena.BeginFrame();
+
+            const ArenaStatistics& frameAllocations = m_FrameArena.GetLastFrameStatistics();
+            m_EngineStats.FrameAllocatedBytes = frameAllocations.AllocatedBytes;
+            m_EngineStats.FrameAllocationCount = frameAllocations.AllocationCount;
+            m_EngineStats.FrameArenaOverflowCount = frameAllocations.OverflowCount;
+
+            // Culling passes of this frame add to them, see CullingSettings::Stats.
+            m_EngineStats.TriangleCount = 0;
+            m_EngineStats.DrawCallCount = 0;
+            m_EngineStats.VisibleObjectCount = 0;
+            m_EngineStats.CulledObjectCount = 0;
+
+            // A replay started during the previous frame takes over from this frame on.
+            const bool replaying = m_Replay != nullptr;
+
             m_Window->Update();
-            
-            // Compute delta time.
-            const auto oldTime = m_CurrentTime;
-            m_CurrentTime = std::chrono::high_resolution_clock::now();
+            m_Window->DispatchEvents();
+
+            if (replaying) {
+                m_Replay->DispatchFrame(m_FrameIndex - m_ReplayStartFrame,
+                                        BIND_EVENT_TO_EVENT_HANDLER(Application::DispatchEvent));
+            }
 
-            const std::chrono::duration<double, std::milli> timeSpan = (m_CurrentTime - oldTime);
-            m_DeltaTime = static_cast<f32>(timeSpan.count()) / 1000.0f;
+            m_EventBus.Drain(BIND_EVENT_TO_EVENT_HANDLER(Application::DispatchEvent));
+            m_Input.Publish();
 
-            m_EngineStats.FrameTime = m_DeltaTime;
+            m_AssetManager->Update();
             
+            // Compute delta time with the window clock, which is a virtual one for headless windows.
+            const f64 windowTime = m_Window->GetTime();
+            const f32 frameTime = replaying ? m_ReplaySettings.DeltaTime : static_cast<f32>(windowTime - m_CurrentTime);
+            m_CurrentTime = windowTime;
+
+            m_EngineStats.FrameTime = frameTime;
+
+            const f32 interpolationAlpha = Simulate(frameTime);
+
+            {
+                FL_PROFILE_ZONE("Application::OnRender");
+                OnRender(interpolationAlpha);
+            }
+
+            // Frame pacing, a window in the background doesn't need more than a few frames per second.
+            const bool inBackground = !m_Window->IsFocused() || m_Window->IsIconified();
+            const f32 frameRate = inBackground && m_FrameLoopSettings.BackgroundFrameRate > 0.0f
+                                      ? m_FrameLoopSettings.BackgroundFrameRate
+                                      : m_FrameLoopSettings.TargetFrameRate;
+
+            // Headless runs are never paced, their clock doesn't depend on how long a frame really takes.
+            if (frameRate > 0.0f && m_Window->GetBackend() != WindowBackend::Headless && !replaying) {
+                const auto frameDuration = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<f64>(1.0 / frameRate));
+                FL_PROFILE_ZONE("FrameLimiter::WaitUntil");
+                m_FrameLimiter.WaitUntil(frameStart + frameDuration);
+            }
+
+            Profiler::EndFrame();
+
+            m_EngineStats.SceneUpdateTime = static_cast<f32>(Profiler::GetLastFrameZoneTime("Scene::Query"));
+            m_EngineStats.MeshDrawTime = static_cast<f32>(Profiler::GetLastFrameZoneTime("Renderer::DrawMeshes"));
+
+            if (replaying) {
+                const std::chrono::duration<f32> wallTime = Clock::now() - frameStart;
+                m_ReplayStatistics.push_back({m_FrameIndex - m_ReplayStartFrame, wallTime.count(), m_EngineStats});
+
+                if (m_FrameIndex - m_ReplayStartFrame + 1 >= m_Replay->GetFrameCount()) {
+                    FinishReplay();
+                }
+            }
+
+            m_FrameIndex++;
+            m_InFrame = false;
+        }
+    }
+
+    bool Application::StartRecording(const std::filesystem::path& path) {
+        StopRecording();
+
+        if (!m_Recorder.Start(path)) {
+            return false;
+        }
+
+        // When called during a frame, recording starts with the next one.
+        m_RecordingStartFrame = m_InFrame ? m_FrameIndex + 1 : m_FrameIndex;
+
+        Log::EngineInfo(fmt::format("Recording events to {0}.", path.string()));
+        return true;
+    }
+
+    void Application::StopRecording() {
+        if (!m_Recorder.IsRecording()) {
+            return;
+        }
+
+        // Called during a frame, the events already recorded for it are kept and the recording covers that frame too.
+        const u64 endFrame = m_InFrame ? m_FrameIndex + 1 : m_FrameIndex;
+        m_Recorder.Stop(endFrame - std::min(endFrame, m_RecordingStartFrame));
+        Log::EngineInfo(fmt::format("Recorded {0} events.", m_Recorder.GetRecordedCount()));
+    }
+
+    bool Application::StartReplay(const ReplaySettings& settings) {
+        auto replay = std::make_unique<EventRecording>();
+        if (!replay->Load(settings.RecordingPath)) {
+            return false;
+        }
+
+        m_Replay = std::move(replay);
+        m_ReplaySettings = settings;
+        m_ReplayStartFrame = m_InFrame ? m_FrameIndex + 1 : m_FrameIndex;
+
+        m_ReplayStatistics.clear();
+        m_ReplayStatistics.reserve(m_Replay->GetFrameCount());
+
+        Log::EngineInfo(fmt::format("Replaying {0} events over {1} frames from {2}.", m_Replay->GetEventCount(),
+                                    m_Replay->GetFrameCount(), settings.RecordingPath.string()));
+        return true;
+    }
+
+    void Application::FinishReplay() {
+        if (!m_ReplaySettings.StatisticsPath.empty()) {
+            std::ofstream file(m_ReplaySettings.StatisticsPath, std::ios::trunc);
+
+            if (!file) {
+                Log::EngineError(fmt::format("Failed to create file {0}.", m_ReplaySettings.StatisticsPath.string()));
+            } else {
+                file << "Frame,WallTime,FrameTime,SceneUpdateTime,MeshDrawTime,TriangleCount,DrawCallCount,"
+                        "VisibleObjectCount,CulledObjectCount,FrameAllocatedBytes,FrameAllocationCount,"
+                        "FrameArenaOverflowCount\n";
+
+                for (const auto& [frameIndex, wallTime, stats] : m_ReplayStatistics) {
+                    file << fmt::format("{0},{1:.9f},{2:.9f},{3:.9f},{4:.9f},{5},{6},{7},{8},{9},{10},{11}\n",
+                                        frameIndex, wallTime, stats.FrameTime, stats.SceneUpdateTime,
+                                        stats.MeshDrawTime, stats.TriangleCount, stats.DrawCallCount,
+                                        stats.VisibleObjectCount, stats.CulledObjectCount, stats.FrameAllocatedBytes,
+                                        stats.FrameAllocationCount, stats.FrameArenaOverflowCount);
+                }
+            }
+        }
+
+        Log::EngineInfo(fmt::format("Replay finished after {0} frames.", m_ReplayStatistics.size()));
+
+        m_Replay.reset();
+        m_IsRunning = false;
+    }
+
+    f32 Application::Simulate(const f32 frameTime) {
+        if (m_FrameLoopSettings.Mode == LoopMode::Variable) {
+            m_DeltaTime = frameTime;
+            FL_PROFILE_ZONE("Application::OnUpdate");
             OnUpdate();
+            return 1.0f;
+        }
+
+        const f64 fixedDeltaTime = m_FrameLoopSettings.FixedDeltaTime;
+        m_DeltaTime = m_FrameLoopSettings.FixedDeltaTime;
+        m_Accumulator += frameTime;
 
-            OnRender();
+        u32 steps = 0;
+        while (m_Accumulator >= fixedDeltaTime && steps < m_FrameLoopSettings.MaxStepsPerFrame && m_IsRunning) {
+            FL_PROFILE_ZONE("Application::OnUpdate");
+            OnUpdate();
+            m_Accumulator -= fixedDeltaTime;
+            steps++;
+        }
+
+        // Spiral of death guard: if we couldn't catch up, drop the backlog instead of carrying it to the next frame.
+        if (m_Accumulator >= fixedDeltaTime) {
+            m_Accumulator = std::fmod(m_Accumulator, fixedDeltaTime);
         }
+
+        return static_cast<f32>(m_Accumulator / fixedDeltaTime);
+    }
+
+    void Application::OnWindowEvent(Event& event) {
+        // While replaying, the recording is the only source of input. Closing the window still quits.
+        if (m_Replay && event.GetEventType() != EventType::WindowClose) {
+            return;
+        }
+
+        if (m_Recorder.IsRecording() && m_FrameIndex >= m_RecordingStartFrame) {
+            m_Recorder.Record(m_FrameIndex - m_RecordingStartFrame, event);
+        }
+
+        DispatchEvent(event);
+    }
+
+    void Application::DispatchEvent(Event& event) {
+        m_Input.OnEvent(event);
+        m_EventHandlers.Dispatch(event);
+        OnEvent(event);
     }
 
     void Application::OnWindowClose(Event& event) {
@@ -0,0 +1,384 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Asset/AssetArchive.hpp>
+
+#include <FlashlightEngine/Core/Hash.hpp>
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Flashlight {
+    namespace {
+        constexpr i32 LZ4CompressionLevel = LZ4HC_CLEVEL_DEFAULT;
+        constexpr i32 ZstdCompressionLevel = 19;
+
+        u64 AlignUp(const u64 value) {
+            return (value + AssetArchiveAlignment - 1) & ~(AssetArchiveAlignment - 1);
+        }
+
+        char NormalizePathCharacter(const char character) {
+            return character == '\\' ? '/' : character;
+        }
+
+        bool PathEquals(const std::string_view stored, const std::string_view path) {
+            return stored.size() == path.size() &&
+                   std::ranges::equal(stored, path, {}, {}, NormalizePathCharacter);
+        }
+
+        void LogArchiveError(const AssetArchiveError error, const std::string_view message) {
+            const ErrorCode code = GetErrorCode(error);
+            Log::EngineError(fmt::format("{0}{1}: {2} (0x{3:04X}).", Log::EvaluateEngineErrorCode(code), message,
+                                         GetErrorName(error), code.GetFormattedErrorCode()));
+        }
+
+        // Largest content a stored entry can decompress to: an LZ4 length byte adds at most 255 bytes, a Zstd block
+        // takes at least 4 bytes for up to 128 KiB. LZ4 also caps what one call can decompress.
+        u64 GetMaxContentSize(const AssetCompression compression, const u64 storedSize) {
+            switch (compression) {
+            case AssetCompression::LZ4:
+                return std::min<u64>(storedSize * 255, LZ4_MAX_INPUT_SIZE);
+            case AssetCompression::Zstd:
+                return storedSize * 32 * 1024;
+            default:
+                return storedSize;
+            }
+        }
+
+        // Empty if the content doesn't get smaller, it is then stored as it is.
+        std::vector<std::byte> Compress(const std::span<const std::byte> content, const AssetCompression compression) {
+            std::vector<std::byte> compressed;
+
+            switch (compression) {
+            case AssetCompression::LZ4:
+                {
+                    if (content.size() > LZ4_MAX_INPUT_SIZE) {
+                        break;
+                    }
+
+                    const i32 sourceSize = static_cast<i32>(content.size());
+                    compressed.resize(static_cast<u64>(LZ4_compressBound(sourceSize)));
+                    const i32 size = LZ4_compress_HC(reinterpret_cast<const char*>(content.data()),
+                                                     reinterpret_cast<char*>(compressed.data()), sourceSize,
+                                                     static_cast<i32>(compressed.size()), LZ4CompressionLevel);
+                    compressed.resize(static_cast<u64>(std::max(size, 0)));
+                    break;
+                }
+
+            case AssetCompression::Zstd:
+                {
+                    compressed.resize(ZSTD_compressBound(content.size()));
+                    const u64 size = ZSTD_compress(compressed.data(), compressed.size(), content.data(),
+                                                   content.size(), ZstdCompressionLevel);
+                    compressed.resize(ZSTD_isError(size) ? 0 : size);
+                    break;
+                }
+
+            default:
+                break;
+            }
+
+            if (compressed.size() >= content.size()) {
+                compressed.clear();
+            }
+
+            return compressed;
+        }
+    }
+
+    std::string_view GetErrorName(const AssetArchiveError error) {
+        switch (error) {
+        case AssetArchiveError::None:
+            return "no error";
+        case AssetArchiveError::OpenFailed:
+            return "the file can't be opened";
+        case AssetArchiveError::InvalidHeader:
+            return "not an asset archive";
+        case AssetArchiveError::UnsupportedVersion:
+            return "unsupported archive version";
+        case AssetArchiveError::Corrupted:
+            return "the archive is corrupted";
+        case AssetArchiveError::EntryNotFound:
+            return "no such entry";
+        case AssetArchiveError::DuplicatePath:
+            return "two entries have the same path hash";
+        case AssetArchiveError::BufferTooSmall:
+            return "the output buffer is too small";
+        case AssetArchiveError::DecompressionFailed:
+            return "decompression failed";
+        case AssetArchiveError::CompressionFailed:
+            return "compression failed";
+        case AssetArchiveError::HashMismatch:
+            return "the content doesn't match its hash";
+        case AssetArchiveError::WriteFailed:
+            return "the archive can't be written";
+        default:
+            return "unknown error";
+        }
+    }
+
+    u64 HashAssetPath(const std::string_view path) {
+        // HashFnv1a with the separators normalized on the fly.
+        u64 hash = Fnv1aOffsetBasis;
+        for (const char character : path) {
+            hash ^= static_cast<u8>(NormalizePathCharacter(character));
+            hash *= Fnv1aPrime;
+        }
+
+        return hash;
+    }
+
+    AssetArchiveError AssetArchive::Open(const std::filesystem::path& path) {
+        FL_PROFILE_ZONE("AssetArchive::Open");
+
+        Close();
+
+        const auto fail = [this, &path](const AssetArchiveError error) {
+            LogArchiveError(error, fmt::format("Failed to open asset archive {0}", path.string()));
+            Close();
+            return error;
+        };
+
+        if (!m_File.OpenRead(path)) {
+            return fail(AssetArchiveError::OpenFailed);
+        }
+
+        const u64 fileSize = m_File.GetSize();
+        if (fileSize < sizeof(AssetArchiveHeader)) {
+            return fail(AssetArchiveError::InvalidHeader);
+        }
+
+        // The mapping is page aligned, so the header and the table of contents can be used in place.
+        const auto* header = reinterpret_cast<const AssetArchiveHeader*>(m_File.GetData());
+        if (header->Magic != AssetArchiveMagic) {
+            return fail(AssetArchiveError::InvalidHeader);
+        }
+
+        if (header->Version != AssetArchiveVersion) {
+            return fail(AssetArchiveError::UnsupportedVersion);
+        }
+
+        const u64 tocSize = static_cast<u64>(header->EntryCount) * sizeof(AssetArchiveEntry);
+        if (header->FileSize != fileSize || header->TocOffset % AssetArchiveAlignment != 0 ||
+            header->TocOffset > fileSize || tocSize > fileSize - header->TocOffset ||
+            header->PathsOffset > fileSize || header->PathsSize > fileSize - header->PathsOffset) {
+            return fail(AssetArchiveError::Corrupted);
+        }
+
+        m_Entries = {reinterpret_cast<const AssetArchiveEntry*>(m_File.GetData() + header->TocOffset),
+                     header->EntryCount};
+        m_Paths = reinterpret_cast<const char*>(m_File.GetData() + header->PathsOffset);
+
+        // Checking the bounds once here lets lookups and reads trust the table of contents. Readers allocate the
+        // uncompressed size of an entry before decompressing it, so it can't be more than the stored data can hold.
+        for (u32 i = 0; i < m_Entries.size(); i++) {
+            const AssetArchiveEntry& entry = m_Entries[i];
+            const bool outOfBounds = entry.Offset > header->TocOffset ||
+                                     entry.StoredSize > header->TocOffset - entry.Offset ||
+                                     static_cast<u64>(entry.PathOffset) + entry.PathLength > header->PathsSize;
+            const bool unsorted = i > 0 && m_Entries[i - 1].PathHash >= entry.PathHash;
+            const bool invalidSize = entry.Compression == AssetCompression::None
+                                         ? entry.StoredSize != entry.Size
+                                         : entry.Size > GetMaxContentSize(entry.Compression, entry.StoredSize);
+
+            if (outOfBounds || unsorted || invalidSize || entry.Compression > AssetCompression::Zstd) {
+                return fail(AssetArchiveError::Corrupted);
+            }
+        }
+
+        return AssetArchiveError::None;
+    }
+
+    void AssetArchive::Close() {
+        m_File.Close();
+        m_Entries = {};
+        m_Paths = nullptr;
+    }
+
+    const AssetArchiveEntry* AssetArchive::Find(const std::string_view path) const {
+        const u64 hash = HashAssetPath(path);
+
+        const auto entry = std::ranges::lower_bound(m_Entries, hash, {}, &AssetArchiveEntry::PathHash);
+        if (entry == m_Entries.end() || entry->PathHash != hash || !PathEquals(GetPath(*entry), path)) {
+            return nullptr;
+        }
+
+        return &*entry;
+    }
+
+    AssetArchiveError AssetArchive::Read(const AssetArchiveEntry& entry, const std::span<std::byte> output) const {
+        FL_PROFILE_ZONE("AssetArchive::Read");
+
+        if (output.size() < entry.Size) {
+            return AssetArchiveError::BufferTooSmall;
+        }
+
+        const std::span<const std::byte> stored = GetStoredData(entry);
+
+        switch (entry.Compression) {
+        case AssetCompression::None:
+            std::memcpy(output.data(), stored.data(), stored.size());
+            return AssetArchiveError::None;
+
+        case AssetCompression::LZ4:
+            {
+                const i32 size = LZ4_decompress_safe(reinterpret_cast<const char*>(stored.data()),
+                                                     reinterpret_cast<char*>(output.data()),
+                                                     static_cast<i32>(stored.size()), static_cast<i32>(entry.Size));
+                return size >= 0 && static_cast<u64>(size) == entry.Size ? AssetArchiveError::None
+                                                                          : AssetArchiveError::DecompressionFailed;
+            }
+
+        case AssetCompression::Zstd:
+            {
+                const u64 size = ZSTD_decompress(output.data(), entry.Size, stored.data(), stored.size());
+                return !ZSTD_isError(size) && size == entry.Size ? AssetArchiveError::None
+                                                                 : AssetArchiveError::DecompressionFailed;
+            }
+
+        default:
+            return AssetArchiveError::Corrupted;
+        }
+    }
+
+    AssetArchiveError AssetArchive::Verify(const AssetArchiveEntry& entry) const {
+        if (entry.Compression == AssetCompression::None) {
+            return HashXxh64(GetView(entry)) == entry.ContentHash ? AssetArchiveError::None
+                                                                  : AssetArchiveError::HashMismatch;
+        }
+
+        std::vector<std::byte> content(entry.Size);
+        if (const AssetArchiveError error = Read(entry, content); error != AssetArchiveError::None) {
+            return error;
+        }
+
+        return HashXxh64(content) == entry.ContentHash ? AssetArchiveError::None : AssetArchiveError::HashMismatch;
+    }
+
+    void AssetArchiveWriter::Add(const std::string_view path, std::vector<std::byte> content,
+                                 const AssetCompression compression) {
+        std::string normalizedPath(path);
+        std::ranges::transform(normalizedPath, normalizedPath.begin(), NormalizePathCharacter);
+
+        m_Entries.push_back({std::move(normalizedPath), std::move(content), compression});
+    }
+
+    AssetArchiveError AssetArchiveWriter::AddFile(const std::filesystem::path& file, const std::string_view path,
+                                                  const AssetCompression compression) {
+        std::ifstream stream(file, std::ios::binary | std::ios::ate);
+        if (!stream) {
+            LogArchiveError(AssetArchiveError::OpenFailed, fmt::format("Failed to add {0}", file.string()));
+            return AssetArchiveError::OpenFailed;
+        }
+
+        std::vector<std::byte> content(static_cast<u64>(stream.tellg()));
+        stream.seekg(0);
+        if (!stream.read(reinterpret_cast<char*>(content.data()), static_cast<std::streamsize>(content.size()))) {
+            LogArchiveError(AssetArchiveError::OpenFailed, fmt::format("Failed to add {0}", file.string()));
+            return AssetArchiveError::OpenFailed;
+        }
+
+        Add(path, std::move(content), compression);
+        return AssetArchiveError::None;
+    }
+
+    AssetArchiveError AssetArchiveWriter::Write(const std::filesystem::path& path, JobSystem* jobs) {
+        FL_PROFILE_ZONE("AssetArchiveWriter::Write");
+
+        const u32 entryCount = GetEntryCount();
+        std::vector<AssetArchiveEntry> toc(entryCount);
+        std::vector<std::vector<std::byte>> compressed(entryCount);
+
+        const auto process = [this, &toc, &compressed](const u32 begin, const u32 end) {
+            for (u32 i = begin; i < end; i++) {
+                const PendingEntry& pending = m_Entries[i];
+                compressed[i] = Compress(pending.Content, pending.Compression);
+
+                AssetArchiveEntry& entry = toc[i];
+                entry.PathHash = HashAssetPath(pending.Path);
+                entry.ContentHash = HashXxh64(pending.Content);
+                entry.Size = pending.Content.size();
+                entry.Compression = compressed[i].empty() ? AssetCompression::None : pending.Compression;
+                entry.StoredSize = compressed[i].empty() ? entry.Size : compressed[i].size();
+                entry.PathLength = static_cast<u32>(pending.Path.size());
+            }
+        };
+
+        if (jobs != nullptr) {
+            jobs->ParallelFor(entryCount, 1, process);
+        } else {
+            process(0, entryCount);
+        }
+
+        // Entries keep the order they were added in the file, only the table of contents is sorted.
+        std::vector<u32> order(entryCount);
+        for (u32 i = 0; i < entryCount; i++) {
+            order[i] = i;
+        }
+        std::ranges::sort(order, {}, [&toc](const u32 index) { return toc[index].PathHash; });
+
+        for (u32 i = 1; i < entryCount; i++) {
+            if (toc[order[i - 1]].PathHash == toc[order[i]].PathHash) {
+                LogArchiveError(AssetArchiveError::DuplicatePath,
+                                fmt::format("Failed to write asset archive {0}, {1} and {2} collide", path.string(),
+                                            m_Entries[order[i - 1]].Path, m_Entries[order[i]].Path));
+                return AssetArchiveError::DuplicatePath;
+            }
+        }
+
+        AssetArchiveHeader header{};
+        header.Magic = AssetArchiveMagic;
+        header.Version = AssetArchiveVersion;
+        header.EntryCount = entryCount;
+
+        u64 offset = sizeof(AssetArchiveHeader);
+        u32 pathOffset = 0;
+        for (u32 i = 0; i < entryCount; i++) {
+            offset = AlignUp(offset);
+            toc[i].Offset = offset;
+            toc[i].PathOffset = pathOffset;
+            offset += toc[i].StoredSize;
+            pathOffset += toc[i].PathLength;
+        }
+
+        header.TocOffset = AlignUp(offset);
+        header.PathsOffset = header.TocOffset + static_cast<u64>(entryCount) * sizeof(AssetArchiveEntry);
+        header.PathsSize = pathOffset;
+        header.FileSize = header.PathsOffset + header.PathsSize;
+
+        MemoryMappedFile file;
+        if (!file.Create(path, header.FileSize)) {
+            LogArchiveError(AssetArchiveError::WriteFailed,
+                            fmt::format("Failed to write asset archive {0}", path.string()));
+            return AssetArchiveError::WriteFailed;
+        }
+
+        std::byte* data = file.GetData();
+        std::memcpy(data, &header, sizeof(header));
+
+        for (u32 i = 0; i < entryCount; i++) {
+            const std::vector<std::byte>& stored = compressed[i].empty() ? m_Entries[i].Content : compressed[i];
+            std::memcpy(data + toc[i].Offset, stored.data(), stored.size());
+            std::memcpy(data + header.PathsOffset + toc[i].PathOffset, m_Entries[i].Path.data(), toc[i].PathLength);
+        }
+
+        std::byte* tocData = data + header.TocOffset;
+        for (const u32 index : order) {
+            std::memcpy(tocData, &toc[index], sizeof(AssetArchiveEntry));
+            tocData += sizeof(AssetArchiveEntry);
+        }
+
+        file.Close();
+        m_Entries.clear();
+
+        return AssetArchiveError::None;
+    }
+}
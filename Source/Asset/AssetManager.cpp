@@ -0,0 +1,489 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Asset/AssetManager.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace Flashlight {
+    AssetManager::AssetManager(const AssetManagerSettings& settings)
+        : m_Settings(settings), m_Slots(std::make_unique<Slot[]>(settings.MaxAssetCount)),
+          m_Completions(settings.MaxAssetCount) {
+        // Without worker threads the decoding jobs would only run when the main thread waits on them.
+        if (m_Settings.Jobs != nullptr && m_Settings.Jobs->GetWorkerCount() <= 1) {
+            m_Settings.Jobs = nullptr;
+        }
+
+        // Popped from the back, so the lowest indices are handed out first.
+        m_FreeIndices.reserve(m_Settings.MaxAssetCount);
+        for (u32 index = m_Settings.MaxAssetCount; index-- > 0;) {
+            m_FreeIndices.push_back(index);
+        }
+
+        for (u32 i = 0; i < std::max(m_Settings.IoThreadCount, 1u); i++) {
+            m_IoThreads.emplace_back(&AssetManager::IoThreadMain, this);
+        }
+    }
+
+    AssetManager::~AssetManager() {
+        m_Stopping.store(true);
+
+        // Taking the locks makes sure no thread is between checking m_Stopping and going to sleep.
+        {
+            std::lock_guard lock(m_QueueMutex);
+        }
+        {
+            std::lock_guard lock(m_MemoryMutex);
+        }
+        m_QueueCondition.notify_all();
+        m_MemoryCondition.notify_all();
+
+        for (std::thread& thread : m_IoThreads) {
+            thread.join();
+        }
+
+        if (m_Settings.Jobs != nullptr) {
+            m_Settings.Jobs->Wait(m_DecodeCounter);
+        }
+
+        for (u32 index = 0; index < m_Settings.MaxAssetCount; index++) {
+            FreeTexture(m_Slots[index]);
+        }
+    }
+
+    AssetHandle AssetManager::LoadTexture(const std::filesystem::path& path, const AssetPriority priority,
+                                          AssetCallback callback, const u32 desiredChannels) {
+        if (m_FreeIndices.empty()) {
+            Log::EngineError(fmt::format("Can't load {0}, all {1} asset slots are taken.", path.string(),
+                                         m_Settings.MaxAssetCount));
+            return {};
+        }
+
+        const u32 index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+
+        Slot& slot = m_Slots[index];
+        slot.Path = path;
+        slot.DesiredChannels = desiredChannels;
+        slot.Callback = std::move(callback);
+        slot.InFlight = true;
+        slot.ReleaseRequested = false;
+        slot.State.store(AssetState::Queued, std::memory_order_release);
+
+        m_PendingCount++;
+        m_RequestedCount++;
+
+        {
+            std::lock_guard lock(m_QueueMutex);
+            m_Queue.push_back({priority, m_NextSequence++, index});
+            std::push_heap(m_Queue.begin(), m_Queue.end());
+        }
+        m_QueueCondition.notify_one();
+
+        return {index, slot.Generation};
+    }
+
+    void AssetManager::Cancel(const AssetHandle handle) {
+        if (!IsAlive(handle)) {
+            return;
+        }
+
+        // The loading threads move the state forward with compare-exchanges, they notice the cancellation at their
+        // next step.
+        std::atomic<AssetState>& state = m_Slots[handle.Index].State;
+        AssetState current = state.load(std::memory_order_acquire);
+        while (current == AssetState::Queued || current == AssetState::Reading || current == AssetState::Decoding) {
+            if (state.compare_exchange_weak(current, AssetState::Cancelled, std::memory_order_acq_rel)) {
+                // A request still in the queue is only seen once an I/O thread is free, which never happens while they
+                // all wait for memory: it is completed right away instead.
+                if (current == AssetState::Queued && RemoveQueued(handle.Index)) {
+                    Complete(handle.Index);
+                    break;
+                }
+
+                // Wakes the request up if it is waiting for memory.
+                {
+                    std::lock_guard lock(m_MemoryMutex);
+                }
+                m_MemoryCondition.notify_all();
+                break;
+            }
+        }
+    }
+
+    void AssetManager::Release(const AssetHandle handle) {
+        if (!IsAlive(handle)) {
+            return;
+        }
+
+        // The loading threads may still use the slot, it is freed once Update receives its completion.
+        Slot& slot = m_Slots[handle.Index];
+        if (slot.InFlight) {
+            Cancel(handle);
+            slot.ReleaseRequested = true;
+            return;
+        }
+
+        FreeSlot(handle.Index);
+    }
+
+    u32 AssetManager::Update() {
+        FL_PROFILE_ZONE("AssetManager::Update");
+
+        u32 count = 0;
+        u32 index;
+        while (m_Completions.TryPop(index)) {
+            Slot& slot = m_Slots[index];
+            slot.InFlight = false;
+            m_PendingCount--;
+            count++;
+
+            const AssetState state = slot.State.load(std::memory_order_acquire);
+            switch (state) {
+            case AssetState::Ready:
+                m_LoadedCount++;
+                break;
+
+            case AssetState::Failed:
+                m_FailedCount++;
+                break;
+
+            default:
+                m_CancelledCount++;
+                break;
+            }
+
+            if (slot.ReleaseRequested) {
+                FreeSlot(index);
+                continue;
+            }
+
+            if (slot.Callback) {
+                slot.Callback({index, slot.Generation}, state);
+            }
+        }
+
+        return count;
+    }
+
+    void AssetManager::WaitIdle() {
+        FL_PROFILE_ZONE("AssetManager::WaitIdle");
+
+        while (m_PendingCount > 0) {
+            if (Update() != 0) {
+                continue;
+            }
+
+            // Help with the decoding, the job system might have no other worker to run it.
+            if (m_Settings.Jobs != nullptr) {
+                m_Settings.Jobs->Wait(m_DecodeCounter);
+            }
+
+            // Requests are completed before they stop being active, so the second Update catches the completions
+            // that came between the first one and the check. They may free memory if their asset was released.
+            if (IsStalled() && Update() == 0) {
+                {
+                    std::lock_guard lock(m_MemoryMutex);
+                    m_FailOverBudget = true;
+                }
+                m_MemoryCondition.notify_all();
+            }
+
+            std::this_thread::yield();
+        }
+
+        std::lock_guard lock(m_MemoryMutex);
+        m_FailOverBudget = false;
+    }
+
+    AssetState AssetManager::GetState(const AssetHandle handle) const {
+        if (!IsAlive(handle)) {
+            return AssetState::Unloaded;
+        }
+
+        return m_Slots[handle.Index].State.load(std::memory_order_acquire);
+    }
+
+    const TextureData* AssetManager::GetTexture(const AssetHandle handle) const {
+        if (GetState(handle) != AssetState::Ready) {
+            return nullptr;
+        }
+
+        return &m_Slots[handle.Index].Texture;
+    }
+
+    AssetStatistics AssetManager::GetStatistics() {
+        AssetStatistics statistics;
+        statistics.Requested = m_RequestedCount;
+        statistics.Loaded = m_LoadedCount;
+        statistics.Failed = m_FailedCount;
+        statistics.Cancelled = m_CancelledCount;
+        statistics.BytesRead = m_BytesRead.load(std::memory_order_relaxed);
+        statistics.PendingCount = m_PendingCount;
+
+        {
+            std::lock_guard lock(m_MemoryMutex);
+            statistics.MemoryUsed = m_MemoryUsed;
+        }
+
+        return statistics;
+    }
+
+    void AssetManager::IoThreadMain() {
+        while (true) {
+            u32 index;
+
+            {
+                std::unique_lock lock(m_QueueMutex);
+                m_QueueCondition.wait(lock, [this] { return m_Stopping.load() || !m_Queue.empty(); });
+
+                if (m_Stopping.load()) {
+                    return;
+                }
+
+                std::pop_heap(m_Queue.begin(), m_Queue.end());
+                index = m_Queue.back().Index;
+                m_Queue.pop_back();
+            }
+
+            Read(index);
+        }
+    }
+
+    void AssetManager::Read(const u32 index) {
+        Slot& slot = m_Slots[index];
+
+        // Don't start reading while over budget, a release or a cancellation lets the request go on. WaitIdle lets it
+        // through to fail when nothing else can free memory.
+        bool overBudget;
+        {
+            std::unique_lock lock(m_MemoryMutex);
+            m_MemoryCondition.wait(lock, [this, &slot] {
+                return m_Stopping.load() || m_MemoryUsed < m_Settings.MemoryBudget || m_FailOverBudget ||
+                       slot.State.load(std::memory_order_acquire) == AssetState::Cancelled;
+            });
+
+            if (m_Stopping.load()) {
+                return;
+            }
+
+            overBudget = m_MemoryUsed >= m_Settings.MemoryBudget;
+            m_ActiveCount++;
+        }
+
+        AssetState expected = AssetState::Queued;
+        if (overBudget) {
+            if (slot.State.compare_exchange_strong(expected, AssetState::Failed, std::memory_order_acq_rel)) {
+                Log::EngineError(fmt::format("Can't load asset {0}, loaded assets fill the memory budget of {1} bytes.",
+                                             slot.Path.string(), m_Settings.MemoryBudget));
+                Finish(index, AssetState::Failed, AssetState::Failed);
+            } else {
+                Finish(index, AssetState::Cancelled, AssetState::Cancelled);
+            }
+            return;
+        }
+
+        if (!slot.State.compare_exchange_strong(expected, AssetState::Reading, std::memory_order_acq_rel)) {
+            Finish(index, AssetState::Cancelled, AssetState::Cancelled);
+            return;
+        }
+
+        if (m_Settings.Archive != nullptr && ReadFromArchive(slot)) {
+            if (slot.Source.empty()) {
+                Finish(index, AssetState::Reading, AssetState::Failed);
+                return;
+            }
+        } else {
+            FL_PROFILE_ZONE("AssetManager::Read");
+
+            std::ifstream file(slot.Path, std::ios::binary | std::ios::ate);
+            if (!file) {
+                Log::EngineError(fmt::format("Failed to open asset {0}.", slot.Path.string()));
+                Finish(index, AssetState::Reading, AssetState::Failed);
+                return;
+            }
+
+            const auto size = static_cast<u64>(file.tellg());
+            HoldMemory(slot, size);
+            slot.FileData.resize(size);
+
+            file.seekg(0);
+            if (!file.read(reinterpret_cast<char*>(slot.FileData.data()), static_cast<std::streamsize>(size))) {
+                Log::EngineError(fmt::format("Failed to read asset {0}.", slot.Path.string()));
+                Finish(index, AssetState::Reading, AssetState::Failed);
+                return;
+            }
+
+            m_BytesRead.fetch_add(size, std::memory_order_relaxed);
+            slot.Source = slot.FileData;
+        }
+
+        expected = AssetState::Reading;
+        if (!slot.State.compare_exchange_strong(expected, AssetState::Decoding, std::memory_order_acq_rel)) {
+            Finish(index, AssetState::Cancelled, AssetState::Cancelled);
+            return;
+        }
+
+        if (m_Settings.Jobs != nullptr) {
+            m_Settings.Jobs->Schedule([this, index] { Decode(index); }, &m_DecodeCounter);
+        } else {
+            Decode(index);
+        }
+    }
+
+    // Returns false if the archive has no such entry. On success the source is empty if the entry couldn't be read.
+    bool AssetManager::ReadFromArchive(Slot& slot) {
+        FL_PROFILE_ZONE("AssetManager::ReadFromArchive");
+
+        const AssetArchiveEntry* entry = m_Settings.Archive->Find(slot.Path.generic_string());
+        if (entry == nullptr) {
+            return false;
+        }
+
+        m_BytesRead.fetch_add(entry->StoredSize, std::memory_order_relaxed);
+
+        if (entry->Compression == AssetCompression::None) {
+            const std::span<const std::byte> view = m_Settings.Archive->GetView(*entry);
+            slot.Source = {reinterpret_cast<const u8*>(view.data()), view.size()};
+            return true;
+        }
+
+        HoldMemory(slot, entry->Size);
+        slot.FileData.resize(entry->Size);
+
+        const std::span<std::byte> output = std::as_writable_bytes(std::span(slot.FileData));
+        const AssetArchiveError error = m_Settings.Archive->Read(*entry, output);
+        if (error != AssetArchiveError::None) {
+            Log::EngineError(fmt::format("Failed to read asset {0} from its archive: {1}.", slot.Path.string(),
+                                         GetErrorName(error)));
+            return true;
+        }
+
+        slot.Source = slot.FileData;
+        return true;
+    }
+
+    void AssetManager::Decode(const u32 index) {
+        FL_PROFILE_ZONE("AssetManager::Decode");
+
+        Slot& slot = m_Slots[index];
+        if (slot.State.load(std::memory_order_acquire) == AssetState::Cancelled) {
+            Finish(index, AssetState::Cancelled, AssetState::Cancelled);
+            return;
+        }
+
+        i32 width;
+        i32 height;
+        i32 fileChannels;
+        u8* pixels = stbi_load_from_memory(slot.Source.data(), static_cast<i32>(slot.Source.size()), &width, &height,
+                                           &fileChannels, static_cast<i32>(slot.DesiredChannels));
+        if (pixels == nullptr) {
+            Log::EngineError(fmt::format("Failed to decode asset {0}: {1}.", slot.Path.string(),
+                                         stbi_failure_reason()));
+            Finish(index, AssetState::Decoding, AssetState::Failed);
+            return;
+        }
+
+        const u32 channels = slot.DesiredChannels != 0 ? slot.DesiredChannels : static_cast<u32>(fileChannels);
+        slot.Texture = {static_cast<u32>(width), static_cast<u32>(height), channels, pixels};
+        HoldMemory(slot, slot.Texture.GetSize());
+
+        Finish(index, AssetState::Decoding, AssetState::Ready);
+    }
+
+    void AssetManager::Finish(const u32 index, const AssetState from, const AssetState to) {
+        Slot& slot = m_Slots[index];
+
+        // Fails only if the request was cancelled meanwhile, in which case nothing is kept.
+        AssetState expected = from;
+        if (from != to && !slot.State.compare_exchange_strong(expected, to, std::memory_order_acq_rel)) {
+            FreeTexture(slot);
+        }
+
+        ReleaseMemory(slot, slot.FileData.size());
+        slot.FileData = {};
+        slot.Source = {};
+
+        Complete(index);
+
+        std::lock_guard lock(m_MemoryMutex);
+        m_ActiveCount--;
+    }
+
+    void AssetManager::Complete(const u32 index) {
+        // There is room for every slot, so this can't fail.
+        [[maybe_unused]] const bool pushed = m_Completions.TryPush(index);
+        assert(pushed && "Asset completion queue is full.");
+    }
+
+    // Returns false if an I/O thread already took the request.
+    bool AssetManager::RemoveQueued(const u32 index) {
+        std::lock_guard lock(m_QueueMutex);
+
+        const auto request = std::ranges::find(m_Queue, index, &IoRequest::Index);
+        if (request == m_Queue.end()) {
+            return false;
+        }
+
+        *request = m_Queue.back();
+        m_Queue.pop_back();
+        std::make_heap(m_Queue.begin(), m_Queue.end());
+
+        return true;
+    }
+
+    // True when loaded assets fill the budget and no request in flight can give memory back, only releases can.
+    bool AssetManager::IsStalled() {
+        std::lock_guard lock(m_MemoryMutex);
+        return m_ActiveCount == 0 && m_MemoryUsed >= m_Settings.MemoryBudget;
+    }
+
+    void AssetManager::FreeSlot(const u32 index) {
+        Slot& slot = m_Slots[index];
+        FreeTexture(slot);
+
+        slot.Path.clear();
+        slot.Callback = {};
+        slot.Generation++;
+        slot.State.store(AssetState::Unloaded, std::memory_order_release);
+
+        m_FreeIndices.push_back(index);
+    }
+
+    void AssetManager::HoldMemory(Slot& slot, const u64 bytes) {
+        std::lock_guard lock(m_MemoryMutex);
+        m_MemoryUsed += bytes;
+        slot.HeldBytes += bytes;
+    }
+
+    void AssetManager::ReleaseMemory(Slot& slot, const u64 bytes) {
+        if (bytes == 0) {
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_MemoryMutex);
+            m_MemoryUsed -= bytes;
+            slot.HeldBytes -= bytes;
+        }
+        m_MemoryCondition.notify_all();
+    }
+
+    void AssetManager::FreeTexture(Slot& slot) {
+        if (slot.Texture.Pixels == nullptr) {
+            return;
+        }
+
+        ReleaseMemory(slot, slot.Texture.GetSize());
+        stbi_image_free(slot.Texture.Pixels);
+        slot.Texture = {};
+    }
+}
@@ -0,0 +1,124 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/BinaryLog.hpp>
+
+#include <thread>
+
+namespace Flashlight {
+    MemoryMappedFile BinaryLog::m_File;
+    std::atomic<bool> BinaryLog::m_IsOpen = false;
+    std::atomic<u32> BinaryLog::m_ActiveWriters = 0;
+    std::atomic<u64> BinaryLog::m_WriteOffset = 0;
+    std::atomic<u64> BinaryLog::m_DroppedCount = 0;
+
+    std::mutex BinaryLog::m_FormatsMutex;
+    std::vector<std::string> BinaryLog::m_Formats;
+
+    bool BinaryLog::Open(const std::filesystem::path& path, const u64 capacity) {
+        Close();
+
+        if (!m_File.Create(path, capacity)) {
+            return false;
+        }
+
+        BinaryLogFileHeader header{};
+        header.Magic = BinaryLogMagic;
+        header.Version = BinaryLogVersion;
+        header.HeaderSize = sizeof(BinaryLogFileHeader);
+        header.SystemClockAtOpen = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        header.SteadyClockAtOpen = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        std::memcpy(m_File.GetData(), &header, sizeof(header));
+
+        m_WriteOffset.store(sizeof(BinaryLogFileHeader), std::memory_order_relaxed);
+        m_DroppedCount.store(0, std::memory_order_relaxed);
+
+        // Formats registered before the file was opened (or while a previous file was open) go first. They are
+        // written before the log is published so that no message using a cached format id can get ahead of its
+        // format record, no writer touches the mapping until m_IsOpen is set.
+        std::scoped_lock lock(m_FormatsMutex);
+        for (u32 formatId = 0; formatId < m_Formats.size(); formatId++) {
+            WriteFormatRecord(formatId, m_Formats[formatId]);
+        }
+
+        m_IsOpen.store(true, std::memory_order_release);
+
+        Log::EngineTrace(fmt::format("Binary log opened at {0}.", path.string()));
+
+        return true;
+    }
+
+    void BinaryLog::Close() {
+        if (!m_IsOpen.exchange(false, std::memory_order_seq_cst)) {
+            return;
+        }
+
+        // Writers that saw the log open may still be copying their record into the mapping.
+        while (m_ActiveWriters.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+
+        const u64 usedSize = std::min(m_WriteOffset.load(std::memory_order_acquire), m_File.GetSize());
+        m_File.Close(usedSize);
+
+        const u64 droppedCount = m_DroppedCount.load(std::memory_order_relaxed);
+        if (droppedCount > 0) {
+            Log::EngineWarn(fmt::format("Binary log was full, {0} records were dropped.", droppedCount));
+        }
+    }
+
+    u32 BinaryLog::RegisterFormat(const std::string_view format) {
+        std::scoped_lock lock(m_FormatsMutex);
+
+        const u32 formatId = static_cast<u32>(m_Formats.size());
+        m_Formats.emplace_back(format);
+
+        if (BeginWrite()) {
+            WriteFormatRecord(formatId, format);
+            EndWrite();
+        }
+
+        return formatId;
+    }
+
+    std::byte* BinaryLog::Reserve(const u32 size) {
+        const u64 offset = m_WriteOffset.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size > m_File.GetSize()) {
+            m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        return m_File.GetData() + offset;
+    }
+
+    void BinaryLog::Commit(std::byte* record, const u32 size) {
+        // The size is published last so a reader never sees a record before its content.
+        std::atomic_ref(reinterpret_cast<BinaryLogRecordHeader*>(record)->Size).store(size, std::memory_order_release);
+    }
+
+    void BinaryLog::WriteFormatRecord(const u32 formatId, const std::string_view format) {
+        const u32 recordSize = (static_cast<u32>(sizeof(BinaryLogRecordHeader) + format.size()) + 7u) & ~7u;
+
+        std::byte* record = Reserve(recordSize);
+        if (record == nullptr) {
+            return;
+        }
+
+        BinaryLogRecordHeader header{};
+        header.Kind = BinaryLogRecordKind::Format;
+        header.FormatId = formatId;
+        header.ArgumentCount = 0;
+        std::memcpy(record, &header, sizeof(header));
+        std::memcpy(record + sizeof(header), format.data(), format.size());
+
+        Commit(record, recordSize);
+    }
+
+    u32 BinaryLog::GetThreadId() {
+        thread_local const u32 threadId = static_cast<u32>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        return threadId;
+    }
+}
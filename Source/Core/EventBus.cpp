@@ -0,0 +1,29 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/EventBus.hpp>
+
+namespace Flashlight {
+    EventBus::EventBus(const u64 capacity) : m_Queue(capacity) {
+    }
+
+    EventBusStatistics EventBus::GetStatistics() const {
+        EventBusStatistics statistics;
+        statistics.Published = m_PublishedCount.load(std::memory_order_relaxed);
+        statistics.Dropped = m_DroppedCount.load(std::memory_order_relaxed);
+        statistics.Dispatched = m_DispatchedCount;
+        statistics.HighWaterMark = m_HighWaterMark.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    void EventBus::UpdateHighWaterMark() {
+        const u64 size = m_Queue.GetApproximateSize();
+        u64 highWaterMark = m_HighWaterMark.load(std::memory_order_relaxed);
+
+        while (size > highWaterMark &&
+               !m_HighWaterMark.compare_exchange_weak(highWaterMark, size, std::memory_order_relaxed)) {
+        }
+    }
+}
@@ -0,0 +1,319 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/EventRecorder.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/MemoryMappedFile.hpp>
+
+namespace Flashlight {
+    namespace {
+        // The engine only targets x64, so the in-memory representation already is little endian.
+        class RecordWriter {
+            std::array<std::byte, 32> m_Buffer;
+            size m_Size = 0;
+
+        public:
+            template <typename T>
+            void Write(const T value) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                std::memcpy(m_Buffer.data() + m_Size, &value, sizeof(T));
+                m_Size += sizeof(T);
+            }
+
+            void WriteVarint(u64 value) {
+                do {
+                    u8 byte = value & 0x7F;
+                    value >>= 7;
+                    if (value != 0) {
+                        byte |= 0x80;
+                    }
+                    Write(byte);
+                } while (value != 0);
+            }
+
+            void Flush(std::ofstream& file) const {
+                file.write(reinterpret_cast<const char*>(m_Buffer.data()), static_cast<std::streamsize>(m_Size));
+            }
+        };
+
+        class RecordReader {
+            std::span<const std::byte> m_Data;
+            size m_Offset = 0;
+            bool m_Failed = false;
+
+        public:
+            explicit RecordReader(const std::span<const std::byte> data, const size offset) : m_Data(data),
+                m_Offset(offset) {
+            }
+
+            template <typename T>
+            T Read() {
+                T value{};
+                if (m_Offset + sizeof(T) > m_Data.size()) {
+                    m_Failed = true;
+                    return value;
+                }
+
+                std::memcpy(&value, m_Data.data() + m_Offset, sizeof(T));
+                m_Offset += sizeof(T);
+                return value;
+            }
+
+            u64 ReadVarint() {
+                u64 value = 0;
+                for (u32 shift = 0; shift < 64; shift += 7) {
+                    const u8 byte = Read<u8>();
+                    value |= static_cast<u64>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0 || m_Failed) {
+                        return value;
+                    }
+                }
+
+                m_Failed = true;
+                return value;
+            }
+
+            [[nodiscard]] bool IsAtEnd() const {
+                return m_Offset >= m_Data.size();
+            }
+
+            [[nodiscard]] bool HasFailed() const {
+                return m_Failed;
+            }
+        };
+
+        std::optional<EventStorage> ReadEvent(const EventType type, RecordReader& reader) {
+            switch (type) {
+            case EventType::WindowClose:
+                return WindowCloseEvent();
+
+            case EventType::WindowResize:
+                {
+                    const u32 width = reader.Read<u32>();
+                    return WindowResizeEvent(width, reader.Read<u32>());
+                }
+
+            case EventType::WindowMoved:
+                {
+                    const i32 x = reader.Read<i32>();
+                    return WindowMovedEvent(x, reader.Read<i32>());
+                }
+
+            case EventType::WindowFocus:
+                return WindowFocusedEvent(reader.Read<u8>() != 0);
+
+            case EventType::KeyDown:
+                {
+                    const i32 scancode = reader.Read<i32>();
+                    return KeyDownEvent(scancode, reader.Read<i32>());
+                }
+
+            case EventType::KeyUp:
+                return KeyUpEvent(reader.Read<i32>());
+
+            case EventType::KeyTyped:
+                return KeyTypedEvent(reader.Read<i32>());
+
+            case EventType::MouseButtonDown:
+                return MouseButtonDownEvent(reader.Read<i32>());
+
+            case EventType::MouseButtonUp:
+                return MouseButtonUpEvent(reader.Read<i32>());
+
+            case EventType::MouseMoved:
+                {
+                    const f32 x = reader.Read<f32>();
+                    return MouseMovedEvent(x, reader.Read<f32>());
+                }
+
+            case EventType::MouseScroll:
+                {
+                    const f32 xOffset = reader.Read<f32>();
+                    return MouseScrolledEvent(xOffset, reader.Read<f32>());
+                }
+
+            case EventType::User:
+                {
+                    const u32 code = reader.Read<u32>();
+                    return UserEvent(code, reader.Read<u64>());
+                }
+
+            default:
+                return std::nullopt;
+            }
+        }
+    }
+
+    EventRecorder::~EventRecorder() {
+        if (IsRecording()) {
+            Stop(m_LastFrameIndex + 1);
+        }
+    }
+
+    bool EventRecorder::Start(const std::filesystem::path& path) {
+        m_File.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_File) {
+            Log::EngineError(fmt::format("Failed to create file {0}.", path.string()));
+            return false;
+        }
+
+        m_File.write(EventRecordingMagic.data(), EventRecordingMagic.size());
+        m_File.write(reinterpret_cast<const char*>(&EventRecordingVersion), sizeof(EventRecordingVersion));
+
+        m_LastFrameIndex = 0;
+        m_RecordedCount = 0;
+
+        return true;
+    }
+
+    void EventRecorder::Stop(const u64 frameCount) {
+        if (!IsRecording()) {
+            return;
+        }
+
+        RecordWriter writer;
+        writer.Write(IntegerFromEnum(EventType::Undefined));
+        writer.WriteVarint(frameCount - std::min(frameCount, m_LastFrameIndex));
+        writer.Flush(m_File);
+
+        m_File.close();
+    }
+
+    void EventRecorder::Record(const u64 frameIndex, const Event& event) {
+        assert(frameIndex >= m_LastFrameIndex && "Events must be recorded in frame order.");
+
+        RecordWriter writer;
+        writer.Write(IntegerFromEnum(event.GetEventType()));
+        writer.WriteVarint(frameIndex - m_LastFrameIndex);
+
+        switch (event.GetEventType()) {
+        case EventType::WindowClose:
+            break;
+
+        case EventType::WindowResize:
+            {
+                const auto& resize = static_cast<const WindowResizeEvent&>(event);
+                writer.Write(resize.GetWidth());
+                writer.Write(resize.GetHeight());
+                break;
+            }
+
+        case EventType::WindowMoved:
+            {
+                const auto& moved = static_cast<const WindowMovedEvent&>(event);
+                writer.Write(moved.GetX());
+                writer.Write(moved.GetY());
+                break;
+            }
+
+        case EventType::WindowFocus:
+            writer.Write(static_cast<u8>(static_cast<const WindowFocusedEvent&>(event).IsFocused()));
+            break;
+
+        case EventType::KeyDown:
+            {
+                const auto& keyDown = static_cast<const KeyDownEvent&>(event);
+                writer.Write(keyDown.GetScancode());
+                writer.Write(keyDown.GetRepetitionCount());
+                break;
+            }
+
+        case EventType::KeyUp:
+        case EventType::KeyTyped:
+            writer.Write(static_cast<const KeyEvent&>(event).GetScancode());
+            break;
+
+        case EventType::MouseButtonDown:
+        case EventType::MouseButtonUp:
+            writer.Write(static_cast<const MouseButtonEvent&>(event).GetButton());
+            break;
+
+        case EventType::MouseMoved:
+            {
+                const auto& mouseMoved = static_cast<const MouseMovedEvent&>(event);
+                writer.Write(mouseMoved.GetX());
+                writer.Write(mouseMoved.GetY());
+                break;
+            }
+
+        case EventType::MouseScroll:
+            {
+                const auto& mouseScrolled = static_cast<const MouseScrolledEvent&>(event);
+                writer.Write(mouseScrolled.GetXOffset());
+                writer.Write(mouseScrolled.GetYOffset());
+                break;
+            }
+
+        case EventType::User:
+            {
+                const auto& userEvent = static_cast<const UserEvent&>(event);
+                writer.Write(userEvent.GetCode());
+                writer.Write(userEvent.GetData());
+                break;
+            }
+
+        default:
+            Log::EngineWarn("Tried to record an event of unknown type.");
+            return;
+        }
+
+        writer.Flush(m_File);
+
+        m_LastFrameIndex = frameIndex;
+        m_RecordedCount++;
+    }
+
+    bool EventRecording::Load(const std::filesystem::path& path) {
+        m_Events.clear();
+        m_FrameCount = 0;
+        m_Cursor = 0;
+
+        MemoryMappedFile file;
+        if (!file.OpenRead(path)) {
+            return false;
+        }
+
+        const std::span<const std::byte> data = file.GetSpan();
+        const size headerSize = EventRecordingMagic.size() + sizeof(u32);
+
+        u32 version = 0;
+        if (data.size() >= headerSize) {
+            std::memcpy(&version, data.data() + EventRecordingMagic.size(), sizeof(version));
+        }
+
+        if (data.size() < headerSize ||
+            std::memcmp(data.data(), EventRecordingMagic.data(), EventRecordingMagic.size()) != 0 ||
+            version != EventRecordingVersion) {
+            Log::EngineError(fmt::format("{0} is not an event recording.", path.string()));
+            return false;
+        }
+
+        RecordReader reader(data, headerSize);
+        u64 frameIndex = 0;
+
+        while (!reader.IsAtEnd()) {
+            const auto type = static_cast<EventType>(reader.Read<u8>());
+            frameIndex += reader.ReadVarint();
+
+            if (type == EventType::Undefined) {
+                m_FrameCount = frameIndex;
+                return !reader.HasFailed();
+            }
+
+            std::optional<EventStorage> event = ReadEvent(type, reader);
+            if (!event || reader.HasFailed()) {
+                break;
+            }
+
+            m_Events.push_back({frameIndex, *event});
+        }
+
+        // No end record, the application probably didn't shut down cleanly. Keep what could be read.
+        Log::EngineWarn(fmt::format("Event recording {0} is truncated.", path.string()));
+        m_FrameCount = frameIndex + 1;
+
+        return true;
+    }
+}
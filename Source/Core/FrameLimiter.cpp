@@ -0,0 +1,34 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/FrameLimiter.hpp>
+
+#include <cmath>
+#include <thread>
+
+namespace Flashlight {
+    void FrameLimiter::WaitUntil(const Clock::time_point deadline) {
+        using Seconds = std::chrono::duration<f64>;
+
+        f64 remaining = Seconds(deadline - Clock::now()).count();
+
+        while (remaining > m_SleepEstimate) {
+            const auto sleepStart = Clock::now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            const f64 observed = Seconds(Clock::now() - sleepStart).count();
+            remaining -= observed;
+
+            // Welford's running variance, the estimate is the mean plus one standard deviation of a 1ms sleep.
+            m_SleepCount++;
+            const f64 delta = observed - m_SleepMean;
+            m_SleepMean += delta / static_cast<f64>(m_SleepCount);
+            m_SleepM2 += delta * (observed - m_SleepMean);
+            m_SleepEstimate = m_SleepMean + std::sqrt(m_SleepM2 / static_cast<f64>(m_SleepCount - 1));
+        }
+
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Hash.hpp>
+
+#include <bit>
+#include <cstring>
+
+namespace Flashlight {
+    namespace {
+        constexpr u64 Prime1 = 0x9E3779B185EBCA87ull;
+        constexpr u64 Prime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr u64 Prime3 = 0x165667B19E3779F9ull;
+        constexpr u64 Prime4 = 0x85EBCA77C2B2AE63ull;
+        constexpr u64 Prime5 = 0x27D4EB2F165667C5ull;
+
+        // The engine only targets x64, which is little endian.
+        template <typename T>
+        T ReadLittleEndian(const std::byte* input) {
+            T value;
+            std::memcpy(&value, input, sizeof(T));
+            return value;
+        }
+
+        u64 Round(u64 accumulator, const u64 input) {
+            accumulator += input * Prime2;
+            accumulator = std::rotl(accumulator, 31);
+            return accumulator * Prime1;
+        }
+
+        u64 MergeRound(u64 accumulator, const u64 value) {
+            accumulator ^= Round(0, value);
+            return accumulator * Prime1 + Prime4;
+        }
+    }
+
+    u64 HashXxh64(const std::span<const std::byte> data, const u64 seed) {
+        const std::byte* input = data.data();
+        const std::byte* end = input + data.size();
+        u64 hash;
+
+        if (data.size() >= 32) {
+            u64 v1 = seed + Prime1 + Prime2;
+            u64 v2 = seed + Prime2;
+            u64 v3 = seed;
+            u64 v4 = seed - Prime1;
+
+            for (const std::byte* limit = end - 32; input <= limit; input += 32) {
+                v1 = Round(v1, ReadLittleEndian<u64>(input));
+                v2 = Round(v2, ReadLittleEndian<u64>(input + 8));
+                v3 = Round(v3, ReadLittleEndian<u64>(input + 16));
+                v4 = Round(v4, ReadLittleEndian<u64>(input + 24));
+            }
+
+            hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        } else {
+            hash = seed + Prime5;
+        }
+
+        hash += data.size();
+
+        for (; end - input >= 8; input += 8) {
+            hash ^= Round(0, ReadLittleEndian<u64>(input));
+            hash = std::rotl(hash, 27) * Prime1 + Prime4;
+        }
+
+        if (end - input >= 4) {
+            hash ^= ReadLittleEndian<u32>(input) * Prime1;
+            hash = std::rotl(hash, 23) * Prime2 + Prime3;
+            input += 4;
+        }
+
+        for (; input < end; input++) {
+            hash ^= static_cast<u64>(*input) * Prime5;
+            hash = std::rotl(hash, 11) * Prime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/HeadlessWindow.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+namespace Flashlight {
+    HeadlessWindow::HeadlessWindow(const WindowProperties& windowProperties)
+        : m_TimeStep(windowProperties.HeadlessTimeStep) {
+        Log::EngineTrace("Creating headless window.");
+
+        m_Data.Width = windowProperties.Width;
+        m_Data.Height = windowProperties.Height;
+        m_Data.Title = windowProperties.Title;
+        m_Data.VSyncEnabled = windowProperties.VSync;
+        m_Data.Focused = true;
+    }
+
+    void HeadlessWindow::Update() {
+        FL_PROFILE_ZONE("Window::Update");
+
+        m_Time += m_TimeStep;
+
+        while (!m_ScheduledEvents.empty() && m_ScheduledEvents.front().Time <= m_Time) {
+            Deliver(m_ScheduledEvents.front().Event);
+            m_ScheduledEvents.pop_front();
+        }
+    }
+
+    void HeadlessWindow::Deliver(const EventStorage& event) {
+        std::visit([this](const auto& concreteEvent) {
+            using ConcreteEvent = std::decay_t<decltype(concreteEvent)>;
+
+            // Keep the window state in sync the way the GLFW callbacks do.
+            if constexpr (std::is_same_v<ConcreteEvent, WindowResizeEvent>) {
+                m_Data.Width = static_cast<i32>(concreteEvent.GetWidth());
+                m_Data.Height = static_cast<i32>(concreteEvent.GetHeight());
+                m_Data.ShouldInvalidateSwapchain = true;
+            } else if constexpr (std::is_same_v<ConcreteEvent, WindowFocusedEvent>) {
+                m_Data.Focused = concreteEvent.IsFocused();
+            } else if constexpr (std::is_same_v<ConcreteEvent, WindowCloseEvent>) {
+                m_ShouldClose = true;
+            }
+
+            QueueEvent(m_Data, concreteEvent);
+        }, event);
+    }
+}
@@ -0,0 +1,114 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Input.hpp>
+
+namespace Flashlight {
+    namespace {
+        template <u32 BitCount>
+        void Press(InputBits<BitCount>& down, InputBits<BitCount>& pressed, const u32 index) {
+            // Key repeats arrive as more down events, only the first one is an edge.
+            if (!down.Test(index)) {
+                pressed.Set(index, true);
+            }
+            down.Set(index, true);
+        }
+
+        template <u32 BitCount>
+        void Release(InputBits<BitCount>& down, InputBits<BitCount>& released, const u32 index) {
+            if (down.Test(index)) {
+                released.Set(index, true);
+            }
+            down.Set(index, false);
+        }
+
+        template <u32 BitCount>
+        void ReleaseAll(InputBits<BitCount>& down, InputBits<BitCount>& released) {
+            for (size i = 0; i < down.Words.size(); i++) {
+                released.Words[i] |= down.Words[i];
+            }
+            down.Reset();
+        }
+    }
+
+    void Input::OnEvent(const Event& event) {
+        switch (event.GetEventType()) {
+        case EventType::KeyDown:
+            Press(m_Pending.KeysDown, m_Pending.KeysPressed,
+                  static_cast<u32>(static_cast<const KeyDownEvent&>(event).GetScancode()));
+            break;
+
+        case EventType::KeyUp:
+            Release(m_Pending.KeysDown, m_Pending.KeysReleased,
+                    static_cast<u32>(static_cast<const KeyUpEvent&>(event).GetScancode()));
+            break;
+
+        case EventType::MouseButtonDown:
+            Press(m_Pending.ButtonsDown, m_Pending.ButtonsPressed,
+                  static_cast<u32>(static_cast<const MouseButtonDownEvent&>(event).GetButton()));
+            break;
+
+        case EventType::MouseButtonUp:
+            Release(m_Pending.ButtonsDown, m_Pending.ButtonsReleased,
+                    static_cast<u32>(static_cast<const MouseButtonUpEvent&>(event).GetButton()));
+            break;
+
+        case EventType::MouseMoved:
+            {
+                const auto& mouseMoved = static_cast<const MouseMovedEvent&>(event);
+                m_Pending.MouseX = mouseMoved.GetX();
+                m_Pending.MouseY = mouseMoved.GetY();
+
+                // The first position only tells where the cursor is, it isn't a move from the origin.
+                if (!m_HasMousePosition) {
+                    m_PublishedMouseX = m_Pending.MouseX;
+                    m_PublishedMouseY = m_Pending.MouseY;
+                    m_HasMousePosition = true;
+                }
+                break;
+            }
+
+        case EventType::MouseScroll:
+            {
+                const auto& mouseScrolled = static_cast<const MouseScrolledEvent&>(event);
+                m_Pending.ScrollX += mouseScrolled.GetXOffset();
+                m_Pending.ScrollY += mouseScrolled.GetYOffset();
+                break;
+            }
+
+        case EventType::WindowFocus:
+            // The release events of keys held while losing focus never arrive, release everything now.
+            if (!static_cast<const WindowFocusedEvent&>(event).IsFocused()) {
+                ReleaseAll(m_Pending.KeysDown, m_Pending.KeysReleased);
+                ReleaseAll(m_Pending.ButtonsDown, m_Pending.ButtonsReleased);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void Input::Publish() {
+        const u32 backIndex = m_FrontIndex.load(std::memory_order_relaxed) ^ 1;
+
+        m_Pending.MouseDeltaX = m_Pending.MouseX - m_PublishedMouseX;
+        m_Pending.MouseDeltaY = m_Pending.MouseY - m_PublishedMouseY;
+        m_Pending.FrameIndex++;
+
+        m_Snapshots[backIndex] = m_Pending;
+        m_FrontIndex.store(backIndex, std::memory_order_release);
+
+        // Edges and scroll are per frame, the held state carries over.
+        m_Pending.KeysPressed.Reset();
+        m_Pending.KeysReleased.Reset();
+        m_Pending.ButtonsPressed.Reset();
+        m_Pending.ButtonsReleased.Reset();
+        m_Pending.ScrollX = 0.0f;
+        m_Pending.ScrollY = 0.0f;
+
+        m_PublishedMouseX = m_Pending.MouseX;
+        m_PublishedMouseY = m_Pending.MouseY;
+    }
+}
@@ -0,0 +1,259 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+namespace Flashlight {
+    namespace {
+        constexpr u32 DequeCapacity = 4096;
+        // Only busy slots can be in the deque, so it never fills up before the pool does.
+        constexpr u32 JobPoolSize = DequeCapacity;
+        constexpr u32 ExternalQueueCapacity = 1024;
+        constexpr u32 IdleSpinCount = 256;
+        constexpr u32 NotAWorker = ~0u;
+
+        thread_local u32 t_WorkerIndex = NotAWorker;
+        thread_local const JobSystem* t_JobSystem = nullptr;
+
+        u32 CurrentWorkerIndex(const JobSystem* jobSystem) {
+            return t_JobSystem == jobSystem ? t_WorkerIndex : NotAWorker;
+        }
+    }
+
+    WorkStealingDeque::WorkStealingDeque(const u32 capacity) {
+        m_Buffer = std::make_unique<std::atomic<PooledJob*>[]>(capacity);
+        m_Mask = static_cast<i64>(capacity) - 1;
+    }
+
+    bool WorkStealingDeque::Push(PooledJob* job) {
+        const i64 bottom = m_Bottom.load(std::memory_order_relaxed);
+        const i64 top = m_Top.load(std::memory_order_acquire);
+
+        if (bottom - top > m_Mask) {
+            return false;
+        }
+
+        m_Buffer[bottom & m_Mask].store(job, std::memory_order_relaxed);
+        m_Bottom.store(bottom + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    PooledJob* WorkStealingDeque::Pop() {
+        const i64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        PooledJob* job = m_Buffer[bottom & m_Mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last job, race against thieves for it.
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    PooledJob* WorkStealingDeque::Steal() {
+        i64 top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const i64 bottom = m_Bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        PooledJob* job = m_Buffer[top & m_Mask].load(std::memory_order_relaxed);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+
+        return job;
+    }
+
+    JobSystem::Worker::Worker(const u32 index) : Deque(DequeCapacity),
+                                                 JobPool(std::make_unique<PooledJob[]>(JobPoolSize)),
+                                                 RandomState(index * 2654435761u + 1) {
+    }
+
+    JobSystem::JobSystem(u32 workerCount) : m_ExternalQueue(ExternalQueueCapacity) {
+        if (workerCount == 0) {
+            workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        for (u32 i = 0; i < workerCount; i++) {
+            m_Workers.push_back(std::make_unique<Worker>(i));
+        }
+
+        t_WorkerIndex = 0;
+        t_JobSystem = this;
+
+        for (u32 i = 1; i < workerCount; i++) {
+            m_Threads.emplace_back(&JobSystem::WorkerMain, this, i);
+        }
+
+        Log::EngineTrace(fmt::format("Job system started with {0} workers.", workerCount));
+    }
+
+    JobSystem::~JobSystem() {
+        m_Running.store(false, std::memory_order_release);
+        m_WorkSignal.fetch_add(1, std::memory_order_release);
+        m_WorkSignal.notify_all();
+
+        for (std::thread& thread : m_Threads) {
+            thread.join();
+        }
+
+        if (t_JobSystem == this) {
+            t_WorkerIndex = NotAWorker;
+            t_JobSystem = nullptr;
+        }
+    }
+
+    void JobSystem::Wait(const JobCounter& counter) {
+        u32 spinCount = 0;
+
+        while (!counter.IsDone()) {
+            if (RunOneJob()) {
+                spinCount = 0;
+            } else if (++spinCount > IdleSpinCount) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::Submit(const Job& job) {
+        const u32 workerIndex = CurrentWorkerIndex(this);
+
+        if (workerIndex == NotAWorker) {
+            while (!m_ExternalQueue.TryPush(job)) {
+                std::this_thread::yield();
+            }
+        } else {
+            Worker& worker = *m_Workers[workerIndex];
+            PooledJob& slot = worker.JobPool[worker.NextJob++ & (JobPoolSize - 1)];
+
+            // The slot's job is still queued or running, the pool is full around here: running the new job right away
+            // is the cheapest form of backpressure. The next submission tries the next slot.
+            if (slot.Busy.load(std::memory_order_acquire)) {
+                job.Execute();
+                return;
+            }
+
+            slot.Work = job;
+            slot.Busy.store(true, std::memory_order_relaxed);
+
+            if (!worker.Deque.Push(&slot)) {
+                slot.Busy.store(false, std::memory_order_relaxed);
+                job.Execute();
+                return;
+            }
+        }
+
+        WakeWorkers();
+    }
+
+    bool JobSystem::RunOneJob() {
+        const u32 workerIndex = CurrentWorkerIndex(this);
+        if (workerIndex != NotAWorker) {
+            return RunWorkerJob(workerIndex);
+        }
+
+        Job externalJob;
+        if (m_ExternalQueue.TryPop(externalJob)) {
+            externalJob.Execute();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool JobSystem::RunWorkerJob(const u32 workerIndex) {
+        Worker& worker = *m_Workers[workerIndex];
+
+        if (PooledJob* job = worker.Deque.Pop()) {
+            job->Run();
+            return true;
+        }
+
+        Job externalJob;
+        if (m_ExternalQueue.TryPop(externalJob)) {
+            externalJob.Execute();
+            return true;
+        }
+
+        const u32 workerCount = GetWorkerCount();
+        if (workerCount < 2) {
+            return false;
+        }
+
+        // Start stealing at a random victim so thieves don't all hammer the same deque.
+        worker.RandomState ^= worker.RandomState << 13;
+        worker.RandomState ^= worker.RandomState >> 17;
+        worker.RandomState ^= worker.RandomState << 5;
+        const u32 start = worker.RandomState % workerCount;
+
+        for (u32 i = 0; i < workerCount; i++) {
+            const u32 victim = (start + i) % workerCount;
+            if (victim == workerIndex) {
+                continue;
+            }
+
+            if (PooledJob* job = m_Workers[victim]->Deque.Steal()) {
+                job->Run();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::WorkerMain(const u32 workerIndex) {
+        t_WorkerIndex = workerIndex;
+        t_JobSystem = this;
+
+        Profiler::SetThreadName(fmt::format("Worker {0}", workerIndex));
+
+        u32 spinCount = 0;
+
+        while (m_Running.load(std::memory_order_acquire)) {
+            const u32 signal = m_WorkSignal.load(std::memory_order_acquire);
+
+            if (RunWorkerJob(workerIndex)) {
+                spinCount = 0;
+                continue;
+            }
+
+            if (++spinCount < IdleSpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Nothing to do for a while, sleep until a job is submitted.
+            m_SleepingWorkers.fetch_add(1, std::memory_order_acq_rel);
+            m_WorkSignal.wait(signal, std::memory_order_acquire);
+            m_SleepingWorkers.fetch_sub(1, std::memory_order_acq_rel);
+            spinCount = 0;
+        }
+    }
+
+    void JobSystem::WakeWorkers() {
+        m_WorkSignal.fetch_add(1, std::memory_order_acq_rel);
+
+        if (m_SleepingWorkers.load(std::memory_order_acquire) > 0) {
+            m_WorkSignal.notify_one();
+        }
+    }
+}
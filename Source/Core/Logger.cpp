@@ -4,27 +4,300 @@
 
 #include <FlashlightEngine/Core/Logger.hpp>
 
+#include <FlashlightEngine/Core/BoundedQueue.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/base_sink.h>
+#include <spdlog/details/null_mutex.h>
+
+#include <mutex>
+#include <thread>
 
 namespace Flashlight {
     std::shared_ptr<spdlog::logger> Logger::m_EngineLogger;
     std::shared_ptr<spdlog::logger> Logger::m_EditorLogger;
 
-    void Logger::Init() {
-        spdlog::set_pattern("%^[%T](%l) %n : %v%$");
+    namespace {
+        constexpr auto LogPattern = "%^[%T](%l) %n : %v%$";
 
-        m_EngineLogger = spdlog::stdout_color_mt("FlashlightEngine");
-        m_EngineLogger->set_level(spdlog::level::trace);
+        class AsyncSink;
+
+        // A queued message. The payload is copied inline so enqueuing never allocates, longer messages are truncated.
+        struct AsyncLogSlot {
+            AsyncSink* Sink = nullptr;
+            spdlog::log_clock::time_point Time;
+            size ThreadId = 0;
+            spdlog::string_view_t LoggerName;
+            spdlog::level::level_enum Level = spdlog::level::off;
+            u32 Length = 0;
+            std::array<char, 432> Payload;
+        };
+
+        /*
+         * AsyncLogBackend : Owns the preallocated message queue shared by every asynchronous logger and the thread
+         * writing the queued messages to their real sinks.
+         */
+        class AsyncLogBackend {
+            BoundedQueue<AsyncLogSlot> m_Queue;
+            LogOverflowPolicy m_OverflowPolicy;
+
+            alignas(CacheLineSize) std::atomic<u64> m_EnqueuedCount{0};
+            std::atomic<u64> m_DroppedCount{0};
+            alignas(CacheLineSize) std::atomic<u64> m_ConsumedCount{0};
+            std::atomic<bool> m_Running{true};
+
+            std::thread m_FlushThread;
+
+        public:
+            AsyncLogBackend(u32 capacity, LogOverflowPolicy overflowPolicy);
+            ~AsyncLogBackend();
+
+            AsyncLogBackend(const AsyncLogBackend&) = delete;
+            AsyncLogBackend(AsyncLogBackend&&) = delete;
+
+            AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+            AsyncLogBackend& operator=(AsyncLogBackend&&) = delete;
+
+            void Enqueue(AsyncSink* sink, const spdlog::details::log_msg& msg);
+
+            // Blocks until every message enqueued before the call has been written.
+            void WaitForFlush() const;
+
+            [[nodiscard]] u64 GetDroppedCount() const {
+                return m_DroppedCount.load(std::memory_order_relaxed);
+            }
+
+        private:
+            void FlushThreadMain();
+        };
+
+        /*
+         * AsyncSink : Sink attached to an asynchronous logger. Logging only copies the message into the backend queue,
+         * the flush thread then forwards it to the sinks registered here.
+         */
+        class AsyncSink final : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+            AsyncLogBackend& m_Backend;
+            std::mutex m_TargetsMutex;
+            std::vector<spdlog::sink_ptr> m_Targets;
+
+        public:
+            explicit AsyncSink(AsyncLogBackend& backend) : m_Backend(backend) {
+            }
+
+            void AddTarget(spdlog::sink_ptr target) {
+                std::scoped_lock lock(m_TargetsMutex);
+                m_Targets.push_back(std::move(target));
+            }
+
+            // Called from the flush thread only.
+            void Forward(const spdlog::details::log_msg& msg) {
+                std::scoped_lock lock(m_TargetsMutex);
+                for (const auto& target : m_Targets) {
+                    if (target->should_log(msg.level)) {
+                        target->log(msg);
+                    }
+                }
+            }
+
+        protected:
+            void sink_it_(const spdlog::details::log_msg& msg) override {
+                m_Backend.Enqueue(this, msg);
+            }
+
+            void flush_() override {
+                m_Backend.WaitForFlush();
+
+                std::scoped_lock lock(m_TargetsMutex);
+                for (const auto& target : m_Targets) {
+                    target->flush();
+                }
+            }
+
+            void set_pattern_(const std::string& pattern) override {
+                std::scoped_lock lock(m_TargetsMutex);
+                for (const auto& target : m_Targets) {
+                    target->set_pattern(pattern);
+                }
+            }
+
+            void set_formatter_(std::unique_ptr<spdlog::formatter> sinkFormatter) override {
+                std::scoped_lock lock(m_TargetsMutex);
+                for (const auto& target : m_Targets) {
+                    target->set_formatter(sinkFormatter->clone());
+                }
+            }
+        };
+
+        AsyncLogBackend::AsyncLogBackend(const u32 capacity, const LogOverflowPolicy overflowPolicy)
+            : m_Queue(capacity), m_OverflowPolicy(overflowPolicy) {
+            m_FlushThread = std::thread(&AsyncLogBackend::FlushThreadMain, this);
+        }
+
+        AsyncLogBackend::~AsyncLogBackend() {
+            m_Running.store(false, std::memory_order_release);
+            m_FlushThread.join();
+        }
+
+        void AsyncLogBackend::Enqueue(AsyncSink* sink, const spdlog::details::log_msg& msg) {
+            AsyncLogSlot slot;
+            slot.Sink = sink;
+            slot.Time = msg.time;
+            slot.ThreadId = msg.thread_id;
+            slot.LoggerName = msg.logger_name;
+            slot.Level = msg.level;
+            slot.Length = static_cast<u32>(std::min(msg.payload.size(), slot.Payload.size()));
+            std::memcpy(slot.Payload.data(), msg.payload.data(), slot.Length);
+
+            if (msg.payload.size() > slot.Payload.size()) {
+                std::memcpy(slot.Payload.data() + slot.Payload.size() - 3, "...", 3);
+            }
+
+            while (!m_Queue.TryPush(slot)) {
+                switch (m_OverflowPolicy) {
+                case LogOverflowPolicy::Block:
+                    std::this_thread::yield();
+                    break;
+
+                case LogOverflowPolicy::DropOldest:
+                    {
+                        AsyncLogSlot discarded;
+                        if (m_Queue.TryPop(discarded)) {
+                            m_ConsumedCount.fetch_add(1, std::memory_order_release);
+                            m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        break;
+                    }
+
+                case LogOverflowPolicy::DropNewest:
+                    m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+
+            m_EnqueuedCount.fetch_add(1, std::memory_order_release);
+        }
+
+        void AsyncLogBackend::WaitForFlush() const {
+            const u64 target = m_EnqueuedCount.load(std::memory_order_acquire);
+            while (m_ConsumedCount.load(std::memory_order_acquire) < target) {
+                std::this_thread::yield();
+            }
+        }
 
-        m_EditorLogger = spdlog::stdout_color_mt("Flashlight Editor");
+        void AsyncLogBackend::FlushThreadMain() {
+            Profiler::SetThreadName("Log Flush Thread");
+
+            AsyncLogSlot slot;
+            u32 idleIterations = 0;
+
+            // Keep going after a stop request until the queue is empty so no message is lost on shutdown.
+            while (m_Running.load(std::memory_order_acquire) || m_Queue.GetApproximateSize() > 0) {
+                if (!m_Queue.TryPop(slot)) {
+                    // Spin briefly, then back off to sleeping so an idle logger doesn't keep a core busy.
+                    if (++idleIterations < 64) {
+                        std::this_thread::yield();
+                    } else {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    continue;
+                }
+
+                idleIterations = 0;
+
+                FL_PROFILE_ZONE("Logger::WriteMessage");
+
+                spdlog::details::log_msg msg(slot.Time, spdlog::source_loc{}, slot.LoggerName, slot.Level,
+                                             spdlog::string_view_t(slot.Payload.data(), slot.Length));
+                msg.thread_id = slot.ThreadId;
+                slot.Sink->Forward(msg);
+
+                m_ConsumedCount.fetch_add(1, std::memory_order_release);
+            }
+        }
+
+        std::unique_ptr<AsyncLogBackend> s_AsyncBackend;
+        std::shared_ptr<AsyncSink> s_EngineAsyncSink;
+        std::shared_ptr<AsyncSink> s_EditorAsyncSink;
+
+        std::shared_ptr<spdlog::logger> CreateAsyncLogger(const std::string& name, std::shared_ptr<AsyncSink>& sink,
+                                                          const bool consoleOutput) {
+            sink = std::make_shared<AsyncSink>(*s_AsyncBackend);
+
+            if (consoleOutput) {
+                auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+                consoleSink->set_pattern(LogPattern);
+                sink->AddTarget(std::move(consoleSink));
+            }
+
+            auto logger = std::make_shared<spdlog::logger>(name, sink);
+            spdlog::register_logger(logger);
+
+            return logger;
+        }
+
+        std::shared_ptr<spdlog::logger> CreateLogger(const std::string& name, const bool consoleOutput) {
+            if (consoleOutput) {
+                return spdlog::stdout_color_mt(name);
+            }
+
+            auto logger = std::make_shared<spdlog::logger>(name);
+            spdlog::register_logger(logger);
+
+            return logger;
+        }
+    }
+
+    void Logger::Init(const LoggerSettings& settings) {
+        spdlog::set_pattern(LogPattern);
+
+        if (settings.Mode == LogMode::Asynchronous) {
+            s_AsyncBackend = std::make_unique<AsyncLogBackend>(settings.QueueCapacity, settings.OverflowPolicy);
+
+            m_EngineLogger = CreateAsyncLogger("FlashlightEngine", s_EngineAsyncSink, settings.ConsoleOutput);
+            m_EditorLogger = CreateAsyncLogger("Flashlight Editor", s_EditorAsyncSink, settings.ConsoleOutput);
+        } else {
+            m_EngineLogger = CreateLogger("FlashlightEngine", settings.ConsoleOutput);
+            m_EditorLogger = CreateLogger("Flashlight Editor", settings.ConsoleOutput);
+        }
+
+        m_EngineLogger->set_level(spdlog::level::trace);
         m_EditorLogger->set_level(spdlog::level::trace);
     }
 
+    void Logger::Shutdown() {
+        Flush();
+
+        // The backend goes first, its thread drains what is left in the queue while the sinks are still alive and
+        // the loggers still own the names the queued messages point to.
+        s_AsyncBackend.reset();
+
+        spdlog::drop_all();
+        m_EngineLogger.reset();
+        m_EditorLogger.reset();
+
+        s_EngineAsyncSink.reset();
+        s_EditorAsyncSink.reset();
+    }
+
+    void Logger::Flush() {
+        FL_PROFILE_ZONE("Logger::Flush");
+
+        if (m_EngineLogger) {
+            m_EngineLogger->flush();
+        }
+
+        if (m_EditorLogger) {
+            m_EditorLogger->flush();
+        }
+    }
+
     template <typename Mutex>
     class CallbackSink final : public spdlog::sinks::base_sink<Mutex> {
         customLogCallback m_Callback;
         spdlog::pattern_formatter m_Formatter;
+        spdlog::memory_buf_t m_FormattedBuffer;
+        std::string m_Message;
 
     public:
         explicit CallbackSink(customLogCallback callback) : m_Callback{std::move(callback)} {
@@ -32,11 +305,14 @@ namespace Flashlight {
 
     protected:
         void sink_it_(const spdlog::details::log_msg& msg) override {
-            spdlog::memory_buf_t formatted;
-            m_Formatter.format(msg, formatted);
+            // The buffers are reused between messages, they only allocate when a message is longer than every
+            // previous one.
+            m_FormattedBuffer.clear();
+            m_Formatter.format(msg, m_FormattedBuffer);
             const auto eol_len = strlen(spdlog::details::os::default_eol);
-            const std::string message(formatted.begin(), formatted.end() - eol_len);
-            m_Callback(msg.level, message + '\n');
+            m_Message.assign(m_FormattedBuffer.begin(), m_FormattedBuffer.end() - eol_len);
+            m_Message.push_back('\n');
+            m_Callback(msg.level, m_Message);
         }
 
         void flush_() override {
@@ -44,13 +320,27 @@ namespace Flashlight {
     };
 
     void Logger::AddEngineCallback(const customLogCallback& callback) {
+        if (s_EngineAsyncSink) {
+            s_EngineAsyncSink->AddTarget(std::make_shared<CallbackSink<spdlog::details::null_mutex>>(callback));
+            return;
+        }
+
         m_EngineLogger->sinks().push_back(std::make_shared<CallbackSink<std::mutex>>(callback));
     }
 
     void Logger::AddEditorCallback(const customLogCallback& callback) {
+        if (s_EditorAsyncSink) {
+            s_EditorAsyncSink->AddTarget(std::make_shared<CallbackSink<spdlog::details::null_mutex>>(callback));
+            return;
+        }
+
         m_EditorLogger->sinks().push_back(std::make_shared<CallbackSink<std::mutex>>(callback));
     }
 
+    u64 Logger::GetDroppedMessageCount() {
+        return s_AsyncBackend ? s_AsyncBackend->GetDroppedCount() : 0;
+    }
+
     namespace Log {
         std::string EvaluateEngineErrorCode(const ErrorCode& errorCode) {
             std::stringstream message;
@@ -69,6 +359,11 @@ namespace Flashlight {
 
             case 0x03:
                 message << "[FILESYSTEM] ";
+                break;
+
+            case 0x04:
+                message << "[SCENE] ";
+                break;
 
             default:
                 message << "[INVALID/UNKNOWN MODULE ID]";
@@ -0,0 +1,29 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Memory/FrameArena.hpp>
+
+namespace Flashlight {
+    namespace {
+        constexpr u64 ScratchArenaCapacity = 1024 * 1024;
+    }
+
+    FrameArena::FrameArena(const u64 capacityPerFrame) {
+        for (auto& arena : m_Arenas) {
+            arena = std::make_unique<LinearArena>(capacityPerFrame);
+        }
+    }
+
+    void FrameArena::BeginFrame() {
+        m_LastFrameStatistics = m_Arenas[m_CurrentIndex]->GetStatistics();
+
+        m_CurrentIndex ^= 1;
+        m_Arenas[m_CurrentIndex]->Reset();
+    }
+
+    LinearArena& GetScratchArena() {
+        thread_local LinearArena scratchArena(ScratchArenaCapacity);
+        return scratchArena;
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Memory/LinearArena.hpp>
+
+namespace Flashlight {
+    LinearArena::LinearArena(const u64 capacity, std::pmr::memory_resource* upstream)
+        : m_Buffer(std::make_unique_for_overwrite<std::byte[]>(capacity)), m_Capacity(capacity), m_Upstream(upstream) {
+    }
+
+    LinearArena::~LinearArena() {
+        Reset();
+    }
+
+    void LinearArena::Reset() {
+        m_PeakBytes = std::max(m_PeakBytes, m_Offset.load(std::memory_order_relaxed));
+        m_Offset.store(0, std::memory_order_relaxed);
+        m_AllocationCount.store(0, std::memory_order_relaxed);
+        m_OverflowCount.store(0, std::memory_order_relaxed);
+
+        ReleaseOverflow(0);
+    }
+
+    ArenaStatistics LinearArena::GetStatistics() const {
+        ArenaStatistics statistics;
+        statistics.AllocationCount = m_AllocationCount.load(std::memory_order_relaxed);
+        statistics.AllocatedBytes = std::min(m_Offset.load(std::memory_order_relaxed), m_Capacity);
+        statistics.PeakBytes = std::max(m_PeakBytes, statistics.AllocatedBytes);
+        statistics.OverflowCount = m_OverflowCount.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    void* LinearArena::do_allocate(const size_t bytes, const size_t alignment) {
+        m_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        const auto base = reinterpret_cast<std::uintptr_t>(m_Buffer.get());
+        u64 offset = m_Offset.load(std::memory_order_relaxed);
+
+        for (;;) {
+            const u64 alignedOffset = ((base + offset + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1))
+                                      - base;
+            const u64 newOffset = alignedOffset + bytes;
+
+            if (newOffset > m_Capacity) {
+                return AllocateOverflow(bytes, alignment);
+            }
+
+            if (m_Offset.compare_exchange_weak(offset, newOffset, std::memory_order_relaxed)) {
+                return m_Buffer.get() + alignedOffset;
+            }
+        }
+    }
+
+    void LinearArena::do_deallocate([[maybe_unused]] void* pointer, [[maybe_unused]] size_t bytes,
+                                    [[maybe_unused]] size_t alignment) {
+    }
+
+    bool LinearArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    void* LinearArena::AllocateOverflow(const size_t bytes, const size_t alignment) {
+        void* pointer = m_Upstream->allocate(bytes, alignment);
+        m_OverflowCount.fetch_add(1, std::memory_order_relaxed);
+
+        std::scoped_lock lock(m_OverflowMutex);
+        m_OverflowAllocations.emplace_back(pointer, bytes, alignment);
+
+        return pointer;
+    }
+
+    // Overflow allocations are freed newest first, back to the first keptCount ones.
+    void LinearArena::ReleaseOverflow(const size_t keptCount) {
+        std::scoped_lock lock(m_OverflowMutex);
+        while (m_OverflowAllocations.size() > keptCount) {
+            const auto& [pointer, bytes, alignment] = m_OverflowAllocations.back();
+            m_Upstream->deallocate(pointer, bytes, alignment);
+            m_OverflowAllocations.pop_back();
+        }
+    }
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Memory/PoolAllocator.hpp>
+
+namespace Flashlight {
+    PoolResource::PoolResource(const size_t blockSize, const size_t blockAlignment, const u32 blocksPerChunk,
+                               std::pmr::memory_resource* upstream)
+        : m_BlockAlignment(std::max(blockAlignment, alignof(FreeBlock))),
+          m_BlocksPerChunk(std::max(blocksPerChunk, 1u)), m_Upstream(upstream) {
+        // Every block must be able to hold a free list link and keep the next block aligned.
+        const size_t size = std::max(blockSize, sizeof(FreeBlock));
+        m_BlockSize = (size + m_BlockAlignment - 1) & ~(m_BlockAlignment - 1);
+    }
+
+    PoolResource::~PoolResource() {
+        for (const auto& [chunk, bytes] : m_Chunks) {
+            m_Upstream->deallocate(chunk, bytes, m_BlockAlignment);
+        }
+    }
+
+    PoolStatistics PoolResource::GetStatistics() const {
+        PoolStatistics statistics;
+        statistics.AllocationCount = m_AllocationCount;
+        statistics.LiveBlocks = m_LiveBlocks;
+        statistics.ReservedBlocks = static_cast<u64>(m_Chunks.size()) * m_BlocksPerChunk;
+
+        return statistics;
+    }
+
+    void* PoolResource::do_allocate(const size_t bytes, const size_t alignment) {
+        if (bytes > m_BlockSize || alignment > m_BlockAlignment) {
+            return m_Upstream->allocate(bytes, alignment);
+        }
+
+        if (m_FreeList == nullptr) {
+            AllocateChunk();
+        }
+
+        FreeBlock* block = m_FreeList;
+        m_FreeList = block->Next;
+
+        m_AllocationCount++;
+        m_LiveBlocks++;
+
+        return block;
+    }
+
+    void PoolResource::do_deallocate(void* pointer, const size_t bytes, const size_t alignment) {
+        if (bytes > m_BlockSize || alignment > m_BlockAlignment) {
+            m_Upstream->deallocate(pointer, bytes, alignment);
+            return;
+        }
+
+        const auto block = static_cast<FreeBlock*>(pointer);
+        block->Next = m_FreeList;
+        m_FreeList = block;
+
+        m_LiveBlocks--;
+    }
+
+    bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    void PoolResource::AllocateChunk() {
+        const size_t chunkSize = m_BlockSize * m_BlocksPerChunk;
+        auto* chunk = static_cast<std::byte*>(m_Upstream->allocate(chunkSize, m_BlockAlignment));
+        m_Chunks.emplace_back(chunk, chunkSize);
+
+        // Link the blocks in address order so consecutive allocations are contiguous.
+        for (u32 i = m_BlocksPerChunk; i > 0; i--) {
+            const auto block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * m_BlockSize);
+            block->Next = m_FreeList;
+            m_FreeList = block;
+        }
+    }
+}
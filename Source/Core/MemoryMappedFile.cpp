@@ -0,0 +1,215 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/MemoryMappedFile.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Flashlight {
+    MemoryMappedFile::~MemoryMappedFile() {
+        Close();
+    }
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+
+            m_Data = std::exchange(other.m_Data, nullptr);
+            m_Size = std::exchange(other.m_Size, 0);
+            m_Writable = std::exchange(other.m_Writable, false);
+#ifdef _WIN32
+            m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+            m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+#else
+            m_FileDescriptor = std::exchange(other.m_FileDescriptor, -1);
+#endif
+        }
+
+        return *this;
+    }
+
+#ifdef _WIN32
+    bool MemoryMappedFile::OpenRead(const std::filesystem::path& path) {
+        Close();
+
+        m_FileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_FileHandle == INVALID_HANDLE_VALUE) {
+            m_FileHandle = nullptr;
+            Log::EngineError(fmt::format("Failed to open file {0}.", path.string()));
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(m_FileHandle, &fileSize);
+        m_Size = static_cast<u64>(fileSize.QuadPart);
+
+        if (m_Size == 0) {
+            Close();
+            return false;
+        }
+
+        m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_MappingHandle != nullptr) {
+            m_Data = static_cast<std::byte*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+        }
+
+        if (m_Data == nullptr) {
+            Log::EngineError(fmt::format("Failed to map file {0}.", path.string()));
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool MemoryMappedFile::Create(const std::filesystem::path& path, const u64 size) {
+        Close();
+
+        m_FileHandle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                   CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_FileHandle == INVALID_HANDLE_VALUE) {
+            m_FileHandle = nullptr;
+            Log::EngineError(fmt::format("Failed to create file {0}.", path.string()));
+            return false;
+        }
+
+        m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                             static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+        if (m_MappingHandle != nullptr) {
+            m_Data = static_cast<std::byte*>(MapViewOfFile(m_MappingHandle, FILE_MAP_WRITE, 0, 0, 0));
+        }
+
+        if (m_Data == nullptr) {
+            Log::EngineError(fmt::format("Failed to map file {0}.", path.string()));
+            Close();
+            return false;
+        }
+
+        m_Size = size;
+        m_Writable = true;
+
+        return true;
+    }
+
+    void MemoryMappedFile::Close(const u64 finalSize) {
+        if (m_Data != nullptr) {
+            UnmapViewOfFile(m_Data);
+            m_Data = nullptr;
+        }
+
+        if (m_MappingHandle != nullptr) {
+            CloseHandle(m_MappingHandle);
+            m_MappingHandle = nullptr;
+        }
+
+        if (m_FileHandle != nullptr) {
+            if (m_Writable && finalSize < m_Size) {
+                LARGE_INTEGER position;
+                position.QuadPart = static_cast<LONGLONG>(finalSize);
+                SetFilePointerEx(m_FileHandle, position, nullptr, FILE_BEGIN);
+                SetEndOfFile(m_FileHandle);
+            }
+
+            CloseHandle(m_FileHandle);
+            m_FileHandle = nullptr;
+        }
+
+        m_Size = 0;
+        m_Writable = false;
+    }
+#else
+    bool MemoryMappedFile::OpenRead(const std::filesystem::path& path) {
+        Close();
+
+        m_FileDescriptor = open(path.c_str(), O_RDONLY);
+        if (m_FileDescriptor < 0) {
+            Log::EngineError(fmt::format("Failed to open file {0}.", path.string()));
+            return false;
+        }
+
+        struct stat fileStatus{};
+        if (fstat(m_FileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0) {
+            Close();
+            return false;
+        }
+
+        m_Size = static_cast<u64>(fileStatus.st_size);
+
+        void* data = mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, m_FileDescriptor, 0);
+        if (data == MAP_FAILED) {
+            Log::EngineError(fmt::format("Failed to map file {0}.", path.string()));
+            Close();
+            return false;
+        }
+
+        m_Data = static_cast<std::byte*>(data);
+
+        return true;
+    }
+
+    bool MemoryMappedFile::Create(const std::filesystem::path& path, const u64 size) {
+        Close();
+
+        m_FileDescriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m_FileDescriptor < 0) {
+            Log::EngineError(fmt::format("Failed to create file {0}.", path.string()));
+            return false;
+        }
+
+        if (ftruncate(m_FileDescriptor, static_cast<off_t>(size)) != 0) {
+            Log::EngineError(fmt::format("Failed to resize file {0}.", path.string()));
+            Close();
+            return false;
+        }
+
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_FileDescriptor, 0);
+        if (data == MAP_FAILED) {
+            Log::EngineError(fmt::format("Failed to map file {0}.", path.string()));
+            Close();
+            return false;
+        }
+
+        m_Data = static_cast<std::byte*>(data);
+        m_Size = size;
+        m_Writable = true;
+
+        return true;
+    }
+
+    void MemoryMappedFile::Close(const u64 finalSize) {
+        if (m_Data != nullptr) {
+            munmap(m_Data, m_Size);
+            m_Data = nullptr;
+        }
+
+        if (m_FileDescriptor >= 0) {
+            if (m_Writable && finalSize < m_Size) {
+                [[maybe_unused]] const i32 result = ftruncate(m_FileDescriptor, static_cast<off_t>(finalSize));
+            }
+
+            close(m_FileDescriptor);
+            m_FileDescriptor = -1;
+        }
+
+        m_Size = 0;
+        m_Writable = false;
+    }
+#endif
+}
@@ -0,0 +1,294 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#if !defined(_MSC_VER) && (defined(__x86_64__) || defined(__i386__))
+    #include <cpuid.h>
+#endif
+
+namespace Flashlight {
+    namespace {
+        constexpr u64 ThreadBufferCapacity = 1 << 14;
+
+        // Single producer (the owning thread), single consumer (the main thread in EndFrame).
+        struct ThreadBuffer {
+            std::array<ProfileEvent, ThreadBufferCapacity> Events;
+            alignas(CacheLineSize) std::atomic<u64> Head{0};
+            alignas(CacheLineSize) std::atomic<u64> Tail{0};
+            std::atomic<u64> DroppedCount{0};
+            u32 Index = 0;
+        };
+
+        struct ProfilerState {
+            // Guards the thread list, only taken when a thread records its first zone and by the main thread.
+            std::mutex ThreadsMutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> Threads;
+            std::vector<std::string> ThreadNames;
+
+            std::array<ProfiledFrame, Profiler::FrameHistorySize> Frames;
+            u32 MainThreadIndex = 0;
+            u32 FrameCount = 0;
+            u32 NextFrame = 0;
+            u64 CurrentFrameStart = 0;
+
+            u64 CalibrationTicks = 0;
+            std::chrono::steady_clock::time_point CalibrationTime;
+            std::atomic<f64> SecondsPerTick{1e-9};
+        };
+
+        ProfilerState& GetState() {
+            static ProfilerState state;
+            return state;
+        }
+
+        thread_local ThreadBuffer* t_ThreadBuffer = nullptr;
+
+        ThreadBuffer& GetThreadBuffer() {
+            if (t_ThreadBuffer == nullptr) {
+                ProfilerState& state = GetState();
+                std::scoped_lock lock(state.ThreadsMutex);
+
+                auto buffer = std::make_unique<ThreadBuffer>();
+                buffer->Index = static_cast<u32>(state.Threads.size());
+                state.ThreadNames.push_back(fmt::format("Thread {0}", buffer->Index));
+
+                // Buffers outlive their thread, their zones are still part of the history.
+                t_ThreadBuffer = state.Threads.emplace_back(std::move(buffer)).get();
+            }
+
+            return *t_ThreadBuffer;
+        }
+
+        void Calibrate(ProfilerState& state) {
+            const u64 ticks = Profiler::ReadTimestamp();
+            const std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - state.CalibrationTime;
+
+            if (ticks > state.CalibrationTicks && elapsed.count() > 0.0) {
+                state.SecondsPerTick.store(elapsed.count() / static_cast<f64>(ticks - state.CalibrationTicks),
+                                           std::memory_order_relaxed);
+            }
+        }
+
+        void WriteEscaped(std::ofstream& file, const std::string_view string) {
+            for (const char character : string) {
+                if (character == '"' || character == '\\') {
+                    file << '\\';
+                }
+                file << character;
+            }
+        }
+    }
+
+    void Profiler::Init() {
+        ProfilerState& state = GetState();
+
+        state.CalibrationTicks = ReadTimestamp();
+        state.CalibrationTime = std::chrono::steady_clock::now();
+
+        // A first estimate for the early frames, it gets more accurate every frame as the measured span grows.
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Calibrate(state);
+
+        SetThreadName("Main Thread");
+        state.MainThreadIndex = GetThreadBuffer().Index;
+        state.CurrentFrameStart = ReadTimestamp();
+    }
+
+    void Profiler::Shutdown() {
+        ProfilerState& state = GetState();
+
+        for (auto& frame : state.Frames) {
+            frame.Events.clear();
+            frame.Events.shrink_to_fit();
+        }
+
+        state.FrameCount = 0;
+        state.NextFrame = 0;
+    }
+
+    void Profiler::BeginFrame() {
+        GetState().CurrentFrameStart = ReadTimestamp();
+    }
+
+    void Profiler::EndFrame() {
+        ProfilerState& state = GetState();
+
+        ProfiledFrame& frame = state.Frames[state.NextFrame];
+        frame.Start = state.CurrentFrameStart;
+        frame.End = ReadTimestamp();
+        frame.DroppedEventCount = 0;
+        frame.Events.clear();
+
+        {
+            std::scoped_lock lock(state.ThreadsMutex);
+            for (const auto& buffer : state.Threads) {
+                const u64 head = buffer->Head.load(std::memory_order_acquire);
+                const u64 tail = buffer->Tail.load(std::memory_order_relaxed);
+
+                for (u64 i = tail; i < head; i++) {
+                    frame.Events.push_back(buffer->Events[i & (ThreadBufferCapacity - 1)]);
+                }
+
+                buffer->Tail.store(head, std::memory_order_release);
+                frame.DroppedEventCount += buffer->DroppedCount.exchange(0, std::memory_order_relaxed);
+            }
+        }
+
+        state.NextFrame = (state.NextFrame + 1) % FrameHistorySize;
+        state.FrameCount = std::min(state.FrameCount + 1, FrameHistorySize);
+
+        Calibrate(state);
+    }
+
+    void Profiler::SetThreadName(const std::string_view name) {
+        const ThreadBuffer& buffer = GetThreadBuffer();
+
+        ProfilerState& state = GetState();
+        std::scoped_lock lock(state.ThreadsMutex);
+        state.ThreadNames[buffer.Index] = name;
+    }
+
+    f64 Profiler::TicksToSeconds(const u64 ticks) {
+        return static_cast<f64>(ticks) * GetState().SecondsPerTick.load(std::memory_order_relaxed);
+    }
+
+    f64 Profiler::GetLastFrameZoneTime(const std::string_view name) {
+        if (GetFrameCount() == 0) {
+            return 0.0;
+        }
+
+        u64 ticks = 0;
+        for (const ProfileEvent& event : GetFrame(GetFrameCount() - 1).Events) {
+            if (name == event.Name) {
+                ticks += event.End - event.Start;
+            }
+        }
+
+        return TicksToSeconds(ticks);
+    }
+
+    u32 Profiler::GetFrameCount() {
+        return GetState().FrameCount;
+    }
+
+    const ProfiledFrame& Profiler::GetFrame(const u32 index) {
+        const ProfilerState& state = GetState();
+        assert(index < state.FrameCount && "Frame index out of range.");
+
+        const u32 oldest = (state.NextFrame + FrameHistorySize - state.FrameCount) % FrameHistorySize;
+        return state.Frames[(oldest + index) % FrameHistorySize];
+    }
+
+    bool Profiler::ExportChromeTrace(const std::filesystem::path& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            Log::EngineError(fmt::format("Failed to open file {0}.", path.string()));
+            return false;
+        }
+
+        ProfilerState& state = GetState();
+        const u32 frameCount = GetFrameCount();
+        const u64 origin = frameCount > 0 ? GetFrame(0).Start : 0;
+        const auto toMicroseconds = [origin](const u64 timestamp) {
+            return TicksToSeconds(timestamp - std::min(timestamp, origin)) * 1e6;
+        };
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        const auto separate = [&file, &first] {
+            if (!first) {
+                file << ",\n";
+            }
+            first = false;
+        };
+
+        {
+            std::scoped_lock lock(state.ThreadsMutex);
+            for (u32 i = 0; i < state.ThreadNames.size(); i++) {
+                separate();
+                file << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":\"";
+                WriteEscaped(file, state.ThreadNames[i]);
+                file << "\"}}";
+            }
+        }
+
+        for (u32 i = 0; i < frameCount; i++) {
+            const ProfiledFrame& frame = GetFrame(i);
+
+            separate();
+            file << fmt::format(R"({{"ph":"X","name":"Frame {0}","cat":"frame","pid":0,"tid":{1},)", i,
+                                state.MainThreadIndex)
+                 << fmt::format(R"("ts":{0:.3f},"dur":{1:.3f}}})", toMicroseconds(frame.Start),
+                                TicksToSeconds(frame.End - frame.Start) * 1e6);
+
+            for (const ProfileEvent& event : frame.Events) {
+                separate();
+                file << "{\"ph\":\"X\",\"name\":\"";
+                WriteEscaped(file, event.Name);
+                file << fmt::format(R"(","pid":0,"tid":{0},"ts":{1:.3f},"dur":{2:.3f}}})", event.ThreadIndex,
+                                    toMicroseconds(event.Start), TicksToSeconds(event.End - event.Start) * 1e6);
+            }
+        }
+
+        file << "]}\n";
+
+        if (!file) {
+            Log::EngineError(fmt::format("Failed to write file {0}.", path.string()));
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Profiler::DetectInvariantTsc() {
+#if defined(_M_X64) || defined(__x86_64__) || defined(__i386__)
+        constexpr u32 PowerManagementLeaf = 0x80000007;
+        std::array<u32, 4> registers{};
+
+    #if defined(_MSC_VER)
+        std::array<int, 4> values;
+        __cpuid(values.data(), 0x80000000);
+        if (static_cast<u32>(values[0]) < PowerManagementLeaf) {
+            return false;
+        }
+
+        __cpuid(values.data(), PowerManagementLeaf);
+        registers[3] = static_cast<u32>(values[3]);
+    #else
+        if (__get_cpuid_max(0x80000000, nullptr) < PowerManagementLeaf) {
+            return false;
+        }
+
+        __get_cpuid(PowerManagementLeaf, &registers[0], &registers[1], &registers[2], &registers[3]);
+    #endif
+
+        // EDX bit 8, older TSCs change rate with the core frequency and drift between sockets.
+        return (registers[3] & (1u << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    void Profiler::RecordEvent(const char* name, const u64 start, const u64 end, const u32 depth) {
+        ThreadBuffer& buffer = GetThreadBuffer();
+
+        const u64 head = buffer.Head.load(std::memory_order_relaxed);
+        if (head - buffer.Tail.load(std::memory_order_acquire) >= ThreadBufferCapacity) {
+            // The main thread hasn't collected this buffer for a while, keep the old zones and drop this one.
+            buffer.DroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.Events[head & (ThreadBufferCapacity - 1)] = {name, start, end, buffer.Index, depth};
+        buffer.Head.store(head + 1, std::memory_order_release);
+    }
+}
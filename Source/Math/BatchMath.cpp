@@ -0,0 +1,191 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Math/BatchMath.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Flashlight {
+    // Defined by the files under Kernels, each built for its instruction set. Null when the compiler can't target it.
+    const BatchKernels* GetSse42BatchKernels();
+    const BatchKernels* GetAvx2BatchKernels();
+    const BatchKernels* GetAvx512BatchKernels();
+
+    namespace {
+        // One float per register, the fallback every other level is checked against.
+        struct Lanes {
+            using Register = f32;
+            static constexpr u32 Width = 1;
+
+            static Register Load(const f32* values) { return *values; }
+            static void Store(f32* values, const Register value) { *values = value; }
+            static void StoreUnaligned(f32* values, const Register value) { *values = value; }
+            static Register Set(const f32 value) { return value; }
+            static Register Sub(const Register lhs, const Register rhs) { return lhs - rhs; }
+            static Register Mul(const Register lhs, const Register rhs) { return lhs * rhs; }
+            static Register Div(const Register lhs, const Register rhs) { return lhs / rhs; }
+            static Register Max(const Register lhs, const Register rhs) { return std::max(lhs, rhs); }
+            static Register Sqrt(const Register value) { return std::sqrt(value); }
+            static Register MulAdd(const Register a, const Register b, const Register c) { return a * b + c; }
+        };
+
+#include "Kernels/BatchKernels.inl"
+
+        constexpr BatchKernels ScalarKernels = MakeBatchKernels<Lanes>();
+
+        const BatchKernels& GetActiveKernels() {
+            // Walks down to the best level the engine was built with.
+            for (i32 level = static_cast<i32>(GetSimdLevel()); level >= 0; level--) {
+                if (const BatchKernels* kernels = GetBatchKernels(static_cast<SimdLevel>(level))) {
+                    return *kernels;
+                }
+            }
+
+            return ScalarKernels;
+        }
+
+        const f32* GetData(const std::span<const Vec3x16> blocks) {
+            return blocks.empty() ? nullptr : blocks[0].X.data();
+        }
+
+        f32* GetData(const std::span<Vec3x16> blocks) {
+            return blocks.empty() ? nullptr : blocks[0].X.data();
+        }
+
+        const f32* GetData(const std::span<const Mat4x16> blocks) {
+            return blocks.empty() ? nullptr : blocks[0].M[0].data();
+        }
+
+        f32* GetData(const std::span<Mat4x16> blocks) {
+            return blocks.empty() ? nullptr : blocks[0].M[0].data();
+        }
+
+        u32 GetBlockCount(const std::span<const Vec3x16> blocks) {
+            return static_cast<u32>(blocks.size());
+        }
+
+        u32 GetBlockCount(const std::span<const Mat4x16> blocks) {
+            return static_cast<u32>(blocks.size());
+        }
+    }
+
+    static_assert(sizeof(Vec3x16) == 3 * BatchWidth * sizeof(f32) && sizeof(Mat4x16) == 16 * BatchWidth * sizeof(f32),
+                  "The kernels expect blocks without padding.");
+
+    void PackVectors(const std::span<const glm::vec3> values, const std::span<Vec3x16> blocks) {
+        assert(blocks.size() >= GetBatchBlockCount(static_cast<u32>(values.size())) && "Not enough blocks.");
+
+        for (u32 block = 0; block < blocks.size(); block++) {
+            const u64 first = static_cast<u64>(block) * BatchWidth;
+            const u64 count = first < values.size() ? std::min<u64>(values.size() - first, BatchWidth) : 0;
+            blocks[block] = Vec3x16::Load(values.subspan(std::min<u64>(first, values.size()), count));
+        }
+    }
+
+    void UnpackVectors(const std::span<const Vec3x16> blocks, const std::span<glm::vec3> values) {
+        assert(blocks.size() >= GetBatchBlockCount(static_cast<u32>(values.size())) && "Not enough blocks.");
+
+        for (u64 first = 0; first < values.size(); first += BatchWidth) {
+            blocks[first / BatchWidth].Store(values.subspan(first, std::min<u64>(values.size() - first, BatchWidth)));
+        }
+    }
+
+    void PackMatrices(const std::span<const glm::mat4> values, const std::span<Mat4x16> blocks) {
+        assert(blocks.size() >= GetBatchBlockCount(static_cast<u32>(values.size())) && "Not enough blocks.");
+
+        for (u32 block = 0; block < blocks.size(); block++) {
+            const u64 first = static_cast<u64>(block) * BatchWidth;
+            const u64 count = first < values.size() ? std::min<u64>(values.size() - first, BatchWidth) : 0;
+            blocks[block] = Mat4x16::Load(values.subspan(std::min<u64>(first, values.size()), count));
+        }
+    }
+
+    void UnpackMatrices(const std::span<const Mat4x16> blocks, const std::span<glm::mat4> values) {
+        assert(blocks.size() >= GetBatchBlockCount(static_cast<u32>(values.size())) && "Not enough blocks.");
+
+        for (u64 first = 0; first < values.size(); first += BatchWidth) {
+            blocks[first / BatchWidth].Store(values.subspan(first, std::min<u64>(values.size() - first, BatchWidth)));
+        }
+    }
+
+    void TransformPoints(const glm::mat4& matrix, const std::span<const Vec3x16> points,
+                         const std::span<Vec3x16> result) {
+        assert(result.size() == points.size() && "Result and input sizes differ.");
+
+        GetActiveKernels().TransformPoints(&matrix[0][0], GetData(points), GetData(result), GetBlockCount(points));
+    }
+
+    void TransformDirections(const glm::mat4& matrix, const std::span<const Vec3x16> directions,
+                             const std::span<Vec3x16> result) {
+        assert(result.size() == directions.size() && "Result and input sizes differ.");
+
+        GetActiveKernels().TransformDirections(&matrix[0][0], GetData(directions), GetData(result),
+                                               GetBlockCount(directions));
+    }
+
+    void TransformPoints(const std::span<const Mat4x16> matrices, const std::span<const Vec3x16> points,
+                         const std::span<Vec3x16> result) {
+        assert(matrices.size() == points.size() && result.size() == points.size() && "Result and input sizes differ.");
+
+        GetActiveKernels().TransformPointsPerLane(GetData(matrices), GetData(points), GetData(result),
+                                                  GetBlockCount(points));
+    }
+
+    void MultiplyMatrices(const glm::mat4& lhs, const std::span<const Mat4x16> rhs, const std::span<Mat4x16> result) {
+        assert(result.size() == rhs.size() && "Result and input sizes differ.");
+
+        GetActiveKernels().MultiplyMatrices(&lhs[0][0], GetData(rhs), GetData(result), GetBlockCount(rhs));
+    }
+
+    void MultiplyMatrices(const std::span<const Mat4x16> lhs, const std::span<const Mat4x16> rhs,
+                          const std::span<Mat4x16> result) {
+        assert(lhs.size() == rhs.size() && result.size() == rhs.size() && "Result and input sizes differ.");
+
+        GetActiveKernels().MultiplyMatricesPerLane(GetData(lhs), GetData(rhs), GetData(result), GetBlockCount(rhs));
+    }
+
+    void NormalizeVectors(const std::span<const Vec3x16> vectors, const std::span<Vec3x16> result) {
+        assert(result.size() == vectors.size() && "Result and input sizes differ.");
+
+        GetActiveKernels().NormalizeVectors(GetData(vectors), GetData(result), GetBlockCount(vectors));
+    }
+
+    void MultiplyAddVectors(const std::span<const Vec3x16> lhs, const std::span<const Vec3x16> rhs, const f32 scale,
+                            const std::span<Vec3x16> result) {
+        assert(lhs.size() == rhs.size() && result.size() == rhs.size() && "Result and input sizes differ.");
+
+        GetActiveKernels().MultiplyAddVectors(GetData(lhs), GetData(rhs), scale, GetData(result), GetBlockCount(rhs));
+    }
+
+    void DotVectors(const std::span<const Vec3x16> lhs, const std::span<const Vec3x16> rhs,
+                    const std::span<f32> result) {
+        assert(lhs.size() == rhs.size() && "Input sizes differ.");
+        assert(result.size() >= rhs.size() * BatchWidth && "Result is too small.");
+
+        GetActiveKernels().DotVectors(GetData(lhs), GetData(rhs), result.data(), GetBlockCount(rhs));
+    }
+
+    void CrossVectors(const std::span<const Vec3x16> lhs, const std::span<const Vec3x16> rhs,
+                      const std::span<Vec3x16> result) {
+        assert(lhs.size() == rhs.size() && result.size() == rhs.size() && "Result and input sizes differ.");
+
+        GetActiveKernels().CrossVectors(GetData(lhs), GetData(rhs), GetData(result), GetBlockCount(rhs));
+    }
+
+    const BatchKernels* GetBatchKernels(const SimdLevel level) {
+        switch (level) {
+        case SimdLevel::Scalar:
+            return &ScalarKernels;
+        case SimdLevel::Sse42:
+            return GetSse42BatchKernels();
+        case SimdLevel::Avx2:
+            return GetAvx2BatchKernels();
+        case SimdLevel::Avx512:
+            return GetAvx512BatchKernels();
+        }
+
+        return nullptr;
+    }
+}
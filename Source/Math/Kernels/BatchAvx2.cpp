@@ -0,0 +1,46 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Built with AVX2 and FMA enabled, see BatchKernels.hpp for what this file may include.
+#include <FlashlightEngine/Math/BatchKernels.hpp>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+    #include <immintrin.h>
+
+namespace Flashlight {
+    namespace {
+        struct Lanes {
+            using Register = __m256;
+            static constexpr u32 Width = 8;
+
+            static Register Load(const f32* values) { return _mm256_load_ps(values); }
+            static void Store(f32* values, const Register value) { _mm256_store_ps(values, value); }
+            static void StoreUnaligned(f32* values, const Register value) { _mm256_storeu_ps(values, value); }
+            static Register Set(const f32 value) { return _mm256_set1_ps(value); }
+            static Register Sub(const Register lhs, const Register rhs) { return _mm256_sub_ps(lhs, rhs); }
+            static Register Mul(const Register lhs, const Register rhs) { return _mm256_mul_ps(lhs, rhs); }
+            static Register Div(const Register lhs, const Register rhs) { return _mm256_div_ps(lhs, rhs); }
+            static Register Max(const Register lhs, const Register rhs) { return _mm256_max_ps(lhs, rhs); }
+            static Register Sqrt(const Register value) { return _mm256_sqrt_ps(value); }
+
+            static Register MulAdd(const Register a, const Register b, const Register c) {
+                return _mm256_fmadd_ps(a, b, c);
+            }
+        };
+
+#include "BatchKernels.inl"
+    }
+
+    const BatchKernels* GetAvx2BatchKernels() {
+        static constexpr BatchKernels kernels = MakeBatchKernels<Lanes>();
+        return &kernels;
+    }
+}
+#else
+namespace Flashlight {
+    const BatchKernels* GetAvx2BatchKernels() {
+        return nullptr;
+    }
+}
+#endif
@@ -0,0 +1,46 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Built with AVX-512F enabled, see BatchKernels.hpp for what this file may include.
+#include <FlashlightEngine/Math/BatchKernels.hpp>
+
+#if defined(__AVX512F__)
+    #include <immintrin.h>
+
+namespace Flashlight {
+    namespace {
+        struct Lanes {
+            using Register = __m512;
+            static constexpr u32 Width = 16;
+
+            static Register Load(const f32* values) { return _mm512_load_ps(values); }
+            static void Store(f32* values, const Register value) { _mm512_store_ps(values, value); }
+            static void StoreUnaligned(f32* values, const Register value) { _mm512_storeu_ps(values, value); }
+            static Register Set(const f32 value) { return _mm512_set1_ps(value); }
+            static Register Sub(const Register lhs, const Register rhs) { return _mm512_sub_ps(lhs, rhs); }
+            static Register Mul(const Register lhs, const Register rhs) { return _mm512_mul_ps(lhs, rhs); }
+            static Register Div(const Register lhs, const Register rhs) { return _mm512_div_ps(lhs, rhs); }
+            static Register Max(const Register lhs, const Register rhs) { return _mm512_max_ps(lhs, rhs); }
+            static Register Sqrt(const Register value) { return _mm512_sqrt_ps(value); }
+
+            static Register MulAdd(const Register a, const Register b, const Register c) {
+                return _mm512_fmadd_ps(a, b, c);
+            }
+        };
+
+#include "BatchKernels.inl"
+    }
+
+    const BatchKernels* GetAvx512BatchKernels() {
+        static constexpr BatchKernels kernels = MakeBatchKernels<Lanes>();
+        return &kernels;
+    }
+}
+#else
+namespace Flashlight {
+    const BatchKernels* GetAvx512BatchKernels() {
+        return nullptr;
+    }
+}
+#endif
@@ -0,0 +1,250 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Kernels shared by every instruction set, included in an anonymous namespace after a Lanes type wrapping the
+// registers: Register, Width, Load, Store, StoreUnaligned, Set, Sub, Mul, MulAdd (a * b + c), Div, Max and Sqrt.
+// Each lane group is fully loaded before its results are stored, so results may overwrite the inputs.
+
+constexpr u32 Vec3BlockSize = 3 * BatchWidth;
+constexpr u32 Mat4BlockSize = 16 * BatchWidth;
+
+template <typename Lanes>
+void TransformPoints(const f32* matrix, const f32* points, f32* result, const u32 blockCount) {
+    using Register = typename Lanes::Register;
+
+    Register m[12];
+    for (u32 element = 0; element < 12; element++) {
+        m[element] = Lanes::Set(matrix[element / 3 * 4 + element % 3]);
+    }
+
+    for (u32 block = 0; block < blockCount; block++) {
+        const f32* in = points + block * Vec3BlockSize;
+        f32* out = result + block * Vec3BlockSize;
+
+        for (u32 lane = 0; lane < BatchWidth; lane += Lanes::Width) {
+            const Register x = Lanes::Load(in + lane);
+            const Register y = Lanes::Load(in + BatchWidth + lane);
+            const Register z = Lanes::Load(in + 2 * BatchWidth + lane);
+
+            const Register rx = Lanes::MulAdd(x, m[0], Lanes::MulAdd(y, m[3], Lanes::MulAdd(z, m[6], m[9])));
+            const Register ry = Lanes::MulAdd(x, m[1], Lanes::MulAdd(y, m[4], Lanes::MulAdd(z, m[7], m[10])));
+            const Register rz = Lanes::MulAdd(x, m[2], Lanes::MulAdd(y, m[5], Lanes::MulAdd(z, m[8], m[11])));
+
+            Lanes::Store(out + lane, rx);
+            Lanes::Store(out + BatchWidth + lane, ry);
+            Lanes::Store(out + 2 * BatchWidth + lane, rz);
+        }
+    }
+}
+
+template <typename Lanes>
+void TransformDirections(const f32* matrix, const f32* directions, f32* result, const u32 blockCount) {
+    using Register = typename Lanes::Register;
+
+    Register m[9];
+    for (u32 element = 0; element < 9; element++) {
+        m[element] = Lanes::Set(matrix[element / 3 * 4 + element % 3]);
+    }
+
+    for (u32 block = 0; block < blockCount; block++) {
+        const f32* in = directions + block * Vec3BlockSize;
+        f32* out = result + block * Vec3BlockSize;
+
+        for (u32 lane = 0; lane < BatchWidth; lane += Lanes::Width) {
+            const Register x = Lanes::Load(in + lane);
+            const Register y = Lanes::Load(in + BatchWidth + lane);
+            const Register z = Lanes::Load(in + 2 * BatchWidth + lane);
+
+            const Register rx = Lanes::MulAdd(x, m[0], Lanes::MulAdd(y, m[3], Lanes::Mul(z, m[6])));
+            const Register ry = Lanes::MulAdd(x, m[1], Lanes::MulAdd(y, m[4], Lanes::Mul(z, m[7])));
+            const Register rz = Lanes::MulAdd(x, m[2], Lanes::MulAdd(y, m[5], Lanes::Mul(z, m[8])));
+
+            Lanes::Store(out + lane, rx);
+            Lanes::Store(out + BatchWidth + lane, ry);
+            Lanes::Store(out + 2 * BatchWidth + lane, rz);
+        }
+    }
+}
+
+template <typename Lanes>
+void TransformPointsPerLane(const f32* matrices, const f32* points, f32* result, const u32 blockCount) {
+    using Register = typename Lanes::Register;
+
+    for (u32 block = 0; block < blockCount; block++) {
+        const f32* matrix = matrices + block * Mat4BlockSize;
+        const f32* in = points + block * Vec3BlockSize;
+        f32* out = result + block * Vec3BlockSize;
+
+        for (u32 lane = 0; lane < BatchWidth; lane += Lanes::Width) {
+            // Same order as TransformPoints, the last row is skipped.
+            Register m[12];
+            for (u32 element = 0; element < 12; element++) {
+                m[element] = Lanes::Load(matrix + (element / 3 * 4 + element % 3) * BatchWidth + lane);
+            }
+
+            const Register x = Lanes::Load(in + lane);
+            const Register y = Lanes::Load(in + BatchWidth + lane);
+            const Register z = Lanes::Load(in + 2 * BatchWidth + lane);
+
+            const Register rx = Lanes::MulAdd(x, m[0], Lanes::MulAdd(y, m[3], Lanes::MulAdd(z, m[6], m[9])));
+            const Register ry = Lanes::MulAdd(x, m[1], Lanes::MulAdd(y, m[4], Lanes::MulAdd(z, m[7], m[10])));
+            const Register rz = Lanes::MulAdd(x, m[2], Lanes::MulAdd(y, m[5], Lanes::MulAdd(z, m[8], m[11])));
+
+            Lanes::Store(out + lane, rx);
+            Lanes::Store(out + BatchWidth + lane, ry);
+            Lanes::Store(out + 2 * BatchWidth + lane, rz);
+        }
+    }
+}
+
+// One lhs matrix for every lane, the parent of a batch of local transforms.
+template <typename Lanes>
+void MultiplyMatrices(const f32* lhs, const f32* rhs, f32* result, const u32 blockCount) {
+    using Register = typename Lanes::Register;
+
+    Register l[16];
+    for (u32 element = 0; element < 16; element++) {
+        l[element] = Lanes::Set(lhs[element]);
+    }
+
+    for (u32 block = 0; block < blockCount; block++) {
+        const f32* in = rhs + block * Mat4BlockSize;
+        f32* out = result + block * Mat4BlockSize;
+
+        for (u32 lane = 0; lane < BatchWidth; lane += Lanes::Width) {
+            for (u32 column = 0; column < 4; column++) {
+                Register r[4];
+                for (u32 row = 0; row < 4; row++) {
+                    r[row] = Lanes::Load(in + (column * 4 + row) * BatchWidth + lane);
+                }
+
+                for (u32 row = 0; row < 4; row++) {
+                    const Register partial = Lanes::MulAdd(l[8 + row], r[2], Lanes::Mul(l[12 + row], r[3]));
+                    const Register value = Lanes::MulAdd(l[row], r[0], Lanes::MulAdd(l[4 + row], r[1], partial));
+                    Lanes::Store(out + (column * 4 + row) * BatchWidth + lane, value);
+                }
+            }
+        }
+    }
+}
+
+template <typename Lanes>
+void MultiplyMatricesPerLane(const f32* lhs, const f32* rhs, f32* result, const u32 blockCount) {
+    using Register = typename Lanes::Register;
+
+    for (u32 block = 0; block < blockCount; block++) {
+        const f32* left = lhs + block * Mat4BlockSize;
+        const f32* right = rhs + block * Mat4BlockSize;
+        f32* out = result + block * Mat4BlockSize;
+
+        for (u32 lane = 0; lane < BatchWidth; lane += Lanes::Width) {
+            Register l[16];
+            for (u32 element = 0; element < 16; element++) {
+                l[element] = Lanes::Load(left + element * BatchWidth + lane);
+            }
+
+            for (u32 column = 0; column < 4; column++) {
+                Register r[4];
+                for (u32 row = 0; row < 4; row++) {
+                    r[row] = Lanes::Load(right + (column * 4 + row) * BatchWidth + lane);
+                }
+
+                for (u32 row = 0; row < 4; row++) {
+                    const Register partial = Lanes::MulAdd(l[8 + row], r[2], Lanes::Mul(l[12 + row], r[3]));
+                    const Register value = Lanes::MulAdd(l[row], r[0], Lanes::MulAdd(l[4 + row], r[1], partial));
+                    Lanes::Store(out + (column * 4 + row) * BatchWidth + lane, value);
+                }
+            }
+        }
+    }
+}
+
+template <typename Lanes>
+void NormalizeVectors(const f32* vectors, f32* result, const u32 blockCount) {
+    using Register = typename Lanes::Register;
+
+    const Register one = Lanes::Set(1.0f);
+    const Register smallestLength = Lanes::Set(1.17549435e-38f); // Smallest normal float.
+    for (u32 block = 0; block < blockCount; block++) {
+        const f32* in = vectors + block * Vec3BlockSize;
+        f32* out = result + block * Vec3BlockSize;
+
+        for (u32 lane = 0; lane < BatchWidth; lane += Lanes::Width) {
+            const Register x = Lanes::Load(in + lane);
+            const Register y = Lanes::Load(in + BatchWidth + lane);
+            const Register z = Lanes::Load(in + 2 * BatchWidth + lane);
+
+            // An exact square root rather than the approximate reciprocal, to give the same results as glm. Zero
+            // lengths are raised so zero vectors scale to zero instead of dividing zero by zero.
+            const Register length = Lanes::Sqrt(Lanes::MulAdd(x, x, Lanes::MulAdd(y, y, Lanes::Mul(z, z))));
+            const Register inverseLength = Lanes::Div(one, Lanes::Max(length, smallestLength));
+
+            Lanes::Store(out + lane, Lanes::Mul(x, inverseLength));
+            Lanes::Store(out + BatchWidth + lane, Lanes::Mul(y, inverseLength));
+            Lanes::Store(out + 2 * BatchWidth + lane, Lanes::Mul(z, inverseLength));
+        }
+    }
+}
+
+template <typename Lanes>
+void MultiplyAddVectors(const f32* lhs, const f32* rhs, const f32 scale, f32* result, const u32 blockCount) {
+    const typename Lanes::Register factor = Lanes::Set(scale);
+
+    // Coordinates don't interact, the blocks are one flat array of floats.
+    for (u32 offset = 0; offset < blockCount * Vec3BlockSize; offset += Lanes::Width) {
+        Lanes::Store(result + offset, Lanes::MulAdd(Lanes::Load(rhs + offset), factor, Lanes::Load(lhs + offset)));
+    }
+}
+
+template <typename Lanes>
+void DotVectors(const f32* lhs, const f32* rhs, f32* result, const u32 blockCount) {
+    using Register = typename Lanes::Register;
+
+    for (u32 block = 0; block < blockCount; block++) {
+        const f32* left = lhs + block * Vec3BlockSize;
+        const f32* right = rhs + block * Vec3BlockSize;
+        f32* out = result + block * BatchWidth;
+
+        for (u32 lane = 0; lane < BatchWidth; lane += Lanes::Width) {
+            const Register x = Lanes::Mul(Lanes::Load(left + lane), Lanes::Load(right + lane));
+            const Register xy = Lanes::MulAdd(Lanes::Load(left + BatchWidth + lane),
+                                              Lanes::Load(right + BatchWidth + lane), x);
+
+            // The result is a plain array of floats, not a block, nothing aligns it to the register.
+            Lanes::StoreUnaligned(out + lane, Lanes::MulAdd(Lanes::Load(left + 2 * BatchWidth + lane),
+                                                            Lanes::Load(right + 2 * BatchWidth + lane), xy));
+        }
+    }
+}
+
+template <typename Lanes>
+void CrossVectors(const f32* lhs, const f32* rhs, f32* result, const u32 blockCount) {
+    using Register = typename Lanes::Register;
+
+    for (u32 block = 0; block < blockCount; block++) {
+        const f32* left = lhs + block * Vec3BlockSize;
+        const f32* right = rhs + block * Vec3BlockSize;
+        f32* out = result + block * Vec3BlockSize;
+
+        for (u32 lane = 0; lane < BatchWidth; lane += Lanes::Width) {
+            const Register lx = Lanes::Load(left + lane);
+            const Register ly = Lanes::Load(left + BatchWidth + lane);
+            const Register lz = Lanes::Load(left + 2 * BatchWidth + lane);
+            const Register rx = Lanes::Load(right + lane);
+            const Register ry = Lanes::Load(right + BatchWidth + lane);
+            const Register rz = Lanes::Load(right + 2 * BatchWidth + lane);
+
+            Lanes::Store(out + lane, Lanes::Sub(Lanes::Mul(ly, rz), Lanes::Mul(lz, ry)));
+            Lanes::Store(out + BatchWidth + lane, Lanes::Sub(Lanes::Mul(lz, rx), Lanes::Mul(lx, rz)));
+            Lanes::Store(out + 2 * BatchWidth + lane, Lanes::Sub(Lanes::Mul(lx, ry), Lanes::Mul(ly, rx)));
+        }
+    }
+}
+
+template <typename Lanes>
+constexpr BatchKernels MakeBatchKernels() {
+    return {&TransformPoints<Lanes>, &TransformDirections<Lanes>, &TransformPointsPerLane<Lanes>,
+            &MultiplyMatrices<Lanes>, &MultiplyMatricesPerLane<Lanes>, &NormalizeVectors<Lanes>,
+            &MultiplyAddVectors<Lanes>, &DotVectors<Lanes>, &CrossVectors<Lanes>};
+}
@@ -0,0 +1,46 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Built with SSE4.2 enabled, see BatchKernels.hpp for what this file may include.
+#include <FlashlightEngine/Math/BatchKernels.hpp>
+
+#if defined(__SSE4_2__) || defined(_M_X64)
+    #include <nmmintrin.h>
+
+namespace Flashlight {
+    namespace {
+        struct Lanes {
+            using Register = __m128;
+            static constexpr u32 Width = 4;
+
+            static Register Load(const f32* values) { return _mm_load_ps(values); }
+            static void Store(f32* values, const Register value) { _mm_store_ps(values, value); }
+            static void StoreUnaligned(f32* values, const Register value) { _mm_storeu_ps(values, value); }
+            static Register Set(const f32 value) { return _mm_set1_ps(value); }
+            static Register Sub(const Register lhs, const Register rhs) { return _mm_sub_ps(lhs, rhs); }
+            static Register Mul(const Register lhs, const Register rhs) { return _mm_mul_ps(lhs, rhs); }
+            static Register Div(const Register lhs, const Register rhs) { return _mm_div_ps(lhs, rhs); }
+            static Register Max(const Register lhs, const Register rhs) { return _mm_max_ps(lhs, rhs); }
+            static Register Sqrt(const Register value) { return _mm_sqrt_ps(value); }
+
+            static Register MulAdd(const Register a, const Register b, const Register c) {
+                return _mm_add_ps(_mm_mul_ps(a, b), c);
+            }
+        };
+
+#include "BatchKernels.inl"
+    }
+
+    const BatchKernels* GetSse42BatchKernels() {
+        static constexpr BatchKernels kernels = MakeBatchKernels<Lanes>();
+        return &kernels;
+    }
+}
+#else
+namespace Flashlight {
+    const BatchKernels* GetSse42BatchKernels() {
+        return nullptr;
+    }
+}
+#endif
@@ -0,0 +1,98 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Math/SimdLevel.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+    #include <immintrin.h>
+#elif defined(__x86_64__)
+    #include <cpuid.h>
+#endif
+
+namespace Flashlight {
+    namespace {
+#if defined(_M_X64) || defined(__x86_64__)
+        std::array<u32, 4> ReadCpuid(const u32 leaf) {
+            std::array<u32, 4> registers{};
+    #if defined(_MSC_VER)
+            std::array<int, 4> values;
+            __cpuidex(values.data(), static_cast<int>(leaf), 0);
+            for (u32 i = 0; i < 4; i++) {
+                registers[i] = static_cast<u32>(values[i]);
+            }
+    #else
+            __cpuid_count(leaf, 0, registers[0], registers[1], registers[2], registers[3]);
+    #endif
+            return registers;
+        }
+
+        // Register states the OS saves on context switches.
+        u64 ReadEnabledStates() {
+    #if defined(_MSC_VER)
+            return _xgetbv(0);
+    #else
+            u32 low;
+            u32 high;
+            __asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+            return static_cast<u64>(high) << 32 | low;
+    #endif
+        }
+
+        SimdLevel DetectSimdLevel() {
+            constexpr u32 Eax = 0, Ebx = 1, Ecx = 2;
+
+            const u32 maxLeaf = ReadCpuid(0)[Eax];
+            const std::array<u32, 4> features = ReadCpuid(1);
+
+            const bool sse42 = (features[Ecx] & (1u << 19)) && (features[Ecx] & (1u << 20));
+            if (!sse42) {
+                return SimdLevel::Scalar;
+            }
+
+            // AVX needs the OS to save the upper halves of the registers, XSAVE tells whether it does.
+            const bool osSavesAvx = (features[Ecx] & (1u << 27)) && (features[Ecx] & (1u << 28)) &&
+                                    (ReadEnabledStates() & 0x6) == 0x6;
+            const bool fma = features[Ecx] & (1u << 12);
+            if (!osSavesAvx || !fma || maxLeaf < 7) {
+                return SimdLevel::Sse42;
+            }
+
+            const std::array<u32, 4> extendedFeatures = ReadCpuid(7);
+            if (!(extendedFeatures[Ebx] & (1u << 5))) {
+                return SimdLevel::Sse42;
+            }
+
+            // AVX-512 also needs the opmask and the upper 16 registers saved.
+            const bool avx512 = (extendedFeatures[Ebx] & (1u << 16)) && (ReadEnabledStates() & 0xE6) == 0xE6;
+            return avx512 ? SimdLevel::Avx512 : SimdLevel::Avx2;
+        }
+#else
+        SimdLevel DetectSimdLevel() {
+            return SimdLevel::Scalar;
+        }
+#endif
+
+        std::atomic<SimdLevel>& GetActiveLevel() {
+            static std::atomic<SimdLevel> level = GetSupportedSimdLevel();
+            return level;
+        }
+    }
+
+    SimdLevel GetSupportedSimdLevel() {
+        static const SimdLevel level = DetectSimdLevel();
+        return level;
+    }
+
+    SimdLevel GetSimdLevel() {
+        return GetActiveLevel().load(std::memory_order_relaxed);
+    }
+
+    void SetSimdLevel(const SimdLevel level) {
+        GetActiveLevel().store(std::min(level, GetSupportedSimdLevel()), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,185 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Mesh/MeshData.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/MemoryMappedFile.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <charconv>
+#include <fstream>
+
+namespace Flashlight {
+    namespace {
+        class ObjParser {
+            const char* m_Cursor;
+            const char* m_End;
+
+        public:
+            ObjParser(const char* begin, const char* end) : m_Cursor(begin), m_End(end) {
+            }
+
+            [[nodiscard]] bool IsDone() const {
+                return m_Cursor >= m_End;
+            }
+
+            void SkipSpaces() {
+                while (m_Cursor < m_End && (*m_Cursor == ' ' || *m_Cursor == '\t' || *m_Cursor == '\r')) {
+                    m_Cursor++;
+                }
+            }
+
+            void NextLine() {
+                while (m_Cursor < m_End && *m_Cursor++ != '\n') {
+                }
+            }
+
+            [[nodiscard]] bool IsLineEnd() const {
+                return m_Cursor >= m_End || *m_Cursor == '\n' || *m_Cursor == '#';
+            }
+
+            [[nodiscard]] std::string_view ReadKeyword() {
+                SkipSpaces();
+                const char* begin = m_Cursor;
+                while (m_Cursor < m_End && *m_Cursor != ' ' && *m_Cursor != '\t' && *m_Cursor != '\r' &&
+                       *m_Cursor != '\n') {
+                    m_Cursor++;
+                }
+
+                return {begin, static_cast<std::size_t>(m_Cursor - begin)};
+            }
+
+            f32 ReadFloat() {
+                SkipSpaces();
+                f32 value = 0.0f;
+                m_Cursor = std::from_chars(m_Cursor, m_End, value).ptr;
+                return value;
+            }
+
+            // Parses "v", "v/vt", "v//vn" or "v/vt/vn", the missing indices are left at 0.
+            bool ReadCorner(std::array<i32, 3>& corner) {
+                SkipSpaces();
+                corner = {};
+
+                for (u32 i = 0; i < 3; i++) {
+                    if (i > 0) {
+                        if (m_Cursor >= m_End || *m_Cursor != '/') {
+                            break;
+                        }
+                        m_Cursor++;
+                    }
+
+                    m_Cursor = std::from_chars(m_Cursor, m_End, corner[i]).ptr;
+                }
+
+                return corner[0] != 0;
+            }
+        };
+
+        // OBJ indices start at 1, negative ones count back from the last element.
+        i64 ResolveIndex(const i32 index, const u64 count) {
+            return index > 0 ? index - 1 : static_cast<i64>(count) + index;
+        }
+
+        template <typename T>
+        T GetElement(const std::vector<T>& elements, const i32 index) {
+            const i64 resolved = ResolveIndex(index, elements.size());
+            return index != 0 && resolved >= 0 && static_cast<u64>(resolved) < elements.size() ? elements[resolved]
+                                                                                               : T(0.0f);
+        }
+    }
+
+    bool ImportObj(const std::filesystem::path& path, MeshData& mesh) {
+        FL_PROFILE_ZONE("ImportObj");
+
+        // Empty files can't be mapped, they are still a valid mesh without faces.
+        std::error_code error;
+        if (std::filesystem::is_regular_file(path, error) && std::filesystem::is_empty(path, error)) {
+            mesh.Vertices.clear();
+            mesh.Indices.clear();
+            return true;
+        }
+
+        MemoryMappedFile file;
+        if (!file.OpenRead(path)) {
+            Log::EngineError(fmt::format("Failed to import OBJ file {0}, it can't be read.", path.string()));
+            return false;
+        }
+
+        const auto* begin = reinterpret_cast<const char*>(file.GetData());
+        ObjParser parser(begin, begin + file.GetSize());
+
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec2> texCoords;
+        std::vector<std::array<i32, 3>> face;
+
+        mesh.Vertices.clear();
+        mesh.Indices.clear();
+
+        for (; !parser.IsDone(); parser.NextLine()) {
+            const std::string_view keyword = parser.ReadKeyword();
+
+            if (keyword == "v") {
+                const f32 x = parser.ReadFloat();
+                const f32 y = parser.ReadFloat();
+                positions.emplace_back(x, y, parser.ReadFloat());
+            } else if (keyword == "vn") {
+                const f32 x = parser.ReadFloat();
+                const f32 y = parser.ReadFloat();
+                normals.emplace_back(x, y, parser.ReadFloat());
+            } else if (keyword == "vt") {
+                const f32 u = parser.ReadFloat();
+                texCoords.emplace_back(u, parser.ReadFloat());
+            } else if (keyword == "f") {
+                face.clear();
+                std::array<i32, 3> corner{};
+                while (!parser.IsLineEnd() && parser.ReadCorner(corner)) {
+                    face.push_back(corner);
+                    parser.SkipSpaces();
+                }
+
+                const auto firstVertex = static_cast<u32>(mesh.Vertices.size());
+                for (const auto& [position, texCoord, normal] : face) {
+                    mesh.Vertices.push_back({GetElement(positions, position), GetElement(normals, normal),
+                                             GetElement(texCoords, texCoord)});
+                }
+
+                for (u32 i = 2; i < face.size(); i++) {
+                    mesh.Indices.insert(mesh.Indices.end(), {firstVertex, firstVertex + i - 1, firstVertex + i});
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool ExportObj(const std::filesystem::path& path, const MeshData& mesh) {
+        FL_PROFILE_ZONE("ExportObj");
+
+        std::ofstream file(path);
+        if (!file) {
+            Log::EngineError(fmt::format("Failed to create file {0}.", path.string()));
+            return false;
+        }
+
+        std::string buffer;
+        for (const MeshVertex& vertex : mesh.Vertices) {
+            fmt::format_to(std::back_inserter(buffer), "v {0} {1} {2}\nvn {3} {4} {5}\nvt {6} {7}\n",
+                           vertex.Position.x, vertex.Position.y, vertex.Position.z, vertex.Normal.x, vertex.Normal.y,
+                           vertex.Normal.z, vertex.TexCoord.x, vertex.TexCoord.y);
+        }
+
+        for (u32 i = 0; i + 2 < mesh.Indices.size(); i += 3) {
+            const u32 a = mesh.Indices[i] + 1;
+            const u32 b = mesh.Indices[i + 1] + 1;
+            const u32 c = mesh.Indices[i + 2] + 1;
+            fmt::format_to(std::back_inserter(buffer), "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", a, b, c);
+        }
+
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,689 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Mesh/MeshOptimizer.hpp>
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace Flashlight {
+    namespace {
+        constexpr u32 FetchCacheLineSize = 64;
+        constexpr u32 FetchCacheLineCount = 16 * 1024 / FetchCacheLineSize;
+
+        /*
+         * FifoCache : Simulates a FIFO cache with one timestamp per element, an element is cached while less than
+         * the cache size misses happened since it was loaded.
+         */
+        class FifoCache {
+            std::vector<u32> m_Timestamps;
+            u32 m_Time;
+            u32 m_Size;
+
+        public:
+            FifoCache(const u32 elementCount, const u32 size)
+                : m_Timestamps(elementCount, 0), m_Time(size + 1), m_Size(size) {
+            }
+
+            // Returns true on a miss.
+            bool Access(const u32 element) {
+                if (m_Time - m_Timestamps[element] > m_Size) {
+                    m_Timestamps[element] = m_Time++;
+                    return true;
+                }
+
+                return false;
+            }
+
+            void Flush() {
+                m_Time += m_Size + 1;
+            }
+        };
+
+        // A part of a mesh renumbered to use only the vertices it references.
+        struct MeshChunk {
+            std::vector<u32> Indices;
+            std::vector<u32> Vertices; // Local to global index, in order of first use.
+            std::vector<u32> Result;
+
+            // globalToLocal has one InvalidVertex per vertex of the mesh, and is left that way.
+            void Build(const std::span<const u32> indices, std::vector<u32>& globalToLocal) {
+                Vertices.clear();
+                Indices.resize(indices.size());
+                for (u64 i = 0; i < indices.size(); i++) {
+                    u32& local = globalToLocal[indices[i]];
+                    if (local == InvalidVertex) {
+                        local = static_cast<u32>(Vertices.size());
+                        Vertices.push_back(indices[i]);
+                    }
+
+                    Indices[i] = local;
+                }
+
+                for (const u32 vertex : Vertices) {
+                    globalToLocal[vertex] = InvalidVertex;
+                }
+
+                Result.resize(indices.size());
+            }
+
+            [[nodiscard]] u32 GetVertexCount() const {
+                return static_cast<u32>(Vertices.size());
+            }
+        };
+
+        // Calls function(chunk, firstIndex) on chunks of chunkTriangleCount triangles in parallel.
+        template <typename Function>
+        void ForEachChunk(JobSystem& jobs, const std::span<const u32> indices, const u32 vertexCount,
+                          const u32 chunkTriangleCount, Function&& function) {
+            const u64 chunkIndexCount = static_cast<u64>(chunkTriangleCount) * 3;
+            const auto chunkCount = static_cast<u32>((indices.size() + chunkIndexCount - 1) / chunkIndexCount);
+
+            jobs.ParallelFor(chunkCount, 1, [&](const u32 begin, const u32 end) {
+                MeshChunk chunk;
+                std::vector<u32> globalToLocal(vertexCount, InvalidVertex);
+                for (u32 chunkIndex = begin; chunkIndex < end; chunkIndex++) {
+                    const u64 firstIndex = chunkIndex * chunkIndexCount;
+                    chunk.Build(indices.subspan(firstIndex, std::min(chunkIndexCount, indices.size() - firstIndex)),
+                                globalToLocal);
+                    function(chunk, firstIndex);
+                }
+            });
+        }
+
+        // Murmur2 over the words of the vertex, vertices are a few dozen bytes.
+        u32 HashVertex(const std::byte* vertex, const u32 vertexSize) {
+            constexpr u32 multiplier = 0x5BD1E995;
+
+            u32 hash = vertexSize;
+            u32 offset = 0;
+            for (; offset + 4 <= vertexSize; offset += 4) {
+                u32 word;
+                std::memcpy(&word, vertex + offset, sizeof(word));
+                word *= multiplier;
+                word ^= word >> 24;
+                word *= multiplier;
+                hash = hash * multiplier ^ word;
+            }
+
+            for (; offset < vertexSize; offset++) {
+                hash ^= static_cast<u32>(vertex[offset]);
+                hash *= multiplier;
+            }
+
+            hash ^= hash >> 13;
+            hash *= multiplier;
+            return hash ^ hash >> 15;
+        }
+
+        glm::vec3 ReadPosition(const f32* positions, const u32 positionStride, const u32 vertex) {
+            const u64 offset = static_cast<u64>(vertex) * positionStride;
+
+            glm::vec3 position;
+            std::memcpy(&position, reinterpret_cast<const std::byte*>(positions) + offset, sizeof(position));
+            return position;
+        }
+
+        // Spreads the low 10 bits of value so there are two zero bits between each of them.
+        u32 SpreadBits(u32 value) {
+            value &= 0x3FF;
+            value = (value | value << 16) & 0x030000FF;
+            value = (value | value << 8) & 0x0300F00F;
+            value = (value | value << 4) & 0x030C30C3;
+            return (value | value << 2) & 0x09249249;
+        }
+
+        /*
+         * Tipsify, from "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (Sander, Nehab and
+         * Barczak, 2007). Emits the triangles around one vertex at a time, then moves to a neighbour that is still in
+         * the cache and won't be evicted by its own triangles, or to the most recent vertex with triangles left.
+         */
+        void Tipsify(const std::span<u32> destination, const std::span<const u32> indices, const u32 vertexCount,
+                     const u32 cacheSize) {
+            const auto triangleCount = static_cast<u32>(indices.size() / 3);
+
+            // Triangles around each vertex, LiveCounts is how many of them are still to emit.
+            std::vector<u32> liveCounts(vertexCount, 0);
+            for (const u32 index : indices) {
+                liveCounts[index]++;
+            }
+
+            std::vector<u32> offsets(vertexCount + 1, 0);
+            for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+                offsets[vertex + 1] = offsets[vertex] + liveCounts[vertex];
+            }
+
+            std::vector<u32> adjacency(indices.size());
+            std::vector<u32> cursors(offsets.begin(), offsets.end() - 1);
+            for (u32 triangle = 0; triangle < triangleCount; triangle++) {
+                for (u32 corner = 0; corner < 3; corner++) {
+                    adjacency[cursors[indices[triangle * 3 + corner]]++] = triangle;
+                }
+            }
+
+            std::vector<u8> emitted(triangleCount, 0);
+            std::vector<u32> cacheTimestamps(vertexCount, 0);
+            u32 time = cacheSize + 1;
+
+            std::vector<u32> deadEnds;
+            std::vector<u32> candidates;
+            u32 scanCursor = 0;
+            u32 outputIndex = 0;
+
+            const auto nextLiveVertex = [&]() -> u32 {
+                while (!deadEnds.empty()) {
+                    const u32 vertex = deadEnds.back();
+                    deadEnds.pop_back();
+                    if (liveCounts[vertex] > 0) {
+                        return vertex;
+                    }
+                }
+
+                for (; scanCursor < vertexCount; scanCursor++) {
+                    if (liveCounts[scanCursor] > 0) {
+                        return scanCursor;
+                    }
+                }
+
+                return InvalidVertex;
+            };
+
+            u32 fanningVertex = nextLiveVertex();
+            while (fanningVertex != InvalidVertex) {
+                candidates.clear();
+
+                for (u32 i = offsets[fanningVertex]; i < offsets[fanningVertex + 1]; i++) {
+                    const u32 triangle = adjacency[i];
+                    if (emitted[triangle]) {
+                        continue;
+                    }
+                    emitted[triangle] = 1;
+
+                    for (u32 corner = 0; corner < 3; corner++) {
+                        const u32 vertex = indices[triangle * 3 + corner];
+                        destination[outputIndex++] = vertex;
+                        deadEnds.push_back(vertex);
+                        candidates.push_back(vertex);
+                        liveCounts[vertex]--;
+
+                        if (time - cacheTimestamps[vertex] > cacheSize) {
+                            cacheTimestamps[vertex] = time++;
+                        }
+                    }
+                }
+
+                // The oldest neighbour whose remaining triangles still fit in the cache.
+                u32 bestVertex = InvalidVertex;
+                i32 bestPriority = -1;
+                for (const u32 vertex : candidates) {
+                    if (liveCounts[vertex] == 0) {
+                        continue;
+                    }
+
+                    i32 priority = 0;
+                    const u32 age = time - cacheTimestamps[vertex];
+                    if (age + 2 * liveCounts[vertex] <= cacheSize) {
+                        priority = static_cast<i32>(age);
+                    }
+
+                    if (priority > bestPriority) {
+                        bestVertex = vertex;
+                        bestPriority = priority;
+                    }
+                }
+
+                fanningVertex = bestVertex != InvalidVertex ? bestVertex : nextLiveVertex();
+            }
+        }
+
+        /*
+         * Cuts the triangles into clusters where the cache starts cold anyway, or where the vertex cache efficiency
+         * of the cluster so far is within the threshold of the whole one, then draws the clusters facing away from
+         * the mesh center first.
+         */
+        void SortClusters(const std::span<u32> destination, const std::span<const u32> indices,
+                          const std::span<const glm::vec3> positions, const glm::vec3& meshCentroid,
+                          const u32 cacheSize, const f32 threshold) {
+            const auto triangleCount = static_cast<u32>(indices.size() / 3);
+            FifoCache cache(static_cast<u32>(positions.size()), cacheSize);
+
+            const auto countMisses = [&indices, &cache](const u32 triangle) {
+                return static_cast<u32>(cache.Access(indices[triangle * 3])) +
+                       static_cast<u32>(cache.Access(indices[triangle * 3 + 1])) +
+                       static_cast<u32>(cache.Access(indices[triangle * 3 + 2]));
+            };
+
+            std::vector<u32> hardBoundaries;
+            for (u32 triangle = 0; triangle < triangleCount; triangle++) {
+                if (countMisses(triangle) == 3 || triangle == 0) {
+                    hardBoundaries.push_back(triangle);
+                }
+            }
+            hardBoundaries.push_back(triangleCount);
+
+            std::vector<u32> clusters;
+            for (u32 hard = 0; hard + 1 < hardBoundaries.size(); hard++) {
+                const u32 begin = hardBoundaries[hard];
+                const u32 end = hardBoundaries[hard + 1];
+
+                cache.Flush();
+                u32 clusterMisses = 0;
+                for (u32 triangle = begin; triangle < end; triangle++) {
+                    clusterMisses += countMisses(triangle);
+                }
+                const f32 clusterThreshold = threshold * static_cast<f32>(clusterMisses) /
+                                             static_cast<f32>(end - begin);
+
+                cache.Flush();
+                u32 start = begin;
+                u32 misses = 0;
+                for (u32 triangle = begin; triangle < end; triangle++) {
+                    misses += countMisses(triangle);
+
+                    if (static_cast<f32>(misses) / static_cast<f32>(triangle - start + 1) <= clusterThreshold) {
+                        clusters.push_back(start);
+                        start = triangle + 1;
+                        misses = 0;
+                        cache.Flush();
+                    }
+                }
+
+                if (start < end) {
+                    clusters.push_back(start);
+                }
+            }
+
+            const auto clusterCount = static_cast<u32>(clusters.size());
+            clusters.push_back(triangleCount);
+
+            std::vector<f32> keys(clusterCount);
+            for (u32 cluster = 0; cluster < clusterCount; cluster++) {
+                glm::vec3 centroid(0.0f);
+                glm::vec3 normal(0.0f);
+                f32 area = 0.0f;
+
+                for (u32 triangle = clusters[cluster]; triangle < clusters[cluster + 1]; triangle++) {
+                    const glm::vec3& a = positions[indices[triangle * 3]];
+                    const glm::vec3& b = positions[indices[triangle * 3 + 1]];
+                    const glm::vec3& c = positions[indices[triangle * 3 + 2]];
+
+                    const glm::vec3 triangleNormal = glm::cross(b - a, c - a);
+                    const f32 triangleArea = glm::length(triangleNormal);
+
+                    centroid += (a + b + c) * (triangleArea / 3.0f);
+                    normal += triangleNormal;
+                    area += triangleArea;
+                }
+
+                const f32 normalLength = glm::length(normal);
+                keys[cluster] = area > 0.0f && normalLength > 0.0f
+                                    ? glm::dot(centroid / area - meshCentroid, normal / normalLength)
+                                    : 0.0f;
+            }
+
+            std::vector<u32> order(clusterCount);
+            for (u32 cluster = 0; cluster < clusterCount; cluster++) {
+                order[cluster] = cluster;
+            }
+            std::ranges::stable_sort(order, std::greater{}, [&keys](const u32 cluster) { return keys[cluster]; });
+
+            u32 outputIndex = 0;
+            for (const u32 cluster : order) {
+                const u32 begin = clusters[cluster] * 3;
+                const u32 end = clusters[cluster + 1] * 3;
+                std::copy(indices.begin() + begin, indices.begin() + end, destination.begin() + outputIndex);
+                outputIndex += end - begin;
+            }
+        }
+    }
+
+    u32 GenerateVertexRemap(const std::span<u32> remap, const std::span<const u32> indices, const void* vertices,
+                            const u32 vertexCount, const u32 vertexSize, JobSystem* jobs) {
+        FL_PROFILE_ZONE("GenerateVertexRemap");
+
+        const auto* vertexData = static_cast<const std::byte*>(vertices);
+
+        std::vector<u32> hashes(vertexCount);
+        const auto hashVertices = [&hashes, vertexData, vertexSize](const u32 begin, const u32 end) {
+            for (u32 vertex = begin; vertex < end; vertex++) {
+                hashes[vertex] = HashVertex(vertexData + static_cast<u64>(vertex) * vertexSize, vertexSize);
+            }
+        };
+
+        if (jobs != nullptr) {
+            jobs->ParallelFor(vertexCount, 1 << 14, hashVertices);
+        } else {
+            hashVertices(0, vertexCount);
+        }
+
+        // Open addressing with triangular probing, which visits every slot of a power of two table.
+        const u32 mask = std::bit_ceil(std::max(vertexCount * 2, 16u)) - 1;
+        std::vector<u32> table(mask + 1, InvalidVertex);
+        std::ranges::fill(remap, InvalidVertex);
+        u32 uniqueCount = 0;
+
+        const auto visit = [&](const u32 vertex) {
+            if (remap[vertex] != InvalidVertex) {
+                return;
+            }
+
+            const std::byte* data = vertexData + static_cast<u64>(vertex) * vertexSize;
+            u32 slot = hashes[vertex] & mask;
+            for (u32 probe = 1; table[slot] != InvalidVertex; probe++) {
+                const u32 other = table[slot];
+                if (hashes[other] == hashes[vertex] &&
+                    std::memcmp(vertexData + static_cast<u64>(other) * vertexSize, data, vertexSize) == 0) {
+                    remap[vertex] = remap[other];
+                    return;
+                }
+
+                slot = (slot + probe) & mask;
+            }
+
+            table[slot] = vertex;
+            remap[vertex] = uniqueCount++;
+        };
+
+        if (indices.empty()) {
+            for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+                visit(vertex);
+            }
+        } else {
+            for (const u32 index : indices) {
+                visit(index);
+            }
+        }
+
+        return uniqueCount;
+    }
+
+    void RemapIndices(const std::span<u32> destination, const std::span<const u32> indices,
+                      const std::span<const u32> remap) {
+        for (u64 i = 0; i < indices.size(); i++) {
+            destination[i] = remap[indices[i]];
+        }
+    }
+
+    void RemapVertices(void* destination, const void* vertices, const u32 vertexCount, const u32 vertexSize,
+                       const std::span<const u32> remap) {
+        auto* output = static_cast<std::byte*>(destination);
+        const auto* input = static_cast<const std::byte*>(vertices);
+
+        for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+            if (remap[vertex] != InvalidVertex) {
+                std::memcpy(output + static_cast<u64>(remap[vertex]) * vertexSize,
+                            input + static_cast<u64>(vertex) * vertexSize, vertexSize);
+            }
+        }
+    }
+
+    void SortTrianglesSpatially(const std::span<u32> destination, const std::span<const u32> indices,
+                                const f32* positions, const u32 vertexCount, const u32 positionStride,
+                                JobSystem* jobs) {
+        FL_PROFILE_ZONE("SortTrianglesSpatially");
+
+        assert(indices.size() % 3 == 0 && "Index count isn't a multiple of 3.");
+
+        glm::vec3 minimum(std::numeric_limits<f32>::max());
+        glm::vec3 maximum(std::numeric_limits<f32>::lowest());
+        for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+            const glm::vec3 position = ReadPosition(positions, positionStride, vertex);
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+        }
+
+        // Same scale on every axis, so a flat mesh still uses the whole curve.
+        const glm::vec3 extent = maximum - minimum;
+        const f32 largestExtent = std::max({extent.x, extent.y, extent.z});
+        const f32 scale = largestExtent > 0.0f ? 1023.0f / largestExtent : 0.0f;
+
+        const auto triangleCount = static_cast<u32>(indices.size() / 3);
+        std::vector<u32> codes(triangleCount);
+        const auto computeCodes = [&](const u32 begin, const u32 end) {
+            for (u32 triangle = begin; triangle < end; triangle++) {
+                const glm::vec3 centroid = (ReadPosition(positions, positionStride, indices[triangle * 3]) +
+                                            ReadPosition(positions, positionStride, indices[triangle * 3 + 1]) +
+                                            ReadPosition(positions, positionStride, indices[triangle * 3 + 2])) /
+                                           3.0f;
+                const glm::vec3 cell = (centroid - minimum) * scale + 0.5f;
+                codes[triangle] = SpreadBits(static_cast<u32>(cell.x)) | SpreadBits(static_cast<u32>(cell.y)) << 1 |
+                                  SpreadBits(static_cast<u32>(cell.z)) << 2;
+            }
+        };
+
+        if (jobs != nullptr) {
+            jobs->ParallelFor(triangleCount, 1 << 14, computeCodes);
+        } else {
+            computeCodes(0, triangleCount);
+        }
+
+        // Radix sort of the 30-bit codes, 10 bits per pass. Stable, so equal codes keep the input order.
+        std::vector<u32> order(triangleCount);
+        std::vector<u32> sorted(triangleCount);
+        for (u32 triangle = 0; triangle < triangleCount; triangle++) {
+            order[triangle] = triangle;
+        }
+
+        for (u32 shift = 0; shift < 30; shift += 10) {
+            std::array<u32, 1024> offsets{};
+            for (const u32 code : codes) {
+                offsets[code >> shift & 0x3FF]++;
+            }
+
+            u32 offset = 0;
+            for (u32& count : offsets) {
+                offset += std::exchange(count, offset);
+            }
+
+            for (const u32 triangle : order) {
+                sorted[offsets[codes[triangle] >> shift & 0x3FF]++] = triangle;
+            }
+
+            order.swap(sorted);
+        }
+
+        for (u32 i = 0; i < triangleCount; i++) {
+            destination[i * 3] = indices[order[i] * 3];
+            destination[i * 3 + 1] = indices[order[i] * 3 + 1];
+            destination[i * 3 + 2] = indices[order[i] * 3 + 2];
+        }
+    }
+
+    void OptimizeVertexCache(const std::span<u32> destination, const std::span<const u32> indices,
+                             const u32 vertexCount, const MeshOptimizerSettings& settings) {
+        FL_PROFILE_ZONE("OptimizeVertexCache");
+
+        assert(indices.size() % 3 == 0 && "Index count isn't a multiple of 3.");
+
+        if (settings.Jobs == nullptr || indices.size() / 3 <= settings.ChunkTriangleCount) {
+            Tipsify(destination, indices, vertexCount, settings.CacheSize);
+            return;
+        }
+
+        ForEachChunk(*settings.Jobs, indices, vertexCount, settings.ChunkTriangleCount,
+                     [&destination, &settings](MeshChunk& chunk, const u64 firstIndex) {
+                         Tipsify(chunk.Result, chunk.Indices, chunk.GetVertexCount(), settings.CacheSize);
+
+                         for (u64 i = 0; i < chunk.Result.size(); i++) {
+                             destination[firstIndex + i] = chunk.Vertices[chunk.Result[i]];
+                         }
+                     });
+    }
+
+    void OptimizeOverdraw(const std::span<u32> destination, const std::span<const u32> indices, const f32* positions,
+                          const u32 vertexCount, const u32 positionStride, const MeshOptimizerSettings& settings) {
+        FL_PROFILE_ZONE("OptimizeOverdraw");
+
+        assert(indices.size() % 3 == 0 && "Index count isn't a multiple of 3.");
+
+        // Area weighted, so a dense patch of small triangles doesn't pull the center towards it.
+        glm::vec3 meshCentroid(0.0f);
+        f32 meshArea = 0.0f;
+        for (u64 i = 0; i + 2 < indices.size(); i += 3) {
+            const glm::vec3 a = ReadPosition(positions, positionStride, indices[i]);
+            const glm::vec3 b = ReadPosition(positions, positionStride, indices[i + 1]);
+            const glm::vec3 c = ReadPosition(positions, positionStride, indices[i + 2]);
+
+            const f32 area = glm::length(glm::cross(b - a, c - a));
+            meshCentroid += (a + b + c) * (area / 3.0f);
+            meshArea += area;
+        }
+
+        if (meshArea > 0.0f) {
+            meshCentroid /= meshArea;
+        }
+
+        if (settings.Jobs == nullptr || indices.size() / 3 <= settings.ChunkTriangleCount) {
+            std::vector<glm::vec3> vertexPositions(vertexCount);
+            for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+                vertexPositions[vertex] = ReadPosition(positions, positionStride, vertex);
+            }
+
+            SortClusters(destination, indices, vertexPositions, meshCentroid, settings.CacheSize,
+                         settings.OverdrawThreshold);
+            return;
+        }
+
+        ForEachChunk(*settings.Jobs, indices, vertexCount, settings.ChunkTriangleCount,
+                     [&](MeshChunk& chunk, const u64 firstIndex) {
+                         std::vector<glm::vec3> chunkPositions(chunk.GetVertexCount());
+                         for (u32 vertex = 0; vertex < chunk.GetVertexCount(); vertex++) {
+                             chunkPositions[vertex] = ReadPosition(positions, positionStride, chunk.Vertices[vertex]);
+                         }
+
+                         SortClusters(chunk.Result, chunk.Indices, chunkPositions, meshCentroid, settings.CacheSize,
+                                      settings.OverdrawThreshold);
+
+                         for (u64 i = 0; i < chunk.Result.size(); i++) {
+                             destination[firstIndex + i] = chunk.Vertices[chunk.Result[i]];
+                         }
+                     });
+    }
+
+    u32 GenerateVertexFetchRemap(const std::span<u32> remap, const std::span<const u32> indices,
+                                 const u32 vertexCount) {
+        FL_PROFILE_ZONE("GenerateVertexFetchRemap");
+
+        std::ranges::fill(remap.first(vertexCount), InvalidVertex);
+
+        u32 nextVertex = 0;
+        for (const u32 index : indices) {
+            if (remap[index] == InvalidVertex) {
+                remap[index] = nextVertex++;
+            }
+        }
+
+        return nextVertex;
+    }
+
+    VertexCacheStatistics AnalyzeVertexCache(const std::span<const u32> indices, const u32 vertexCount,
+                                             const u32 cacheSize) {
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<u8> used(vertexCount, 0);
+        u32 usedCount = 0;
+
+        VertexCacheStatistics statistics;
+        for (const u32 index : indices) {
+            statistics.TransformedVertexCount += cache.Access(index);
+            usedCount += used[index] == 0;
+            used[index] = 1;
+        }
+
+        if (!indices.empty()) {
+            statistics.Acmr = static_cast<f32>(statistics.TransformedVertexCount) /
+                              static_cast<f32>(indices.size() / 3);
+            statistics.Atvr = static_cast<f32>(statistics.TransformedVertexCount) / static_cast<f32>(usedCount);
+        }
+
+        return statistics;
+    }
+
+    VertexFetchStatistics AnalyzeVertexFetch(const std::span<const u32> indices, const u32 vertexCount,
+                                             const u32 vertexSize) {
+        const u64 lineCount = (static_cast<u64>(vertexCount) * vertexSize + FetchCacheLineSize - 1) /
+                              FetchCacheLineSize;
+        FifoCache cache(static_cast<u32>(lineCount), FetchCacheLineCount);
+        std::vector<u8> used(vertexCount, 0);
+        u64 usedCount = 0;
+
+        VertexFetchStatistics statistics;
+        for (const u32 index : indices) {
+            const u64 firstByte = static_cast<u64>(index) * vertexSize;
+            for (u64 line = firstByte / FetchCacheLineSize; line <= (firstByte + vertexSize - 1) / FetchCacheLineSize;
+                 line++) {
+                statistics.BytesFetched += cache.Access(static_cast<u32>(line)) ? FetchCacheLineSize : 0;
+            }
+
+            usedCount += used[index] == 0;
+            used[index] = 1;
+        }
+
+        if (usedCount > 0) {
+            statistics.Overfetch = static_cast<f32>(statistics.BytesFetched) /
+                                   static_cast<f32>(usedCount * vertexSize);
+        }
+
+        return statistics;
+    }
+
+    MeshOptimizationReport OptimizeMesh(MeshData& mesh, const MeshOptimizerSettings& settings) {
+        FL_PROFILE_ZONE("OptimizeMesh");
+
+        MeshOptimizationReport report;
+        report.SourceVertexCount = mesh.GetVertexCount();
+        report.TriangleCount = mesh.GetTriangleCount();
+        report.CacheBefore = AnalyzeVertexCache(mesh.Indices, mesh.GetVertexCount(), settings.CacheSize);
+        report.FetchBefore = AnalyzeVertexFetch(mesh.Indices, mesh.GetVertexCount(), sizeof(MeshVertex));
+
+        // The steps below need at least one vertex to point at, an empty mesh or an OBJ without faces has none.
+        if (mesh.Indices.empty() || mesh.Vertices.empty()) {
+            report.VertexCount = report.SourceVertexCount;
+            report.CacheAfter = report.CacheBefore;
+            report.FetchAfter = report.FetchBefore;
+            return report;
+        }
+
+        std::vector<u32> remap(mesh.GetVertexCount());
+        const u32 uniqueCount = GenerateVertexRemap(remap, mesh.Indices, mesh.Vertices.data(), mesh.GetVertexCount(),
+                                                    sizeof(MeshVertex), settings.Jobs);
+
+        std::vector<MeshVertex> vertices(uniqueCount);
+        RemapVertices(vertices.data(), mesh.Vertices.data(), mesh.GetVertexCount(), sizeof(MeshVertex), remap);
+        RemapIndices(mesh.Indices, mesh.Indices, remap);
+
+        std::vector<u32> indices(mesh.Indices.size());
+        if (settings.Jobs != nullptr && mesh.GetTriangleCount() > settings.ChunkTriangleCount) {
+            SortTrianglesSpatially(indices, mesh.Indices, &vertices[0].Position.x, uniqueCount, sizeof(MeshVertex),
+                                   settings.Jobs);
+            mesh.Indices.swap(indices);
+        }
+
+        OptimizeVertexCache(indices, mesh.Indices, uniqueCount, settings);
+
+        if (settings.OverdrawThreshold >= 1.0f) {
+            OptimizeOverdraw(mesh.Indices, indices, &vertices[0].Position.x, uniqueCount, sizeof(MeshVertex),
+                             settings);
+        } else {
+            mesh.Indices.swap(indices);
+        }
+
+        const u32 vertexCount = GenerateVertexFetchRemap(remap, mesh.Indices, uniqueCount);
+        mesh.Vertices.resize(vertexCount);
+        RemapVertices(mesh.Vertices.data(), vertices.data(), uniqueCount, sizeof(MeshVertex), remap);
+        RemapIndices(mesh.Indices, mesh.Indices, remap);
+
+        report.VertexCount = vertexCount;
+        report.CacheAfter = AnalyzeVertexCache(mesh.Indices, vertexCount, settings.CacheSize);
+        report.FetchAfter = AnalyzeVertexFetch(mesh.Indices, vertexCount, sizeof(MeshVertex));
+
+        return report;
+    }
+}
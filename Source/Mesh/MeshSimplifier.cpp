@@ -0,0 +1,712 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Mesh/MeshSimplifier.hpp>
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+#include <FlashlightEngine/Core/Window.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Flashlight {
+    namespace {
+        // Sum of squared distances to a set of planes, weighted by the area of the triangles they come from.
+        struct Quadric {
+            f64 A00 = 0.0, A11 = 0.0, A22 = 0.0, A01 = 0.0, A02 = 0.0, A12 = 0.0;
+            f64 B0 = 0.0, B1 = 0.0, B2 = 0.0;
+            f64 C = 0.0;
+            f64 Weight = 0.0;
+
+            // Plane through p with unit normal n.
+            static Quadric FromPlane(const glm::vec3& n, const glm::vec3& p, const f64 weight) {
+                const f64 d = -static_cast<f64>(glm::dot(n, p));
+
+                Quadric quadric;
+                quadric.A00 = weight * n.x * n.x;
+                quadric.A11 = weight * n.y * n.y;
+                quadric.A22 = weight * n.z * n.z;
+                quadric.A01 = weight * n.x * n.y;
+                quadric.A02 = weight * n.x * n.z;
+                quadric.A12 = weight * n.y * n.z;
+                quadric.B0 = weight * n.x * d;
+                quadric.B1 = weight * n.y * d;
+                quadric.B2 = weight * n.z * d;
+                quadric.C = weight * d * d;
+                quadric.Weight = weight;
+                return quadric;
+            }
+
+            Quadric& operator+=(const Quadric& other) {
+                A00 += other.A00;
+                A11 += other.A11;
+                A22 += other.A22;
+                A01 += other.A01;
+                A02 += other.A02;
+                A12 += other.A12;
+                B0 += other.B0;
+                B1 += other.B1;
+                B2 += other.B2;
+                C += other.C;
+                Weight += other.Weight;
+                return *this;
+            }
+
+            // Mean squared distance from p to the planes.
+            [[nodiscard]] f32 Evaluate(const glm::vec3& p) const {
+                const f64 x = p.x;
+                const f64 y = p.y;
+                const f64 z = p.z;
+                const f64 error = A00 * x * x + A11 * y * y + A22 * z * z +
+                                  2.0 * (A01 * x * y + A02 * x * z + A12 * y * z) +
+                                  2.0 * (B0 * x + B1 * y + B2 * z) + C;
+
+                return Weight > 0.0 ? static_cast<f32>(std::max(error, 0.0) / Weight) : 0.0f;
+            }
+        };
+
+        struct Collapse {
+            u32 From;
+            u32 To;
+            f32 Cost;
+        };
+
+        // Triangles around each vertex, rebuilt after every pass.
+        struct Adjacency {
+            std::vector<u32> Offsets;
+            std::vector<u32> Triangles;
+
+            void Build(const std::span<const u32> indices, const u32 vertexCount) {
+                Offsets.assign(vertexCount + 1, 0);
+                for (const u32 index : indices) {
+                    Offsets[index + 1]++;
+                }
+                for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+                    Offsets[vertex + 1] += Offsets[vertex];
+                }
+
+                Triangles.resize(indices.size());
+                std::vector<u32> cursors(Offsets.begin(), Offsets.end() - 1);
+                for (u32 i = 0; i < indices.size(); i++) {
+                    Triangles[cursors[indices[i]]++] = i / 3;
+                }
+            }
+
+            [[nodiscard]] std::span<const u32> Get(const u32 vertex) const {
+                return std::span(Triangles).subspan(Offsets[vertex], Offsets[vertex + 1] - Offsets[vertex]);
+            }
+        };
+
+        /*
+         * Marks the vertices that can't move: every vertex sharing its position with another one, which makes it
+         * part of an attribute seam, and both ends of edges with only one triangle.
+         */
+        std::vector<u8> FindLockedVertices(const std::span<const u32> indices,
+                                           const std::span<const glm::vec3> positions) {
+            const auto vertexCount = static_cast<u32>(positions.size());
+            std::vector<u8> locked(vertexCount, 0);
+
+            // Vertices sorted by position, equal positions end up next to each other.
+            std::vector<u32> order(vertexCount);
+            for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+                order[vertex] = vertex;
+            }
+            const auto positionKey = [&positions](const u32 vertex) {
+                return std::tuple(positions[vertex].x, positions[vertex].y, positions[vertex].z);
+            };
+            std::ranges::sort(order, {}, positionKey);
+
+            std::vector<u32> canonical(vertexCount);
+            for (u32 i = 0; i < vertexCount; i++) {
+                const bool sameAsPrevious = i > 0 && positionKey(order[i]) == positionKey(order[i - 1]);
+                canonical[order[i]] = sameAsPrevious ? canonical[order[i - 1]] : order[i];
+                if (sameAsPrevious) {
+                    locked[order[i]] = 1;
+                    locked[order[i - 1]] = 1;
+                }
+            }
+
+            // An edge is on a border when the edge going the other way doesn't exist.
+            std::vector<u64> edges;
+            edges.reserve(indices.size());
+            for (u64 i = 0; i < indices.size(); i += 3) {
+                for (u32 corner = 0; corner < 3; corner++) {
+                    const u64 a = canonical[indices[i + corner]];
+                    const u64 b = canonical[indices[i + (corner + 1) % 3]];
+                    edges.push_back(a << 32 | b);
+                }
+            }
+            std::ranges::sort(edges);
+
+            for (u64 i = 0; i < indices.size(); i += 3) {
+                for (u32 corner = 0; corner < 3; corner++) {
+                    const u32 a = indices[i + corner];
+                    const u32 b = indices[i + (corner + 1) % 3];
+                    const u64 reversed = static_cast<u64>(canonical[b]) << 32 | canonical[a];
+                    if (!std::ranges::binary_search(edges, reversed)) {
+                        locked[a] = 1;
+                        locked[b] = 1;
+                    }
+                }
+            }
+
+            return locked;
+        }
+
+        // Checks that moving from to to keeps every remaining triangle around from facing the same side.
+        bool HasFlips(const std::span<const u32> indices, const Adjacency& adjacency,
+                      const std::span<const glm::vec3> positions, const u32 from, const u32 to) {
+            for (const u32 triangle : adjacency.Get(from)) {
+                u32 a = indices[triangle * 3];
+                u32 b = indices[triangle * 3 + 1];
+                u32 c = indices[triangle * 3 + 2];
+
+                // Rotate so from comes first, the winding is kept.
+                while (a != from) {
+                    const u32 first = a;
+                    a = b;
+                    b = c;
+                    c = first;
+                }
+
+                if (b == to || c == to) {
+                    continue;
+                }
+
+                const glm::vec3 before = glm::cross(positions[b] - positions[from], positions[c] - positions[from]);
+                const glm::vec3 after = glm::cross(positions[b] - positions[to], positions[c] - positions[to]);
+                if (glm::dot(before, after) <= 0.0f) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /*
+         * Collapsing an edge merges the neighbours of both ends, they may only share the two vertices opposite to
+         * the edge or the surface folds onto itself.
+         */
+        void GatherNeighbours(const std::span<const u32> indices, const Adjacency& adjacency, const u32 vertex,
+                              std::vector<u32>& neighbours) {
+            neighbours.clear();
+            for (const u32 triangle : adjacency.Get(vertex)) {
+                for (u32 corner = 0; corner < 3; corner++) {
+                    if (indices[triangle * 3 + corner] != vertex) {
+                        neighbours.push_back(indices[triangle * 3 + corner]);
+                    }
+                }
+            }
+            std::ranges::sort(neighbours);
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        }
+
+        bool BreaksLink(const std::span<const u32> indices, const Adjacency& adjacency, const u32 from, const u32 to,
+                        std::vector<u32>& fromNeighbours, std::vector<u32>& toNeighbours) {
+            GatherNeighbours(indices, adjacency, from, fromNeighbours);
+            GatherNeighbours(indices, adjacency, to, toNeighbours);
+
+            u32 sharedCount = 0;
+            auto fromIt = fromNeighbours.begin();
+            auto toIt = toNeighbours.begin();
+            while (fromIt != fromNeighbours.end() && toIt != toNeighbours.end()) {
+                if (*fromIt < *toIt) {
+                    ++fromIt;
+                } else if (*toIt < *fromIt) {
+                    ++toIt;
+                } else {
+                    sharedCount++;
+                    ++fromIt;
+                    ++toIt;
+                }
+            }
+
+            return sharedCount > 2;
+        }
+
+        // Removes the triangles that lost a corner in a collapse. Returns the new index count.
+        u32 ApplyRemap(const std::span<u32> indices, const u32 indexCount, const std::span<const u32> remap) {
+            u32 written = 0;
+            for (u32 i = 0; i < indexCount; i += 3) {
+                const u32 a = remap[indices[i]];
+                const u32 b = remap[indices[i + 1]];
+                const u32 c = remap[indices[i + 2]];
+                if (a != b && b != c && a != c) {
+                    indices[written++] = a;
+                    indices[written++] = b;
+                    indices[written++] = c;
+                }
+            }
+
+            return written;
+        }
+
+        glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b,
+                                         const glm::vec3& c) {
+            // From Real-Time Collision Detection (Ericson), by the Voronoi region p is in.
+            const glm::vec3 ab = b - a;
+            const glm::vec3 ac = c - a;
+            const glm::vec3 ap = p - a;
+            const f32 d1 = glm::dot(ab, ap);
+            const f32 d2 = glm::dot(ac, ap);
+            if (d1 <= 0.0f && d2 <= 0.0f) {
+                return a;
+            }
+
+            const glm::vec3 bp = p - b;
+            const f32 d3 = glm::dot(ab, bp);
+            const f32 d4 = glm::dot(ac, bp);
+            if (d3 >= 0.0f && d4 <= d3) {
+                return b;
+            }
+
+            const f32 vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+                return a + ab * (d1 / (d1 - d3));
+            }
+
+            const glm::vec3 cp = p - c;
+            const f32 d5 = glm::dot(ab, cp);
+            const f32 d6 = glm::dot(ac, cp);
+            if (d6 >= 0.0f && d5 <= d6) {
+                return c;
+            }
+
+            const f32 vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+                return a + ac * (d2 / (d2 - d6));
+            }
+
+            const f32 va = d3 * d6 - d5 * d4;
+            if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+                return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+            }
+
+            const f32 denominator = 1.0f / (va + vb + vc);
+            return a + ab * (vb * denominator) + ac * (vc * denominator);
+        }
+
+        /*
+         * TriangleGrid : Uniform grid of the triangles of a mesh over a fixed box, for nearest surface queries from
+         * points inside that box.
+         */
+        class TriangleGrid {
+            std::span<const u32> m_Indices;
+            std::span<const MeshVertex> m_Vertices;
+            glm::vec3 m_Origin;
+            f32 m_CellSize;
+            std::array<i32, 3> m_CellCounts;
+            std::vector<u32> m_CellOffsets;
+            std::vector<u32> m_CellTriangles;
+
+        public:
+            TriangleGrid(const std::span<const u32> indices, const std::span<const MeshVertex> vertices,
+                         const glm::vec3& minimum, const glm::vec3& maximum)
+                : m_Indices(indices), m_Vertices(vertices), m_Origin(minimum) {
+                const auto triangleCount = static_cast<u32>(indices.size() / 3);
+                const glm::vec3 extent = glm::max(maximum - minimum, glm::vec3(1e-6f));
+
+                // Cells follow the size of the triangles, a surface crosses few of them so sizing by the volume
+                // would fill those with thousands of triangles.
+                f64 area = 0.0;
+                for (u32 triangle = 0; triangle < triangleCount; triangle++) {
+                    const glm::vec3& a = GetPosition(triangle, 0);
+                    area += 0.5 * glm::length(glm::cross(GetPosition(triangle, 1) - a, GetPosition(triangle, 2) - a));
+                }
+                const f32 triangleSize = std::sqrt(static_cast<f32>(area / std::max(triangleCount, 1u)));
+                m_CellSize = std::max(2.0f * triangleSize, std::max({extent.x, extent.y, extent.z}) / 256.0f);
+                for (u32 axis = 0; axis < 3; axis++) {
+                    m_CellCounts[axis] = std::max(static_cast<i32>(std::ceil(extent[axis] / m_CellSize)), 1);
+                }
+
+                const auto cellCount = static_cast<u32>(m_CellCounts[0] * m_CellCounts[1] * m_CellCounts[2]);
+                m_CellOffsets.assign(cellCount + 1, 0);
+
+                // Two passes over the cells each triangle box covers: count, then fill.
+                for (u32 pass = 0; pass < 2; pass++) {
+                    std::vector<u32> cursors;
+                    if (pass == 1) {
+                        for (u32 cell = 0; cell < cellCount; cell++) {
+                            m_CellOffsets[cell + 1] += m_CellOffsets[cell];
+                        }
+                        m_CellTriangles.resize(m_CellOffsets[cellCount]);
+                        cursors.assign(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+                    }
+
+                    for (u32 triangle = 0; triangle < triangleCount; triangle++) {
+                        const glm::vec3& a = GetPosition(triangle, 0);
+                        const glm::vec3& b = GetPosition(triangle, 1);
+                        const glm::vec3& c = GetPosition(triangle, 2);
+                        const std::array<i32, 3> first = GetCell(glm::min(a, glm::min(b, c)));
+                        const std::array<i32, 3> last = GetCell(glm::max(a, glm::max(b, c)));
+
+                        for (i32 z = first[2]; z <= last[2]; z++) {
+                            for (i32 y = first[1]; y <= last[1]; y++) {
+                                for (i32 x = first[0]; x <= last[0]; x++) {
+                                    const u32 cell = GetCellIndex(x, y, z);
+                                    if (pass == 0) {
+                                        m_CellOffsets[cell + 1]++;
+                                    } else {
+                                        m_CellTriangles[cursors[cell]++] = triangle;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            /*
+             * Searches rings of cells around p until no closer triangle can be in the next ring. Stops early once
+             * the distance is known to be at most floor, and returns an upper value of it then.
+             */
+            [[nodiscard]] f32 GetDistance(const glm::vec3& p, const f32 floor = 0.0f) const {
+                const std::array<i32, 3> center = GetCell(p);
+                const i32 maxRing = std::max({m_CellCounts[0], m_CellCounts[1], m_CellCounts[2]});
+
+                f32 best = std::numeric_limits<f32>::max();
+                for (i32 ring = 0; ring <= maxRing; ring++) {
+                    std::array<i32, 3> first;
+                    std::array<i32, 3> last;
+                    for (u32 axis = 0; axis < 3; axis++) {
+                        first[axis] = std::max(center[axis] - ring, 0);
+                        last[axis] = std::min(center[axis] + ring, m_CellCounts[axis] - 1);
+                    }
+
+                    for (i32 z = first[2]; z <= last[2]; z++) {
+                        for (i32 y = first[1]; y <= last[1]; y++) {
+                            for (i32 x = first[0]; x <= last[0]; x++) {
+                                const bool onRing = std::abs(x - center[0]) == ring ||
+                                                    std::abs(y - center[1]) == ring ||
+                                                    std::abs(z - center[2]) == ring;
+                                if (onRing) {
+                                    best = std::min(best, GetCellDistance(p, GetCellIndex(x, y, z)));
+                                }
+                            }
+                        }
+                    }
+
+                    // Cells outside this ring are at least as far as the faces of the box searched so far.
+                    f32 searched = std::numeric_limits<f32>::max();
+                    for (u32 axis = 0; axis < 3; axis++) {
+                        const f32 lower = m_Origin[axis] + static_cast<f32>(center[axis] - ring) * m_CellSize;
+                        const f32 upper = lower + static_cast<f32>(2 * ring + 1) * m_CellSize;
+                        searched = std::min({searched, p[axis] - lower, upper - p[axis]});
+                    }
+
+                    if (best <= std::max(searched, floor)) {
+                        break;
+                    }
+                }
+
+                return best;
+            }
+
+        private:
+            [[nodiscard]] f32 GetCellDistance(const glm::vec3& p, const u32 cell) const {
+                f32 best = std::numeric_limits<f32>::max();
+                for (u32 i = m_CellOffsets[cell]; i < m_CellOffsets[cell + 1]; i++) {
+                    const u32 triangle = m_CellTriangles[i];
+                    const glm::vec3 closest = ClosestPointOnTriangle(
+                        p, GetPosition(triangle, 0), GetPosition(triangle, 1), GetPosition(triangle, 2));
+                    best = std::min(best, glm::distance(p, closest));
+                }
+
+                return best;
+            }
+
+            [[nodiscard]] const glm::vec3& GetPosition(const u32 triangle, const u32 corner) const {
+                return m_Vertices[m_Indices[triangle * 3 + corner]].Position;
+            }
+
+            [[nodiscard]] std::array<i32, 3> GetCell(const glm::vec3& p) const {
+                std::array<i32, 3> cell;
+                for (u32 axis = 0; axis < 3; axis++) {
+                    cell[axis] = std::clamp(static_cast<i32>((p[axis] - m_Origin[axis]) / m_CellSize), 0,
+                                            m_CellCounts[axis] - 1);
+                }
+
+                return cell;
+            }
+
+            [[nodiscard]] u32 GetCellIndex(const i32 x, const i32 y, const i32 z) const {
+                return static_cast<u32>((z * m_CellCounts[1] + y) * m_CellCounts[0] + x);
+            }
+        };
+
+        /*
+         * Largest distance from the vertices and triangle centers of from to the surface in grid. Points can only
+         * raise the largest distance of their range so far, so their search stops as soon as they can't.
+         */
+        f32 MeasureOneSidedDistance(const std::span<const u32> from, const std::span<const MeshVertex> vertices,
+                                    const TriangleGrid& grid, JobSystem* jobs) {
+            // Shared vertices are measured once, they would otherwise come up in about six triangles each.
+            std::vector<u8> used(vertices.size(), 0);
+            std::vector<glm::vec3> points;
+            points.reserve(from.size() / 3 * 2);
+            for (u64 i = 0; i < from.size(); i += 3) {
+                const glm::vec3& a = vertices[from[i]].Position;
+                const glm::vec3& b = vertices[from[i + 1]].Position;
+                const glm::vec3& c = vertices[from[i + 2]].Position;
+                points.push_back((a + b + c) / 3.0f);
+
+                for (u32 corner = 0; corner < 3; corner++) {
+                    if (!used[from[i + corner]]) {
+                        used[from[i + corner]] = 1;
+                        points.push_back(vertices[from[i + corner]].Position);
+                    }
+                }
+            }
+
+            std::vector<f32> distances(points.size());
+            const auto measure = [&](const u32 begin, const u32 end) {
+                f32 worst = 0.0f;
+                for (u32 point = begin; point < end; point++) {
+                    distances[point] = grid.GetDistance(points[point], worst);
+                    worst = std::max(worst, distances[point]);
+                }
+            };
+
+            if (jobs != nullptr) {
+                jobs->ParallelFor(static_cast<u32>(points.size()), 1024, measure);
+            } else {
+                measure(0, static_cast<u32>(points.size()));
+            }
+
+            return distances.empty() ? 0.0f : *std::ranges::max_element(distances);
+        }
+    }
+
+    SimplifyResult SimplifyMesh(const std::span<u32> destination, const std::span<const u32> indices,
+                                const std::span<const MeshVertex> vertices, const SimplifySettings& settings) {
+        FL_PROFILE_ZONE("SimplifyMesh");
+
+        assert(indices.size() % 3 == 0 && "Index count isn't a multiple of 3.");
+        assert(destination.size() >= indices.size() && "Destination is too small.");
+
+        const auto vertexCount = static_cast<u32>(vertices.size());
+        std::copy(indices.begin(), indices.end(), destination.begin());
+
+        SimplifyResult result;
+        result.IndexCount = static_cast<u32>(indices.size());
+        if (result.IndexCount <= settings.TargetIndexCount || vertexCount == 0) {
+            return result;
+        }
+
+        // Positions scaled into the unit cube, so errors are relative to the mesh size.
+        glm::vec3 minimum(std::numeric_limits<f32>::max());
+        glm::vec3 maximum(std::numeric_limits<f32>::lowest());
+        for (const MeshVertex& vertex : vertices) {
+            minimum = glm::min(minimum, vertex.Position);
+            maximum = glm::max(maximum, vertex.Position);
+        }
+
+        const glm::vec3 extent = maximum - minimum;
+        const f32 largestExtent = std::max({extent.x, extent.y, extent.z});
+        const f32 scale = largestExtent > 0.0f ? 1.0f / largestExtent : 1.0f;
+
+        std::vector<glm::vec3> positions(vertexCount);
+        for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+            positions[vertex] = (vertices[vertex].Position - minimum) * scale;
+        }
+
+        const std::vector<u8> locked = FindLockedVertices(indices, positions);
+
+        std::vector<Quadric> quadrics(vertexCount);
+        for (u64 i = 0; i < indices.size(); i += 3) {
+            const glm::vec3& a = positions[indices[i]];
+            const glm::vec3& b = positions[indices[i + 1]];
+            const glm::vec3& c = positions[indices[i + 2]];
+
+            const glm::vec3 normal = glm::cross(b - a, c - a);
+            const f32 length = glm::length(normal);
+            if (length > 0.0f) {
+                const Quadric quadric = Quadric::FromPlane(normal / length, a, length * 0.5f);
+                quadrics[indices[i]] += quadric;
+                quadrics[indices[i + 1]] += quadric;
+                quadrics[indices[i + 2]] += quadric;
+            }
+        }
+
+        const f32 maxCost = settings.TargetError * settings.TargetError;
+        const std::span<u32> current = destination.first(indices.size());
+
+        Adjacency adjacency;
+        std::vector<Collapse> collapses;
+        std::vector<u32> remap(vertexCount);
+        std::vector<u8> touched(vertexCount);
+        std::vector<u32> fromNeighbours;
+        std::vector<u32> toNeighbours;
+        f32 worstCost = 0.0f;
+
+        // Each pass collapses the cheapest edges whose neighbourhoods don't overlap, then rebuilds the triangles.
+        while (result.IndexCount > settings.TargetIndexCount) {
+            const std::span<const u32> triangles = current.first(result.IndexCount);
+            adjacency.Build(triangles, vertexCount);
+
+            // Every interior edge shows up once in each direction, keep it once.
+            collapses.clear();
+            for (u32 i = 0; i < result.IndexCount; i += 3) {
+                for (u32 corner = 0; corner < 3; corner++) {
+                    const u32 a = triangles[i + corner];
+                    const u32 b = triangles[i + (corner + 1) % 3];
+                    if (a > b || (locked[a] && locked[b])) {
+                        continue;
+                    }
+
+                    const f32 costAB = locked[a] ? std::numeric_limits<f32>::max()
+                                                 : quadrics[a].Evaluate(positions[b]);
+                    const f32 costBA = locked[b] ? std::numeric_limits<f32>::max()
+                                                 : quadrics[b].Evaluate(positions[a]);
+                    collapses.push_back(costAB <= costBA ? Collapse{a, b, costAB} : Collapse{b, a, costBA});
+                }
+            }
+
+            std::ranges::sort(collapses, {}, &Collapse::Cost);
+
+            for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+                remap[vertex] = vertex;
+            }
+            std::ranges::fill(touched, 0);
+
+            const u32 trianglesToRemove = (result.IndexCount - settings.TargetIndexCount) / 3;
+            u32 removedCount = 0;
+            u32 collapseCount = 0;
+            for (const Collapse& collapse : collapses) {
+                if (collapse.Cost > maxCost || removedCount >= trianglesToRemove) {
+                    break;
+                }
+
+                if (touched[collapse.From] || touched[collapse.To] ||
+                    HasFlips(triangles, adjacency, positions, collapse.From, collapse.To) ||
+                    BreaksLink(triangles, adjacency, collapse.From, collapse.To, fromNeighbours, toNeighbours)) {
+                    continue;
+                }
+
+                // Nothing around from may change again in this pass, the checks above looked at it as it is.
+                for (const u32 triangle : adjacency.Get(collapse.From)) {
+                    u32 sharedCount = 0;
+                    for (u32 corner = 0; corner < 3; corner++) {
+                        const u32 vertex = triangles[triangle * 3 + corner];
+                        touched[vertex] = 1;
+                        sharedCount += vertex == collapse.To;
+                    }
+                    removedCount += sharedCount;
+                }
+
+                remap[collapse.From] = collapse.To;
+                quadrics[collapse.To] += quadrics[collapse.From];
+                worstCost = std::max(worstCost, collapse.Cost);
+                collapseCount++;
+            }
+
+            if (collapseCount == 0) {
+                break;
+            }
+
+            result.IndexCount = ApplyRemap(current, result.IndexCount, remap);
+        }
+
+        result.EstimatedError = std::sqrt(worstCost);
+        return result;
+    }
+
+    MeshLodChain BuildLodChain(const MeshData& mesh, const LodChainSettings& settings) {
+        FL_PROFILE_ZONE("BuildLodChain");
+
+        MeshLodChain chain;
+        chain.Indices = mesh.Indices;
+        chain.Lods.push_back({0, static_cast<u32>(mesh.Indices.size()), 0.0f});
+
+        std::vector<u32> previous = mesh.Indices;
+        std::vector<u32> next(previous.size());
+        f32 error = 0.0f;
+
+        while (chain.GetLodCount() < settings.MaxLodCount) {
+            const auto targetTriangleCount =
+                static_cast<u32>(static_cast<f32>(previous.size() / 3) * settings.ReductionRatio);
+            if (targetTriangleCount < settings.MinTriangleCount) {
+                break;
+            }
+
+            const SimplifyResult result =
+                SimplifyMesh(next, previous, mesh.Vertices, {targetTriangleCount * 3, settings.MaxError});
+
+            // Stalled on locked vertices or on the error limit, the next LODs would look the same.
+            if (static_cast<f32>(result.IndexCount) > static_cast<f32>(previous.size()) * 0.95f) {
+                break;
+            }
+
+            // The estimate of the step is a mean distance, far under the largest one, so the step is measured
+            // instead. Distances between successive LODs add up to at least the distance to the source, and the
+            // previous LOD gets smaller every step where the source would be measured in full each time.
+            const std::span<const u32> lod = std::span(next).first(result.IndexCount);
+            error += MeasureHausdorffDistance(previous, lod, mesh.Vertices, settings.Jobs) * LodErrorMargin;
+            chain.Lods.push_back({static_cast<u32>(chain.Indices.size()), result.IndexCount, error});
+            chain.Indices.insert(chain.Indices.end(), next.begin(), next.begin() + result.IndexCount);
+
+            previous.assign(next.begin(), next.begin() + result.IndexCount);
+        }
+
+        return chain;
+    }
+
+    void BuildLodChains(const std::span<const MeshData> meshes, const std::span<MeshLodChain> chains,
+                        const LodChainSettings& settings, JobSystem* jobs) {
+        FL_PROFILE_ZONE("BuildLodChains");
+
+        assert(chains.size() == meshes.size() && "There must be one LOD chain per mesh.");
+
+        // Waiting in a job runs other jobs, so the measures can use the job system too.
+        LodChainSettings chainSettings = settings;
+        if (jobs != nullptr) {
+            chainSettings.Jobs = jobs;
+        }
+
+        const auto build = [&](const u32 begin, const u32 end) {
+            for (u32 mesh = begin; mesh < end; mesh++) {
+                chains[mesh] = BuildLodChain(meshes[mesh], chainSettings);
+            }
+        };
+
+        if (jobs != nullptr) {
+            // Meshes are whole simplifications each, one per job.
+            jobs->ParallelFor(static_cast<u32>(meshes.size()), 1, build);
+        } else {
+            build(0, static_cast<u32>(meshes.size()));
+        }
+    }
+
+    f32 MeasureHausdorffDistance(const std::span<const u32> indicesA, const std::span<const u32> indicesB,
+                                 const std::span<const MeshVertex> vertices, JobSystem* jobs) {
+        FL_PROFILE_ZONE("MeasureHausdorffDistance");
+
+        if (indicesA.empty() || indicesB.empty()) {
+            return indicesA.size() == indicesB.size() ? 0.0f : std::numeric_limits<f32>::max();
+        }
+
+        glm::vec3 minimum(std::numeric_limits<f32>::max());
+        glm::vec3 maximum(std::numeric_limits<f32>::lowest());
+        for (const MeshVertex& vertex : vertices) {
+            minimum = glm::min(minimum, vertex.Position);
+            maximum = glm::max(maximum, vertex.Position);
+        }
+
+        const TriangleGrid gridA(indicesA, vertices, minimum, maximum);
+        const TriangleGrid gridB(indicesB, vertices, minimum, maximum);
+
+        return std::max(MeasureOneSidedDistance(indicesA, vertices, gridB, jobs),
+                        MeasureOneSidedDistance(indicesB, vertices, gridA, jobs));
+    }
+
+    LodSelector::LodSelector(const u32 viewportHeight, const f32 verticalFov, const f32 maxPixelError)
+        : m_PixelsPerUnit(static_cast<f32>(viewportHeight) / (2.0f * std::tan(verticalFov * 0.5f))),
+          m_MaxPixelError(maxPixelError) {
+    }
+
+    LodSelector LodSelector::FromWindow(const Window& window, const f32 verticalFov, const f32 maxPixelError) {
+        return {window.GetExtent().height, verticalFov, maxPixelError};
+    }
+}
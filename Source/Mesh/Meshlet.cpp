@@ -0,0 +1,445 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Mesh/Meshlet.hpp>
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Core/MemoryMappedFile.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace Flashlight {
+    namespace {
+        constexpr u8 NotInMeshlet = 0xFF;
+
+        // Below this, the normals spread over more than a half space and no camera position sees only back faces.
+        constexpr f32 MinConeSpread = 0.1f;
+
+        glm::vec3 ReadPosition(const f32* positions, const u32 positionStride, const u32 vertex) {
+            const u64 offset = static_cast<u64>(vertex) * positionStride;
+
+            glm::vec3 position;
+            std::memcpy(&position, reinterpret_cast<const std::byte*>(positions) + offset, sizeof(position));
+            return position;
+        }
+
+        // Unit normal of a triangle, zero if it is degenerate.
+        glm::vec3 ComputeNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+            const glm::vec3 normal = glm::cross(b - a, c - a);
+            const f32 length = glm::length(normal);
+            return length > 0.0f ? normal / length : glm::vec3(0.0f);
+        }
+
+        /*
+         * Meshlet being grown. Candidates are the triangles touching its vertices, found when a vertex is added
+         * rather than searched for every time.
+         */
+        class MeshletGrower {
+            std::span<const u32> m_Indices;
+            std::span<const glm::vec3> m_Normals;
+            std::span<const u32> m_AdjacencyOffsets;
+            std::span<const u32> m_Adjacency;
+            const MeshletBuildSettings& m_Settings;
+
+            std::vector<u8> m_Emitted;
+            std::vector<u8> m_IsCandidate;
+            std::vector<u8> m_LocalIndices;
+            std::vector<u32> m_LiveCounts;
+            std::vector<u32> m_Candidates;
+
+            Meshlet m_Meshlet{};
+            glm::vec3 m_NormalSum{0.0f};
+            u32 m_InputCursor = 0;
+
+        public:
+            MeshletGrower(const std::span<const u32> indices, const std::span<const glm::vec3> normals,
+                          const std::span<const u32> adjacencyOffsets, const std::span<const u32> adjacency,
+                          const MeshletBuildSettings& settings)
+                : m_Indices(indices), m_Normals(normals), m_AdjacencyOffsets(adjacencyOffsets),
+                  m_Adjacency(adjacency), m_Settings(settings), m_Emitted(normals.size(), 0),
+                  m_IsCandidate(normals.size(), 0), m_LocalIndices(adjacencyOffsets.size() - 1, NotInMeshlet),
+                  m_LiveCounts(adjacencyOffsets.size() - 1) {
+                for (u32 vertex = 0; vertex + 1 < adjacencyOffsets.size(); vertex++) {
+                    m_LiveCounts[vertex] = adjacencyOffsets[vertex + 1] - adjacencyOffsets[vertex];
+                }
+            }
+
+            void Build(MeshletMesh& meshlets) {
+                u32 triangle = NextInputTriangle();
+                while (triangle != InvalidTriangle) {
+                    Add(triangle, meshlets);
+
+                    triangle = m_Meshlet.TriangleCount < m_Settings.MaxTriangleCount ? PickCandidate()
+                                                                                     : InvalidTriangle;
+                    if (triangle == InvalidTriangle) {
+                        triangle = Finish(meshlets);
+                    }
+                }
+            }
+
+        private:
+            static constexpr u32 InvalidTriangle = std::numeric_limits<u32>::max();
+
+            u32 CountNewVertices(const u32 triangle) const {
+                const u32 a = m_Indices[triangle * 3];
+                const u32 b = m_Indices[triangle * 3 + 1];
+                const u32 c = m_Indices[triangle * 3 + 2];
+
+                return static_cast<u32>(m_LocalIndices[a] == NotInMeshlet) +
+                       static_cast<u32>(m_LocalIndices[b] == NotInMeshlet && b != a) +
+                       static_cast<u32>(m_LocalIndices[c] == NotInMeshlet && c != a && c != b);
+            }
+
+            // Triangles left around the corners, low values are in corners of the meshlet that would become islands.
+            u32 CountLiveTriangles(const u32 triangle) const {
+                return m_LiveCounts[m_Indices[triangle * 3]] + m_LiveCounts[m_Indices[triangle * 3 + 1]] +
+                       m_LiveCounts[m_Indices[triangle * 3 + 2]];
+            }
+
+            /*
+             * The candidate that fits and adds the fewest vertices. Ties go to the one with the fewest triangles left
+             * around it, facing away from the meshlet counting against it.
+             */
+            u32 PickCandidate() {
+                const f32 normalLength = glm::length(m_NormalSum);
+                const glm::vec3 axis = normalLength > 0.0f ? m_NormalSum / normalLength : glm::vec3(0.0f);
+
+                u32 best = InvalidTriangle;
+                u32 bestNewVertices = std::numeric_limits<u32>::max();
+                f32 bestScore = std::numeric_limits<f32>::max();
+                for (u32 i = 0; i < m_Candidates.size();) {
+                    const u32 triangle = m_Candidates[i];
+                    if (m_Emitted[triangle]) {
+                        m_IsCandidate[triangle] = 0;
+                        m_Candidates[i] = m_Candidates.back();
+                        m_Candidates.pop_back();
+                        continue;
+                    }
+                    i++;
+
+                    const u32 newVertices = CountNewVertices(triangle);
+                    if (m_Meshlet.VertexCount + newVertices > m_Settings.MaxVertexCount ||
+                        newVertices > bestNewVertices) {
+                        continue;
+                    }
+
+                    const f32 score = static_cast<f32>(CountLiveTriangles(triangle)) +
+                                      m_Settings.ConeWeight * (1.0f - glm::dot(m_Normals[triangle], axis));
+                    if (newVertices < bestNewVertices || score < bestScore ||
+                        (score == bestScore && triangle < best)) {
+                        best = triangle;
+                        bestNewVertices = newVertices;
+                        bestScore = score;
+                    }
+                }
+
+                return best;
+            }
+
+            void Add(const u32 triangle, MeshletMesh& meshlets) {
+                m_Emitted[triangle] = 1;
+                m_NormalSum += m_Normals[triangle];
+
+                for (u32 corner = 0; corner < 3; corner++) {
+                    const u32 vertex = m_Indices[triangle * 3 + corner];
+                    m_LiveCounts[vertex]--;
+                    if (m_LocalIndices[vertex] == NotInMeshlet) {
+                        m_LocalIndices[vertex] = static_cast<u8>(m_Meshlet.VertexCount++);
+                        meshlets.Vertices.push_back(vertex);
+
+                        for (u32 i = m_AdjacencyOffsets[vertex]; i < m_AdjacencyOffsets[vertex + 1]; i++) {
+                            const u32 neighbour = m_Adjacency[i];
+                            if (!m_Emitted[neighbour] && !m_IsCandidate[neighbour]) {
+                                m_IsCandidate[neighbour] = 1;
+                                m_Candidates.push_back(neighbour);
+                            }
+                        }
+                    }
+
+                    meshlets.Triangles.push_back(m_LocalIndices[vertex]);
+                }
+
+                m_Meshlet.TriangleCount++;
+            }
+
+            // Stores the meshlet and returns the triangle the next one starts from, next to it when possible.
+            u32 Finish(MeshletMesh& meshlets) {
+                meshlets.Meshlets.push_back(m_Meshlet);
+                meshlets.Triangles.resize((meshlets.Triangles.size() + 3) & ~static_cast<u64>(3), 0);
+
+                for (u32 i = 0; i < m_Meshlet.VertexCount; i++) {
+                    m_LocalIndices[meshlets.Vertices[m_Meshlet.VertexOffset + i]] = NotInMeshlet;
+                }
+
+                u32 next = InvalidTriangle;
+                u32 nextLiveTriangles = std::numeric_limits<u32>::max();
+                for (const u32 triangle : m_Candidates) {
+                    if (!m_Emitted[triangle] && CountLiveTriangles(triangle) < nextLiveTriangles) {
+                        next = triangle;
+                        nextLiveTriangles = CountLiveTriangles(triangle);
+                    }
+                    m_IsCandidate[triangle] = 0;
+                }
+                m_Candidates.clear();
+
+                m_Meshlet = {static_cast<u32>(meshlets.Vertices.size()), static_cast<u32>(meshlets.Triangles.size()),
+                             0, 0};
+                m_NormalSum = glm::vec3(0.0f);
+
+                return next != InvalidTriangle ? next : NextInputTriangle();
+            }
+
+            u32 NextInputTriangle() {
+                const auto triangleCount = static_cast<u32>(m_Normals.size());
+                while (m_InputCursor < triangleCount && m_Emitted[m_InputCursor]) {
+                    m_InputCursor++;
+                }
+
+                return m_InputCursor < triangleCount ? m_InputCursor : InvalidTriangle;
+            }
+        };
+    }
+
+    void BuildMeshlets(MeshletMesh& meshlets, const std::span<const u32> indices, const f32* positions,
+                       const u32 vertexCount, const u32 positionStride, const MeshletBuildSettings& settings) {
+        FL_PROFILE_ZONE("BuildMeshlets");
+
+        assert(indices.size() % 3 == 0 && "Index count isn't a multiple of 3.");
+        assert(settings.MaxVertexCount >= 3 && settings.MaxVertexCount < NotInMeshlet &&
+               "Meshlet vertex limit out of range.");
+        assert(settings.MaxTriangleCount >= 1 && "Meshlet triangle limit out of range.");
+
+        const auto triangleCount = static_cast<u32>(indices.size() / 3);
+
+        std::vector<glm::vec3> normals(triangleCount);
+        const auto computeNormals = [&](const u32 begin, const u32 end) {
+            for (u32 triangle = begin; triangle < end; triangle++) {
+                normals[triangle] = ComputeNormal(ReadPosition(positions, positionStride, indices[triangle * 3]),
+                                                  ReadPosition(positions, positionStride, indices[triangle * 3 + 1]),
+                                                  ReadPosition(positions, positionStride, indices[triangle * 3 + 2]));
+            }
+        };
+
+        if (settings.Jobs != nullptr) {
+            settings.Jobs->ParallelFor(triangleCount, 1 << 14, computeNormals);
+        } else {
+            computeNormals(0, triangleCount);
+        }
+
+        // Triangles around each vertex.
+        std::vector<u32> adjacencyOffsets(vertexCount + 1, 0);
+        for (const u32 index : indices) {
+            adjacencyOffsets[index + 1]++;
+        }
+        for (u32 vertex = 0; vertex < vertexCount; vertex++) {
+            adjacencyOffsets[vertex + 1] += adjacencyOffsets[vertex];
+        }
+
+        std::vector<u32> adjacency(indices.size());
+        std::vector<u32> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (u32 triangle = 0; triangle < triangleCount; triangle++) {
+            for (u32 corner = 0; corner < 3; corner++) {
+                adjacency[cursors[indices[triangle * 3 + corner]]++] = triangle;
+            }
+        }
+
+        meshlets.Meshlets.clear();
+        meshlets.Vertices.clear();
+        meshlets.Triangles.clear();
+
+        MeshletGrower grower(indices, normals, adjacencyOffsets, adjacency, settings);
+        grower.Build(meshlets);
+
+        meshlets.Bounds.resize(meshlets.Meshlets.size());
+        const auto computeBounds = [&](const u32 begin, const u32 end) {
+            for (u32 i = begin; i < end; i++) {
+                const Meshlet& meshlet = meshlets.Meshlets[i];
+                meshlets.Bounds[i] = ComputeMeshletBounds(meshlets.GetVertices(meshlet), meshlets.GetTriangles(meshlet),
+                                                          positions, positionStride);
+            }
+        };
+
+        if (settings.Jobs != nullptr) {
+            settings.Jobs->ParallelFor(meshlets.GetMeshletCount(), 256, computeBounds);
+        } else {
+            computeBounds(0, meshlets.GetMeshletCount());
+        }
+    }
+
+    MeshletBounds ComputeMeshletBounds(const std::span<const u32> vertices, const std::span<const u8> triangles,
+                                       const f32* positions, const u32 positionStride) {
+        MeshletBounds bounds{glm::vec3(0.0f), 0.0f, glm::vec3(0.0f, 0.0f, 1.0f), 1.0f};
+        if (vertices.empty()) {
+            return bounds;
+        }
+
+        // Ritter's sphere: start from the two farthest axis extremes, then grow to take in every outlier.
+        std::array<glm::vec3, 3> minimums;
+        std::array<glm::vec3, 3> maximums;
+        minimums.fill(ReadPosition(positions, positionStride, vertices[0]));
+        maximums = minimums;
+
+        for (const u32 vertex : vertices) {
+            const glm::vec3 position = ReadPosition(positions, positionStride, vertex);
+            for (u32 axis = 0; axis < 3; axis++) {
+                minimums[axis] = position[axis] < minimums[axis][axis] ? position : minimums[axis];
+                maximums[axis] = position[axis] > maximums[axis][axis] ? position : maximums[axis];
+            }
+        }
+
+        u32 widestAxis = 0;
+        for (u32 axis = 1; axis < 3; axis++) {
+            if (glm::distance(minimums[axis], maximums[axis]) >
+                glm::distance(minimums[widestAxis], maximums[widestAxis])) {
+                widestAxis = axis;
+            }
+        }
+
+        glm::vec3 center = (minimums[widestAxis] + maximums[widestAxis]) * 0.5f;
+        f32 radius = glm::distance(minimums[widestAxis], maximums[widestAxis]) * 0.5f;
+
+        for (const u32 vertex : vertices) {
+            const glm::vec3 position = ReadPosition(positions, positionStride, vertex);
+            const f32 distance = glm::distance(position, center);
+            if (distance > radius) {
+                const f32 newRadius = (radius + distance) * 0.5f;
+                center += (position - center) * ((newRadius - radius) / distance);
+                radius = newRadius;
+            }
+        }
+
+        bounds.Center = center;
+        bounds.Radius = radius;
+
+        // The cone axis is the average normal, its cutoff the sine of the widest angle between a normal and the axis.
+        std::vector<glm::vec3> normals;
+        normals.reserve(triangles.size() / 3);
+        glm::vec3 normalSum(0.0f);
+        for (u64 i = 0; i + 2 < triangles.size(); i += 3) {
+            const glm::vec3 normal = ComputeNormal(ReadPosition(positions, positionStride, vertices[triangles[i]]),
+                                                   ReadPosition(positions, positionStride, vertices[triangles[i + 1]]),
+                                                   ReadPosition(positions, positionStride, vertices[triangles[i + 2]]));
+            if (normal != glm::vec3(0.0f)) {
+                normals.push_back(normal);
+                normalSum += normal;
+            }
+        }
+
+        const f32 normalLength = glm::length(normalSum);
+        if (normalLength <= 0.0f) {
+            return bounds;
+        }
+
+        const glm::vec3 axis = normalSum / normalLength;
+        f32 minimumDot = 1.0f;
+        for (const glm::vec3& normal : normals) {
+            minimumDot = std::min(minimumDot, glm::dot(normal, axis));
+        }
+
+        bounds.ConeAxis = axis;
+        bounds.ConeCutoff = minimumDot > MinConeSpread ? std::sqrt(1.0f - minimumDot * minimumDot) : 1.0f;
+        return bounds;
+    }
+
+    bool SaveMeshlets(const std::filesystem::path& path, const MeshletMesh& meshlets) {
+        FL_PROFILE_ZONE("SaveMeshlets");
+
+        MeshletFileHeader header{};
+        header.Magic = MeshletFileMagic;
+        header.Version = MeshletFileVersion;
+        header.MeshletCount = meshlets.GetMeshletCount();
+        header.VertexCount = static_cast<u32>(meshlets.Vertices.size());
+        header.TriangleSize = static_cast<u32>(meshlets.Triangles.size());
+
+        const u64 meshletsSize = static_cast<u64>(header.MeshletCount) * sizeof(Meshlet);
+        const u64 boundsSize = static_cast<u64>(header.MeshletCount) * sizeof(MeshletBounds);
+        const u64 verticesSize = static_cast<u64>(header.VertexCount) * sizeof(u32);
+
+        MemoryMappedFile file;
+        if (!file.Create(path, sizeof(header) + meshletsSize + boundsSize + verticesSize + header.TriangleSize)) {
+            Log::EngineError(fmt::format("Failed to write meshlets to {0}.", path.string()));
+            return false;
+        }
+
+        std::byte* data = file.GetData();
+        std::memcpy(data, &header, sizeof(header));
+        data += sizeof(header);
+        std::memcpy(data, meshlets.Meshlets.data(), meshletsSize);
+        data += meshletsSize;
+        std::memcpy(data, meshlets.Bounds.data(), boundsSize);
+        data += boundsSize;
+        std::memcpy(data, meshlets.Vertices.data(), verticesSize);
+        data += verticesSize;
+        std::memcpy(data, meshlets.Triangles.data(), header.TriangleSize);
+
+        return true;
+    }
+
+    bool LoadMeshlets(const std::filesystem::path& path, MeshletMesh& meshlets) {
+        FL_PROFILE_ZONE("LoadMeshlets");
+
+        MemoryMappedFile file;
+        if (!file.OpenRead(path)) {
+            return false;
+        }
+
+        const auto fail = [&path](const std::string_view reason) {
+            Log::EngineError(fmt::format("Failed to load meshlets from {0}, {1}.", path.string(), reason));
+            return false;
+        };
+
+        MeshletFileHeader header;
+        if (file.GetSize() < sizeof(header)) {
+            return fail("the file is too small");
+        }
+
+        std::memcpy(&header, file.GetData(), sizeof(header));
+        if (header.Magic != MeshletFileMagic) {
+            return fail("it isn't a meshlet file");
+        }
+        if (header.Version != MeshletFileVersion) {
+            return fail(fmt::format("version {0} isn't supported", header.Version));
+        }
+
+        const u64 meshletsSize = static_cast<u64>(header.MeshletCount) * sizeof(Meshlet);
+        const u64 boundsSize = static_cast<u64>(header.MeshletCount) * sizeof(MeshletBounds);
+        const u64 verticesSize = static_cast<u64>(header.VertexCount) * sizeof(u32);
+        if (file.GetSize() != sizeof(header) + meshletsSize + boundsSize + verticesSize + header.TriangleSize) {
+            return fail("its size doesn't match its header");
+        }
+
+        meshlets.Meshlets.resize(header.MeshletCount);
+        meshlets.Bounds.resize(header.MeshletCount);
+        meshlets.Vertices.resize(header.VertexCount);
+        meshlets.Triangles.resize(header.TriangleSize);
+
+        const std::byte* data = file.GetData() + sizeof(header);
+        std::memcpy(meshlets.Meshlets.data(), data, meshletsSize);
+        data += meshletsSize;
+        std::memcpy(meshlets.Bounds.data(), data, boundsSize);
+        data += boundsSize;
+        std::memcpy(meshlets.Vertices.data(), data, verticesSize);
+        data += verticesSize;
+        std::memcpy(meshlets.Triangles.data(), data, header.TriangleSize);
+
+        for (const Meshlet& meshlet : meshlets.Meshlets) {
+            const bool inBounds =
+                static_cast<u64>(meshlet.VertexOffset) + meshlet.VertexCount <= header.VertexCount &&
+                static_cast<u64>(meshlet.TriangleOffset) + static_cast<u64>(meshlet.TriangleCount) * 3 <=
+                    header.TriangleSize;
+            if (!inBounds || !std::ranges::all_of(meshlets.GetTriangles(meshlet), [&meshlet](const u8 index) {
+                    return index < meshlet.VertexCount;
+                })) {
+                meshlets = {};
+                return fail("a meshlet is out of bounds");
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,163 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Renderer/Culling.hpp>
+
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace Flashlight {
+    // Defined by the files under Kernels, each built for its instruction set. Null when the compiler can't target it.
+    const CullingKernels* GetSse42CullingKernels();
+    const CullingKernels* GetAvx2CullingKernels();
+    const CullingKernels* GetAvx512CullingKernels();
+
+    namespace {
+#include "Kernels/CullingKernels.inl"
+
+        constexpr CullingKernels ScalarKernels = MakeCullingKernels<ScalarLanes>();
+
+        const CullingKernels& GetActiveKernels() {
+            // Walks down to the best level the engine was built with.
+            for (i32 level = static_cast<i32>(GetSimdLevel()); level >= 0; level--) {
+                if (const CullingKernels* kernels = GetCullingKernels(static_cast<SimdLevel>(level))) {
+                    return *kernels;
+                }
+            }
+
+            return ScalarKernels;
+        }
+
+        SphereArrays GetArrays(const BoundingSpheres& spheres) {
+            return {spheres.CenterX.data(), spheres.CenterY.data(), spheres.CenterZ.data(), spheres.Radius.data()};
+        }
+
+        BoxArrays GetArrays(const BoundingBoxes& boxes) {
+            return {boxes.CenterX.data(), boxes.CenterY.data(), boxes.CenterZ.data(),
+                    boxes.ExtentX.data(), boxes.ExtentY.data(), boxes.ExtentZ.data()};
+        }
+
+        u32 CullRange(const CullingKernels& kernels, const Frustum& frustum, const BoundingSpheres& spheres,
+                      const u32 begin, const u32 end, u32* visible) {
+            return kernels.CullSpheres(&frustum.Planes[0].x, GetArrays(spheres), begin, end, visible);
+        }
+
+        u32 CullRange(const CullingKernels& kernels, const Frustum& frustum, const BoundingBoxes& boxes,
+                      const u32 begin, const u32 end, u32* visible) {
+            return kernels.CullBoxes(&frustum.Planes[0].x, GetArrays(boxes), begin, end, visible);
+        }
+
+        bool IsOccluded(const OcclusionBuffer& occlusion, const BoundingSpheres& spheres, const u32 index) {
+            return !occlusion.IsBoxVisible({spheres.CenterX[index], spheres.CenterY[index], spheres.CenterZ[index]},
+                                           glm::vec3(spheres.Radius[index]));
+        }
+
+        bool IsOccluded(const OcclusionBuffer& occlusion, const BoundingBoxes& boxes, const u32 index) {
+            return !occlusion.IsBoxVisible({boxes.CenterX[index], boxes.CenterY[index], boxes.CenterZ[index]},
+                                           {boxes.ExtentX[index], boxes.ExtentY[index], boxes.ExtentZ[index]});
+        }
+    }
+
+    static_assert(sizeof(Frustum::Planes) == 24 * sizeof(f32), "The kernels read the planes as 24 packed floats.");
+
+    Frustum Frustum::FromViewProjection(const glm::mat4& viewProjection) {
+        const auto row = [&viewProjection](const u32 index) {
+            return glm::vec4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index],
+                             viewProjection[3][index]);
+        };
+
+        Frustum frustum;
+        frustum.Planes[0] = row(3) + row(0);
+        frustum.Planes[1] = row(3) - row(0);
+        frustum.Planes[2] = row(3) + row(1);
+        frustum.Planes[3] = row(3) - row(1);
+        frustum.Planes[4] = row(2);
+        frustum.Planes[5] = row(3) - row(2);
+
+        for (glm::vec4& plane : frustum.Planes) {
+            plane /= glm::length(glm::vec3(plane));
+        }
+
+        return frustum;
+    }
+
+    u32 CullSpheres(const Frustum& frustum, const BoundingSpheres& spheres, const u32 begin, const u32 end,
+                    u32* visible) {
+        return CullRange(GetActiveKernels(), frustum, spheres, begin, end, visible);
+    }
+
+    u32 CullBoxes(const Frustum& frustum, const BoundingBoxes& boxes, const u32 begin, const u32 end, u32* visible) {
+        return CullRange(GetActiveKernels(), frustum, boxes, begin, end, visible);
+    }
+
+    const CullingKernels* GetCullingKernels(const SimdLevel level) {
+        switch (level) {
+        case SimdLevel::Scalar:
+            return &ScalarKernels;
+        case SimdLevel::Sse42:
+            return GetSse42CullingKernels();
+        case SimdLevel::Avx2:
+            return GetAvx2CullingKernels();
+        case SimdLevel::Avx512:
+            return GetAvx512CullingKernels();
+        }
+
+        return nullptr;
+    }
+
+    CullingStats Culler::Cull(const Frustum& frustum, const BoundingSpheres& spheres, std::vector<u32>& visible,
+                              const CullingSettings& settings) {
+        return CullImpl(frustum, spheres, visible, settings);
+    }
+
+    CullingStats Culler::Cull(const Frustum& frustum, const BoundingBoxes& boxes, std::vector<u32>& visible,
+                              const CullingSettings& settings) {
+        return CullImpl(frustum, boxes, visible, settings);
+    }
+
+    template <typename Bounds>
+    CullingStats Culler::CullImpl(const Frustum& frustum, const Bounds& bounds, std::vector<u32>& visible,
+                                  const CullingSettings& settings) {
+        FL_PROFILE_ZONE("Culler::Cull");
+
+        // Resolved once, so every range uses the same level even if SetSimdLevel is called meanwhile.
+        const CullingKernels& kernels = GetActiveKernels();
+        const auto cullFrustum = [&](const u32 begin, const u32 end, u32* rangeVisible) {
+            return CullRange(kernels, frustum, bounds, begin, end, rangeVisible);
+        };
+
+        const u32 count = bounds.GetCount();
+        CullingRangeCounts counts;
+        if (settings.Occlusion != nullptr) {
+            counts = m_Ranges.Run(count, RangeSize, settings.Jobs, visible, cullFrustum, [&](const u32 index) {
+                return IsOccluded(*settings.Occlusion, bounds, index);
+            });
+        } else {
+            counts = m_Ranges.Run(count, RangeSize, settings.Jobs, visible, cullFrustum, [](u32) { return false; });
+        }
+
+        CullingStats stats;
+        stats.TestedCount = count;
+        stats.FrustumCulledCount = counts.FirstCulledCount;
+        stats.OcclusionCulledCount = counts.SecondCulledCount;
+        stats.VisibleCount = counts.VisibleCount;
+
+        if (!settings.TriangleCounts.empty()) {
+            for (const u32 index : visible) {
+                stats.VisibleTriangleCount += settings.TriangleCounts[index];
+            }
+        }
+
+        if (settings.Stats != nullptr) {
+            ReportCullingStats(stats, *settings.Stats);
+        }
+
+        return stats;
+    }
+}
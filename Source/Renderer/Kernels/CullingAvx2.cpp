@@ -0,0 +1,51 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Built with AVX2 and FMA enabled, see CullingKernels.hpp for what this file may include.
+#include <FlashlightEngine/Renderer/CullingKernels.hpp>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+
+namespace Flashlight {
+    namespace {
+        struct Lanes {
+            using Register = __m256;
+            using Mask = __m256;
+            static constexpr u32 Width = 8;
+
+            static Register Load(const f32* values) { return _mm256_loadu_ps(values); }
+            static Register Set(const f32 value) { return _mm256_set1_ps(value); }
+            static Register Add(const Register lhs, const Register rhs) { return _mm256_add_ps(lhs, rhs); }
+            static Mask And(const Mask lhs, const Mask rhs) { return _mm256_and_ps(lhs, rhs); }
+            static Mask AllSet() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+            static u32 ToBits(const Mask mask) { return static_cast<u32>(_mm256_movemask_ps(mask)); }
+
+            static Register MulAdd(const Register a, const Register b, const Register c) {
+                return _mm256_fmadd_ps(a, b, c);
+            }
+
+            static Mask GreaterEqual(const Register lhs, const Register rhs) {
+                return _mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ);
+            }
+        };
+
+#include "CullingKernels.inl"
+    }
+
+    const CullingKernels* GetAvx2CullingKernels() {
+        static constexpr CullingKernels kernels = MakeCullingKernels<Lanes>();
+        return &kernels;
+    }
+}
+#else
+namespace Flashlight {
+    const CullingKernels* GetAvx2CullingKernels() {
+        return nullptr;
+    }
+}
+#endif
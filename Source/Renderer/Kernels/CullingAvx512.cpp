@@ -0,0 +1,51 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Built with AVX-512F enabled, see CullingKernels.hpp for what this file may include.
+#include <FlashlightEngine/Renderer/CullingKernels.hpp>
+
+#if defined(__AVX512F__)
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+
+namespace Flashlight {
+    namespace {
+        struct Lanes {
+            using Register = __m512;
+            using Mask = __mmask16;
+            static constexpr u32 Width = 16;
+
+            static Register Load(const f32* values) { return _mm512_loadu_ps(values); }
+            static Register Set(const f32 value) { return _mm512_set1_ps(value); }
+            static Register Add(const Register lhs, const Register rhs) { return _mm512_add_ps(lhs, rhs); }
+            static Mask And(const Mask lhs, const Mask rhs) { return static_cast<Mask>(lhs & rhs); }
+            static Mask AllSet() { return static_cast<Mask>(0xFFFF); }
+            static u32 ToBits(const Mask mask) { return mask; }
+
+            static Register MulAdd(const Register a, const Register b, const Register c) {
+                return _mm512_fmadd_ps(a, b, c);
+            }
+
+            static Mask GreaterEqual(const Register lhs, const Register rhs) {
+                return _mm512_cmp_ps_mask(lhs, rhs, _CMP_GE_OQ);
+            }
+        };
+
+#include "CullingKernels.inl"
+    }
+
+    const CullingKernels* GetAvx512CullingKernels() {
+        static constexpr CullingKernels kernels = MakeCullingKernels<Lanes>();
+        return &kernels;
+    }
+}
+#else
+namespace Flashlight {
+    const CullingKernels* GetAvx512CullingKernels() {
+        return nullptr;
+    }
+}
+#endif
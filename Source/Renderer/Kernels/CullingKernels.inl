@@ -0,0 +1,148 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Kernels shared by every instruction set, included in an anonymous namespace after a Lanes type wrapping the
+// registers: Register, Mask, Width, Load (unaligned), Set, Add, MulAdd (a * b + c), GreaterEqual, And, AllSet and
+// ToBits (one bit per lane). The objects left after the last full register go through ScalarLanes, which is also the
+// Scalar level. Every level sums the plane distances in the same order, only AVX2 and AVX-512 fuse the multiply-adds,
+// so objects within a rounding error of a plane may be kept by one level and culled by another.
+
+constexpr u32 FrustumPlaneCount = 6;
+
+// Index of the lowest bit set, mask isn't 0. The builtins rather than std::countr_zero, see CullingKernels.hpp.
+inline u32 FindLowestBit(const u32 mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<u32>(index);
+#else
+    return static_cast<u32>(__builtin_ctz(mask));
+#endif
+}
+
+// Appends begin + i for every bit i set in mask.
+inline u32 AppendMask(u32 mask, const u32 begin, u32* visible) {
+    u32 count = 0;
+    while (mask != 0) {
+        visible[count++] = begin + FindLowestBit(mask);
+        mask &= mask - 1;
+    }
+
+    return count;
+}
+
+inline f32 Abs(const f32 value) {
+    return value < 0.0f ? -value : value;
+}
+
+struct ScalarLanes {
+    using Register = f32;
+    using Mask = bool;
+    static constexpr u32 Width = 1;
+
+    static Register Load(const f32* values) { return *values; }
+    static Register Set(const f32 value) { return value; }
+    static Register Add(const Register lhs, const Register rhs) { return lhs + rhs; }
+    static Register MulAdd(const Register a, const Register b, const Register c) { return a * b + c; }
+    static Mask GreaterEqual(const Register lhs, const Register rhs) { return lhs >= rhs; }
+    static Mask And(const Mask lhs, const Mask rhs) { return lhs && rhs; }
+    static Mask AllSet() { return true; }
+    static u32 ToBits(const Mask mask) { return mask ? 1u : 0u; }
+};
+
+template <typename Lanes>
+u32 CullSpheres(const f32* planes, const SphereArrays& spheres, const u32 begin, const u32 end, u32* visible) {
+    using Register = typename Lanes::Register;
+    using Mask = typename Lanes::Mask;
+
+    Register p[FrustumPlaneCount][4];
+    for (u32 plane = 0; plane < FrustumPlaneCount; plane++) {
+        for (u32 component = 0; component < 4; component++) {
+            p[plane][component] = Lanes::Set(planes[plane * 4 + component]);
+        }
+    }
+
+    const Register zero = Lanes::Set(0.0f);
+
+    u32 count = 0;
+    u32 index = begin;
+    for (; index + Lanes::Width <= end; index += Lanes::Width) {
+        const Register x = Lanes::Load(spheres.CenterX + index);
+        const Register y = Lanes::Load(spheres.CenterY + index);
+        const Register z = Lanes::Load(spheres.CenterZ + index);
+        const Register radius = Lanes::Load(spheres.Radius + index);
+
+        // Visible while distance + radius >= 0 for every plane.
+        Mask inside = Lanes::AllSet();
+        for (u32 plane = 0; plane < FrustumPlaneCount; plane++) {
+            Register distance = Lanes::MulAdd(x, p[plane][0], p[plane][3]);
+            distance = Lanes::MulAdd(y, p[plane][1], distance);
+            distance = Lanes::MulAdd(z, p[plane][2], distance);
+            inside = Lanes::And(inside, Lanes::GreaterEqual(Lanes::Add(distance, radius), zero));
+        }
+
+        count += AppendMask(Lanes::ToBits(inside), index, visible + count);
+    }
+
+    if constexpr (Lanes::Width > 1) {
+        count += CullSpheres<ScalarLanes>(planes, spheres, index, end, visible + count);
+    }
+
+    return count;
+}
+
+template <typename Lanes>
+u32 CullBoxes(const f32* planes, const BoxArrays& boxes, const u32 begin, const u32 end, u32* visible) {
+    using Register = typename Lanes::Register;
+    using Mask = typename Lanes::Mask;
+
+    // The box corner furthest along the normal is center + |normal| * extents away from the plane.
+    Register p[FrustumPlaneCount][4];
+    Register absolute[FrustumPlaneCount][3];
+    for (u32 plane = 0; plane < FrustumPlaneCount; plane++) {
+        for (u32 component = 0; component < 4; component++) {
+            p[plane][component] = Lanes::Set(planes[plane * 4 + component]);
+        }
+        for (u32 component = 0; component < 3; component++) {
+            absolute[plane][component] = Lanes::Set(Abs(planes[plane * 4 + component]));
+        }
+    }
+
+    const Register zero = Lanes::Set(0.0f);
+
+    u32 count = 0;
+    u32 index = begin;
+    for (; index + Lanes::Width <= end; index += Lanes::Width) {
+        const Register x = Lanes::Load(boxes.CenterX + index);
+        const Register y = Lanes::Load(boxes.CenterY + index);
+        const Register z = Lanes::Load(boxes.CenterZ + index);
+        const Register extentX = Lanes::Load(boxes.ExtentX + index);
+        const Register extentY = Lanes::Load(boxes.ExtentY + index);
+        const Register extentZ = Lanes::Load(boxes.ExtentZ + index);
+
+        Mask inside = Lanes::AllSet();
+        for (u32 plane = 0; plane < FrustumPlaneCount; plane++) {
+            Register distance = Lanes::MulAdd(x, p[plane][0], p[plane][3]);
+            distance = Lanes::MulAdd(y, p[plane][1], distance);
+            distance = Lanes::MulAdd(z, p[plane][2], distance);
+            distance = Lanes::MulAdd(extentX, absolute[plane][0], distance);
+            distance = Lanes::MulAdd(extentY, absolute[plane][1], distance);
+            distance = Lanes::MulAdd(extentZ, absolute[plane][2], distance);
+            inside = Lanes::And(inside, Lanes::GreaterEqual(distance, zero));
+        }
+
+        count += AppendMask(Lanes::ToBits(inside), index, visible + count);
+    }
+
+    if constexpr (Lanes::Width > 1) {
+        count += CullBoxes<ScalarLanes>(planes, boxes, index, end, visible + count);
+    }
+
+    return count;
+}
+
+template <typename Lanes>
+constexpr CullingKernels MakeCullingKernels() {
+    return {CullSpheres<Lanes>, CullBoxes<Lanes>};
+}
@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Built with SSE4.2 enabled, see CullingKernels.hpp for what this file may include.
+#include <FlashlightEngine/Renderer/CullingKernels.hpp>
+
+#if defined(__SSE4_2__) || defined(_M_X64)
+    #include <nmmintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+
+namespace Flashlight {
+    namespace {
+        struct Lanes {
+            using Register = __m128;
+            using Mask = __m128;
+            static constexpr u32 Width = 4;
+
+            static Register Load(const f32* values) { return _mm_loadu_ps(values); }
+            static Register Set(const f32 value) { return _mm_set1_ps(value); }
+            static Register Add(const Register lhs, const Register rhs) { return _mm_add_ps(lhs, rhs); }
+            static Mask GreaterEqual(const Register lhs, const Register rhs) { return _mm_cmpge_ps(lhs, rhs); }
+            static Mask And(const Mask lhs, const Mask rhs) { return _mm_and_ps(lhs, rhs); }
+            static Mask AllSet() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+            static u32 ToBits(const Mask mask) { return static_cast<u32>(_mm_movemask_ps(mask)); }
+
+            static Register MulAdd(const Register a, const Register b, const Register c) {
+                return _mm_add_ps(_mm_mul_ps(a, b), c);
+            }
+        };
+
+#include "CullingKernels.inl"
+    }
+
+    const CullingKernels* GetSse42CullingKernels() {
+        static constexpr CullingKernels kernels = MakeCullingKernels<Lanes>();
+        return &kernels;
+    }
+}
+#else
+namespace Flashlight {
+    const CullingKernels* GetSse42CullingKernels() {
+        return nullptr;
+    }
+}
+#endif
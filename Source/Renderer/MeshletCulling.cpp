@@ -0,0 +1,46 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Renderer/MeshletCulling.hpp>
+
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+namespace Flashlight {
+    MeshletCullingStats MeshletCuller::Cull(const MeshletMesh& meshlets, const Frustum& frustum,
+                                            const glm::vec3& cameraPosition, std::vector<u32>& visible,
+                                            const MeshletCullingSettings& settings) {
+        FL_PROFILE_ZONE("MeshletCuller::Cull");
+
+        const auto cullFrustum = [&](const u32 begin, const u32 end, u32* rangeVisible) {
+            u32 frustumCount = 0;
+            for (u32 meshlet = begin; meshlet < end; meshlet++) {
+                const MeshletBounds& bounds = meshlets.Bounds[meshlet];
+                if (!settings.FrustumCulling || IsSphereInFrustum(frustum, bounds.Center, bounds.Radius)) {
+                    rangeVisible[frustumCount++] = meshlet;
+                }
+            }
+
+            return frustumCount;
+        };
+
+        const auto cullCone = [&](const u32 meshlet) {
+            return settings.ConeCulling && IsMeshletBackFacing(meshlets.Bounds[meshlet], cameraPosition);
+        };
+
+        const u32 count = meshlets.GetMeshletCount();
+        const CullingRangeCounts counts = m_Ranges.Run(count, RangeSize, settings.Jobs, visible, cullFrustum, cullCone);
+
+        MeshletCullingStats stats;
+        stats.TestedCount = count;
+        stats.FrustumCulledCount = counts.FirstCulledCount;
+        stats.ConeCulledCount = counts.SecondCulledCount;
+        stats.VisibleCount = counts.VisibleCount;
+
+        for (const u32 meshlet : visible) {
+            stats.VisibleTriangleCount += meshlets.Meshlets[meshlet].TriangleCount;
+        }
+
+        return stats;
+    }
+}
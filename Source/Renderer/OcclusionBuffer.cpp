@@ -0,0 +1,166 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Renderer/OcclusionBuffer.hpp>
+
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Flashlight {
+    namespace {
+        constexpr std::array<u32, 36> BoxIndices = {
+            0, 1, 3, 0, 3, 2, // -X
+            4, 6, 7, 4, 7, 5, // +X
+            0, 4, 5, 0, 5, 1, // -Y
+            2, 3, 7, 2, 7, 6, // +Y
+            0, 2, 6, 0, 6, 4, // -Z
+            1, 5, 7, 1, 7, 3  // +Z
+        };
+
+        // Corner i takes the max extent on X if bit 2 is set, on Y for bit 1 and on Z for bit 0.
+        std::array<glm::vec3, 8> GetBoxCorners(const glm::vec3& center, const glm::vec3& extents) {
+            std::array<glm::vec3, 8> corners;
+            for (u32 i = 0; i < 8; i++) {
+                corners[i] = center + glm::vec3(i & 4 ? extents.x : -extents.x, i & 2 ? extents.y : -extents.y,
+                                                i & 1 ? extents.z : -extents.z);
+            }
+
+            return corners;
+        }
+
+        bool IsBehindNearPlane(const glm::vec4& clip) {
+            return clip.w <= 1e-5f || clip.z < 0.0f;
+        }
+    }
+
+    OcclusionBuffer::OcclusionBuffer(const u32 width, const u32 height)
+        : m_Width(width), m_Height(height), m_Depth(static_cast<size_t>(width) * height, 1.0f) {
+    }
+
+    void OcclusionBuffer::Begin(const glm::mat4& viewProjection) {
+        m_ViewProjection = viewProjection;
+        std::fill(m_Depth.begin(), m_Depth.end(), 1.0f);
+    }
+
+    void OcclusionBuffer::RasterizeOccluder(const std::span<const glm::vec3> vertices,
+                                            const std::span<const u32> indices, const glm::mat4& model) {
+        FL_PROFILE_ZONE("OcclusionBuffer::RasterizeOccluder");
+
+        const glm::mat4 modelViewProjection = m_ViewProjection * model;
+
+        std::vector<glm::vec4> clipVertices(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++) {
+            clipVertices[i] = modelViewProjection * glm::vec4(vertices[i], 1.0f);
+        }
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            RasterizeTriangle(clipVertices[indices[i]], clipVertices[indices[i + 1]], clipVertices[indices[i + 2]]);
+        }
+    }
+
+    void OcclusionBuffer::RasterizeOccluderBox(const glm::vec3& center, const glm::vec3& extents) {
+        const std::array<glm::vec3, 8> corners = GetBoxCorners(center, extents);
+        RasterizeOccluder(corners, BoxIndices, glm::mat4(1.0f));
+    }
+
+    bool OcclusionBuffer::IsBoxVisible(const glm::vec3& center, const glm::vec3& extents) const {
+        f32 minX = std::numeric_limits<f32>::max(), minY = minX, minZ = minX;
+        f32 maxX = std::numeric_limits<f32>::lowest(), maxY = maxX;
+
+        for (const glm::vec3& corner : GetBoxCorners(center, extents)) {
+            const glm::vec4 clip = m_ViewProjection * glm::vec4(corner, 1.0f);
+
+            // The box reaches the camera, its screen rectangle can't be bounded.
+            if (IsBehindNearPlane(clip)) {
+                return true;
+            }
+
+            const f32 inverseW = 1.0f / clip.w;
+            minX = std::min(minX, clip.x * inverseW);
+            maxX = std::max(maxX, clip.x * inverseW);
+            minY = std::min(minY, clip.y * inverseW);
+            maxY = std::max(maxY, clip.y * inverseW);
+            minZ = std::min(minZ, clip.z * inverseW);
+        }
+
+        const auto left = static_cast<i32>(std::floor((minX * 0.5f + 0.5f) * static_cast<f32>(m_Width)));
+        const auto right = static_cast<i32>(std::ceil((maxX * 0.5f + 0.5f) * static_cast<f32>(m_Width)));
+        const auto top = static_cast<i32>(std::floor((minY * 0.5f + 0.5f) * static_cast<f32>(m_Height)));
+        const auto bottom = static_cast<i32>(std::ceil((maxY * 0.5f + 0.5f) * static_cast<f32>(m_Height)));
+
+        const i32 x0 = std::max(left, 0), x1 = std::min(right, static_cast<i32>(m_Width));
+        const i32 y0 = std::max(top, 0), y1 = std::min(bottom, static_cast<i32>(m_Height));
+
+        if (x0 >= x1 || y0 >= y1) {
+            return false;
+        }
+
+        for (i32 y = y0; y < y1; y++) {
+            const f32* row = m_Depth.data() + static_cast<size_t>(y) * m_Width;
+            for (i32 x = x0; x < x1; x++) {
+                if (minZ <= row[x]) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void OcclusionBuffer::RasterizeTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+        if (IsBehindNearPlane(a) || IsBehindNearPlane(b) || IsBehindNearPlane(c)) {
+            return;
+        }
+
+        const auto toScreen = [this](const glm::vec4& clip) {
+            const f32 inverseW = 1.0f / clip.w;
+            return glm::vec3((clip.x * inverseW * 0.5f + 0.5f) * static_cast<f32>(m_Width),
+                             (clip.y * inverseW * 0.5f + 0.5f) * static_cast<f32>(m_Height), clip.z * inverseW);
+        };
+
+        glm::vec3 v0 = toScreen(a), v1 = toScreen(b), v2 = toScreen(c);
+
+        f32 area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if (std::abs(area) < 1e-8f) {
+            return;
+        }
+
+        // Both windings are accepted, occluders are treated as double-sided.
+        if (area < 0.0f) {
+            std::swap(v1, v2);
+            area = -area;
+        }
+
+        const i32 x0 = std::max(static_cast<i32>(std::floor(std::min({v0.x, v1.x, v2.x}))), 0);
+        const i32 x1 = std::min(static_cast<i32>(std::ceil(std::max({v0.x, v1.x, v2.x}))), static_cast<i32>(m_Width));
+        const i32 y0 = std::max(static_cast<i32>(std::floor(std::min({v0.y, v1.y, v2.y}))), 0);
+        const i32 y1 = std::min(static_cast<i32>(std::ceil(std::max({v0.y, v1.y, v2.y}))), static_cast<i32>(m_Height));
+
+        const f32 inverseArea = 1.0f / area;
+
+        for (i32 y = y0; y < y1; y++) {
+            const f32 py = static_cast<f32>(y) + 0.5f;
+            f32* row = m_Depth.data() + static_cast<size_t>(y) * m_Width;
+
+            for (i32 x = x0; x < x1; x++) {
+                const f32 px = static_cast<f32>(x) + 0.5f;
+
+                // Edge functions, each one is the weight of the opposite vertex.
+                const f32 w0 = (v2.x - v1.x) * (py - v1.y) - (v2.y - v1.y) * (px - v1.x);
+                const f32 w1 = (v0.x - v2.x) * (py - v2.y) - (v0.y - v2.y) * (px - v2.x);
+                const f32 w2 = (v1.x - v0.x) * (py - v0.y) - (v1.y - v0.y) * (px - v0.x);
+
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                    continue;
+                }
+
+                // Depth after the perspective divide is linear in screen space.
+                const f32 depth = (w0 * v0.z + w1 * v1.z + w2 * v2.z) * inverseArea;
+                row[x] = std::min(row[x], depth);
+            }
+        }
+    }
+}
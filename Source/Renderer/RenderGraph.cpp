@@ -0,0 +1,520 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Renderer/RenderGraph.hpp>
+
+#include <FlashlightEngine/Core/Profiler.hpp>
+
+#include <algorithm>
+
+namespace Flashlight {
+    namespace {
+        // Estimates until the backend sets the real requirements, close to what desktop drivers ask for.
+        constexpr u64 ImageAlignment = 64 * 1024;
+        constexpr u64 BufferAlignment = 256;
+
+        // Vulkan alignments are powers of two.
+        u64 AlignUp(const u64 value, const u64 alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        u64 EstimateImageSize(const RenderImageDesc& desc) {
+            u64 size = 0;
+            for (u32 mip = 0; mip < desc.MipLevels; mip++) {
+                size += static_cast<u64>(std::max(desc.Width >> mip, 1u)) * std::max(desc.Height >> mip, 1u);
+            }
+
+            return AlignUp(size * GetFormatSize(desc.Format) * desc.ArrayLayers, ImageAlignment);
+        }
+    }
+
+    void RenderGraphBackend::BeginPass(std::string_view) {
+    }
+
+    void RenderGraphBackend::EndPass() {
+    }
+
+    RenderResourceId RenderGraph::CreateImage(const std::string_view name, const RenderImageDesc& desc) {
+        return AddResource(name, RenderResourceType::Image, desc, {}, false, RenderUsage::None, RenderUsage::None);
+    }
+
+    RenderResourceId RenderGraph::CreateBuffer(const std::string_view name, const RenderBufferDesc& desc) {
+        return AddResource(name, RenderResourceType::Buffer, {}, desc, false, RenderUsage::None, RenderUsage::None);
+    }
+
+    RenderResourceId RenderGraph::ImportImage(const std::string_view name, const RenderImageDesc& desc,
+                                              const RenderUsage initialUsage, const RenderUsage finalUsage) {
+        return AddResource(name, RenderResourceType::Image, desc, {}, true, initialUsage, finalUsage);
+    }
+
+    RenderResourceId RenderGraph::ImportBuffer(const std::string_view name, const RenderBufferDesc& desc,
+                                               const RenderUsage initialUsage, const RenderUsage finalUsage) {
+        return AddResource(name, RenderResourceType::Buffer, {}, desc, true, initialUsage, finalUsage);
+    }
+
+    void RenderGraph::Compile() {
+        FL_PROFILE_ZONE("RenderGraph::Compile");
+
+        BuildDependencies();
+        CullPasses();
+        SortPasses();
+        ComputeLifetimes();
+
+        m_Offsets.assign(m_Resources.size(), 0);
+        m_AliasUsages.assign(m_Resources.size(), 0);
+        m_Stats.ImageHeapSize = AllocateHeap(RenderResourceType::Image);
+        m_Stats.BufferHeapSize = AllocateHeap(RenderResourceType::Buffer);
+
+        ComputeBarriers();
+
+        m_Stats.PassCount = static_cast<u32>(m_Order.size());
+        m_Stats.CulledPassCount = static_cast<u32>(m_Passes.size() - m_Order.size());
+        m_Stats.BatchCount = static_cast<u32>(m_Batches.size());
+        m_Stats.BarrierCount = static_cast<u32>(m_Barriers.size());
+        m_Compiled = true;
+    }
+
+    void RenderGraph::Execute(RenderGraphBackend& backend) const {
+        FL_PROFILE_ZONE("RenderGraph::Execute");
+
+        assert(m_Compiled && "The graph isn't compiled.");
+
+        for (const RenderGraphBatch& batch : m_Batches) {
+            if (batch.BarrierCount != 0) {
+                backend.RecordBarriers(std::span(m_Barriers).subspan(batch.FirstBarrier, batch.BarrierCount));
+            }
+
+            for (u32 i = batch.FirstPass; i < batch.FirstPass + batch.PassCount; i++) {
+                const PassCallbacks& pass = m_PassCallbacks[m_Order[i]];
+
+                backend.BeginPass(pass.Name);
+                if (pass.Execute) {
+                    pass.Execute(backend);
+                }
+                backend.EndPass();
+            }
+        }
+    }
+
+    void RenderGraph::Reset() {
+        m_Resources.clear();
+        m_ResourceDescs.clear();
+        m_Passes.clear();
+        m_PassCallbacks.clear();
+        m_Accesses.clear();
+        m_Order.clear();
+        m_Batches.clear();
+        m_Barriers.clear();
+        m_Stats = {};
+        m_Compiled = false;
+    }
+
+    RenderResourceId RenderGraph::AddResource(const std::string_view name, const RenderResourceType type,
+                                              const RenderImageDesc& image, const RenderBufferDesc& buffer,
+                                              const bool imported, const RenderUsage initialUsage,
+                                              const RenderUsage finalUsage) {
+        const bool isImage = type == RenderResourceType::Image;
+
+        m_Resources.push_back({isImage ? EstimateImageSize(image) : AlignUp(buffer.Size, BufferAlignment),
+                               isImage ? ImageAlignment : BufferAlignment, type, imported, initialUsage, finalUsage});
+        m_ResourceDescs.push_back({std::string(name), image, buffer});
+        m_Compiled = false;
+
+        return static_cast<RenderResourceId>(m_Resources.size() - 1);
+    }
+
+    void RenderGraph::AddAccess(const RenderPassId pass, const RenderResourceId resource, const RenderUsage usage) {
+        assert(pass + 1 == m_Passes.size() && "Accesses can only be declared from the setup function of a pass.");
+        assert(resource < m_Resources.size() && "Unknown resource.");
+        assert((m_Resources[resource].Type == RenderResourceType::Buffer ||
+                GetUsageLayout(usage) != RenderImageLayout::Undefined) && "Buffer usage declared on an image.");
+
+        m_Accesses.push_back({resource, usage});
+        m_Passes[pass].AccessCount++;
+    }
+
+    void RenderGraph::BuildDependencies() {
+        // Passes only depend on passes declared before them, so the predecessors of every pass are known once it
+        // is reached and are appended in order.
+        m_PredecessorOffsets.assign(m_Passes.size() + 1, 0);
+        m_Predecessors.clear();
+        m_LastWriters.assign(m_Resources.size(), InvalidIndex);
+        m_ReaderHeads.assign(m_Resources.size(), InvalidIndex);
+        m_ReaderNodes.clear();
+
+        for (RenderPassId pass = 0; pass < m_Passes.size(); pass++) {
+            const PassData& data = m_Passes[pass];
+
+            for (u32 i = data.FirstAccess; i < data.FirstAccess + data.AccessCount; i++) {
+                const auto [resource, usage] = m_Accesses[i];
+                const RenderPassId lastWriter = m_LastWriters[resource];
+
+                if (lastWriter != InvalidIndex && lastWriter != pass) {
+                    m_Predecessors.push_back(lastWriter);
+                }
+
+                if (!IsWriteUsage(usage)) {
+                    m_ReaderNodes.push_back({pass, m_ReaderHeads[resource]});
+                    m_ReaderHeads[resource] = static_cast<u32>(m_ReaderNodes.size() - 1);
+                    continue;
+                }
+
+                // The readers of the previous contents must be done before they are overwritten, but they don't
+                // feed this pass: culling ignores these edges.
+                for (u32 node = m_ReaderHeads[resource]; node != InvalidIndex; node = m_ReaderNodes[node].Next) {
+                    if (m_ReaderNodes[node].Pass != pass) {
+                        m_Predecessors.push_back(m_ReaderNodes[node].Pass | AntiDependencyBit);
+                    }
+                }
+
+                m_LastWriters[resource] = pass;
+                m_ReaderHeads[resource] = InvalidIndex;
+            }
+
+            m_PredecessorOffsets[pass + 1] = static_cast<u32>(m_Predecessors.size());
+        }
+    }
+
+    void RenderGraph::CullPasses() {
+        // Levels double as the liveness mark here: zero for the passes that are needed.
+        m_PassLevels.assign(m_Passes.size(), InvalidIndex);
+
+        for (RenderPassId pass = 0; pass < m_Passes.size(); pass++) {
+            const PassData& data = m_Passes[pass];
+
+            bool needed = data.SideEffects;
+            for (u32 i = data.FirstAccess; i < data.FirstAccess + data.AccessCount && !needed; i++) {
+                needed = m_Resources[m_Accesses[i].Resource].Imported && IsWriteUsage(m_Accesses[i].Usage);
+            }
+
+            if (needed) {
+                m_PassLevels[pass] = 0;
+            }
+        }
+
+        // Predecessors always come first, so one backward sweep reaches every pass a needed pass depends on.
+        for (RenderPassId pass = static_cast<RenderPassId>(m_Passes.size()); pass-- > 0;) {
+            if (m_PassLevels[pass] == InvalidIndex) {
+                continue;
+            }
+
+            for (u32 i = m_PredecessorOffsets[pass]; i < m_PredecessorOffsets[pass + 1]; i++) {
+                if ((m_Predecessors[i] & AntiDependencyBit) == 0) {
+                    m_PassLevels[m_Predecessors[i]] = 0;
+                }
+            }
+        }
+    }
+
+    void RenderGraph::SortPasses() {
+        // The declaration order is already a topological order, passes are regrouped by their longest distance from
+        // a pass without predecessors so every level only depends on the ones before it.
+        u32 levelCount = 0;
+        for (RenderPassId pass = 0; pass < m_Passes.size(); pass++) {
+            if (m_PassLevels[pass] == InvalidIndex) {
+                continue;
+            }
+
+            u32 level = 0;
+            for (u32 i = m_PredecessorOffsets[pass]; i < m_PredecessorOffsets[pass + 1]; i++) {
+                const u32 predecessorLevel = m_PassLevels[m_Predecessors[i] & ~AntiDependencyBit];
+                if (predecessorLevel != InvalidIndex) {
+                    level = std::max(level, predecessorLevel + 1);
+                }
+            }
+
+            m_PassLevels[pass] = level;
+            levelCount = std::max(levelCount, level + 1);
+        }
+
+        // Counting sort, stable so passes of a level keep their declaration order.
+        m_LevelCounts.assign(levelCount + 1, 0);
+        for (const u32 level : m_PassLevels) {
+            if (level != InvalidIndex) {
+                m_LevelCounts[level + 1]++;
+            }
+        }
+
+        m_Batches.clear();
+        for (u32 level = 0; level < levelCount; level++) {
+            m_Batches.push_back({m_LevelCounts[level], m_LevelCounts[level + 1], 0, 0});
+            m_LevelCounts[level + 1] += m_LevelCounts[level];
+        }
+
+        m_Order.resize(m_LevelCounts[levelCount]);
+        for (RenderPassId pass = 0; pass < m_Passes.size(); pass++) {
+            if (m_PassLevels[pass] != InvalidIndex) {
+                m_Order[m_LevelCounts[m_PassLevels[pass]]++] = pass;
+            }
+        }
+    }
+
+    void RenderGraph::ComputeLifetimes() {
+        m_FirstLevels.assign(m_Resources.size(), InvalidIndex);
+        m_LastLevels.assign(m_Resources.size(), 0);
+        m_ResourceUsages.assign(m_Resources.size(), 0);
+
+        for (const RenderPassId pass : m_Order) {
+            const PassData& data = m_Passes[pass];
+            const u32 level = m_PassLevels[pass];
+
+            for (u32 i = data.FirstAccess; i < data.FirstAccess + data.AccessCount; i++) {
+                const auto [resource, usage] = m_Accesses[i];
+
+                m_FirstLevels[resource] = std::min(m_FirstLevels[resource], level);
+                m_LastLevels[resource] = std::max(m_LastLevels[resource], level);
+                m_ResourceUsages[resource] |= static_cast<RenderUsageFlags>(usage);
+            }
+        }
+
+        m_Stats.TransientResourceCount = 0;
+        m_Stats.TransientMemory = 0;
+        for (RenderResourceId resource = 0; resource < m_Resources.size(); resource++) {
+            if (!m_Resources[resource].Imported && m_FirstLevels[resource] != InvalidIndex) {
+                m_Stats.TransientResourceCount++;
+                m_Stats.TransientMemory += m_Resources[resource].Size;
+            }
+        }
+    }
+
+    u64 RenderGraph::AllocateHeap(const RenderResourceType type) {
+        // Linear scan over the levels: resources are placed in order of first use, in the best fitting block freed by
+        // the resources whose last use came before.
+        const auto sortByLevel = [this, type](const std::vector<u32>& levels, std::vector<RenderResourceId>& order) {
+            const auto isAllocated = [this, type](const RenderResourceId resource) {
+                return m_Resources[resource].Type == type && !m_Resources[resource].Imported &&
+                       m_FirstLevels[resource] != InvalidIndex;
+            };
+
+            // Counting sort, levels are dense. Leaves the end of every level in m_LevelCounts.
+            m_LevelCounts.assign(m_Batches.size() + 1, 0);
+            for (RenderResourceId resource = 0; resource < m_Resources.size(); resource++) {
+                if (isAllocated(resource)) {
+                    m_LevelCounts[levels[resource] + 1]++;
+                }
+            }
+
+            for (u32 level = 0; level < m_Batches.size(); level++) {
+                m_LevelCounts[level + 1] += m_LevelCounts[level];
+            }
+
+            order.resize(m_LevelCounts.back());
+            for (RenderResourceId resource = 0; resource < m_Resources.size(); resource++) {
+                if (isAllocated(resource)) {
+                    order[m_LevelCounts[levels[resource]]++] = resource;
+                }
+            }
+        };
+
+        sortByLevel(m_LastLevels, m_ReleaseOrder);
+        sortByLevel(m_FirstLevels, m_AllocationOrder);
+
+        // The largest resources of a level are placed first, they are the hardest to fit.
+        for (u32 level = 0; level < m_Batches.size(); level++) {
+            const auto begin = m_AllocationOrder.begin() + (level == 0 ? 0 : m_LevelCounts[level - 1]);
+            const auto end = m_AllocationOrder.begin() + m_LevelCounts[level];
+            if (end - begin < 2) {
+                continue;
+            }
+
+            std::sort(begin, end, [this](const RenderResourceId a, const RenderResourceId b) {
+                return m_Resources[a].Size > m_Resources[b].Size ||
+                       (m_Resources[a].Size == m_Resources[b].Size && a < b);
+            });
+        }
+
+        m_FreeBlocks.clear();
+        u64 heapSize = 0;
+        u32 released = 0;
+
+        for (const RenderResourceId resource : m_AllocationOrder) {
+            const u64 size = m_Resources[resource].Size;
+            const u64 alignment = m_Resources[resource].Alignment;
+
+            for (; released < m_ReleaseOrder.size() &&
+                   m_LastLevels[m_ReleaseOrder[released]] < m_FirstLevels[resource]; released++) {
+                const RenderResourceId freed = m_ReleaseOrder[released];
+                FreeBlock block{m_Offsets[freed], m_Resources[freed].Size, m_ResourceUsages[freed]};
+
+                // Keep the blocks sorted by offset and merge the neighbours touching the freed range.
+                auto next = std::ranges::lower_bound(m_FreeBlocks, block.Offset, {}, &FreeBlock::Offset);
+                if (next != m_FreeBlocks.end() && block.Offset + block.Size == next->Offset) {
+                    block.Size += next->Size;
+                    block.Usages |= next->Usages;
+                    next = m_FreeBlocks.erase(next);
+                }
+
+                if (next != m_FreeBlocks.begin()) {
+                    FreeBlock& previous = *(next - 1);
+                    if (previous.Offset + previous.Size == block.Offset) {
+                        previous.Size += block.Size;
+                        previous.Usages |= block.Usages;
+                        continue;
+                    }
+                }
+
+                m_FreeBlocks.insert(next, block);
+            }
+
+            u32 best = InvalidIndex;
+            u64 bestWaste = std::numeric_limits<u64>::max();
+            for (u32 i = 0; i < m_FreeBlocks.size(); i++) {
+                const FreeBlock& block = m_FreeBlocks[i];
+                const u64 offset = AlignUp(block.Offset, alignment);
+                if (offset + size <= block.Offset + block.Size && block.Size - size < bestWaste) {
+                    best = i;
+                    bestWaste = block.Size - size;
+                }
+            }
+
+            // Nothing fits, grow the heap, starting in the last block if it ends the heap.
+            if (best == InvalidIndex) {
+                if (!m_FreeBlocks.empty() && m_FreeBlocks.back().Offset + m_FreeBlocks.back().Size == heapSize) {
+                    best = static_cast<u32>(m_FreeBlocks.size() - 1);
+                    heapSize = AlignUp(m_FreeBlocks.back().Offset, alignment) + size;
+                    m_FreeBlocks.back().Size = heapSize - m_FreeBlocks.back().Offset;
+                } else {
+                    m_Offsets[resource] = AlignUp(heapSize, alignment);
+                    heapSize = m_Offsets[resource] + size;
+                    continue;
+                }
+            }
+
+            // Split the block, the padding before the resource and what is left after it stay free.
+            FreeBlock& block = m_FreeBlocks[best];
+            const u64 offset = AlignUp(block.Offset, alignment);
+            const u64 end = block.Offset + block.Size;
+            m_Offsets[resource] = offset;
+            m_AliasUsages[resource] = block.Usages;
+
+            if (offset > block.Offset) {
+                const FreeBlock padding{block.Offset, offset - block.Offset, block.Usages};
+                block.Offset = offset;
+                block.Size = end - offset;
+                m_FreeBlocks.insert(m_FreeBlocks.begin() + best++, padding);
+            }
+
+            if (offset + size < end) {
+                m_FreeBlocks[best].Offset = offset + size;
+                m_FreeBlocks[best].Size = end - offset - size;
+            } else {
+                m_FreeBlocks.erase(m_FreeBlocks.begin() + best);
+            }
+        }
+
+        return heapSize;
+    }
+
+    void RenderGraph::ComputeBarriers() {
+        m_Barriers.clear();
+        m_States.resize(m_Resources.size());
+        m_LevelStamps.assign(m_Resources.size(), InvalidIndex);
+        m_LevelUsages.resize(m_Resources.size());
+        m_LevelLayouts.resize(m_Resources.size());
+
+        for (RenderResourceId resource = 0; resource < m_Resources.size(); resource++) {
+            const ResourceData& data = m_Resources[resource];
+
+            // A transient resource starts undefined, after whatever used its memory before it.
+            const RenderUsage initialUsage = data.Imported ? data.InitialUsage : RenderUsage::None;
+            m_States[resource] = {data.Type == RenderResourceType::Image ? GetUsageLayout(initialUsage)
+                                                                          : RenderImageLayout::Undefined,
+                                  static_cast<RenderUsageFlags>(initialUsage) | m_AliasUsages[resource], 0, 0};
+        }
+
+        for (u32 level = 0; level < m_Batches.size(); level++) {
+            RenderGraphBatch& batch = m_Batches[level];
+            batch.FirstBarrier = static_cast<u32>(m_Barriers.size());
+
+            // Gather what the level does with each resource, passes of a level can't conflict: a written resource is
+            // only touched by its writer. Readers disagreeing on the layout share the general one.
+            m_LevelResources.clear();
+            for (u32 i = batch.FirstPass; i < batch.FirstPass + batch.PassCount; i++) {
+                const PassData& pass = m_Passes[m_Order[i]];
+
+                for (u32 j = pass.FirstAccess; j < pass.FirstAccess + pass.AccessCount; j++) {
+                    const auto [resource, usage] = m_Accesses[j];
+                    const RenderImageLayout layout = m_Resources[resource].Type == RenderResourceType::Image
+                                                         ? GetUsageLayout(usage)
+                                                         : RenderImageLayout::Undefined;
+
+                    if (m_LevelStamps[resource] != level) {
+                        m_LevelStamps[resource] = level;
+                        m_LevelUsages[resource] = 0;
+                        m_LevelLayouts[resource] = layout;
+                        m_LevelResources.push_back(resource);
+                    } else if (m_LevelLayouts[resource] != layout) {
+                        m_LevelLayouts[resource] = RenderImageLayout::General;
+                    }
+
+                    m_LevelUsages[resource] |= static_cast<RenderUsageFlags>(usage);
+                }
+            }
+
+            for (const RenderResourceId resource : m_LevelResources) {
+                ResourceState& state = m_States[resource];
+                const RenderUsageFlags usages = m_LevelUsages[resource];
+                const RenderImageLayout layout = m_LevelLayouts[resource];
+                const bool layoutChanges = state.Layout != layout;
+
+                if ((usages & RenderWriteUsages) != 0) {
+                    // Write after anything: wait for every access since the previous write, and for that write.
+                    const RenderUsageFlags srcUsages = state.WriteUsages | state.ReadUsages;
+                    if (srcUsages != 0 || layoutChanges) {
+                        AddBarrier(resource, srcUsages, usages, state.Layout, layout);
+                    }
+
+                    state.WriteUsages = usages & RenderWriteUsages;
+                    state.ReadUsages = usages & ~RenderWriteUsages;
+                    state.VisibleUsages = usages;
+                } else if (layoutChanges) {
+                    AddBarrier(resource, state.WriteUsages | state.ReadUsages, usages, state.Layout, layout);
+
+                    state.ReadUsages |= usages;
+                    state.VisibleUsages |= usages;
+                } else if (state.WriteUsages != 0 && (usages & ~state.VisibleUsages) != 0) {
+                    // Read after write: only the reads the write wasn't made visible to yet need a barrier.
+                    AddBarrier(resource, state.WriteUsages, usages & ~state.VisibleUsages, layout, layout);
+
+                    state.ReadUsages |= usages;
+                    state.VisibleUsages |= usages;
+                } else {
+                    state.ReadUsages |= usages;
+                }
+
+                state.Layout = layout;
+            }
+
+            batch.BarrierCount = static_cast<u32>(m_Barriers.size()) - batch.FirstBarrier;
+        }
+
+        // Hand the imported resources back in the state they are expected in, in a last batch without passes.
+        const u32 firstFinalBarrier = static_cast<u32>(m_Barriers.size());
+        for (RenderResourceId resource = 0; resource < m_Resources.size(); resource++) {
+            const ResourceData& data = m_Resources[resource];
+            if (!data.Imported || data.FinalUsage == RenderUsage::None) {
+                continue;
+            }
+
+            const ResourceState& state = m_States[resource];
+            const RenderImageLayout layout = data.Type == RenderResourceType::Image ? GetUsageLayout(data.FinalUsage)
+                                                                                    : RenderImageLayout::Undefined;
+            const RenderUsageFlags srcUsages = state.WriteUsages | state.ReadUsages;
+            if (srcUsages != 0 || state.Layout != layout) {
+                AddBarrier(resource, srcUsages, static_cast<RenderUsageFlags>(data.FinalUsage), state.Layout, layout);
+            }
+        }
+
+        if (m_Barriers.size() != firstFinalBarrier) {
+            m_Batches.push_back({static_cast<u32>(m_Order.size()), 0, firstFinalBarrier,
+                                 static_cast<u32>(m_Barriers.size()) - firstFinalBarrier});
+        }
+    }
+
+    void RenderGraph::AddBarrier(const RenderResourceId resource, const RenderUsageFlags srcUsages,
+                                 const RenderUsageFlags dstUsages, const RenderImageLayout oldLayout,
+                                 const RenderImageLayout newLayout) {
+        m_Barriers.push_back({resource, srcUsages, dstUsages, oldLayout, newLayout});
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Scene/Archetype.hpp>
+
+#include <bit>
+#include <new>
+
+namespace Flashlight {
+    namespace {
+        constexpr u32 AlignUp(const u32 value, const u32 alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    Archetype::Archetype(const ComponentMask mask) : m_Mask(mask) {
+        m_ColumnIndices.fill(InvalidColumn);
+
+        for (ComponentMask remaining = mask; remaining != 0; remaining &= remaining - 1) {
+            const auto id = static_cast<ComponentId>(std::countr_zero(remaining));
+
+            m_ColumnIndices[id] = static_cast<u8>(m_ComponentIds.size());
+            m_ComponentIds.push_back(id);
+            m_ComponentInfos.push_back(&ComponentRegistry::GetInfo(id));
+
+            assert(m_ComponentInfos.back()->Alignment <= CacheLineSize && "Component alignment is too large.");
+        }
+
+        m_ColumnOffsets.resize(m_ComponentIds.size());
+
+        u32 entityBytes = sizeof(Entity);
+        for (const ComponentInfo* info : m_ComponentInfos) {
+            entityBytes += info->Size;
+        }
+
+        // Start from the capacity ignoring padding and shrink until the columns fit. A chunk always holds at least one
+        // entity, even when that makes it larger than ChunkSize.
+        m_ChunkCapacity = std::max(ChunkSize / entityBytes, 1u);
+        while (m_ChunkCapacity > 1 && ComputeChunkBytes(m_ChunkCapacity) > ChunkSize) {
+            m_ChunkCapacity--;
+        }
+
+        m_ChunkBytes = ComputeChunkBytes(m_ChunkCapacity);
+    }
+
+    Archetype::~Archetype() {
+        for (u32 chunk = 0; chunk < m_Chunks.size(); chunk++) {
+            for (u32 row = 0; row < m_Chunks[chunk].Count; row++) {
+                DestroyComponents({chunk, row});
+            }
+
+            ::operator delete(m_Chunks[chunk].Data, std::align_val_t{CacheLineSize});
+        }
+    }
+
+    ArchetypeRow Archetype::Push(const Entity entity) {
+        if (m_Chunks.empty() || m_Chunks.back().Count == m_ChunkCapacity) {
+            auto* data = static_cast<std::byte*>(::operator new(m_ChunkBytes, std::align_val_t{CacheLineSize}));
+            m_Chunks.push_back({data, 0});
+        }
+
+        const ArchetypeRow row{static_cast<u32>(m_Chunks.size() - 1), m_Chunks.back().Count++};
+        GetEntities(row.Chunk)[row.Row] = entity;
+        m_EntityCount++;
+
+        return row;
+    }
+
+    void Archetype::DestroyComponents(const ArchetypeRow row) {
+        for (u8 column = 0; column < m_ComponentInfos.size(); column++) {
+            DestroyComponent(*m_ComponentInfos[column], GetComponent(row, column));
+        }
+    }
+
+    Entity Archetype::Remove(const ArchetypeRow row) {
+        const ArchetypeRow last{static_cast<u32>(m_Chunks.size() - 1), m_Chunks.back().Count - 1};
+
+        Entity moved;
+        if (row.Chunk != last.Chunk || row.Row != last.Row) {
+            for (u8 column = 0; column < m_ComponentInfos.size(); column++) {
+                RelocateComponent(*m_ComponentInfos[column], GetComponent(row, column), GetComponent(last, column));
+            }
+
+            moved = GetEntities(last.Chunk)[last.Row];
+            GetEntities(row.Chunk)[row.Row] = moved;
+        }
+
+        m_EntityCount--;
+        if (--m_Chunks.back().Count == 0) {
+            ::operator delete(m_Chunks.back().Data, std::align_val_t{CacheLineSize});
+            m_Chunks.pop_back();
+        }
+
+        return moved;
+    }
+
+    u32 Archetype::ComputeChunkBytes(const u32 capacity) {
+        // Every column starts on its own cache line so a chunk never shares a line between two arrays.
+        u32 bytes = AlignUp(capacity * static_cast<u32>(sizeof(Entity)), CacheLineSize);
+
+        for (u8 column = 0; column < m_ComponentInfos.size(); column++) {
+            m_ColumnOffsets[column] = bytes;
+            bytes = AlignUp(bytes + capacity * m_ComponentInfos[column]->Size, CacheLineSize);
+        }
+
+        return bytes;
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Scene/Component.hpp>
+
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <atomic>
+#include <mutex>
+
+namespace Flashlight {
+    namespace {
+        struct ComponentRegistryState {
+            std::mutex Mutex; // Only taken by Register.
+            std::array<ComponentInfo, MaxComponentTypes> Infos;
+            // Infos below the count are never written again, it is published after they are.
+            std::atomic<u32> Count{0};
+        };
+
+        ComponentRegistryState& GetState() {
+            static ComponentRegistryState state;
+            return state;
+        }
+    }
+
+    ComponentId ComponentRegistry::Register(const ComponentInfo& info) {
+        assert(info.Type != nullptr && "Component type missing.");
+
+        ComponentRegistryState& state = GetState();
+        std::lock_guard lock(state.Mutex);
+
+        const u32 count = state.Count.load(std::memory_order_relaxed);
+        for (u32 id = 0; id < count; id++) {
+            const ComponentInfo& registered = state.Infos[id];
+            if (std::type_index(*registered.Type) == std::type_index(*info.Type)) {
+                assert(registered.Size == info.Size && registered.Alignment == info.Alignment &&
+                       "Component type registered again with a different layout.");
+                return id;
+            }
+        }
+
+        if (count == MaxComponentTypes) {
+            Log::EngineFatal({0x04, 0x00},
+                             fmt::format("Too many component types, {0} can't be registered.", info.Name));
+        }
+
+        state.Infos[count] = info;
+        state.Count.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    const ComponentInfo& ComponentRegistry::GetInfo(const ComponentId id) {
+        const ComponentRegistryState& state = GetState();
+
+        assert(id < state.Count.load(std::memory_order_acquire) && "Unknown component id.");
+        return state.Infos[id];
+    }
+
+    u32 ComponentRegistry::GetComponentTypeCount() {
+        return GetState().Count.load(std::memory_order_acquire);
+    }
+}
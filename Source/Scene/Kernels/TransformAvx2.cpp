@@ -0,0 +1,56 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Built with AVX2 and FMA enabled, see TransformKernels.hpp for what this file may include.
+#include <FlashlightEngine/Scene/TransformKernels.hpp>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+    #include <immintrin.h>
+
+namespace Flashlight {
+    namespace {
+#include "TransformKernels.inl"
+
+        // Two world columns per register, both lanes hold the same parent column.
+        void ComputeWorldMatrix(const f32* parent, const f32* position, const f32* rotation, const f32* scale,
+                                f32* result) {
+            f32 m[9];
+            ComputeLocalColumns(rotation, scale, m);
+
+            const __m256 p0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(parent));
+            const __m256 p1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(parent + 4));
+            const __m256 p2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(parent + 8));
+            const __m256 p3 = _mm256_insertf128_ps(_mm256_setzero_ps(), _mm_loadu_ps(parent + 12), 1);
+
+            const auto pair = [](const f32 low, const f32 high) {
+                return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(low)), _mm_set1_ps(high), 1);
+            };
+
+            const __m256 c0 = pair(m[0], m[3]);
+            const __m256 c1 = pair(m[1], m[4]);
+            const __m256 c2 = pair(m[2], m[5]);
+            const __m256 t0 = pair(m[6], position[0]);
+            const __m256 t1 = pair(m[7], position[1]);
+            const __m256 t2 = pair(m[8], position[2]);
+
+            const __m256 columns01 = _mm256_fmadd_ps(p2, c2, _mm256_fmadd_ps(p1, c1, _mm256_mul_ps(p0, c0)));
+            const __m256 columns23 = _mm256_fmadd_ps(p2, t2, _mm256_fmadd_ps(p1, t1, _mm256_fmadd_ps(p0, t0, p3)));
+
+            _mm256_storeu_ps(result, columns01);
+            _mm256_storeu_ps(result + 8, columns23);
+        }
+    }
+
+    const TransformKernels* GetAvx2TransformKernels() {
+        static constexpr TransformKernels kernels = MakeTransformKernels<&ComputeWorldMatrix>();
+        return &kernels;
+    }
+}
+#else
+namespace Flashlight {
+    const TransformKernels* GetAvx2TransformKernels() {
+        return nullptr;
+    }
+}
+#endif
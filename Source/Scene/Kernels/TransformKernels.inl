@@ -0,0 +1,56 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Included in an anonymous namespace after a ComputeWorldMatrix(parent, position, rotation, scale, result) function
+// working on raw floats. It computes parent * translate(position) * mat4_cast(rotation) * scale(scale) without
+// building the local matrix: its last row is (0, 0, 0, 1), so each world column is a sum of three parent columns
+// (plus the parent's translation for the last one) weighted by the rotation-scale coefficients, LocalColumns.
+
+constexpr f32 IdentityMatrix[16] = {
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f
+};
+
+// The first three columns of the local matrix, column c, row r is m[c * 3 + r].
+inline void ComputeLocalColumns(const f32* rotation, const f32* scale, f32* m) {
+    const f32 x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+    const f32 xx = x * x, yy = y * y, zz = z * z;
+    const f32 xy = x * y, xz = x * z, yz = y * z;
+    const f32 wx = w * x, wy = w * y, wz = w * z;
+
+    m[0] = (1.0f - 2.0f * (yy + zz)) * scale[0];
+    m[1] = 2.0f * (xy + wz) * scale[0];
+    m[2] = 2.0f * (xz - wy) * scale[0];
+    m[3] = 2.0f * (xy - wz) * scale[1];
+    m[4] = (1.0f - 2.0f * (xx + zz)) * scale[1];
+    m[5] = 2.0f * (yz + wx) * scale[1];
+    m[6] = 2.0f * (xz + wy) * scale[2];
+    m[7] = 2.0f * (yz - wx) * scale[2];
+    m[8] = (1.0f - 2.0f * (xx + yy)) * scale[2];
+}
+
+template <void (*ComputeWorldMatrix)(const f32*, const f32*, const f32*, const f32*, f32*)>
+void UpdateWorldMatrices(const TransformArrays& nodes, const u32 begin, const u32 end) {
+    for (u32 index = begin; index < end; index++) {
+        // Parents are processed first, so their flag already says whether anything above them changed.
+        const u32 parentIndex = nodes.ParentIndices[index];
+        if (!nodes.Dirty[index] && (parentIndex == TransformRootParent || !nodes.Dirty[parentIndex])) {
+            continue;
+        }
+
+        nodes.Dirty[index] = 1;
+
+        const f32* parent = parentIndex == TransformRootParent ? IdentityMatrix
+                                                                : nodes.WorldMatrices + parentIndex * 16ull;
+        ComputeWorldMatrix(parent, nodes.Positions + index * 3ull, nodes.Rotations + index * 4ull,
+                           nodes.Scales + index * 3ull, nodes.WorldMatrices + index * 16ull);
+    }
+}
+
+template <void (*ComputeWorldMatrix)(const f32*, const f32*, const f32*, const f32*, f32*)>
+constexpr TransformKernels MakeTransformKernels() {
+    return {&UpdateWorldMatrices<ComputeWorldMatrix>};
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Built with SSE4.2 enabled, see TransformKernels.hpp for what this file may include.
+#include <FlashlightEngine/Scene/TransformKernels.hpp>
+
+#if defined(__SSE4_2__) || defined(_M_X64)
+    #include <nmmintrin.h>
+
+namespace Flashlight {
+    namespace {
+#include "TransformKernels.inl"
+
+        // One world column per register.
+        void ComputeWorldMatrix(const f32* parent, const f32* position, const f32* rotation, const f32* scale,
+                                f32* result) {
+            f32 m[9];
+            ComputeLocalColumns(rotation, scale, m);
+
+            const __m128 p0 = _mm_loadu_ps(parent);
+            const __m128 p1 = _mm_loadu_ps(parent + 4);
+            const __m128 p2 = _mm_loadu_ps(parent + 8);
+            const __m128 p3 = _mm_loadu_ps(parent + 12);
+
+            const auto column = [&p0, &p1, &p2](const f32 a, const f32 b, const f32 c) {
+                return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, _mm_set1_ps(a)), _mm_mul_ps(p1, _mm_set1_ps(b))),
+                                  _mm_mul_ps(p2, _mm_set1_ps(c)));
+            };
+
+            _mm_storeu_ps(result, column(m[0], m[1], m[2]));
+            _mm_storeu_ps(result + 4, column(m[3], m[4], m[5]));
+            _mm_storeu_ps(result + 8, column(m[6], m[7], m[8]));
+            _mm_storeu_ps(result + 12, _mm_add_ps(column(position[0], position[1], position[2]), p3));
+        }
+    }
+
+    const TransformKernels* GetSse42TransformKernels() {
+        static constexpr TransformKernels kernels = MakeTransformKernels<&ComputeWorldMatrix>();
+        return &kernels;
+    }
+}
+#else
+namespace Flashlight {
+    const TransformKernels* GetSse42TransformKernels() {
+        return nullptr;
+    }
+}
+#endif
@@ -0,0 +1,131 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Scene/Scene.hpp>
+
+namespace Flashlight {
+    Scene::Scene() {
+        // Entities without components.
+        GetOrCreateArchetype(0);
+    }
+
+    Entity Scene::CreateEntity() {
+        return AllocateEntity(*m_Archetypes.front());
+    }
+
+    void Scene::DestroyEntity(const Entity entity) {
+        if (!IsAlive(entity)) {
+            return;
+        }
+
+        EntityRecord& record = m_Records[entity.Index];
+        record.Owner->DestroyComponents(record.Row);
+
+        const Entity moved = record.Owner->Remove(record.Row);
+        if (moved.IsValid()) {
+            m_Records[moved.Index].Row = record.Row;
+        }
+
+        record.Owner = nullptr;
+        record.Generation++;
+        m_FreeIndices.push_back(entity.Index);
+        m_EntityCount--;
+    }
+
+    void Scene::Clear() {
+        for (u32 index = 0; index < m_Records.size(); index++) {
+            DestroyEntity({index, m_Records[index].Generation});
+        }
+    }
+
+    Entity Scene::AllocateEntity(Archetype& archetype) {
+        Entity entity;
+
+        if (!m_FreeIndices.empty()) {
+            entity.Index = m_FreeIndices.back();
+            m_FreeIndices.pop_back();
+        } else {
+            entity.Index = static_cast<u32>(m_Records.size());
+            m_Records.emplace_back();
+        }
+
+        EntityRecord& record = m_Records[entity.Index];
+        entity.Generation = record.Generation;
+
+        record.Owner = &archetype;
+        record.Row = archetype.Push(entity);
+        m_EntityCount++;
+
+        return entity;
+    }
+
+    Archetype& Scene::GetOrCreateArchetype(const ComponentMask mask) {
+        if (const auto it = m_ArchetypesByMask.find(mask); it != m_ArchetypesByMask.end()) {
+            return *it->second;
+        }
+
+        Archetype& archetype = *m_Archetypes.emplace_back(std::make_unique<Archetype>(mask));
+        m_ArchetypesByMask.emplace(mask, &archetype);
+
+        return archetype;
+    }
+
+    Archetype& Scene::GetAddTarget(Archetype& source, const ComponentId id) {
+        if (source.m_AddEdges[id] == nullptr) {
+            Archetype& target = GetOrCreateArchetype(source.GetMask() | ComponentMask{1} << id);
+            source.m_AddEdges[id] = &target;
+            target.m_RemoveEdges[id] = &source;
+        }
+
+        return *source.m_AddEdges[id];
+    }
+
+    Archetype& Scene::GetRemoveTarget(Archetype& source, const ComponentId id) {
+        if (source.m_RemoveEdges[id] == nullptr) {
+            Archetype& target = GetOrCreateArchetype(source.GetMask() & ~(ComponentMask{1} << id));
+            source.m_RemoveEdges[id] = &target;
+            target.m_AddEdges[id] = &source;
+        }
+
+        return *source.m_RemoveEdges[id];
+    }
+
+    void Scene::MoveEntity(const Entity entity, Archetype& target) {
+        EntityRecord& record = m_Records[entity.Index];
+        Archetype& source = *record.Owner;
+        const ArchetypeRow sourceRow = record.Row;
+        const ArchetypeRow targetRow = target.Push(entity);
+
+        for (u8 column = 0; column < source.m_ComponentIds.size(); column++) {
+            const ComponentId id = source.m_ComponentIds[column];
+            void* component = source.GetComponent(sourceRow, column);
+
+            if (target.HasComponent(id)) {
+                void* destination = target.GetComponent(targetRow, target.GetColumnIndex(id));
+                RelocateComponent(*source.m_ComponentInfos[column], destination, component);
+            } else {
+                DestroyComponent(*source.m_ComponentInfos[column], component);
+            }
+        }
+
+        const Entity moved = source.Remove(sourceRow);
+        if (moved.IsValid()) {
+            m_Records[moved.Index].Row = sourceRow;
+        }
+
+        record.Owner = &target;
+        record.Row = targetRow;
+    }
+
+    void* Scene::FindComponent(const Entity entity, const ComponentId id) const {
+        if (!IsAlive(entity)) {
+            return nullptr;
+        }
+
+        const EntityRecord& record = m_Records[entity.Index];
+        const u8 column = record.Owner->GetColumnIndex(id);
+
+        return column == Archetype::InvalidColumn ? nullptr : record.Owner->GetComponent(record.Row, column);
+    }
+}
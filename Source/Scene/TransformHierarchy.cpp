@@ -0,0 +1,348 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Scene/TransformHierarchy.hpp>
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Profiler.hpp>
+#include <FlashlightEngine/Math/SimdLevel.hpp>
+#include <FlashlightEngine/Scene/TransformKernels.hpp>
+
+namespace Flashlight {
+    // Defined by the files under Kernels, each built for its instruction set. Null when the compiler can't target it.
+    // AVX-512 brings nothing to a single 4x4 product, that level uses the AVX2 kernels.
+    const TransformKernels* GetSse42TransformKernels();
+    const TransformKernels* GetAvx2TransformKernels();
+
+    namespace {
+#include "Kernels/TransformKernels.inl"
+
+        // Nodes per job when a level is split, about 50 microseconds of work.
+        constexpr u32 UpdateGranularity = 4096;
+
+        void ComputeWorldMatrix(const f32* parent, const f32* position, const f32* rotation, const f32* scale,
+                                f32* result) {
+            f32 m[9];
+            ComputeLocalColumns(rotation, scale, m);
+
+            for (u32 row = 0; row < 4; row++) {
+                result[row] = parent[row] * m[0] + parent[4 + row] * m[1] + parent[8 + row] * m[2];
+                result[4 + row] = parent[row] * m[3] + parent[4 + row] * m[4] + parent[8 + row] * m[5];
+                result[8 + row] = parent[row] * m[6] + parent[4 + row] * m[7] + parent[8 + row] * m[8];
+                result[12 + row] = parent[row] * position[0] + parent[4 + row] * position[1] +
+                                   parent[8 + row] * position[2] + parent[12 + row];
+            }
+        }
+
+        constexpr TransformKernels ScalarKernels = MakeTransformKernels<&ComputeWorldMatrix>();
+
+        const TransformKernels* GetTransformKernels(const SimdLevel level) {
+            switch (level) {
+            case SimdLevel::Scalar:
+                return &ScalarKernels;
+            case SimdLevel::Sse42:
+                return GetSse42TransformKernels();
+            case SimdLevel::Avx2:
+            case SimdLevel::Avx512:
+                return GetAvx2TransformKernels();
+            }
+
+            return nullptr;
+        }
+
+        const TransformKernels& GetActiveKernels() {
+            // Walks down to the best level the engine was built with.
+            for (i32 level = static_cast<i32>(GetSimdLevel()); level >= 0; level--) {
+                if (const TransformKernels* kernels = GetTransformKernels(static_cast<SimdLevel>(level))) {
+                    return *kernels;
+                }
+            }
+
+            return ScalarKernels;
+        }
+
+        template <typename T>
+        void Permute(std::vector<T>& values, const std::vector<u32>& order) {
+            std::vector<T> sorted;
+            sorted.reserve(values.size());
+
+            for (const u32 index : order) {
+                sorted.push_back(values[index]);
+            }
+
+            values.swap(sorted);
+        }
+
+        template <typename T>
+        void Compact(std::vector<T>& values, const std::vector<u8>& removed) {
+            u32 write = 0;
+            for (u32 read = 0; read < values.size(); read++) {
+                if (!removed[read]) {
+                    values[write++] = values[read];
+                }
+            }
+
+            values.resize(write);
+        }
+    }
+
+    static_assert(sizeof(glm::vec3) == 3 * sizeof(f32) && sizeof(glm::mat4) == 16 * sizeof(f32),
+                  "The kernels read positions, scales and matrices as packed floats.");
+    static_assert(offsetof(glm::quat, x) == 0 && offsetof(glm::quat, w) == 3 * sizeof(f32),
+                  "The kernels read rotations as x, y, z, w.");
+
+    TransformId TransformHierarchy::Create(const TransformId parent) {
+        assert((parent == InvalidTransform || IsAlive(parent)) && "Parent transform is dead.");
+
+        TransformId id;
+        if (!m_FreeIds.empty()) {
+            id = m_FreeIds.back();
+            m_FreeIds.pop_back();
+        } else {
+            id = static_cast<TransformId>(m_Indices.size());
+            m_Indices.push_back(InvalidIndex);
+        }
+
+        const u32 index = GetCount();
+
+        m_Ids.push_back(id);
+        m_ParentIndices.push_back(parent == InvalidTransform ? InvalidIndex : m_Indices[parent]);
+        m_LocalPositions.emplace_back(0.0f);
+        m_LocalRotations.emplace_back(1.0f, 0.0f, 0.0f, 0.0f);
+        m_LocalScales.emplace_back(1.0f);
+        m_WorldMatrices.emplace_back(1.0f);
+        m_Dirty.push_back(1);
+
+        m_Indices[id] = index;
+        m_FirstDirtyIndex = std::min(m_FirstDirtyIndex, index);
+
+        // Appending keeps parents before children but breaks the depth order, the next Update sorts the nodes again.
+        m_OrderDirty = true;
+
+        return id;
+    }
+
+    void TransformHierarchy::Destroy(const TransformId id) {
+        Destroy(std::span(&id, 1));
+    }
+
+    void TransformHierarchy::Destroy(const std::span<const TransformId> ids) {
+        // Marking descendants in one pass needs parents to come first.
+        if (m_OrderDirty) {
+            SortBreadthFirst();
+        }
+
+        std::vector<u8> removed(GetCount(), 0);
+        for (const TransformId id : ids) {
+            if (IsAlive(id)) {
+                removed[m_Indices[id]] = 1;
+            }
+        }
+
+        for (u32 index = 0; index < GetCount(); index++) {
+            const u32 parentIndex = m_ParentIndices[index];
+            if (parentIndex != InvalidIndex && removed[parentIndex]) {
+                removed[index] = 1;
+            }
+        }
+
+        RemoveMarked(removed);
+    }
+
+    void TransformHierarchy::SetParent(const TransformId id, const TransformId parent) {
+        assert(IsAlive(id) && "Transform is dead.");
+        assert((parent == InvalidTransform || IsAlive(parent)) && "Parent transform is dead.");
+
+        for (TransformId ancestor = parent; ancestor != InvalidTransform; ancestor = GetParent(ancestor)) {
+            assert(ancestor != id && "A transform can't be parented to one of its descendants.");
+        }
+
+        const u32 index = m_Indices[id];
+        m_ParentIndices[index] = parent == InvalidTransform ? InvalidIndex : m_Indices[parent];
+        MarkDirty(index);
+
+        m_OrderDirty = true;
+    }
+
+    TransformId TransformHierarchy::GetParent(const TransformId id) const {
+        const u32 parentIndex = m_ParentIndices[m_Indices[id]];
+        return parentIndex == InvalidIndex ? InvalidTransform : m_Ids[parentIndex];
+    }
+
+    void TransformHierarchy::Update(JobSystem* jobs) {
+        FL_PROFILE_ZONE("TransformHierarchy::Update");
+
+        if (m_OrderDirty) {
+            SortBreadthFirst();
+        }
+
+        if (m_FirstDirtyIndex == InvalidIndex) {
+            return;
+        }
+
+        // Levels are updated one after the other, the nodes of a level only read world matrices of the levels before.
+        const auto firstLevel = std::upper_bound(m_LevelOffsets.begin(), m_LevelOffsets.end(), m_FirstDirtyIndex) - 1;
+        for (auto level = firstLevel; level + 1 != m_LevelOffsets.end(); ++level) {
+            const u32 begin = std::max(*level, m_FirstDirtyIndex);
+            const u32 end = *(level + 1);
+            if (begin >= end) {
+                continue; // Emptied by Destroy.
+            }
+
+            if (jobs != nullptr && end - begin > UpdateGranularity) {
+                jobs->ParallelFor(end - begin, UpdateGranularity, [this, begin](const u32 first, const u32 last) {
+                    UpdateRange(begin + first, begin + last);
+                });
+            } else {
+                UpdateRange(begin, end);
+            }
+        }
+
+        std::fill(m_Dirty.begin() + m_FirstDirtyIndex, m_Dirty.end(), 0);
+        m_FirstDirtyIndex = InvalidIndex;
+    }
+
+    void TransformHierarchy::UpdateRange(const u32 begin, const u32 end) {
+        static_assert(InvalidIndex == TransformRootParent, "The kernels see roots as TransformRootParent.");
+
+        const TransformArrays nodes = {
+            m_ParentIndices.data(), &m_LocalPositions.data()->x, &m_LocalRotations.data()->x, &m_LocalScales.data()->x,
+            m_Dirty.data(), &m_WorldMatrices.data()[0][0][0]
+        };
+
+        GetActiveKernels().UpdateWorldMatrices(nodes, begin, end);
+    }
+
+    void TransformHierarchy::SortBreadthFirst() {
+        const u32 count = GetCount();
+
+        // Children of every node, grouped by parent in index order.
+        std::vector<u32> childOffsets(count + 1, 0);
+        for (const u32 parentIndex : m_ParentIndices) {
+            if (parentIndex != InvalidIndex) {
+                childOffsets[parentIndex + 1]++;
+            }
+        }
+        for (u32 index = 0; index < count; index++) {
+            childOffsets[index + 1] += childOffsets[index];
+        }
+
+        std::vector<u32> children(childOffsets[count]);
+        std::vector<u32> nextChild(childOffsets.begin(), childOffsets.end() - 1);
+        for (u32 index = 0; index < count; index++) {
+            if (m_ParentIndices[index] != InvalidIndex) {
+                children[nextChild[m_ParentIndices[index]]++] = index;
+            }
+        }
+
+        // Breadth-first order: sorted by depth, and within a depth the parents are visited in increasing order, so
+        // Update reads the parent world matrices sequentially.
+        std::vector<u32> order;
+        order.reserve(count);
+        for (u32 index = 0; index < count; index++) {
+            if (m_ParentIndices[index] == InvalidIndex) {
+                order.push_back(index);
+            }
+        }
+
+        // One level at a time: the children of a level's nodes are the next level.
+        m_LevelOffsets.clear();
+        for (u32 levelBegin = 0; levelBegin < order.size();) {
+            const auto levelEnd = static_cast<u32>(order.size());
+            m_LevelOffsets.push_back(levelBegin);
+
+            for (u32 next = levelBegin; next < levelEnd; next++) {
+                const u32 index = order[next];
+                for (u32 child = childOffsets[index]; child < childOffsets[index + 1]; child++) {
+                    order.push_back(children[child]);
+                }
+            }
+
+            levelBegin = levelEnd;
+        }
+        m_LevelOffsets.push_back(count);
+
+        std::vector<u32> newIndices(count);
+        for (u32 newIndex = 0; newIndex < count; newIndex++) {
+            newIndices[order[newIndex]] = newIndex;
+        }
+
+        for (u32& parentIndex : m_ParentIndices) {
+            if (parentIndex != InvalidIndex) {
+                parentIndex = newIndices[parentIndex];
+            }
+        }
+
+        Permute(m_Ids, order);
+        Permute(m_ParentIndices, order);
+        Permute(m_LocalPositions, order);
+        Permute(m_LocalRotations, order);
+        Permute(m_LocalScales, order);
+        Permute(m_WorldMatrices, order);
+        Permute(m_Dirty, order);
+
+        for (u32 index = 0; index < count; index++) {
+            m_Indices[m_Ids[index]] = index;
+        }
+
+        const auto firstDirty = std::find(m_Dirty.begin(), m_Dirty.end(), 1);
+        m_FirstDirtyIndex = firstDirty == m_Dirty.end() ? InvalidIndex : static_cast<u32>(firstDirty - m_Dirty.begin());
+
+        m_OrderDirty = false;
+    }
+
+    void TransformHierarchy::RemoveMarked(const std::vector<u8>& removed) {
+        const u32 count = GetCount();
+
+        std::vector<u32> newIndices(count, InvalidIndex);
+        u32 kept = 0;
+        u32 level = 0;
+        u32 firstDirtyIndex = InvalidIndex;
+        for (u32 index = 0; index < count; index++) {
+            // Levels and the first dirty node move down by the number of nodes removed before them.
+            while (level < m_LevelOffsets.size() && m_LevelOffsets[level] == index) {
+                m_LevelOffsets[level++] = kept;
+            }
+            if (index == m_FirstDirtyIndex) {
+                firstDirtyIndex = kept;
+            }
+
+            if (removed[index]) {
+                m_Indices[m_Ids[index]] = InvalidIndex;
+                m_FreeIds.push_back(m_Ids[index]);
+            } else {
+                newIndices[index] = kept++;
+            }
+        }
+
+        while (level < m_LevelOffsets.size()) {
+            m_LevelOffsets[level++] = kept;
+        }
+
+        if (kept == count) {
+            return;
+        }
+
+        m_FirstDirtyIndex = firstDirtyIndex;
+
+        // A kept node's parent is always kept too.
+        for (u32& parentIndex : m_ParentIndices) {
+            if (parentIndex != InvalidIndex) {
+                parentIndex = newIndices[parentIndex];
+            }
+        }
+
+        Compact(m_Ids, removed);
+        Compact(m_ParentIndices, removed);
+        Compact(m_LocalPositions, removed);
+        Compact(m_LocalRotations, removed);
+        Compact(m_LocalScales, removed);
+        Compact(m_WorldMatrices, removed);
+        Compact(m_Dirty, removed);
+
+        for (u32 index = 0; index < kept; index++) {
+            m_Indices[m_Ids[index]] = index;
+        }
+    }
+}
@@ -0,0 +1,133 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Animation/AnimationClip.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    // Not a multiple of PoseWidth, so the last packet of the pose is partial.
+    constexpr u32 JointCount = 19;
+    constexpr u32 FrameCount = 91;
+
+    /*
+     * Every joint swings around its own axis, some joints breathe in scale, and the root moves forward by distance
+     * over the clip while bobbing up and down.
+     */
+    RawAnimation MakeAnimation(const f32 distance) {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<f32> value(-1.0f, 1.0f);
+
+        RawAnimation raw;
+        raw.JointCount = JointCount;
+        raw.FrameCount = FrameCount;
+
+        std::vector<glm::vec3> axes(JointCount);
+        std::vector<f32> phases(JointCount);
+        for (u32 joint = 0; joint < JointCount; joint++) {
+            axes[joint] = glm::normalize(glm::vec3(value(random), value(random), value(random)));
+            phases[joint] = value(random) * 3.0f;
+        }
+
+        for (u32 frame = 0; frame < FrameCount; frame++) {
+            const f32 time = static_cast<f32>(frame) / raw.SampleRate;
+            for (u32 joint = 0; joint < JointCount; joint++) {
+                JointTransform transform;
+                transform.Translation = glm::vec3(0.0f, 0.5f, 0.0f);
+                transform.Rotation = glm::angleAxis(1.2f * std::sin(2.0f * time + phases[joint]), axes[joint]);
+                if (joint == 0) {
+                    transform.Translation = glm::vec3(distance * frame / (FrameCount - 1), 0.1f * std::sin(5.0f * time),
+                                                      0.0f);
+                }
+                if (joint % 5 == 3) {
+                    transform.Scale = glm::vec3(1.0f + 0.2f * std::sin(3.0f * time));
+                }
+
+                raw.Samples.push_back(transform);
+            }
+        }
+
+        return raw;
+    }
+
+    class AnimationClipTest : public testing::Test {
+    protected:
+        std::vector<std::string> m_Warnings;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+            Logger::AddEngineCallback([this](const spdlog::level::level_enum& level, const std::string& message) {
+                if (level == spdlog::level::warn) {
+                    m_Warnings.push_back(message);
+                }
+            });
+        }
+
+        void TearDown() override {
+            Logger::Shutdown();
+        }
+    };
+
+    TEST_F(AnimationClipTest, CompressedClipsStayWithinTolerance) {
+        const RawAnimation raw = MakeAnimation(2.0f);
+        const ClipCompressionSettings settings;
+        const AnimationClip clip = CompressAnimation(raw, settings);
+
+        const ClipError error = MeasureClipError(clip, raw);
+        EXPECT_LE(error.Translation, settings.TranslationTolerance);
+        EXPECT_LE(error.Rotation, settings.RotationTolerance);
+        EXPECT_LE(error.Scale, settings.ScaleTolerance);
+
+        EXPECT_LT(clip.GetKeyCount(), JointCount * FrameCount * 3);
+        EXPECT_LT(clip.GetMemorySize(), raw.Samples.size() * sizeof(JointTransform));
+        EXPECT_TRUE(m_Warnings.empty());
+
+        // Two meters fit in 16 bits within a millimeter.
+        for (const ClipChannelData& channel : clip.Channels) {
+            EXPECT_TRUE(channel.RawKeys.empty());
+        }
+    }
+
+    // 16 bits over a kilometer are steps of 1.5 centimeters, the root keeps full floats to stay within a millimeter.
+    TEST_F(AnimationClipTest, WideRangesKeepTheirTolerance) {
+        const RawAnimation raw = MakeAnimation(1000.0f);
+        const ClipCompressionSettings settings;
+        const AnimationClip clip = CompressAnimation(raw, settings);
+
+        const ClipError error = MeasureClipError(clip, raw);
+        EXPECT_LE(error.Translation, settings.TranslationTolerance);
+        EXPECT_LE(error.Rotation, settings.RotationTolerance);
+        EXPECT_LE(error.Scale, settings.ScaleTolerance);
+
+        const ClipChannelData& translations = clip.GetChannel(ClipChannel::Translation);
+        EXPECT_TRUE(translations.Tracks[0].Raw);
+        EXPECT_EQ(translations.RawKeys.size(), translations.Tracks[0].KeyCount);
+        EXPECT_EQ(translations.RawKeyFrames.size(), translations.RawKeys.size());
+        for (u32 joint = 1; joint < JointCount; joint++) {
+            EXPECT_FALSE(translations.Tracks[joint].Raw) << "Joint " << joint;
+        }
+
+        // In between frames too.
+        Pose pose;
+        SampleAnimation(clip, 1.5f / raw.SampleRate, pose);
+        const glm::vec3 expected = glm::mix(raw.GetSample(1, 0).Translation, raw.GetSample(2, 0).Translation, 0.5f);
+        EXPECT_LE(glm::length(pose.GetJoint(0).Translation - expected), 2.0f * settings.TranslationTolerance);
+    }
+
+    TEST_F(AnimationClipTest, RotationTolerancesUnderTheQuantizationAreLogged) {
+        const RawAnimation raw = MakeAnimation(2.0f);
+
+        ClipCompressionSettings settings;
+        settings.RotationTolerance = 1e-6f;
+        const AnimationClip clip = CompressAnimation(raw, settings);
+
+        EXPECT_EQ(m_Warnings.size(), JointCount);
+        EXPECT_EQ(clip.GetChannel(ClipChannel::Rotation).Keys.size(), JointCount * FrameCount);
+    }
+}
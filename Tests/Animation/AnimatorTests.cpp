@@ -0,0 +1,265 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Animation/Animator.hpp>
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    // Not multiples of PoseWidth, and different enough that the per-thread poses have to be resized.
+    constexpr u32 SmallJointCount = 5;
+    constexpr u32 LargeJointCount = 27;
+
+    constexpr u32 FrameCount = 31;
+
+    JointTransform MakeTransform(std::mt19937& random, const f32 amplitude) {
+        std::uniform_real_distribution<f32> value(-1.0f, 1.0f);
+
+        JointTransform transform;
+        transform.Translation = amplitude * glm::vec3(value(random), value(random), value(random));
+        transform.Rotation = glm::angleAxis(amplitude * 3.0f * value(random),
+                                            glm::normalize(glm::vec3(value(random), value(random), value(random))));
+        transform.Scale = glm::vec3(1.0f) + amplitude * 0.3f * glm::vec3(value(random), value(random), value(random));
+        return transform;
+    }
+
+    // Each joint's parent is one of the joints before it.
+    Skeleton MakeSkeleton(const u32 jointCount, const u32 seed) {
+        std::mt19937 random(seed);
+
+        std::vector<SkeletonJoint> joints(jointCount);
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            joints[joint].Name = "Joint" + std::to_string(joint);
+            joints[joint].Parent = joint == 0 ? InvalidJoint : static_cast<u32>(random() % joint);
+            joints[joint].BindPose = MakeTransform(random, 1.0f);
+        }
+
+        return Skeleton(joints);
+    }
+
+    // Random keys, additive clips stay close to the identity like the difference between two poses would.
+    AnimationClip MakeClip(const u32 jointCount, const u32 seed, const bool additive = false) {
+        std::mt19937 random(seed);
+
+        RawAnimation raw;
+        raw.JointCount = jointCount;
+        raw.FrameCount = FrameCount;
+        for (u32 sample = 0; sample < jointCount * FrameCount; sample++) {
+            raw.Samples.push_back(MakeTransform(random, additive ? 0.2f : 1.0f));
+        }
+
+        return CompressAnimation(raw);
+    }
+
+    const glm::mat4 Root = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+
+    // What EvaluateCharacter should do, spelled out with the pose functions.
+    std::vector<glm::mat4> ComputeReference(const Skeleton& skeleton, const Pose& pose) {
+        std::vector<glm::mat4> models(skeleton.GetJointCount());
+        ComputeModelMatrices(skeleton, pose, models, Root);
+        return models;
+    }
+
+    Pose Sample(const AnimationClip& clip, const f32 time) {
+        Pose pose;
+        SampleAnimation(clip, time, pose);
+        return pose;
+    }
+
+    // The same functions on the same inputs, so the matrices are expected to be identical.
+    void ExpectMatrices(const std::vector<glm::mat4>& actual, const std::vector<glm::mat4>& expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (u32 joint = 0; joint < actual.size(); joint++) {
+            for (u32 column = 0; column < 4; column++) {
+                for (u32 row = 0; row < 4; row++) {
+                    ASSERT_EQ(actual[joint][column][row], expected[joint][column][row])
+                        << "Joint " << joint << ", column " << column << ", row " << row;
+                }
+            }
+        }
+    }
+
+    class AnimatorTest : public testing::Test {
+    protected:
+        Skeleton m_Small = MakeSkeleton(SmallJointCount, 1);
+        Skeleton m_Large = MakeSkeleton(LargeJointCount, 2);
+        AnimationClip m_SmallClip;
+        AnimationClip m_LargeClip;
+        AnimationClip m_LargeOtherClip;
+        AnimationClip m_LargeAdditiveClip;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+
+            m_SmallClip = MakeClip(SmallJointCount, 3);
+            m_LargeClip = MakeClip(LargeJointCount, 4);
+            m_LargeOtherClip = MakeClip(LargeJointCount, 5);
+            m_LargeAdditiveClip = MakeClip(LargeJointCount, 6, true);
+        }
+
+        void TearDown() override {
+            Logger::Shutdown();
+        }
+
+        static std::vector<glm::mat4> Evaluate(const Skeleton& skeleton, const std::span<const AnimationLayer> layers) {
+            std::vector<glm::mat4> models(skeleton.GetJointCount());
+            EvaluateCharacter({&skeleton, layers, Root, models});
+            return models;
+        }
+    };
+
+    TEST_F(AnimatorTest, BindPoseShowsWhenNoLayerReplacesIt) {
+        const std::vector<glm::mat4> expected = ComputeReference(m_Large, Pose::FromBindPose(m_Large));
+        ExpectMatrices(Evaluate(m_Large, {}), expected);
+
+        // Layers without a clip or a weight are skipped.
+        const std::array<AnimationLayer, 2> skipped = {
+            AnimationLayer{nullptr, 0.5f, 1.0f}, AnimationLayer{&m_LargeClip, 0.5f, 0.0f}
+        };
+        ExpectMatrices(Evaluate(m_Large, skipped), expected);
+    }
+
+    TEST_F(AnimatorTest, FullBlendLayersReplaceThePoseSoFar) {
+        const std::vector<glm::mat4> expected = ComputeReference(m_Large, Sample(m_LargeClip, 0.4f));
+
+        for (const f32 weight : {1.0f, 1.5f}) {
+            const AnimationLayer layer{&m_LargeClip, 0.4f, weight};
+            ExpectMatrices(Evaluate(m_Large, std::span(&layer, 1)), expected);
+        }
+
+        // Whatever came before it.
+        const std::array<AnimationLayer, 3> layers = {
+            AnimationLayer{&m_LargeOtherClip, 0.2f, 1.0f},
+            AnimationLayer{&m_LargeAdditiveClip, 0.3f, 0.7f, AnimationBlendMode::Additive},
+            AnimationLayer{&m_LargeClip, 0.4f, 1.0f}
+        };
+        ExpectMatrices(Evaluate(m_Large, layers), expected);
+    }
+
+    TEST_F(AnimatorTest, PartialBlendLayersLerp) {
+        Pose pose = Pose::FromBindPose(m_Large);
+        BlendPoses(pose, Sample(m_LargeClip, 0.4f), 0.3f, pose);
+
+        const AnimationLayer layer{&m_LargeClip, 0.4f, 0.3f};
+        ExpectMatrices(Evaluate(m_Large, std::span(&layer, 1)), ComputeReference(m_Large, pose));
+
+        // Over another clip rather than the bind pose.
+        pose = Sample(m_LargeOtherClip, 0.9f);
+        BlendPoses(pose, Sample(m_LargeClip, 0.4f), 0.6f, pose);
+
+        const std::array<AnimationLayer, 2> layers = {
+            AnimationLayer{&m_LargeOtherClip, 0.9f, 1.0f}, AnimationLayer{&m_LargeClip, 0.4f, 0.6f}
+        };
+        ExpectMatrices(Evaluate(m_Large, layers), ComputeReference(m_Large, pose));
+    }
+
+    TEST_F(AnimatorTest, AdditiveLayersAddTheirWeight) {
+        Pose pose = Sample(m_LargeClip, 0.4f);
+        AddPose(pose, Sample(m_LargeAdditiveClip, 0.7f), 0.5f, pose);
+
+        const std::array<AnimationLayer, 2> layers = {
+            AnimationLayer{&m_LargeClip, 0.4f, 1.0f},
+            AnimationLayer{&m_LargeAdditiveClip, 0.7f, 0.5f, AnimationBlendMode::Additive}
+        };
+        ExpectMatrices(Evaluate(m_Large, layers), ComputeReference(m_Large, pose));
+
+        // A full weight additive layer is still added, it doesn't replace the pose.
+        pose = Pose::FromBindPose(m_Large);
+        AddPose(pose, Sample(m_LargeAdditiveClip, 0.7f), 1.0f, pose);
+
+        const AnimationLayer additive{&m_LargeAdditiveClip, 0.7f, 1.0f, AnimationBlendMode::Additive};
+        ExpectMatrices(Evaluate(m_Large, std::span(&additive, 1)), ComputeReference(m_Large, pose));
+    }
+
+    // The poses in between are reused from one character to the next on a thread, whatever their skeleton size.
+    TEST_F(AnimatorTest, PerThreadPosesFollowTheSkeletonSize) {
+        const AnimationLayer largeFull{&m_LargeClip, 0.4f, 1.0f};
+        const AnimationLayer largeHalf{&m_LargeClip, 0.4f, 0.5f};
+        const AnimationLayer smallFull{&m_SmallClip, 0.8f, 1.0f};
+        const AnimationLayer smallHalf{&m_SmallClip, 0.8f, 0.5f};
+
+        Pose largeBlend = Pose::FromBindPose(m_Large);
+        BlendPoses(largeBlend, Sample(m_LargeClip, 0.4f), 0.5f, largeBlend);
+        Pose smallBlend = Pose::FromBindPose(m_Small);
+        BlendPoses(smallBlend, Sample(m_SmallClip, 0.8f), 0.5f, smallBlend);
+
+        // Large then small and back, with every way of filling the pose: bind pose, replaced and blended.
+        for (u32 round = 0; round < 2; round++) {
+            ExpectMatrices(Evaluate(m_Large, std::span(&largeFull, 1)),
+                           ComputeReference(m_Large, Sample(m_LargeClip, 0.4f)));
+            ExpectMatrices(Evaluate(m_Small, {}), ComputeReference(m_Small, Pose::FromBindPose(m_Small)));
+            ExpectMatrices(Evaluate(m_Large, std::span(&largeHalf, 1)), ComputeReference(m_Large, largeBlend));
+            ExpectMatrices(Evaluate(m_Small, std::span(&smallFull, 1)),
+                           ComputeReference(m_Small, Sample(m_SmallClip, 0.8f)));
+            ExpectMatrices(Evaluate(m_Large, {}), ComputeReference(m_Large, Pose::FromBindPose(m_Large)));
+            ExpectMatrices(Evaluate(m_Small, std::span(&smallHalf, 1)), ComputeReference(m_Small, smallBlend));
+        }
+    }
+
+    TEST_F(AnimatorTest, CrowdsMatchOneCharacterAtATimeWithAndWithoutJobs) {
+        // Several jobs worth of characters mixing both skeletons and every kind of layer stack.
+        constexpr u32 characterCount = 150;
+        std::mt19937 random(9);
+        std::uniform_real_distribution<f32> unit(0.0f, 1.0f);
+
+        std::vector<std::vector<AnimationLayer>> layers(characterCount);
+        std::vector<std::vector<glm::mat4>> expected(characterCount);
+        for (u32 character = 0; character < characterCount; character++) {
+            const f32 time = unit(random);
+            const f32 weight = unit(random);
+            Pose pose;
+
+            switch (character % 4) {
+            case 0:
+                layers[character] = {{&m_SmallClip, time, 1.0f}};
+                pose = Sample(m_SmallClip, time);
+                break;
+            case 1:
+                layers[character] = {{&m_SmallClip, time, weight}};
+                pose = Pose::FromBindPose(m_Small);
+                BlendPoses(pose, Sample(m_SmallClip, time), weight, pose);
+                break;
+            case 2:
+                layers[character] = {{&m_LargeClip, time, 1.0f}, {&m_LargeOtherClip, time, weight}};
+                pose = Sample(m_LargeClip, time);
+                BlendPoses(pose, Sample(m_LargeOtherClip, time), weight, pose);
+                break;
+            default:
+                layers[character] = {{&m_LargeClip, time, 1.0f},
+                                     {&m_LargeAdditiveClip, time, weight, AnimationBlendMode::Additive}};
+                pose = Sample(m_LargeClip, time);
+                AddPose(pose, Sample(m_LargeAdditiveClip, time), weight, pose);
+                break;
+            }
+
+            expected[character] = ComputeReference(character % 4 < 2 ? m_Small : m_Large, pose);
+        }
+
+        JobSystem jobSystem(4);
+        for (JobSystem* jobs : {static_cast<JobSystem*>(nullptr), &jobSystem}) {
+            std::vector<std::vector<glm::mat4>> models(characterCount);
+            std::vector<CharacterAnimation> characters(characterCount);
+            for (u32 character = 0; character < characterCount; character++) {
+                const Skeleton& skeleton = character % 4 < 2 ? m_Small : m_Large;
+                models[character].resize(skeleton.GetJointCount());
+                characters[character] = {&skeleton, layers[character], Root, models[character]};
+            }
+
+            EvaluateCharacters(characters, jobs);
+
+            for (u32 character = 0; character < characterCount; character++) {
+                SCOPED_TRACE(fmt::format("Character {0}, {1}", character, jobs != nullptr ? "jobs" : "no jobs"));
+                ExpectMatrices(models[character], expected[character]);
+            }
+        }
+    }
+}
@@ -0,0 +1,207 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Animation/Pose.hpp>
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 FanCount = 10;
+    constexpr u32 ChainLength = 12;
+
+    JointTransform MakeTransform(std::mt19937& random) {
+        std::uniform_real_distribution<f32> value(-1.0f, 1.0f);
+
+        JointTransform transform;
+        transform.Translation = glm::vec3(value(random), value(random), value(random));
+        transform.Rotation = glm::angleAxis(3.0f * value(random),
+                                            glm::normalize(glm::vec3(value(random), value(random), value(random))));
+        transform.Scale = glm::vec3(1.0f) + 0.3f * glm::vec3(value(random), value(random), value(random));
+        return transform;
+    }
+
+    /*
+     * A root with a fan of FanCount children, the last one carrying a chain of ChainLength joints. Joints are listed
+     * leaves first so every parent comes after its children. Once sorted, the fan fills whole packets while the
+     * chain has one joint per depth and puts parents in the same packet as their children.
+     */
+    std::vector<SkeletonJoint> MakeJoints() {
+        const u32 count = 1 + FanCount + ChainLength;
+        std::mt19937 random(7);
+
+        std::vector<SkeletonJoint> joints(count);
+        const auto sourceIndex = [count](const u32 order) {
+            return count - 1 - order;
+        };
+
+        joints[sourceIndex(0)].Parent = InvalidJoint;
+        for (u32 fan = 0; fan < FanCount; fan++) {
+            joints[sourceIndex(1 + fan)].Parent = sourceIndex(0);
+        }
+        for (u32 link = 0; link < ChainLength; link++) {
+            joints[sourceIndex(1 + FanCount + link)].Parent = sourceIndex(link == 0 ? FanCount : FanCount + link);
+        }
+
+        for (u32 joint = 0; joint < count; joint++) {
+            joints[joint].Name = "Joint" + std::to_string(joint);
+            joints[joint].BindPose = MakeTransform(random);
+        }
+
+        return joints;
+    }
+
+    Pose MakePose(const u32 jointCount, const u32 seed) {
+        std::mt19937 random(seed);
+
+        Pose pose;
+        pose.Resize(jointCount);
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            pose.SetJoint(joint, MakeTransform(random));
+        }
+        return pose;
+    }
+
+    glm::mat4 ToMatrix(const JointTransform& transform) {
+        return glm::translate(glm::mat4(1.0f), transform.Translation) * glm::mat4_cast(transform.Rotation) *
+               glm::scale(glm::mat4(1.0f), transform.Scale);
+    }
+
+    // One joint at a time in the source order, walking up to the root for each one.
+    glm::mat4 ComputeReferenceModel(const std::vector<SkeletonJoint>& joints, const std::vector<glm::mat4>& locals,
+                                    const u32 joint, const glm::mat4& root) {
+        const u32 parent = joints[joint].Parent;
+        if (parent == InvalidJoint) {
+            return root * locals[joint];
+        }
+
+        return ComputeReferenceModel(joints, locals, parent, root) * locals[joint];
+    }
+
+    void ExpectNear(const JointTransform& actual, const JointTransform& expected, const u32 joint) {
+        for (u32 axis = 0; axis < 3; axis++) {
+            EXPECT_NEAR(actual.Translation[axis], expected.Translation[axis], 1e-5f) << "Joint " << joint;
+            EXPECT_NEAR(actual.Scale[axis], expected.Scale[axis], 1e-5f) << "Joint " << joint;
+        }
+
+        // q and -q are the same rotation.
+        EXPECT_NEAR(std::abs(glm::dot(actual.Rotation, expected.Rotation)), 1.0f, 1e-5f) << "Joint " << joint;
+    }
+
+    TEST(SkeletonTest, JointsAreSortedBreadthFirst) {
+        const std::vector<SkeletonJoint> joints = MakeJoints();
+        const Skeleton skeleton(joints);
+
+        ASSERT_EQ(skeleton.GetJointCount(), joints.size());
+        EXPECT_EQ(skeleton.GetParentIndex(0), InvalidJoint);
+
+        for (u32 joint = 0; joint < skeleton.GetJointCount(); joint++) {
+            const u32 source = skeleton.GetSourceIndex(joint);
+            EXPECT_EQ(skeleton.GetName(joint), joints[source].Name);
+            EXPECT_EQ(skeleton.FindJoint(joints[source].Name), joint);
+            ExpectNear(skeleton.GetBindPose()[joint], joints[source].BindPose, joint);
+
+            const u32 parent = skeleton.GetParentIndex(joint);
+            if (joint > 0) {
+                ASSERT_LT(parent, joint);
+                EXPECT_EQ(skeleton.GetSourceIndex(parent), joints[source].Parent);
+            }
+        }
+
+        EXPECT_EQ(skeleton.FindJoint("Missing"), InvalidJoint);
+    }
+
+    TEST(PoseTest, ModelMatricesMatchOneJointAtATime) {
+        const std::vector<SkeletonJoint> joints = MakeJoints();
+        const Skeleton skeleton(joints);
+        const u32 jointCount = skeleton.GetJointCount();
+
+        u8 localParents = 0;
+        for (u32 packet = 0; packet < skeleton.GetPacketCount(); packet++) {
+            localParents |= skeleton.GetPacketLocalParents(packet);
+        }
+        ASSERT_NE(localParents, 0) << "No parent shares a packet with its children.";
+
+        const Pose pose = MakePose(jointCount, 11);
+        std::vector<glm::mat4> locals(jointCount);
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            locals[skeleton.GetSourceIndex(joint)] = ToMatrix(pose.GetJoint(joint));
+        }
+
+        const glm::mat4 root = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f)) *
+                               glm::rotate(glm::mat4(1.0f), 0.7f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        std::vector<glm::mat4> models(jointCount);
+        ComputeModelMatrices(skeleton, pose, models, root);
+
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            const glm::mat4 expected = ComputeReferenceModel(joints, locals, skeleton.GetSourceIndex(joint), root);
+
+            // Scales compound down the chain, the rounding grows with the size of the matrix.
+            f32 magnitude = 1.0f;
+            for (u32 column = 0; column < 4; column++) {
+                magnitude = std::max(magnitude, glm::length(expected[column]));
+            }
+
+            for (u32 column = 0; column < 4; column++) {
+                for (u32 row = 0; row < 4; row++) {
+                    EXPECT_NEAR(models[joint][column][row], expected[column][row], 1e-5f * magnitude)
+                        << "Joint " << joint << ", column " << column << ", row " << row;
+                }
+            }
+        }
+    }
+
+    TEST(PoseTest, BlendWeightsPickTheirEnds) {
+        constexpr u32 jointCount = 19;
+        const Pose a = MakePose(jointCount, 1);
+        const Pose b = MakePose(jointCount, 2);
+
+        Pose result;
+        BlendPoses(a, b, 0.0f, result);
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            ExpectNear(result.GetJoint(joint), a.GetJoint(joint), joint);
+        }
+
+        BlendPoses(a, b, 1.0f, result);
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            ExpectNear(result.GetJoint(joint), b.GetJoint(joint), joint);
+        }
+
+        // The result may be an input.
+        Pose halfway = a;
+        BlendPoses(halfway, b, 0.5f, halfway);
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            const glm::vec3 expected = glm::mix(a.GetJoint(joint).Translation, b.GetJoint(joint).Translation, 0.5f);
+            EXPECT_NEAR(glm::length(halfway.GetJoint(joint).Translation - expected), 0.0f, 1e-5f) << "Joint " << joint;
+        }
+    }
+
+    TEST(PoseTest, AdditivePosesRoundTrip) {
+        constexpr u32 jointCount = 19;
+        const Pose pose = MakePose(jointCount, 3);
+        const Pose reference = MakePose(jointCount, 4);
+
+        Pose additive;
+        ComputeAdditivePose(pose, reference, additive);
+
+        Pose result;
+        AddPose(reference, additive, 1.0f, result);
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            ExpectNear(result.GetJoint(joint), pose.GetJoint(joint), joint);
+        }
+
+        // Nothing of the additive pose is added at weight 0.
+        AddPose(reference, additive, 0.0f, result);
+        for (u32 joint = 0; joint < jointCount; joint++) {
+            ExpectNear(result.GetJoint(joint), reference.GetJoint(joint), joint);
+        }
+    }
+}
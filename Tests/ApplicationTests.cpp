@@ -0,0 +1,155 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Application.hpp>
+#include <FlashlightEngine/Core/HeadlessWindow.hpp>
+#include <FlashlightEngine/Renderer/Culling.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    WindowProperties MakeHeadlessProperties() {
+        WindowProperties properties(1280, 720, "FlashlightTests", false, false);
+        properties.Backend = WindowBackend::Headless;
+        return properties;
+    }
+
+    // Runs a given number of frames on a headless window, keeping the EngineStats of every frame.
+    class TestApplication final : public Application {
+        u32 m_FramesLeft = 0;
+
+    public:
+        u32 FrameIndex = 0;
+        std::vector<EngineStats> Stats;
+        std::vector<std::pair<u32, EventType>> Events; // Frame each event was dispatched on.
+        std::function<void(u32)> RenderCallback;
+
+        TestApplication() : Application(MakeHeadlessProperties(), {.ConsoleOutput = false}) {
+        }
+
+        void RunFrames(const u32 frameCount) {
+            m_FramesLeft = frameCount;
+            m_IsRunning = true;
+            Run();
+        }
+
+        HeadlessWindow& GetHeadlessWindow() {
+            return static_cast<HeadlessWindow&>(*m_Window);
+        }
+
+        EngineStats& GetEngineStats() {
+            return m_EngineStats;
+        }
+
+    protected:
+        void OnUpdate() override {
+        }
+
+        void OnEvent(Event& event) override {
+            Events.emplace_back(FrameIndex, event.GetEventType());
+        }
+
+        void OnRender(f32) override {
+            if (RenderCallback) {
+                RenderCallback(FrameIndex);
+            }
+
+            Stats.push_back(m_EngineStats);
+            FrameIndex++;
+
+            if (--m_FramesLeft == 0) {
+                Close();
+            }
+        }
+    };
+
+    // Every frame reports the frame arena use of the frame before it.
+    TEST(ApplicationTest, EngineStatsReportTheFrameArenaOfThePreviousFrame) {
+        TestApplication application;
+        application.RenderCallback = [&application](const u32 frame) {
+            for (u32 i = 0; i <= frame; i++) {
+                (void) application.GetFrameArena().GetCurrent().allocate(100, 1);
+            }
+        };
+        application.RunFrames(4);
+
+        ASSERT_EQ(application.Stats.size(), 4u);
+        EXPECT_EQ(application.Stats[0].FrameAllocationCount, 0u);
+        EXPECT_EQ(application.Stats[0].FrameAllocatedBytes, 0u);
+        for (u32 frame = 1; frame < 4; frame++) {
+            EXPECT_EQ(application.Stats[frame].FrameAllocationCount, frame) << "Frame " << frame;
+            EXPECT_EQ(application.Stats[frame].FrameAllocatedBytes, frame * 100u) << "Frame " << frame;
+            EXPECT_EQ(application.Stats[frame].FrameArenaOverflowCount, 0u) << "Frame " << frame;
+        }
+    }
+
+    // Scripted input reaches the application on the frame whose clock reaches it, and frames last one time step.
+    TEST(ApplicationTest, ScriptedHeadlessEventsArriveOnTheirFrames) {
+        TestApplication application;
+        HeadlessWindow& window = application.GetHeadlessWindow();
+
+        // A power of two keeps the summed clock exact.
+        window.SetTimeStep(1.0 / 64.0);
+        const f64 start = window.GetTime();
+
+        window.InjectEvent(MouseMovedEvent(10.0f, 20.0f));
+        window.ScheduleEvent(start + 2.0 / 64.0, KeyDownEvent(static_cast<i32>(Keys::W), 0));
+        window.ScheduleEvent(start + 4.0 / 64.0, KeyUpEvent(static_cast<i32>(Keys::W)));
+        window.ScheduleEvent(start + 4.0 / 64.0, WindowResizeEvent(800, 600));
+        application.RunFrames(6);
+
+        const std::vector<std::pair<u32, EventType>> expected = {
+            {0, EventType::MouseMoved}, {1, EventType::KeyDown}, {3, EventType::KeyUp}, {3, EventType::WindowResize}
+        };
+        EXPECT_EQ(application.Events, expected);
+
+        EXPECT_EQ(window.GetExtent().width, 800u);
+        EXPECT_EQ(window.GetExtent().height, 600u);
+        EXPECT_EQ(window.GetTime(), start + 6.0 / 64.0);
+
+        ASSERT_EQ(application.Stats.size(), 6u);
+        for (const EngineStats& stats : application.Stats) {
+            EXPECT_EQ(stats.FrameTime, 1.0f / 64.0f);
+        }
+    }
+
+    // Culling passes given the application's statistics fill the visibility fields of their frame only.
+    TEST(ApplicationTest, CullingPassesFillTheVisibilityStatsOfTheirFrame) {
+        // The identity's frustum is the [-1, 1] x [-1, 1] x [0, 1] box, the second sphere is outside.
+        const Frustum frustum = Frustum::FromViewProjection(glm::mat4(1.0f));
+        BoundingSpheres spheres;
+        spheres.Add(glm::vec3(0.0f, 0.0f, 0.5f), 0.1f);
+        spheres.Add(glm::vec3(5.0f, 0.0f, 0.5f), 0.1f);
+        spheres.Add(glm::vec3(0.5f, -0.5f, 0.5f), 0.1f);
+        const std::vector<u32> triangleCounts = {10, 20, 30};
+
+        TestApplication application;
+        Culler culler;
+        std::vector<u32> visible;
+        application.RenderCallback = [&](const u32 frame) {
+            CullingSettings settings;
+            settings.TriangleCounts = triangleCounts;
+            settings.Stats = &application.GetEngineStats();
+
+            // Two passes on the first frame, none on the second.
+            for (u32 pass = 0; pass < (frame == 0 ? 2u : 0u); pass++) {
+                culler.Cull(frustum, spheres, visible, settings);
+            }
+        };
+        application.RunFrames(2);
+
+        ASSERT_EQ(application.Stats.size(), 2u);
+        EXPECT_EQ(application.Stats[0].VisibleObjectCount, 4);
+        EXPECT_EQ(application.Stats[0].CulledObjectCount, 2);
+        EXPECT_EQ(application.Stats[0].DrawCallCount, 4);
+        EXPECT_EQ(application.Stats[0].TriangleCount, 80);
+
+        EXPECT_EQ(application.Stats[1].VisibleObjectCount, 0);
+        EXPECT_EQ(application.Stats[1].CulledObjectCount, 0);
+        EXPECT_EQ(application.Stats[1].DrawCallCount, 0);
+        EXPECT_EQ(application.Stats[1].TriangleCount, 0);
+    }
+}
@@ -0,0 +1,226 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Asset/AssetArchive.hpp>
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    std::vector<std::byte> MakeRandomContent(std::mt19937& random, const u64 size) {
+        std::vector<std::byte> content(size);
+        for (std::byte& value : content) {
+            value = static_cast<std::byte>(random());
+        }
+
+        return content;
+    }
+
+    std::vector<std::byte> ToBytes(const std::string_view text) {
+        const std::span<const std::byte> bytes = std::as_bytes(std::span(text));
+        return {bytes.begin(), bytes.end()};
+    }
+
+    // Text-like content, compresses a few times over.
+    std::vector<std::byte> MakeCompressibleContent(std::mt19937& random, const u64 size) {
+        std::vector<std::byte> content(size);
+        for (std::byte& value : content) {
+            value = static_cast<std::byte>('a' + random() % 4);
+        }
+
+        return content;
+    }
+
+    class AssetArchiveTest : public testing::Test {
+    protected:
+        std::filesystem::path m_Path;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+            m_Path = std::filesystem::temp_directory_path() / "FlashlightAssetArchiveTests.flpack";
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(m_Path);
+            Logger::Shutdown();
+        }
+
+        [[nodiscard]] std::vector<std::byte> ReadEntry(const AssetArchive& archive, const std::string_view path) const {
+            const AssetArchiveEntry* entry = archive.Find(path);
+            if (entry == nullptr) {
+                ADD_FAILURE() << "No entry " << path;
+                return {};
+            }
+
+            std::vector<std::byte> content(entry->Size);
+            EXPECT_EQ(archive.Read(*entry, content), AssetArchiveError::None);
+            EXPECT_EQ(archive.Verify(*entry), AssetArchiveError::None);
+
+            return content;
+        }
+
+        // Rewrites the table of contents entry of the given path in the archive file.
+        void PatchEntry(const std::string_view path, const std::function<void(AssetArchiveEntry&)>& patch) const {
+            std::fstream file(m_Path, std::ios::binary | std::ios::in | std::ios::out);
+
+            AssetArchiveHeader header;
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+            for (u32 i = 0; i < header.EntryCount; i++) {
+                const auto position = static_cast<std::streamoff>(header.TocOffset + i * sizeof(AssetArchiveEntry));
+
+                AssetArchiveEntry entry;
+                file.seekg(position);
+                file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+                if (entry.PathHash != HashAssetPath(path)) {
+                    continue;
+                }
+
+                patch(entry);
+                file.seekp(position);
+                file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+                return;
+            }
+
+            ADD_FAILURE() << "No entry " << path;
+        }
+    };
+
+    TEST_F(AssetArchiveTest, ReadsBackEveryEntry) {
+        std::mt19937 random(42);
+        const std::vector<std::byte> raw = MakeRandomContent(random, 10'000);
+        const std::vector<std::byte> text = MakeCompressibleContent(random, 100'000);
+
+        AssetArchiveWriter writer;
+        writer.Add("Raw.bin", raw);
+        writer.Add("Textures\\Text.lz4", text, AssetCompression::LZ4);
+        writer.Add("Textures/Text.zst", text, AssetCompression::Zstd);
+        writer.Add("Empty.bin", {}, AssetCompression::Zstd);
+
+        // Random bytes don't get smaller, they are stored as they are.
+        writer.Add("Random.zst", raw, AssetCompression::Zstd);
+        ASSERT_EQ(writer.Write(m_Path), AssetArchiveError::None);
+
+        AssetArchive archive;
+        ASSERT_EQ(archive.Open(m_Path), AssetArchiveError::None);
+        EXPECT_EQ(archive.GetEntries().size(), 5u);
+
+        EXPECT_EQ(ReadEntry(archive, "Raw.bin"), raw);
+        EXPECT_EQ(ReadEntry(archive, "Textures/Text.lz4"), text);
+        EXPECT_EQ(ReadEntry(archive, "Textures\\Text.zst"), text);
+        EXPECT_TRUE(ReadEntry(archive, "Empty.bin").empty());
+        EXPECT_EQ(ReadEntry(archive, "Random.zst"), raw);
+        EXPECT_EQ(archive.Find("Missing.bin"), nullptr);
+
+        EXPECT_EQ(archive.Find("Textures/Text.lz4")->Compression, AssetCompression::LZ4);
+        EXPECT_LT(archive.Find("Textures/Text.zst")->StoredSize, text.size());
+        EXPECT_EQ(archive.Find("Random.zst")->Compression, AssetCompression::None);
+
+        const std::span<const std::byte> view = archive.GetView(*archive.Find("Raw.bin"));
+        EXPECT_TRUE(std::ranges::equal(view, raw));
+    }
+
+    TEST_F(AssetArchiveTest, WritesMoreEntriesThanAJobPoolHoldsInParallel) {
+        JobSystem jobSystem(4);
+
+        constexpr u32 EntryCount = 10'000;
+        AssetArchiveWriter writer;
+        for (u32 i = 0; i < EntryCount; i++) {
+            writer.Add("Entries/" + std::to_string(i), ToBytes("Entry " + std::to_string(i) + std::string(64, 'x')),
+                       i % 2 == 0 ? AssetCompression::LZ4 : AssetCompression::Zstd);
+        }
+        ASSERT_EQ(writer.Write(m_Path, &jobSystem), AssetArchiveError::None);
+
+        AssetArchive archive;
+        ASSERT_EQ(archive.Open(m_Path), AssetArchiveError::None);
+        for (u32 i = 0; i < EntryCount; i++) {
+            const std::vector<std::byte> content = ReadEntry(archive, "Entries/" + std::to_string(i));
+            ASSERT_EQ(content, ToBytes("Entry " + std::to_string(i) + std::string(64, 'x'))) << "Entry " << i;
+        }
+    }
+
+    // The size bound on compressed entries must not reject what the compressors actually produce.
+    TEST_F(AssetArchiveTest, OpensEntriesAtTheirBestCompressionRatio) {
+        const std::vector<std::byte> zeros(16 * 1024 * 1024);
+
+        AssetArchiveWriter writer;
+        writer.Add("Zeros.lz4", zeros, AssetCompression::LZ4);
+        writer.Add("Zeros.zst", zeros, AssetCompression::Zstd);
+        ASSERT_EQ(writer.Write(m_Path), AssetArchiveError::None);
+
+        AssetArchive archive;
+        ASSERT_EQ(archive.Open(m_Path), AssetArchiveError::None);
+        EXPECT_EQ(ReadEntry(archive, "Zeros.lz4"), zeros);
+        EXPECT_EQ(ReadEntry(archive, "Zeros.zst"), zeros);
+    }
+
+    TEST_F(AssetArchiveTest, RejectsCorruptedTablesOfContents) {
+        std::mt19937 random(42);
+        const std::vector<std::byte> text = MakeCompressibleContent(random, 100'000);
+
+        const auto write = [this, &text] {
+            AssetArchiveWriter writer;
+            writer.Add("Text.lz4", text, AssetCompression::LZ4);
+            writer.Add("Text.zst", text, AssetCompression::Zstd);
+            writer.Add("Text.bin", text);
+            ASSERT_EQ(writer.Write(m_Path), AssetArchiveError::None);
+        };
+
+        const auto expectCorrupted = [this] {
+            AssetArchive archive;
+            EXPECT_EQ(archive.Open(m_Path), AssetArchiveError::Corrupted);
+            EXPECT_FALSE(archive.IsOpen());
+        };
+
+        // Sizes no stored data can decompress to, readers would try to allocate them.
+        for (const std::string_view path : {"Text.lz4", "Text.zst"}) {
+            write();
+            PatchEntry(path, [](AssetArchiveEntry& entry) { entry.Size = 1ull << 40; });
+            expectCorrupted();
+        }
+
+        write();
+        PatchEntry("Text.bin", [](AssetArchiveEntry& entry) { entry.Size++; });
+        expectCorrupted();
+
+        write();
+        PatchEntry("Text.zst", [](AssetArchiveEntry& entry) { entry.StoredSize = 1ull << 40; });
+        expectCorrupted();
+
+        write();
+        PatchEntry("Text.zst", [](AssetArchiveEntry& entry) { entry.Compression = static_cast<AssetCompression>(7); });
+        expectCorrupted();
+
+        // Within the bounds but wrong: found by reading or verifying.
+        write();
+        PatchEntry("Text.zst", [](AssetArchiveEntry& entry) { entry.Size--; });
+
+        AssetArchive archive;
+        ASSERT_EQ(archive.Open(m_Path), AssetArchiveError::None);
+        const AssetArchiveEntry* entry = archive.Find("Text.zst");
+        std::vector<std::byte> content(entry->Size);
+        EXPECT_EQ(archive.Read(*entry, content), AssetArchiveError::DecompressionFailed);
+        EXPECT_EQ(archive.Verify(*entry), AssetArchiveError::DecompressionFailed);
+    }
+
+    TEST_F(AssetArchiveTest, RejectsWhatIsNotAnArchive) {
+        AssetArchive archive;
+        EXPECT_EQ(archive.Open(m_Path), AssetArchiveError::OpenFailed);
+
+        std::ofstream(m_Path, std::ios::binary) << std::string(200, 'x');
+        EXPECT_EQ(archive.Open(m_Path), AssetArchiveError::InvalidHeader);
+
+        AssetArchiveWriter writer;
+        writer.Add("Entry.bin", std::vector<std::byte>(1000));
+        ASSERT_EQ(writer.Write(m_Path), AssetArchiveError::None);
+        std::filesystem::resize_file(m_Path, std::filesystem::file_size(m_Path) - 1);
+        EXPECT_EQ(archive.Open(m_Path), AssetArchiveError::Corrupted);
+    }
+}
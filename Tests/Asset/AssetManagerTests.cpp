@@ -0,0 +1,227 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Asset/AssetManager.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 TextureSize = 16;
+    constexpr u64 DecodedSize = TextureSize * TextureSize * 4;
+
+    // Binary PPM, the simplest format stb_image reads. Pixel i is (i, seed, 255 - i).
+    void WriteTexture(const std::filesystem::path& path, const u8 seed) {
+        std::ofstream file(path, std::ios::binary);
+        file << "P6\n" << TextureSize << ' ' << TextureSize << "\n255\n";
+        for (u32 i = 0; i < TextureSize * TextureSize; i++) {
+            const u8 pixel[3] = {static_cast<u8>(i), seed, static_cast<u8>(255 - i)};
+            file.write(reinterpret_cast<const char*>(pixel), sizeof(pixel));
+        }
+    }
+
+    // Runs every test with decoding on the I/O threads (0) and on a job system of 4 workers.
+    class AssetManagerTest : public testing::TestWithParam<u32> {
+    protected:
+        std::unique_ptr<JobSystem> m_Jobs;
+        std::filesystem::path m_Directory;
+        std::vector<std::pair<AssetHandle, AssetState>> m_Completions;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+            if (GetParam() > 0) {
+                m_Jobs = std::make_unique<JobSystem>(GetParam());
+            }
+
+            m_Directory = std::filesystem::temp_directory_path() /
+                          ("FlashlightAssetManagerTests" + std::to_string(GetParam()));
+            std::filesystem::create_directories(m_Directory);
+            for (u32 i = 0; i < 16; i++) {
+                WriteTexture(GetPath(i), static_cast<u8>(i));
+            }
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(m_Directory);
+            m_Jobs.reset();
+            Logger::Shutdown();
+        }
+
+        [[nodiscard]] std::filesystem::path GetPath(const u32 texture) const {
+            return m_Directory / ("Texture" + std::to_string(texture) + ".ppm");
+        }
+
+        [[nodiscard]] AssetManagerSettings MakeSettings(const u64 memoryBudget = 1ull << 30) const {
+            AssetManagerSettings settings;
+            settings.IoThreadCount = 2;
+            settings.MemoryBudget = memoryBudget;
+            settings.Jobs = m_Jobs.get();
+            return settings;
+        }
+
+        AssetHandle Load(AssetManager& assets, const u32 texture,
+                         const AssetPriority priority = AssetPriority::Normal) {
+            return assets.LoadTexture(GetPath(texture), priority,
+                                      [this](const AssetHandle handle, const AssetState state) {
+                                          m_Completions.emplace_back(handle, state);
+                                      });
+        }
+
+        // Calls Update until the number of completions is reached, or gives up after a few seconds.
+        void UpdateUntil(AssetManager& assets, const u64 completionCount) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (m_Completions.size() < completionCount && std::chrono::steady_clock::now() < deadline) {
+                assets.Update();
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    TEST_P(AssetManagerTest, LoadsTexturesAndCallsBack) {
+        AssetManager assets(MakeSettings());
+
+        std::vector<AssetHandle> handles;
+        for (u32 i = 0; i < 16; i++) {
+            handles.push_back(Load(assets, i));
+        }
+        const AssetHandle missing = Load(assets, 100);
+
+        assets.WaitIdle();
+
+        ASSERT_EQ(m_Completions.size(), 17u);
+        EXPECT_EQ(assets.GetState(missing), AssetState::Failed);
+        EXPECT_EQ(assets.GetTexture(missing), nullptr);
+
+        for (u32 texture = 0; texture < 16; texture++) {
+            ASSERT_EQ(assets.GetState(handles[texture]), AssetState::Ready);
+
+            const TextureData* data = assets.GetTexture(handles[texture]);
+            ASSERT_NE(data, nullptr);
+            EXPECT_EQ(data->Width, TextureSize);
+            EXPECT_EQ(data->Height, TextureSize);
+            ASSERT_EQ(data->Channels, 4u);
+            for (u32 i = 0; i < TextureSize * TextureSize; i++) {
+                ASSERT_EQ(data->Pixels[i * 4 + 0], static_cast<u8>(i));
+                ASSERT_EQ(data->Pixels[i * 4 + 1], texture);
+                ASSERT_EQ(data->Pixels[i * 4 + 2], static_cast<u8>(255 - i));
+                ASSERT_EQ(data->Pixels[i * 4 + 3], 255);
+            }
+        }
+
+        const AssetStatistics statistics = assets.GetStatistics();
+        EXPECT_EQ(statistics.Loaded, 16u);
+        EXPECT_EQ(statistics.Failed, 1u);
+        EXPECT_EQ(statistics.PendingCount, 0u);
+        EXPECT_EQ(statistics.MemoryUsed, 16 * DecodedSize);
+
+        // Released handles are dead, and their memory is given back.
+        assets.Release(handles[0]);
+        EXPECT_EQ(assets.GetState(handles[0]), AssetState::Unloaded);
+        EXPECT_EQ(assets.GetStatistics().MemoryUsed, 15 * DecodedSize);
+    }
+
+    TEST_P(AssetManagerTest, WaitIdleFailsRequestsOverAFullBudget) {
+        // Room for four textures, nothing is ever released.
+        AssetManager assets(MakeSettings(4 * DecodedSize));
+
+        std::vector<AssetHandle> handles;
+        for (u32 i = 0; i < 10; i++) {
+            handles.push_back(Load(assets, i));
+        }
+
+        assets.WaitIdle();
+
+        u32 readyCount = 0;
+        for (const AssetHandle handle : handles) {
+            const AssetState state = assets.GetState(handle);
+            ASSERT_TRUE(state == AssetState::Ready || state == AssetState::Failed);
+            readyCount += state == AssetState::Ready;
+        }
+
+        // Reads start under the budget, those in flight may go past it.
+        EXPECT_GE(readyCount, 4u);
+        EXPECT_LT(readyCount, 10u);
+        EXPECT_EQ(m_Completions.size(), 10u);
+        EXPECT_EQ(assets.GetStatistics().Failed, 10u - readyCount);
+
+        // Releasing makes room again, and WaitIdle no longer fails what fits.
+        for (const AssetHandle handle : handles) {
+            assets.Release(handle);
+        }
+
+        m_Completions.clear();
+        const AssetHandle handle = Load(assets, 0);
+        assets.WaitIdle();
+
+        EXPECT_EQ(assets.GetState(handle), AssetState::Ready);
+    }
+
+    TEST_P(AssetManagerTest, CancelledRequestsCompleteWhileOthersWaitForMemory) {
+        AssetManager assets(MakeSettings(2 * DecodedSize));
+
+        const AssetHandle loaded[2] = {Load(assets, 0), Load(assets, 1)};
+        assets.WaitIdle();
+        ASSERT_EQ(assets.GetStatistics().MemoryUsed, 2 * DecodedSize);
+
+        // Both I/O threads take a blocked request first, the others stay in the queue behind them.
+        m_Completions.clear();
+        const AssetHandle blocked[2] = {Load(assets, 2, AssetPriority::Critical),
+                                        Load(assets, 3, AssetPriority::Critical)};
+
+        std::vector<AssetHandle> cancelled;
+        for (u32 i = 4; i < 8; i++) {
+            cancelled.push_back(Load(assets, i, AssetPriority::Low));
+        }
+
+        for (const AssetHandle handle : cancelled) {
+            assets.Cancel(handle);
+        }
+
+        UpdateUntil(assets, cancelled.size());
+        ASSERT_EQ(m_Completions.size(), cancelled.size());
+        for (const auto& [handle, state] : m_Completions) {
+            EXPECT_EQ(state, AssetState::Cancelled);
+            EXPECT_NE(std::ranges::find(cancelled, handle), cancelled.end());
+        }
+
+        EXPECT_EQ(assets.GetState(blocked[0]), AssetState::Queued);
+        EXPECT_EQ(assets.GetState(blocked[1]), AssetState::Queued);
+
+        // Releases let the blocked requests go on.
+        assets.Release(loaded[0]);
+        assets.Release(loaded[1]);
+        UpdateUntil(assets, cancelled.size() + 2);
+
+        EXPECT_EQ(assets.GetState(blocked[0]), AssetState::Ready);
+        EXPECT_EQ(assets.GetState(blocked[1]), AssetState::Ready);
+        EXPECT_EQ(assets.GetStatistics().Cancelled, cancelled.size());
+    }
+
+    TEST_P(AssetManagerTest, ReleasingWhileLoadingFreesEverything) {
+        AssetManager assets(MakeSettings());
+
+        for (u32 round = 0; round < 4; round++) {
+            for (u32 i = 0; i < 16; i++) {
+                assets.Release(Load(assets, i));
+            }
+            assets.WaitIdle();
+        }
+
+        // Released requests don't call back.
+        EXPECT_TRUE(m_Completions.empty());
+        EXPECT_EQ(assets.GetStatistics().MemoryUsed, 0u);
+        EXPECT_EQ(assets.GetStatistics().PendingCount, 0u);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(AssetManager, AssetManagerTest, testing::Values(0u, 4u),
+                             [](const testing::TestParamInfo<u32>& info) {
+                                 return info.param == 0 ? std::string("IoThreadDecoding")
+                                                        : fmt::format("{0}Workers", info.param);
+                             });
+}
@@ -0,0 +1,119 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/BinaryLog.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <unordered_set>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 WriterCount = 4;
+    constexpr u32 FormatCount = 4096;
+    constexpr u32 ReopenCount = 16;
+    constexpr u64 Capacity = 16ull * 1024 * 1024;
+
+    class BinaryLogTest : public testing::Test {
+    protected:
+        std::filesystem::path m_Path = std::filesystem::temp_directory_path() / "FlashlightTests.flbin";
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+        }
+
+        void TearDown() override {
+            BinaryLog::Close();
+            std::filesystem::remove(m_Path);
+            Logger::Shutdown();
+        }
+
+        struct DecodeResult {
+            u64 MessageCount = 0;
+            u64 CorruptedCount = 0;
+        };
+
+        // Walks the records in one pass like FlashlightLogDecoder does: a message whose format record hasn't been
+        // seen yet can't be decoded.
+        DecodeResult Decode() const {
+            MemoryMappedFile file;
+            EXPECT_TRUE(file.OpenRead(m_Path));
+
+            DecodeResult result;
+            std::unordered_set<u32> formats;
+
+            const std::byte* cursor = file.GetData() + sizeof(BinaryLogFileHeader);
+            const std::byte* fileEnd = file.GetData() + file.GetSize();
+            while (static_cast<u64>(fileEnd - cursor) >= sizeof(BinaryLogRecordHeader)) {
+                BinaryLogRecordHeader record{};
+                std::memcpy(&record, cursor, sizeof(record));
+                if (record.Size == 0) {
+                    break;
+                }
+
+                cursor += record.Size;
+                if (record.Kind == BinaryLogRecordKind::Format) {
+                    formats.insert(record.FormatId);
+                } else if (formats.contains(record.FormatId)) {
+                    result.MessageCount++;
+                } else {
+                    result.CorruptedCount++;
+                }
+            }
+
+            return result;
+        }
+    };
+
+    // Writers keep the format id they cached while the log was previously open, the reopened log has to write every
+    // known format before any of their messages. Many long formats keep the reopened log busy writing them.
+    TEST_F(BinaryLogTest, ReopenWritesFormatsBeforeMessages) {
+        ASSERT_TRUE(BinaryLog::Open(m_Path, Capacity));
+
+        // The writers use the last format, which the reopened log writes last.
+        const std::string padding(200, '.');
+        u32 formatId = 0;
+        for (u32 i = 0; i < FormatCount; i++) {
+            formatId = BinaryLog::RegisterFormat(fmt::format("Reopen test format {0} {1}: {{0}}", i, padding));
+        }
+        BinaryLog::Close();
+
+        std::atomic<bool> stop = false;
+        std::vector<std::thread> writers;
+        for (u32 writer = 0; writer < WriterCount; writer++) {
+            writers.emplace_back([&stop, formatId] {
+                const auto registrar = [formatId](std::string_view) {
+                    return formatId;
+                };
+
+                while (!stop.load(std::memory_order_relaxed)) {
+                    BinaryLog::Write(spdlog::level::info, registrar, "", 42u);
+                }
+            });
+        }
+
+        u64 messageCount = 0;
+        u64 corruptedCount = 0;
+        for (u32 reopen = 0; reopen < ReopenCount; reopen++) {
+            ASSERT_TRUE(BinaryLog::Open(m_Path, Capacity));
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            BinaryLog::Close();
+
+            const DecodeResult result = Decode();
+            messageCount += result.MessageCount;
+            corruptedCount += result.CorruptedCount;
+        }
+
+        stop.store(true, std::memory_order_relaxed);
+        for (std::thread& writer : writers) {
+            writer.join();
+        }
+
+        EXPECT_GT(messageCount, 0u);
+        EXPECT_EQ(corruptedCount, 0u);
+    }
+}
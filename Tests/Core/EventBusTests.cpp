@@ -0,0 +1,122 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/EventBus.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr u32 ProducerCount = 8;
+    constexpr u32 EventsPerProducer = 20000;
+
+    // Producers publish (producer, sequence) pairs while the test thread drains, like workers posting to the main
+    // loop. A small bus keeps it full so producers and the consumer keep contending on the same slots.
+    class EventBusStressTest : public testing::TestWithParam<bool> {
+    protected:
+        // Returns the events each producer got through, checking they arrived in the order they were published.
+        std::vector<u64> Run(EventBus& bus, const bool retryWhenFull) {
+            std::atomic<u32> runningProducers{ProducerCount};
+            std::vector<std::thread> producers;
+            for (u32 producer = 0; producer < ProducerCount; producer++) {
+                producers.emplace_back([&bus, &runningProducers, producer, retryWhenFull] {
+                    for (u64 sequence = 0; sequence < EventsPerProducer; sequence++) {
+                        while (!bus.Publish(UserEvent(producer, sequence)) && retryWhenFull) {
+                            std::this_thread::yield();
+                        }
+                    }
+                    runningProducers.fetch_sub(1, std::memory_order_release);
+                });
+            }
+
+            std::vector<u64> received(ProducerCount, 0);
+            std::vector<i64> lastSequence(ProducerCount, -1);
+            const auto handler = [&received, &lastSequence](Event& event) {
+                ASSERT_EQ(event.GetEventType(), EventType::User);
+                const auto& userEvent = static_cast<UserEvent&>(event);
+
+                ASSERT_LT(userEvent.GetCode(), ProducerCount);
+                const auto sequence = static_cast<i64>(userEvent.GetData());
+                ASSERT_GT(sequence, lastSequence[userEvent.GetCode()]) << "Producer " << userEvent.GetCode();
+
+                lastSequence[userEvent.GetCode()] = sequence;
+                received[userEvent.GetCode()]++;
+            };
+
+            while (runningProducers.load(std::memory_order_acquire) != 0) {
+                bus.Drain(handler);
+            }
+            while (bus.Drain(handler) != 0) {
+            }
+
+            for (std::thread& producer : producers) {
+                producer.join();
+            }
+
+            return received;
+        }
+    };
+
+    TEST_P(EventBusStressTest, KeepsPerProducerOrder) {
+        const bool retryWhenFull = GetParam();
+        EventBus bus(256);
+
+        const std::vector<u64> received = Run(bus, retryWhenFull);
+        ASSERT_FALSE(HasFatalFailure());
+
+        u64 total = 0;
+        for (u32 producer = 0; producer < ProducerCount; producer++) {
+            if (retryWhenFull) {
+                EXPECT_EQ(received[producer], EventsPerProducer) << "Producer " << producer;
+            }
+            total += received[producer];
+        }
+
+        const EventBusStatistics statistics = bus.GetStatistics();
+        EXPECT_EQ(statistics.Published, total);
+        EXPECT_EQ(statistics.Dispatched, total);
+        EXPECT_LE(statistics.HighWaterMark, bus.GetCapacity());
+        if (!retryWhenFull) {
+            EXPECT_EQ(statistics.Published + statistics.Dropped, u64{ProducerCount} * EventsPerProducer);
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(EventBus, EventBusStressTest, testing::Values(true, false),
+                             [](const testing::TestParamInfo<bool>& info) {
+                                 return info.param ? "RetryWhenFull" : "DropWhenFull";
+                             });
+
+    TEST(EventBus, DrainOnlyDispatchesEventsAlreadyQueued) {
+        EventBus bus(16);
+        for (u32 i = 0; i < 4; i++) {
+            ASSERT_TRUE(bus.Publish(UserEvent(i)));
+        }
+
+        // Events published while draining wait for the next drain.
+        u32 dispatched = 0;
+        EXPECT_EQ(bus.Drain([&bus, &dispatched](Event&) {
+            bus.Publish(UserEvent(100));
+            dispatched++;
+        }), 4u);
+        EXPECT_EQ(dispatched, 4u);
+        EXPECT_EQ(bus.Drain([](Event&) {
+        }), 4u);
+    }
+
+    TEST(EventBus, CountsDroppedEventsWhenFull) {
+        EventBus bus(4);
+        for (u32 i = 0; i < bus.GetCapacity(); i++) {
+            EXPECT_TRUE(bus.Publish(UserEvent(i)));
+        }
+        EXPECT_FALSE(bus.Publish(UserEvent(0)));
+
+        const EventBusStatistics statistics = bus.GetStatistics();
+        EXPECT_EQ(statistics.Published, bus.GetCapacity());
+        EXPECT_EQ(statistics.Dropped, 1u);
+        EXPECT_EQ(statistics.HighWaterMark, bus.GetCapacity());
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/EventQueue.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    // Type of every drained event, with its first value (x, width, code...) to tell them apart.
+    std::vector<std::pair<EventType, i64>> DrainAll(EventQueue& queue) {
+        std::vector<std::pair<EventType, i64>> events;
+        queue.Drain([&events](Event& event) {
+            i64 value = 0;
+            switch (event.GetEventType()) {
+            case EventType::MouseMoved:
+                value = static_cast<i64>(static_cast<MouseMovedEvent&>(event).GetX());
+                break;
+            case EventType::WindowResize:
+                value = static_cast<WindowResizeEvent&>(event).GetWidth();
+                break;
+            case EventType::User:
+                value = static_cast<UserEvent&>(event).GetCode();
+                break;
+            default:
+                break;
+            }
+            events.emplace_back(event.GetEventType(), value);
+        });
+        return events;
+    }
+
+    TEST(EventQueueTest, ConsecutiveCoalescableEventsKeepTheLastValue) {
+        EventQueue queue;
+        queue.Push(MouseMovedEvent(1.0f, 1.0f));
+        queue.Push(MouseMovedEvent(2.0f, 2.0f));
+        queue.Push(MouseMovedEvent(3.0f, 3.0f));
+        queue.Push(WindowResizeEvent(800, 600));
+        queue.Push(WindowResizeEvent(1024, 768));
+
+        EXPECT_EQ(queue.GetSize(), 2u);
+        EXPECT_EQ(queue.GetCoalescedCount(), 3u);
+
+        const std::vector<std::pair<EventType, i64>> expected = {
+            {EventType::MouseMoved, 3}, {EventType::WindowResize, 1024}
+        };
+        EXPECT_EQ(DrainAll(queue), expected);
+        EXPECT_TRUE(queue.IsEmpty());
+    }
+
+    TEST(EventQueueTest, OtherEventsStopTheMerging) {
+        EventQueue queue;
+        queue.Push(MouseMovedEvent(1.0f, 1.0f));
+        queue.Push(MouseButtonDownEvent(0));
+        queue.Push(MouseMovedEvent(2.0f, 2.0f));
+        queue.Push(WindowResizeEvent(800, 600));
+        queue.Push(MouseMovedEvent(3.0f, 3.0f));
+
+        // Button and user events are never merged, even when they follow each other.
+        queue.Push(UserEvent(7));
+        queue.Push(UserEvent(8));
+
+        EXPECT_EQ(queue.GetSize(), 7u);
+        EXPECT_EQ(queue.GetCoalescedCount(), 0u);
+
+        const std::vector<std::pair<EventType, i64>> expected = {
+            {EventType::MouseMoved, 1}, {EventType::MouseButtonDown, 0}, {EventType::MouseMoved, 2},
+            {EventType::WindowResize, 800}, {EventType::MouseMoved, 3}, {EventType::User, 7}, {EventType::User, 8}
+        };
+        EXPECT_EQ(DrainAll(queue), expected);
+    }
+
+    TEST(EventQueueTest, DrainKeepsSubmissionOrder) {
+        EventQueue queue;
+        for (u32 code = 0; code < EventQueueCapacity; code++) {
+            ASSERT_TRUE(queue.Push(UserEvent(code)));
+        }
+        EXPECT_TRUE(queue.IsFull());
+        EXPECT_FALSE(queue.Push(UserEvent(EventQueueCapacity)));
+
+        const std::vector<std::pair<EventType, i64>> events = DrainAll(queue);
+        ASSERT_EQ(events.size(), EventQueueCapacity);
+        for (u32 code = 0; code < EventQueueCapacity; code++) {
+            EXPECT_EQ(events[code].second, code);
+        }
+
+        EXPECT_TRUE(queue.IsEmpty());
+        EXPECT_TRUE(DrainAll(queue).empty());
+    }
+
+    // Merging doesn't take a slot, so it still works once the queue is full.
+    TEST(EventQueueTest, FullQueuesStillMergeIntoTheirLastEvent) {
+        EventQueue queue;
+        for (u32 code = 0; code + 1 < EventQueueCapacity; code++) {
+            queue.Push(UserEvent(code));
+        }
+        queue.Push(MouseMovedEvent(1.0f, 1.0f));
+        ASSERT_TRUE(queue.IsFull());
+
+        EXPECT_TRUE(queue.Push(MouseMovedEvent(2.0f, 2.0f)));
+        EXPECT_FALSE(queue.Push(WindowResizeEvent(800, 600)));
+
+        const std::vector<std::pair<EventType, i64>> events = DrainAll(queue);
+        ASSERT_EQ(events.size(), EventQueueCapacity);
+        EXPECT_EQ(events.back(), std::make_pair(EventType::MouseMoved, i64{2}));
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/EventRecorder.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    class EventRecorderTest : public testing::Test {
+    protected:
+        std::filesystem::path m_Path = std::filesystem::temp_directory_path() / "FlashlightTests.flrec";
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(m_Path);
+            Logger::Shutdown();
+        }
+
+        // Frame index of every event the recording hands out, replayed frame by frame like Application does.
+        static std::vector<u64> Replay(EventRecording& recording) {
+            std::vector<u64> frames;
+            for (u64 frame = 0; frame < recording.GetFrameCount(); frame++) {
+                recording.DispatchFrame(frame, [&frames, frame](Event&) {
+                    frames.push_back(frame);
+                });
+            }
+            return frames;
+        }
+    };
+
+    TEST_F(EventRecorderTest, RoundTripsEveryEventType) {
+        {
+            EventRecorder recorder;
+            ASSERT_TRUE(recorder.Start(m_Path));
+            recorder.Record(0, WindowResizeEvent(1280, 720));
+            recorder.Record(0, KeyDownEvent(30, 2));
+            recorder.Record(3, MouseMovedEvent(12.5f, -4.0f));
+            recorder.Record(3, MouseScrolledEvent(0.0f, 1.0f));
+            recorder.Record(7, UserEvent(42, 1234));
+            recorder.Stop(8);
+        }
+
+        EventRecording recording;
+        ASSERT_TRUE(recording.Load(m_Path));
+        EXPECT_EQ(recording.GetFrameCount(), 8u);
+        EXPECT_EQ(recording.GetEventCount(), 5u);
+
+        std::vector<EventType> types;
+        recording.DispatchFrame(7, [&types](Event& event) {
+            types.push_back(event.GetEventType());
+
+            if (event.GetEventType() == EventType::WindowResize) {
+                const auto& resize = static_cast<const WindowResizeEvent&>(event);
+                EXPECT_EQ(resize.GetWidth(), 1280u);
+                EXPECT_EQ(resize.GetHeight(), 720u);
+            } else if (event.GetEventType() == EventType::MouseMoved) {
+                EXPECT_EQ(static_cast<const MouseMovedEvent&>(event).GetX(), 12.5f);
+            } else if (event.GetEventType() == EventType::User) {
+                EXPECT_EQ(static_cast<const UserEvent&>(event).GetCode(), 42u);
+            }
+        });
+
+        EXPECT_EQ(types, (std::vector{EventType::WindowResize, EventType::KeyDown, EventType::MouseMoved,
+                                      EventType::MouseScroll, EventType::User}));
+    }
+
+    // What Application::StopRecording relies on when it stops during a frame: a recording covering that frame hands
+    // out the events recorded in it.
+    TEST_F(EventRecorderTest, EventsOfTheLastCoveredFrameAreReplayed) {
+        {
+            EventRecorder recorder;
+            ASSERT_TRUE(recorder.Start(m_Path));
+            recorder.Record(2, KeyDownEvent(30, 0));
+            recorder.Record(5, KeyUpEvent(30));
+            recorder.Stop(6);
+        }
+
+        EventRecording recording;
+        ASSERT_TRUE(recording.Load(m_Path));
+        EXPECT_EQ(Replay(recording), (std::vector<u64>{2, 5}));
+    }
+
+    TEST_F(EventRecorderTest, TruncatedRecordingKeepsTheEventsRead) {
+        {
+            EventRecorder recorder;
+            ASSERT_TRUE(recorder.Start(m_Path));
+            recorder.Record(1, KeyDownEvent(30, 0));
+            recorder.Record(4, KeyUpEvent(30));
+            recorder.Stop(5);
+        }
+
+        // Drop the end record, as if the application had crashed.
+        std::filesystem::resize_file(m_Path, std::filesystem::file_size(m_Path) - 2);
+
+        EventRecording recording;
+        ASSERT_TRUE(recording.Load(m_Path));
+        EXPECT_EQ(Replay(recording), (std::vector<u64>{1, 4}));
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/HeadlessWindow.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    // A power of two keeps the summed clock exact, scheduled times can be compared to it as is.
+    constexpr f64 TimeStep = 1.0 / 64.0;
+
+    class HeadlessWindowTest : public testing::Test {
+    protected:
+        std::unique_ptr<HeadlessWindow> m_Window;
+        std::vector<EventType> m_Events;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+
+            WindowProperties properties(1280, 720, "FlashlightTests", false, false);
+            properties.Backend = WindowBackend::Headless;
+            properties.HeadlessTimeStep = TimeStep;
+            m_Window = std::make_unique<HeadlessWindow>(properties);
+            m_Window->SetEventCallback([this](Event& event) {
+                m_Events.push_back(event.GetEventType());
+            });
+        }
+
+        void TearDown() override {
+            m_Window.reset();
+            Logger::Shutdown();
+        }
+
+        // One frame of Application::Run as far as the window is concerned.
+        std::vector<EventType> RunFrame() {
+            m_Events.clear();
+            m_Window->Update();
+            m_Window->DispatchEvents();
+            return m_Events;
+        }
+    };
+
+    TEST_F(HeadlessWindowTest, ClockOnlyMovesOnUpdate) {
+        EXPECT_EQ(m_Window->GetTime(), 0.0);
+        RunFrame();
+        RunFrame();
+        EXPECT_EQ(m_Window->GetTime(), 2.0 * TimeStep);
+
+        m_Window->SetTimeStep(0.5);
+        RunFrame();
+        EXPECT_EQ(m_Window->GetTime(), 2.0 * TimeStep + 0.5);
+    }
+
+    TEST_F(HeadlessWindowTest, ScheduledEventsArriveWhenTheClockReachesThem) {
+        // Scheduled out of order, events of the same time keep their scheduling order.
+        m_Window->ScheduleEvent(3.0 * TimeStep, KeyUpEvent(static_cast<i32>(Keys::W)));
+        m_Window->ScheduleEvent(1.0 * TimeStep, KeyDownEvent(static_cast<i32>(Keys::W), 0));
+        m_Window->ScheduleEvent(3.0 * TimeStep, MouseButtonDownEvent(0));
+        m_Window->InjectEvent(WindowCloseEvent());
+
+        EXPECT_EQ(RunFrame(), (std::vector{EventType::WindowClose, EventType::KeyDown}));
+        EXPECT_TRUE(m_Window->ShouldClose());
+        EXPECT_TRUE(RunFrame().empty());
+        EXPECT_EQ(RunFrame(), (std::vector{EventType::KeyUp, EventType::MouseButtonDown}));
+    }
+
+    TEST_F(HeadlessWindowTest, StateChangesUpdateTheWindowAndProduceEvents) {
+        EXPECT_EQ(m_Window->GetExtent().width, 1280u);
+        EXPECT_EQ(m_Window->GetExtent().height, 720u);
+
+        m_Window->SetExtent(800, 600);
+        m_Window->SetFocused(false);
+        EXPECT_EQ(RunFrame(), (std::vector{EventType::WindowResize, EventType::WindowFocus}));
+
+        EXPECT_EQ(m_Window->GetExtent().width, 800u);
+        EXPECT_EQ(m_Window->GetExtent().height, 600u);
+        EXPECT_TRUE(m_Window->ShouldInvalidateSwapchain());
+        EXPECT_FALSE(m_Window->IsFocused());
+    }
+}
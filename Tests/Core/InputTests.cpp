@@ -0,0 +1,115 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Input.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr i32 KeyW = static_cast<i32>(Keys::W);
+    constexpr i32 KeyA = static_cast<i32>(Keys::A);
+
+    class InputTest : public testing::Test {
+    protected:
+        Input m_Input;
+
+        template <typename T>
+        void Send(const T& event) {
+            m_Input.OnEvent(event);
+        }
+
+        const InputSnapshot& Publish() {
+            m_Input.Publish();
+            return m_Input.GetSnapshot();
+        }
+    };
+
+    TEST_F(InputTest, RepeatsDontPressAgain) {
+        Send(KeyDownEvent(KeyW, 0));
+        EXPECT_TRUE(Publish().WasKeyPressed(Keys::W));
+
+        Send(KeyDownEvent(KeyW, 1));
+        Send(KeyDownEvent(KeyW, 2));
+        const InputSnapshot& snapshot = Publish();
+        EXPECT_TRUE(snapshot.IsKeyDown(Keys::W));
+        EXPECT_FALSE(snapshot.WasKeyPressed(Keys::W));
+    }
+
+    TEST_F(InputTest, TapsWithinAFrameReportBothEdges) {
+        Send(KeyDownEvent(KeyW, 0));
+        Send(KeyUpEvent(KeyW));
+        Send(MouseButtonDownEvent(IntegerFromEnum(MouseButtons::Left)));
+        Send(MouseButtonUpEvent(IntegerFromEnum(MouseButtons::Left)));
+
+        const InputSnapshot& snapshot = Publish();
+        EXPECT_TRUE(snapshot.WasKeyPressed(Keys::W));
+        EXPECT_TRUE(snapshot.WasKeyReleased(Keys::W));
+        EXPECT_FALSE(snapshot.IsKeyDown(Keys::W));
+        EXPECT_TRUE(snapshot.WasMouseButtonPressed(MouseButtons::Left));
+        EXPECT_TRUE(snapshot.WasMouseButtonReleased(MouseButtons::Left));
+        EXPECT_FALSE(snapshot.IsMouseButtonDown(MouseButtons::Left));
+    }
+
+    TEST_F(InputTest, LosingFocusReleasesEverythingHeld) {
+        Send(KeyDownEvent(KeyW, 0));
+        Send(KeyDownEvent(KeyA, 0));
+        Send(MouseButtonDownEvent(IntegerFromEnum(MouseButtons::Right)));
+        Publish();
+
+        Send(WindowFocusedEvent(false));
+        const InputSnapshot& snapshot = Publish();
+        EXPECT_FALSE(snapshot.IsKeyDown(Keys::W));
+        EXPECT_FALSE(snapshot.IsKeyDown(Keys::A));
+        EXPECT_FALSE(snapshot.IsMouseButtonDown(MouseButtons::Right));
+        EXPECT_TRUE(snapshot.WasKeyReleased(Keys::W));
+        EXPECT_TRUE(snapshot.WasKeyReleased(Keys::A));
+        EXPECT_TRUE(snapshot.WasMouseButtonReleased(MouseButtons::Right));
+
+        // Keys that weren't held aren't released.
+        EXPECT_FALSE(snapshot.WasKeyReleased(Keys::D));
+    }
+
+    TEST_F(InputTest, EdgesAndScrollLastOneFrame) {
+        Send(KeyDownEvent(KeyW, 0));
+        Send(MouseScrolledEvent(1.0f, 2.0f));
+        Send(MouseScrolledEvent(0.5f, 1.0f));
+
+        const InputSnapshot& first = Publish();
+        EXPECT_TRUE(first.WasKeyPressed(Keys::W));
+        EXPECT_EQ(first.ScrollX, 1.5f);
+        EXPECT_EQ(first.ScrollY, 3.0f);
+
+        const InputSnapshot& second = Publish();
+        EXPECT_TRUE(second.IsKeyDown(Keys::W));
+        EXPECT_FALSE(second.WasKeyPressed(Keys::W));
+        EXPECT_EQ(second.ScrollX, 0.0f);
+        EXPECT_EQ(second.ScrollY, 0.0f);
+        EXPECT_EQ(second.FrameIndex, first.FrameIndex + 1);
+    }
+
+    TEST_F(InputTest, MouseDeltaStartsAtTheFirstKnownPosition) {
+        EXPECT_EQ(Publish().MouseDeltaX, 0.0f);
+
+        // The first position seeds the delta instead of being a jump from the origin.
+        Send(MouseMovedEvent(500.0f, 300.0f));
+        const InputSnapshot& first = Publish();
+        EXPECT_EQ(first.MouseX, 500.0f);
+        EXPECT_EQ(first.MouseDeltaX, 0.0f);
+        EXPECT_EQ(first.MouseDeltaY, 0.0f);
+
+        // Every move of a frame adds up to one delta.
+        Send(MouseMovedEvent(510.0f, 290.0f));
+        Send(MouseMovedEvent(520.0f, 295.0f));
+        const InputSnapshot& second = Publish();
+        EXPECT_EQ(second.MouseDeltaX, 20.0f);
+        EXPECT_EQ(second.MouseDeltaY, -5.0f);
+
+        const InputSnapshot& third = Publish();
+        EXPECT_EQ(third.MouseX, 520.0f);
+        EXPECT_EQ(third.MouseDeltaX, 0.0f);
+        EXPECT_EQ(third.MouseDeltaY, 0.0f);
+    }
+}
@@ -0,0 +1,120 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    // More jobs than a worker's pool has slots, so slots get reused while other jobs are still queued.
+    constexpr u32 JobCount = 20000;
+
+    class JobSystemTest : public testing::TestWithParam<u32> {
+    protected:
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+        }
+
+        void TearDown() override {
+            Logger::Shutdown();
+        }
+    };
+
+    TEST_P(JobSystemTest, ParallelForRunsEveryRangeOnce) {
+        JobSystem jobSystem(GetParam());
+
+        std::vector<std::atomic<u32>> visits(JobCount);
+        jobSystem.ParallelFor(JobCount, 1, [&visits](const u32 begin, const u32 end) {
+            for (u32 i = begin; i < end; i++) {
+                visits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        for (u32 i = 0; i < JobCount; i++) {
+            ASSERT_EQ(visits[i].load(), 1u) << "Index " << i;
+        }
+    }
+
+    TEST_P(JobSystemTest, ParallelForWritesEveryResult) {
+        JobSystem jobSystem(GetParam());
+
+        std::vector<u32> results(JobCount, 0);
+        jobSystem.ParallelFor(JobCount, 1, [&results](const u32 begin, const u32 end) {
+            for (u32 i = begin; i < end; i++) {
+                results[i] = i * 3 + 1;
+            }
+        });
+
+        for (u32 i = 0; i < JobCount; i++) {
+            ASSERT_EQ(results[i], i * 3 + 1) << "Index " << i;
+        }
+    }
+
+    TEST_P(JobSystemTest, NestedParallelForRunsEveryRangeOnce) {
+        JobSystem jobSystem(GetParam());
+
+        constexpr u32 OuterCount = 8;
+        constexpr u32 InnerCount = JobCount / OuterCount;
+        std::vector<std::atomic<u32>> visits(OuterCount * InnerCount);
+
+        jobSystem.ParallelFor(OuterCount, 1, [&jobSystem, &visits](const u32 outerBegin, const u32 outerEnd) {
+            for (u32 outer = outerBegin; outer < outerEnd; outer++) {
+                jobSystem.ParallelFor(InnerCount, 1, [&visits, outer](const u32 begin, const u32 end) {
+                    for (u32 i = begin; i < end; i++) {
+                        visits[outer * InnerCount + i].fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+        });
+
+        for (u32 i = 0; i < OuterCount * InnerCount; i++) {
+            ASSERT_EQ(visits[i].load(), 1u) << "Index " << i;
+        }
+    }
+
+    TEST_P(JobSystemTest, ScheduledJobsAllFinishBeforeWaitReturns) {
+        JobSystem jobSystem(GetParam());
+
+        std::atomic<u32> finished{0};
+        JobCounter counter;
+        for (u32 i = 0; i < JobCount; i++) {
+            jobSystem.Schedule([&finished] {
+                finished.fetch_add(1, std::memory_order_relaxed);
+            }, &counter);
+        }
+        jobSystem.Wait(counter);
+
+        EXPECT_EQ(finished.load(), JobCount);
+    }
+
+    TEST_P(JobSystemTest, JobsScheduledFromOtherThreadsAllRun) {
+        JobSystem jobSystem(GetParam());
+
+        std::atomic<u32> finished{0};
+        JobCounter counter;
+        std::thread producer([&jobSystem, &finished, &counter] {
+            for (u32 i = 0; i < JobCount; i++) {
+                jobSystem.Schedule([&finished] {
+                    finished.fetch_add(1, std::memory_order_relaxed);
+                }, &counter);
+            }
+        });
+
+        // Only the workers drain the shared queue, worker 0 included, so keep waiting while the producer runs.
+        while (finished.load(std::memory_order_relaxed) < JobCount) {
+            jobSystem.Wait(counter);
+        }
+        producer.join();
+
+        EXPECT_EQ(finished.load(), JobCount);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(JobSystem, JobSystemTest, testing::Values(1u, 2u, 4u),
+                             [](const testing::TestParamInfo<u32>& info) {
+                                 return fmt::format("{0}Workers", info.param);
+                             });
+}
@@ -0,0 +1,75 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+// Every level is stripped in this file whatever the configuration, like a build configured with --loglevel=off.
+#undef FL_LOG_ACTIVE_LEVEL
+#define FL_LOG_ACTIVE_LEVEL FL_LOG_LEVEL_OFF
+
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    u32 s_Evaluations = 0;
+
+    i32 CountEvaluation() {
+        s_Evaluations++;
+        return 0;
+    }
+
+    /*
+     * A stripped call must not leave any code behind: had any of these macros expanded to a call into the logger or
+     * to CountEvaluation, neither of which is constexpr, this function couldn't be evaluated at compile time.
+     */
+    consteval bool StrippedCallsAreConstantExpressions() {
+        FL_ENGINE_TRACE(fmt::format("{}", CountEvaluation()));
+        FL_ENGINE_INFO(fmt::format("{}", CountEvaluation()));
+        FL_ENGINE_WARN(fmt::format("{}", CountEvaluation()));
+        FL_ENGINE_ERROR(fmt::format("{}", CountEvaluation()));
+        FL_ENGINE_CRITICAL(fmt::format("{}", CountEvaluation()));
+        FL_EDITOR_TRACE(fmt::format("{}", CountEvaluation()));
+        FL_EDITOR_INFO(fmt::format("{}", CountEvaluation()));
+        FL_EDITOR_WARN(fmt::format("{}", CountEvaluation()));
+        FL_EDITOR_ERROR(fmt::format("{}", CountEvaluation()));
+        FL_EDITOR_CRITICAL(fmt::format("{}", CountEvaluation()));
+        return true;
+    }
+    static_assert(StrippedCallsAreConstantExpressions());
+
+    static_assert(!Log::IsLevelCompiled(spdlog::level::trace));
+    static_assert(!Log::IsLevelCompiled(spdlog::level::critical));
+
+    TEST(LogStripping, StrippedMacrosDontEvaluateArguments) {
+        s_Evaluations = 0;
+
+        FL_ENGINE_TRACE(fmt::format("{}", CountEvaluation()));
+        FL_ENGINE_INFO(fmt::format("{}", CountEvaluation()));
+        FL_ENGINE_WARN(fmt::format("{}", CountEvaluation()));
+        FL_ENGINE_ERROR(fmt::format("{}", CountEvaluation()));
+        FL_ENGINE_CRITICAL(fmt::format("{}", CountEvaluation()));
+        FL_EDITOR_TRACE(fmt::format("{}", CountEvaluation()));
+        FL_EDITOR_WARN(fmt::format("{}", CountEvaluation()));
+
+        EXPECT_EQ(s_Evaluations, 0u);
+    }
+
+    // The logger is never initialized here, so a lazy call reaching it would also crash.
+    TEST(LogStripping, StrippedLazyCallsDontCallTheProducer) {
+        s_Evaluations = 0;
+
+        const auto producer = [] {
+            return std::to_string(CountEvaluation());
+        };
+        Log::EngineTraceLazy(producer);
+        Log::EngineInfoLazy(producer);
+        Log::EngineWarnLazy(producer);
+        Log::EditorTraceLazy(producer);
+        Log::EditorInfoLazy(producer);
+        Log::EditorWarnLazy(producer);
+
+        EXPECT_EQ(s_Evaluations, 0u);
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Logger.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    class LoggerTest : public testing::TestWithParam<LogMode> {
+    protected:
+        u32 m_Messages = 0;
+        u32 m_Evaluations = 0;
+
+        void SetUp() override {
+            if (!Log::IsLevelCompiled(spdlog::level::warn)) {
+                GTEST_SKIP() << "Warnings are stripped in this configuration.";
+            }
+
+            LoggerSettings settings;
+            settings.Mode = GetParam();
+            settings.ConsoleOutput = false;
+
+            Logger::Init(settings);
+            Logger::AddEngineCallback([this](const spdlog::level::level_enum&, const std::string&) {
+                m_Messages++;
+            });
+        }
+
+        void TearDown() override {
+            Logger::Shutdown();
+        }
+
+        i32 CountEvaluation() {
+            m_Evaluations++;
+            return 0;
+        }
+    };
+
+    // The counterpart of the stripping tests: a compiled-in call evaluates its arguments and reaches the sinks.
+    TEST_P(LoggerTest, CompiledInCallsReachTheSinks) {
+        FL_ENGINE_WARN(fmt::format("{}", CountEvaluation()));
+        Log::EngineWarnLazy([this] {
+            return std::to_string(CountEvaluation());
+        });
+        Logger::Flush();
+
+        EXPECT_EQ(m_Evaluations, 2u);
+        EXPECT_EQ(m_Messages, 2u);
+    }
+
+    TEST_P(LoggerTest, LazyCallsBelowTheRuntimeLevelDontCallTheProducer) {
+        Logger::GetEngineLogger()->set_level(spdlog::level::err);
+
+        Log::EngineWarnLazy([this] {
+            return std::to_string(CountEvaluation());
+        });
+        Logger::Flush();
+
+        EXPECT_EQ(m_Evaluations, 0u);
+        EXPECT_EQ(m_Messages, 0u);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Logger, LoggerTest, testing::Values(LogMode::Synchronous, LogMode::Asynchronous),
+                             [](const testing::TestParamInfo<LogMode>& info) {
+                                 return info.param == LogMode::Synchronous ? "Synchronous" : "Asynchronous";
+                             });
+}
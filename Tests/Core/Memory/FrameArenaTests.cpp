@@ -0,0 +1,52 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Memory/FrameArena.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    TEST(FrameArena, MemoryOfAFrameLastsUntilTheNextOne) {
+        FrameArena arena(1024);
+
+        auto* first = static_cast<u32*>(arena.GetCurrent().allocate(sizeof(u32), alignof(u32)));
+        *first = 42;
+
+        arena.BeginFrame();
+        EXPECT_EQ(arena.GetPrevious().GetStatistics().AllocationCount, 1u);
+        EXPECT_EQ(arena.GetCurrent().GetStatistics().AllocationCount, 0u);
+        EXPECT_EQ(*first, 42u);
+
+        // Two frames later the first arena is the current one again, reset.
+        (void) arena.GetCurrent().allocate(64, 16);
+        arena.BeginFrame();
+        EXPECT_EQ(arena.GetCurrent().GetStatistics().AllocationCount, 0u);
+        EXPECT_EQ(arena.GetCurrent().allocate(sizeof(u32), alignof(u32)), first);
+    }
+
+    // What Application copies into EngineStats at the start of every frame.
+    TEST(FrameArena, LastFrameStatisticsDescribeTheFrameThatEnded) {
+        FrameArena arena(256);
+        EXPECT_EQ(arena.GetLastFrameStatistics().AllocationCount, 0u);
+
+        for (u32 i = 0; i < 3; i++) {
+            (void) arena.GetCurrent().allocate(100, 1);
+        }
+        arena.BeginFrame();
+
+        ArenaStatistics statistics = arena.GetLastFrameStatistics();
+        EXPECT_EQ(statistics.AllocationCount, 3u);
+        EXPECT_EQ(statistics.AllocatedBytes, 200u);
+        EXPECT_EQ(statistics.OverflowCount, 1u);
+
+        // An empty frame reports nothing, not what the other arena held.
+        arena.BeginFrame();
+        statistics = arena.GetLastFrameStatistics();
+        EXPECT_EQ(statistics.AllocationCount, 0u);
+        EXPECT_EQ(statistics.AllocatedBytes, 0u);
+        EXPECT_EQ(statistics.OverflowCount, 0u);
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Memory/FrameArena.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Flashlight;
+
+namespace {
+    // Upstream resource counting the blocks it has handed out and not got back.
+    class CountingResource final : public std::pmr::memory_resource {
+    public:
+        u64 LiveBlocks = 0;
+
+    protected:
+        void* do_allocate(const size_t bytes, const size_t alignment) override {
+            LiveBlocks++;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, const size_t bytes, const size_t alignment) override {
+            LiveBlocks--;
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    TEST(LinearArena, RewindReleasesOverflowAllocatedAfterTheMarker) {
+        CountingResource upstream;
+        LinearArena arena(256, &upstream);
+
+        void* kept = arena.allocate(1024, 16);
+        const LinearArena::Marker marker = arena.GetMarker();
+        for (u32 i = 0; i < 8; i++) {
+            (void) arena.allocate(1024, 16);
+        }
+        EXPECT_EQ(upstream.LiveBlocks, 9u);
+
+        arena.Rewind(marker);
+        EXPECT_EQ(upstream.LiveBlocks, 1u);
+        EXPECT_NE(kept, nullptr);
+
+        arena.Reset();
+        EXPECT_EQ(upstream.LiveBlocks, 0u);
+    }
+
+    TEST(LinearArena, RewindGivesBackTheBufferSpace) {
+        LinearArena arena(256);
+
+        const LinearArena::Marker marker = arena.GetMarker();
+        void* first = arena.allocate(64, 16);
+        arena.Rewind(marker);
+
+        EXPECT_EQ(arena.allocate(64, 16), first);
+        EXPECT_EQ(arena.GetStatistics().OverflowCount, 0u);
+    }
+
+    TEST(LinearArena, NestedRewindsOnlyReleaseTheirOwnOverflow) {
+        CountingResource upstream;
+        LinearArena arena(64, &upstream);
+
+        const LinearArena::Marker outer = arena.GetMarker();
+        (void) arena.allocate(128, 16);
+        {
+            const LinearArena::Marker inner = arena.GetMarker();
+            (void) arena.allocate(128, 16);
+            (void) arena.allocate(128, 16);
+            arena.Rewind(inner);
+            EXPECT_EQ(upstream.LiveBlocks, 1u);
+        }
+        arena.Rewind(outer);
+        EXPECT_EQ(upstream.LiveBlocks, 0u);
+    }
+
+    // The thread-local scratch arena is never reset, scopes alone must keep it from growing.
+    TEST(ScratchScope, RepeatedOverflowingScopesDontAccumulate) {
+        const u64 capacity = GetScratchArena().GetCapacity();
+
+        for (u32 i = 0; i < 64; i++) {
+            ScratchScope scope;
+            (void) scope.GetArena().allocate(capacity + 1, 16);
+        }
+
+        ScratchScope scope;
+        EXPECT_EQ(scope.GetArena().GetMarker().OverflowCount, 0u);
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Memory/PoolAllocator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+
+using namespace Flashlight;
+
+namespace {
+    // Upstream resource counting the blocks it has handed out and not got back.
+    class CountingResource final : public std::pmr::memory_resource {
+    public:
+        u64 LiveBlocks = 0;
+
+    protected:
+        void* do_allocate(const size_t bytes, const size_t alignment) override {
+            LiveBlocks++;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, const size_t bytes, const size_t alignment) override {
+            LiveBlocks--;
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    TEST(PoolResource, FreedBlocksAreReusedFirst) {
+        PoolResource pool(32, 8, 4);
+
+        void* first = pool.allocate(32, 8);
+        void* second = pool.allocate(32, 8);
+        EXPECT_EQ(static_cast<std::byte*>(second), static_cast<std::byte*>(first) + pool.GetBlockSize());
+
+        pool.deallocate(first, 32, 8);
+        EXPECT_EQ(pool.GetStatistics().LiveBlocks, 1u);
+        EXPECT_EQ(pool.allocate(32, 8), first);
+
+        const PoolStatistics statistics = pool.GetStatistics();
+        EXPECT_EQ(statistics.AllocationCount, 3u);
+        EXPECT_EQ(statistics.LiveBlocks, 2u);
+        EXPECT_EQ(statistics.ReservedBlocks, 4u);
+    }
+
+    TEST(PoolResource, ExhaustedChunksGetAnotherOne) {
+        CountingResource upstream;
+        {
+            PoolResource pool(16, 8, 4, &upstream);
+
+            std::vector<void*> blocks;
+            for (u32 i = 0; i < 4; i++) {
+                blocks.push_back(pool.allocate(16, 8));
+            }
+            EXPECT_EQ(upstream.LiveBlocks, 1u);
+            EXPECT_EQ(pool.GetStatistics().ReservedBlocks, 4u);
+
+            blocks.push_back(pool.allocate(16, 8));
+            EXPECT_EQ(upstream.LiveBlocks, 2u);
+            EXPECT_EQ(pool.GetStatistics().ReservedBlocks, 8u);
+
+            // Chunks are kept until the pool goes away, freeing every block doesn't give them back.
+            for (void* block : blocks) {
+                pool.deallocate(block, 16, 8);
+            }
+            EXPECT_EQ(upstream.LiveBlocks, 2u);
+            EXPECT_EQ(pool.GetStatistics().LiveBlocks, 0u);
+        }
+        EXPECT_EQ(upstream.LiveBlocks, 0u);
+    }
+
+    TEST(PoolResource, LargerRequestsGoToTheUpstreamResource) {
+        CountingResource upstream;
+        PoolResource pool(16, 8, 4, &upstream);
+
+        void* large = pool.allocate(pool.GetBlockSize() * 2, 8);
+        void* overAligned = pool.allocate(16, 64);
+        EXPECT_EQ(upstream.LiveBlocks, 2u);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(overAligned) % 64, 0u);
+        EXPECT_EQ(pool.GetStatistics().AllocationCount, 0u);
+
+        pool.deallocate(large, pool.GetBlockSize() * 2, 8);
+        pool.deallocate(overAligned, 16, 64);
+        EXPECT_EQ(upstream.LiveBlocks, 0u);
+    }
+
+    // Standard containers use the pool through the memory_resource interface, one block per node.
+    TEST(PoolResource, BacksPmrContainers) {
+        PoolResource pool(64, alignof(std::max_align_t), 16);
+        PoolResource otherPool(64, alignof(std::max_align_t), 16);
+
+        EXPECT_TRUE(pool.is_equal(pool));
+        EXPECT_FALSE(pool.is_equal(otherPool));
+
+        {
+            std::pmr::list<u64> list(&pool);
+            for (u64 value = 0; value < 40; value++) {
+                list.push_back(value);
+            }
+            EXPECT_EQ(pool.GetStatistics().LiveBlocks, 40u);
+            EXPECT_EQ(pool.GetStatistics().ReservedBlocks, 48u);
+
+            list.pop_front();
+            EXPECT_EQ(pool.GetStatistics().LiveBlocks, 39u);
+
+            // Moving between lists of the same resource keeps the nodes.
+            std::pmr::list<u64> other(&pool);
+            other.splice(other.end(), list);
+            EXPECT_EQ(pool.GetStatistics().LiveBlocks, 39u);
+        }
+        EXPECT_EQ(pool.GetStatistics().LiveBlocks, 0u);
+    }
+
+    TEST(ObjectPool, CreateAndDestroyRunConstructorsAndDestructors) {
+        static u32 liveObjects = 0;
+        struct Tracked {
+            u64 Value;
+
+            explicit Tracked(const u64 value) : Value(value) {
+                liveObjects++;
+            }
+
+            ~Tracked() {
+                liveObjects--;
+            }
+        };
+
+        ObjectPool<Tracked> pool(8);
+        Tracked* first = pool.Create(1u);
+        Tracked* second = pool.Create(2u);
+        EXPECT_EQ(liveObjects, 2u);
+        EXPECT_EQ(first->Value, 1u);
+        EXPECT_EQ(second->Value, 2u);
+
+        pool.Destroy(first);
+        pool.Destroy(nullptr);
+        EXPECT_EQ(liveObjects, 1u);
+        EXPECT_EQ(pool.Create(3u), first);
+
+        EXPECT_EQ(pool.GetResource().GetStatistics().LiveBlocks, 2u);
+    }
+}
@@ -0,0 +1,287 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Math/BatchMath.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    // Not a multiple of BatchWidth, so the last block is partial.
+    constexpr u32 Count = 2 * BatchWidth + 5;
+
+    // Relative to the magnitude of the value, the levels with fused multiply-adds round differently than glm.
+    constexpr f32 Tolerance = 1e-5f;
+
+    std::vector<glm::vec3> MakeVectors(std::mt19937& random) {
+        std::uniform_real_distribution<f32> coordinate(-10.0f, 10.0f);
+
+        std::vector<glm::vec3> vectors(Count);
+        for (glm::vec3& vector : vectors) {
+            vector = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+        }
+
+        return vectors;
+    }
+
+    // Full matrices, or affine ones with a last row of (0, 0, 0, 1) for the transforms.
+    std::vector<glm::mat4> MakeMatrices(std::mt19937& random, const bool affine) {
+        std::uniform_real_distribution<f32> element(-2.0f, 2.0f);
+
+        std::vector<glm::mat4> matrices(Count);
+        for (glm::mat4& matrix : matrices) {
+            for (u32 column = 0; column < 4; column++) {
+                for (u32 row = 0; row < 4; row++) {
+                    matrix[column][row] = element(random);
+                }
+                if (affine) {
+                    matrix[column][3] = column == 3 ? 1.0f : 0.0f;
+                }
+            }
+        }
+
+        return matrices;
+    }
+
+    std::vector<Vec3x16> Pack(const std::span<const glm::vec3> values) {
+        std::vector<Vec3x16> blocks(GetBatchBlockCount(static_cast<u32>(values.size())));
+        PackVectors(values, blocks);
+        return blocks;
+    }
+
+    std::vector<Mat4x16> Pack(const std::span<const glm::mat4> values) {
+        std::vector<Mat4x16> blocks(GetBatchBlockCount(static_cast<u32>(values.size())));
+        PackMatrices(values, blocks);
+        return blocks;
+    }
+
+    std::vector<glm::vec3> Unpack(const std::span<const Vec3x16> blocks) {
+        std::vector<glm::vec3> values(Count);
+        UnpackVectors(blocks, values);
+        return values;
+    }
+
+    std::vector<glm::mat4> Unpack(const std::span<const Mat4x16> blocks) {
+        std::vector<glm::mat4> values(Count);
+        UnpackMatrices(blocks, values);
+        return values;
+    }
+
+    void ExpectNear(const f32 value, const f32 expected, const u32 index) {
+        EXPECT_NEAR(value, expected, Tolerance * std::max(1.0f, std::abs(expected))) << "Index " << index;
+    }
+
+    void ExpectNear(const std::span<const glm::vec3> values, const std::span<const glm::vec3> expected) {
+        ASSERT_EQ(values.size(), expected.size());
+        for (u32 i = 0; i < values.size(); i++) {
+            for (u32 coordinate = 0; coordinate < 3; coordinate++) {
+                ExpectNear(values[i][coordinate], expected[i][coordinate], i);
+            }
+        }
+    }
+
+    void ExpectNear(const std::span<const glm::mat4> values, const std::span<const glm::mat4> expected) {
+        ASSERT_EQ(values.size(), expected.size());
+        for (u32 i = 0; i < values.size(); i++) {
+            for (u32 column = 0; column < 4; column++) {
+                for (u32 row = 0; row < 4; row++) {
+                    ExpectNear(values[i][column][row], expected[i][column][row], i);
+                }
+            }
+        }
+    }
+
+    // Runs the test at the level of its parameter, skipped when the CPU or the build doesn't have it.
+    class BatchMathLevelTest : public testing::TestWithParam<SimdLevel> {
+        SimdLevel m_Previous = GetSimdLevel();
+
+    protected:
+        std::mt19937 m_Random{42};
+
+        void SetUp() override {
+            if (GetParam() > GetSupportedSimdLevel() || GetBatchKernels(GetParam()) == nullptr) {
+                GTEST_SKIP() << "Level not supported by this CPU or build.";
+            }
+
+            SetSimdLevel(GetParam());
+        }
+
+        void TearDown() override {
+            SetSimdLevel(m_Previous);
+        }
+    };
+
+    TEST_P(BatchMathLevelTest, PackingRoundTrips) {
+        const std::vector<glm::vec3> vectors = MakeVectors(m_Random);
+        const std::vector<glm::mat4> matrices = MakeMatrices(m_Random, false);
+
+        EXPECT_EQ(Unpack(Pack(vectors)), vectors);
+        EXPECT_EQ(Unpack(Pack(matrices)), matrices);
+    }
+
+    TEST_P(BatchMathLevelTest, TransformsMatchGlm) {
+        const std::vector<glm::vec3> points = MakeVectors(m_Random);
+        const std::vector<glm::mat4> matrices = MakeMatrices(m_Random, true);
+        const std::vector<Vec3x16> blocks = Pack(points);
+        std::vector<Vec3x16> result(blocks.size());
+
+        std::vector<glm::vec3> expected(Count);
+        for (u32 i = 0; i < Count; i++) {
+            expected[i] = glm::vec3(matrices[0] * glm::vec4(points[i], 1.0f));
+        }
+        TransformPoints(matrices[0], blocks, result);
+        ExpectNear(Unpack(result), expected);
+
+        for (u32 i = 0; i < Count; i++) {
+            expected[i] = glm::vec3(matrices[0] * glm::vec4(points[i], 0.0f));
+        }
+        TransformDirections(matrices[0], blocks, result);
+        ExpectNear(Unpack(result), expected);
+
+        for (u32 i = 0; i < Count; i++) {
+            expected[i] = glm::vec3(matrices[i] * glm::vec4(points[i], 1.0f));
+        }
+        TransformPoints(Pack(matrices), blocks, result);
+        ExpectNear(Unpack(result), expected);
+    }
+
+    TEST_P(BatchMathLevelTest, MatrixProductsMatchGlm) {
+        const std::vector<glm::mat4> lhs = MakeMatrices(m_Random, false);
+        const std::vector<glm::mat4> rhs = MakeMatrices(m_Random, false);
+        const std::vector<Mat4x16> rhsBlocks = Pack(rhs);
+        std::vector<Mat4x16> result(rhsBlocks.size());
+
+        std::vector<glm::mat4> expected(Count);
+        for (u32 i = 0; i < Count; i++) {
+            expected[i] = lhs[0] * rhs[i];
+        }
+        MultiplyMatrices(lhs[0], rhsBlocks, result);
+        ExpectNear(Unpack(result), expected);
+
+        for (u32 i = 0; i < Count; i++) {
+            expected[i] = lhs[i] * rhs[i];
+        }
+        MultiplyMatrices(Pack(lhs), rhsBlocks, result);
+        ExpectNear(Unpack(result), expected);
+    }
+
+    TEST_P(BatchMathLevelTest, VectorOperationsMatchGlm) {
+        const std::vector<glm::vec3> lhs = MakeVectors(m_Random);
+        const std::vector<glm::vec3> rhs = MakeVectors(m_Random);
+        const std::vector<Vec3x16> lhsBlocks = Pack(lhs);
+        const std::vector<Vec3x16> rhsBlocks = Pack(rhs);
+        std::vector<Vec3x16> result(lhsBlocks.size());
+
+        std::vector<glm::vec3> expected(Count);
+        for (u32 i = 0; i < Count; i++) {
+            expected[i] = glm::normalize(lhs[i]);
+        }
+        NormalizeVectors(lhsBlocks, result);
+        ExpectNear(Unpack(result), expected);
+
+        for (u32 i = 0; i < Count; i++) {
+            expected[i] = lhs[i] + rhs[i] * 0.25f;
+        }
+        MultiplyAddVectors(lhsBlocks, rhsBlocks, 0.25f, result);
+        ExpectNear(Unpack(result), expected);
+
+        for (u32 i = 0; i < Count; i++) {
+            expected[i] = glm::cross(lhs[i], rhs[i]);
+        }
+        CrossVectors(lhsBlocks, rhsBlocks, result);
+        ExpectNear(Unpack(result), expected);
+
+        std::vector<f32> dots(lhsBlocks.size() * BatchWidth);
+        DotVectors(lhsBlocks, rhsBlocks, dots);
+        for (u32 i = 0; i < Count; i++) {
+            ExpectNear(dots[i], glm::dot(lhs[i], rhs[i]), i);
+        }
+    }
+
+    // Every function gives the same results when it writes over its first input.
+    TEST_P(BatchMathLevelTest, ResultsMayOverwriteInputs) {
+        const std::vector<Vec3x16> vectors = Pack(MakeVectors(m_Random));
+        const std::vector<Vec3x16> others = Pack(MakeVectors(m_Random));
+        const std::vector<Mat4x16> matrices = Pack(MakeMatrices(m_Random, true));
+        const std::vector<Mat4x16> otherMatrices = Pack(MakeMatrices(m_Random, false));
+        const glm::mat4 matrix = MakeMatrices(m_Random, true)[0];
+
+        const auto expectVectors = [&](const auto& run) {
+            std::vector<Vec3x16> expected(vectors.size());
+            run(vectors, expected);
+
+            std::vector<Vec3x16> aliased = vectors;
+            run(aliased, aliased);
+            EXPECT_EQ(Unpack(aliased), Unpack(expected));
+        };
+
+        const auto expectMatrices = [&](const auto& run) {
+            std::vector<Mat4x16> expected(matrices.size());
+            run(matrices, expected);
+
+            std::vector<Mat4x16> aliased = matrices;
+            run(aliased, aliased);
+            EXPECT_EQ(Unpack(aliased), Unpack(expected));
+        };
+
+        expectVectors([&](const std::span<const Vec3x16> input, const std::span<Vec3x16> result) {
+            TransformPoints(matrix, input, result);
+        });
+        expectVectors([&](const std::span<const Vec3x16> input, const std::span<Vec3x16> result) {
+            TransformDirections(matrix, input, result);
+        });
+        expectVectors([&](const std::span<const Vec3x16> input, const std::span<Vec3x16> result) {
+            TransformPoints(matrices, input, result);
+        });
+        expectVectors([](const std::span<const Vec3x16> input, const std::span<Vec3x16> result) {
+            NormalizeVectors(input, result);
+        });
+        expectVectors([&](const std::span<const Vec3x16> input, const std::span<Vec3x16> result) {
+            MultiplyAddVectors(input, others, 0.25f, result);
+        });
+        expectVectors([&](const std::span<const Vec3x16> input, const std::span<Vec3x16> result) {
+            CrossVectors(input, others, result);
+        });
+        expectMatrices([&](const std::span<const Mat4x16> input, const std::span<Mat4x16> result) {
+            MultiplyMatrices(matrix, input, result);
+        });
+        expectMatrices([&](const std::span<const Mat4x16> input, const std::span<Mat4x16> result) {
+            MultiplyMatrices(input, otherMatrices, result);
+        });
+    }
+
+    // The pad lanes of the last block are zero vectors, they and real zero vectors must not turn into NaNs.
+    TEST_P(BatchMathLevelTest, NormalizedZeroVectorsStayZero) {
+        std::vector<glm::vec3> vectors = MakeVectors(m_Random);
+        vectors[3] = glm::vec3(0.0f);
+
+        std::vector<Vec3x16> blocks = Pack(vectors);
+        NormalizeVectors(blocks, blocks);
+
+        EXPECT_EQ(blocks[0].Get(3), glm::vec3(0.0f));
+        EXPECT_NEAR(glm::length(blocks[0].Get(4)), 1.0f, Tolerance);
+        for (u32 lane = Count % BatchWidth; lane < BatchWidth; lane++) {
+            EXPECT_EQ(blocks.back().Get(lane), glm::vec3(0.0f)) << "Lane " << lane;
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(BatchMath, BatchMathLevelTest,
+                             testing::Values(SimdLevel::Scalar, SimdLevel::Sse42, SimdLevel::Avx2, SimdLevel::Avx512),
+                             [](const testing::TestParamInfo<SimdLevel>& info) {
+                                 switch (info.param) {
+                                 case SimdLevel::Scalar:
+                                     return std::string("Scalar");
+                                 case SimdLevel::Sse42:
+                                     return std::string("Sse42");
+                                 case SimdLevel::Avx2:
+                                     return std::string("Avx2");
+                                 case SimdLevel::Avx512:
+                                     return std::string("Avx512");
+                                 }
+                                 return std::string("Unknown");
+                             });
+}
@@ -0,0 +1,227 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Mesh/MeshOptimizer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    using Triangle = std::array<f32, 9>;
+
+    // A grid of size * size quads in random order, every corner with its own vertex like an imported OBJ.
+    MeshData MakeShuffledGrid(const u32 size) {
+        std::vector<std::array<glm::vec2, 3>> triangles;
+        for (u32 y = 0; y < size; y++) {
+            for (u32 x = 0; x < size; x++) {
+                const glm::vec2 corner(static_cast<f32>(x), static_cast<f32>(y));
+                triangles.push_back({corner, corner + glm::vec2(1.0f, 0.0f), corner + glm::vec2(1.0f, 1.0f)});
+                triangles.push_back({corner, corner + glm::vec2(1.0f, 1.0f), corner + glm::vec2(0.0f, 1.0f)});
+            }
+        }
+
+        std::mt19937 random(42);
+        std::ranges::shuffle(triangles, random);
+
+        MeshData mesh;
+        for (const auto& triangle : triangles) {
+            for (const glm::vec2& position : triangle) {
+                mesh.Indices.push_back(mesh.GetVertexCount());
+                mesh.Vertices.push_back({glm::vec3(position.x, position.y, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f),
+                                         position / 64.0f});
+            }
+        }
+
+        return mesh;
+    }
+
+    // The positions of every triangle, each starting at its smallest corner so rotations compare equal. Sorted.
+    std::vector<Triangle> GetTriangles(const MeshData& mesh) {
+        std::vector<Triangle> triangles;
+        for (u32 i = 0; i < mesh.Indices.size(); i += 3) {
+            std::array<glm::vec3, 3> corners;
+            for (u32 j = 0; j < 3; j++) {
+                corners[j] = mesh.Vertices[mesh.Indices[i + j]].Position;
+            }
+
+            const auto lexicographic = [](const glm::vec3& a, const glm::vec3& b) {
+                return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+            };
+            std::ranges::rotate(corners, std::ranges::min_element(corners, lexicographic));
+
+            Triangle& triangle = triangles.emplace_back();
+            for (u32 j = 0; j < 3; j++) {
+                triangle[j * 3 + 0] = corners[j].x;
+                triangle[j * 3 + 1] = corners[j].y;
+                triangle[j * 3 + 2] = corners[j].z;
+            }
+        }
+
+        std::ranges::sort(triangles);
+        return triangles;
+    }
+
+    // Runs every test without a job system (0) and with a job system of 4 workers.
+    class MeshOptimizerTest : public testing::TestWithParam<u32> {
+    protected:
+        std::unique_ptr<JobSystem> m_Jobs;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+            if (GetParam() > 0) {
+                m_Jobs = std::make_unique<JobSystem>(GetParam());
+            }
+        }
+
+        void TearDown() override {
+            m_Jobs.reset();
+            Logger::Shutdown();
+        }
+
+        [[nodiscard]] MeshOptimizerSettings MakeSettings() const {
+            MeshOptimizerSettings settings;
+            settings.Jobs = m_Jobs.get();
+            settings.ChunkTriangleCount = 1000; // Several chunks with a job system.
+            return settings;
+        }
+    };
+
+    TEST_P(MeshOptimizerTest, KeepsEveryTriangleAndImprovesTheCaches) {
+        constexpr u32 GridSize = 64;
+        MeshData mesh = MakeShuffledGrid(GridSize);
+        const std::vector<Triangle> triangles = GetTriangles(mesh);
+
+        const MeshOptimizationReport report = OptimizeMesh(mesh, MakeSettings());
+
+        EXPECT_EQ(GetTriangles(mesh), triangles);
+        EXPECT_EQ(report.SourceVertexCount, GridSize * GridSize * 6);
+        EXPECT_EQ(report.VertexCount, (GridSize + 1) * (GridSize + 1));
+        EXPECT_EQ(mesh.GetVertexCount(), report.VertexCount);
+
+        EXPECT_LT(report.CacheAfter.Acmr, report.CacheBefore.Acmr);
+        EXPECT_LT(report.CacheAfter.Acmr, 1.0f);
+        // The duplicated corners were fetched in order, the shared vertices are fewer bytes but not quite in order.
+        EXPECT_LT(report.FetchAfter.BytesFetched, report.FetchBefore.BytesFetched);
+        EXPECT_LT(report.FetchAfter.Overfetch, 1.5f);
+
+        // Vertices come in order of first use.
+        u32 nextVertex = 0;
+        for (const u32 index : mesh.Indices) {
+            ASSERT_LE(index, nextVertex);
+            nextVertex = std::max(nextVertex, index + 1);
+        }
+        EXPECT_EQ(nextVertex, mesh.GetVertexCount());
+    }
+
+    TEST_P(MeshOptimizerTest, LeavesEmptyMeshesAlone) {
+        MeshData mesh;
+        MeshOptimizationReport report = OptimizeMesh(mesh, MakeSettings());
+
+        EXPECT_TRUE(mesh.Vertices.empty());
+        EXPECT_TRUE(mesh.Indices.empty());
+        EXPECT_EQ(report.VertexCount, 0u);
+        EXPECT_EQ(report.TriangleCount, 0u);
+
+        // Vertices without any triangle, nothing uses them so nothing is optimized.
+        mesh.Vertices.resize(3);
+        report = OptimizeMesh(mesh, MakeSettings());
+
+        EXPECT_EQ(mesh.GetVertexCount(), 3u);
+        EXPECT_EQ(report.VertexCount, 3u);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(MeshOptimizer, MeshOptimizerTest, testing::Values(0u, 4u),
+                             [](const testing::TestParamInfo<u32>& info) {
+                                 return info.param == 0 ? std::string("NoJobSystem")
+                                                        : fmt::format("{0}Workers", info.param);
+                             });
+
+    class ObjTest : public testing::Test {
+    protected:
+        std::filesystem::path m_Path;
+        std::vector<std::string> m_Errors;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+            Logger::AddEngineCallback([this](const spdlog::level::level_enum& level, const std::string& message) {
+                if (level == spdlog::level::err) {
+                    m_Errors.push_back(message);
+                }
+            });
+
+            m_Path = std::filesystem::temp_directory_path() / "FlashlightObjTests.obj";
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(m_Path);
+            Logger::Shutdown();
+        }
+
+        void Write(const std::string_view content) const {
+            std::ofstream(m_Path, std::ios::binary) << content;
+        }
+    };
+
+    TEST_F(ObjTest, ImportsFacesAndSplitsPolygons) {
+        Write("# A quad and a triangle using negative indices.\n"
+              "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+              "vn 0 0 1\n"
+              "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+              "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+              "f -4//-1 -2//-1 -1//-1\n");
+
+        MeshData mesh;
+        ASSERT_TRUE(ImportObj(m_Path, mesh));
+
+        ASSERT_EQ(mesh.GetVertexCount(), 7u);
+        EXPECT_EQ(mesh.Indices, (std::vector<u32>{0, 1, 2, 0, 2, 3, 4, 5, 6}));
+        EXPECT_EQ(mesh.Vertices[2].Position, glm::vec3(1.0f, 1.0f, 0.0f));
+        EXPECT_EQ(mesh.Vertices[2].TexCoord, glm::vec2(1.0f, 1.0f));
+        EXPECT_EQ(mesh.Vertices[2].Normal, glm::vec3(0.0f, 0.0f, 1.0f));
+        EXPECT_EQ(mesh.Vertices[5].Position, glm::vec3(1.0f, 1.0f, 0.0f));
+        EXPECT_EQ(mesh.Vertices[5].TexCoord, glm::vec2(0.0f));
+        EXPECT_TRUE(m_Errors.empty());
+    }
+
+    TEST_F(ObjTest, ExportedMeshesImportBack) {
+        MeshData mesh = MakeShuffledGrid(8);
+        OptimizeMesh(mesh);
+        ASSERT_TRUE(ExportObj(m_Path, mesh));
+
+        MeshData imported;
+        ASSERT_TRUE(ImportObj(m_Path, imported));
+        EXPECT_EQ(GetTriangles(imported), GetTriangles(mesh));
+    }
+
+    TEST_F(ObjTest, ImportsFilesWithoutFacesAsEmptyMeshes) {
+        MeshData mesh = MakeShuffledGrid(2);
+
+        Write("");
+        ASSERT_TRUE(ImportObj(m_Path, mesh));
+        EXPECT_TRUE(mesh.Vertices.empty());
+        EXPECT_TRUE(mesh.Indices.empty());
+
+        Write("v 0 0 0\nv 1 0 0\nv 1 1 0\n");
+        ASSERT_TRUE(ImportObj(m_Path, mesh));
+        EXPECT_TRUE(mesh.Vertices.empty());
+
+        OptimizeMesh(mesh);
+        EXPECT_TRUE(mesh.Vertices.empty());
+        EXPECT_TRUE(m_Errors.empty());
+    }
+
+    TEST_F(ObjTest, LogsWhyAnImportFailed) {
+        MeshData mesh;
+        EXPECT_FALSE(ImportObj(m_Path / "Missing.obj", mesh));
+
+        ASSERT_FALSE(m_Errors.empty());
+        EXPECT_NE(m_Errors.back().find("Missing.obj"), std::string::npos);
+    }
+}
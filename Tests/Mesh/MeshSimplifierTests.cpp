@@ -0,0 +1,250 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Mesh/MeshSimplifier.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numbers>
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    /*
+     * A UV sphere with bumps, some noise and spikes on about one vertex in a hundred, so the simplifier has real
+     * curvature to trade. The first column of vertices is repeated at the end with u = 1, a seam like in authored
+     * meshes.
+     */
+    MeshData MakeBumpySphere(const u32 segments, const f32 noise, const f32 spikeHeight = 0.0f) {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<f32> offset(-noise, noise);
+
+        MeshData mesh;
+        for (u32 ring = 0; ring <= segments; ring++) {
+            const f32 v = static_cast<f32>(ring) / static_cast<f32>(segments);
+            const f32 theta = std::numbers::pi_v<f32> * v;
+            for (u32 segment = 0; segment <= segments; segment++) {
+                const f32 u = static_cast<f32>(segment) / static_cast<f32>(segments);
+                const f32 phi = 2.0f * std::numbers::pi_v<f32> * u;
+
+                // The seam and the poles keep their exact position, their duplicates must line up.
+                const bool shared = segment == segments || ring == 0 || ring == segments;
+                const bool spike = !shared && (ring * 7 + segment * 13) % 97 == 0;
+                const f32 radius = 1.0f + 0.2f * std::sin(5.0f * phi) * std::sin(3.0f * theta) +
+                                   (shared ? 0.0f : offset(random)) + (spike ? spikeHeight : 0.0f);
+                const glm::vec3 position(radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta),
+                                         radius * std::sin(theta) * std::sin(phi));
+                mesh.Vertices.push_back({position, glm::normalize(position), glm::vec2(u, v)});
+            }
+        }
+
+        for (u32 ring = 0; ring < segments; ring++) {
+            for (u32 segment = 0; segment < segments; segment++) {
+                const u32 a = ring * (segments + 1) + segment;
+                const u32 b = a + 1;
+                const u32 c = a + segments + 1;
+                const u32 d = c + 1;
+                mesh.Indices.insert(mesh.Indices.end(), {a, c, b, b, c, d});
+            }
+        }
+
+        return mesh;
+    }
+
+    glm::vec3 GetClosestPoint(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+        // Closest point on the plane if it is inside the triangle, otherwise on the closest edge.
+        const glm::vec3 normal = glm::normalize(glm::cross(b - a, c - a));
+        const glm::vec3 projected = p - normal * glm::dot(p - a, normal);
+
+        const std::array<glm::vec3, 3> corners = {a, b, c};
+        bool inside = true;
+        for (u32 edge = 0; edge < 3; edge++) {
+            const glm::vec3& start = corners[edge];
+            const glm::vec3& end = corners[(edge + 1) % 3];
+            inside &= glm::dot(glm::cross(end - start, projected - start), normal) >= 0.0f;
+        }
+        if (inside) {
+            return projected;
+        }
+
+        glm::vec3 best = a;
+        for (u32 edge = 0; edge < 3; edge++) {
+            const glm::vec3& start = corners[edge];
+            const glm::vec3 direction = corners[(edge + 1) % 3] - start;
+            const f32 t = std::clamp(glm::dot(p - start, direction) / glm::dot(direction, direction), 0.0f, 1.0f);
+            const glm::vec3 point = start + direction * t;
+            if (glm::distance(p, point) < glm::distance(p, best)) {
+                best = point;
+            }
+        }
+
+        return best;
+    }
+
+    // Brute force over points spread inside every triangle of from, not only its vertices and centers.
+    f32 MeasureDenseDistance(const std::span<const u32> from, const std::span<const u32> to,
+                             const std::span<const MeshVertex> vertices) {
+        constexpr u32 Steps = 3;
+
+        f32 worst = 0.0f;
+        for (u64 i = 0; i < from.size(); i += 3) {
+            for (u32 x = 0; x <= Steps; x++) {
+                for (u32 y = 0; x + y <= Steps; y++) {
+                    const f32 u = static_cast<f32>(x) / Steps;
+                    const f32 w = static_cast<f32>(y) / Steps;
+                    const glm::vec3 p = vertices[from[i]].Position * (1.0f - u - w) +
+                                        vertices[from[i + 1]].Position * u + vertices[from[i + 2]].Position * w;
+
+                    f32 best = std::numeric_limits<f32>::max();
+                    for (u64 j = 0; j < to.size(); j += 3) {
+                        const glm::vec3 closest = GetClosestPoint(p, vertices[to[j]].Position,
+                                                                  vertices[to[j + 1]].Position,
+                                                                  vertices[to[j + 2]].Position);
+                        best = std::min(best, glm::distance(p, closest));
+                    }
+                    worst = std::max(worst, best);
+                }
+            }
+        }
+
+        return worst;
+    }
+
+    class MeshSimplifierTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+        }
+
+        void TearDown() override {
+            Logger::Shutdown();
+        }
+    };
+
+    TEST_F(MeshSimplifierTest, ReachesTheTargetWithoutTouchingTheSeam) {
+        const MeshData sphere = MakeBumpySphere(32, 0.0f);
+        const auto vertexCount = static_cast<u32>(sphere.Vertices.size());
+
+        SimplifySettings settings;
+        settings.TargetIndexCount = static_cast<u32>(sphere.Indices.size() / 4 / 3 * 3);
+        settings.TargetError = 1.0f;
+
+        std::vector<u32> simplified(sphere.Indices.size());
+        const SimplifyResult result = SimplifyMesh(simplified, sphere.Indices, sphere.Vertices, settings);
+        simplified.resize(result.IndexCount);
+
+        EXPECT_LE(result.IndexCount, settings.TargetIndexCount);
+        EXPECT_GT(result.IndexCount, 0u);
+        EXPECT_GT(result.EstimatedError, 0.0f);
+
+        // Every vertex of the seam columns is still used, they can't move.
+        std::vector<u8> used(vertexCount, 0);
+        for (const u32 index : simplified) {
+            ASSERT_LT(index, vertexCount);
+            used[index] = 1;
+        }
+        for (u32 ring = 1; ring < 32; ring++) {
+            EXPECT_TRUE(used[ring * 33]) << "Ring " << ring;
+            EXPECT_TRUE(used[ring * 33 + 32]) << "Ring " << ring;
+        }
+
+        // No triangle lost a corner.
+        for (u32 i = 0; i < simplified.size(); i += 3) {
+            EXPECT_NE(simplified[i], simplified[i + 1]);
+            EXPECT_NE(simplified[i + 1], simplified[i + 2]);
+            EXPECT_NE(simplified[i], simplified[i + 2]);
+        }
+    }
+
+    TEST_F(MeshSimplifierTest, StopsAtTheTargetError) {
+        const MeshData sphere = MakeBumpySphere(32, 0.0f);
+
+        std::vector<u32> simplified(sphere.Indices.size());
+        SimplifySettings settings;
+        settings.TargetError = 0.0f;
+
+        // Curved everywhere, nothing collapses for free.
+        const SimplifyResult exact = SimplifyMesh(simplified, sphere.Indices, sphere.Vertices, settings);
+        EXPECT_EQ(exact.IndexCount, sphere.Indices.size());
+        EXPECT_EQ(exact.EstimatedError, 0.0f);
+
+        settings.TargetError = 0.005f;
+        const SimplifyResult coarse = SimplifyMesh(simplified, sphere.Indices, sphere.Vertices, settings);
+        EXPECT_LT(coarse.IndexCount, sphere.Indices.size());
+        EXPECT_LE(coarse.EstimatedError, settings.TargetError);
+    }
+
+    /*
+     * The selector trusts these errors, the surface must never be further from the source than they say. Spikes
+     * move far when they go but make up little of the area, the estimates of the quadrics miss them.
+     */
+    TEST_F(MeshSimplifierTest, LodErrorsBoundTheDistanceToTheSource) {
+        for (const auto [noise, spikeHeight] : {std::pair(0.0f, 0.0f), std::pair(0.02f, 0.0f), std::pair(0.0f, 0.3f),
+                                                std::pair(0.01f, 0.3f)}) {
+            const MeshData sphere = MakeBumpySphere(12, noise, spikeHeight);
+
+            LodChainSettings settings;
+            settings.MaxLodCount = 8;
+            settings.MinTriangleCount = 16;
+            const MeshLodChain chain = BuildLodChain(sphere, settings);
+
+            ASSERT_GE(chain.GetLodCount(), 3u) << "Noise " << noise << ", spikes " << spikeHeight;
+            EXPECT_EQ(chain.Lods[0].Error, 0.0f);
+            EXPECT_EQ(chain.GetIndices(0).size(), sphere.Indices.size());
+
+            for (u32 lod = 1; lod < chain.GetLodCount(); lod++) {
+                const std::span<const u32> indices = chain.GetIndices(lod);
+                EXPECT_LT(indices.size(), chain.GetIndices(lod - 1).size());
+
+                const f32 distance = std::max(MeasureDenseDistance(chain.GetIndices(0), indices, sphere.Vertices),
+                                              MeasureDenseDistance(indices, chain.GetIndices(0), sphere.Vertices));
+                EXPECT_GT(distance, 0.0f);
+                EXPECT_LE(distance, chain.Lods[lod].Error)
+                    << "Noise " << noise << ", spikes " << spikeHeight << ", LOD " << lod;
+            }
+        }
+    }
+
+    TEST_F(MeshSimplifierTest, ChainsAreTheSameWithJobs) {
+        std::vector<MeshData> meshes;
+        for (u32 mesh = 0; mesh < 6; mesh++) {
+            meshes.push_back(MakeBumpySphere(16 + mesh * 4, 0.01f));
+        }
+
+        std::vector<MeshLodChain> expected(meshes.size());
+        BuildLodChains(meshes, expected);
+
+        JobSystem jobSystem(4);
+        std::vector<MeshLodChain> chains(meshes.size());
+        BuildLodChains(meshes, chains, {}, &jobSystem);
+
+        for (u32 mesh = 0; mesh < meshes.size(); mesh++) {
+            EXPECT_EQ(chains[mesh].Indices, expected[mesh].Indices) << "Mesh " << mesh;
+            ASSERT_EQ(chains[mesh].GetLodCount(), expected[mesh].GetLodCount()) << "Mesh " << mesh;
+            for (u32 lod = 0; lod < chains[mesh].GetLodCount(); lod++) {
+                EXPECT_EQ(chains[mesh].Lods[lod].Error, expected[mesh].Lods[lod].Error);
+            }
+        }
+    }
+
+    TEST_F(MeshSimplifierTest, SelectorPicksTheCoarsestLodUnderThePixelError) {
+        MeshLodChain chain;
+        chain.Lods = {{0, 0, 0.0f}, {0, 0, 0.01f}, {0, 0, 0.1f}};
+
+        // A 90 degree field of view over 1000 pixels: 500 pixels per unit at a distance of one.
+        const LodSelector selector(1000, std::numbers::pi_v<f32> / 2.0f, 1.0f);
+        EXPECT_NEAR(selector.GetScreenError(0.01f, 1.0f), 5.0f, 1e-4f);
+
+        EXPECT_EQ(selector.Select(chain, 1.0f), 0u);
+        EXPECT_EQ(selector.Select(chain, 6.0f), 1u);
+        EXPECT_EQ(selector.Select(chain, 60.0f), 2u);
+
+        // Scaling the model up scales its errors.
+        EXPECT_EQ(selector.Select(chain, 60.0f, 2.0f), 1u);
+        EXPECT_EQ(selector.Select(chain, 0.0f), 0u);
+    }
+}
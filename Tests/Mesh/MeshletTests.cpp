@@ -0,0 +1,235 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Mesh/Meshlet.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numbers>
+
+using namespace Flashlight;
+
+namespace {
+    struct IndexedPositions {
+        std::vector<glm::vec3> Positions;
+        std::vector<u32> Indices;
+    };
+
+    // A UV sphere, its vertices are shared by up to six triangles so the vertex limit fills meshlets first.
+    IndexedPositions MakeSphere(const u32 segments) {
+        IndexedPositions mesh;
+        for (u32 ring = 0; ring <= segments; ring++) {
+            const f32 theta = std::numbers::pi_v<f32> * static_cast<f32>(ring) / static_cast<f32>(segments);
+            for (u32 segment = 0; segment < segments; segment++) {
+                const f32 phi = 2.0f * std::numbers::pi_v<f32> * static_cast<f32>(segment) / static_cast<f32>(segments);
+                mesh.Positions.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                            std::sin(theta) * std::sin(phi));
+            }
+        }
+
+        for (u32 ring = 0; ring < segments; ring++) {
+            for (u32 segment = 0; segment < segments; segment++) {
+                const u32 a = ring * segments + segment;
+                const u32 b = ring * segments + (segment + 1) % segments;
+                const u32 c = a + segments;
+                const u32 d = b + segments;
+                mesh.Indices.insert(mesh.Indices.end(), {a, c, b, b, c, d});
+            }
+        }
+
+        return mesh;
+    }
+
+    // Every triangle between a dozen points on a circle, 220 triangles over 12 vertices: only the triangle limit binds.
+    IndexedPositions MakeDenseFan() {
+        constexpr u32 pointCount = 12;
+
+        IndexedPositions mesh;
+        for (u32 point = 0; point < pointCount; point++) {
+            const f32 angle = 2.0f * std::numbers::pi_v<f32> * static_cast<f32>(point) / pointCount;
+            mesh.Positions.emplace_back(std::cos(angle), std::sin(angle), 0.1f * static_cast<f32>(point % 3));
+        }
+
+        for (u32 a = 0; a < pointCount; a++) {
+            for (u32 b = a + 1; b < pointCount; b++) {
+                for (u32 c = b + 1; c < pointCount; c++) {
+                    mesh.Indices.insert(mesh.Indices.end(), {a, b, c});
+                }
+            }
+        }
+
+        return mesh;
+    }
+
+    MeshletMesh Build(const IndexedPositions& mesh, const MeshletBuildSettings& settings = {}) {
+        MeshletMesh meshlets;
+        BuildMeshlets(meshlets, mesh.Indices, &mesh.Positions[0].x, static_cast<u32>(mesh.Positions.size()),
+                      sizeof(glm::vec3), settings);
+        return meshlets;
+    }
+
+    // Triangles as mesh vertex indices, each rotated to start at its smallest index so the winding is kept.
+    std::vector<std::array<u32, 3>> SortTriangles(std::vector<std::array<u32, 3>> triangles) {
+        for (std::array<u32, 3>& triangle : triangles) {
+            std::ranges::rotate(triangle, std::ranges::min_element(triangle));
+        }
+
+        std::ranges::sort(triangles);
+        return triangles;
+    }
+
+    std::vector<std::array<u32, 3>> GetTriangles(const std::vector<u32>& indices) {
+        std::vector<std::array<u32, 3>> triangles;
+        for (u64 i = 0; i < indices.size(); i += 3) {
+            triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+        }
+
+        return SortTriangles(std::move(triangles));
+    }
+
+    std::vector<std::array<u32, 3>> GetTriangles(const MeshletMesh& meshlets) {
+        std::vector<std::array<u32, 3>> triangles;
+        for (const Meshlet& meshlet : meshlets.Meshlets) {
+            const std::span<const u32> vertices = meshlets.GetVertices(meshlet);
+            const std::span<const u8> local = meshlets.GetTriangles(meshlet);
+            for (u32 triangle = 0; triangle < meshlet.TriangleCount; triangle++) {
+                triangles.push_back({vertices[local[triangle * 3]], vertices[local[triangle * 3 + 1]],
+                                     vertices[local[triangle * 3 + 2]]});
+            }
+        }
+
+        return SortTriangles(std::move(triangles));
+    }
+
+    void ExpectWithinLimits(const MeshletMesh& meshlets, const MeshletBuildSettings& settings) {
+        ASSERT_EQ(meshlets.Bounds.size(), meshlets.Meshlets.size());
+
+        for (const Meshlet& meshlet : meshlets.Meshlets) {
+            EXPECT_GT(meshlet.TriangleCount, 0u);
+            EXPECT_LE(meshlet.VertexCount, settings.MaxVertexCount);
+            EXPECT_LE(meshlet.TriangleCount, settings.MaxTriangleCount);
+            EXPECT_EQ(meshlet.TriangleOffset % 4, 0u);
+            ASSERT_LE(meshlet.VertexOffset + meshlet.VertexCount, meshlets.Vertices.size());
+            ASSERT_LE(meshlet.TriangleOffset + meshlet.TriangleCount * 3, meshlets.Triangles.size());
+
+            for (const u8 index : meshlets.GetTriangles(meshlet)) {
+                EXPECT_LT(index, meshlet.VertexCount);
+            }
+        }
+    }
+
+    class MeshletTest : public testing::Test {
+    protected:
+        std::filesystem::path m_Path = std::filesystem::temp_directory_path() / "FlashlightMeshletTests.flml";
+        std::vector<std::string> m_Errors;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+            Logger::AddEngineCallback([this](const spdlog::level::level_enum& level, const std::string& message) {
+                if (level == spdlog::level::err) {
+                    m_Errors.push_back(message);
+                }
+            });
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(m_Path);
+            Logger::Shutdown();
+        }
+    };
+
+    TEST_F(MeshletTest, MeshletsStayWithinTheVertexLimit) {
+        const IndexedPositions mesh = MakeSphere(48);
+        const MeshletMesh meshlets = Build(mesh);
+        ExpectWithinLimits(meshlets, {});
+
+        // Vertices run out long before triangles on a sphere, so meshlets get filled up to the vertex limit.
+        EXPECT_TRUE(std::ranges::any_of(meshlets.Meshlets, [](const Meshlet& meshlet) {
+            return meshlet.VertexCount == MeshletMaxVertexCount;
+        }));
+
+        MeshletBuildSettings settings;
+        settings.MaxVertexCount = 16;
+        settings.MaxTriangleCount = 20;
+        ExpectWithinLimits(Build(mesh, settings), settings);
+    }
+
+    TEST_F(MeshletTest, MeshletsStayWithinTheTriangleLimit) {
+        const IndexedPositions mesh = MakeDenseFan();
+        const MeshletMesh meshlets = Build(mesh);
+        ExpectWithinLimits(meshlets, {});
+
+        ASSERT_EQ(meshlets.GetMeshletCount(), 2u);
+        EXPECT_EQ(meshlets.Meshlets[0].TriangleCount, MeshletMaxTriangleCount);
+        EXPECT_EQ(meshlets.Meshlets[1].TriangleCount, mesh.Indices.size() / 3 - MeshletMaxTriangleCount);
+    }
+
+    TEST_F(MeshletTest, EveryTriangleIsKeptWithAndWithoutJobs) {
+        const IndexedPositions mesh = MakeSphere(48);
+        const std::vector<std::array<u32, 3>> expected = GetTriangles(mesh.Indices);
+
+        JobSystem jobSystem(4);
+        for (JobSystem* jobs : {static_cast<JobSystem*>(nullptr), &jobSystem}) {
+            MeshletBuildSettings settings;
+            settings.Jobs = jobs;
+
+            EXPECT_EQ(GetTriangles(Build(mesh, settings)), expected);
+        }
+
+        EXPECT_EQ(GetTriangles(Build(MakeDenseFan())), GetTriangles(MakeDenseFan().Indices));
+    }
+
+    TEST_F(MeshletTest, SavedMeshletsLoadBack) {
+        const MeshletMesh meshlets = Build(MakeSphere(32));
+        ASSERT_TRUE(SaveMeshlets(m_Path, meshlets));
+
+        MeshletMesh loaded;
+        ASSERT_TRUE(LoadMeshlets(m_Path, loaded));
+
+        ASSERT_EQ(loaded.GetMeshletCount(), meshlets.GetMeshletCount());
+        const u64 meshletsSize = meshlets.Meshlets.size() * sizeof(Meshlet);
+        const u64 boundsSize = meshlets.Bounds.size() * sizeof(MeshletBounds);
+        EXPECT_EQ(std::memcmp(loaded.Meshlets.data(), meshlets.Meshlets.data(), meshletsSize), 0);
+        EXPECT_EQ(std::memcmp(loaded.Bounds.data(), meshlets.Bounds.data(), boundsSize), 0);
+        EXPECT_EQ(loaded.Vertices, meshlets.Vertices);
+        EXPECT_EQ(loaded.Triangles, meshlets.Triangles);
+        EXPECT_TRUE(m_Errors.empty());
+    }
+
+    TEST_F(MeshletTest, LoadRejectsTruncatedFilesAndOtherVersions) {
+        const MeshletMesh meshlets = Build(MakeSphere(16));
+        MeshletMesh loaded;
+
+        // Cut in the triangles, then in the header.
+        ASSERT_TRUE(SaveMeshlets(m_Path, meshlets));
+        std::filesystem::resize_file(m_Path, std::filesystem::file_size(m_Path) - 1);
+        EXPECT_FALSE(LoadMeshlets(m_Path, loaded));
+        ASSERT_EQ(m_Errors.size(), 1u);
+        EXPECT_NE(m_Errors.back().find("size"), std::string::npos);
+
+        std::filesystem::resize_file(m_Path, sizeof(MeshletFileHeader) / 2);
+        EXPECT_FALSE(LoadMeshlets(m_Path, loaded));
+        ASSERT_EQ(m_Errors.size(), 2u);
+        EXPECT_NE(m_Errors.back().find("too small"), std::string::npos);
+
+        // A complete file of the next version.
+        ASSERT_TRUE(SaveMeshlets(m_Path, meshlets));
+        {
+            std::fstream file(m_Path, std::ios::binary | std::ios::in | std::ios::out);
+            const u32 version = MeshletFileVersion + 1;
+            file.seekp(offsetof(MeshletFileHeader, Version));
+            file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        }
+        EXPECT_FALSE(LoadMeshlets(m_Path, loaded));
+        ASSERT_EQ(m_Errors.size(), 3u);
+        EXPECT_NE(m_Errors.back().find(fmt::format("version {0}", MeshletFileVersion + 1)), std::string::npos);
+
+        EXPECT_TRUE(loaded.Meshlets.empty());
+    }
+}
@@ -0,0 +1,314 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Renderer/Culling.hpp>
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    // Not a multiple of any register width, so every level has a partial last block.
+    constexpr u32 ObjectCount = 10'007;
+
+    // Objects closer than this to a plane may land on either side depending on rounding, they aren't checked.
+    constexpr f64 BoundaryMargin = 1e-3;
+
+    glm::mat4 MakeViewProjection() {
+        return glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f) *
+               glm::lookAtRH(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    glm::vec3 MakeCenter(std::mt19937& random) {
+        std::uniform_real_distribution<f32> position(-200.0f, 200.0f);
+        return {position(random), position(random), position(random)};
+    }
+
+    BoundingSpheres MakeSpheres() {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<f32> radius(0.5f, 5.0f);
+
+        BoundingSpheres spheres;
+        for (u32 i = 0; i < ObjectCount; i++) {
+            spheres.Add(MakeCenter(random), radius(random));
+        }
+
+        return spheres;
+    }
+
+    BoundingBoxes MakeBoxes() {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<f32> extent(0.5f, 5.0f);
+
+        BoundingBoxes boxes;
+        for (u32 i = 0; i < ObjectCount; i++) {
+            boxes.Add(MakeCenter(random), glm::vec3(extent(random), extent(random), extent(random)));
+        }
+
+        return boxes;
+    }
+
+    // Smallest signed distance of the object to a plane, in double precision. Visible when it isn't negative.
+    f64 GetReferenceDistance(const Frustum& frustum, const BoundingSpheres& spheres, const u32 index) {
+        f64 distance = std::numeric_limits<f64>::max();
+        for (const glm::vec4& plane : frustum.Planes) {
+            distance = std::min(distance, static_cast<f64>(plane.x) * spheres.CenterX[index] +
+                                              static_cast<f64>(plane.y) * spheres.CenterY[index] +
+                                              static_cast<f64>(plane.z) * spheres.CenterZ[index] + plane.w +
+                                              spheres.Radius[index]);
+        }
+
+        return distance;
+    }
+
+    f64 GetReferenceDistance(const Frustum& frustum, const BoundingBoxes& boxes, const u32 index) {
+        f64 distance = std::numeric_limits<f64>::max();
+        for (const glm::vec4& plane : frustum.Planes) {
+            distance = std::min(distance, static_cast<f64>(plane.x) * boxes.CenterX[index] +
+                                              static_cast<f64>(plane.y) * boxes.CenterY[index] +
+                                              static_cast<f64>(plane.z) * boxes.CenterZ[index] + plane.w +
+                                              std::abs(static_cast<f64>(plane.x)) * boxes.ExtentX[index] +
+                                              std::abs(static_cast<f64>(plane.y)) * boxes.ExtentY[index] +
+                                              std::abs(static_cast<f64>(plane.z)) * boxes.ExtentZ[index]);
+        }
+
+        return distance;
+    }
+
+    // Checks the indices written for [begin, end): increasing, inside the range, and matching the reference.
+    template <typename Bounds>
+    void ExpectMatchesReference(const Frustum& frustum, const Bounds& bounds, const u32 begin, const u32 end,
+                                const std::span<const u32> visible) {
+        std::vector<u8> isVisible(bounds.GetCount(), 0);
+        for (u32 i = 0; i < visible.size(); i++) {
+            ASSERT_GE(visible[i], begin);
+            ASSERT_LT(visible[i], end);
+            if (i > 0) {
+                ASSERT_LT(visible[i - 1], visible[i]);
+            }
+            isVisible[visible[i]] = 1;
+        }
+
+        for (u32 index = begin; index < end; index++) {
+            const f64 distance = GetReferenceDistance(frustum, bounds, index);
+            if (std::abs(distance) >= BoundaryMargin) {
+                ASSERT_EQ(isVisible[index] != 0, distance >= 0.0) << "Object " << index << ", distance " << distance;
+            }
+        }
+    }
+
+    // Runs the test at the level of its parameter, skipped when the CPU or the build doesn't have it.
+    class CullingLevelTest : public testing::TestWithParam<SimdLevel> {
+        SimdLevel m_Previous = GetSimdLevel();
+
+    protected:
+        void SetUp() override {
+            if (GetParam() > GetSupportedSimdLevel() || GetCullingKernels(GetParam()) == nullptr) {
+                GTEST_SKIP() << "Level not supported by this CPU or build.";
+            }
+
+            SetSimdLevel(GetParam());
+        }
+
+        void TearDown() override {
+            SetSimdLevel(m_Previous);
+        }
+    };
+
+    TEST_P(CullingLevelTest, SpheresMatchReference) {
+        const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+        const BoundingSpheres spheres = MakeSpheres();
+
+        // Ranges starting and ending off a register boundary.
+        for (const auto [begin, end] : {std::pair(0u, ObjectCount), std::pair(3u, ObjectCount - 5)}) {
+            std::vector<u32> visible(end - begin);
+            const u32 count = CullSpheres(frustum, spheres, begin, end, visible.data());
+
+            ExpectMatchesReference(frustum, spheres, begin, end, std::span(visible.data(), count));
+
+            // The scene has both outcomes.
+            EXPECT_GT(count, 0u);
+            EXPECT_LT(count, end - begin);
+        }
+    }
+
+    TEST_P(CullingLevelTest, BoxesMatchReference) {
+        const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+        const BoundingBoxes boxes = MakeBoxes();
+
+        for (const auto [begin, end] : {std::pair(0u, ObjectCount), std::pair(3u, ObjectCount - 5)}) {
+            std::vector<u32> visible(end - begin);
+            const u32 count = CullBoxes(frustum, boxes, begin, end, visible.data());
+
+            ExpectMatchesReference(frustum, boxes, begin, end, std::span(visible.data(), count));
+            EXPECT_GT(count, 0u);
+            EXPECT_LT(count, end - begin);
+        }
+    }
+
+    // Every length from empty to a few registers, so each level runs its tail alone and after full registers.
+    TEST_P(CullingLevelTest, ShortRangesMatchReference) {
+        const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+        const BoundingSpheres spheres = MakeSpheres();
+
+        u32 visibleCount = 0;
+        for (u32 begin = 0; begin < 2000; begin += 50) {
+            for (u32 length = 0; length <= 40; length++) {
+                std::vector<u32> visible(length);
+                const u32 count = CullSpheres(frustum, spheres, begin, begin + length, visible.data());
+
+                ExpectMatchesReference(frustum, spheres, begin, begin + length, std::span(visible.data(), count));
+                visibleCount += count;
+            }
+        }
+
+        EXPECT_GT(visibleCount, 0u);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Culling, CullingLevelTest,
+                             testing::Values(SimdLevel::Scalar, SimdLevel::Sse42, SimdLevel::Avx2, SimdLevel::Avx512),
+                             [](const testing::TestParamInfo<SimdLevel>& info) {
+                                 switch (info.param) {
+                                 case SimdLevel::Scalar:
+                                     return std::string("Scalar");
+                                 case SimdLevel::Sse42:
+                                     return std::string("Sse42");
+                                 case SimdLevel::Avx2:
+                                     return std::string("Avx2");
+                                 case SimdLevel::Avx512:
+                                     return std::string("Avx512");
+                                 }
+                                 return std::string("Unknown");
+                             });
+
+    class CullerTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+        }
+
+        void TearDown() override {
+            Logger::Shutdown();
+        }
+    };
+
+    TEST_F(CullerTest, MatchesTheRangeFunctionWithAndWithoutJobs) {
+        const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+        const BoundingSpheres spheres = MakeSpheres();
+        const std::vector<u32> triangleCounts(ObjectCount, 12);
+
+        std::vector<u32> expected(ObjectCount);
+        expected.resize(CullSpheres(frustum, spheres, 0, ObjectCount, expected.data()));
+
+        JobSystem jobSystem(4);
+        Culler culler;
+        for (JobSystem* jobs : {static_cast<JobSystem*>(nullptr), &jobSystem}) {
+            CullingSettings settings;
+            settings.Jobs = jobs;
+            settings.TriangleCounts = triangleCounts;
+
+            std::vector<u32> visible;
+            const CullingStats stats = culler.Cull(frustum, spheres, visible, settings);
+
+            EXPECT_EQ(visible, expected);
+            EXPECT_EQ(stats.TestedCount, ObjectCount);
+            EXPECT_EQ(stats.VisibleCount, expected.size());
+            EXPECT_EQ(stats.FrustumCulledCount, ObjectCount - expected.size());
+            EXPECT_EQ(stats.OcclusionCulledCount, 0u);
+            EXPECT_EQ(stats.VisibleTriangleCount, 12u * expected.size());
+        }
+    }
+
+    TEST_F(CullerTest, ReusesItsScratchAcrossSizes) {
+        const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+        const BoundingBoxes boxes = MakeBoxes();
+
+        BoundingBoxes fewBoxes;
+        fewBoxes.Add(glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(1.0f));
+        fewBoxes.Add(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(1.0f));
+
+        Culler culler;
+        std::vector<u32> visible;
+
+        const CullingStats large = culler.Cull(frustum, boxes, visible, {});
+        EXPECT_EQ(large.FrustumCulledCount + large.VisibleCount, ObjectCount);
+
+        const CullingStats small = culler.Cull(frustum, fewBoxes, visible, {});
+        EXPECT_EQ(small.TestedCount, 2u);
+        EXPECT_EQ(small.FrustumCulledCount, 1u);
+        EXPECT_EQ(visible, std::vector<u32>{0});
+
+        BoundingBoxes noBoxes;
+        const CullingStats empty = culler.Cull(frustum, noBoxes, visible, {});
+        EXPECT_EQ(empty.TestedCount, 0u);
+        EXPECT_TRUE(visible.empty());
+    }
+
+    TEST_F(CullerTest, OcclusionOnlyRemovesFrustumSurvivors) {
+        const glm::mat4 viewProjection = MakeViewProjection();
+        const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+        const BoundingSpheres spheres = MakeSpheres();
+
+        // A wall filling most of the view.
+        OcclusionBuffer occlusion;
+        occlusion.Begin(viewProjection);
+        occlusion.RasterizeOccluderBox(glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(60.0f, 40.0f, 1.0f));
+
+        JobSystem jobSystem(4);
+        CullingSettings settings;
+        settings.Jobs = &jobSystem;
+        settings.Occlusion = &occlusion;
+
+        Culler culler;
+        std::vector<u32> withoutOcclusion;
+        std::vector<u32> visible;
+        const CullingStats frustumOnly = culler.Cull(frustum, spheres, withoutOcclusion, {});
+        const CullingStats stats = culler.Cull(frustum, spheres, visible, settings);
+
+        EXPECT_EQ(stats.FrustumCulledCount, frustumOnly.FrustumCulledCount);
+        EXPECT_GT(stats.OcclusionCulledCount, 0u);
+        EXPECT_EQ(stats.VisibleCount + stats.OcclusionCulledCount, frustumOnly.VisibleCount);
+        EXPECT_TRUE(std::includes(withoutOcclusion.begin(), withoutOcclusion.end(), visible.begin(), visible.end()));
+
+        for (const u32 index : visible) {
+            EXPECT_TRUE(occlusion.IsBoxVisible({spheres.CenterX[index], spheres.CenterY[index], spheres.CenterZ[index]},
+                                               glm::vec3(spheres.Radius[index])));
+        }
+    }
+
+    TEST_F(CullerTest, PassesAddUpInTheEngineStats) {
+        const glm::mat4 viewProjection = MakeViewProjection();
+        const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+        const BoundingSpheres spheres = MakeSpheres();
+        const std::vector<u32> triangleCounts(ObjectCount, 12);
+
+        OcclusionBuffer occlusion;
+        occlusion.Begin(viewProjection);
+        occlusion.RasterizeOccluderBox(glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(60.0f, 40.0f, 1.0f));
+
+        EngineStats engineStats{};
+        CullingSettings settings;
+        settings.TriangleCounts = triangleCounts;
+        settings.Stats = &engineStats;
+
+        Culler culler;
+        std::vector<u32> visible;
+        const CullingStats frustumOnly = culler.Cull(frustum, spheres, visible, settings);
+
+        settings.Occlusion = &occlusion;
+        const CullingStats occluded = culler.Cull(frustum, spheres, visible, settings);
+
+        const u32 visibleCount = frustumOnly.VisibleCount + occluded.VisibleCount;
+        EXPECT_EQ(engineStats.VisibleObjectCount, static_cast<i32>(visibleCount));
+        EXPECT_EQ(engineStats.DrawCallCount, static_cast<i32>(visibleCount));
+        EXPECT_EQ(engineStats.CulledObjectCount, static_cast<i32>(2 * ObjectCount - visibleCount));
+        EXPECT_EQ(engineStats.TriangleCount, static_cast<i32>(12 * visibleCount));
+        EXPECT_GT(occluded.OcclusionCulledCount, 0u);
+    }
+}
@@ -0,0 +1,213 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Renderer/MeshletCulling.hpp>
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <numbers>
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    // Several ranges of the culler, the last one partial.
+    constexpr u32 MeshletCount = 3 * MeshletCuller::RangeSize + 17;
+
+    // Meshlets closer than this to a plane may land on either side depending on rounding, they aren't checked.
+    constexpr f64 BoundaryMargin = 1e-3;
+
+    const glm::vec3 CameraPosition(0.0f);
+
+    Frustum MakeFrustum() {
+        return Frustum::FromViewProjection(
+            glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f) *
+            glm::lookAtRH(CameraPosition, glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    }
+
+    // Only the meshlets and their bounds, the culler doesn't look at the vertices.
+    MeshletMesh MakeMeshlets() {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<f32> position(-200.0f, 200.0f);
+        std::uniform_real_distribution<f32> radius(0.5f, 5.0f);
+        std::normal_distribution<f32> axis;
+        std::uniform_real_distribution<f32> cutoff(-0.5f, 1.0f);
+
+        MeshletMesh meshlets;
+        for (u32 i = 0; i < MeshletCount; i++) {
+            meshlets.Meshlets.push_back({0, 0, 3, i % MeshletMaxTriangleCount + 1});
+            meshlets.Bounds.push_back({{position(random), position(random), position(random)}, radius(random),
+                                       glm::normalize(glm::vec3(axis(random), axis(random), axis(random))),
+                                       cutoff(random)});
+        }
+
+        return meshlets;
+    }
+
+    // Smallest signed distance of the bounding sphere to a plane, in double precision. Inside when it isn't negative.
+    f64 GetReferenceDistance(const Frustum& frustum, const MeshletBounds& bounds) {
+        f64 distance = std::numeric_limits<f64>::max();
+        for (const glm::vec4& plane : frustum.Planes) {
+            distance = std::min(distance, static_cast<f64>(plane.x) * bounds.Center.x +
+                                              static_cast<f64>(plane.y) * bounds.Center.y +
+                                              static_cast<f64>(plane.z) * bounds.Center.z + plane.w + bounds.Radius);
+        }
+
+        return distance;
+    }
+
+    // Runs every test without a job system (0) and with a job system of 4 workers.
+    class MeshletCullerTest : public testing::TestWithParam<u32> {
+    protected:
+        std::unique_ptr<JobSystem> m_Jobs;
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+            if (GetParam() > 0) {
+                m_Jobs = std::make_unique<JobSystem>(GetParam());
+            }
+        }
+
+        void TearDown() override {
+            m_Jobs.reset();
+            Logger::Shutdown();
+        }
+
+        [[nodiscard]] MeshletCullingSettings MakeSettings(const bool frustumCulling, const bool coneCulling) const {
+            MeshletCullingSettings settings;
+            settings.Jobs = m_Jobs.get();
+            settings.FrustumCulling = frustumCulling;
+            settings.ConeCulling = coneCulling;
+            return settings;
+        }
+    };
+
+    TEST_P(MeshletCullerTest, MatchesBruteForce) {
+        const Frustum frustum = MakeFrustum();
+        const MeshletMesh meshlets = MakeMeshlets();
+
+        MeshletCuller culler;
+        for (const auto [frustumCulling, coneCulling] : {std::pair(true, true), std::pair(true, false),
+                                                         std::pair(false, true), std::pair(false, false)}) {
+            std::vector<u32> visible;
+            const MeshletCullingStats stats = culler.Cull(meshlets, frustum, CameraPosition, visible,
+                                                          MakeSettings(frustumCulling, coneCulling));
+
+            std::vector<u8> isVisible(MeshletCount, 0);
+            u64 triangleCount = 0;
+            for (u32 i = 0; i < visible.size(); i++) {
+                ASSERT_LT(visible[i], MeshletCount);
+                if (i > 0) {
+                    ASSERT_LT(visible[i - 1], visible[i]);
+                }
+
+                isVisible[visible[i]] = 1;
+                triangleCount += meshlets.Meshlets[visible[i]].TriangleCount;
+            }
+
+            u32 frustumCulledCount = 0;
+            u32 coneCulledCount = 0;
+            for (u32 meshlet = 0; meshlet < MeshletCount; meshlet++) {
+                const MeshletBounds& bounds = meshlets.Bounds[meshlet];
+                const f64 distance = GetReferenceDistance(frustum, bounds);
+                if (frustumCulling && std::abs(distance) < BoundaryMargin) {
+                    // Counted by whatever the culler decided, so the totals below still have to add up.
+                    frustumCulledCount += !IsSphereInFrustum(frustum, bounds.Center, bounds.Radius);
+                    coneCulledCount += IsSphereInFrustum(frustum, bounds.Center, bounds.Radius) && coneCulling &&
+                                       IsMeshletBackFacing(bounds, CameraPosition);
+                    continue;
+                }
+
+                const bool inside = !frustumCulling || distance >= 0.0;
+                const bool backFacing = coneCulling && IsMeshletBackFacing(bounds, CameraPosition);
+                frustumCulledCount += !inside;
+                coneCulledCount += inside && backFacing;
+                ASSERT_EQ(isVisible[meshlet] != 0, inside && !backFacing) << "Meshlet " << meshlet;
+            }
+
+            EXPECT_EQ(stats.TestedCount, MeshletCount);
+            EXPECT_EQ(stats.FrustumCulledCount, frustumCulledCount);
+            EXPECT_EQ(stats.ConeCulledCount, coneCulledCount);
+            EXPECT_EQ(stats.VisibleCount, visible.size());
+            EXPECT_EQ(stats.VisibleCount + stats.FrustumCulledCount + stats.ConeCulledCount, MeshletCount);
+            EXPECT_EQ(stats.VisibleTriangleCount, triangleCount);
+
+            // The scene has every outcome of the tests that are on.
+            EXPECT_GT(stats.VisibleCount, 0u);
+            EXPECT_EQ(stats.FrustumCulledCount > 0, frustumCulling);
+            EXPECT_EQ(stats.ConeCulledCount > 0, coneCulling);
+        }
+    }
+
+    // The cones of real meshlets are conservative: every triangle of a culled meshlet faces away from the camera.
+    TEST_P(MeshletCullerTest, ConeCulledMeshletsOnlyHoldBackFaces) {
+        constexpr u32 Rings = 48;
+        constexpr u32 Segments = 96;
+
+        // A unit sphere, wound counter-clockwise seen from outside.
+        std::vector<glm::vec3> positions;
+        for (u32 ring = 0; ring <= Rings; ring++) {
+            const f32 theta = std::numbers::pi_v<f32> * static_cast<f32>(ring) / Rings;
+            for (u32 segment = 0; segment <= Segments; segment++) {
+                const f32 phi = 2.0f * std::numbers::pi_v<f32> * static_cast<f32>(segment) / Segments;
+                positions.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                       -std::sin(theta) * std::sin(phi));
+            }
+        }
+
+        std::vector<u32> indices;
+        for (u32 ring = 0; ring < Rings; ring++) {
+            for (u32 segment = 0; segment < Segments; segment++) {
+                const u32 corner = ring * (Segments + 1) + segment;
+                indices.insert(indices.end(), {corner, corner + Segments + 1, corner + 1});
+                indices.insert(indices.end(), {corner + 1, corner + Segments + 1, corner + Segments + 2});
+            }
+        }
+
+        MeshletBuildSettings buildSettings;
+        buildSettings.Jobs = m_Jobs.get();
+
+        MeshletMesh meshlets;
+        BuildMeshlets(meshlets, indices, &positions[0].x, static_cast<u32>(positions.size()), sizeof(glm::vec3),
+                      buildSettings);
+
+        const glm::vec3 cameraPosition(0.0f, 0.0f, 1.25f);
+        std::vector<u32> visible;
+        MeshletCuller culler;
+        const MeshletCullingStats stats =
+            culler.Cull(meshlets, MakeFrustum(), cameraPosition, visible, MakeSettings(false, true));
+
+        ASSERT_GT(stats.ConeCulledCount, 0u);
+        ASSERT_GT(stats.VisibleCount, 0u);
+
+        u32 next = 0;
+        for (u32 meshlet = 0; meshlet < meshlets.GetMeshletCount(); meshlet++) {
+            if (next < visible.size() && visible[next] == meshlet) {
+                next++;
+                continue;
+            }
+
+            const std::span<const u32> vertices = meshlets.GetVertices(meshlets.Meshlets[meshlet]);
+            const std::span<const u8> triangles = meshlets.GetTriangles(meshlets.Meshlets[meshlet]);
+            for (u32 i = 0; i < triangles.size(); i += 3) {
+                const glm::vec3& a = positions[vertices[triangles[i + 0]]];
+                const glm::vec3& b = positions[vertices[triangles[i + 1]]];
+                const glm::vec3& c = positions[vertices[triangles[i + 2]]];
+
+                const glm::vec3 normal = glm::cross(b - a, c - a);
+                ASSERT_GE(glm::dot(normal, a - cameraPosition), 0.0f)
+                    << "Meshlet " << meshlet << ", triangle " << i / 3;
+            }
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(MeshletCuller, MeshletCullerTest, testing::Values(0u, 4u),
+                             [](const testing::TestParamInfo<u32>& info) {
+                                 return info.param == 0 ? std::string("NoJobSystem")
+                                                        : fmt::format("{0}Workers", info.param);
+                             });
+}
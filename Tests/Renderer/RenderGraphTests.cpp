@@ -0,0 +1,401 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Renderer/RenderGraph.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    constexpr RenderImageDesc TargetDesc{256, 256, 1, 1, RenderFormat::R8G8B8A8Unorm};
+
+    constexpr RenderUsageFlags ToFlags(const RenderUsage usage) {
+        return static_cast<RenderUsageFlags>(usage);
+    }
+
+    // Records what Execute hands to the backend, in order.
+    class RecordingBackend : public RenderGraphBackend {
+    public:
+        std::vector<std::string> Events;
+
+        void RecordBarriers(const std::span<const RenderGraphBarrier> barriers) override {
+            Events.push_back("Barriers " + std::to_string(barriers.size()));
+        }
+
+        void BeginPass(const std::string_view name) override {
+            Events.push_back("Begin " + std::string(name));
+        }
+
+        void EndPass() override {
+            Events.push_back("End");
+        }
+    };
+
+    // Level of every kept pass, the index of the batch it is in.
+    std::vector<u32> GetPassLevels(const RenderGraph& graph) {
+        std::vector<u32> levels(graph.GetPassCount(), std::numeric_limits<u32>::max());
+        const std::span<const RenderGraphBatch> batches = graph.GetBatches();
+        for (u32 level = 0; level < batches.size(); level++) {
+            for (u32 i = batches[level].FirstPass; i < batches[level].FirstPass + batches[level].PassCount; i++) {
+                levels[graph.GetPassOrder()[i]] = level;
+            }
+        }
+
+        return levels;
+    }
+
+    std::vector<RenderGraphBarrier> GetBarriersOf(const RenderGraph& graph, const RenderResourceId resource) {
+        std::vector<RenderGraphBarrier> barriers;
+        for (const RenderGraphBarrier& barrier : graph.GetBarriers()) {
+            if (barrier.Resource == resource) {
+                barriers.push_back(barrier);
+            }
+        }
+
+        return barriers;
+    }
+
+    TEST(RenderGraph, CullsPassesNothingNeededDependsOn) {
+        RenderGraph graph;
+        const RenderResourceId swapchain = graph.ImportImage("Swapchain", TargetDesc, RenderUsage::None,
+                                                             RenderUsage::Present);
+        const RenderResourceId unused = graph.CreateImage("Unused", TargetDesc);
+        const RenderResourceId color = graph.CreateImage("Color", TargetDesc);
+        const RenderResourceId readback = graph.CreateBuffer("Readback", {1024});
+
+        const RenderPassId unusedPass = graph.AddPass("Unused", [&](RenderPassBuilder& builder) {
+            builder.Write(unused, RenderUsage::ColorAttachment);
+        });
+        const RenderPassId colorPass = graph.AddPass("Color", [&](RenderPassBuilder& builder) {
+            builder.Write(color, RenderUsage::ColorAttachment);
+        });
+        const RenderPassId presentPass = graph.AddPass("Present", [&](RenderPassBuilder& builder) {
+            builder.Read(color, RenderUsage::ShaderSampled).Write(swapchain, RenderUsage::ColorAttachment);
+        });
+        const RenderPassId readbackPass = graph.AddPass("Readback", [&](RenderPassBuilder& builder) {
+            builder.Read(unused, RenderUsage::TransferSrc).Write(readback, RenderUsage::TransferDst).SetSideEffects();
+        });
+
+        graph.Compile();
+
+        // The readback has side effects, so what it reads is needed too.
+        EXPECT_FALSE(graph.IsPassCulled(unusedPass));
+        EXPECT_FALSE(graph.IsPassCulled(colorPass));
+        EXPECT_FALSE(graph.IsPassCulled(presentPass));
+        EXPECT_FALSE(graph.IsPassCulled(readbackPass));
+
+        graph.Reset();
+        const RenderResourceId swapchain2 = graph.ImportImage("Swapchain", TargetDesc, RenderUsage::None,
+                                                              RenderUsage::Present);
+        const RenderResourceId unused2 = graph.CreateImage("Unused", TargetDesc);
+        const RenderPassId culled = graph.AddPass("Unused", [&](RenderPassBuilder& builder) {
+            builder.Write(unused2, RenderUsage::ColorAttachment);
+        });
+        const RenderPassId kept = graph.AddPass("Present", [&](RenderPassBuilder& builder) {
+            builder.Write(swapchain2, RenderUsage::ColorAttachment);
+        });
+
+        graph.Compile();
+
+        EXPECT_TRUE(graph.IsPassCulled(culled));
+        EXPECT_FALSE(graph.IsPassCulled(kept));
+        EXPECT_EQ(graph.GetStats().PassCount, 1u);
+        EXPECT_EQ(graph.GetStats().CulledPassCount, 1u);
+        EXPECT_EQ(graph.GetStats().TransientResourceCount, 0u);
+    }
+
+    TEST(RenderGraph, GroupsIndependentPassesInLevels) {
+        RenderGraph graph;
+        const RenderResourceId swapchain = graph.ImportImage("Swapchain", TargetDesc, RenderUsage::None,
+                                                             RenderUsage::Present);
+        const RenderResourceId shadows = graph.CreateImage("Shadows", TargetDesc);
+        const RenderResourceId gbuffer = graph.CreateImage("GBuffer", TargetDesc);
+
+        const RenderPassId shadowPass = graph.AddPass("Shadows", [&](RenderPassBuilder& builder) {
+            builder.Write(shadows, RenderUsage::DepthStencilAttachment);
+        });
+        const RenderPassId gbufferPass = graph.AddPass("GBuffer", [&](RenderPassBuilder& builder) {
+            builder.Write(gbuffer, RenderUsage::ColorAttachment);
+        });
+        const RenderPassId lightingPass = graph.AddPass("Lighting", [&](RenderPassBuilder& builder) {
+            builder.Read(shadows, RenderUsage::ShaderSampled).Read(gbuffer, RenderUsage::ShaderSampled);
+            builder.Write(swapchain, RenderUsage::ColorAttachment);
+        });
+
+        graph.Compile();
+
+        const std::vector<u32> levels = GetPassLevels(graph);
+        EXPECT_EQ(levels[shadowPass], 0u);
+        EXPECT_EQ(levels[gbufferPass], 0u);
+        EXPECT_EQ(levels[lightingPass], 1u);
+
+        // Two levels of passes, then the batch handing the swapchain over for presentation.
+        ASSERT_EQ(graph.GetBatches().size(), 3u);
+        EXPECT_EQ(graph.GetBatches()[0].PassCount, 2u);
+        EXPECT_EQ(graph.GetBatches()[2].PassCount, 0u);
+
+        // Both targets live at the same time, they can't share memory.
+        EXPECT_NE(graph.GetResourceOffset(shadows), graph.GetResourceOffset(gbuffer));
+    }
+
+    TEST(RenderGraph, EmitsLayoutTransitionsAndWaits) {
+        RenderGraph graph;
+        const RenderResourceId swapchain = graph.ImportImage("Swapchain", TargetDesc, RenderUsage::None,
+                                                             RenderUsage::Present);
+        const RenderResourceId color = graph.CreateImage("Color", TargetDesc);
+
+        graph.AddPass("Color", [&](RenderPassBuilder& builder) {
+            builder.Write(color, RenderUsage::ColorAttachment);
+        });
+        graph.AddPass("Present", [&](RenderPassBuilder& builder) {
+            builder.Read(color, RenderUsage::ShaderSampled).Write(swapchain, RenderUsage::ColorAttachment);
+        });
+
+        graph.Compile();
+
+        const std::vector<RenderGraphBarrier> colorBarriers = GetBarriersOf(graph, color);
+        ASSERT_EQ(colorBarriers.size(), 2u);
+
+        // First use: nothing to wait for, only the transition out of undefined.
+        EXPECT_EQ(colorBarriers[0].SrcUsages, 0u);
+        EXPECT_EQ(colorBarriers[0].DstUsages, ToFlags(RenderUsage::ColorAttachment));
+        EXPECT_EQ(colorBarriers[0].OldLayout, RenderImageLayout::Undefined);
+        EXPECT_EQ(colorBarriers[0].NewLayout, RenderImageLayout::ColorAttachment);
+
+        // Read after write.
+        EXPECT_EQ(colorBarriers[1].SrcUsages, ToFlags(RenderUsage::ColorAttachment));
+        EXPECT_EQ(colorBarriers[1].DstUsages, ToFlags(RenderUsage::ShaderSampled));
+        EXPECT_EQ(colorBarriers[1].OldLayout, RenderImageLayout::ColorAttachment);
+        EXPECT_EQ(colorBarriers[1].NewLayout, RenderImageLayout::ShaderReadOnly);
+
+        const std::vector<RenderGraphBarrier> swapchainBarriers = GetBarriersOf(graph, swapchain);
+        ASSERT_EQ(swapchainBarriers.size(), 2u);
+        EXPECT_EQ(swapchainBarriers[1].SrcUsages, ToFlags(RenderUsage::ColorAttachment));
+        EXPECT_EQ(swapchainBarriers[1].DstUsages, ToFlags(RenderUsage::Present));
+        EXPECT_EQ(swapchainBarriers[1].NewLayout, RenderImageLayout::PresentSrc);
+    }
+
+    TEST(RenderGraph, ExecutesBatchesInOrder) {
+        RenderGraph graph;
+        const RenderResourceId swapchain = graph.ImportImage("Swapchain", TargetDesc, RenderUsage::None,
+                                                             RenderUsage::Present);
+        const RenderResourceId color = graph.CreateImage("Color", TargetDesc);
+
+        u32 executed = 0;
+        graph.AddPass("Color", [&](RenderPassBuilder& builder) {
+            builder.Write(color, RenderUsage::ColorAttachment).SetExecute([&executed](RenderGraphBackend&) {
+                executed++;
+            });
+        });
+        graph.AddPass("Present", [&](RenderPassBuilder& builder) {
+            builder.Read(color, RenderUsage::ShaderSampled).Write(swapchain, RenderUsage::ColorAttachment);
+        });
+
+        graph.Compile();
+
+        RecordingBackend backend;
+        graph.Execute(backend);
+
+        EXPECT_EQ(executed, 1u);
+        EXPECT_EQ(backend.Events, (std::vector<std::string>{"Barriers 1", "Begin Color", "End", "Barriers 2",
+                                                            "Begin Present", "End", "Barriers 1"}));
+    }
+
+    // Random graphs: every pass writes a target or a buffer and reads a few recent ones.
+    class RenderGraphRandomTest : public testing::TestWithParam<u32> {
+    protected:
+        struct Access {
+            RenderResourceId Resource;
+            bool Write;
+        };
+
+        RenderGraph m_Graph;
+        std::vector<std::vector<Access>> m_PassAccesses;
+        std::vector<u64> m_Sizes;
+
+        void Build(const u32 passCount, const u32 seed) {
+            std::mt19937 random(seed);
+            std::vector<RenderResourceId> resources;
+
+            const RenderResourceId swapchain = m_Graph.ImportImage("Swapchain", TargetDesc, RenderUsage::None,
+                                                                   RenderUsage::Present);
+            m_Sizes.assign(1, 0);
+
+            for (u32 i = 0; i < passCount; i++) {
+                // Sizes and alignments set by hand, so the test knows the exact memory ranges.
+                const bool isBuffer = random() % 4 == 0;
+                const RenderResourceId resource = isBuffer ? m_Graph.CreateBuffer("Buffer", {4096})
+                                                           : m_Graph.CreateImage("Target", TargetDesc);
+                const u64 alignment = isBuffer ? 256 : 4096;
+                const u64 size = alignment * (1 + random() % 16) - (isBuffer ? 0 : random() % alignment);
+                m_Graph.SetMemoryRequirements(resource, size, alignment);
+                m_Sizes.push_back(size);
+
+                std::vector<Access>& accesses = m_PassAccesses.emplace_back();
+                m_Graph.AddPass("Pass", [&](RenderPassBuilder& builder) {
+                    for (u32 j = 0; j < 3 && !resources.empty(); j++) {
+                        const u32 back = static_cast<u32>(random() % std::min<u32>(static_cast<u32>(resources.size()),
+                                                                                     12));
+                        const RenderResourceId read = resources[resources.size() - 1 - back];
+                        const bool readIsBuffer = m_Graph.GetResourceType(read) == RenderResourceType::Buffer;
+                        builder.Read(read, readIsBuffer ? RenderUsage::ShaderStorageRead : RenderUsage::ShaderSampled);
+                        accesses.push_back({read, false});
+                    }
+
+                    // Some passes write a resource of an earlier pass again, which orders them after its readers.
+                    const RenderResourceId written = !resources.empty() && random() % 8 == 0
+                                                         ? resources[resources.size() - 1 - random() %
+                                                                     std::min<u32>(static_cast<u32>(resources.size()),
+                                                                                   4)]
+                                                         : resource;
+                    const bool writtenIsBuffer = m_Graph.GetResourceType(written) == RenderResourceType::Buffer;
+                    builder.Write(written,
+                                  writtenIsBuffer ? RenderUsage::ShaderStorageWrite : RenderUsage::ColorAttachment);
+                    accesses.push_back({written, true});
+                });
+
+                resources.push_back(resource);
+            }
+
+            std::vector<Access>& accesses = m_PassAccesses.emplace_back();
+            m_Graph.AddPass("Present", [&](RenderPassBuilder& builder) {
+                const bool lastIsBuffer = m_Graph.GetResourceType(resources.back()) == RenderResourceType::Buffer;
+                builder.Read(resources.back(),
+                             lastIsBuffer ? RenderUsage::ShaderStorageRead : RenderUsage::ShaderSampled);
+                builder.Write(swapchain, RenderUsage::ColorAttachment);
+                accesses.push_back({resources.back(), false});
+                accesses.push_back({swapchain, true});
+            });
+        }
+
+        // Checks the compiled graph against the accesses recorded while building it.
+        void ExpectValidCompilation() {
+            const std::vector<u32> levels = GetPassLevels(m_Graph);
+            const u32 resourceCount = m_Graph.GetResourceCount();
+
+            // Kept passes come after everything they depend on, in the declaration order.
+            std::vector<RenderPassId> lastWriters(resourceCount, InvalidRenderResource);
+            std::vector<std::vector<RenderPassId>> readers(resourceCount);
+            for (RenderPassId pass = 0; pass < m_PassAccesses.size(); pass++) {
+                for (const auto [resource, write] : m_PassAccesses[pass]) {
+                    const RenderPassId writer = lastWriters[resource];
+                    if (!m_Graph.IsPassCulled(pass) && writer != InvalidRenderResource && writer != pass) {
+                        ASSERT_FALSE(m_Graph.IsPassCulled(writer)) << "Pass " << pass << " needs pass " << writer;
+                        ASSERT_LT(levels[writer], levels[pass]);
+                    }
+
+                    if (!write) {
+                        readers[resource].push_back(pass);
+                        continue;
+                    }
+
+                    for (const RenderPassId reader : readers[resource]) {
+                        if (!m_Graph.IsPassCulled(pass) && !m_Graph.IsPassCulled(reader) && reader != pass) {
+                            ASSERT_LT(levels[reader], levels[pass]) << "Overwritten before pass " << reader << " read";
+                        }
+                    }
+                    lastWriters[resource] = pass;
+                    readers[resource].clear();
+                }
+            }
+
+            // Lifetime of every transient resource, in levels.
+            std::vector<u32> first(resourceCount, std::numeric_limits<u32>::max());
+            std::vector<u32> last(resourceCount, 0);
+            for (RenderPassId pass = 0; pass < m_PassAccesses.size(); pass++) {
+                if (m_Graph.IsPassCulled(pass)) {
+                    continue;
+                }
+                for (const auto [resource, write] : m_PassAccesses[pass]) {
+                    first[resource] = std::min(first[resource], levels[pass]);
+                    last[resource] = std::max(last[resource], levels[pass]);
+                }
+            }
+
+            // Resources of the same heap whose memory overlaps never live at the same time, and the later one waits
+            // for the earlier one on its first barrier.
+            u64 totalSize = 0;
+            u64 paddedSize = 0;
+            for (RenderResourceId a = 1; a < resourceCount; a++) {
+                if (first[a] == std::numeric_limits<u32>::max()) {
+                    continue;
+                }
+
+                const u64 alignment = m_Graph.GetResourceType(a) == RenderResourceType::Buffer ? 256 : 4096;
+                totalSize += m_Sizes[a];
+                paddedSize += m_Sizes[a] + alignment - 1;
+                ASSERT_EQ(m_Graph.GetResourceOffset(a) % alignment, 0u);
+
+                const u64 heapSize = m_Graph.GetResourceType(a) == RenderResourceType::Buffer
+                                         ? m_Graph.GetStats().BufferHeapSize
+                                         : m_Graph.GetStats().ImageHeapSize;
+                ASSERT_LE(m_Graph.GetResourceOffset(a) + m_Sizes[a], heapSize);
+
+                for (RenderResourceId b = a + 1; b < resourceCount; b++) {
+                    if (first[b] == std::numeric_limits<u32>::max() ||
+                        m_Graph.GetResourceType(a) != m_Graph.GetResourceType(b)) {
+                        continue;
+                    }
+
+                    const u64 offsetA = m_Graph.GetResourceOffset(a);
+                    const u64 offsetB = m_Graph.GetResourceOffset(b);
+                    if (offsetA >= offsetB + m_Sizes[b] || offsetB >= offsetA + m_Sizes[a]) {
+                        continue;
+                    }
+
+                    ASSERT_TRUE(last[a] < first[b] || last[b] < first[a])
+                        << "Resources " << a << " and " << b << " share memory while both alive";
+
+                    const RenderResourceId later = last[a] < first[b] ? b : a;
+                    const std::vector<RenderGraphBarrier> barriers = GetBarriersOf(m_Graph, later);
+                    ASSERT_FALSE(barriers.empty());
+                    EXPECT_NE(barriers[0].SrcUsages, 0u) << "Resource " << later << " doesn't wait for its memory";
+                }
+            }
+
+            EXPECT_EQ(m_Graph.GetStats().TransientMemory, totalSize);
+            // At worst every resource gets its own memory, after the padding of its alignment.
+            EXPECT_LE(m_Graph.GetStats().ImageHeapSize + m_Graph.GetStats().BufferHeapSize, paddedSize);
+        }
+    };
+
+    TEST_P(RenderGraphRandomTest, RespectsDependenciesAndNeverOverlapsLiveMemory) {
+        Build(300, GetParam());
+        m_Graph.Compile();
+
+        ExpectValidCompilation();
+        EXPECT_GT(m_Graph.GetStats().CulledPassCount, 0u);
+    }
+
+    TEST_P(RenderGraphRandomTest, RecompilingGivesTheSameResult) {
+        Build(300, GetParam());
+        m_Graph.Compile();
+
+        const std::vector<RenderPassId> order(m_Graph.GetPassOrder().begin(), m_Graph.GetPassOrder().end());
+        const u32 barrierCount = m_Graph.GetStats().BarrierCount;
+        const u64 heapSize = m_Graph.GetStats().ImageHeapSize;
+
+        m_Graph.Compile();
+
+        EXPECT_TRUE(std::ranges::equal(m_Graph.GetPassOrder(), order));
+        EXPECT_EQ(m_Graph.GetStats().BarrierCount, barrierCount);
+        EXPECT_EQ(m_Graph.GetStats().ImageHeapSize, heapSize);
+
+        // A smaller graph after Reset reuses the scratch memory sized for this one.
+        m_Graph.Reset();
+        m_PassAccesses.clear();
+        Build(20, GetParam() + 1);
+        m_Graph.Compile();
+
+        ExpectValidCompilation();
+    }
+
+    INSTANTIATE_TEST_SUITE_P(RenderGraph, RenderGraphRandomTest, testing::Values(1u, 2u, 3u, 4u, 5u),
+                             [](const testing::TestParamInfo<u32>& info) {
+                                 return "Seed" + std::to_string(info.param);
+                             });
+}
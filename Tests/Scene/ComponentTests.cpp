@@ -0,0 +1,85 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Scene/Component.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace Flashlight;
+
+namespace {
+    struct TestPosition {
+        f32 X, Y, Z;
+    };
+
+    struct alignas(32) TestBounds {
+        f32 Min[4];
+        f32 Max[4];
+    };
+
+    struct TestName {
+        std::string Value;
+    };
+
+    TEST(ComponentRegistry, GivesEveryTypeItsOwnStableId) {
+        const ComponentId position = GetComponentId<TestPosition>();
+        const ComponentId bounds = GetComponentId<TestBounds>();
+        const ComponentId name = GetComponentId<TestName>();
+
+        EXPECT_NE(position, bounds);
+        EXPECT_NE(position, name);
+        EXPECT_NE(bounds, name);
+
+        EXPECT_EQ(GetComponentId<TestPosition>(), position);
+        EXPECT_EQ(GetComponentId<const TestPosition&>(), position);
+    }
+
+    TEST(ComponentRegistry, InfoDescribesTheLayout) {
+        const ComponentInfo& bounds = ComponentRegistry::GetInfo(GetComponentId<TestBounds>());
+        EXPECT_EQ(bounds.Size, sizeof(TestBounds));
+        EXPECT_EQ(bounds.Alignment, 32u);
+        EXPECT_EQ(bounds.Relocate, nullptr);
+        EXPECT_EQ(bounds.Destroy, nullptr);
+
+        const ComponentInfo& name = ComponentRegistry::GetInfo(GetComponentId<TestName>());
+        EXPECT_NE(name.Relocate, nullptr);
+        EXPECT_NE(name.Destroy, nullptr);
+    }
+
+    TEST(ComponentRegistry, RegisteringTheSameTypeAgainReturnsItsId) {
+        ComponentInfo info = ComponentRegistry::GetInfo(GetComponentId<TestPosition>());
+        const u32 count = ComponentRegistry::GetComponentTypeCount();
+
+        EXPECT_EQ(ComponentRegistry::Register(info), GetComponentId<TestPosition>());
+        EXPECT_EQ(ComponentRegistry::GetComponentTypeCount(), count);
+    }
+
+    TEST(ComponentRegistry, ConcurrentLookupsAgreeOnTheIds) {
+        struct TestVelocity {
+            f32 X, Y, Z;
+        };
+        struct TestHealth {
+            i32 Value;
+        };
+
+        std::vector<std::thread> threads;
+        std::array<std::pair<ComponentId, ComponentId>, 8> ids;
+        for (u32 i = 0; i < ids.size(); i++) {
+            threads.emplace_back([&ids, i] {
+                ids[i] = {GetComponentId<TestVelocity>(), GetComponentId<TestHealth>()};
+                EXPECT_EQ(ComponentRegistry::GetInfo(ids[i].first).Size, sizeof(TestVelocity));
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (const auto& pair : ids) {
+            EXPECT_EQ(pair, ids[0]);
+        }
+        EXPECT_NE(ids[0].first, ids[0].second);
+    }
+}
@@ -0,0 +1,233 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Math/SimdLevel.hpp>
+#include <FlashlightEngine/Scene/TransformHierarchy.hpp>
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace Flashlight;
+
+namespace {
+    // Wide enough for levels to be split into several jobs.
+    constexpr u32 NodeCount = 20000;
+
+    glm::mat4 ComputeReferenceWorld(const TransformHierarchy& hierarchy, const TransformId id) {
+        const glm::mat4 local = glm::translate(glm::mat4(1.0f), hierarchy.GetLocalPosition(id)) *
+                                glm::mat4_cast(hierarchy.GetLocalRotation(id)) *
+                                glm::scale(glm::mat4(1.0f), hierarchy.GetLocalScale(id));
+
+        const TransformId parent = hierarchy.GetParent(id);
+        return parent == InvalidTransform ? local : ComputeReferenceWorld(hierarchy, parent) * local;
+    }
+
+    void ExpectReferenceWorlds(const TransformHierarchy& hierarchy, const std::vector<TransformId>& ids) {
+        for (const TransformId id : ids) {
+            if (!hierarchy.IsAlive(id)) {
+                continue;
+            }
+
+            const glm::mat4 expected = ComputeReferenceWorld(hierarchy, id);
+            const glm::mat4& actual = hierarchy.GetWorldMatrix(id);
+            for (u32 column = 0; column < 4; column++) {
+                for (u32 row = 0; row < 4; row++) {
+                    ASSERT_NEAR(actual[column][row], expected[column][row],
+                                1e-3f * std::max(1.0f, std::abs(expected[column][row])))
+                        << "Transform " << id << ", column " << column << ", row " << row;
+                }
+            }
+        }
+    }
+
+    // Runs every test without a job system (0) and with job systems of 1 and 4 workers.
+    class TransformHierarchyTest : public testing::TestWithParam<u32> {
+    protected:
+        std::unique_ptr<JobSystem> m_Jobs;
+        TransformHierarchy m_Hierarchy;
+        std::vector<TransformId> m_Ids;
+        std::mt19937 m_Random{42};
+
+        void SetUp() override {
+            Logger::Init({.ConsoleOutput = false});
+            if (GetParam() > 0) {
+                m_Jobs = std::make_unique<JobSystem>(GetParam());
+            }
+        }
+
+        void TearDown() override {
+            m_Jobs.reset();
+            Logger::Shutdown();
+        }
+
+        // A random tree with a few roots: node i's parent is drawn among the nodes before it.
+        void Fill() {
+            m_Ids.resize(NodeCount);
+            for (u32 i = 0; i < NodeCount; i++) {
+                const TransformId parent = i < 4 ? InvalidTransform : m_Ids[RandomIndex(i)];
+                m_Ids[i] = m_Hierarchy.Create(parent);
+                Move(m_Ids[i]);
+            }
+        }
+
+        void Move(const TransformId id) {
+            std::uniform_real_distribution<f32> position(-2.0f, 2.0f);
+            std::uniform_real_distribution<f32> angle(-3.0f, 3.0f);
+            std::uniform_real_distribution<f32> scale(0.9f, 1.1f);
+
+            m_Hierarchy.SetLocalTransform(id, glm::vec3(position(m_Random), position(m_Random), position(m_Random)),
+                                          glm::angleAxis(angle(m_Random), glm::vec3(0.0f, 0.0f, 1.0f)),
+                                          glm::vec3(scale(m_Random)));
+        }
+
+        u32 RandomIndex(const u32 count) {
+            return std::uniform_int_distribution<u32>(0, count - 1)(m_Random);
+        }
+
+        void Update() {
+            m_Hierarchy.Update(m_Jobs.get());
+        }
+    };
+
+    TEST_P(TransformHierarchyTest, FullUpdateMatchesReference) {
+        Fill();
+        Update();
+
+        ExpectReferenceWorlds(m_Hierarchy, m_Ids);
+    }
+
+    TEST_P(TransformHierarchyTest, PartialUpdateRecomputesMovedSubtrees) {
+        Fill();
+        Update();
+
+        for (u32 round = 0; round < 3; round++) {
+            for (u32 i = 0; i < NodeCount / 100; i++) {
+                Move(m_Ids[RandomIndex(NodeCount)]);
+            }
+            Update();
+
+            ExpectReferenceWorlds(m_Hierarchy, m_Ids);
+        }
+    }
+
+    TEST_P(TransformHierarchyTest, UpdateAfterReparentingAndDestroying) {
+        Fill();
+        Update();
+
+        // Parented under a node of an earlier index, so no cycle can form.
+        for (u32 i = 0; i < 200; i++) {
+            const u32 child = 4 + RandomIndex(NodeCount - 4);
+            m_Hierarchy.SetParent(m_Ids[child], m_Ids[RandomIndex(child)]);
+        }
+        Update();
+        ExpectReferenceWorlds(m_Hierarchy, m_Ids);
+
+        std::vector<TransformId> destroyed;
+        for (u32 i = 0; i < 50; i++) {
+            destroyed.push_back(m_Ids[4 + RandomIndex(NodeCount - 4)]);
+        }
+
+        // A single node moved, kept and created last so it comes after most removed nodes: the update has to start at
+        // its index after the compaction, not before it.
+        const auto isDestroyed = [this, &destroyed](const TransformId id) {
+            for (TransformId ancestor = id; ancestor != InvalidTransform; ancestor = m_Hierarchy.GetParent(ancestor)) {
+                if (std::find(destroyed.begin(), destroyed.end(), ancestor) != destroyed.end()) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        TransformId moved = m_Ids[NodeCount - 1];
+        for (u32 i = NodeCount - 1; isDestroyed(moved); i--) {
+            moved = m_Ids[i - 1];
+        }
+        Move(moved);
+
+        m_Hierarchy.Destroy(destroyed);
+        Update();
+        ExpectReferenceWorlds(m_Hierarchy, m_Ids);
+
+        for (const TransformId id : destroyed) {
+            EXPECT_FALSE(m_Hierarchy.IsAlive(id));
+        }
+
+        // Ids are reused and the new nodes are appended at the deepest level.
+        for (u32 i = 0; i < 100; i++) {
+            const TransformId parent = m_Ids[RandomIndex(NodeCount)];
+            if (m_Hierarchy.IsAlive(parent)) {
+                const TransformId id = m_Hierarchy.Create(parent);
+                Move(id);
+                m_Ids.push_back(id);
+            }
+        }
+        Update();
+        ExpectReferenceWorlds(m_Hierarchy, m_Ids);
+    }
+
+    TEST_P(TransformHierarchyTest, DestroyingEverythingLeavesAnEmptyHierarchy) {
+        Fill();
+        Update();
+
+        Move(m_Ids[NodeCount - 1]);
+        m_Hierarchy.Destroy(std::span(m_Ids.data(), 4));
+        EXPECT_EQ(m_Hierarchy.GetCount(), 0u);
+
+        Update();
+
+        const TransformId root = m_Hierarchy.Create();
+        m_Hierarchy.SetLocalPosition(root, glm::vec3(1.0f, 2.0f, 3.0f));
+        Update();
+
+        EXPECT_EQ(m_Hierarchy.GetWorldMatrix(root)[3][0], 1.0f);
+        EXPECT_EQ(m_Hierarchy.GetWorldMatrix(root)[3][1], 2.0f);
+        EXPECT_EQ(m_Hierarchy.GetWorldMatrix(root)[3][2], 3.0f);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(TransformHierarchy, TransformHierarchyTest, testing::Values(0u, 1u, 4u),
+                             [](const testing::TestParamInfo<u32>& info) {
+                                 return info.param == 0 ? std::string("NoJobSystem")
+                                                        : fmt::format("{0}Workers", info.param);
+                             });
+
+    // Every level the CPU supports gives the reference matrices, with rotations around any axis. Levels the build has
+    // no kernels for fall back to the level below.
+    TEST(TransformHierarchyLevelTest, EveryLevelMatchesReference) {
+        const SimdLevel previous = GetSimdLevel();
+
+        for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse42, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            if (level > GetSupportedSimdLevel()) {
+                break;
+            }
+            SetSimdLevel(level);
+
+            std::mt19937 random(7);
+            std::uniform_real_distribution<f32> value(-1.0f, 1.0f);
+
+            TransformHierarchy hierarchy;
+            std::vector<TransformId> ids;
+            for (u32 i = 0; i < 1000; i++) {
+                const TransformId parent = i < 4 ? InvalidTransform : ids[random() % i];
+                ids.push_back(hierarchy.Create(parent));
+
+                const glm::vec3 position(value(random), value(random), value(random));
+                const glm::vec3 axis = glm::normalize(glm::vec3(value(random), value(random), value(random)) +
+                                                      glm::vec3(0.0f, 0.0f, 2.0f));
+                const glm::quat rotation = glm::angleAxis(3.0f * value(random), axis);
+                const glm::vec3 scale = glm::vec3(1.0f) + 0.1f * glm::vec3(value(random), value(random), value(random));
+                hierarchy.SetLocalTransform(ids.back(), position, rotation, scale);
+            }
+            hierarchy.Update(nullptr);
+
+            SCOPED_TRACE(static_cast<i32>(level));
+            ExpectReferenceWorlds(hierarchy, ids);
+        }
+
+        SetSimdLevel(previous);
+    }
+}
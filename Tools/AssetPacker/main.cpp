@@ -0,0 +1,110 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Asset/AssetArchive.hpp>
+#include <FlashlightEngine/Core/JobSystem.hpp>
+
+#include <algorithm>
+
+using namespace Flashlight;
+
+namespace {
+    void PrintUsage() {
+        std::cerr << "Usage: FlashlightAssetPacker <input directory> <output archive> [none|lz4|zstd]\n"
+                  << "       FlashlightAssetPacker --list <archive>\n";
+    }
+
+    std::string_view GetCompressionName(const AssetCompression compression) {
+        switch (compression) {
+        case AssetCompression::LZ4:
+            return "lz4";
+        case AssetCompression::Zstd:
+            return "zstd";
+        default:
+            return "none";
+        }
+    }
+
+    // Lists the entries and checks every one of them against its hash.
+    i32 List(const std::filesystem::path& path) {
+        AssetArchive archive;
+        if (archive.Open(path) != AssetArchiveError::None) {
+            return 1;
+        }
+
+        u32 corruptedCount = 0;
+        for (const AssetArchiveEntry& entry : archive.GetEntries()) {
+            const AssetArchiveError error = archive.Verify(entry);
+            corruptedCount += error != AssetArchiveError::None;
+
+            std::cout << fmt::format("{0:>12} {1:>12} {2:<5} {3:016x} {4}", entry.Size, entry.StoredSize,
+                                     GetCompressionName(entry.Compression), entry.ContentHash, archive.GetPath(entry));
+            if (error != AssetArchiveError::None) {
+                std::cout << " (" << GetErrorName(error) << ")";
+            }
+            std::cout << "\n";
+        }
+
+        std::cerr << archive.GetEntries().size() << " entries, " << corruptedCount << " corrupted.\n";
+        return corruptedCount == 0 ? 0 : 1;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Logger::Init({});
+
+    i32 result = 1;
+    if (argc == 3 && std::string_view(argv[1]) == "--list") {
+        result = List(argv[2]);
+    } else if (argc == 3 || argc == 4) {
+        const std::string_view compressionName = argc == 4 ? argv[3] : "none";
+        const std::filesystem::path input = argv[1];
+
+        AssetCompression compression = AssetCompression::None;
+        if (compressionName == "lz4") {
+            compression = AssetCompression::LZ4;
+        } else if (compressionName == "zstd") {
+            compression = AssetCompression::Zstd;
+        } else if (compressionName != "none") {
+            PrintUsage();
+            Logger::Shutdown();
+            return 1;
+        }
+
+        // Sorted so packing the same directory twice gives the same archive.
+        std::vector<std::filesystem::path> files;
+        std::error_code error;
+        for (const auto& file : std::filesystem::recursive_directory_iterator(input, error)) {
+            if (file.is_regular_file()) {
+                files.push_back(file.path());
+            }
+        }
+        std::ranges::sort(files);
+
+        if (error) {
+            std::cerr << "Failed to list " << input.string() << ": " << error.message() << ".\n";
+        } else {
+            AssetArchiveWriter writer;
+            u64 inputSize = 0;
+            bool added = true;
+            for (const std::filesystem::path& file : files) {
+                added = added && writer.AddFile(file, std::filesystem::relative(file, input).generic_string(),
+                                                compression) == AssetArchiveError::None;
+                inputSize += std::filesystem::file_size(file, error);
+            }
+
+            JobSystem jobSystem;
+            if (added && writer.Write(argv[2], &jobSystem) == AssetArchiveError::None) {
+                std::cerr << "Packed " << files.size() << " files, " << inputSize << " bytes into "
+                          << std::filesystem::file_size(argv[2], error) << " bytes.\n";
+                result = 0;
+            }
+        }
+    } else {
+        PrintUsage();
+    }
+
+    Logger::Shutdown();
+    return result;
+}
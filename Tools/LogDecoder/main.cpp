@@ -0,0 +1,209 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/BinaryLog.hpp>
+
+#ifdef SPDLOG_FMT_EXTERNAL
+    #include <fmt/args.h>
+#else
+    #include <spdlog/fmt/bundled/args.h>
+#endif
+
+#include <spdlog/fmt/chrono.h>
+
+#include <fstream>
+#include <unordered_map>
+
+using namespace Flashlight;
+
+namespace {
+    // Every read is checked against the end of the record, the file may be truncated or damaged.
+    template <typename T>
+    bool Read(const std::byte*& input, const std::byte* end, T& value) {
+        if (static_cast<u64>(end - input) < sizeof(T)) {
+            return false;
+        }
+
+        std::memcpy(&value, input, sizeof(T));
+        input += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool PushValue(fmt::dynamic_format_arg_store<fmt::format_context>& arguments, const std::byte*& input,
+                   const std::byte* end) {
+        T value;
+        if (!Read(input, end, value)) {
+            return false;
+        }
+
+        arguments.push_back(value);
+        return true;
+    }
+
+    bool PushArgument(fmt::dynamic_format_arg_store<fmt::format_context>& arguments, const std::byte*& input,
+                      const std::byte* end) {
+        u8 type;
+        if (!Read(input, end, type)) {
+            return false;
+        }
+
+        switch (static_cast<BinaryLogArgumentType>(type)) {
+        case BinaryLogArgumentType::Bool:
+            {
+                // Read as a byte, any value but 0 and 1 would be an invalid bool.
+                u8 value;
+                if (!Read(input, end, value)) {
+                    return false;
+                }
+                arguments.push_back(value != 0);
+                return true;
+            }
+
+        case BinaryLogArgumentType::Char: return PushValue<char>(arguments, input, end);
+        case BinaryLogArgumentType::I8: return PushValue<i8>(arguments, input, end);
+        case BinaryLogArgumentType::I16: return PushValue<i16>(arguments, input, end);
+        case BinaryLogArgumentType::I32: return PushValue<i32>(arguments, input, end);
+        case BinaryLogArgumentType::I64: return PushValue<i64>(arguments, input, end);
+        case BinaryLogArgumentType::U8: return PushValue<u8>(arguments, input, end);
+        case BinaryLogArgumentType::U16: return PushValue<u16>(arguments, input, end);
+        case BinaryLogArgumentType::U32: return PushValue<u32>(arguments, input, end);
+        case BinaryLogArgumentType::U64: return PushValue<u64>(arguments, input, end);
+        case BinaryLogArgumentType::F32: return PushValue<f32>(arguments, input, end);
+        case BinaryLogArgumentType::F64: return PushValue<f64>(arguments, input, end);
+
+        case BinaryLogArgumentType::String:
+            {
+                u32 length;
+                if (!Read(input, end, length) || length > static_cast<u64>(end - input)) {
+                    return false;
+                }
+
+                arguments.push_back(std::string(reinterpret_cast<const char*>(input), length));
+                input += length;
+                return true;
+            }
+
+        default:
+            return false;
+        }
+    }
+
+    i32 Decode(const char* path, const char* outputPath) {
+        MemoryMappedFile file;
+        if (!file.OpenRead(path) || file.GetSize() < sizeof(BinaryLogFileHeader)) {
+            std::cerr << "Failed to open " << path << ".\n";
+            return 1;
+        }
+
+        BinaryLogFileHeader header{};
+        std::memcpy(&header, file.GetData(), sizeof(header));
+        if (header.Magic != BinaryLogMagic || header.Version != BinaryLogVersion) {
+            std::cerr << path << " is not a Flashlight binary log or was written by an unsupported version.\n";
+            return 1;
+        }
+
+        if (header.HeaderSize < sizeof(BinaryLogFileHeader) || header.HeaderSize > file.GetSize()) {
+            std::cerr << path << " has a corrupted header.\n";
+            return 1;
+        }
+
+        std::ofstream outputFile;
+        if (outputPath != nullptr) {
+            outputFile.open(outputPath);
+        }
+        std::ostream& output = outputFile.is_open() ? outputFile : std::cout;
+
+        std::unordered_map<u32, std::string> formats;
+        u64 messageCount = 0;
+        u64 corruptedCount = 0;
+        bool truncated = false;
+
+        const std::byte* cursor = file.GetData() + header.HeaderSize;
+        const std::byte* fileEnd = file.GetData() + file.GetSize();
+
+        while (static_cast<u64>(fileEnd - cursor) >= sizeof(BinaryLogRecordHeader)) {
+            BinaryLogRecordHeader record{};
+            std::memcpy(&record, cursor, sizeof(record));
+
+            // Records are published by writing their size last, a zero size is where the writer stopped.
+            if (record.Size == 0) {
+                break;
+            }
+
+            // Any other size that doesn't describe a whole record means the next ones can't be found anymore.
+            const u64 remaining = static_cast<u64>(fileEnd - cursor);
+            if (record.Size < sizeof(record) || record.Size % 8 != 0 || record.Size > remaining) {
+                truncated = true;
+                break;
+            }
+
+            const std::byte* payload = cursor + sizeof(record);
+            const std::byte* recordEnd = cursor + record.Size;
+            cursor = recordEnd;
+
+            if (record.Kind == BinaryLogRecordKind::Format) {
+                std::string format(reinterpret_cast<const char*>(payload), recordEnd - payload);
+                format.erase(format.find_last_not_of('\0') + 1);
+                formats[record.FormatId] = std::move(format);
+                continue;
+            }
+
+            const auto format = formats.find(record.FormatId);
+            fmt::dynamic_format_arg_store<fmt::format_context> arguments;
+            bool valid = format != formats.end() && record.Level < spdlog::level::n_levels;
+            for (u16 i = 0; valid && i < record.ArgumentCount; i++) {
+                valid = PushArgument(arguments, payload, recordEnd);
+            }
+
+            if (!valid) {
+                corruptedCount++;
+                continue;
+            }
+
+            const i64 wallClock = header.SystemClockAtOpen + (record.Timestamp - header.SteadyClockAtOpen);
+            const std::chrono::sys_seconds seconds{std::chrono::seconds(wallClock / 1'000'000'000)};
+            const i64 microseconds = wallClock % 1'000'000'000 / 1'000;
+
+            std::string message;
+            try {
+                message = fmt::vformat(format->second, arguments);
+            } catch (const fmt::format_error& error) {
+                message = format->second + " <format error: " + error.what() + ">";
+            }
+
+            const auto levelName = spdlog::level::to_string_view(static_cast<spdlog::level::level_enum>(record.Level));
+            output << fmt::format("[{:%F %T}.{:06}]({}) [thread {:08x}] {}\n", seconds, microseconds,
+                                  std::string_view(levelName.data(), levelName.size()), record.ThreadId, message);
+            messageCount++;
+        }
+
+        std::cerr << "Decoded " << messageCount << " messages";
+        if (corruptedCount > 0) {
+            std::cerr << ", skipped " << corruptedCount << " unreadable records";
+        }
+        std::cerr << ".\n";
+
+        if (truncated) {
+            std::cerr << "Found a corrupted record at offset " << cursor - file.GetData()
+                      << ", the rest of the log was not decoded.\n";
+        }
+
+        return 0;
+    }
+}
+
+int main(const int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: FlashlightLogDecoder <log file> [output file]\n";
+        return 1;
+    }
+
+    // MemoryMappedFile reports its errors through the engine logger.
+    Logger::Init({});
+    const i32 result = Decode(argv[1], argc >= 3 ? argv[2] : nullptr);
+    Logger::Shutdown();
+
+    return result;
+}
@@ -0,0 +1,58 @@
+// Copyright (C) 2024 Jean "Pixfri" Letessier 
+// This file is part of Flashlight Engine.
+// For conditions of distribution and use, see copyright notice in LICENSE
+
+#include <FlashlightEngine/Core/JobSystem.hpp>
+#include <FlashlightEngine/Core/Logger.hpp>
+#include <FlashlightEngine/Mesh/MeshOptimizer.hpp>
+
+#include <chrono>
+
+using namespace Flashlight;
+
+namespace {
+    void PrintUsage() {
+        std::cerr << "Usage: FlashlightMeshOptimizer <input.obj> [output.obj]\n";
+    }
+
+    void PrintReport(const MeshOptimizationReport& report, const f64 milliseconds) {
+        std::cout << fmt::format("Triangles      {0}\n", report.TriangleCount)
+                  << fmt::format("Vertices       {0} -> {1}\n", report.SourceVertexCount, report.VertexCount)
+                  << fmt::format("ACMR           {0:.3f} -> {1:.3f}\n", report.CacheBefore.Acmr,
+                                 report.CacheAfter.Acmr)
+                  << fmt::format("ATVR           {0:.3f} -> {1:.3f}\n", report.CacheBefore.Atvr,
+                                 report.CacheAfter.Atvr)
+                  << fmt::format("Overfetch      {0:.3f} -> {1:.3f}\n", report.FetchBefore.Overfetch,
+                                 report.FetchAfter.Overfetch)
+                  << fmt::format("Time           {0:.1f} ms\n", milliseconds);
+    }
+}
+
+int main(const int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    Logger::Init({});
+
+    i32 result = 1;
+    MeshData mesh;
+    if (ImportObj(argv[1], mesh)) {
+        JobSystem jobSystem;
+        MeshOptimizerSettings settings;
+        settings.Jobs = &jobSystem;
+
+        const auto start = std::chrono::steady_clock::now();
+        const MeshOptimizationReport report = OptimizeMesh(mesh, settings);
+        const std::chrono::duration<f64, std::milli> duration = std::chrono::steady_clock::now() - start;
+
+        PrintReport(report, duration.count());
+        result = argc == 3 && !ExportObj(argv[2], mesh) ? 1 : 0;
+    } else {
+        std::cerr << "Failed to read " << argv[1] << ".\n";
+    }
+
+    Logger::Shutdown();
+    return result;
+}
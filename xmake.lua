@@ -28,13 +28,42 @@ add_repositories("FlashlightEngine https://github.com/FlashlightEngine/xmake-rep
 
 -- Define packages to download.
 add_requires("volk 1.3.290+0", "vk-bootstrap v1.3.290", "vulkan-memory-allocator v3.1.0", 
-             "vulkan-utility-libraries v1.3.290", "glfw 3.4", "glm 1.0.1", "spdlog v1.9.0", "stb 2024.06.01")
+             "vulkan-utility-libraries v1.3.290", "glfw 3.4", "glm 1.0.1", "spdlog v1.9.0", "stb 2024.06.01",
+             "lz4 v1.9.4", "zstd v1.5.6")
 add_requires("imgui v1.91.0", {configs = {glfw = true, vulkan = true, debug = is_mode("debug")}})
 add_requires("flutils 1.2.0")
 
 local outputdir = "$(mode)-$(os)-$(arch)"
 
 option("static", {description = "Build the engine into a static library.", default = false})
+option("benchmarks", {description = "Build the FlashlightBenchmarks target.", default = false})
+option("tests", {description = "Build the FlashlightTests target, run it with xmake test.", default = false})
+option("avx2", {description = "Compile for CPUs with AVX2 and FMA, SIMD kernels then use 256-bit registers.",
+               default = false})
+option("profiling", {description = "Compile the profiler zones in.", default = true})
+option("loglevel", {description = "Lowest log level compiled in, defaults to trace in debug and info in release.",
+                    values = {"trace", "debug", "info", "warn", "error", "critical", "off"}})
+
+if has_config("loglevel") then
+  add_defines("FL_LOG_ACTIVE_LEVEL=FL_LOG_LEVEL_" .. get_config("loglevel"):upper())
+end
+
+if has_config("avx2") then
+  add_vectorexts("avx2")
+  add_cxflags("-mfma", {tools = {"gcc", "clang"}})
+end
+
+if has_config("profiling") then
+  add_defines("FL_PROFILING")
+end
+
+if has_config("benchmarks") then
+  add_requires("benchmark 1.9.0")
+end
+
+if has_config("tests") then
+  add_requires("gtest 1.15.2")
+end
 
 add_includedirs("Include")
   
@@ -53,7 +82,32 @@ target("FlashlightEngine", function()
   set_objectdir("build/" .. outputdir .. "/FlashlightEngine/obj")
 
   -- Set source cpp files.
-  add_files("Source/**.cpp")
+  add_files("Source/**.cpp|Animation/*.cpp|Math/*.cpp|Math/Kernels/*.cpp|Renderer/Kernels/*.cpp|Scene/Kernels/*.cpp")
+
+  -- Nothing in animation and math reads errno, without it GCC can't vectorize loops calling sqrt (quaternion
+  -- normalization in poses). MSVC has no such flag.
+  if is_plat("windows") then
+    add_files("Source/Animation/*.cpp", "Source/Math/*.cpp")
+  else
+    add_files("Source/Animation/*.cpp", "Source/Math/*.cpp", {cxxflags = "-fno-math-errno"})
+  end
+
+  -- Batch math, culling and transform kernels, each file is built for its own instruction set and picked at runtime
+  -- from CPUID.
+  if is_plat("windows") then
+    add_files("Source/Math/Kernels/*Sse42.cpp", "Source/Renderer/Kernels/*Sse42.cpp",
+              "Source/Scene/Kernels/*Sse42.cpp")
+    add_files("Source/Math/Kernels/*Avx2.cpp", "Source/Renderer/Kernels/*Avx2.cpp", "Source/Scene/Kernels/*Avx2.cpp",
+              {cxxflags = "/arch:AVX2"})
+    add_files("Source/Math/Kernels/*Avx512.cpp", "Source/Renderer/Kernels/*Avx512.cpp", {cxxflags = "/arch:AVX512"})
+  else
+    add_files("Source/Math/Kernels/*Sse42.cpp", "Source/Renderer/Kernels/*Sse42.cpp", "Source/Scene/Kernels/*Sse42.cpp",
+              {cxxflags = "-msse4.2"})
+    add_files("Source/Math/Kernels/*Avx2.cpp", "Source/Renderer/Kernels/*Avx2.cpp", "Source/Scene/Kernels/*Avx2.cpp",
+              {cxxflags = {"-mavx2", "-mfma"}})
+    add_files("Source/Math/Kernels/*Avx512.cpp", "Source/Renderer/Kernels/*Avx512.cpp",
+              {cxxflags = {"-mavx512f", "-mavx2", "-mfma"}})
+  end
 
   -- Add Engine headers to the project and set the include directory as public so it can be accessed from dependant
   -- targets.
@@ -66,8 +120,74 @@ target("FlashlightEngine", function()
 
   -- target dependencies
   add_packages("volk","vk-bootstrap", "vulkan-memory-allocator", "vulkan-utility-libraries", "glfw", "glm",
-               "spdlog", "imgui", "stb", "flutils")
+               "spdlog", "imgui", "stb", "flutils", "lz4", "zstd")
+
+end)
+
+target("FlashlightLogDecoder", function()
+  set_kind("binary")
+  add_deps("FlashlightEngine")
+
+  set_targetdir("build/" .. outputdir .. "/FlashlightLogDecoder/bin")
+  set_objectdir("build/" .. outputdir .. "/FlashlightLogDecoder/obj")
 
+  add_files("Tools/LogDecoder/**.cpp")
+
+  add_packages("spdlog")
 end)
 
+target("FlashlightAssetPacker", function()
+  set_kind("binary")
+  add_deps("FlashlightEngine")
+
+  set_targetdir("build/" .. outputdir .. "/FlashlightAssetPacker/bin")
+  set_objectdir("build/" .. outputdir .. "/FlashlightAssetPacker/obj")
+
+  add_files("Tools/AssetPacker/**.cpp")
+
+  add_packages("spdlog")
+end)
+
+target("FlashlightMeshOptimizer", function()
+  set_kind("binary")
+  add_deps("FlashlightEngine")
+
+  set_targetdir("build/" .. outputdir .. "/FlashlightMeshOptimizer/bin")
+  set_objectdir("build/" .. outputdir .. "/FlashlightMeshOptimizer/obj")
+
+  add_files("Tools/MeshOptimizer/**.cpp")
+
+  add_packages("glm", "spdlog")
+end)
+
+if has_config("benchmarks") then
+  target("FlashlightBenchmarks", function()
+    set_kind("binary")
+    add_deps("FlashlightEngine")
+
+    set_targetdir("build/" .. outputdir .. "/FlashlightBenchmarks/bin")
+    set_objectdir("build/" .. outputdir .. "/FlashlightBenchmarks/obj")
+
+    add_files("Benchmarks/**.cpp")
+
+    add_packages("benchmark", "glfw", "glm", "spdlog", "stb")
+  end)
+end
+
+if has_config("tests") then
+  target("FlashlightTests", function()
+    set_kind("binary")
+    add_deps("FlashlightEngine")
+
+    set_targetdir("build/" .. outputdir .. "/FlashlightTests/bin")
+    set_objectdir("build/" .. outputdir .. "/FlashlightTests/obj")
+
+    add_files("Tests/**.cpp")
+
+    add_packages("gtest", "glfw", "glm", "spdlog", "stb")
+
+    add_tests("default")
+  end)
+end
+
 includes("xmake/**.lua")